@@ -0,0 +1,254 @@
+// expressions.cpp: example program showing vector and matrix expressions evaluated in a single loop, fused for posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// configure posit environment using fast posits
+#define POSIT_FAST_POSIT_16_1 1
+#include <universal/posit/posit>
+#include <universal/blas/blas.hpp>
+#include <random>
+
+template<typename Scalar>
+sw::unum::blas::vector<Scalar> RandomVector(size_t N, std::mt19937_64& eng) {
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	sw::unum::blas::vector<Scalar> v(N);
+	for (auto& e : v) e = dist(eng);
+	return v;
+}
+
+template<typename Scalar>
+sw::unum::blas::matrix<Scalar> RandomMatrix(size_t M, size_t N, std::mt19937_64& eng) {
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	sw::unum::blas::matrix<Scalar> A(M, N);
+	for (size_t i = 0; i < M; ++i) for (size_t j = 0; j < N; ++j) A(i, j) = dist(eng);
+	return A;
+}
+
+// element-wise expressions of native types evaluate to the same results as the element-wise loops
+int VerifyNativeExpressions(const std::string& tag) {
+	using namespace sw::unum::blas;
+	int nrOfFailedTests = 0;
+	constexpr size_t N = 100;
+	std::mt19937_64 eng(0x5eed);
+	vector<double> x = RandomVector<double>(N, eng), z = RandomVector<double>(N, eng);
+	double a = 0.75, b = -1.5;
+
+	vector<double> y = a * fused(x) + b * fused(z);
+	for (size_t i = 0; i < N; ++i) if (y[i] != a * x[i] + b * z[i]) { ++nrOfFailedTests; break; }
+	y = -fused(x) + fused(z) / 2.0 - (fused(x) - z) * 3;
+	for (size_t i = 0; i < N; ++i) if (y[i] != -x[i] + z[i] / 2.0 - (x[i] - z[i]) * 3) { ++nrOfFailedTests; break; }
+	vector<double> w(y);
+	y += fused(x) - z;
+	for (size_t i = 0; i < N; ++i) if (y[i] != w[i] + (x[i] - z[i])) { ++nrOfFailedTests; break; }
+
+	matrix<double> A = RandomMatrix<double>(7, N, eng), B = RandomMatrix<double>(7, N, eng);
+	matrix<double> C = fused(A) + 2.0 * fused(B) - fused(A) / 4.0;
+	for (size_t i = 0; i < 7; ++i) for (size_t j = 0; j < N; ++j) if (C(i, j) != A(i, j) + 2.0 * B(i, j) - A(i, j) / 4.0) ++nrOfFailedTests;
+
+	// the vector operand of a matrix-vector product can be an expression, and the product part of an expression
+	vector<double> c = RandomVector<double>(7, eng);
+	vector<double> r = fused(c) - fused(A) * (fused(x) + z) * 0.5;
+	for (size_t i = 0; i < 7; ++i) {
+		double e = 0;
+		for (size_t j = 0; j < N; ++j) e += A(i, j) * (x[j] + z[j]);
+		if (r[i] != c[i] - e * 0.5) ++nrOfFailedTests;
+	}
+	try {
+		r = fused(A) * c;
+		++nrOfFailedTests;
+	}
+	catch (const matmul_incompatible_matrices&) {
+		// incompatible operands are rejected when the product is formed
+	}
+	try {
+		r = fused(x) + c;
+		++nrOfFailedTests;
+	}
+	catch (const elementwise_incompatible_operands&) {
+		// as are element-wise operands of different sizes
+	}
+	try {
+		C = fused(A) - matrix<double>(N, 7);
+		++nrOfFailedTests;
+	}
+	catch (const elementwise_incompatible_operands&) {
+	}
+
+	// views are operands
+	vector_view<double> vx(&x[0], N);
+	y = fused(vx) + z;
+	for (size_t i = 0; i < N; ++i) if (y[i] != x[i] + z[i]) { ++nrOfFailedTests; break; }
+
+	// the operators on containers compute their result
+	static_assert(std::is_same<decltype(x + z), vector<double>>::value, "vector sum is not a vector");
+	static_assert(std::is_same<decltype(-x), vector<double>>::value, "vector negation is not a vector");
+	static_assert(std::is_same<decltype(A * x), vector<double>>::value, "matrix-vector product is not a vector");
+	static_assert(std::is_same<decltype(A - B), matrix<double>>::value, "matrix difference is not a matrix");
+	y = -x;
+	for (size_t i = 0; i < N; ++i) if (y[i] != -x[i]) { ++nrOfFailedTests; break; }
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+// sums of products of posits are accumulated in a quire and rounded once
+template<size_t nbits, size_t es>
+int VerifyFusedExpressions(const std::string& tag) {
+	using namespace sw::unum;
+	using namespace sw::unum::blas;
+	using Scalar = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	constexpr size_t M = 13, N = 200;
+	std::mt19937_64 eng(0x5eed);
+	vector<Scalar> x = RandomVector<Scalar>(N, eng), z = RandomVector<Scalar>(N, eng), b = RandomVector<Scalar>(M, eng);
+	matrix<Scalar> A = RandomMatrix<Scalar>(M, N, eng);
+	Scalar alpha = 0.75, beta = -1.5;
+
+	// y = alpha*x + beta*z
+	vector<Scalar> y = alpha * fused(x) + beta * fused(z);
+	for (size_t i = 0; i < N; ++i) {
+		quire<nbits, es, 20> q;
+		q += quire_mul(alpha, x[i]);
+		q += quire_mul(beta, z[i]);
+		Scalar e;
+		convert(q.to_value(), e);
+		if (y[i] != e) { ++nrOfFailedTests; break; }
+	}
+
+	// the residual r = b - A*x
+	vector<Scalar> r = fused(b) - fused(A) * x;
+	for (size_t i = 0; i < M; ++i) {
+		quire<nbits, es, 20> q;
+		q += b[i];
+		for (size_t j = 0; j < N; ++j) q -= quire_mul(A(i, j), x[j]);
+		Scalar e;
+		convert(q.to_value(), e);
+		if (r[i] != e) { ++nrOfFailedTests; break; }
+	}
+
+	// a single operation is a correctly rounded posit operation
+	y = x + z;
+	for (size_t i = 0; i < N; ++i) if (y[i] != x[i] + z[i]) { ++nrOfFailedTests; break; }
+
+	// assigning a product to one of its operands evaluates through a temporary
+	vector<Scalar> s(N), t(N);
+	matrix<Scalar> S = RandomMatrix<Scalar>(N, N, eng);
+	s = x;
+	t = S * s;
+	s = fused(S) * s;
+	for (size_t i = 0; i < N; ++i) if (s[i] != t[i]) { ++nrOfFailedTests; break; }
+	s = x;
+	t = fused(x) - fused(S) * s;
+	s = fused(x) - fused(S) * s;
+	for (size_t i = 0; i < N; ++i) if (s[i] != t[i]) { ++nrOfFailedTests; break; }
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+// nested scaling multiplies the scale factors exactly: the reference holds the product of two factors
+// exactly in a posit of twice the precision, and accumulates in the quire of that wider posit
+template<size_t nbits, size_t es>
+int VerifyNestedScaling(const std::string& tag) {
+	using namespace sw::unum;
+	using namespace sw::unum::blas;
+	using Scalar = posit<nbits, es>;
+	using Wide = posit<2 * nbits, es>;
+	int nrOfFailedTests = 0;
+	constexpr size_t M = 13, N = 200;
+	std::mt19937_64 eng(0x5eed);
+	vector<Scalar> x = RandomVector<Scalar>(N, eng), z = RandomVector<Scalar>(N, eng), y = RandomVector<Scalar>(M, eng);
+	matrix<Scalar> A = RandomMatrix<Scalar>(M, N, eng);
+	Scalar alpha = 0.3, beta = -1.7, gamma = 1.1;
+
+	// a*(b*x) + z
+	vector<Scalar> r = alpha * (beta * fused(x)) + z;
+	Wide ab = Wide(double(alpha)) * Wide(double(beta));
+	for (size_t i = 0; i < N; ++i) {
+		quire<2 * nbits, es, 20> q;
+		q += quire_mul(ab, Wide(double(x[i])));
+		q += Wide(double(z[i]));
+		Scalar e;
+		convert(q.to_value(), e);
+		if (r[i] != e) { ++nrOfFailedTests; break; }
+	}
+
+	// a single nested product is rounded once as well, as is a product scaled twice
+	r = alpha * (beta * fused(x));
+	for (size_t i = 0; i < N; ++i) {
+		quire<2 * nbits, es, 20> q;
+		q += quire_mul(ab, Wide(double(x[i])));
+		Scalar e;
+		convert(q.to_value(), e);
+		if (r[i] != e) { ++nrOfFailedTests; break; }
+	}
+	r = gamma * (alpha * (beta * fused(x))) - z;
+	for (size_t i = 0; i < N; ++i) {
+		quire<2 * nbits, es, 20> q;
+		q += quire_mul(ab, Wide(double(gamma)) * Wide(double(x[i])));
+		q -= Wide(double(z[i]));
+		Scalar e;
+		convert(q.to_value(), e);
+		if (r[i] != e) { ++nrOfFailedTests; break; }
+	}
+
+	// a*(A*x) + y
+	vector<Scalar> s = alpha * (fused(A) * x) + y;
+	for (size_t i = 0; i < M; ++i) {
+		quire<2 * nbits, es, 20> q;
+		for (size_t j = 0; j < N; ++j) q += quire_mul(Wide(double(alpha)) * Wide(double(A(i, j))), Wide(double(x[j])));
+		q += Wide(double(y[i]));
+		Scalar e;
+		convert(q.to_value(), e);
+		if (s[i] != e) { ++nrOfFailedTests; break; }
+	}
+
+	// the extremes of the dynamic range: maxpos^3 and minpos^3 fit the widened quire
+	Scalar maxp = std::numeric_limits<Scalar>::max(), minp = std::numeric_limits<Scalar>::min();
+	vector<Scalar> u(3), w(3);
+	u[0] = maxp; u[1] = minp; u[2] = -minp;
+	w[0] = -maxp; w[1] = 1; w[2] = minp;
+	vector<Scalar> v = maxp * (minp * fused(u)) + w;
+	if (!v[0].iszero() || v[1] != Scalar(1) || !v[2].iszero()) ++nrOfFailedTests;
+	v = minp * (minp * fused(u)) + w;
+	if (v[0] != -maxp || v[1] != Scalar(1) || v[2] != minp) ++nrOfFailedTests;
+	v = maxp * (maxp * fused(u)) + w;
+	if (v[0] != maxp || v[1] != maxp || v[2] != -maxp) ++nrOfFailedTests;
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "vector and matrix expressions" << endl;
+
+	nrOfFailedTestCases += VerifyNativeExpressions("expressions double    ");
+	nrOfFailedTestCases += VerifyFusedExpressions<16, 1>("fused posit<16,1>     ");
+	nrOfFailedTestCases += VerifyFusedExpressions<24, 1>("fused posit<24,1>     ");
+	nrOfFailedTestCases += VerifyFusedExpressions<32, 2>("fused posit<32,2>     ");
+	nrOfFailedTestCases += VerifyNestedScaling<16, 1>("nested posit<16,1>    ");
+	nrOfFailedTestCases += VerifyNestedScaling<24, 1>("nested posit<24,1>    ");
+	nrOfFailedTestCases += VerifyNestedScaling<32, 2>("nested posit<32,2>    ");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
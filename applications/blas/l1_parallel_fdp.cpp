@@ -0,0 +1,109 @@
+// l1_parallel_fdp.cpp: example program showing a fused-dot product partitioned across threads with an exact quire merge
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// configure posit environment using fast posits
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+#include <universal/posit/posit>
+#include <universal/blas/blas.hpp>
+#include <chrono>
+#include <random>
+
+// adding and subtracting quires is exact: compare to the sum through the normalized values
+template<size_t nbits, size_t es>
+int VerifyQuireMerge(const std::string& tag) {
+	using namespace sw::unum;
+	using Quire = quire<nbits, es, 20>;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+	std::uniform_int_distribution<int> scale(-12, 12);
+	for (int i = 0; i < 1000; ++i) {
+		Quire a, b;
+		for (int j = 0; j < 4; ++j) {
+			a += quire_mul(posit<nbits, es>(std::ldexp(mantissa(eng), scale(eng))), posit<nbits, es>(mantissa(eng)));
+			b += quire_mul(posit<nbits, es>(std::ldexp(mantissa(eng), scale(eng))), posit<nbits, es>(mantissa(eng)));
+		}
+		Quire sum(a), reference(a);
+		sum += b;
+		reference += b.to_value();
+		if (sum != reference) ++nrOfFailedTests;
+		Quire difference(a);
+		reference = a;
+		difference -= b;
+		reference -= b.to_value();
+		if (difference != reference) ++nrOfFailedTests;
+		// the exact difference of a quire with itself is a positive zero
+		difference = a;
+		difference -= a;
+		if (!difference.iszero() || difference.sign()) ++nrOfFailedTests;
+		if (nrOfFailedTests) break;
+	}
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+// the parallel fused dot product is bit-identical to the sequential fused dot product
+template<size_t nbits, size_t es>
+int VerifyParallelFdp(const std::string& tag, size_t N) {
+	using namespace sw::unum;
+	using Scalar = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	blas::vector<Scalar> x(N), y(N);
+	for (auto& e : x) e = dist(eng);
+	for (auto& e : y) e = dist(eng);
+
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	Scalar sequential = fdp(x, y);
+	steady_clock::time_point end = steady_clock::now();
+	double elapsed = duration_cast<duration<double>>(end - begin).count();
+	for (unsigned nrThreads : { 1u, 2u, 3u, 8u, 0u }) {
+		if (parallel_fdp(x, y, nrThreads) != sequential) ++nrOfFailedTests;
+	}
+	begin = steady_clock::now();
+	Scalar parallel = parallel_fdp(x, y);
+	end = steady_clock::now();
+	if (parallel != sequential) ++nrOfFailedTests;
+	double parallelElapsed = duration_cast<duration<double>>(end - begin).count();
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS")
+		<< "   fdp " << elapsed << " sec, parallel_fdp " << parallelElapsed << " sec on "
+		<< std::max(1u, std::thread::hardware_concurrency()) << " threads" << std::endl;
+	return nrOfFailedTests;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "parallel fused dot products" << endl;
+
+	nrOfFailedTestCases += VerifyQuireMerge<16, 1>("quire merge posit<16,1>   ");
+	nrOfFailedTestCases += VerifyQuireMerge<32, 2>("quire merge posit<32,2>   ");
+	nrOfFailedTestCases += VerifyParallelFdp<16, 1>("parallel fdp posit<16,1>  ", 100000);
+	nrOfFailedTestCases += VerifyParallelFdp<32, 2>("parallel fdp posit<32,2>  ", 100000);
+	nrOfFailedTestCases += VerifyParallelFdp<32, 2>("parallel fdp short vector ", 5);
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
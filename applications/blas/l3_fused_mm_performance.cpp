@@ -0,0 +1,116 @@
+// l3_fused_mm_performance.cpp: performance of the blocked, multithreaded fused matrix-matrix product
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <chrono>
+#include <thread>
+// enable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+#include <universal/posit/posit>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/generators.hpp>
+
+// reference fused matrix-matrix product: one quire per element of C and a naive i-j-k loop
+template<size_t nbits, size_t es>
+sw::unum::blas::matrix< sw::unum::posit<nbits, es> > ReferenceFusedMatmul(const sw::unum::blas::matrix< sw::unum::posit<nbits, es> >& A, const sw::unum::blas::matrix< sw::unum::posit<nbits, es> >& B) {
+	using namespace sw::unum;
+	constexpr size_t capacity = 20;
+	size_t rows = A.rows();
+	size_t cols = B.cols();
+	size_t dots = A.cols();
+	blas::matrix< posit<nbits, es> > C(rows, cols);
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) {
+			quire<nbits, es, capacity> q;
+			for (size_t k = 0; k < dots; ++k) {
+				q += quire_mul(A(i, k), B(k, j));
+			}
+			convert(q.to_value(), C(i, j));
+		}
+	}
+	return C;
+}
+
+// measure the reference and the blocked engine, and verify that the results are bit-identical
+template<size_t nbits, size_t es>
+int BenchmarkFusedMatmul(size_t N, unsigned nrThreads) {
+	using namespace std;
+	using namespace std::chrono;
+	using namespace sw::unum;
+	using Matrix = blas::matrix< posit<nbits, es> >;
+
+	Matrix A(N, N), B(N, N);
+	blas::uniform_rand(A, -1.0, 1.0);
+	blas::uniform_rand(B, -1.0, 1.0);
+
+	steady_clock::time_point t1 = steady_clock::now();
+	Matrix Cref = ReferenceFusedMatmul(A, B);
+	steady_clock::time_point t2 = steady_clock::now();
+	double reference = duration_cast<duration<double>>(t2 - t1).count();
+
+	t1 = steady_clock::now();
+	Matrix C1 = blas::fmm(A, B, 1);
+	t2 = steady_clock::now();
+	double blocked = duration_cast<duration<double>>(t2 - t1).count();
+
+	t1 = steady_clock::now();
+	Matrix Cn = blas::fmm(A, B, nrThreads);
+	t2 = steady_clock::now();
+	double threaded = duration_cast<duration<double>>(t2 - t1).count();
+
+	int nrOfFailedTests = 0;
+	if (Cref != C1) ++nrOfFailedTests;
+	if (Cref != Cn) ++nrOfFailedTests;
+
+	double fmas = double(N) * double(N) * double(N);
+	cout << "posit<" << nbits << "," << es << "> " << setw(4) << N << "x" << N
+		<< " reference " << setw(10) << reference << " sec (" << setw(8) << uint64_t(fmas / (1000.0 * reference)) << " KFDP/s)"
+		<< "  blocked " << setw(10) << blocked << " sec (" << setw(8) << uint64_t(fmas / (1000.0 * blocked)) << " KFDP/s)"
+		<< "  " << nrThreads << " threads " << setw(10) << threaded << " sec (" << setw(8) << uint64_t(fmas / (1000.0 * threaded)) << " KFDP/s)"
+		<< (nrOfFailedTests ? "  FAIL: results are not bit-identical" : "  PASS") << endl;
+	return nrOfFailedTests;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	unsigned nrThreads = std::thread::hardware_concurrency();
+	if (nrThreads < 2) nrThreads = 2;  // exercise the thread partitioning even on a single core
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "Fused matrix-matrix product: blocked and multithreaded engine vs naive reference\n";
+	nrOfFailedTestCases += BenchmarkFusedMatmul<16, 1>(33, nrThreads);   // not a multiple of the tile size
+	nrOfFailedTestCases += BenchmarkFusedMatmul<16, 1>(64, nrThreads);
+	nrOfFailedTestCases += BenchmarkFusedMatmul<32, 2>(64, nrThreads);
+	nrOfFailedTestCases += BenchmarkFusedMatmul<32, 2>(128, nrThreads);
+	nrOfFailedTestCases += BenchmarkFusedMatmul<64, 3>(48, nrThreads);
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -11,6 +11,7 @@
 #endif
 
 #include <chrono>
+#include <thread>
 // enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 // enable fast posits
@@ -216,6 +217,63 @@ void MagicSquareTest(int N) {
 
 }
 
+// benchmark the blocked LU decomposition against CroutFDP and ludcmp, and verify that
+// the blocked factorization is bit-identical to ludcmp, independent of the thread count
+template<size_t nbits, size_t es>
+int BenchmarkBlockedLU(size_t N, unsigned nrThreads) {
+	using namespace std;
+	using namespace std::chrono;
+	using namespace sw::unum;
+	using Matrix = blas::matrix< posit<nbits, es> >;
+
+	Matrix A(N, N);
+	blas::uniform_rand(A, -1.0, 1.0);
+
+	Matrix S(A), D(N, N);
+	steady_clock::time_point t1 = steady_clock::now();
+	blas::CroutFDP(S, D);
+	steady_clock::time_point t2 = steady_clock::now();
+	double crout = duration_cast<duration<double>>(t2 - t1).count();
+
+	Matrix LUref(A);
+	blas::vector<size_t> pref;
+	t1 = steady_clock::now();
+	blas::ludcmp(LUref, pref);
+	t2 = steady_clock::now();
+	double reference = duration_cast<duration<double>>(t2 - t1).count();
+
+	Matrix LU1(A);
+	blas::vector<size_t> p1;
+	t1 = steady_clock::now();
+	blas::ludcmp_blocked(LU1, p1, 1);
+	t2 = steady_clock::now();
+	double blocked = duration_cast<duration<double>>(t2 - t1).count();
+
+	Matrix LUn(A);
+	blas::vector<size_t> pn;
+	t1 = steady_clock::now();
+	blas::ludcmp_blocked(LUn, pn, nrThreads);
+	t2 = steady_clock::now();
+	double threaded = duration_cast<duration<double>>(t2 - t1).count();
+
+	auto samePivots = [N](const blas::vector<size_t>& a, const blas::vector<size_t>& b) {
+		for (size_t i = 0; i < N; ++i) if (a[i] != b[i]) return false;
+		return true;
+	};
+	int nrOfFailedTests = 0;
+	if (LUref != LU1 || !samePivots(pref, p1)) ++nrOfFailedTests;
+	if (LUref != LUn || !samePivots(pref, pn)) ++nrOfFailedTests;
+
+	double fdps = double(N) * double(N) * double(N) / 3.0;
+	cout << "posit<" << nbits << "," << es << "> " << setw(4) << N << "x" << N
+		<< " CroutFDP " << setw(10) << crout << " sec (" << setw(8) << uint64_t(fdps / (1000.0 * crout)) << " KFDP/s)"
+		<< "  ludcmp " << setw(10) << reference << " sec (" << setw(8) << uint64_t(fdps / (1000.0 * reference)) << " KFDP/s)"
+		<< "  blocked " << setw(10) << blocked << " sec (" << setw(8) << uint64_t(fdps / (1000.0 * blocked)) << " KFDP/s)"
+		<< "  " << nrThreads << " threads " << setw(10) << threaded << " sec (" << setw(8) << uint64_t(fdps / (1000.0 * threaded)) << " KFDP/s)"
+		<< (nrOfFailedTests ? "  FAIL: factorizations are not bit-identical" : "  PASS") << endl;
+	return nrOfFailedTests;
+}
+
 int main(int argc, char** argv)
 try {
 	using namespace std;
@@ -234,6 +292,24 @@ try {
 
 	FrankMatrix();
 
+	unsigned nrThreads = std::thread::hardware_concurrency();
+	if (nrThreads < 2) nrThreads = 2;  // exercise the thread partitioning even on a single core
+	cout << "\nBlocked LU decomposition with fused dot products\n";
+	nrOfFailedTestCases += BenchmarkBlockedLU<16, 1>(100, nrThreads);  // not a multiple of the panel width
+	nrOfFailedTestCases += BenchmarkBlockedLU<32, 2>(67, nrThreads);
+	nrOfFailedTestCases += BenchmarkBlockedLU<32, 2>(256, nrThreads);
+
+	// a singular system has no solution: solve returns an empty vector
+	{
+		sw::unum::blas::matrix< posit<32, 2> > S(3, 3);
+		sw::unum::blas::vector< posit<32, 2> > s(3);
+		s = posit<32, 2>(1);
+		if (size(solve(S, s)) != 0) {
+			cout << "FAIL: solve of a singular system did not return an empty vector\n";
+			++nrOfFailedTestCases;
+		}
+	}
+
 	/*
 	MagicSquareTest<float>(5);
 	MagicSquareTest<float>(51);
@@ -0,0 +1,144 @@
+// packed.cpp: example program to store odd-width posits, fixpnts, and integers in bit-packed vectors and matrices
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// configure posit environment using fast posits
+#define POSIT_FAST_POSIT_16_1 1
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixpnt>
+#include <universal/integer/integer.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/packed.hpp>
+#include <random>
+
+// fill a vector with random encodings
+template<typename Scalar>
+sw::unum::blas::vector<Scalar> RandomEncodings(size_t N, uint64_t seed) {
+	using Encoding = sw::unum::blas::binary_encoding<Scalar>;
+	std::mt19937_64 eng(seed);
+	sw::unum::blas::vector<Scalar> v(N);
+	for (auto& e : v) {
+		uint64_t limbs[(Encoding::nbits + 63) / 64];
+		for (auto& limb : limbs) limb = eng();
+		limbs[(Encoding::nbits - 1) / 64] &= sw::unum::blas::internal::limb_mask(Encoding::nbits - 64 * ((Encoding::nbits - 1) / 64));
+		Encoding::load(e, limbs);
+	}
+	return v;
+}
+
+// pack and unpack through element access and through blocks, at all alignments of the block boundaries
+template<typename Scalar>
+int VerifyPackedVector(const std::string& tag, size_t N) {
+	using namespace sw::unum::blas;
+	int nrOfFailedTests = 0;
+	vector<Scalar> v = RandomEncodings<Scalar>(N, 0x5eed);
+
+	packed_vector<Scalar> p(v);
+	if (p.size() != N || p.bytes() != 8 * ((N * packed_vector<Scalar>::nbits + 63) / 64 + 1)) ++nrOfFailedTests;
+	for (size_t i = 0; i < N; ++i) if (!(p[i] == v[i])) { ++nrOfFailedTests; break; }
+
+	std::vector<Scalar> buffer(N);
+	for (size_t first : { size_t(0), size_t(1), size_t(63), size_t(64), size_t(100) }) {
+		size_t count = N - first - (first % 7);
+		p.unpack(first, count, buffer.data());
+		for (size_t i = 0; i < count; ++i) if (!(buffer[i] == v[first + i])) { ++nrOfFailedTests; break; }
+	}
+
+	// block packs and element stores must not disturb the neighboring fields
+	packed_vector<Scalar> q(N);
+	std::vector<Scalar> w(v.begin(), v.end());
+	q.pack(0, 3, w.data());
+	q.pack(3, N - 3, w.data() + 3);
+	for (size_t i = 0; i < N; ++i) if (!(q[i] == v[i])) { ++nrOfFailedTests; break; }
+	for (size_t i = 0; i < N; i += 3) q[i] = v[N - 1 - i];
+	for (size_t i = 0; i < N; ++i) if (!(q[i] == (i % 3 == 0 ? v[N - 1 - i] : v[i]))) { ++nrOfFailedTests; break; }
+
+	// shrinking clears the storage beyond the new end
+	q.resize(N / 2);
+	q.resize(N);
+	for (size_t i = N / 2; i < N; ++i) if (!(q[i] == Scalar(0))) { ++nrOfFailedTests; break; }
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+// the packed BLAS kernels yield the same results as the kernels on unpacked vectors and matrices
+template<size_t nbits, size_t es>
+int VerifyPackedKernels(const std::string& tag) {
+	using namespace sw::unum;
+	using namespace sw::unum::blas;
+	using Scalar = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	constexpr size_t M = 19, N = 300;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	vector<Scalar> x(N), y(N);
+	matrix<Scalar> A(M, N);
+	for (auto& e : x) e = dist(eng);
+	for (auto& e : y) e = dist(eng);
+	for (size_t i = 0; i < M; ++i) for (size_t j = 0; j < N; ++j) A(i, j) = dist(eng);
+	packed_vector<Scalar> px(x), py(y);
+	packed_matrix<Scalar> pA(A);
+
+	if (dot(px, py) != dot(x, y)) ++nrOfFailedTests;
+
+	Scalar a = 0.5;
+	axpy(N, a, x, 1, y, 1);
+	axpy(N, a, px, 1, py, 1);
+	for (size_t i = 0; i < N; ++i) if (py[i] != y[i]) { ++nrOfFailedTests; break; }
+	axpy(N / 2, a, x, 2, y, 2);
+	axpy(N / 2, a, px, 2, py, 2);
+	for (size_t i = 0; i < N; ++i) if (py[i] != y[i]) { ++nrOfFailedTests; break; }
+
+	vector<Scalar> b = A * x, pb(M);
+	matvec(pb, pA, x);
+	for (size_t i = 0; i < M; ++i) if (pb[i] != b[i]) { ++nrOfFailedTests; break; }
+
+	// generic BLAS functions use the proxy references of the packed containers
+	pA(1, 2) += pA(3, 4);
+	A(1, 2) += A(3, 4);
+	if (pA(1, 2) != A(1, 2)) ++nrOfFailedTests;
+	if (sum(px) != sum(x)) ++nrOfFailedTests;
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "bit-packed vectors and matrices" << endl;
+
+	nrOfFailedTestCases += VerifyPackedVector< posit<10, 1> >("packed posit<10,1>   ", 1001);
+	nrOfFailedTestCases += VerifyPackedVector< posit<12, 1> >("packed posit<12,1>   ", 999);
+	nrOfFailedTestCases += VerifyPackedVector< posit<14, 1> >("packed posit<14,1>   ", 500);
+	nrOfFailedTestCases += VerifyPackedVector< posit<16, 1> >("packed posit<16,1>   ", 500);
+	nrOfFailedTestCases += VerifyPackedVector< posit<48, 2> >("packed posit<48,2>   ", 300);
+	nrOfFailedTestCases += VerifyPackedVector< posit<80, 2> >("packed posit<80,2>   ", 300);
+	nrOfFailedTestCases += VerifyPackedVector< integer<12> >("packed integer<12>   ", 300);
+	nrOfFailedTestCases += VerifyPackedVector< fixpnt<20, 10> >("packed fixpnt<20,10> ", 300);
+
+	nrOfFailedTestCases += VerifyPackedKernels<10, 1>("kernels posit<10,1>  ");
+	nrOfFailedTestCases += VerifyPackedKernels<16, 1>("kernels posit<16,1>  ");
+	nrOfFailedTestCases += VerifyPackedKernels<48, 2>("kernels posit<48,2>  ");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,107 @@
+// reproducible.cpp: example program showing reproducible float and double dot products and sums
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <universal/posit/posit>
+#include <universal/blas/blas.hpp>
+#include <algorithm>
+#include <random>
+
+// random values with 13 significant bits in a narrow range: their dot products are exact in double
+template<typename Real>
+sw::unum::blas::vector<Real> ShortValues(size_t N, std::mt19937_64& eng) {
+	std::uniform_int_distribution<int> digits(-4096, 4096), scale(-2, 2);
+	sw::unum::blas::vector<Real> v(N);
+	for (auto& e : v) e = std::ldexp(Real(digits(eng)), scale(eng) - 12);
+	return v;
+}
+
+// the reproducible dot product is the correctly rounded exact dot product
+template<typename Real>
+int VerifyCorrectRounding(const std::string& tag) {
+	using namespace sw::unum::blas;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(0x5eed);
+	for (size_t N : { size_t(1), size_t(10), size_t(1000), size_t(100000) }) {
+		vector<Real> x = ShortValues<Real>(N, eng), y = ShortValues<Real>(N, eng);
+		double exact = 0;
+		for (size_t i = 0; i < N; ++i) exact += double(x[i]) * double(y[i]);
+		if (reproducible_dot(x, y) != Real(exact)) ++nrOfFailedTests;
+		exact = 0;
+		for (size_t i = 0; i < N; ++i) exact += double(x[i]);
+		if (reproducible_sum(x) != Real(exact)) ++nrOfFailedTests;
+	}
+
+	// catastrophic cancellation: the naive sum loses the small terms
+	Real big = std::numeric_limits<Real>::max() / 4;
+	vector<Real> c = { big, Real(1), -big, Real(0.5), big, -big };
+	if (reproducible_sum(c) != Real(1.5)) ++nrOfFailedTests;
+	vector<Real> a = { Real(3.2e8), Real(1), Real(-1), Real(8e7) }, b = { Real(4.0e7), Real(1), Real(-1), Real(-1.6e8) };
+	if (reproducible_dot(a, b) != Real(2)) ++nrOfFailedTests;
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+// the result does not depend on the order of the elements nor on the number of threads
+template<typename Real>
+int VerifyReproducibility(const std::string& tag) {
+	using namespace sw::unum::blas;
+	int nrOfFailedTests = 0;
+	constexpr size_t N = 200000;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<Real> mantissa(-1, 1);
+	std::uniform_int_distribution<int> scale(-40, 40);
+	vector<Real> x(N), y(N);
+	for (auto& e : x) e = std::ldexp(mantissa(eng), scale(eng));
+	for (auto& e : y) e = std::ldexp(mantissa(eng), scale(eng));
+
+	Real dot = reproducible_dot(x, y), sum = reproducible_sum(x);
+	for (unsigned nrThreads : { 2u, 3u, 7u, 0u }) {
+		if (reproducible_dot(x, y, nrThreads) != dot) ++nrOfFailedTests;
+		if (reproducible_sum(x, nrThreads) != sum) ++nrOfFailedTests;
+	}
+	std::vector<size_t> order(N);
+	for (size_t i = 0; i < N; ++i) order[i] = i;
+	std::shuffle(order.begin(), order.end(), eng);
+	vector<Real> px(N), py(N);
+	for (size_t i = 0; i < N; ++i) {
+		px[i] = x[order[i]];
+		py[i] = y[order[i]];
+	}
+	if (reproducible_dot(px, py) != dot) ++nrOfFailedTests;
+	if (reproducible_sum(px, 3) != sum) ++nrOfFailedTests;
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "reproducible dot products and sums" << endl;
+
+	nrOfFailedTestCases += VerifyCorrectRounding<float>("correct rounding float  ");
+	nrOfFailedTestCases += VerifyCorrectRounding<double>("correct rounding double ");
+	nrOfFailedTestCases += VerifyReproducibility<float>("reproducible float      ");
+	nrOfFailedTestCases += VerifyReproducibility<double>("reproducible double     ");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,155 @@
+// serialization.cpp: example program to store vectors and matrices in binary data files and map them back into memory
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// configure posit environment using fast posits
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixpnt>
+#include <universal/integer/integer.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/serialization/datafile.hpp>
+#include <universal/blas/serialization/mapped_dataset.hpp>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+// fill a vector with random encodings
+template<typename Scalar>
+sw::unum::blas::vector<Scalar> RandomEncodings(size_t N) {
+	using Encoding = sw::unum::blas::binary_encoding<Scalar>;
+	std::mt19937_64 eng(0x5eed);
+	sw::unum::blas::vector<Scalar> v(N);
+	for (auto& e : v) {
+		uint64_t limbs[(Encoding::nbits + 63) / 64];
+		for (auto& limb : limbs) limb = eng();
+		limbs[(Encoding::nbits - 1) / 64] &= sw::unum::blas::internal::limb_mask(Encoding::nbits - 64 * ((Encoding::nbits - 1) / 64));
+		Encoding::load(e, limbs);
+	}
+	return v;
+}
+
+// round trip a vector through a stream and through a mapped file, and verify the zero-copy view when it is available
+template<typename Scalar>
+int VerifyVectorRoundTrip(const std::string& tag, size_t N, bool expectZeroCopy) {
+	using namespace sw::unum::blas;
+	int nrOfFailedTests = 0;
+	vector<Scalar> v = RandomEncodings<Scalar>(N);
+
+	std::stringstream ss;
+	write_binary(ss, v);
+	vector<Scalar> w;
+	read_binary(ss, w);
+	if (w.size() != N) ++nrOfFailedTests;
+	for (size_t i = 0; i < w.size() && i < N; ++i) if (!(w[i] == v[i])) { ++nrOfFailedTests; break; }
+
+	const std::string filename = "serialization_test.dat";
+	{
+		std::ofstream file(filename, std::ios::binary);
+		write_binary(file, v);
+	}
+	{
+		mapped_dataset<Scalar> dataset(filename);
+		if (dataset.size() != N || dataset.rank() != 1 || dataset.zero_copy() != expectZeroCopy) ++nrOfFailedTests;
+		for (size_t i = 0; i < dataset.size(); ++i) if (!(dataset[i] == v[i])) { ++nrOfFailedTests; break; }
+		if (dataset.zero_copy()) {
+			vector_view<Scalar> view = dataset.as_vector();
+			for (size_t i = 0; i < view.size(); ++i) if (!(view[i] == v[i])) { ++nrOfFailedTests; break; }
+		}
+	}
+	std::remove(filename.c_str());
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+// store a matrix, map it back, and use the view in a BLAS kernel
+int VerifyMatrixRoundTrip() {
+	using namespace sw::unum;
+	using namespace sw::unum::blas;
+	using Scalar = posit<32, 2>;
+	int nrOfFailedTests = 0;
+	constexpr size_t M = 37, N = 23;
+	matrix<Scalar> A(M, N);
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	for (size_t i = 0; i < M; ++i) for (size_t j = 0; j < N; ++j) A(i, j) = dist(eng);
+
+	const std::string filename = "serialization_test.dat";
+	{
+		std::ofstream file(filename, std::ios::binary);
+		write_binary(file, A);
+	}
+	{
+		mapped_dataset<Scalar> dataset(filename);
+		matrix_view<Scalar> view = dataset.as_matrix();
+		if (view.rows() != M || view.cols() != N) ++nrOfFailedTests;
+		for (size_t i = 0; i < M; ++i) {
+			vector<Scalar> row(N);
+			for (size_t j = 0; j < N; ++j) row[j] = A(i, j);
+			if (dot(view[i], view[i]) != dot(row, row)) ++nrOfFailedTests;
+		}
+		matrix<Scalar> B;
+		dataset.load(B);
+		if (B != A) ++nrOfFailedTests;
+	}
+	std::remove(filename.c_str());
+
+	// a matrix file is not a vector, and the element type must match
+	std::stringstream ss;
+	write_binary(ss, A);
+	vector< posit<32, 2> > v;
+	try { read_binary(ss, v); ++nrOfFailedTests; } catch (const datafile_error&) {}
+	ss.seekg(0);
+	matrix< posit<16, 1> > C;
+	try { read_binary(ss, C); ++nrOfFailedTests; } catch (const datafile_error&) {}
+	// a truncated payload is detected
+	std::string truncated = ss.str().substr(0, ss.str().size() / 2);
+	std::stringstream ts(truncated);
+	matrix<Scalar> D;
+	try { read_binary(ts, D); ++nrOfFailedTests; } catch (const datafile_error&) {}
+
+	std::cout << "matrix posit<32,2>  " << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "binary data files" << endl;
+
+	// byte-multiple widths of fast posits and integers are used in place
+	nrOfFailedTestCases += VerifyVectorRoundTrip< posit<16, 1> >("vector posit<16,1>  ", 1000, true);
+	nrOfFailedTestCases += VerifyVectorRoundTrip< posit<32, 2> >("vector posit<32,2>  ", 1000, true);
+	nrOfFailedTestCases += VerifyVectorRoundTrip< integer<32> >("vector integer<32>  ", 1000, true);
+	nrOfFailedTestCases += VerifyVectorRoundTrip< fixpnt<16, 8> >("vector fixpnt<16,8> ", 1000, true);
+	// odd widths are bit-packed and decoded on access
+	nrOfFailedTestCases += VerifyVectorRoundTrip< posit<10, 1> >("vector posit<10,1>  ", 1001, false);
+	nrOfFailedTestCases += VerifyVectorRoundTrip< posit<12, 1> >("vector posit<12,1>  ", 999, false);
+	nrOfFailedTestCases += VerifyVectorRoundTrip< integer<12> >("vector integer<12>  ", 77, false);
+	nrOfFailedTestCases += VerifyVectorRoundTrip< fixpnt<20, 10> >("vector fixpnt<20,10>", 77, false);
+	nrOfFailedTestCases += VerifyVectorRoundTrip< posit<80, 2> >("vector posit<80,2>  ", 77, false);
+	nrOfFailedTestCases += VerifyMatrixRoundTrip();
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
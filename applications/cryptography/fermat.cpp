@@ -15,8 +15,29 @@
 #include <universal/integer/integer>
 #include <universal/integer/primes.hpp>
 
+// Miller-Rabin test with the first reps integers from 2 as bases, whose exponentiations run as one batch modulo a
 template<size_t nbits, typename BlockType>
 bool miller_rabin(const sw::unum::integer<nbits, BlockType>& a, int reps) {
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	if (a < 4) return a > 1;
+	if (a.iseven()) return false;
+	// a - 1 = d 2^s
+	Integer minusOne = a - 1, d = a - 1;
+	unsigned s = 0;
+	while (d.iseven()) { d >>= 1; ++s; }
+	std::vector<Integer> bases, x;
+	for (int i = 0; i < reps && Integer(2 + i) < minusOne; ++i) bases.push_back(Integer(2 + i));
+	sw::unum::modular_context<Integer> ctx(a);
+	ctx.powmod(bases, d, x);
+	for (Integer& y : x) {
+		if (y == 1 || y == minusOne) continue;
+		unsigned r = 1;
+		for (; r < s; ++r) {
+			y = ctx.mulmod(y, y);
+			if (y == minusOne) break;
+		}
+		if (r == s) return false;  // the base is a witness of compositeness
+	}
 	return true;
 }
 
@@ -50,17 +71,17 @@ try {
 			stack<Integer> factors;
 			Integer a = 1049;
 			factors.push(a);
+			// Fermat's method is quick on factors that are close to the square root
+			factors.push(Integer(1000003) * Integer(1000033));
 
 			while (!factors.empty()) {
 				Integer factor = factors.top();
 				factors.pop();
-				/*
 				if (miller_rabin(factor, 25)) {
 					// factor is prime
 					cout << factor << endl;
 					continue;
 				}
-				*/
 				Integer result = fermatFactorization(factor);
 				if (result == 1) {
 					cout << "factor " << factor << " exponent " << result << endl;
@@ -10,14 +10,74 @@
 #include <typeinfo>
 #include <chrono>
 // include the number system we want to use, and configure overflow exceptions so we can capture failures
-#define INTEGER_THROW_ARITHMETIC_EXCEPTION 1
+#define INTEGER_THROW_ARITHMETIC_EXCEPTION 0
 #include <universal/integer/integer>
 
+/*
+   Pollard's rho method walks the sequence x_{k+1} = x_k^2 + c mod n. Modulo an unknown prime factor p of n
+   the sequence cycles after about sqrt(p) steps, and the cycle shows up as gcd(x_i - x_j, n) > 1.
+   Brent's variant compares x_j against the x_i at the powers of two, and multiplies a batch of the
+   differences together so that a batch costs a single gcd. The work grows with the square root
+   of the smallest factor, not of n.
+*/
+
+template<size_t nbits, typename BlockType>
+void FactorWithPollardRho(const sw::unum::integer<nbits, BlockType>& n) {
+	using namespace std::chrono;
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	steady_clock::time_point begin = steady_clock::now();
+	Integer factor = n;
+	for (unsigned long long c = 1; c < 10 && factor == n; ++c) factor = sw::unum::pollardRhoBrent(n, c);
+	steady_clock::time_point end = steady_clock::now();
+	double elapsed = duration_cast< duration<double> >(end - begin).count();
+	if (factor == n) {
+		std::cout << n << " resisted the rho walks" << std::endl;
+		return;
+	}
+	std::cout << n << " = " << factor << " * " << n / factor << "  in " << elapsed << " sec" << std::endl;
+}
+
 int main(int argc, char** argv)
 try {
 	using namespace std;
 	using namespace sw::unum;
 
+	constexpr size_t nbits = 256;
+	using Integer = integer<nbits, uint32_t>;
+
+	cout << "Pollard's rho factorization with Brent's cycle detection\n";
+	// the Fermat numbers 2^(2^k) + 1 for k = 5 and 6
+	Integer fermat(1);
+	for (int i = 0; i < 32; ++i) fermat *= 2;
+	FactorWithPollardRho(fermat + 1);
+	for (int i = 0; i < 32; ++i) fermat *= 2;
+	FactorWithPollardRho(fermat + 1);
+
+	// semiprimes with factors of increasing size: the time grows with the square root of the smaller one
+	Integer p = 1000;
+	for (int digits = 4; digits <= 10; ++digits, p *= 10) {
+		Integer a = p + 1, b = p * 3 + 1;
+		while (!isPrime(a)) ++a;
+		while (!isPrime(b)) ++b;
+		FactorWithPollardRho(a * b);
+	}
+
+	// and the complete factorization, which uses the rho method for the factors beyond trial division
+	cout << "\nprime factorization of 2^k - 1\n";
+	Integer mersenne = 1;
+	for (int k = 1; k <= 100; ++k) {
+		mersenne *= 2;
+		if (k % 10 != 0) continue;
+		primefactors<nbits, uint32_t> factors;
+		primeFactorization(mersenne - 1, factors);
+		cout << "2^" << setw(3) << k << " - 1 =";
+		for (auto& f : factors) {
+			cout << ' ' << f.first;
+			if (f.second > 1) cout << '^' << f.second;
+		}
+		cout << endl;
+	}
+
 
 	return EXIT_SUCCESS;
 }
@@ -10,14 +10,55 @@
 #include <typeinfo>
 #include <chrono>
 // include the number system we want to use, and configure overflow exceptions so we can capture failures
-#define INTEGER_THROW_ARITHMETIC_EXCEPTION 1
+#define INTEGER_THROW_ARITHMETIC_EXCEPTION 0
 #include <universal/integer/integer>
 
+/*
+   The quadratic sieve looks for a congruence of squares X^2 = Y^2 mod n with X != +-Y, so that
+   gcd(X - Y, n) is a proper factor. The values Q(x) = (x + m)^2 - n, m = floor(sqrt(n)), are squares
+   modulo n and small, about 2 x sqrt(n), so a fair fraction of them factors over a base of small primes.
+   Sieving the logarithms of the primes of the base finds those x without trial division of every Q(x),
+   and a product of relations with even exponents, found by Gaussian elimination over GF(2), is a
+   square on both sides. The work grows subexponentially, exp(sqrt(ln n ln ln n)), with the size of n
+   and does not depend on the size of the factors, so it beats Pollard's rho on semiprimes with balanced factors.
+*/
+
+// a semiprime of two primes of a number of decimal digits
+template<size_t nbits, typename BlockType>
+sw::unum::integer<nbits, BlockType> Semiprime(int digits) {
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	Integer p = 1;
+	for (int i = 1; i < digits; ++i) p *= 10;
+	Integer a = p + 7, b = p * 3 + 11;
+	while (!isPrime(a)) ++a;
+	while (!isPrime(b)) ++b;
+	return a * b;
+}
+
 int main(int argc, char** argv)
 try {
 	using namespace std;
+	using namespace std::chrono;
 	using namespace sw::unum;
 
+	constexpr size_t nbits = 256;
+	using Integer = integer<nbits, uint32_t>;
+
+	cout << "Quadratic sieve factorization\n";
+	bool bTrace = true;
+	for (int digits = 8; digits <= 18; digits += 2) {
+		Integer n = Semiprime<nbits, uint32_t>(digits);
+		steady_clock::time_point begin = steady_clock::now();
+		Integer factor = quadraticSieve(n, 0, bTrace);
+		steady_clock::time_point end = steady_clock::now();
+		double elapsed = duration_cast< duration<double> >(end - begin).count();
+		if (factor.isone()) {
+			cout << n << " was not factored" << endl;
+			continue;
+		}
+		cout << n << " = " << factor << " * " << n / factor << "  in " << elapsed << " sec\n" << endl;
+	}
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
@@ -17,15 +17,18 @@
  * Find the largest palindrome made from the product of two n-digit numbers.
  */
 
-sw::unum::decimal convert(std::string& palindrome) {
-	sw::unum::decimal p;
+// 9 or 18 digits per limb, and products of these magnitudes without heap allocations
+using Decimal = sw::unum::packed_decimal<>;
+
+Decimal convert(std::string& palindrome) {
+	Decimal p;
 	if (p.parse(palindrome)) {
 		return p;
 	}
-	return sw::unum::decimal(0);
+	return Decimal(0);
 }
 
-bool isPalindrome(const sw::unum::decimal& suspectedPalindrome) {
+bool isPalindrome(const Decimal& suspectedPalindrome) {
 	using namespace std;
 	string s1 = to_string(suspectedPalindrome);
 	string s2(s1);
@@ -33,7 +36,7 @@ bool isPalindrome(const sw::unum::decimal& suspectedPalindrome) {
 	return (s1 == s2);
 }
 
-bool LargestPalindromeProduct(const sw::unum::decimal& nrDigits) {
+bool LargestPalindromeProduct(const Decimal& nrDigits) {
 	using namespace std;
 	using namespace sw::unum;
 
@@ -41,15 +44,15 @@ bool LargestPalindromeProduct(const sw::unum::decimal& nrDigits) {
 	for (long i = 0; i < long(nrDigits); ++i) {
 		ss << '9';
 	}
-	decimal max;
+	Decimal max;
 	max.parse(ss.str());
 
-	decimal nrOfSteps = 0;
-	decimal largestPalindrome = 0;
-	for (decimal i = max; i >= 0; --i) {
-		for (decimal j = max; j >= 0; --j) {
+	Decimal nrOfSteps = 0;
+	Decimal largestPalindrome = 0;
+	for (Decimal i = max; i >= 0; --i) {
+		for (Decimal j = max; j >= 0; --j) {
 			++nrOfSteps;
-			decimal possiblePalindrome = i * j;
+			Decimal possiblePalindrome = i * j;
 			if (isPalindrome(possiblePalindrome)) {
 				if (largestPalindrome < possiblePalindrome) {
 					largestPalindrome = possiblePalindrome;
@@ -69,8 +72,6 @@ try {
 	using namespace std;
 	using namespace sw::unum;
 
-	using Decimal = decimal;
-
 	Decimal nrDigits = 1;
 
 	LargestPalindromeProduct(nrDigits++);
@@ -8,6 +8,8 @@
 // enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/posit/posit>
+// multi-precision floating-point for the reference digits
+#include <universal/mpfloat/mpfloat.hpp>
 
 /*
 Traditionally, we define the PI as the ratio of the circumference and its diameter.
@@ -66,6 +68,15 @@ An infinite series for PI published by Nilakantha in the 15th century is:
 pi = 3 + ----- - ----- + ----- - ------ + ...
 		 2*3*4   4*5*6   6*7*8   8*9*10
 
+Gauss-Legendre Algorithm
+An iteration of arithmetic and geometric means, due to Gauss and Legendre, and rediscovered
+by Salamin and Brent in 1975, which doubles the number of correct digits in each step:
+
+a = 1, b = 1/sqrt(2), t = 1/4, p = 1
+a' = (a + b)/2, b' = sqrt(a*b), t' = t - p*(a - a')^2, p' = 2p
+
+pi ~= (a + b)^2 / (4t)
+
 */
 
 // best practice for C++ is to assign a literal
@@ -151,6 +162,27 @@ Real MethodOfViete(size_t N) {
 	 return pi;
  }
 
+template<typename Real>
+Real MethodOfGaussLegendre(size_t N) {
+	using namespace sw::unum;
+	Real a = Real(1), b = Real(1) / sqrt(Real(2)), t = Real(1) / Real(4), p = Real(1);
+	for (size_t i = 0; i < N; ++i) {
+		Real next = (a + b) / Real(2);
+		b = sqrt(a * b);
+		t = t - p * (a - next) * (a - next);
+		p = Real(2) * p;
+		a = next;
+	}
+	return (a + b) * (a + b) / (Real(4) * t);
+}
+
+// number of leading characters that two decimal strings have in common
+size_t CommonPrefix(const std::string& a, const std::string& b) {
+	size_t n = 0;
+	while (n < a.size() && n < b.size() && a[n] == b[n]) ++n;
+	return n;
+}
+
 int main(int argc, char** argv)
 try {
 	using namespace std;
@@ -193,8 +225,31 @@ try {
 	cout << "ref = " << pi50 << endl;
 	cout << "pi  = " << setprecision(20) << MethodOfNilakantha<Real>(N) << endl;
 
+	// the series in 256-bit mpfloat show the truncation errors of the methods rather than the rounding errors
+	N = 1000;
+	cout << "Series using " << N << " iterations in mpfloat with " << mpfloat::default_precision() << " bits of precision" << endl;
+	cout << "ref = " << pi50 << endl;
+	cout << "pi  = " << setprecision(50) << MethodOfViete<mpfloat>(100) << "  Viete, 100 iterations" << endl;
+	cout << "pi  = " << setprecision(50) << MethodOfWallis<mpfloat>(N) << "  Wallis" << endl;
+	cout << "pi  = " << setprecision(50) << MethodOfMadhavaOfSangamagrama<mpfloat>(N) << "  Madhava" << endl;
+	cout << "pi  = " << setprecision(50) << MethodOfNilakantha<mpfloat>(N) << "  Nilakantha" << endl;
 
 	// 1000 digits -> 1.e1000 -> 2^3322 -> 1.051103774764883380737596422798e+1000 -> you will need 3322 bits to represent 1000 digits of pi
+	// with guard bits for the rounding errors of the iteration
+	mpfloat::set_default_precision(3400);
+	N = 12;
+	mpfloat mppi = MethodOfGaussLegendre<mpfloat>(N);
+	std::string digits = mppi.str(1010);
+	size_t correct = CommonPrefix(digits, pi1000) - 1;  // the decimal point is not a digit
+	cout << "Gauss-Legendre using " << N << " iterations in mpfloat with " << mppi.precision() << " bits of precision" << endl;
+	cout << "pi  = " << digits.substr(0, 60) << "..." << endl;
+	cout << "correct digits of pi: " << correct << (correct >= 1000 ? "  PASS" : "  FAIL") << endl;
+	if (correct < 1000) ++nrOfFailedTestCases;
+
+	// the reference value rounds once to a posit
+	posit<64, 3> p64;
+	convert(mppi, p64);
+	cout << "posit<64,3> rounding of pi : " << setprecision(20) << p64 << endl;
 
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
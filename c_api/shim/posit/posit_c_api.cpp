@@ -13,14 +13,15 @@
 // POSIT_ENABLE_LITERALS
 // Disable exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 0
-// Disable standard posit specializations for the shim
+// Disable standard posit specializations for the shim,
+// except for the wide posits, which marshal their limbs directly
 #define POSIT_FAST_POSIT_4_0   0
 #define POSIT_FAST_POSIT_8_0   0
 #define POSIT_FAST_POSIT_16_1  0
 #define POSIT_FAST_POSIT_32_2  0
 #define POSIT_FAST_POSIT_64_3  0
-#define POSIT_FAST_POSIT_128_4 0
-#define POSIT_FAST_POSIT_256_5 0
+#define POSIT_FAST_POSIT_128_4 1
+#define POSIT_FAST_POSIT_256_5 1
 // Now include the C++ library
 #include <universal/posit/posit>
 
@@ -130,6 +131,28 @@ template<size_t nbits, size_t es, class positN_t> class convert_bytes : convert<
 	}
 };
 
+// convert_limbs copies the bytes of a positN_t into the 64-bit limbs of the fast wide posits
+template<size_t nbits, size_t es, class positN_t> class convert_limbs : convert<nbits,es,positN_t> {
+	public:
+	static sw::unum::posit<nbits, es> decode(positN_t bits) {
+		sw::unum::posit<nbits, es> pa;
+		for (size_t i = 0; i < nbits / 64; ++i) {
+			uint64_t limb = 0;
+			for (size_t b = 0; b < 8; ++b) limb |= uint64_t(bits.x[8 * i + b]) << (8 * b);
+			pa.setword(i, limb);
+		}
+		return pa;
+	}
+	static positN_t encode(sw::unum::posit<nbits, es> p) {
+		positN_t out;
+		for (size_t i = 0; i < nbits / 64; ++i) {
+			uint64_t limb = p.word(i);
+			for (size_t b = 0; b < 8; ++b) out.x[8 * i + b] = (unsigned char)(limb >> (8 * b));
+		}
+		return out;
+	}
+};
+
 // operation<2,1> = 2 args, 1 result
 template<size_t nbits, size_t es> class operation21 {
 	public:
@@ -266,8 +289,8 @@ typedef capi<8,0,posit8_t,posit8x2_t,convert_bytes<8,0,posit8_t>> capi8;
 typedef capi<16,1,posit16_t,posit16x2_t,convert_bytes<16,1,posit16_t>> capi16;
 typedef capi<32,2,posit32_t,posit32x2_t,convert_bytes<32,2,posit32_t>> capi32;
 typedef capi<64,3,posit64_t,posit64x2_t,convert_bytes<64,3,posit64_t>> capi64;
-typedef capi<128,4,posit128_t,posit128x2_t,convert_bytes<128,4,posit128_t>> capi128;
-typedef capi<256,5,posit256_t,posit256x2_t,convert_bytes<256,5,posit256_t>> capi256;
+typedef capi<128,4,posit128_t,posit128x2_t,convert_limbs<128,4,posit128_t>> capi128;
+typedef capi<256,5,posit256_t,posit256x2_t,convert_limbs<256,5,posit256_t>> capi256;
 
 // prevent any symbol mangling
 extern "C" {
@@ -180,7 +180,8 @@ int main(int argc, char* argv[])
 		double da, dref;
 		da = posit16_tod(pa);
 		dref = exp(da);
-		posit16_t pref = posit16_fromd(dref);
+		// exp saturates to maxpos where the double reference overflows to inf
+		posit16_t pref = isinf(dref) ? posit16_reinterpret(0x7fff) : posit16_fromd(dref);
 		if (posit16_cmp(pref, pc)) {
 			if (dref > 0.0) {
 			    printf("FAIL: exp(16.1x%04xp) produced 16.1x%04xp instead of 16.1x%04xp\n",
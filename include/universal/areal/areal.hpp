@@ -5,58 +5,137 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
 #include <limits>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <type_traits>
+#include <utility>
 
 #include <universal/native/ieee-754.hpp>
 #include <universal/blockbin/blockbinary.hpp>
+#include <universal/areal/exceptions.hpp>
+
+// configurations of up to 32 bits compute with native 64-bit integers,
+// wider configurations, or all configurations when set to 0, compute with blockbinary significands
+#if !defined(AREAL_FAST_SPECIALIZATION)
+#define AREAL_FAST_SPECIALIZATION 1
+#endif
 
 namespace sw {	namespace unum {
-		
+
+/*
+ An areal is a faithful floating-point number with an uncertainty bit, the ubit, as its least significant bit:
+
+     [ sign | exponent (es bits) | fraction (fbits bits) | ubit ]
+
+ The exponent is biased by 2^(es-1) - 1, an exponent field of zero encodes the subnormals. With the ubit clear
+ the encoding is an exact value, with the ubit set it is the open interval between that exact value and the
+ next exact value away from zero. The two encodings with all exponent and fraction bits set are special:
+ with the ubit clear they are +-inf, with the ubit set NaN. The encoding just below infinity, maxpos with
+ the ubit set, is the interval (maxpos, inf), and zero with the ubit set is the interval (0, minpos).
+
+ Arithmetic on exact values truncates the exact result toward zero and sets the ubit when any bits were
+ discarded, so the encoded interval contains the exact result. An uncertain operand is the interval between
+ its exact bounds: the operation is carried out on the lower and upper bounds of the operands, each bound of
+ the result is rounded outward to the encoding that holds it, and the result is the one encoding that
+ encloses the interval between them. An interval that spans an exact value, or more than one encoding,
+ has no enclosing areal and yields NaN. An exact zero or infinity that absorbs the other operand, such as
+ 0 * x or inf + x, yields an exact result.
+ */
+
 // Forward definitions
 template<size_t nbits, size_t es, typename bt> class areal;
 template<size_t nbits, size_t es, typename bt> areal<nbits,es,bt> abs(const areal<nbits,es,bt>& v);
 
-template<size_t nbits, size_t es, typename bt>
-void extract_fields(const blockbinary<nbits, bt>& raw_bits, bool& _sign, blockbinary<es, bt>& _exponent, blockbinary<nbits - es - 1, bt>& _fraction) {
-
+namespace internal {
+
+// The areal arithmetic is written once against a significand word: a native 64-bit integer
+// for configurations up to 32 bits, and a blockbinary wide enough for a product for the others.
+// The words hold non-negative values only.
+
+// position of the most significant bit, -1 if s == 0
+inline int significand_msb(uint64_t s) { return s ? 63 - limb_clz(s) : -1; }
+template<size_t W, typename bt>
+inline int significand_msb(const blockbinary<W, bt>& s) { return s.msb(); }
+
+inline bool significand_iszero(uint64_t s) { return s == 0; }
+template<size_t W, typename bt>
+inline bool significand_iszero(const blockbinary<W, bt>& s) { return s.iszero(); }
+
+// the lower 64 bits of a significand
+inline uint64_t significand_low(uint64_t s) { return s; }
+template<size_t W, typename bt>
+inline uint64_t significand_low(const blockbinary<W, bt>& s) {
+	constexpr size_t bitsInBlock = blockbinary<W, bt>::bitsInBlock;
+	uint64_t low = 0;
+	for (size_t i = 0; i < blockbinary<W, bt>::nrBlocks && i * bitsInBlock < 64; ++i) {
+		low |= uint64_t(s.block(i)) << (i * bitsInBlock);
+	}
+	return low;
 }
 
-// fill an areal object with mininum positive value
-template<size_t nbits, size_t es, typename bt>
-areal<nbits, es, bt>& minpos(areal<nbits, es, bt>& aminpos) {
-
-	return aminpos;
+// block i of a significand, in blocks of the storage type
+template<typename bt>
+inline bt significand_block(uint64_t s, size_t i) {
+	constexpr size_t bitsInBlock = sizeof(bt) * 8;
+	return (i * bitsInBlock < 64) ? bt(s >> (i * bitsInBlock)) : bt(0);
 }
-// fill an areal object with maximum positive value
-template<size_t nbits, size_t es, typename bt>
-areal<nbits, es, bt>& maxpos(areal<nbits, es, bt>& amaxpos) {
-
-	return amaxpos;
+template<typename bt, size_t W>
+inline bt significand_block(const blockbinary<W, bt>& s, size_t i) {
+	return (i < blockbinary<W, bt>::nrBlocks) ? s.block(i) : bt(0);
 }
-// fill an areal object with mininum negative value
-template<size_t nbits, size_t es, typename bt>
-areal<nbits, es, bt>& minneg(areal<nbits, es, bt>& aminneg) {
 
-	return aminneg;
+// shift right by n bits and return true when nonzero bits were shifted out
+inline bool significand_shift_right(uint64_t& s, int n) {
+	if (n <= 0) return false;
+	if (n >= 64) {
+		bool sticky = (s != 0);
+		s = 0;
+		return sticky;
+	}
+	bool sticky = (s & ((uint64_t(1) << n) - 1)) != 0;
+	s >>= n;
+	return sticky;
 }
-// fill an areal object with maximum negative value
-template<size_t nbits, size_t es, typename bt>
-areal<nbits, es, bt>& maxneg(areal<nbits, es, bt>& amaxneg) {
-
-	return amaxneg;
+template<size_t W, typename bt>
+inline bool significand_shift_right(blockbinary<W, bt>& s, int n) {
+	if (n <= 0) return false;
+	blockbinary<W, bt> shifted(s);
+	shifted >>= n;
+	blockbinary<W, bt> restored(shifted);
+	restored <<= n;
+	bool sticky = (restored != s);
+	s = shifted;
+	return sticky;
 }
 
-// template class representing a value in scientific notation, using a template size for the number of fraction bits
+} // namespace internal
+
+// template class representing an arbitrary linear floating-point value with an uncertainty bit
 template<size_t nbits, size_t es, typename bt = uint8_t>
 class areal {
 public:
-	static constexpr size_t fbits  = nbits - 1 - es;    // number of fraction bits excluding the hidden bit
+	static_assert(es >= 1 && es <= 30, "areal exponent field must be between 1 and 30 bits");
+	static_assert(nbits >= es + 3, "areal requires at least one fraction bit");
+	static constexpr size_t fbits  = nbits - 2 - es;    // number of fraction bits excluding the hidden bit
 	static constexpr size_t fhbits = fbits + 1;         // number of fraction bits including the hidden bit
-	static constexpr size_t abits = fhbits + 3;         // size of the addend
+	static constexpr size_t abits = fhbits + 3;         // size of the addend: hidden bit, fraction, guard, round and sticky
 	static constexpr size_t mbits = 2 * fhbits;         // size of the multiplier output
-	static constexpr size_t divbits = 3 * fhbits + 4;   // size of the divider output
-
-	areal() {}
+	static constexpr size_t divbits = 2 * fhbits + 2;   // size of the dividend
+	static constexpr int bias = (1 << (es - 1)) - 1;
+	static constexpr int max_exponent_field = (1 << es) - 1;
+	static constexpr int min_normal_scale = 1 - bias;
+	static constexpr int max_scale = max_exponent_field - bias;
+	// size of the significand word of the reference arithmetic: it holds an encoding, a product, and a dividend
+	static constexpr size_t sbits = (nbits + 1 > divbits + 2 ? nbits + 1 : divbits + 2);
+	static constexpr bool fast = AREAL_FAST_SPECIALIZATION && nbits <= 32;
+	using Significand = typename std::conditional<fast, uint64_t, blockbinary<sbits, bt> >::type;
+
+	constexpr areal() noexcept {}
 
 	areal(signed char initial_value)        { *this = initial_value; }
 	areal(short initial_value)              { *this = initial_value; }
@@ -66,9 +145,10 @@ public:
 	areal(float initial_value)              { *this = initial_value; }
 	areal(double initial_value)             { *this = initial_value; }
 	areal(long double initial_value)        { *this = initial_value; }
-	areal(const areal& rhs)                 { *this = rhs; }
+	constexpr areal(const areal& rhs) noexcept : _bits(rhs._bits) {}
 
 	// assignment operators
+	areal& operator=(const areal&) = default;
 	areal& operator=(signed char rhs) {
 		return *this = (long long)(rhs);
 	}
@@ -79,58 +159,108 @@ public:
 		return *this = (long long)(rhs);
 	}
 	areal& operator=(long long rhs) {
+		bool negative = rhs < 0;
+		// negate in the unsigned domain so that the most negative value is representable
+		uint64_t magnitude = negative ? uint64_t(0) - uint64_t(rhs) : uint64_t(rhs);
+		store(round(negative, 0, magnitude, false));
 		return *this;
 	}
 	areal& operator=(unsigned long long rhs) {
+		store(round(false, 0, uint64_t(rhs), false));
 		return *this;
 	}
 	areal& operator=(float rhs) {
-
-		return *this;
+		return *this = double(rhs);
 	}
 	areal& operator=(double rhs) {
-
+		// decode the IEEE-754 fields directly: this is the common conversion
+		uint64_t raw;
+		std::memcpy(&raw, &rhs, sizeof(raw));
+		bool negative = (raw >> 63) != 0;
+		int exponent = int((raw >> 52) & 0x7FF);
+		uint64_t fraction = raw & 0x000FFFFFFFFFFFFFull;
+		if (exponent == 0x7FF) {
+			if (fraction) setnan(); else setinf(negative);
+		}
+		else if (exponent == 0) {
+			store(round(negative, -1074, fraction, false));
+		}
+		else {
+			store(round(negative, exponent - 1075, fraction | (uint64_t(1) << 52), false));
+		}
 		return *this;
 	}
 	areal& operator=(long double rhs) {
-
+		if (std::isnan(rhs)) {
+			setnan();
+		}
+		else if (std::isinf(rhs)) {
+			setinf(std::signbit(rhs));
+		}
+		else if (rhs == 0) {
+			setzero();
+			_bits.set(nbits - 1, std::signbit(rhs));
+		}
+		else {
+			// the significand of the widest IEEE type fits in 64 bits
+			int exponent;
+			long double fraction = std::frexp(std::fabs(rhs), &exponent);
+			uint64_t significand = uint64_t(std::ldexp(fraction, 64));
+			store(round(std::signbit(rhs), exponent - 64, significand, false));
+		}
 		return *this;
 	}
 
 	// arithmetic operators
 	// prefix operator
-	areal operator-() const {				
-		return *this;
+	areal operator-() const {
+		areal negated(*this);
+		negated._bits.set(nbits - 1, !sign());
+		return negated;
 	}
 
 	areal& operator+=(const areal& rhs) {
+		store(add(encoding(), rhs.encoding(), false));
 		return *this;
 	}
 	areal& operator+=(double rhs) {
 		return *this += areal(rhs);
 	}
 	areal& operator-=(const areal& rhs) {
-
+		store(add(encoding(), rhs.encoding(), true));
 		return *this;
 	}
 	areal& operator-=(double rhs) {
-		return *this -= areal<nbits, es>(rhs);
+		return *this -= areal(rhs);
 	}
 	areal& operator*=(const areal& rhs) {
-
+		store(mul(encoding(), rhs.encoding()));
 		return *this;
 	}
 	areal& operator*=(double rhs) {
-		return *this *= areal<nbits, es>(rhs);
+		return *this *= areal(rhs);
 	}
 	areal& operator/=(const areal& rhs) {
-
+		store(div(encoding(), rhs.encoding()));
 		return *this;
 	}
 	areal& operator/=(double rhs) {
-		return *this /= areal<nbits, es>(rhs);
+		return *this /= areal(rhs);
 	}
+	// increment and decrement step through the encodings: exact values and the intervals between them alternate
 	areal& operator++() {
+		if (isnan() || (isinf() && !sign())) return *this;
+		Significand r = encoding();
+		if (!sign()) {
+			r = r + Significand(1);
+		}
+		else if (!internal::significand_iszero(magnitude())) {
+			r = r - Significand(1);
+		}
+		else {
+			r = Significand(1);  // -0 steps to (0, minpos)
+		}
+		store(r);
 		return *this;
 	}
 	areal operator++(int) {
@@ -139,6 +269,9 @@ public:
 		return tmp;
 	}
 	areal& operator--() {
+		*this = -*this;
+		operator++();
+		*this = -*this;
 		return *this;
 	}
 	areal operator--(int) {
@@ -148,26 +281,67 @@ public:
 	}
 
 	// modifiers
-	void reset() {	}
+	constexpr void reset() noexcept { _bits.clear(); }
+	constexpr void setzero() noexcept { _bits.clear(); }
+	constexpr void setinf(bool negative = false) { setspecial(negative); }
+	constexpr void setnan(bool signalling = false) { setspecial(signalling); _bits.set(0); }
+	void setubit(bool uncertain = true) {
+		if (isnan() || isinf() || ubit() == uncertain) return;
+		store(uncertain ? encoding() + Significand(1) : encoding() - Significand(1));
+	}
+	constexpr void set_raw_bits(uint64_t raw) noexcept { _bits.set_raw_bits(raw); }
+	// maximum and minimum magnitudes of exact values: maxpos is two encodings below infinity
+	constexpr areal& maxpos(bool negative = false) { setspecial(negative); _bits.reset(1); return *this; }
+	constexpr areal& minpos(bool negative = false) { _bits.clear(); _bits.set(1); _bits.set(nbits - 1, negative); return *this; }
+	// the exact value 2^scale, scale in [min_normal_scale - fbits, max_scale]
+	constexpr areal& pow2(int scale, bool negative = false) {
+		_bits.clear();
+		if (scale >= min_normal_scale) {
+			int exponent = scale + bias;
+			for (size_t i = 0; i < es; ++i) _bits.set(1 + fbits + i, (exponent >> i) & 1);
+		}
+		else {
+			_bits.set(1 + size_t(scale - (min_normal_scale - int(fbits))));
+		}
+		_bits.set(nbits - 1, negative);
+		return *this;
+	}
 
 	// selectors
-	inline bool isneg() const { return false; }
-	inline bool iszero() const { return false; }
-	inline bool isinf() const { return false; }
-	inline bool isnan() const { return false; }
-	inline bool sign() const { return false; }
-	inline int scale() const { return false; }
-	inline std::string get() const { return std::string("tbd"); }
-
+	inline bool sign() const { return _bits.test(nbits - 1); }
+	inline bool isneg() const { return sign(); }
+	inline bool iszero() const { Significand m = magnitude(); m >>= 1; return internal::significand_iszero(m); }
+	inline bool isinf() const { return isspecial() && !_bits.test(0); }
+	inline bool isnan() const { return isspecial() && _bits.test(0); }
+	inline bool ubit() const { return _bits.test(0) && !isnan(); }
+	inline bool isexact() const { return !_bits.test(0); }
+	inline int scale() const {
+		unpacked v = decode(encoding());
+		return (v.zero || v.inf || v.nan) ? 0 : v.scale;
+	}
+	inline blockbinary<nbits, bt> get() const { return _bits; }
 
 	long double to_long_double() const {
-		return 0.0l;
+		unpacked v = decode(encoding());
+		if (v.nan) return std::numeric_limits<long double>::quiet_NaN();
+		if (v.inf) return v.sign ? -std::numeric_limits<long double>::infinity() : std::numeric_limits<long double>::infinity();
+		long double magnitude = 0.0l;
+		if (!v.zero) {
+			// keep the upper 64 bits of wide significands
+			int lsb_scale = v.scale - int(fbits);
+			if (fhbits > 64) {
+				internal::significand_shift_right(v.significand, int(fhbits) - 64);
+				lsb_scale += int(fhbits) - 64;
+			}
+			magnitude = std::ldexp((long double)(internal::significand_low(v.significand)), lsb_scale);
+		}
+		return v.sign ? -magnitude : magnitude;
 	}
 	double to_double() const {
-		return 0.0;
+		return double(to_long_double());
 	}
 	float to_float() const {
-		return 0.0f;
+		return float(to_long_double());
 	}
 	// Maybe remove explicit
 	explicit operator long double() const { return to_long_double(); }
@@ -175,6 +349,352 @@ public:
 	explicit operator float() const { return to_float(); }
 
 private:
+	blockbinary<nbits, bt> _bits;
+
+	// an areal decoded into sign, scale, and a significand with its most significant bit at position fbits
+	struct unpacked {
+		bool sign, ubit, zero, inf, nan;
+		int scale;
+		Significand significand;
+	};
+
+	static constexpr size_t bitsInBlock = blockbinary<nbits, bt>::bitsInBlock;
+
+	// +-inf: exponent and fraction all ones, ubit clear
+	constexpr void setspecial(bool negative) {
+		_bits.clear();
+		for (size_t i = 1; i < nbits - 1; ++i) _bits.set(i);
+		_bits.set(nbits - 1, negative);
+	}
+	static constexpr size_t nrBlocks = blockbinary<nbits, bt>::nrBlocks;
+
+	Significand encoding() const {
+		Significand r(0);
+		for (int i = int(nrBlocks) - 1; i >= 0; --i) {
+			r <<= int(bitsInBlock);
+			r = r + Significand(_bits.block(size_t(i)));
+		}
+		return r;
+	}
+	void store(const Significand& r) {
+		for (size_t i = 0; i < nrBlocks; ++i) _bits.setblock(i, internal::significand_block<bt>(r, i));
+	}
+	// the encoding without the sign bit
+	Significand magnitude() const {
+		Significand r = encoding();
+		if (sign()) {
+			Significand signbit(1);
+			signbit <<= int(nbits - 1);
+			r = r - signbit;
+		}
+		return r;
+	}
+	// exponent and fraction all ones
+	bool isspecial() const {
+		Significand m = magnitude();
+		m >>= 1;
+		m = m + Significand(1);
+		return internal::significand_msb(m) == int(nbits) - 2;
+	}
+
+	// assemble an encoding from its fields: the fraction excludes the hidden bit
+	static Significand assemble(bool negative, int exponent, const Significand& fraction, bool ubit) {
+		Significand r(negative ? 1 : 0);
+		r <<= int(es);
+		r = r + Significand(exponent);
+		r <<= int(fbits);
+		r = r + fraction;
+		r <<= 1;
+		return ubit ? r + Significand(1) : r;
+	}
+	static Significand allones_fraction() {
+		Significand f(1);
+		f <<= int(fbits);
+		return f - Significand(1);
+	}
+	// +-inf, or NaN
+	static Significand special(bool negative, bool nan) {
+		return assemble(negative, max_exponent_field, allones_fraction(), nan);
+	}
+	// the interval (maxpos, inf)
+	static Significand overflow(bool negative) {
+		return assemble(negative, max_exponent_field, allones_fraction() - Significand(1), true);
+	}
+
+	static unpacked decode(const Significand& r) {
+		unpacked v;
+		Significand signbit(r);
+		signbit >>= int(nbits - 1);
+		v.sign = (internal::significand_low(signbit) & 1) != 0;
+		v.ubit = (internal::significand_low(r) & 1) != 0;
+		Significand field(r);
+		field >>= 1;
+		Significand upper(field);
+		upper >>= int(fbits);
+		int exponent = int(internal::significand_low(upper) & uint64_t(max_exponent_field));
+		upper <<= int(fbits);
+		Significand fraction = field - upper;
+		v.zero = v.inf = v.nan = false;
+		v.scale = 0;
+		if (exponent == max_exponent_field && fraction == allones_fraction()) {
+			v.inf = !v.ubit;
+			v.nan = v.ubit;
+		}
+		else if (exponent == 0) {
+			if (internal::significand_iszero(fraction)) {
+				v.zero = true;
+			}
+			else {
+				// normalize the subnormal
+				int shift = int(fbits) - internal::significand_msb(fraction);
+				fraction <<= shift;
+				v.scale = min_normal_scale - shift;
+			}
+		}
+		else {
+			Significand hidden(1);
+			hidden <<= int(fbits);
+			fraction = fraction + hidden;
+			v.scale = exponent - bias;
+		}
+		v.significand = fraction;
+		return v;
+	}
+
+	// encode the value significand * 2^lsb_scale, truncated toward zero: discarded bits and sticky set the ubit
+	static Significand encode(bool negative, int lsb_scale, Significand significand, bool sticky) {
+		int msb = internal::significand_msb(significand);
+		if (msb < 0) return assemble(negative, 0, Significand(0), sticky);
+		int scale = lsb_scale + msb;
+		if (msb > int(fbits)) {
+			sticky |= internal::significand_shift_right(significand, msb - int(fbits));
+		}
+		else {
+			significand <<= int(fbits) - msb;
+		}
+		if (scale > max_scale) return overflow(negative);
+		int exponent;
+		if (scale < min_normal_scale) {
+			sticky |= internal::significand_shift_right(significand, min_normal_scale - scale);
+			exponent = 0;
+		}
+		else {
+			Significand hidden(1);
+			hidden <<= int(fbits);
+			significand = significand - hidden;
+			exponent = scale + bias;
+		}
+		if (exponent == max_exponent_field && significand == allones_fraction()) return overflow(negative);
+		return assemble(negative, exponent, significand, sticky);
+	}
+	// encode a 64-bit significand of a native value
+	static Significand round(bool negative, int lsb_scale, uint64_t significand, bool sticky) {
+		// reduce the significand to the precision of the significand word before transferring it
+		int msb = internal::significand_msb(significand);
+		if (msb > int(fhbits)) {
+			sticky |= internal::significand_shift_right(significand, msb - int(fhbits));
+			lsb_scale += msb - int(fhbits);
+		}
+		// transfer in halves: the blockbinary word is signed
+		Significand s((long long)(significand >> 32));
+		s <<= 32;
+		s = s + Significand((long long)(significand & 0xFFFFFFFFull));
+		return encode(negative, lsb_scale, s, sticky);
+	}
+	// re-encode an exact unpacked value
+	static Significand encode(const unpacked& v, bool negative) {
+		if (v.zero) return assemble(negative, 0, Significand(0), false);
+		return encode(negative, v.scale - int(fbits), v.significand, false);
+	}
+	static Significand zero(bool negative) {
+		return assemble(negative, 0, Significand(0), false);
+	}
+	// the encoding with the sign flipped
+	static Significand negate(const Significand& r) {
+		Significand signbit(1);
+		signbit <<= int(nbits - 1);
+		Significand upper(r);
+		upper >>= int(nbits - 1);
+		return internal::significand_iszero(upper) ? r + signbit : r - signbit;
+	}
+
+	// the arithmetic on exact values: the encoding that holds the exact result
+	static Significand exact_add(const unpacked& a, const unpacked& b, bool subtract) {
+		bool bsign = b.sign != subtract;
+		if (a.nan || b.nan) return special(false, true);
+		if (a.inf || b.inf) {
+			if (a.inf && b.inf && a.sign != bsign) return special(false, true);
+			return special(a.inf ? a.sign : bsign, false);
+		}
+		if (a.zero && b.zero) return zero(a.sign && bsign);
+		if (b.zero) return encode(a, a.sign);
+		if (a.zero) return encode(b, bsign);
+
+		// align the operand with the smaller scale to the one with the larger scale
+		bool swap = b.scale > a.scale;
+		const unpacked& x = swap ? b : a;
+		const unpacked& y = swap ? a : b;
+		bool xsign = swap ? bsign : a.sign;
+		bool ysign = swap ? a.sign : bsign;
+		Significand lhs(x.significand), rhs(y.significand);
+		lhs <<= 3;
+		rhs <<= 3;
+		// jam the bits shifted out into the sticky bit
+		if (internal::significand_shift_right(rhs, x.scale - y.scale) && !(internal::significand_low(rhs) & 1)) rhs = rhs + Significand(1);
+
+		Significand sum;
+		bool negative = xsign;
+		if (xsign == ysign) {
+			sum = lhs + rhs;
+		}
+		else if (rhs < lhs) {
+			sum = lhs - rhs;
+		}
+		else {
+			sum = rhs - lhs;
+			negative = ysign;
+			if (internal::significand_iszero(sum)) negative = false;
+		}
+		return encode(negative, x.scale - int(fbits) - 3, sum, false);
+	}
+
+	static Significand exact_mul(const unpacked& a, const unpacked& b) {
+		bool negative = a.sign != b.sign;
+		if (a.nan || b.nan) return special(false, true);
+		if (a.inf || b.inf) {
+			if (a.zero || b.zero) return special(false, true);
+			return special(negative, false);
+		}
+		if (a.zero || b.zero) return zero(negative);
+		Significand product = a.significand * b.significand;
+		return encode(negative, a.scale + b.scale - 2 * int(fbits), product, false);
+	}
+
+	static Significand exact_div(const unpacked& a, const unpacked& b) {
+		bool negative = a.sign != b.sign;
+		if (a.nan || b.nan) return special(false, true);
+		if (a.inf) return b.inf ? special(false, true) : special(negative, false);
+		if (b.inf) return zero(negative);
+		if (b.zero) {
+#if AREAL_THROW_ARITHMETIC_EXCEPTION
+			throw areal_divide_by_zero();
+#else
+			return a.zero ? special(false, true) : special(negative, false);
+#endif
+		}
+		if (a.zero) return zero(negative);
+		// a quotient of at least fhbits + 2 bits, and the remainder for the sticky bit
+		Significand dividend(a.significand);
+		dividend <<= int(fhbits) + 2;
+		Significand quotient = dividend / b.significand;
+		Significand remainder = dividend - quotient * b.significand;
+		return encode(negative, a.scale - b.scale - int(fhbits) - 2, quotient, !internal::significand_iszero(remainder));
+	}
+
+	// the arithmetic on intervals: a bound of an interval is an exact value, and open or closed
+	struct bound {
+		unpacked v;
+		bool open;
+	};
+	// the bounds of an encoding: an exact value is the closed interval [v, v], an uncertain value the open
+	// interval between its exact value and the next exact value away from zero
+	static void bounds(const Significand& r, bound& lo, bound& hi) {
+		unpacked v = decode(r);
+		if (!v.ubit) {
+			lo.v = hi.v = v;
+			lo.open = hi.open = false;
+			return;
+		}
+		v.ubit = false;
+		unpacked next = decode(r + Significand(1));
+		lo.v = v.sign ? next : v;
+		hi.v = v.sign ? v : next;
+		lo.open = hi.open = true;
+	}
+	// the bounds of the magnitudes of a value that is neither an exact zero nor an infinity: its interval does not hold zero
+	static void magnitude_bounds(const Significand& r, bound& lo, bound& hi) {
+		bounds(r, lo, hi);
+		if (lo.v.sign) std::swap(lo, hi);
+		lo.v.sign = hi.v.sign = false;
+	}
+	// the encoding that encloses the interval between the encodings that hold its bounds: a bound that is open
+	// and exact steps inward to the interval next to it; NaN when no single encoding encloses the interval
+	static Significand enclose(const Significand& lo, bool lo_open, const Significand& hi, bool hi_open) {
+		areal l, h;
+		l.store(lo);
+		h.store(hi);
+		if (lo_open && l.isexact()) ++l;
+		if (hi_open && h.isexact()) --h;
+		return (l == h) ? l.encoding() : special(false, true);
+	}
+	// the interval of the magnitudes [lo, hi] with a sign
+	static Significand enclose_signed(bool negative, const Significand& lo, bool lo_open, const Significand& hi, bool hi_open) {
+		return negative ? enclose(negate(hi), hi_open, negate(lo), lo_open) : enclose(lo, lo_open, hi, hi_open);
+	}
+
+	static Significand add(const Significand& ra, const Significand& rb, bool subtract) {
+		unpacked a = decode(ra), b = decode(rb);
+		if (!a.ubit && !b.ubit) return exact_add(a, b, subtract);
+		if (a.nan || b.nan) return special(false, true);
+		// an infinity absorbs an uncertain operand, which holds finite values only
+		if (a.inf) return special(a.sign, false);
+		if (b.inf) return special(b.sign != subtract, false);
+		bound alo, ahi, blo, bhi;
+		bounds(ra, alo, ahi);
+		bounds(rb, blo, bhi);
+		if (subtract) {
+			// a - b is a + [-bhi, -blo]
+			std::swap(blo, bhi);
+			blo.v.sign = !blo.v.sign;
+			bhi.v.sign = !bhi.v.sign;
+		}
+		return enclose(exact_add(alo.v, blo.v, false), alo.open || blo.open, exact_add(ahi.v, bhi.v, false), ahi.open || bhi.open);
+	}
+
+	static Significand mul(const Significand& ra, const Significand& rb) {
+		unpacked a = decode(ra), b = decode(rb);
+		if (!a.ubit && !b.ubit) return exact_mul(a, b);
+		if (a.nan || b.nan) return special(false, true);
+		bool negative = a.sign != b.sign;
+		// an exact zero or infinity absorbs an uncertain operand, which holds neither
+		if (a.inf || b.inf) return special(negative, false);
+		if ((a.zero && !a.ubit) || (b.zero && !b.ubit)) return zero(negative);
+		bound alo, ahi, blo, bhi;
+		magnitude_bounds(ra, alo, ahi);
+		magnitude_bounds(rb, blo, bhi);
+		return enclose_signed(negative, exact_mul(alo.v, blo.v), alo.open || blo.open, exact_mul(ahi.v, bhi.v), ahi.open || bhi.open);
+	}
+
+	static Significand div(const Significand& ra, const Significand& rb) {
+		unpacked a = decode(ra), b = decode(rb);
+		if (!a.ubit && !b.ubit) return exact_div(a, b);
+		if (a.nan || b.nan) return special(false, true);
+		bool negative = a.sign != b.sign;
+		if (a.inf) return special(negative, false);
+		if (b.inf || (a.zero && !a.ubit)) return zero(negative);
+		if (b.zero && !b.ubit) {
+#if AREAL_THROW_ARITHMETIC_EXCEPTION
+			throw areal_divide_by_zero();
+#else
+			return special(negative, false);
+#endif
+		}
+		bound alo, ahi, blo, bhi;
+		magnitude_bounds(ra, alo, ahi);
+		magnitude_bounds(rb, blo, bhi);
+		// the quotient grows without bound as the divisor approaches zero
+		Significand hi = blo.v.zero ? special(false, false) : exact_div(ahi.v, blo.v);
+		return enclose_signed(negative, exact_div(alo.v, bhi.v), alo.open || bhi.open, hi, ahi.open || blo.open);
+	}
+
+	// compare the encodings as sign-magnitude integers
+	static bool less_than(const areal& lhs, const areal& rhs) {
+		if (lhs.isnan() || rhs.isnan()) return false;
+		Significand l = lhs.magnitude(), r = rhs.magnitude();
+		bool ls = lhs.sign(), rs = rhs.sign();
+		if (ls != rs) return ls && !(internal::significand_iszero(l) && internal::significand_iszero(r));
+		return ls ? (r < l) : (l < r);
+	}
 
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<size_t nnbits, size_t nes, typename nbt>
@@ -196,58 +716,96 @@ private:
 	friend bool operator>=(const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs);
 };
 
+// fill an areal object with mininum positive value
+template<size_t nbits, size_t es, typename bt>
+constexpr areal<nbits, es, bt>& minpos(areal<nbits, es, bt>& aminpos) {
+	return aminpos.minpos();
+}
+// fill an areal object with maximum positive value
+template<size_t nbits, size_t es, typename bt>
+constexpr areal<nbits, es, bt>& maxpos(areal<nbits, es, bt>& amaxpos) {
+	return amaxpos.maxpos();
+}
+// fill an areal object with mininum negative value
+template<size_t nbits, size_t es, typename bt>
+constexpr areal<nbits, es, bt>& minneg(areal<nbits, es, bt>& aminneg) {
+	return aminneg.minpos(true);
+}
+// fill an areal object with maximum negative value
+template<size_t nbits, size_t es, typename bt>
+constexpr areal<nbits, es, bt>& maxneg(areal<nbits, es, bt>& amaxneg) {
+	return amaxneg.maxpos(true);
+}
+
 ////////////////////// operators
+// exact values print as a number, uncertain values as the open interval they represent
 template<size_t nnbits, size_t nes, typename nbt>
 inline std::ostream& operator<<(std::ostream& ostr, const areal<nnbits,nes,nbt>& v) {
-
-	return ostr;
+	if (!v.ubit()) return ostr << v.to_long_double();
+	areal<nnbits, nes, nbt> lower(v), upper(v);
+	lower.setubit(false);
+	upper.setubit(false);
+	v.sign() ? --upper : ++upper;
+	v.sign() ? --upper : ++upper;
+	std::stringstream ss;
+	ss << std::setprecision(ostr.precision());
+	if (v.sign()) ss << '(' << upper.to_long_double() << ", " << lower.to_long_double() << ')';
+	else ss << '(' << lower.to_long_double() << ", " << upper.to_long_double() << ')';
+	return ostr << ss.str();
 }
 
 template<size_t nnbits, size_t nes, typename nbt>
-inline std::istream& operator>>(std::istream& istr, const areal<nnbits,nes,nbt>& v) {
-	istr >> v._fraction;
+inline std::istream& operator>>(std::istream& istr, areal<nnbits,nes,nbt>& v) {
+	long double value;
+	istr >> value;
+	v = value;
 	return istr;
 }
 
+// NaN is unordered and +0 equals -0, all other encodings compare as distinct values
 template<size_t nnbits, size_t nes, typename nbt>
-inline bool operator==(const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return false; }
+inline bool operator==(const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) {
+	if (lhs.isnan() || rhs.isnan()) return false;
+	if (lhs.iszero() && rhs.iszero() && lhs.isexact() && rhs.isexact()) return true;
+	return lhs._bits == rhs._bits;
+}
 template<size_t nnbits, size_t nes, typename nbt>
 inline bool operator!=(const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return !operator==(lhs, rhs); }
 template<size_t nnbits, size_t nes, typename nbt>
-inline bool operator< (const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return false; }
+inline bool operator< (const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return areal<nnbits, nes, nbt>::less_than(lhs, rhs); }
 template<size_t nnbits, size_t nes, typename nbt>
 inline bool operator> (const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return  operator< (rhs, lhs); }
 template<size_t nnbits, size_t nes, typename nbt>
-inline bool operator<=(const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return !operator> (lhs, rhs); }
+inline bool operator<=(const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return operator< (lhs, rhs) || operator==(lhs, rhs); }
 template<size_t nnbits, size_t nes, typename nbt>
-inline bool operator>=(const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return !operator< (lhs, rhs); }
+inline bool operator>=(const areal<nnbits,nes,nbt>& lhs, const areal<nnbits,nes,nbt>& rhs) { return operator< (rhs, lhs) || operator==(lhs, rhs); }
 
-// posit - posit binary arithmetic operators
+// areal - areal binary arithmetic operators
 // BINARY ADDITION
 template<size_t nbits, size_t es, typename bt>
 inline areal<nbits, es, bt> operator+(const areal<nbits, es, bt>& lhs, const areal<nbits, es, bt>& rhs) {
-	areal<nbits, es> sum(lhs);
+	areal<nbits, es, bt> sum(lhs);
 	sum += rhs;
 	return sum;
 }
 // BINARY SUBTRACTION
 template<size_t nbits, size_t es, typename bt>
 inline areal<nbits, es, bt> operator-(const areal<nbits, es, bt>& lhs, const areal<nbits, es, bt>& rhs) {
-	areal<nbits, es> diff(lhs);
+	areal<nbits, es, bt> diff(lhs);
 	diff -= rhs;
 	return diff;
 }
 // BINARY MULTIPLICATION
 template<size_t nbits, size_t es, typename bt>
 inline areal<nbits, es, bt> operator*(const areal<nbits, es, bt>& lhs, const areal<nbits, es, bt>& rhs) {
-	areal<nbits, es> mul(lhs);
+	areal<nbits, es, bt> mul(lhs);
 	mul *= rhs;
 	return mul;
 }
 // BINARY DIVISION
 template<size_t nbits, size_t es, typename bt>
 inline areal<nbits, es, bt> operator/(const areal<nbits, es, bt>& lhs, const areal<nbits, es, bt>& rhs) {
-	areal<nbits, es> ratio(lhs);
+	areal<nbits, es, bt> ratio(lhs);
 	ratio /= rhs;
 	return ratio;
 }
@@ -256,22 +814,26 @@ inline areal<nbits, es, bt> operator/(const areal<nbits, es, bt>& lhs, const are
 template<size_t nbits, size_t es, typename bt>
 inline std::string components(const areal<nbits,es,bt>& v) {
 	std::stringstream s;
-	if (v.iszero()) {
-		s << " zero b" << std::setw(nbits) << v.fraction();
+	if (v.isnan()) {
+		s << " nan b" << v.get();
+		return s.str();
+	}
+	else if (v.iszero()) {
+		s << " zero b" << v.get();
 		return s.str();
 	}
 	else if (v.isinf()) {
-		s << " infinite b" << std::setw(nbits) << v.fraction();
+		s << " infinite b" << v.get();
 		return s.str();
 	}
-	s << "(" << (v.sign() ? "-" : "+") << "," << v.scale() << "," << v.fraction() << ")";
+	s << "(" << (v.sign() ? "-" : "+") << "," << v.scale() << "," << (v.ubit() ? "inexact" : "exact") << ")";
 	return s.str();
 }
 
-/// Magnitude of a scientific notation value (equivalent to turning the sign bit off).
+/// Magnitude of an areal (equivalent to turning the sign bit off).
 template<size_t nbits, size_t es, typename bt>
-areal<nbits,es> abs(const areal<nbits,es,bt>& v) {
-	return areal<nbits,es>(false, v.scale(), v.fraction(), v.isZero());
+areal<nbits,es,bt> abs(const areal<nbits,es,bt>& v) {
+	return v.sign() ? -v : v;
 }
 
 
@@ -4,6 +4,17 @@
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// BITBLOCK_WORD_ARRAY selects the bitblock implementation:
+//   0: bitblock derives from std::bitset and the arithmetic helpers work one bit at a time (default)
+//   1: bitblock is a contiguous array of 64-bit words and the arithmetic helpers work a word at a time
+#if !defined(BITBLOCK_WORD_ARRAY)
+#define BITBLOCK_WORD_ARRAY 0
+#endif
+
+#if BITBLOCK_WORD_ARRAY
+#include <universal/bitblock/bitblock_v2.hpp>
+#else
 #include <sstream>
 #include <iostream>
 #include <iomanip>
@@ -717,3 +728,5 @@ bool anyAfter(const bitblock<nbits>& bits, int msb) {
 }
 
 }} // namespace sw::unum
+
+#endif // BITBLOCK_WORD_ARRAY
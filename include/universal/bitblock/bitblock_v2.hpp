@@ -1,648 +1,843 @@
 #pragma once
-//  bitblock.hpp : bitblock class
+//  bitblock_v2.hpp : bitblock class stored as a contiguous array of 64-bit words
 //
-// Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-
+#include <cstdint>
 #include <sstream>
-
-// this should be removed when we have made the transition away from std::bitset to sw::unum::bitblock
-#include <cassert>
-#include "ubb.h"
-
-
-namespace sw {
-	namespace unum {
-
-		/**
-		 @brief templated class implementing efficient multi-precision binary arithmetic and logic
-		 */
-		template<size_t nbits>
-		class bitblock : public universal_bitset::bitset<nbits> {
-		public:
-			bitblock() {
-				setzero();
-			}
-
-			bitblock(const bitblock&) = default;
-			bitblock(bitblock&&) = default;
-			bitblock& operator=(const bitblock&) = default;
-			bitblock& operator=(bitblock&&) = default;
-
-			// assignment operators for native types
-			bitblock& operator=(signed char rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this; }
-			bitblock& operator=(short rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this;	}
-			bitblock& operator=(int rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this; }
-			bitblock& operator=(long rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this; }
-			bitblock& operator=(long long rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this;	}
-			bitblock& operator=(char rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this; }
-			bitblock& operator=(unsigned short rhs) {universal_bitset::bitset<nbits>::operator=(rhs); return *this; }
-			bitblock& operator=(unsigned int rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this; }
-			bitblock& operator=(unsigned long rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this;	}
-			bitblock& operator=(unsigned long long rhs) { universal_bitset::bitset<nbits>::operator=(rhs); return *this; }
-
-			unsigned long long to_ullong() const {
-				return this->M_do_to_ullong();
-			}
-
-			void setzero() {
-				universal_bitset::bitset<nbits>::reset();
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+// bitblock exception definitions
+#include <universal/bitblock/exceptions.hpp>
+// word-level kernels: clz/ctz/popcount and multi-precision multiply and divide
+#include <universal/native/limb_arithmetic.hpp>
+
+// DO NOT USE DIRECTLY!
+// this implementation is selected by BITBLOCK_WORD_ARRAY in <universal/bitblock/bitblock.hpp>
+
+namespace sw { namespace unum {
+
+// bitblock is a template class implementing efficient multi-precision binary arithmetic and logic
+// The bits are stored in an array of 64-bit words, least significant word first, and the bits
+// beyond nbits in the most significant word are always zero. The API is the std::bitset API
+// that the std::bitset-based bitblock exposes, so that the two implementations are interchangeable.
+template<size_t nbits>
+class bitblock {
+public:
+	static constexpr size_t bitsInWord = 64;
+	static constexpr size_t nrWords = (nbits == 0 ? 1 : 1 + ((nbits - 1) / bitsInWord));
+	static constexpr size_t MSW = nrWords - 1;  // MSW == Most Significant Word
+	static constexpr uint64_t MSW_MASK = (nbits == 0 ? 0ull : (nbits % bitsInWord == 0 ? ~0ull : ((1ull << (nbits % bitsInWord)) - 1)));
+
+	// proxy to a single bit, the equivalent of std::bitset<nbits>::reference
+	class reference {
+	public:
+		reference(bitblock& bb, size_t pos) : _bb(&bb), _pos(pos) {}
+		reference(const reference&) = default;
+		reference& operator=(bool v) { _bb->setbit(_pos, v); return *this; }
+		reference& operator=(const reference& r) { _bb->setbit(_pos, bool(r)); return *this; }
+		operator bool() const { return _bb->getbit(_pos); }
+		bool operator~() const { return !_bb->getbit(_pos); }
+		reference& flip() { _bb->setbit(_pos, !_bb->getbit(_pos)); return *this; }
+	private:
+		bitblock* _bb;
+		size_t    _pos;
+	};
+
+	constexpr bitblock() : _word{} {}
+	constexpr explicit bitblock(unsigned long long rhs) : _word{} { _word[0] = rhs; _word[MSW] &= MSW_MASK; }
+
+	constexpr bitblock(const bitblock&) = default;
+	constexpr bitblock(bitblock&&) = default;
+
+	constexpr bitblock& operator=(const bitblock&) = default;
+	constexpr bitblock& operator=(bitblock&&) = default;
+
+	constexpr bitblock& operator=(unsigned long long rhs) {
+		for (size_t i = 0; i < nrWords; ++i) _word[i] = 0;
+		_word[0] = rhs;
+		_word[MSW] &= MSW_MASK;
+		return *this;
+	}
+
+	// bit access
+	constexpr bool operator[](size_t pos) const { return getbit(pos); }
+	reference operator[](size_t pos) { return reference(*this, pos); }
+	bool test(size_t pos) const {
+		if (pos >= nbits) throw std::out_of_range("bitblock::test: position out of range");
+		return getbit(pos);
+	}
+
+	// modifiers
+	bitblock& set() {
+		for (size_t i = 0; i < nrWords; ++i) _word[i] = ~0ull;
+		_word[MSW] &= MSW_MASK;
+		return *this;
+	}
+	bitblock& set(size_t pos, bool v = true) {
+		if (pos >= nbits) throw std::out_of_range("bitblock::set: position out of range");
+		setbit(pos, v);
+		return *this;
+	}
+	constexpr bitblock& reset() {
+		for (size_t i = 0; i < nrWords; ++i) _word[i] = 0;
+		return *this;
+	}
+	bitblock& reset(size_t pos) {
+		if (pos >= nbits) throw std::out_of_range("bitblock::reset: position out of range");
+		setbit(pos, false);
+		return *this;
+	}
+	bitblock& flip() {
+		for (size_t i = 0; i < nrWords; ++i) _word[i] = ~_word[i];
+		_word[MSW] &= MSW_MASK;
+		return *this;
+	}
+	bitblock& flip(size_t pos) {
+		if (pos >= nbits) throw std::out_of_range("bitblock::flip: position out of range");
+		_word[pos / bitsInWord] ^= (1ull << (pos % bitsInWord));
+		return *this;
+	}
+	void setToZero() { reset(); }
+	bool load_bits(const std::string& string_of_bits) {
+		if (string_of_bits.length() != nbits) return false;
+		setToZero();
+		int msb = nbits - 1;
+		for (std::string::const_iterator it = string_of_bits.begin(); it != string_of_bits.end(); ++it) {
+			if (*it == '0') {
+				this->reset(msb--);
 			}
-
-			bool load_bits(const std::string& string_of_bits) {
-				if (string_of_bits.length() != nbits)
-					return false;
-
-				setzero();
-				int msb = nbits - 1;
-
-				for (std::string::const_iterator it = string_of_bits.begin(); it != string_of_bits.end(); ++it) {
-
-					if (*it == '0') {
-						this->reset(msb--);
-					}
-					else if (*it == '1') {
-						this->set(msb--);
-					}
-					else {
-						return false;
-					}
-				}
-				return true;
+			else if (*it == '1') {
+				this->set(msb--);
 			}
-		};
-
-		/**
-		   @param val is a bitblock value.
-
-		   @return value of sign bit.
-		 */
-		template<size_t nbits>
-		unsigned int getSignBit(const bitblock<nbits>& val) {
-			return val[nbits - 1];
-		}
-
-		// logic operators:  unsigned (in)equality inherited.
-
-		// this comparison is for a two's complement number only
-		template<size_t nbits>
-		bool lessThan(const bitblock<nbits>& lhs,
-			const bitblock<nbits>& rhs) {
-			// Short-circuits on disparate signs:
-			if (getSignBit(lhs) == 0 && getSignBit(rhs) == 1) {
+			else {
 				return false;
 			}
-			if (getSignBit(lhs) == 1 && getSignBit(rhs) == 0) {
-				return true;
-			}
-
-			// Sign bits agree, can compare bit patterns directly:
-			return lhs < rhs;
-		}
-
-		/**
-		  @brief Vestigial alias for '<' operator:  unsigned.
-		*/
-		template<size_t nbits>
-		bool lessThan_unsigned(const bitblock<nbits> &lhs,
-			const bitblock<nbits> &rhs) {
-			return lhs < rhs;
-		}
-
-		////////////////////////////// ARITHMETIC functions
-		//////////////////////////////////////////////////////////////////////////////////////
-		// increment and decrement
-
-		/**
-		   @brief Increments value in place.
-
-		   @param[in, out] number is the value to decrement.
-
-		   @return true iff the sign has changed from nonnegative to negative.
-		 */
-		template<size_t nbits>
-		bool increment_bitset(bitblock<nbits>& number) {
-			unsigned int signPre = getSignBit(number);
-			number.increment();
-			unsigned int signPost = getSignBit(number);
-			return signPost > signPre;
-		}
-
-		// increment the input bitset in place, and return true if there is a carry generated.
-		// The input number is assumed to be right adjusted starting at nbits-nrBits
-		// [1 0 0 0] nrBits = 0 is a noop as there is no word to increment
-		// [1 0 0 0] nrBits = 1 is the word [1]
-		// [1 0 0 0] nrBits = 2 is the word [1 0]
-		// [1 1 0 0] nrBits = 3 is the word [1 1 0], etc.
-
-		template<size_t nbits>
-		bool increment_unsigned(bitblock<nbits>& number, int nrBits = nbits - 1) {
-			bool carry = 1;  // ripple carry
-			int lsb = nbits - nrBits;
-			for (size_t i = lsb; i < nbits; i++) {
-				bool _a = number[i];
-				number[i] = _a ^ carry;
-				carry = (_a & false) | (carry & (_a ^ false));
-			}
-			return carry;
-		}
-
-
-		/**
-		   @brief Decrements value in place.
-
-		   @param[in, out] number is the value to decrement.
-
-		   @return true iff the sign has changed from negative to nonnegative.
-		 */
-		template<size_t nbits>
-		bool decrement_bitset(bitblock<nbits>& number) {
-			unsigned int signPre = getSignBit(number);
-			(void)number.decrement();
-			unsigned int signPost = getSignBit(number);
-			return signPost < signPre;
-		}
-
-
-		//////////////////////////////////////////////////////////////////////////////////////
-
-		/**
-		   @brief Adds two nbit summands into nbit+1 result.
-
-		   @param a is an addend.
-
-		   @param b is an addend.
-
-		   @param[out] sum contains the sum, with carry bit set.
-
-		   @return true iff carry precipitated.
-		*/
-		template<size_t nbits>
-		bool add_unsigned(const bitblock<nbits> &a,
-			const bitblock<nbits> &b,
-			bitblock<nbits + 1>& sum) {
-			return sum.add(a, b);
-		}
-
-		// subtract bitsets a and b and return result in bitset dif. Return true if there is a borrow generated.
-		template<size_t nbits>
-		bool subtract_unsigned(bitblock<nbits> a,
-			bitblock<nbits> b,
-			bitblock<nbits + 1>& dif) {
-			return dif.sub(a, b);
-		}
-
-		template<size_t nbits>
-		bool add_signed_magnitude(bitblock<nbits> a,
-			bitblock<nbits> b,
-			bitblock<nbits>& sum) {
-			uint8_t carry = 0;
-			bool sign_a = a.test(nbits - 1);
-			if (sign_a) {
-				a = a.flip();
-				carry += 1;
-			}
-			bool sign_b = b.test(nbits - 1);
-			if (sign_b) {
-				b = b.flip();
-				carry += 1;
-			}
-			for (int i = 0; i < nbits - 2; i++) {
-				bool _a = a[i];
-				bool _b = b[i];
-				sum[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-
-			return carry;
-		}
-
-
-		template<size_t nbits>
-		bool subtract_signed_magnitude(bitblock<nbits> a,
-			bitblock<nbits> b,
-			bitblock<nbits>& diff) {
-			bool sign_a = a.test(nbits - 1);
-			bool sign_b = b.test(nbits - 1);
-			std::cerr << "subtract_signed_magnitude not implemented yet" << std::endl;
-			return false;
-		}
-
-
-		// integral type to bitblock transformations
-		// we are using a full nbits sized bitset even though nbits-3 is the maximum fraction
-		// a posit would contain. However, we need an extra bit after the cut-off to make the
-		// round up/down decision. The <nbits-something> size created a lot of sw complexity
-		// that isn't worth the trouble, so we are simplifying and simply manage a full nbits
-		// of fraction bits.
-
-		template<size_t nbits>
-		bitblock<nbits> extract_23b_fraction(uint32_t _23b_fraction_without_hidden_bit) {
-			bitblock<nbits> _fraction;
-			uint32_t mask = uint32_t(0x00400000ul);
-			unsigned int ub = (nbits < 23 ? nbits : 23);
-			for (unsigned int i = 0; i < ub; i++) {
-				_fraction[nbits - 1 - i] = _23b_fraction_without_hidden_bit & mask;
-				mask >>= 1;
-			}
-			return _fraction;
-		}
-
-		template<size_t nbits>
-		bitblock<nbits> extract_52b_fraction(uint64_t _52b_fraction_without_hidden_bit) {
-			bitblock<nbits> _fraction;
-			uint64_t mask = uint64_t(0x0008000000000000ull);
-			unsigned int ub = (nbits < 52 ? nbits : 52);
-			for (unsigned int i = 0; i < ub; i++) {
-				_fraction[nbits - 1 - i] = _52b_fraction_without_hidden_bit & mask;
-				mask >>= 1;
-			}
-			return _fraction;
-		}
-
-
-		template<size_t nbits>
-		bitblock<nbits> extract_63b_fraction(uint64_t _63b_fraction_without_hidden_bit) {
-			bitblock<nbits> _fraction;
-			uint64_t mask = uint64_t(0x4000000000000000ull);
-			unsigned int ub = (nbits < 63 ? nbits : 63);
-			for (unsigned int i = 0; i < ub; i++) {
-				_fraction[nbits - 1 - i] = _63b_fraction_without_hidden_bit & mask;
-				mask >>= 1;
-			}
-			return _fraction;
-		}
-
-		// 128 bit unsigned int mapped to two uint64_t elements
-		typedef struct __uint128 {
-			uint64_t lower;
-			uint64_t upper;
-		} uint128;
-
-
-		// take in a long double mapped to two uint64_t elements
-		template<size_t nbits>
-		bitblock<nbits> extract_long_double_fraction(uint128* _112b_fraction_without_hidden_bit) {
-			bitblock<nbits> _fraction;
-			int msb = nbits - 1;
-			uint64_t mask = uint64_t(0x0000800000000000ull);
-			unsigned int ub = (nbits < 48 ? nbits : 48); // 48 bits in the upper half
-			for (unsigned int i = 0; i < ub; i++) {
-				_fraction[msb--] = _112b_fraction_without_hidden_bit->upper & mask;
-				mask >>= 1;
-			}
-			mask = uint64_t(0x8000000000000000ull);
-			ub = (nbits < 112 - 48 ? nbits : 112 - 48); // max 64 bits in the lower half
-			for (unsigned int i = 0; i < ub; i++) {
-				_fraction[msb--] = _112b_fraction_without_hidden_bit->lower & mask;
-				mask >>= 1;
-			}
-			return _fraction;
-		}
-
-		template<size_t nbits>
-		bitblock<nbits> copy_integer_fraction(unsigned long long _fraction_without_hidden_bit) {
-			bitblock<nbits> _fraction;
-			uint64_t mask = uint64_t(0x8000000000000000ull);
-			unsigned int ub = (nbits < 64 ? nbits : 64);
-			for (unsigned int i = 0; i < ub; i++) {
-				_fraction[nbits - 1 - i] = _fraction_without_hidden_bit & mask;
-				mask >>= 1;
-			}
-			return _fraction;
-		}
-
-
-		////////////////////////////////////////////////////////////////////////////////////////
-		// bitset copy and slice operators
-
-		// copy a bitset into a bigger bitset starting at position indicated by the shift value
-		template<size_t src_size, size_t tgt_size>
-		void copy_into(const bitblock<src_size>& src, size_t shift, bitblock<tgt_size>& tgt) {
-			tgt.reset();
-			for (size_t i = 0; i < src_size; i++)
-				tgt.set(i + shift, src[i]);
-		}
-
-
-		// copy a slice of a bitset into a bigger bitset starting at position indicated by the shift value
-		template<size_t src_size, size_t tgt_size>
-		void copy_slice_into(bitblock<src_size>& src, bitblock<tgt_size>& tgt, size_t begin = 0, size_t end = src_size, size_t shift = 0) {
-			// do NOT reset the target!!!
-			if (end <= src_size) throw iteration_bound_too_large{};
-			if (end + shift < tgt_size) throw iteration_bound_too_large{};
-			for (size_t i = begin; i < end; i++)
-				tgt.set(i + shift, src[i]);
-		}
-
-		template<size_t from, size_t to, size_t src_size>
-		bitblock<to - from> fixed_subset(const bitblock<src_size>& src) {
-			static_assert(from <= to, "from cannot be larger than to");
-			static_assert(to <= src_size, "to is larger than src_size");
-
-			bitblock<to - from> result;
-			for (size_t i = 0, end = to - from; i < end; ++i)
-				result[i] = src[i + from];
-
-			return result;
 		}
-
-		//////////////////////////////////////////////////////////////////////////////////////
-		// multiply and divide
-
-
-		// multiply bitsets a and b and return result in bitset result.
-		template<size_t operand_size>
-		void multiply_unsigned(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<2 * operand_size>& result) {
-			constexpr size_t result_size = 2 * operand_size;
-			bitblock<result_size> addend;
-			result.reset();
-			if (a.test(0)) {
-				copy_into<operand_size, result_size>(b, 0, result);
+		return true;
+	}
+
+	// word access
+	constexpr uint64_t word(size_t i) const { return _word[i]; }
+	constexpr void setword(size_t i, uint64_t w) {
+		_word[i] = w;
+		if (i == MSW) _word[MSW] &= MSW_MASK; // enforce precondition of properly nulled leading non-bits
+	}
+
+	// queries
+	constexpr size_t size() const { return nbits; }
+	size_t count() const {
+		size_t n = 0;
+		for (size_t i = 0; i < nrWords; ++i) n += size_t(internal::limb_popcount(_word[i]));
+		return n;
+	}
+	constexpr bool any() const {
+		for (size_t i = 0; i < nrWords; ++i) if (_word[i]) return true;
+		return false;
+	}
+	constexpr bool none() const { return !any(); }
+	constexpr bool all() const {
+		for (size_t i = 0; i < MSW; ++i) if (_word[i] != ~0ull) return false;
+		return _word[MSW] == MSW_MASK;
+	}
+
+	// conversions
+	unsigned long to_ulong() const {
+		unsigned long long v = to_ullong();
+		if (v > (unsigned long long)(~0ul)) throw std::overflow_error("bitblock::to_ulong: value does not fit");
+		return (unsigned long)v;
+	}
+	unsigned long long to_ullong() const {
+		for (size_t i = 1; i < nrWords; ++i) if (_word[i]) throw std::overflow_error("bitblock::to_ullong: value does not fit");
+		return _word[0];
+	}
+	std::string to_string(char zero = '0', char one = '1') const {
+		std::string s(nbits, zero);
+		for (size_t i = 0; i < nbits; ++i) if (getbit(i)) s[nbits - 1 - i] = one;
+		return s;
+	}
+
+	// logic operators
+	bitblock& operator&=(const bitblock& rhs) {
+		for (size_t i = 0; i < nrWords; ++i) _word[i] &= rhs._word[i];
+		return *this;
+	}
+	bitblock& operator|=(const bitblock& rhs) {
+		for (size_t i = 0; i < nrWords; ++i) _word[i] |= rhs._word[i];
+		return *this;
+	}
+	bitblock& operator^=(const bitblock& rhs) {
+		for (size_t i = 0; i < nrWords; ++i) _word[i] ^= rhs._word[i];
+		return *this;
+	}
+	bitblock operator~() const {
+		bitblock tmp(*this);
+		return tmp.flip();
+	}
+	bitblock& operator<<=(size_t bitsToShift) {
+		if (bitsToShift >= nbits) return reset();
+		if (bitsToShift == 0) return *this;
+		size_t wordShift = bitsToShift / bitsInWord;
+		size_t bitShift = bitsToShift % bitsInWord;
+		if (bitShift == 0) {
+			for (size_t i = MSW; i >= wordShift && i < nrWords; --i) _word[i] = _word[i - wordShift];
+		}
+		else {
+			for (size_t i = MSW; i > wordShift; --i) {
+				_word[i] = (_word[i - wordShift] << bitShift) | (_word[i - wordShift - 1] >> (bitsInWord - bitShift));
 			}
-			for (size_t i = 1; i < operand_size; i++) {
-				if (a.test(i)) {
-					copy_into<operand_size, result_size>(b, i, addend);
-					(void)result.add(addend);
-					// we should never have a carry:  assert(carry == false);
-				}
+			_word[wordShift] = _word[0] << bitShift;
+		}
+		for (size_t i = 0; i < wordShift; ++i) _word[i] = 0;
+		_word[MSW] &= MSW_MASK;
+		return *this;
+	}
+	bitblock& operator>>=(size_t bitsToShift) {
+		if (bitsToShift >= nbits) return reset();
+		if (bitsToShift == 0) return *this;
+		size_t wordShift = bitsToShift / bitsInWord;
+		size_t bitShift = bitsToShift % bitsInWord;
+		size_t last = MSW - wordShift;
+		if (bitShift == 0) {
+			for (size_t i = 0; i <= last; ++i) _word[i] = _word[i + wordShift];
+		}
+		else {
+			for (size_t i = 0; i < last; ++i) {
+				_word[i] = (_word[i + wordShift] >> bitShift) | (_word[i + wordShift + 1] << (bitsInWord - bitShift));
 			}
-		}
-
-
-		// divide bitsets a and b and return result in bitset result.
-		template<size_t operand_size>
-		void integer_divide_unsigned(const bitblock<operand_size>& a,
-			const bitblock<operand_size>& b,
-			bitblock<2 * operand_size>& result) {
-			bitblock<operand_size> subtractand, accumulator;
+			_word[last] = _word[MSW] >> bitShift;
+		}
+		for (size_t i = last + 1; i < nrWords; ++i) _word[i] = 0;
+		return *this;
+	}
+	bitblock operator<<(size_t bitsToShift) const {
+		bitblock tmp(*this);
+		return tmp <<= bitsToShift;
+	}
+	bitblock operator>>(size_t bitsToShift) const {
+		bitblock tmp(*this);
+		return tmp >>= bitsToShift;
+	}
+
+private:
+	uint64_t _word[nrWords];
+
+	constexpr bool getbit(size_t pos) const { return (_word[pos / bitsInWord] >> (pos % bitsInWord)) & 1ull; }
+	constexpr void setbit(size_t pos, bool v) {
+		uint64_t mask = (1ull << (pos % bitsInWord));
+		if (v) _word[pos / bitsInWord] |= mask; else _word[pos / bitsInWord] &= ~mask;
+	}
+};
+
+template<size_t nbits>
+inline bitblock<nbits> operator&(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	bitblock<nbits> r(lhs);
+	return r &= rhs;
+}
+template<size_t nbits>
+inline bitblock<nbits> operator|(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	bitblock<nbits> r(lhs);
+	return r |= rhs;
+}
+template<size_t nbits>
+inline bitblock<nbits> operator^(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	bitblock<nbits> r(lhs);
+	return r ^= rhs;
+}
+
+template<size_t nbits>
+inline std::ostream& operator<<(std::ostream& ostr, const bitblock<nbits>& bits) {
+	return ostr << bits.to_string();
+}
+
+namespace internal {
+
+// r = a + b + carry_in, returns the carry out of bit nbits - 1
+template<size_t nbits>
+inline bool bitblock_add(bitblock<nbits>& r, const bitblock<nbits>& a, const bitblock<nbits>& b, bool carry_in) {
+	constexpr size_t nrWords = bitblock<nbits>::nrWords;
+	constexpr size_t msbits = nbits % 64;
+	uint64_t carry = carry_in ? 1 : 0;
+	uint64_t s = 0;
+	for (size_t i = 0; i < nrWords; ++i) {
+		uint64_t t = a.word(i) + carry;
+		carry = (t < carry);
+		s = t + b.word(i);
+		carry += (s < t);
+		r.setword(i, s);
+	}
+	// in a partial most significant word, the carry out lands in the first bit beyond nbits
+	return (msbits ? ((s >> msbits) & 1ull) : carry) != 0;
+}
+
+// r = a - b - borrow_in, returns the borrow out of bit nbits - 1
+template<size_t nbits>
+inline bool bitblock_sub(bitblock<nbits>& r, const bitblock<nbits>& a, const bitblock<nbits>& b, bool borrow_in) {
+	constexpr size_t nrWords = bitblock<nbits>::nrWords;
+	constexpr size_t msbits = nbits % 64;
+	uint64_t borrow = borrow_in ? 1 : 0;
+	uint64_t d = 0;
+	for (size_t i = 0; i < nrWords; ++i) {
+		uint64_t t = a.word(i) - b.word(i);
+		uint64_t bout = (a.word(i) < b.word(i));
+		d = t - borrow;
+		borrow = bout + (t < borrow);
+		r.setword(i, d);
+	}
+	// in a partial most significant word, a borrow sets all the bits beyond nbits
+	return (msbits ? ((d >> msbits) & 1ull) : borrow) != 0;
+}
+
+// copy the lower bits of a bitblock into a bitblock of a different size, truncating or zero extending
+template<size_t tgt_size, size_t src_size>
+inline void bitblock_resize(const bitblock<src_size>& src, bitblock<tgt_size>& tgt) {
+	for (size_t i = 0; i < bitblock<tgt_size>::nrWords; ++i) {
+		tgt.setword(i, (i < bitblock<src_size>::nrWords) ? src.word(i) : 0ull);
+	}
+}
+
+// place the width lower bits of a native word at the most significant end of a bitblock
+template<size_t nbits>
+inline void bitblock_msb_align(bitblock<nbits>& tgt, uint64_t field, size_t width) {
+	if (width < 64) field &= (1ull << width) - 1;
+	bitblock<nbits + 64> wide;
+	wide.setword(0, field);
+	wide <<= nbits;
+	wide >>= width;
+	bitblock_resize(wide, tgt);
+}
+
+} // namespace internal
+
+// logic operators
+
+// this comparison is for a two's complement number only
+template<size_t nbits>
+bool twosComplementLessThan(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	// comparison of the sign bit
+	if (lhs[nbits - 1] == 0 && rhs[nbits - 1] == 1)	return false;
+	if (lhs[nbits - 1] == 1 && rhs[nbits - 1] == 0) return true;
+	// sign is equal, compare the remaining bits
+	for (size_t i = bitblock<nbits>::nrWords; i-- > 0; ) {
+		if (lhs.word(i) != rhs.word(i)) return lhs.word(i) < rhs.word(i);
+	}
+	// numbers are equal
+	return false;
+}
+
+// this comparison works for any number
+template<size_t nbits>
+bool operator==(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	for (size_t i = 0; i < bitblock<nbits>::nrWords; ++i) {
+		if (lhs.word(i) != rhs.word(i)) return false;
+	}
+	// numbers are equal
+	return true;
+}
+
+template<size_t nbits>
+bool operator!=(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	return !operator==(lhs, rhs);
+}
+
+// this comparison is for unsigned numbers only
+template<size_t nbits>
+bool operator< (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	for (size_t i = bitblock<nbits>::nrWords; i-- > 0; ) {
+		if (lhs.word(i) != rhs.word(i)) return lhs.word(i) < rhs.word(i);
+	}
+	// numbers are equal
+	return false;
+}
+
+// this comparison is for unsigned numbers only
+template<size_t nbits>
+bool operator<= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	return !(rhs < lhs);
+}
+
+// this comparison is for unsigned numbers only
+template<size_t nbits>
+bool operator> (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	return rhs < lhs;
+}
+
+// this comparison is for unsigned numbers only
+template<size_t nbits>
+bool operator>= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	return !(lhs < rhs);
+}
+
+////////////////////////////// ARITHMETIC functions
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+// increment and decrement
+
+// increment the input bitset in place, and return true if there is a carry generated.
+template<size_t nbits>
+bool increment_bitset(bitblock<nbits>& number) {
+	return internal::bitblock_add(number, number, bitblock<nbits>(), true);
+}
+
+// increment the input bitset in place, and return true if there is a carry generated.
+// The input number is assumed to be right adjusted starting at nbits-nrBits
+// [1 0 0 0] nrBits = 0 is a noop as there is no word to increment
+// [1 0 0 0] nrBits = 1 is the word [1]
+// [1 0 0 0] nrBits = 2 is the word [1 0]
+// [1 1 0 0] nrBits = 3 is the word [1 1 0], etc.
+template<size_t nbits>
+bool increment_unsigned(bitblock<nbits>& number, size_t nrBits = nbits - 1) {
+	if (nrBits > nbits - 1) nrBits = nbits - 1;  // check/fix argument
+	size_t lsb = nbits - nrBits;
+	if (lsb >= nbits) return true;
+	bitblock<nbits> one;
+	one.set(lsb);
+	return internal::bitblock_add(number, number, one, false);
+}
+
+// decrement the input bitset in place, and return true if there is a borrow generated.
+template<size_t nbits>
+bool decrement_bitset(bitblock<nbits>& number) {
+	return internal::bitblock_sub(number, number, bitblock<nbits>(), true);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// add and subtract
+
+// add bitsets a and b and return result in bitset sum. Return true if there is a carry generated.
+template<size_t nbits>
+bool add_unsigned(bitblock<nbits> a, bitblock<nbits> b, bitblock<nbits + 1>& sum) {
+	bitblock<nbits> s;
+	bool carry = internal::bitblock_add(s, a, b, false);
+	internal::bitblock_resize(s, sum);
+	sum.set(nbits, carry);
+	return carry;
+}
+
+// subtract bitsets a and b and return result in bitset dif. Return true if there is a borrow generated.
+template<size_t nbits>
+bool subtract_unsigned(bitblock<nbits> a, bitblock<nbits> b, bitblock<nbits + 1>& dif) {
+	bitblock<nbits> d;
+	bool borrow = internal::bitblock_sub(d, a, b, false);
+	internal::bitblock_resize(d, dif);
+	dif.set(nbits, borrow);
+	return borrow;
+}
+
+template<size_t nbits>
+bool add_signed_magnitude(bitblock<nbits> a, bitblock<nbits> b, bitblock<nbits>& sum) {
+	uint8_t carry = 0;
+	if (nbits > 1) {  // need at least 1 bit of magnitude to add
+		bool sign_a = a.test(nbits - 1);
+		if (sign_a) {
+			a = a.flip();
+			carry += 1;
+		}
+		bool sign_b = b.test(nbits - 1);
+		if (sign_b) {
+			b = b.flip();
+			carry += 1;
+		}
+
+		for (size_t i = 0; i < nbits - 2; i++) {
+			bool _a = a[i];
+			bool _b = b[i];
+			sum[i] = _a ^ _b ^ carry;
+			carry = (_a & _b) | (carry & (_a ^ _b));
+		}
+	}
+	return carry;
+}
+
+template<size_t nbits>
+bool subtract_signed_magnitude(bitblock<nbits> a, bitblock<nbits> b, bitblock<nbits>& diff) {
+	std::cerr << "subtract_signed_magnitude not implemented yet" << std::endl;
+	return false;
+}
+
+// integral type to bitblock transformations
+
+// we are using a full nbits sized bitset even though nbits-3 is the maximum fraction
+// a posit would contain. However, we need an extra bit after the cut-off to make the
+// round up/down decision. The <nbits-something> size created a lot of sw complexity
+// that isn't worth the trouble, so we are simplifying and simply manage a full nbits
+// of fraction bits.
+
+template<size_t nbits>
+bitblock<nbits> extract_23b_fraction(uint32_t _23b_fraction_without_hidden_bit) {
+	bitblock<nbits> _fraction;
+	internal::bitblock_msb_align(_fraction, _23b_fraction_without_hidden_bit, 23);
+	return _fraction;
+}
+
+template<size_t nbits>
+bitblock<nbits> extract_52b_fraction(uint64_t _52b_fraction_without_hidden_bit) {
+	bitblock<nbits> _fraction;
+	internal::bitblock_msb_align(_fraction, _52b_fraction_without_hidden_bit, 52);
+	return _fraction;
+}
+
+template<size_t nbits>
+bitblock<nbits> extract_63b_fraction(uint64_t _63b_fraction_without_hidden_bit) {
+	bitblock<nbits> _fraction;
+	internal::bitblock_msb_align(_fraction, _63b_fraction_without_hidden_bit, 63);
+	return _fraction;
+}
+
+// 128 bit unsigned int mapped to two uint64_t elements
+typedef struct __uint128 {
+	uint64_t lower;
+	uint64_t upper;
+} uint128;
+
+// take in a long double mapped to two uint64_t elements
+template<size_t nbits>
+bitblock<nbits> extract_long_double_fraction(uint128* _112b_fraction_without_hidden_bit) {
+	// 48 bits in the upper half, followed by 64 bits in the lower half
+	bitblock<112> fraction;
+	fraction.setword(0, _112b_fraction_without_hidden_bit->lower);
+	fraction.setword(1, _112b_fraction_without_hidden_bit->upper & 0x0000FFFFFFFFFFFFull);
+	bitblock<nbits + 112> wide;
+	internal::bitblock_resize(fraction, wide);
+	wide <<= nbits;
+	wide >>= 112;
+	bitblock<nbits> _fraction;
+	internal::bitblock_resize(wide, _fraction);
+	return _fraction;
+}
+
+template<size_t nbits>
+bitblock<nbits> copy_integer_fraction(unsigned long long _fraction_without_hidden_bit) {
+	bitblock<nbits> _fraction;
+	internal::bitblock_msb_align(_fraction, _fraction_without_hidden_bit, 64);
+	return _fraction;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// bitset copy and slice operators
+
+// copy a bitset into a bigger bitset starting at position indicated by the shift value
+template<size_t src_size, size_t tgt_size>
+void copy_into(const bitblock<src_size>& src, size_t shift, bitblock<tgt_size>& tgt) {
+	internal::bitblock_resize(src, tgt);
+	tgt <<= shift;
+}
+
+// TODO: is this guard named correctly?
+#if BITBLOCK_THROW_ARITHMETIC_EXCEPTION
+// copy a slice of a bitset into a bigger bitset starting at position indicated by the shift value
+template<size_t src_size, size_t tgt_size>
+void copy_slice_into(bitblock<src_size>& src, bitblock<tgt_size>& tgt, size_t begin = 0, size_t end = src_size, size_t shift = 0) {
+	// do NOT reset the target!!!
+	if (end <= src_size) throw iteration_bound_too_large{};
+	if (end + shift < tgt_size) throw iteration_bound_too_large{};
+	for (size_t i = begin; i < end; i++)
+		tgt.set(i + shift, src[i]);
+}
+#else
+// copy a slice of a bitset into a bigger bitset starting at position indicated by the shift value
+template<size_t src_size, size_t tgt_size>
+void copy_slice_into(bitblock<src_size>& src, bitblock<tgt_size>& tgt, size_t begin = 0, size_t end = src_size, size_t shift = 0) {
+	// do NOT reset the target!!!
+	if (end <= src_size) return;
+	if (end + shift < tgt_size) return;
+	for (size_t i = begin; i < end; i++)
+		tgt.set(i + shift, src[i]);
+}
+#endif // BITBLOCK_THROW_ARITHMETIC_EXCEPTION
+
+template<size_t from, size_t to, size_t src_size>
+bitblock<to - from> fixed_subset(const bitblock<src_size>& src) {
+	static_assert(from <= to, "from cannot be larger than to");
+	static_assert(to <= src_size, "to is larger than src_size");
+
+	bitblock<to - from> result;
+	internal::bitblock_resize(src >> from, result);
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// multiply and divide
+
+// accumulate the addend to a running accumulator
+template<size_t src_size, size_t tgt_size>
+bool accumulate(const bitblock<src_size>& addend, bitblock<tgt_size>& accumulator) {
+	// the ripple carry stops at src_size: the upper bits of the accumulator are not modified
+	bitblock<src_size> lower;
+	internal::bitblock_resize(accumulator, lower);
+	bool carry = internal::bitblock_add(lower, lower, addend, false);
+	bitblock<tgt_size> upper(accumulator), update;
+	upper >>= src_size;
+	upper <<= src_size;
+	internal::bitblock_resize(lower, update);
+	accumulator = upper | update;
+	return carry;
+}
+
+// multiply bitsets a and b and return result in bitset result.
+template<size_t operand_size>
+void multiply_unsigned(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<2 * operand_size>& result) {
+	constexpr size_t nrWords = bitblock<operand_size>::nrWords;
+	uint64_t x[nrWords], y[nrWords], p[2 * nrWords];
+	for (size_t i = 0; i < nrWords; ++i) {
+		x[i] = a.word(i);
+		y[i] = b.word(i);
+	}
+	internal::limb_multiply(p, x, nrWords, y, nrWords);
+	for (size_t i = 0; i < bitblock<2 * operand_size>::nrWords; ++i) result.setword(i, p[i]);
+}
+
+// subtract a subtractand from a running accumulator
+template<size_t src_size, size_t tgt_size>
+bool subtract(bitblock<tgt_size>& accumulator, const bitblock<src_size>& subtractand) {
+	// the ripple borrow stops at src_size: the upper bits of the accumulator are not modified
+	bitblock<src_size> lower;
+	internal::bitblock_resize(accumulator, lower);
+	bool borrow = internal::bitblock_sub(lower, lower, subtractand, false);
+	bitblock<tgt_size> upper(accumulator), update;
+	upper >>= src_size;
+	upper <<= src_size;
+	internal::bitblock_resize(lower, update);
+	accumulator = upper | update;
+	return borrow;
+}
+
+namespace internal {
+
+// q = u / v on the 32-bit digits of the bitblocks, using Knuth Algorithm D
+template<size_t qbits, size_t ubits, size_t vbits>
+inline void bitblock_divide(const bitblock<ubits>& u, const bitblock<vbits>& v, bitblock<qbits>& q) {
+	constexpr size_t m = 2 * bitblock<ubits>::nrWords;
+	constexpr size_t n = 2 * bitblock<vbits>::nrWords;
+	uint32_t ud[m], vd[n], qd[m], rd[n];
+	for (size_t i = 0; i < m; ++i) ud[i] = uint32_t(u.word(i / 2) >> (32 * (i % 2)));
+	for (size_t i = 0; i < n; ++i) vd[i] = uint32_t(v.word(i / 2) >> (32 * (i % 2)));
+	limb_divide(qd, rd, ud, m, vd, n);
+	for (size_t i = 0; i < bitblock<qbits>::nrWords; ++i) {
+		q.setword(i, (2 * i < m) ? (uint64_t(qd[2 * i]) | (uint64_t(qd[2 * i + 1]) << 32)) : 0ull);
+	}
+}
+
+} // namespace internal
+
+// divide bitsets a and b and return result in bitset result.
+template<size_t operand_size>
+void integer_divide_unsigned(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<2 * operand_size>& result) {
+	result.reset();
+	if (b.none()) {
+#if BITBLOCK_THROW_ARITHMETIC_EXCEPTION
+		throw bitblock_divide_by_zero{};
+#else
+		std::cerr << "bitblock_divide_by_zero\n";
+#endif // BITBLOCK_THROW_ARITHMETIC_EXCEPTION
+	}
+	else {
+		internal::bitblock_divide(a, b, result);
+	}
+}
+
+// divide bitsets a and b and return result in bitset result.
+// By providing more bits in the result, the algorithm will fill these with fraction bits if available.
+// Radix point must be maintained by calling function.
+template<size_t operand_size, size_t result_size>
+void divide_with_fraction(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<result_size>& result) {
+	result.reset();
+	if (b.none()) {
+#if BITBLOCK_THROW_ARITHMETIC_EXCEPTION
+		throw bitblock_divide_by_zero{};
+#else
+		std::cerr << "bitblock_divide_by_zero\n";
+#endif // BITBLOCK_THROW_ARITHMETIC_EXCEPTION
+	}
+	else {
+		// result = (a * 2^(result_size - operand_size)) / b
+		bitblock<result_size> dividend;
+		copy_into<operand_size, result_size>(a, result_size - operand_size, dividend);
+		internal::bitblock_divide(dividend, b, result);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// truncating and rounding
+
+// truncate right-side
+template<size_t src_size, size_t tgt_size>
+void truncate(bitblock<src_size>& src, bitblock<tgt_size>& tgt) {
+	if (tgt_size <= src_size) {
+		internal::bitblock_resize(src >> (src_size - tgt_size), tgt);
+	}
+	else {
+		copy_into<src_size, tgt_size>(src, tgt_size - src_size, tgt);
+	}
+}
+
+// round
+template<size_t tgt_size, size_t src_size>
+struct round_t
+{
+	static bitblock<tgt_size> eval(const bitblock<src_size>& src, size_t n)
+	{
+		static_assert(src_size > 0 && tgt_size > 0, "We don't bother with empty sets.");
+		// the bits that are cut off at the leading end
+		bool cut_off = (tgt_size + n < src_size) && (src >> (tgt_size + n)).any();
+#if BITBLOCK_THROW_ARITHMETIC_EXCEPTION
+		if (n >= src_size)
+			throw round_off_all{};
+		// look for cut-off leading bits
+		if (cut_off)
+			throw cut_off_leading_bit{};
+#else
+		if (n >= src_size) {
+			bitblock<tgt_size> result;
 			result.reset();
-			accumulator = a;
-			int msb = findMostSignificantBit(b);
-			if (msb < 0) {
-				throw integer_divide_by_zero{};
-			}
-
-			const unsigned int shift = operand_size - msb - 1;
-			// prepare the subtractand
-			subtractand = b;
-			subtractand <<= shift;
-			for (int i = shift; i >= 0; --i) {
-				if (subtractand <= accumulator) {
-					(void)accumulator.sub(subtractand);
-					result.set(i);
-				}
-				else {
-					result.reset(i);
-				}
-				subtractand >>= 1;
-			}
+			return result;
 		}
-
-
-		// divide bitsets a and b and return result in bitset result. 
-		// By providing more bits in the result, the algorithm will fill these with fraction bits if available.
-		// Radix point must be maintained by calling function.
-		template<size_t operand_size, size_t result_size>
-		void divide_with_fraction(const bitblock<operand_size>& a,
-			const bitblock<operand_size>& b,
-			bitblock<result_size>& result) {
-			bitblock<result_size> subtractand, accumulator;
+		if (cut_off) {
+			std::cerr << "cut_off_leading_bit\n";
+			bitblock<tgt_size> result;
 			result.reset();
-			copy_into<operand_size, result_size>(a, result_size - operand_size, accumulator);
-			int msb = findMostSignificantBit(b);
-			if (msb < 0) {
-				throw integer_divide_by_zero{};
-			}
-
-			int shift = operand_size - msb - 1;
-			// prepare the subtractand
-			copy_into<operand_size, result_size>(b, result_size - operand_size, subtractand);
-			subtractand <<= shift;
-			for (int i = result_size - msb - 1; i >= 0; --i) {
-				//std::cout << "accumulator " << accumulator << std::endl;
-				//std::cout << "subtractand " << subtractand << std::endl;
-				if (subtractand <= accumulator) {
-					(void)accumulator.sub(subtractand);
-					//assert(borrow == false);
-					result.set(i);
-				}
-				else {
-					result.reset(i);
-				}
-				//std::cout << "result      " << result << std::endl;
-				subtractand >>= 1;
-			}
-		}
-
-		//////////////////////////////////////////////////////////////////////////////////////
-		// truncating and rounding
-
-		// truncate right-side
-		template<size_t src_size, size_t tgt_size>
-		void truncate(bitblock<src_size>& src, bitblock<tgt_size>& tgt) {
-			tgt.reset();
-			for (size_t i = 0; i < tgt_size; i++)
-				tgt.set(tgt_size - 1 - i, src[src_size - 1 - i]);
-		}
-
-
-		// round
-		template<size_t tgt_size, size_t src_size>
-		struct round_t
-		{
-			static bitblock<tgt_size> eval(const bitblock<src_size>& src, size_t n)
-			{
-				static_assert(src_size > 0 && tgt_size > 0, "We don't bother with empty sets.");
-				if (n >= src_size)
-					throw round_off_all{};
-
-				// look for cut-off leading bits
-				for (size_t leading = tgt_size + n; leading < src_size; ++leading)
-					if (src[leading])
-						throw cut_off_leading_bit{};
-
-				bitblock<tgt_size> result((src >> n).to_ullong()); // convert to size_t to deal with different sizes
-				if (n > 0 && src[n - 1]) {                                // round up potentially if first cut-off bit is true
-#         ifdef POSIT_ROUND_TIES_AWAY_FROM_ZERO             // TODO: Evil hack to be consistent with assign_fraction, for testing only
-					result = result.to_ullong() + 1;
-#         else            
-
-					bool more_bits = false;
-					for (long i = 0; i + 1 < n && !more_bits; ++i)
-						more_bits |= src[i];
-					if (more_bits) {
-						result = result.to_ullong() + 1;                // increment_unsigned is ambiguous 
-					}
-					else {                                            // tie: round up odd number
-#             ifndef POSIT_ROUND_TIES_TO_ZERO               // TODO: evil hack to be removed later
-						if (result[0])
-							result = result.to_ullong() + 1;
-#             endif
-					}
-#         endif
-
-				}
-				return result;
-			}
-		};
-
-		template<size_t src_size>
-		struct round_t<0, src_size>
-		{
-			static bitblock<0> eval(const bitblock<src_size>&, size_t)
-			{
-				return {};
-			}
-		};
-
-
-
-		/** Round off \p n last bits of bitset \p src. Round to nearest resulting in potentially smaller bitset.
-		 *  Doesn't return carry bit in case of overflow while rounding up! TODO: Check whether we need carry or we require an extra bit for this case.
-		 */
-		template<size_t tgt_size, size_t src_size>
-		bitblock<tgt_size> round(const bitblock<src_size>& src, size_t n)
-		{
-			return round_t<tgt_size, src_size>::eval(src, n);
-		}
-
-
-		////////////////////////////// HELPER functions
-
-		// Attention!
-		// Achtung!
-		// Regardez!
-		// Waarschuwing!
-		// DANGER: this depends on the implicit type conversion of number
-		// to a uint64_t for sign-extending a 2's complement number system.
-		// If nbits > 64 then this code breaks.
-		template<size_t nbits, class Type>
-		bitblock<nbits> convert_to_bitblock(Type number) {
-			bitblock<nbits> bBits;
-			const uint64_t one = uint64_t(1);
-			for (std::size_t i = 0; i < nbits; i++) {
-				bBits[i] = (one << i) & number;
-			}
-
-			return bBits;
+			return result;
 		}
+#endif // BITBLOCK_THROW_ARITHMETIC_EXCEPTION
 
-		/**
-		   @brief Constructs a string of 1's and 0's representing the
-		   value passed.
+		bitblock<tgt_size> result;
+		internal::bitblock_resize(src >> n, result);
 
-		   @param bit contains the value to display.
-
-		   @return string representing the value.
-		 */
-		template<size_t nbits>
-		std::string to_binary(bitblock<nbits> const &bits) {
-			char str[nbits + 1];
-			str[nbits] = 0;
-			for (size_t i = 0; i < nbits; i++) {
-				str[nbits - 1 - i] = bits[i] ? '1' : '0';
+		if (n > 0 && src[n - 1]) {                         // round up potentially if first cut-off bit is true
+#ifdef BITBLOCK_ROUND_TIES_AWAY_FROM_ZERO					   // TODO: Evil hack to be consistent with assign_fraction, for testing only
+			increment_bitset(result);
+#else
+			bool more_bits = (n > 1) && anyAfter(src, int(n) - 2);
+			if (more_bits) {
+				increment_bitset(result);
 			}
-			return std::string(str);
-		}
-
-		template<size_t nbits>
-		std::string to_hex(bitblock<nbits> bits) {
-			char str[(nbits >> 2) + 2];   // plenty of room
-			for (size_t i = 0; i < (nbits >> 2) + 2; ++i) str[i] = 0;
-			const char* hexits = "0123456789ABCDEF";
-			unsigned int maxHexDigits = (nbits >> 2) + ((nbits % 4) ? 1 : 0);
-			for (unsigned int i = 0; i < maxHexDigits; i++) {
-				unsigned int hexit;
-				switch (nbits) {
-				case 1:
-					hexit = bits[0];
-					break;
-				case 2:
-					hexit = (bits[1] << 1) + bits[0];
-					break;
-				case 3:
-					hexit = (bits[2] << 2) + (bits[1] << 1) + bits[0];
-					break;
-				default:
-					hexit = (bits[3] << 3) + (bits[2] << 2) + (bits[1] << 1) + bits[0];
-					break;
-				}
-				str[maxHexDigits - 1 - i] = hexits[hexit];
-				bits >>= 4;
+			else {                                         // tie: round up odd number
+#ifndef BITBLOCK_ROUND_TIES_TO_ZERO                        // TODO: evil hack to be removed later
+				if (result[0])
+					increment_bitset(result);
+#endif
 			}
-			str[maxHexDigits] = 0;  // null terminated string
-			return std::string(str);
-		}
-
-		// convert a sign/magnitude number to a string
-		template<size_t nbits>
-		std::string sign_magnitude_to_string(bitblock<nbits> bits) {
-			std::stringstream ss;
-			ss << (bits[nbits - 1] ? "n-" : "p-");
-			if (nbits < 2) return ss.str();
-			for (int i = nbits - 2; i >= 0; --i) {
-				ss << (bits[i] ? "1" : "0");
-			}
-			return ss.str();
-		}
-
-
-		// find the MSB, return position if found, return -1 if no bits are set
-		template<size_t nbits>
-		int findMostSignificantBit(const bitblock<nbits>& bits) {
-			return bits.getMSB();
-		}
-
-		// calculate the 1's complement of a sign-magnitude encoded number
-
-		template<size_t nbits>
-		bitblock<nbits> ones_complement(const bitblock<nbits> &number) {
-			bitblock<nbits> complement = number;
-			complement.flip();
-			return complement;
-		}
-
-
-		// calculate the 2's complement of a 2's complement encoded number
-		template<size_t nbits>
-		bitblock<nbits> twos_complement(const bitblock<nbits> &number) {
-			bitblock<nbits> complement;
-			uint8_t carry = 1;
-			for (size_t i = 0; i < nbits; i++) {
-				uint8_t slice = uint8_t(!number[i]) + carry;
-				carry = slice >> 1;
-				complement[i] = (0x1 & slice);
-			}
-
-			return complement;
-		}
-
-
-		/**
-		   @brief Flips the sign bit of value passed.
-
-		   @param number is a value for which the sign is to be flipped.
-
-		   @return new bitset with the sign flipped as compared to number
-		*/
-		template<size_t nbits>
-		bitblock<nbits> flip_sign_bit(const bitblock<nbits> &number) {
-			bitblock<nbits> negate = number;
-			negate.flip(nbits - 1);
-			return negate;
-		}
-
-		/**
-		   @return true iff any bit at or right of msb is set.
-		 */
-		template<size_t nbits>
-		bool anyAfter(const bitblock<nbits>& bits, unsigned msb) {
-			bitblock<nbits> shBits = bits;
-			shBits <<= (nbits - 1 - msb);
-			return shBits.count() > 0;
-		}
-	} // namespace sw
-
-} // namespace unum
+#endif
+		}
+		return result;
+	}
+};
+
+template<size_t src_size>
+struct round_t<0, src_size>
+{
+	static bitblock<0> eval(const bitblock<src_size>&, size_t)
+	{
+		return {};
+	}
+};
+
+
+
+/** Round off \p n last bits of bitset \p src. Round to nearest resulting in potentially smaller bitset.
+*  Doesn't return carry bit in case of overflow while rounding up! TODO: Check whether we need carry or we require an extra bit for this case.
+*/
+template<size_t tgt_size, size_t src_size>
+bitblock<tgt_size> round(const bitblock<src_size>& src, size_t n)
+{
+	return round_t<tgt_size, src_size>::eval(src, n);
+}
+
+
+////////////////////////////// HELPER functions
+
+// find the MSB, return position if found, return -1 if no bits are set
+template<size_t nbits>
+int findMostSignificantBit(const bitblock<nbits>& bits) {
+	for (size_t i = bitblock<nbits>::nrWords; i-- > 0; ) {
+		uint64_t w = bits.word(i);
+		if (w) return int(i * 64) + 63 - internal::limb_clz(w);
+	}
+	return -1; // indicative of no bits set
+}
+
+// calculate the 1's complement of a sign-magnitude encoded number
+template<size_t nbits>
+bitblock<nbits> ones_complement(bitblock<nbits> number) {
+	return number.flip();
+}
+
+// calculate the 2's complement of a 2's complement encoded number
+template<size_t nbits>
+bitblock<nbits> twos_complement(bitblock<nbits> number) {
+	number.flip();
+	increment_bitset(number);
+	return number;
+}
+
+// DANGER: this depends on the implicit type conversion of number to a uint64_t to sign extent a 2's complement number system
+// if nbits > 64 then this code breaks.
+template<size_t nbits, class Type>
+bitblock<nbits> convert_to_bitblock(Type number) {
+	bitblock<nbits> _Bits;
+	_Bits.setword(0, uint64_t(number));
+	return _Bits;
+}
+
+template<size_t nbits>
+std::string to_bit_string(bitblock<nbits> bits, bool separator = true) {
+	std::stringstream ss;
+	int msb = nbits; // compilation warning work-around for nbits = 0
+	for (int i = msb - 1; i >= 0; --i) {
+		ss << (bits[std::size_t(i)] ? "1" : "0");
+		if (separator && i % 4 == 0 && i != 0) ss << "'";
+	}
+	return ss.str();
+}
+
+template<size_t nbits>
+std::string to_hex(bitblock<nbits> bits) {
+	char str[(nbits >> 2) + 2];   // plenty of room
+	for (size_t i = 0; i < (nbits >> 2) + 2; ++i) str[i] = 0;
+	const char* hexits = "0123456789abcdef";
+	unsigned int maxHexDigits = (nbits >> 2) + ((nbits % 4) ? 1 : 0);
+	for (unsigned int i = 0; i < maxHexDigits; i++) {
+		unsigned int hexit = unsigned(bits.word(0) & 0xF);
+		str[maxHexDigits - 1 - i] = hexits[hexit];
+		bits >>= 4;
+	}
+	str[maxHexDigits] = 0;  // null terminated string
+	return std::string(str);
+}
+
+// convert a sign/magnitude number to a string
+template<size_t nbits>
+std::string sign_magnitude_to_string(bitblock<nbits> bits) {
+	std::stringstream ss;
+	ss << (bits[nbits - 1] ? "n-" : "p-");
+	if (nbits < 2) return ss.str();
+	for (int i = nbits - 2; i >= 0; --i) {
+		ss << (bits[i] ? "1" : "0");
+	}
+	return ss.str();
+}
+
+// return a new bitset with the sign flipped as compared to the input bitset
+template<size_t nbits>
+bitblock<nbits> flip_sign_bit(bitblock<nbits> number) {
+	number.flip(nbits - 1);
+	return number;
+}
+
+// sticky bit representation of all the bits from [msb, lsb], that is, msb is included
+template<size_t nbits>
+bool anyAfter(const bitblock<nbits>& bits, int msb) {
+	if (msb < 0) return false;	// bad input
+	if (size_t(msb) >= nbits) msb = int(nbits) - 1;
+	size_t top = size_t(msb) / 64;
+	for (size_t i = 0; i < top; ++i) if (bits.word(i)) return true;
+	size_t topbits = size_t(msb) % 64 + 1;
+	uint64_t mask = (topbits == 64 ? ~0ull : ((1ull << topbits) - 1));
+	return (bits.word(top) & mask) != 0;
+}
+
+}} // namespace sw::unum
@@ -7,6 +7,7 @@
 
 #include <universal/blas/vector.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/blas/views.hpp>
 
 #include <universal/blas/blas_l1.hpp>
 #include <universal/blas/blas_l2.hpp>
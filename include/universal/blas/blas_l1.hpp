@@ -5,8 +5,11 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cmath>
+#include <algorithm>
 #include <universal/posit/posit>
+#include <universal/float/native_quire.hpp>
 #include <universal/blas/vector.hpp>
+#include <universal/blas/parallel.hpp>
 
 namespace sw { namespace unum { namespace blas { 
 
@@ -81,6 +84,85 @@ typename Vector::value_type dot(const Vector& x, const Vector& y) {
 	return sum_of_products;
 }
 
+// Fused dot product partitioned across threads: each thread accumulates a contiguous range in its own quire,
+// and the quires are merged exactly, so the result is bit-identical to fdp(x, y) for any number of threads.
+// The threads are run by parallel_for, and nrThreads = 0 selects the hardware concurrency of the machine.
+template<typename Vector>
+enable_if_posit<value_type<Vector>, value_type<Vector> > // as return type
+parallel_fdp(const Vector& x, const Vector& y, unsigned nrThreads = 0) {
+	constexpr size_t nbits = Vector::value_type::nbits;
+	constexpr size_t es = Vector::value_type::es;
+	constexpr size_t capacity = 20; // same quire as fdp
+	using Quire = quire<nbits, es, capacity>;
+	size_t n = std::min(size(x), size(y));
+	// one contiguous range per thread
+	size_t nrRanges = thread_count(std::max(size_t(1), n), nrThreads);
+
+	std::vector<Quire> partial(nrRanges);
+	parallel_for(nrRanges, unsigned(nrRanges), [&](size_t t) {
+		Quire& q = partial[t];
+		size_t last = n * (t + 1) / nrRanges;
+		for (size_t i = n * t / nrRanges; i < last; ++i) {
+			q += sw::unum::quire_mul(x[i], y[i]);
+		}
+	});
+
+	Quire q(0);
+	for (auto& p : partial) q += p;  // exact merge
+	typename Vector::value_type sum;
+	convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
+	return sum;
+}
+
+/// reproducible reductions of float and double vectors
+//
+// The elements, or the products of the elements, are accumulated exactly in a native_quire and
+// rounded once: the result is the correctly rounded value of the exact sum, and does not depend
+// on the order of accumulation. With nrThreads != 1 the elements are partitioned into contiguous
+// ranges, one per thread (0 selects the hardware concurrency), each thread accumulates its range
+// in its own native_quire, and the accumulators are merged exactly: the result is bit-identical
+// to the sequential reduction for any number of threads.
+
+// ranges shorter than this are not worth a thread
+constexpr size_t REPRODUCIBLE_MIN_RANGE = 16 * 1024;
+
+namespace internal {
+	template<typename Real, typename Accumulate>
+	Real reproducible_reduction(size_t n, unsigned nrThreads, Accumulate&& accumulate) {
+		size_t nrRanges = thread_count(std::max(size_t(1), (n + REPRODUCIBLE_MIN_RANGE - 1) / REPRODUCIBLE_MIN_RANGE), nrThreads);
+		if (nrRanges <= 1) {
+			sw::ieee::native_quire<Real> q;
+			accumulate(q, 0, n);
+			return q.to_native();
+		}
+		std::vector< sw::ieee::native_quire<Real> > partial(nrRanges);
+		parallel_for(nrRanges, unsigned(nrRanges), [&](size_t r) {
+			accumulate(partial[r], r * n / nrRanges, (r + 1) * n / nrRanges);
+		});
+		for (size_t r = 1; r < nrRanges; ++r) partial[0] += partial[r];
+		return partial[0].to_native();
+	}
+}
+
+// reproducible dot product
+template<typename Vector>
+typename Vector::value_type reproducible_dot(const Vector& x, const Vector& y, unsigned nrThreads = 1) {
+	using Real = typename Vector::value_type;
+	size_t n = std::min(size_t(size(x)), size_t(size(y)));
+	return internal::reproducible_reduction<Real>(n, nrThreads, [&](sw::ieee::native_quire<Real>& q, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) q += sw::ieee::quire_mul(Real(x[i]), Real(y[i]));
+	});
+}
+
+// reproducible sum of the vector elements
+template<typename Vector>
+typename Vector::value_type reproducible_sum(const Vector& x, unsigned nrThreads = 1) {
+	using Real = typename Vector::value_type;
+	return internal::reproducible_reduction<Real>(size_t(size(x)), nrThreads, [&](sw::ieee::native_quire<Real>& q, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) q += Real(x[i]);
+	});
+}
+
 // rotation of points in the plane
 template<typename Rotation, typename Vector>
 void rot(size_t n, Vector& x, size_t incx, Vector& y, size_t incy, Rotation c, Rotation s) {
@@ -1,6 +1,160 @@
 #pragma once
-// blas_l1.hpp: BLAS Level 1 functions
+// blas_l3.hpp: BLAS Level 3 functions
 //
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <vector>
+#include <universal/posit/posit>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/matrix.hpp>
+#include <universal/blas/parallel.hpp>
+
+namespace sw { namespace unum { namespace blas {
+
+/// //////////////////////////////////////////////////////////////////
+/// fused matrix-matrix product engine
+///
+/// C = A * B where every element of C is a fused dot product with a single rounding step.
+/// The rows of C are partitioned into row blocks that are distributed across threads.
+/// Each row block of A is decoded once into (sign, scale, fraction) triples, and B is
+/// decoded into transposed panels of FMM_TILE_COLS columns by FMM_PANEL_DEPTH rows,
+/// so that the inner kernel streams through contiguous memory.
+/// Every tile of C holds one quire per element for the full depth of the product,
+/// and since quire accumulation is exact the result is bit-identical to the
+/// element-by-element fused dot product, independent of blocking and thread count.
+
+// cache blocking parameters
+constexpr size_t FMM_TILE_ROWS   = 32;   // rows of a C tile and of an A row block
+constexpr size_t FMM_TILE_COLS   = 32;   // columns of a C tile and of a B panel
+constexpr size_t FMM_PANEL_DEPTH = 256;  // depth of the B panel
+
+// decode a posit into the (sign, scale, fraction) triple that quire_mul operates on
+template<size_t nbits, size_t es>
+inline value<nbits - 3 - es> fmm_decode(const posit<nbits, es>& p) {
+	constexpr size_t fbits = nbits - 3 - es;
+	value<fbits> v;
+	if (p.isnar()) {
+		v.setinf();
+	}
+	else if (p.iszero()) {
+		v.setzero();
+	}
+	else {
+		v.set(sign(p), scale(p), extract_fraction<nbits, es, fbits>(p), false, false);
+	}
+	return v;
+}
+
+// unrounded product of two decoded operands, identical to module_multiply
+// when the product of the significands fits in 64 bits it is computed with a native multiply
+template<size_t fbits, size_t mbits>
+inline void fmm_multiply(const value<fbits>& a, const value<fbits>& b, value<mbits>& product) {
+	if constexpr (mbits <= 64) {
+		uint64_t r = (a.fraction().to_ullong() | (uint64_t(1) << fbits)) * (b.fraction().to_ullong() | (uint64_t(1) << fbits));
+		int new_scale = a.scale() + b.scale();
+		size_t shift = 2;
+		if (r & (uint64_t(1) << (mbits - 1))) {
+			shift = 1;
+			++new_scale;
+		}
+		r <<= shift;    // shift hidden bit out
+		if (mbits < 64) r &= (uint64_t(1) << (mbits % 64)) - 1;
+		bitblock<mbits> fraction;
+		fraction = r;
+		product.set(a.sign() ^ b.sign(), new_scale, fraction, false, false, false);
+	}
+	else {
+		module_multiply(a, b, product);
+	}
+}
+
+// accumulate the unrounded products of two decoded vectors into a quire: q += a[0] * b[0] + ... + a[n-1] * b[n-1]
+template<size_t nbits, size_t es, size_t capacity, size_t fbits, size_t mbits>
+inline void fmm_accumulate(quire<nbits, es, capacity>& q, const value<fbits>* a, const value<fbits>* b, size_t n, value<mbits>& product) {
+	for (size_t k = 0; k < n; ++k) {
+		// same special case handling as quire_mul
+		if (a[k].isinf() || b[k].isinf()) {
+			product.setinf();
+		}
+		else if (a[k].iszero() || b[k].iszero()) {
+			continue;
+		}
+		else {
+			fmm_multiply(a[k], b[k], product);
+		}
+		q += product;
+	}
+}
+
+// process a row block of C: rows [i0, i1)
+template<size_t nbits, size_t es, size_t capacity>
+void fmm_row_block(const matrix< posit<nbits, es> >& A, const matrix< posit<nbits, es> >& B, matrix< posit<nbits, es> >& C, size_t i0, size_t i1) {
+	constexpr size_t fbits  = nbits - 3 - es;
+	constexpr size_t fhbits = fbits + 1;      // size of fraction + hidden bit
+	constexpr size_t mbits  = 2 * fhbits;     // size of the multiplier output
+	size_t cols = B.cols();
+	size_t dots = A.cols();
+	size_t mb = i1 - i0;
+
+	// decode the row block of A once: row-major, contiguous along the dot product
+	std::vector< value<fbits> > Ablock(mb * dots);
+	for (size_t i = 0; i < mb; ++i) {
+		for (size_t k = 0; k < dots; ++k) {
+			Ablock[i * dots + k] = fmm_decode(A(i0 + i, k));
+		}
+	}
+
+	std::vector< value<fbits> > Bpanel(FMM_TILE_COLS * FMM_PANEL_DEPTH);
+	std::vector< quire<nbits, es, capacity> > tile(FMM_TILE_ROWS * FMM_TILE_COLS);
+	value<mbits> product;
+	for (size_t j0 = 0; j0 < cols; j0 += FMM_TILE_COLS) {
+		size_t j1 = (j0 + FMM_TILE_COLS < cols ? j0 + FMM_TILE_COLS : cols);
+		size_t nb = j1 - j0;
+		for (size_t e = 0; e < mb * nb; ++e) tile[e].reset();
+		for (size_t k0 = 0; k0 < dots; k0 += FMM_PANEL_DEPTH) {
+			size_t k1 = (k0 + FMM_PANEL_DEPTH < dots ? k0 + FMM_PANEL_DEPTH : dots);
+			size_t kb = k1 - k0;
+			// decode the B panel transposed: column j of the panel is contiguous along the dot product
+			for (size_t k = 0; k < kb; ++k) {
+				for (size_t j = 0; j < nb; ++j) {
+					Bpanel[j * kb + k] = fmm_decode(B(k0 + k, j0 + j));
+				}
+			}
+			// accumulate the panel product into the tile quires
+			for (size_t i = 0; i < mb; ++i) {
+				const value<fbits>* a = &Ablock[i * dots + k0];
+				for (size_t j = 0; j < nb; ++j) {
+					fmm_accumulate(tile[i * nb + j], a, &Bpanel[j * kb], kb, product);
+				}
+			}
+		}
+		// one and only rounding step of the fused-dot products
+		for (size_t i = 0; i < mb; ++i) {
+			for (size_t j = 0; j < nb; ++j) {
+				convert(tile[i * nb + j].to_value(), C(i0 + i, j0 + j));
+			}
+		}
+	}
+}
+
+// fused matrix-matrix product: nrThreads = 0 selects the hardware concurrency of the machine
+template<size_t nbits, size_t es>
+matrix< posit<nbits, es> > fmm(const matrix< posit<nbits, es> >& A, const matrix< posit<nbits, es> >& B, unsigned nrThreads = 0) {
+	constexpr size_t capacity = 20; // FDP for vectors < 1,048,576 elements
+	if (A.cols() != B.rows()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), B.rows(), B.cols(), "*").what());
+	size_t rows = A.rows();
+	size_t cols = B.cols();
+	matrix< posit<nbits, es> > C(rows, cols);
+
+	// row blocks are distributed round-robin across the threads
+	size_t nrRowBlocks = (rows + FMM_TILE_ROWS - 1) / FMM_TILE_ROWS;
+	parallel_for(nrRowBlocks, nrThreads, [&](size_t rb) {
+		size_t i0 = rb * FMM_TILE_ROWS;
+		size_t i1 = (i0 + FMM_TILE_ROWS < rows ? i0 + FMM_TILE_ROWS : rows);
+		fmm_row_block<nbits, es, capacity>(A, B, C, i0, i1);
+	});
+	return C;
+}
+
+}}} // namespace sw::unum::blas
@@ -41,4 +41,13 @@ struct matmul_incompatible_matrices
 	};
 };
 
+// exception for element-wise operators on operands of different shapes
+struct elementwise_incompatible_operands
+	: public std::runtime_error
+{
+	elementwise_incompatible_operands(const std::string& error)
+		: std::runtime_error(std::string("BLAS element-wise operator: ") + error) {
+	};
+};
+
 }}} // namespace sw::unum::blas
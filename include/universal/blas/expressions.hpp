@@ -0,0 +1,488 @@
+#pragma once
+// expressions.hpp: expression templates for the vector and matrix operators
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <universal/blas/exceptions.hpp>
+#include <universal/posit/posit_fwd.hpp>
+#include <universal/traits/posit_traits.hpp>
+
+namespace sw { namespace unum { namespace blas {
+
+template<typename Scalar> class vector;
+template<typename Scalar> class matrix;
+
+// The operators of vector and matrix compute their result. Lazy evaluation is opt-in: fused(x) marks
+// a vector or a matrix as an operand of an expression, and the element-wise operators, scaling, and
+// the matrix-vector product applied to an expression return expressions that record the operation
+// and its operands instead of computing a temporary. An expression is evaluated when it is assigned
+// to, or used to construct, a vector or a matrix: a single loop computes every element of the result
+// from the elements of the operands, so that y = a*fused(x) + b*fused(z) allocates nothing and streams
+// through x, z, and y once.
+//
+// When the elements are posits, an expression that combines several terms, such as a*fused(x) + b*fused(z)
+// or fused(b) - fused(A)*x, is evaluated as a fused dot product: for every element the terms, and the products of a
+// scale factor or a matrix row with their operands, are accumulated in a quire and rounded once.
+// Nested scaling, such as a*(b*fused(x)) + z or a*(fused(A)*x) + y, distributes the scale factors over the terms:
+// the product of all the factors of a term is formed exactly, and the quire is widened to hold the
+// scales of these longer products. An expression with a single operation is evaluated directly, as
+// a posit operation is already correctly rounded. Quotients, and the matrix and vector operands of a
+// matrix-vector product that are expressions, are rounded terms of the fused evaluation.
+//
+// Expressions hold container operands that are lvalues by reference, and temporaries by value:
+// an expression stored in a variable, for example with auto, must not outlive the containers it refers to.
+
+namespace internal {
+	struct vector_expression_tag {};
+	struct matrix_expression_tag {};
+}
+
+// operand traits: containers and expressions that can appear in an expression
+template<typename T> struct is_vector_operand : std::is_base_of<internal::vector_expression_tag, T> {};
+template<typename Scalar> struct is_vector_operand< vector<Scalar> > : std::true_type {};
+template<typename T> struct is_matrix_operand : std::is_base_of<internal::matrix_expression_tag, T> {};
+template<typename Scalar> struct is_matrix_operand< matrix<Scalar> > : std::true_type {};
+
+namespace internal {
+
+	template<typename T> using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+	template<typename T>
+	constexpr bool is_expression = std::is_base_of<vector_expression_tag, T>::value || std::is_base_of<matrix_expression_tag, T>::value;
+	template<typename T>
+	constexpr bool is_operand = is_vector_operand<T>::value || is_matrix_operand<T>::value;
+
+	// containers that are lvalues are held by reference, expressions and temporary containers by value
+	template<typename T>
+	using operand_t = std::conditional_t<std::is_lvalue_reference<T>::value && !is_expression<remove_cvref_t<T>>, const remove_cvref_t<T>&, remove_cvref_t<T>>;
+
+	// the tag of an element-wise operation on an operand of type T
+	template<typename T>
+	using kind_t = std::conditional_t<is_matrix_operand<remove_cvref_t<T>>::value, matrix_expression_tag, vector_expression_tag>;
+
+	// number of rounding steps of the direct evaluation of an element
+	template<typename T>
+	constexpr size_t roundings() {
+		if constexpr (is_expression<remove_cvref_t<T>>) return remove_cvref_t<T>::roundings; else return 0;
+	}
+
+	// largest number of posit factors in a term of the fused evaluation of an element
+	template<typename T>
+	constexpr size_t factors() {
+		if constexpr (is_expression<remove_cvref_t<T>>) return remove_cvref_t<T>::factors; else return 1;
+	}
+
+	// true when the evaluation of an element at the target reads other elements of the target
+	template<typename T>
+	bool hazard(const T& t, const void* target) {
+		if constexpr (is_expression<T>) return t.hazard(target); else return false;
+	}
+	// true when the expression refers to the target
+	template<typename T>
+	bool refers_to(const T& t, const void* target) {
+		if constexpr (is_expression<T>) return t.refers_to(target); else return static_cast<const void*>(&t) == target;
+	}
+
+	// quire of the fused evaluation of posit expressions with terms of up to nrFactors factors:
+	// the lower half of the quire of posit<qbits,es> spans the scales of minpos^nrFactors to maxpos^nrFactors
+	template<typename Scalar, size_t nrFactors> struct fused_accumulator;
+	template<size_t nbits, size_t es, size_t nrFactors>
+	struct fused_accumulator< posit<nbits, es>, nrFactors > {
+		static constexpr size_t capacity = 20; // FDP for vectors < 1,048,576 elements
+		static constexpr size_t qbits = (nrFactors * (nbits - 2) + 5) / 2 > nbits ? (nrFactors * (nbits - 2) + 5) / 2 : nbits;
+		using type = quire<qbits, es, capacity>;
+	};
+
+	// exact product of a factor and a posit: the fractions are extended to the wider of the two,
+	// and the product keeps all their bits
+	template<size_t fa, size_t fb>
+	auto exact_product(const value<fa>& a, const value<fb>& b) {
+		constexpr size_t fw = (fa > fb ? fa : fb);
+		value<2 * (fw + 1)> product;  // constructs to zero value
+		if (a.isinf() || a.isnan() || b.isinf() || b.isnan()) { product.setinf(); return product; }
+		if (a.iszero() || b.iszero()) return product;
+		value<fw> wa, wb;
+		wa.template right_extend<fa, fw>(a);
+		wb.template right_extend<fb, fw>(b);
+		module_multiply(wa, wb, product);
+		return product;
+	}
+	template<size_t fa, size_t nbits, size_t es>
+	auto exact_product(const value<fa>& a, const posit<nbits, es>& b) {
+		return exact_product(a, b.to_value());
+	}
+	template<size_t nbits, size_t es>
+	auto exact_product(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		return quire_mul(a, b);
+	}
+
+	// add the element of t, or its negation, to the quire
+	template<typename Quire, typename T, typename... Index>
+	void accumulate(Quire& q, bool negate, const T& t, Index... idx) {
+		if constexpr (is_expression<T>) {
+			t.accumulate(q, negate, idx...);
+		}
+		else {
+			if (negate) q -= t(idx...).to_value(); else q += t(idx...).to_value();
+		}
+	}
+	// add the product of factor and the element of t, or its negation, to the quire
+	// the factor is a posit, or the exact product of the scale factors of the enclosing expressions
+	template<typename Quire, typename Factor, typename T, typename... Index>
+	void accumulate_product(Quire& q, bool negate, const Factor& factor, const T& t, Index... idx) {
+		if constexpr (is_expression<T>) {
+			t.accumulate_product(q, negate, factor, idx...);
+		}
+		else {
+			if (negate) q -= exact_product(factor, t(idx...)); else q += exact_product(factor, t(idx...));
+		}
+	}
+
+	// evaluate an element of an expression with a single rounding step
+	template<typename T, typename... Index>
+	typename T::value_type fused_element(const T& t, Index... idx) {
+		using Scalar = typename T::value_type;
+		typename fused_accumulator<Scalar, factors<T>()>::type q;
+		t.accumulate(q, false, idx...);
+		Scalar e;
+		convert(q.to_value(), e);  // one and only rounding step of the fused evaluation
+		return e;
+	}
+
+	// evaluate an element of an operand
+	template<typename T, typename... Index>
+	typename T::value_type element(const T& t, Index... idx) {
+		if constexpr (is_posit<typename T::value_type> && roundings<T>() > 1) {
+			return fused_element(t, idx...);
+		}
+		else {
+			return t(idx...);
+		}
+	}
+
+	// the shapes of the operands of an element-wise operation must be equal
+	template<typename L, typename R>
+	void conformant_shapes(const L& l, const R& r, const char* op) {
+		if constexpr (std::is_same<kind_t<L>, matrix_expression_tag>::value) {
+			if (l.rows() != r.rows() || l.cols() != r.cols()) throw elementwise_incompatible_operands(incompatible_matrices(l.rows(), l.cols(), r.rows(), r.cols(), op).what());
+		}
+		else {
+			if (l.size() != r.size()) throw elementwise_incompatible_operands(incompatible_matrices(l.size(), 1, r.size(), 1, op).what());
+		}
+	}
+
+} // namespace internal
+
+// a vector or matrix operand marked by fused(): its element is exact, and it accumulates directly in the quire
+template<typename C>
+class expression_operand : public internal::kind_t<C> {
+public:
+	typedef typename internal::remove_cvref_t<C>::value_type value_type;
+	static constexpr size_t roundings = 0;
+	static constexpr size_t factors = 1;
+
+	template<typename A>
+	explicit expression_operand(A&& a) : c(std::forward<A>(a)) {}
+
+	template<typename... Index>
+	value_type operator()(Index... idx) const { return c(idx...); }
+	value_type operator[](size_t i) const { return c(i); }
+
+	// selectors
+	auto size() const { return c.size(); }
+	size_t rows() const { return c.rows(); }
+	size_t cols() const { return c.cols(); }
+
+	bool hazard(const void*) const { return false; }
+	bool refers_to(const void* target) const { return internal::refers_to(c, target); }
+	template<typename Quire, typename... Index>
+	void accumulate(Quire& q, bool negate, Index... idx) const {
+		internal::accumulate(q, negate, c, idx...);
+	}
+	template<typename Quire, typename Factor, typename... Index>
+	void accumulate_product(Quire& q, bool negate, const Factor& factor, Index... idx) const {
+		internal::accumulate_product(q, negate, factor, c, idx...);
+	}
+
+private:
+	C c;
+};
+
+// element-wise sum, or difference, of two operands
+template<typename L, typename R, bool subtract>
+class expression_sum : public internal::kind_t<L> {
+public:
+	typedef typename internal::remove_cvref_t<L>::value_type value_type;
+	static constexpr size_t roundings = internal::roundings<L>() + internal::roundings<R>() + 1;
+	static constexpr size_t factors = (internal::factors<L>() > internal::factors<R>() ? internal::factors<L>() : internal::factors<R>());
+
+	template<typename A, typename B>
+	expression_sum(A&& a, B&& b) : l(std::forward<A>(a)), r(std::forward<B>(b)) {
+		internal::conformant_shapes(l, r, subtract ? "-" : "+");
+	}
+
+	template<typename... Index>
+	value_type operator()(Index... idx) const {
+		return (subtract ? internal::element(l, idx...) - internal::element(r, idx...) : internal::element(l, idx...) + internal::element(r, idx...));
+	}
+	value_type operator[](size_t i) const { return (*this)(i); }
+
+	// selectors
+	auto size() const { return l.size(); }
+	size_t rows() const { return l.rows(); }
+	size_t cols() const { return l.cols(); }
+
+	bool hazard(const void* target) const { return internal::hazard(l, target) || internal::hazard(r, target); }
+	bool refers_to(const void* target) const { return internal::refers_to(l, target) || internal::refers_to(r, target); }
+	template<typename Quire, typename... Index>
+	void accumulate(Quire& q, bool negate, Index... idx) const {
+		internal::accumulate(q, negate, l, idx...);
+		internal::accumulate(q, negate != subtract, r, idx...);
+	}
+	template<typename Quire, typename Factor, typename... Index>
+	void accumulate_product(Quire& q, bool negate, const Factor& factor, Index... idx) const {
+		internal::accumulate_product(q, negate, factor, l, idx...);
+		internal::accumulate_product(q, negate != subtract, factor, r, idx...);
+	}
+
+private:
+	L l;
+	R r;
+};
+
+// element-wise negation
+template<typename E>
+class expression_negation : public internal::kind_t<E> {
+public:
+	typedef typename internal::remove_cvref_t<E>::value_type value_type;
+	static constexpr size_t roundings = internal::roundings<E>();
+	static constexpr size_t factors = internal::factors<E>();
+
+	template<typename A>
+	explicit expression_negation(A&& a) : e(std::forward<A>(a)) {}
+
+	template<typename... Index>
+	value_type operator()(Index... idx) const { return -internal::element(e, idx...); }
+	value_type operator[](size_t i) const { return (*this)(i); }
+
+	// selectors
+	auto size() const { return e.size(); }
+	size_t rows() const { return e.rows(); }
+	size_t cols() const { return e.cols(); }
+
+	bool hazard(const void* target) const { return internal::hazard(e, target); }
+	bool refers_to(const void* target) const { return internal::refers_to(e, target); }
+	template<typename Quire, typename... Index>
+	void accumulate(Quire& q, bool negate, Index... idx) const {
+		internal::accumulate(q, !negate, e, idx...);
+	}
+	template<typename Quire, typename Factor, typename... Index>
+	void accumulate_product(Quire& q, bool negate, const Factor& factor, Index... idx) const {
+		internal::accumulate_product(q, !negate, factor, e, idx...);
+	}
+
+private:
+	E e;
+};
+
+// scaling by a scalar: a * e, or e / a
+template<typename E, bool divide>
+class expression_scaled : public internal::kind_t<E> {
+public:
+	typedef typename internal::remove_cvref_t<E>::value_type value_type;
+	static constexpr size_t roundings = internal::roundings<E>() + 1;
+	static constexpr size_t factors = divide ? 1 : internal::factors<E>() + 1;
+
+	template<typename A>
+	expression_scaled(const value_type& a, A&& x) : a(a), e(std::forward<A>(x)) {}
+
+	template<typename... Index>
+	value_type operator()(Index... idx) const { return (divide ? internal::element(e, idx...) / a : a * internal::element(e, idx...)); }
+	value_type operator[](size_t i) const { return (*this)(i); }
+
+	// selectors
+	auto size() const { return e.size(); }
+	size_t rows() const { return e.rows(); }
+	size_t cols() const { return e.cols(); }
+
+	bool hazard(const void* target) const { return internal::hazard(e, target); }
+	bool refers_to(const void* target) const { return internal::refers_to(e, target); }
+	// a product distributes over the terms of the operand, and multiplies exactly into the factor
+	// of an enclosing product; a quotient is a rounded term
+	template<typename Quire, typename... Index>
+	void accumulate(Quire& q, bool negate, Index... idx) const {
+		if constexpr (divide) {
+			if (negate) q -= (*this)(idx...).to_value(); else q += (*this)(idx...).to_value();
+		}
+		else {
+			internal::accumulate_product(q, negate, a, e, idx...);
+		}
+	}
+	template<typename Quire, typename Factor, typename... Index>
+	void accumulate_product(Quire& q, bool negate, const Factor& factor, Index... idx) const {
+		if constexpr (divide) {
+			if (negate) q -= internal::exact_product(factor, (*this)(idx...)); else q += internal::exact_product(factor, (*this)(idx...));
+		}
+		else {
+			internal::accumulate_product(q, negate, internal::exact_product(factor, a), e, idx...);
+		}
+	}
+
+private:
+	value_type a;
+	E e;
+};
+
+// matrix-vector product: a vector operand that is an expression is evaluated once, when the product is formed,
+// an operand marked by fused() is read in place
+template<typename M, typename V>
+class matrix_vector_product : public internal::vector_expression_tag {
+public:
+	typedef typename internal::remove_cvref_t<M>::value_type value_type;
+	static constexpr size_t roundings = 2;
+	static constexpr size_t factors = 2;
+
+	template<typename MA, typename VB>
+	matrix_vector_product(MA&& A_, VB&& x_) : A(std::forward<MA>(A_)), x(std::forward<VB>(x_)) {
+		if (A.cols() != x.size()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), x.size(), 1, "*").what());
+	}
+
+	value_type operator()(size_t i) const {
+		if constexpr (is_posit<value_type>) {
+			return internal::fused_element(*this, i);
+		}
+		else {
+			value_type e = value_type(0);
+			for (size_t j = 0; j < A.cols(); ++j) e += internal::element(A, i, j) * x(j);
+			return e;
+		}
+	}
+	value_type operator[](size_t i) const { return (*this)(i); }
+
+	// selectors
+	size_t size() const { return A.rows(); }
+
+	bool hazard(const void* target) const { return internal::refers_to(x, target); }
+	bool refers_to(const void* target) const { return internal::refers_to(A, target) || internal::refers_to(x, target); }
+	template<typename Quire>
+	void accumulate(Quire& q, bool negate, size_t i) const {
+		for (size_t j = 0; j < A.cols(); ++j) {
+			if (negate) q -= quire_mul(internal::element(A, i, j), x(j)); else q += quire_mul(internal::element(A, i, j), x(j));
+		}
+	}
+	template<typename Quire, typename Factor>
+	void accumulate_product(Quire& q, bool negate, const Factor& factor, size_t i) const {
+		for (size_t j = 0; j < A.cols(); ++j) {
+			auto product = internal::exact_product(internal::exact_product(factor, internal::element(A, i, j)), x(j));
+			if (negate) q -= product; else q += product;
+		}
+	}
+
+private:
+	using vector_operand = std::conditional_t<(internal::roundings<V>() > 0), vector<value_type>, V>;
+	M A;
+	vector_operand x;
+};
+
+namespace internal {
+	// the operators form expressions when one of their operands is an expression,
+	// the operators on containers are defined with vector and matrix and compute their result
+	template<typename L, typename R>
+	constexpr bool conformant_operands() {
+		using LT = remove_cvref_t<L>;
+		using RT = remove_cvref_t<R>;
+		if constexpr (!is_expression<LT> && !is_expression<RT>) {
+			return false;
+		}
+		else if constexpr ((is_vector_operand<LT>::value && is_vector_operand<RT>::value) || (is_matrix_operand<LT>::value && is_matrix_operand<RT>::value)) {
+			return std::is_same<typename LT::value_type, typename RT::value_type>::value;
+		}
+		else {
+			return false;
+		}
+	}
+	template<typename S, typename E>
+	constexpr bool scalar_operand() {
+		using ET = remove_cvref_t<E>;
+		if constexpr (is_expression<ET>) {
+			return std::is_arithmetic<S>::value || std::is_same<S, typename ET::value_type>::value;
+		}
+		else {
+			return false;
+		}
+	}
+}
+
+/// operators that form expressions
+
+// mark a vector or a matrix as an operand of a lazy expression
+template<typename C, typename = std::enable_if_t<internal::is_operand<internal::remove_cvref_t<C>>>>
+auto fused(C&& c) {
+	if constexpr (internal::is_expression<internal::remove_cvref_t<C>>) {
+		return internal::remove_cvref_t<C>(std::forward<C>(c));
+	}
+	else {
+		return expression_operand<internal::operand_t<C>>(std::forward<C>(c));
+	}
+}
+
+// element-wise sum
+template<typename L, typename R, typename = std::enable_if_t<internal::conformant_operands<L, R>()>>
+auto operator+(L&& l, R&& r) {
+	return expression_sum<internal::operand_t<L>, internal::operand_t<R>, false>(std::forward<L>(l), std::forward<R>(r));
+}
+// element-wise difference
+template<typename L, typename R, typename = std::enable_if_t<internal::conformant_operands<L, R>()>>
+auto operator-(L&& l, R&& r) {
+	return expression_sum<internal::operand_t<L>, internal::operand_t<R>, true>(std::forward<L>(l), std::forward<R>(r));
+}
+// negation
+template<typename E, typename = std::enable_if_t<internal::is_expression<internal::remove_cvref_t<E>>>>
+auto operator-(E&& e) {
+	return expression_negation<internal::operand_t<E>>(std::forward<E>(e));
+}
+// scaling
+template<typename S, typename E, typename = std::enable_if_t<internal::scalar_operand<S, E>()>>
+auto operator*(const S& a, E&& e) {
+	using value_type = typename internal::remove_cvref_t<E>::value_type;
+	return expression_scaled<internal::operand_t<E>, false>(value_type(a), std::forward<E>(e));
+}
+template<typename E, typename S, typename = std::enable_if_t<internal::scalar_operand<S, E>()>>
+auto operator*(E&& e, const S& a) {
+	using value_type = typename internal::remove_cvref_t<E>::value_type;
+	return expression_scaled<internal::operand_t<E>, false>(value_type(a), std::forward<E>(e));
+}
+template<typename E, typename S, typename = std::enable_if_t<internal::scalar_operand<S, E>()>>
+auto operator/(E&& e, const S& a) {
+	using value_type = typename internal::remove_cvref_t<E>::value_type;
+	return expression_scaled<internal::operand_t<E>, true>(value_type(a), std::forward<E>(e));
+}
+// matrix-vector product
+template<typename M, typename V, typename = std::enable_if_t<is_matrix_operand<internal::remove_cvref_t<M>>::value && is_vector_operand<internal::remove_cvref_t<V>>::value
+	&& (internal::is_expression<internal::remove_cvref_t<M>> || internal::is_expression<internal::remove_cvref_t<V>>)>>
+auto operator*(M&& A, V&& x) {
+	return matrix_vector_product<internal::operand_t<M>, internal::operand_t<V>>(std::forward<M>(A), std::forward<V>(x));
+}
+
+// size of a vector expression
+template<typename E, typename = std::enable_if_t<std::is_base_of<internal::vector_expression_tag, E>::value>>
+size_t size(const E& e) { return e.size(); }
+
+// print an expression by evaluating it
+template<typename E, typename = std::enable_if_t<internal::is_expression<E>>>
+std::ostream& operator<<(std::ostream& ostr, const E& e) {
+	using value_type = typename E::value_type;
+	if constexpr (std::is_base_of<internal::vector_expression_tag, E>::value) {
+		return ostr << vector<value_type>(e);
+	}
+	else {
+		return ostr << matrix<value_type>(e);
+	}
+}
+
+}}}  // namespace sw::unum::blas
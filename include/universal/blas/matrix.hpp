@@ -10,6 +10,7 @@
 #include <map>
 #include <universal/blas/exceptions.hpp>
 #include <universal/posit/posit_fwd.hpp>
+#include <universal/blas/expressions.hpp>
 
 namespace sw { namespace unum { namespace blas { 
 
@@ -63,10 +64,22 @@ public:
 		_n = ncols;
 	}
 	matrix(const matrix& A) : _m{ A._m }, _n{ A._n }, data(A.data) {}
+	// evaluate a matrix expression
+	template<typename Expression, typename = std::enable_if_t<std::is_base_of<internal::matrix_expression_tag, Expression>::value>>
+	matrix(const Expression& e) : _m{ e.rows() }, _n{ e.cols() }, data(e.rows() * e.cols()) {
+		evaluate(e);
+	}
 
 	// operators
 	matrix& operator=(const matrix& M) = default;
 	matrix& operator=(matrix&& M) = default;
+	// element-wise expressions only read the element they compute, so they can be evaluated in place
+	template<typename Expression, typename = std::enable_if_t<std::is_base_of<internal::matrix_expression_tag, Expression>::value>>
+	matrix& operator=(const Expression& e) {
+		resize(e.rows(), e.cols());
+		evaluate(e);
+		return *this;
+	}
 
 	// Identity matrix operator
 	matrix& operator=(const Scalar& one) {
@@ -178,6 +191,13 @@ private:
 	size_t _m, _n; // m rows and n columns
 	std::vector<Scalar> data;
 
+	template<typename Expression>
+	void evaluate(const Expression& e) {
+		for (size_t i = 0; i < _m; ++i) {
+			for (size_t j = 0; j < _n; ++j) data[i*_n + j] = internal::element(e, i, j);
+		}
+	}
+
 };
 
 template<typename Scalar>
@@ -238,6 +258,7 @@ matrix<Scalar> operator/(const matrix<Scalar>& A, const Scalar& b) {
 // matrix-vector multiply
 template<typename Scalar>
 vector<Scalar> operator*(const matrix<Scalar>& A, const vector<Scalar>& x) {
+	if (A.cols() != x.size()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), x.size(), 1, "*").what());
 	vector<Scalar> b(A.rows());
 	for (size_t i = 0; i < A.rows(); ++i) {
 		b[i] = Scalar(0);
@@ -252,6 +273,7 @@ vector<Scalar> operator*(const matrix<Scalar>& A, const vector<Scalar>& x) {
 template<size_t nbits, size_t es>
 vector< posit<nbits, es> > operator*(const matrix< posit<nbits, es> >& A, const vector< posit<nbits, es> >& x) {
 	constexpr size_t capacity = 20; // FDP for vectors < 1,048,576 elements
+	if (A.cols() != x.size()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), x.size(), 1, "*").what());
 	vector< posit<nbits, es> > b(A.rows());
 	for (size_t i = 0; i < A.rows(); ++i) {
 		quire<nbits, es, capacity> q;
@@ -283,24 +305,11 @@ matrix<Scalar> operator*(const matrix<Scalar>& A, const matrix<Scalar>& B) {
 }
 
 // overload for posits uses fused dot products
+// the fused matrix-matrix product engine fmm is defined in blas_l3.hpp, which blas.hpp includes:
+// the call is found by argument-dependent lookup where the operator is instantiated
 template<size_t nbits, size_t es>
 matrix< posit<nbits, es> > operator*(const matrix< posit<nbits, es> >& A, const matrix< posit<nbits, es> >& B) {
-	constexpr size_t capacity = 20; // FDP for vectors < 1,048,576 elements
-	if (A.cols() != B.rows()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), B.rows(), B.cols(), "*").what());
-	size_t rows = A.rows();
-	size_t cols = B.cols();
-	size_t dots = A.cols();
-	matrix< posit<nbits, es> > C(rows, cols);
-	for (size_t i = 0; i < rows; ++i) {
-		for (size_t j = 0; j < cols; ++j) {
-			quire<nbits, es, capacity> q;
-			for (size_t k = 0; k < dots; ++k) {
-				q += quire_mul(A(i, k), B(k, j));
-			}
-			convert(q.to_value(), C(i, j)); // one and only rounding step of the fused-dot product
-		}
-	}
-	return C;
+	return fmm(A, B);
 }
 
 // matrix equivalence tests
@@ -0,0 +1,380 @@
+#pragma once
+// packed.hpp: bit-packed vectors and matrices of posits, fixpnts, and integers of odd widths
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/matrix.hpp>
+#include <universal/blas/serialization/datafile.hpp>
+
+namespace sw { namespace unum { namespace blas {
+
+// A posit<10,1> holds its encoding in a 64-bit word, so an array of them uses more than six times
+// the storage of the information it contains. packed_vector and packed_matrix store the encodings
+// back to back, nbits per element, in a little-endian bitstream of 64-bit words: the layout of the
+// payload of a data file, see serialization/datafile.hpp.
+//
+// Elements are unpacked into arrays of Scalar a block at a time. A block of 64 elements occupies
+// exactly nbits words, so the position of every field in a block is a compile-time constant, and
+// the block is unpacked with straight-line word loads and shifts, which the compiler can vectorize.
+// The BLAS kernels below stream their packed operands through such blocks, so that bandwidth-bound
+// kernels, like dot, axpy, and matrix-vector products, move nbits per element through the memory system.
+// Single elements are accessed through a proxy reference.
+
+namespace internal {
+
+	// elements per unpack block: 64 fields of nbits occupy nbits words
+	constexpr size_t PACKED_BLOCK = 64;
+
+	// fetch the field of nbits <= 64 that starts at a bit offset: the word following the field must be readable
+	template<size_t nbits>
+	inline uint64_t get_field(const uint64_t* words, uint64_t offset) {
+		const uint64_t* w = words + offset / 64;
+		const unsigned shift = unsigned(offset % 64);
+		return ((w[0] >> shift) | ((w[1] << 1) << (63 - shift))) & limb_mask(nbits);
+	}
+	// store the field of nbits <= 64 at a bit offset, the bits of v above nbits must be 0
+	template<size_t nbits>
+	inline void put_field(uint64_t* words, uint64_t offset, uint64_t v) {
+		uint64_t* w = words + offset / 64;
+		const unsigned shift = unsigned(offset % 64);
+		const uint64_t mask = limb_mask(nbits);
+		w[0] = (w[0] & ~(mask << shift)) | (v << shift);
+		if (shift + nbits > 64) w[1] = (w[1] & ~(mask >> (64 - shift))) | (v >> (64 - shift));
+	}
+
+	// fetch and store the limbs of a field of any width
+	template<size_t nbits>
+	inline void get_limbs(const uint64_t* words, uint64_t offset, uint64_t* limbs) {
+		for (size_t l = 0; 64 * l + 64 < nbits; ++l, offset += 64) limbs[l] = get_field<64>(words, offset);
+		limbs[(nbits - 1) / 64] = get_field<nbits - 64 * ((nbits - 1) / 64)>(words, offset);
+	}
+	template<size_t nbits>
+	inline void put_limbs(uint64_t* words, uint64_t offset, const uint64_t* limbs) {
+		for (size_t l = 0; 64 * l + 64 < nbits; ++l, offset += 64) put_field<64>(words, offset, limbs[l]);
+		put_field<nbits - 64 * ((nbits - 1) / 64)>(words, offset, limbs[(nbits - 1) / 64]);
+	}
+
+	// the fields of a block expanded at compile time, so that every word index and shift is a constant
+	template<size_t nbits, size_t... k>
+	inline void unpack_fields(const uint64_t* words, uint64_t* fields, std::index_sequence<k...>) {
+		((fields[k] = get_field<nbits>(words, k * nbits)), ...);
+	}
+
+	// unpack the 64 fields of nbits <= 64 of the block that starts at words: the word following the block must be readable
+	template<size_t nbits>
+	inline void unpack_block(const uint64_t* words, uint64_t* fields) {
+		unpack_fields<nbits>(words, fields, std::make_index_sequence<PACKED_BLOCK>{});
+	}
+	// deposit field k of a block into the words of the block, which must have been cleared
+	template<size_t nbits, size_t k>
+	inline void deposit_field(uint64_t* words, uint64_t field) {
+		constexpr size_t   word  = k * nbits / 64;
+		constexpr unsigned shift = unsigned(k * nbits % 64);
+		words[word] |= field << shift;
+		if constexpr (shift + nbits > 64) words[word + 1] |= field >> (64 - shift);
+	}
+	template<size_t nbits, size_t... k>
+	inline void pack_fields(uint64_t* words, const uint64_t* fields, std::index_sequence<k...>) {
+		(deposit_field<nbits, k>(words, fields[k]), ...);
+	}
+
+	// pack 64 fields of nbits <= 64 into the nbits words of a block
+	template<size_t nbits>
+	inline void pack_block(uint64_t* words, const uint64_t* fields) {
+		for (size_t w = 0; w < nbits; ++w) words[w] = 0;
+		pack_fields<nbits>(words, fields, std::make_index_sequence<PACKED_BLOCK>{});
+	}
+
+} // namespace internal
+
+template<typename Container> class packed_reference;
+
+// bit-packed vector of elements of type Scalar
+template<typename Scalar>
+class packed_vector {
+	using Encoding = binary_encoding<Scalar>;
+public:
+	static constexpr size_t nbits = Encoding::nbits;
+	typedef Scalar                          value_type;
+	typedef packed_reference<packed_vector> reference;
+
+	packed_vector() : _size{ 0 }, _words(1, 0) {}
+	explicit packed_vector(size_t N) : _size{ N }, _words(nrWords(N), 0) {}
+	packed_vector(size_t N, const Scalar& val) : _size{ N }, _words(nrWords(N), 0) {
+		for (size_t i = 0; i < N; ++i) set(i, val);
+	}
+	packed_vector(std::initializer_list<Scalar> iList) : _size{ iList.size() }, _words(nrWords(iList.size()), 0) {
+		pack(0, _size, iList.begin());
+	}
+	explicit packed_vector(const vector<Scalar>& v) : _size{ v.size() }, _words(nrWords(v.size()), 0) {
+		for (size_t i = 0; i < _size; ++i) set(i, v[i]);
+	}
+
+	Scalar operator[](size_t i) const { return get(i); }
+	reference operator[](size_t i) { return reference(*this, i); }
+	Scalar operator()(size_t i) const { return get(i); }
+	reference operator()(size_t i) { return reference(*this, i); }
+
+	// element access
+	Scalar get(size_t i) const {
+		uint64_t limbs[nrLimbs];
+		internal::get_limbs<nbits>(_words.data(), uint64_t(i) * nbits, limbs);
+		Scalar v;
+		Encoding::load(v, limbs);
+		return v;
+	}
+	void set(size_t i, const Scalar& v) {
+		uint64_t limbs[nrLimbs];
+		Encoding::store(v, limbs);
+		internal::put_limbs<nbits>(_words.data(), uint64_t(i) * nbits, limbs);
+	}
+
+	// unpack the elements [first, first + count) into out
+	void unpack(size_t first, size_t count, Scalar* out) const {
+		size_t i = first, last = first + count;
+		if constexpr (nbits <= 64) {
+			for (; i < last && i % internal::PACKED_BLOCK != 0; ++i) *out++ = get(i);
+			uint64_t fields[internal::PACKED_BLOCK];
+			for (; i + internal::PACKED_BLOCK <= last; i += internal::PACKED_BLOCK) {
+				internal::unpack_block<nbits>(_words.data() + (i / internal::PACKED_BLOCK) * nbits, fields);
+				for (size_t k = 0; k < internal::PACKED_BLOCK; ++k) Encoding::load(*out++, fields + k);
+			}
+		}
+		for (; i < last; ++i) *out++ = get(i);
+	}
+	// pack count elements from in into [first, first + count)
+	void pack(size_t first, size_t count, const Scalar* in) {
+		size_t i = first, last = first + count;
+		if constexpr (nbits <= 64) {
+			for (; i < last && i % internal::PACKED_BLOCK != 0; ++i) set(i, *in++);
+			uint64_t fields[internal::PACKED_BLOCK];
+			for (; i + internal::PACKED_BLOCK <= last; i += internal::PACKED_BLOCK) {
+				for (size_t k = 0; k < internal::PACKED_BLOCK; ++k) Encoding::store(*in++, fields + k);
+				internal::pack_block<nbits>(_words.data() + (i / internal::PACKED_BLOCK) * nbits, fields);
+			}
+		}
+		for (; i < last; ++i) set(i, *in++);
+	}
+
+	// modifiers
+	void resize(size_t N) {
+		if (N < _size) {
+			// clear the bits beyond the new end, so that growing again yields zeros
+			for (size_t i = N; i < _size; ++i) set(i, Scalar(0));
+		}
+		_words.resize(nrWords(N), 0);
+		_size = N;
+	}
+
+	// selectors
+	size_t size() const { return _size; }
+	// storage footprint in bytes
+	size_t bytes() const { return _words.size() * sizeof(uint64_t); }
+	// the bitstream, followed by a zero guard word
+	const uint64_t* words() const { return _words.data(); }
+
+private:
+	static constexpr size_t nrLimbs = (nbits + 63) / 64;
+	// the guard word lets every field be fetched with two word loads
+	static size_t nrWords(size_t N) { return (N * nbits + 63) / 64 + 1; }
+
+	size_t                _size;
+	std::vector<uint64_t> _words;
+};
+
+template<typename Scalar> auto size(const packed_vector<Scalar>& v) { return v.size(); }
+
+// proxy for an element of a packed container
+template<typename Container>
+class packed_reference {
+public:
+	typedef typename Container::value_type value_type;
+
+	packed_reference(Container& c, size_t i) : c{ c }, i{ i } {}
+	operator value_type() const { return c.get(i); }
+
+	packed_reference& operator=(const value_type& v) { c.set(i, v); return *this; }
+	packed_reference& operator=(const packed_reference& r) { c.set(i, r.c.get(r.i)); return *this; }
+	packed_reference& operator+=(const value_type& v) { value_type e = c.get(i); e += v; c.set(i, e); return *this; }
+	packed_reference& operator-=(const value_type& v) { value_type e = c.get(i); e -= v; c.set(i, e); return *this; }
+	packed_reference& operator*=(const value_type& v) { value_type e = c.get(i); e *= v; c.set(i, e); return *this; }
+	packed_reference& operator/=(const value_type& v) { value_type e = c.get(i); e /= v; c.set(i, e); return *this; }
+
+	// the operators of the number systems are templates, which do not consider the conversion of the proxy
+	friend value_type operator+(const packed_reference& a, const value_type& b) { return value_type(a) + b; }
+	friend value_type operator+(const value_type& a, const packed_reference& b) { return a + value_type(b); }
+	friend value_type operator+(const packed_reference& a, const packed_reference& b) { return value_type(a) + value_type(b); }
+	friend value_type operator-(const packed_reference& a, const value_type& b) { return value_type(a) - b; }
+	friend value_type operator-(const value_type& a, const packed_reference& b) { return a - value_type(b); }
+	friend value_type operator-(const packed_reference& a, const packed_reference& b) { return value_type(a) - value_type(b); }
+	friend value_type operator*(const packed_reference& a, const value_type& b) { return value_type(a) * b; }
+	friend value_type operator*(const value_type& a, const packed_reference& b) { return a * value_type(b); }
+	friend value_type operator*(const packed_reference& a, const packed_reference& b) { return value_type(a) * value_type(b); }
+	friend value_type operator/(const packed_reference& a, const value_type& b) { return value_type(a) / b; }
+	friend value_type operator/(const value_type& a, const packed_reference& b) { return a / value_type(b); }
+	friend value_type operator/(const packed_reference& a, const packed_reference& b) { return value_type(a) / value_type(b); }
+	friend bool operator==(const packed_reference& a, const value_type& b) { return value_type(a) == b; }
+	friend bool operator==(const value_type& a, const packed_reference& b) { return a == value_type(b); }
+	friend bool operator==(const packed_reference& a, const packed_reference& b) { return value_type(a) == value_type(b); }
+	friend bool operator!=(const packed_reference& a, const value_type& b) { return value_type(a) != b; }
+	friend bool operator!=(const value_type& a, const packed_reference& b) { return a != value_type(b); }
+	friend bool operator!=(const packed_reference& a, const packed_reference& b) { return value_type(a) != value_type(b); }
+	friend bool operator<(const packed_reference& a, const value_type& b) { return value_type(a) < b; }
+	friend bool operator<(const value_type& a, const packed_reference& b) { return a < value_type(b); }
+	friend bool operator<(const packed_reference& a, const packed_reference& b) { return value_type(a) < value_type(b); }
+	friend bool operator>(const packed_reference& a, const value_type& b) { return value_type(a) > b; }
+	friend bool operator>(const value_type& a, const packed_reference& b) { return a > value_type(b); }
+	friend bool operator>(const packed_reference& a, const packed_reference& b) { return value_type(a) > value_type(b); }
+	friend std::ostream& operator<<(std::ostream& ostr, const packed_reference& r) { return ostr << value_type(r); }
+
+private:
+	Container& c;
+	size_t     i;
+};
+
+template<typename Scalar>
+std::ostream& operator<<(std::ostream& ostr, const packed_vector<Scalar>& v) {
+	auto width = ostr.precision() + 2;
+	for (size_t j = 0; j < size(v); ++j) ostr << std::setw(width) << v[j] << " ";
+	return ostr;
+}
+
+// bit-packed, row-major matrix of elements of type Scalar
+template<typename Scalar>
+class packed_matrix {
+public:
+	typedef Scalar                                       value_type;
+	typedef typename packed_vector<Scalar>::reference    reference;
+
+	packed_matrix() : _m{ 0 }, _n{ 0 } {}
+	packed_matrix(size_t m, size_t n) : _m{ m }, _n{ n }, _data(m * n) {}
+	explicit packed_matrix(const matrix<Scalar>& A) : _m{ A.rows() }, _n{ A.cols() }, _data(A.rows() * A.cols()) {
+		for (size_t i = 0; i < _m; ++i) {
+			for (size_t j = 0; j < _n; ++j) _data.set(i * _n + j, A(i, j));
+		}
+	}
+
+	Scalar operator()(size_t i, size_t j) const { return _data.get(i * _n + j); }
+	reference operator()(size_t i, size_t j) { return _data[i * _n + j]; }
+
+	// unpack the elements [first, first + count) of row i into out
+	void unpack_row(size_t i, size_t first, size_t count, Scalar* out) const { _data.unpack(i * _n + first, count, out); }
+
+	// modifiers
+	void resize(size_t m, size_t n) { _m = m; _n = n; _data.resize(m * n); }
+
+	// selectors
+	inline size_t rows() const { return _m; }
+	inline size_t cols() const { return _n; }
+	inline std::pair<size_t, size_t> size() const { return std::make_pair(_m, _n); }
+	size_t bytes() const { return _data.bytes(); }
+
+private:
+	size_t _m, _n; // m rows and n columns
+	packed_vector<Scalar> _data;
+};
+
+template<typename Scalar>
+inline size_t num_rows(const packed_matrix<Scalar>& A) { return A.rows(); }
+template<typename Scalar>
+inline size_t num_cols(const packed_matrix<Scalar>& A) { return A.cols(); }
+
+template<typename Scalar>
+std::ostream& operator<<(std::ostream& ostr, const packed_matrix<Scalar>& A) {
+	auto width = ostr.precision() + 2;
+	for (size_t i = 0; i < A.rows(); ++i) {
+		for (size_t j = 0; j < A.cols(); ++j) ostr << std::setw(width) << A(i, j) << " ";
+		ostr << '\n';
+	}
+	return ostr;
+}
+
+// BLAS kernels that stream packed operands through blocks of unpacked elements
+
+// number of elements that the kernels unpack at a time
+constexpr size_t PACKED_KERNEL_BLOCK = 4 * internal::PACKED_BLOCK;
+
+// dot product, with the semantics of dot(const Vector&, const Vector&)
+template<typename Scalar>
+Scalar dot(const packed_vector<Scalar>& x, const packed_vector<Scalar>& y) {
+	Scalar sum_of_products = Scalar(0);
+	size_t nx = size(x);
+	if (nx <= size(y)) {
+		Scalar xb[PACKED_KERNEL_BLOCK], yb[PACKED_KERNEL_BLOCK];
+		for (size_t i = 0; i < nx; i += PACKED_KERNEL_BLOCK) {
+			size_t count = (nx - i < PACKED_KERNEL_BLOCK ? nx - i : PACKED_KERNEL_BLOCK);
+			x.unpack(i, count, xb);
+			y.unpack(i, count, yb);
+			for (size_t k = 0; k < count; ++k) sum_of_products += xb[k] * yb[k];
+		}
+	}
+	return sum_of_products;
+}
+
+// a times x plus y
+template<typename Scalar>
+void axpy(size_t n, Scalar a, const packed_vector<Scalar>& x, size_t incx, packed_vector<Scalar>& y, size_t incy) {
+	if (incx == 1 && incy == 1) {
+		if (n > size(x)) n = size(x);
+		if (n > size(y)) n = size(y);
+		Scalar xb[PACKED_KERNEL_BLOCK], yb[PACKED_KERNEL_BLOCK];
+		for (size_t i = 0; i < n; i += PACKED_KERNEL_BLOCK) {
+			size_t count = (n - i < PACKED_KERNEL_BLOCK ? n - i : PACKED_KERNEL_BLOCK);
+			x.unpack(i, count, xb);
+			y.unpack(i, count, yb);
+			for (size_t k = 0; k < count; ++k) yb[k] += a * xb[k];
+			y.pack(i, count, yb);
+		}
+		return;
+	}
+	size_t cnt, ix, iy;
+	for (cnt = 0, ix = 0, iy = 0; cnt < n && ix < size(x) && iy < size(y); ++cnt, ix += incx, iy += incy) {
+		Scalar e = y.get(iy);
+		e += a * x.get(ix);
+		y.set(iy, e);
+	}
+}
+
+// matrix-vector multiply
+template<typename Scalar>
+vector<Scalar> operator*(const packed_matrix<Scalar>& A, const vector<Scalar>& x) {
+	vector<Scalar> b(A.rows());
+	Scalar ab[PACKED_KERNEL_BLOCK];
+	for (size_t i = 0; i < A.rows(); ++i) {
+		Scalar e = Scalar(0);
+		for (size_t j = 0; j < A.cols(); j += PACKED_KERNEL_BLOCK) {
+			size_t count = (A.cols() - j < PACKED_KERNEL_BLOCK ? A.cols() - j : PACKED_KERNEL_BLOCK);
+			A.unpack_row(i, j, count, ab);
+			for (size_t k = 0; k < count; ++k) e += ab[k] * x[j + k];
+		}
+		b[i] = e;
+	}
+	return b;
+}
+
+// overload for posits to use fused dot products
+template<size_t nbits, size_t es>
+vector< posit<nbits, es> > operator*(const packed_matrix< posit<nbits, es> >& A, const vector< posit<nbits, es> >& x) {
+	constexpr size_t capacity = 20; // FDP for vectors < 1,048,576 elements
+	vector< posit<nbits, es> > b(A.rows());
+	posit<nbits, es> ab[PACKED_KERNEL_BLOCK];
+	for (size_t i = 0; i < A.rows(); ++i) {
+		quire<nbits, es, capacity> q;
+		for (size_t j = 0; j < A.cols(); j += PACKED_KERNEL_BLOCK) {
+			size_t count = (A.cols() - j < PACKED_KERNEL_BLOCK ? A.cols() - j : PACKED_KERNEL_BLOCK);
+			A.unpack_row(i, j, count, ab);
+			for (size_t k = 0; k < count; ++k) q += quire_mul(ab[k], x[j + k]);
+		}
+		convert(q.to_value(), b[i]); // one and only rounding step of the fused-dot product
+	}
+	return b;
+}
+
+}}}  // namespace sw::unum::blas
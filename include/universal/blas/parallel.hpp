@@ -0,0 +1,55 @@
+#pragma once
+// parallel.hpp: distribution of independent tasks across threads for the BLAS functions
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <vector>
+#include <thread>
+#include <exception>
+#include <functional>
+
+namespace sw { namespace unum { namespace blas {
+
+// the number of threads that run nrTasks tasks: nrThreads = 0 selects the hardware concurrency of the machine,
+// and there are never more threads than tasks
+inline unsigned thread_count(size_t nrTasks, unsigned nrThreads) {
+	if (nrThreads == 0) nrThreads = std::thread::hardware_concurrency();
+	if (nrThreads == 0) nrThreads = 1;
+	if (nrThreads > nrTasks) nrThreads = unsigned(nrTasks);
+	return nrThreads;
+}
+
+// run task(t) for the tasks t in [0, nrTasks), distributed round-robin across thread_count(nrTasks, nrThreads) threads
+// an exception thrown by a task is rethrown on the calling thread
+template<typename Task>
+void parallel_for(size_t nrTasks, unsigned nrThreads, Task&& task) {
+	nrThreads = thread_count(nrTasks, nrThreads);
+
+	auto worker = [&](unsigned t, std::exception_ptr& error) {
+		try {
+			for (size_t task_id = t; task_id < nrTasks; task_id += nrThreads) task(task_id);
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+	};
+
+	std::vector<std::exception_ptr> errors(nrThreads > 0 ? nrThreads : 1);
+	if (nrThreads <= 1) {
+		worker(0, errors[0]);
+	}
+	else {
+		std::vector<std::thread> threads;
+		threads.reserve(nrThreads);
+		for (unsigned t = 0; t < nrThreads; ++t) {
+			threads.emplace_back(worker, t, std::ref(errors[t]));
+		}
+		for (auto& thread : threads) thread.join();
+	}
+	for (auto& error : errors) {
+		if (error) std::rethrow_exception(error);
+	}
+}
+
+}}}  // namespace sw::unum::blas
@@ -0,0 +1,453 @@
+#pragma once
+// datafile.hpp: self-describing binary data files of vectors and matrices of posits, fixpnts, and integers
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <universal/posit/posit_fwd.hpp>
+#include <universal/bitblock/bitblock.hpp>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/matrix.hpp>
+
+namespace sw { namespace unum {
+
+template<size_t nbits, size_t rbits, bool arithmetic, typename bt> class fixpnt;
+template<size_t nbits, typename BlockType> class integer;
+
+namespace blas {
+
+// A data file holds a vector or a matrix, and is laid out as follows, all fields little-endian:
+//   offset  size  field
+//        0     8  magic "UNUMDATA"
+//        8     2  format version
+//       10     1  number system: 1 posit, 2 fixpnt, 3 integer
+//       11     1  flags: bit 0 is set for a saturating fixpnt
+//       12     4  nbits
+//       16     4  es of a posit, rbits of a fixpnt, 0 for an integer
+//       20     4  rank: 1 for a vector, 2 for a matrix
+//       24     8  rows
+//       32     8  columns, 1 for a vector
+//       40     8  payload offset from the start of the file, a multiple of 64
+//       48     8  payload size in bytes
+//       56     8  reserved, 0
+//       64        payload
+// The payload is a little-endian bitstream of the element encodings in row-major order,
+// nbits per element without padding, so a posit<10,1> takes 10 bits. It is padded with zeros
+// to a multiple of 8 bytes and followed by 8 zero bytes, so that any element can be fetched
+// with 64-bit loads. When nbits is a multiple of 8 and the in-memory representation of the type
+// is its encoding, the payload of a memory-mapped file can be used in place: see mapped_dataset.hpp.
+
+enum class number_system : uint8_t { posit = 1, fixpnt = 2, integer = 3 };
+
+struct datafile_error
+	: public std::runtime_error
+{
+	datafile_error(const std::string& error)
+		: std::runtime_error(std::string("data file: ") + error) {};
+};
+
+constexpr char     DATAFILE_MAGIC[8] = { 'U', 'N', 'U', 'M', 'D', 'A', 'T', 'A' };
+constexpr uint16_t DATAFILE_VERSION = 1;
+constexpr size_t   DATAFILE_HEADER_SIZE = 64;
+constexpr uint8_t  DATAFILE_SATURATING = 0x01;
+
+struct datafile_header {
+	number_system system;
+	uint8_t  flags;
+	uint32_t nbits;
+	uint32_t param;          // es or rbits
+	uint32_t rank;
+	uint64_t rows;
+	uint64_t cols;
+	uint64_t payloadOffset;
+	uint64_t payloadSize;
+};
+
+/// binary_encoding<Scalar> describes the storage of a number system in a data file: the type tag,
+/// and the transfer of an encoding to and from little-endian 64-bit limbs
+template<typename Scalar> struct binary_encoding;
+
+namespace internal {
+
+	inline uint64_t load_le(const uint8_t* bytes, size_t nrBytes) {
+		uint64_t v = 0;
+		for (size_t i = 0; i < nrBytes; ++i) v |= uint64_t(bytes[i]) << (8 * i);
+		return v;
+	}
+	inline void store_le(uint8_t* bytes, uint64_t v, size_t nrBytes) {
+		for (size_t i = 0; i < nrBytes; ++i) bytes[i] = uint8_t(v >> (8 * i));
+	}
+
+	inline bool little_endian_host() {
+		const uint16_t probe = 1;
+		return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+	}
+
+	inline uint64_t limb_mask(size_t n) {
+		return (n >= 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1);
+	}
+
+	template<size_t nbits>
+	void bitblock_to_limbs(const bitblock<nbits>& bb, uint64_t* limbs) {
+#if BITBLOCK_WORD_ARRAY
+		for (size_t i = 0; i < (nbits + 63) / 64; ++i) limbs[i] = bb.word(i);
+#else
+		for (size_t i = 0; i < (nbits + 63) / 64; ++i) limbs[i] = 0;
+		for (size_t i = 0; i < nbits; ++i) if (bb.test(i)) limbs[i / 64] |= uint64_t(1) << (i % 64);
+#endif
+	}
+	template<size_t nbits>
+	void limbs_to_bitblock(bitblock<nbits>& bb, const uint64_t* limbs) {
+#if BITBLOCK_WORD_ARRAY
+		for (size_t i = 0; i < (nbits + 63) / 64; ++i) bb.setword(i, limbs[i]);
+#else
+		for (size_t i = 0; i < nbits; ++i) bb[i] = bool((limbs[i / 64] >> (i % 64)) & 1);
+#endif
+	}
+
+	// extract nbits at a bit offset of a little-endian bitstream into limbs:
+	// the stream must be readable for 8 bytes past the byte that holds the last bit
+	inline void extract_bits(const uint8_t* stream, uint64_t offset, size_t nbits, uint64_t* limbs) {
+		for (size_t l = 0; 64 * l < nbits; ++l, offset += 64) {
+			const uint8_t* p = stream + offset / 8;
+			const unsigned shift = unsigned(offset % 8);
+			const size_t n = (nbits - 64 * l < 64 ? nbits - 64 * l : 64);
+			uint64_t v = load_le(p, 8) >> shift;
+			if (shift + n > 64) v |= uint64_t(p[8]) << (64 - shift);
+			limbs[l] = v & limb_mask(n);
+		}
+	}
+
+	// pack bit fields into a little-endian bitstream on an output stream
+	class bitstream_writer {
+	public:
+		explicit bitstream_writer(std::ostream& ostr) : ostr(ostr), acc{ 0 }, fill{ 0 }, used{ 0 }, words{ 0 } {}
+		// append the n bits, 0 < n <= 64, of bits: bits above n must be 0
+		void put(uint64_t bits, unsigned n) {
+			acc |= bits << fill;
+			unsigned total = fill + n;
+			if (total >= 64) {
+				emit(acc);
+				acc = (fill == 0 ? 0 : bits >> (64 - fill));
+				total -= 64;
+			}
+			fill = total;
+		}
+		// pad to a multiple of 8 bytes and append the guard word, returns the number of bytes written
+		uint64_t finish() {
+			if (fill > 0) emit(acc);
+			emit(0);
+			flush();
+			acc = 0;
+			fill = 0;
+			return 8 * words;
+		}
+	private:
+		void emit(uint64_t word) {
+			if (used == sizeof(buffer)) flush();
+			store_le(buffer + used, word, 8);
+			used += 8;
+			++words;
+		}
+		void flush() {
+			ostr.write(reinterpret_cast<const char*>(buffer), std::streamsize(used));
+			used = 0;
+		}
+		std::ostream& ostr;
+		uint64_t acc;       // pending bits
+		unsigned fill;      // number of pending bits
+		size_t   used;      // bytes in the buffer
+		uint64_t words;     // words emitted
+		uint8_t  buffer[8 * 1024];
+	};
+
+	// unpack bit fields from a little-endian bitstream of payloadSize bytes on an input stream
+	class bitstream_reader {
+	public:
+		bitstream_reader(std::istream& istr, uint64_t payloadSize) : istr(istr), remaining{ payloadSize }, pos{ 0 }, end{ 0 }, acc{ 0 }, avail{ 0 } {}
+		// fetch the next n bits, 0 < n <= 64
+		uint64_t get(unsigned n) {
+			uint64_t bits;
+			if (avail >= n) {
+				bits = acc & limb_mask(n);
+				acc = (n == 64 ? 0 : acc >> n);
+				avail -= n;
+			}
+			else {
+				uint64_t word = next_word();
+				bits = (acc | (word << avail)) & limb_mask(n);
+				unsigned consumed = n - avail;
+				acc = (consumed == 64 ? 0 : word >> consumed);
+				avail = 64 - consumed;
+			}
+			return bits;
+		}
+		// consume the rest of the payload
+		void finish() {
+			if (remaining > 0) istr.ignore(std::streamsize(remaining));
+			if (!istr) throw datafile_error("truncated payload");
+			remaining = 0;
+		}
+	private:
+		uint64_t next_word() {
+			if (end - pos < 8) {
+				size_t left = end - pos;
+				for (size_t i = 0; i < left; ++i) buffer[i] = buffer[pos + i];
+				size_t request = sizeof(buffer) - left;
+				if (request > remaining) request = size_t(remaining);
+				istr.read(reinterpret_cast<char*>(buffer + left), std::streamsize(request));
+				size_t received = size_t(istr.gcount());
+				remaining -= received;
+				pos = 0;
+				end = left + received;
+				if (end < 8) throw datafile_error("truncated payload");
+			}
+			uint64_t word = load_le(buffer + pos, 8);
+			pos += 8;
+			return word;
+		}
+		std::istream& istr;
+		uint64_t remaining;  // payload bytes not yet read from the stream
+		size_t   pos, end;   // unconsumed bytes in the buffer
+		uint64_t acc;        // pending bits
+		unsigned avail;      // number of pending bits
+		uint8_t  buffer[8 * 1024];
+	};
+
+	inline void encode_datafile_header(uint8_t* bytes, const datafile_header& header) {
+		for (size_t i = 0; i < DATAFILE_HEADER_SIZE; ++i) bytes[i] = 0;
+		for (size_t i = 0; i < 8; ++i) bytes[i] = uint8_t(DATAFILE_MAGIC[i]);
+		store_le(bytes + 8, DATAFILE_VERSION, 2);
+		bytes[10] = uint8_t(header.system);
+		bytes[11] = header.flags;
+		store_le(bytes + 12, header.nbits, 4);
+		store_le(bytes + 16, header.param, 4);
+		store_le(bytes + 20, header.rank, 4);
+		store_le(bytes + 24, header.rows, 8);
+		store_le(bytes + 32, header.cols, 8);
+		store_le(bytes + 40, header.payloadOffset, 8);
+		store_le(bytes + 48, header.payloadSize, 8);
+	}
+
+	inline datafile_header decode_datafile_header(const uint8_t* bytes) {
+		for (size_t i = 0; i < 8; ++i) {
+			if (bytes[i] != uint8_t(DATAFILE_MAGIC[i])) throw datafile_error("not a universal data file");
+		}
+		if (load_le(bytes + 8, 2) != DATAFILE_VERSION) throw datafile_error("unsupported format version " + std::to_string(load_le(bytes + 8, 2)));
+		datafile_header header;
+		header.system = number_system(bytes[10]);
+		header.flags = bytes[11];
+		header.nbits = uint32_t(load_le(bytes + 12, 4));
+		header.param = uint32_t(load_le(bytes + 16, 4));
+		header.rank = uint32_t(load_le(bytes + 20, 4));
+		header.rows = load_le(bytes + 24, 8);
+		header.cols = load_le(bytes + 32, 8);
+		header.payloadOffset = load_le(bytes + 40, 8);
+		header.payloadSize = load_le(bytes + 48, 8);
+		if (header.rank < 1 || header.rank > 2 || (header.rank == 1 && header.cols != 1)) throw datafile_error("malformed shape");
+		if (header.payloadOffset < DATAFILE_HEADER_SIZE || header.payloadOffset % 64 != 0) throw datafile_error("malformed payload offset");
+		if (header.nbits == 0 || (header.cols != 0 && header.rows > UINT64_MAX / header.cols)) throw datafile_error("malformed header");
+		uint64_t nrElements = header.rows * header.cols;
+		if (nrElements > (UINT64_MAX - 127) / header.nbits || header.payloadSize < 8 * ((nrElements * header.nbits + 63) / 64 + 1)) throw datafile_error("payload too small for its shape");
+		return header;
+	}
+
+} // namespace internal
+
+template<size_t _nbits, size_t es>
+struct binary_encoding< posit<_nbits, es> > {
+	static constexpr number_system system = number_system::posit;
+	static constexpr size_t  nbits = _nbits;
+	static constexpr size_t  param = es;
+	static constexpr uint8_t flags = 0;
+	static void store(const posit<nbits, es>& p, uint64_t* limbs) {
+		if constexpr (nbits <= 64) {
+			limbs[0] = uint64_t(p.encoding()) & internal::limb_mask(nbits);
+		}
+		else {
+			internal::bitblock_to_limbs(p.get(), limbs);
+		}
+	}
+	static void load(posit<nbits, es>& p, const uint64_t* limbs) {
+		if constexpr (nbits <= 64) {
+			p.set_raw_bits(limbs[0]);
+		}
+		else {
+			bitblock<nbits> raw;
+			internal::limbs_to_bitblock(raw, limbs);
+			p.set(raw);
+		}
+	}
+};
+
+template<size_t _nbits, size_t rbits, bool arithmetic, typename bt>
+struct binary_encoding< fixpnt<_nbits, rbits, arithmetic, bt> > {
+	using Scalar = fixpnt<_nbits, rbits, arithmetic, bt>;
+	static constexpr number_system system = number_system::fixpnt;
+	static constexpr size_t  nbits = _nbits;
+	static constexpr size_t  param = rbits;
+	static constexpr uint8_t flags = (arithmetic ? 0 : DATAFILE_SATURATING);
+	static void store(const Scalar& a, uint64_t* limbs) {
+		constexpr size_t bitsInBlock = Scalar::bitsInBlock;
+		for (size_t i = 0; i < (nbits + 63) / 64; ++i) limbs[i] = 0;
+		auto bb = a.getbb();
+		for (size_t i = 0; i < Scalar::nrBlocks; ++i) {
+			limbs[(i * bitsInBlock) / 64] |= uint64_t(bb.block(i)) << ((i * bitsInBlock) % 64);
+		}
+		limbs[(nbits - 1) / 64] &= internal::limb_mask(nbits - 64 * ((nbits - 1) / 64));
+	}
+	static void load(Scalar& a, const uint64_t* limbs) {
+		if constexpr (nbits <= 64) {
+			a.set_raw_bits(limbs[0]);
+		}
+		else {
+			for (size_t i = 0; i < nbits; ++i) a.set(i, bool((limbs[i / 64] >> (i % 64)) & 1));
+		}
+	}
+};
+
+template<size_t _nbits, typename BlockType>
+struct binary_encoding< integer<_nbits, BlockType> > {
+	using Scalar = integer<_nbits, BlockType>;
+	static constexpr number_system system = number_system::integer;
+	static constexpr size_t  nbits = _nbits;
+	static constexpr size_t  param = 0;
+	static constexpr uint8_t flags = 0;
+	static void store(const Scalar& a, uint64_t* limbs) {
+		for (size_t i = 0; i < (nbits + 63) / 64; ++i) limbs[i] = 0;
+		for (unsigned i = 0; i < Scalar::nrBytes; ++i) limbs[i / 8] |= uint64_t(a.byte(i)) << (8 * (i % 8));
+	}
+	static void load(Scalar& a, const uint64_t* limbs) {
+		for (unsigned i = 0; i < Scalar::nrBytes; ++i) a.setbyte(i, uint8_t(limbs[i / 8] >> (8 * (i % 8))));
+	}
+};
+
+// true when the in-memory representation of Scalar is its little-endian encoding,
+// so that a payload can be used in place as an array of Scalar
+template<typename Scalar>
+bool has_native_layout() {
+	return std::is_trivially_copyable<Scalar>::value && sizeof(Scalar) * 8 == binary_encoding<Scalar>::nbits && internal::little_endian_host();
+}
+
+// the header of a data file of rows x cols elements of type Scalar
+template<typename Scalar>
+datafile_header make_datafile_header(uint32_t rank, uint64_t rows, uint64_t cols) {
+	using Encoding = binary_encoding<Scalar>;
+	datafile_header header;
+	header.system = Encoding::system;
+	header.flags = Encoding::flags;
+	header.nbits = uint32_t(Encoding::nbits);
+	header.param = uint32_t(Encoding::param);
+	header.rank = rank;
+	header.rows = rows;
+	header.cols = cols;
+	header.payloadOffset = DATAFILE_HEADER_SIZE;
+	header.payloadSize = 8 * ((rows * cols * Encoding::nbits + 63) / 64 + 1);
+	return header;
+}
+
+// verify that a data file holds elements of type Scalar; the saturation flag of a fixpnt is not checked
+template<typename Scalar>
+void check_datafile_type(const datafile_header& header) {
+	using Encoding = binary_encoding<Scalar>;
+	if (header.system != Encoding::system || header.nbits != Encoding::nbits || header.param != Encoding::param) {
+		throw datafile_error("element type mismatch: file holds number system " + std::to_string(unsigned(header.system)) + " with nbits " + std::to_string(header.nbits) + " and parameter " + std::to_string(header.param));
+	}
+}
+
+namespace internal {
+
+	template<typename Scalar>
+	void write_element(bitstream_writer& writer, const Scalar& v) {
+		using Encoding = binary_encoding<Scalar>;
+		constexpr size_t nrLimbs = (Encoding::nbits + 63) / 64;
+		uint64_t limbs[nrLimbs];
+		Encoding::store(v, limbs);
+		for (size_t l = 0; l < nrLimbs; ++l) {
+			const unsigned n = unsigned(Encoding::nbits - 64 * l < 64 ? Encoding::nbits - 64 * l : 64);
+			writer.put(limbs[l] & limb_mask(n), n);
+		}
+	}
+
+	template<typename Scalar>
+	void read_element(bitstream_reader& reader, Scalar& v) {
+		using Encoding = binary_encoding<Scalar>;
+		constexpr size_t nrLimbs = (Encoding::nbits + 63) / 64;
+		uint64_t limbs[nrLimbs];
+		for (size_t l = 0; l < nrLimbs; ++l) {
+			limbs[l] = reader.get(unsigned(Encoding::nbits - 64 * l < 64 ? Encoding::nbits - 64 * l : 64));
+		}
+		Encoding::load(v, limbs);
+	}
+
+	template<typename Scalar, typename Element>
+	void write_datafile(std::ostream& ostr, uint32_t rank, uint64_t rows, uint64_t cols, Element&& element) {
+		datafile_header header = make_datafile_header<Scalar>(rank, rows, cols);
+		uint8_t bytes[DATAFILE_HEADER_SIZE];
+		encode_datafile_header(bytes, header);
+		ostr.write(reinterpret_cast<const char*>(bytes), DATAFILE_HEADER_SIZE);
+		bitstream_writer writer(ostr);
+		for (uint64_t i = 0; i < rows; ++i) {
+			for (uint64_t j = 0; j < cols; ++j) write_element(writer, element(i, j));
+		}
+		writer.finish();
+		if (!ostr) throw datafile_error("write failed");
+	}
+
+	inline datafile_header read_datafile_header(std::istream& istr) {
+		uint8_t bytes[DATAFILE_HEADER_SIZE];
+		istr.read(reinterpret_cast<char*>(bytes), DATAFILE_HEADER_SIZE);
+		if (istr.gcount() != std::streamsize(DATAFILE_HEADER_SIZE)) throw datafile_error("truncated header");
+		datafile_header header = decode_datafile_header(bytes);
+		if (header.payloadOffset > DATAFILE_HEADER_SIZE) istr.ignore(std::streamsize(header.payloadOffset - DATAFILE_HEADER_SIZE));
+		return header;
+	}
+
+} // namespace internal
+
+// write a vector as a data file
+template<typename Scalar>
+void write_binary(std::ostream& ostr, const vector<Scalar>& v) {
+	internal::write_datafile<Scalar>(ostr, 1, v.size(), 1, [&v](uint64_t i, uint64_t) { return v[size_t(i)]; });
+}
+
+// write a matrix as a data file
+template<typename Scalar>
+void write_binary(std::ostream& ostr, const matrix<Scalar>& A) {
+	internal::write_datafile<Scalar>(ostr, 2, A.rows(), A.cols(), [&A](uint64_t i, uint64_t j) { return A(size_t(i), size_t(j)); });
+}
+
+// read a data file holding a vector of Scalar
+template<typename Scalar>
+void read_binary(std::istream& istr, vector<Scalar>& v) {
+	datafile_header header = internal::read_datafile_header(istr);
+	check_datafile_type<Scalar>(header);
+	if (header.rank != 1) throw datafile_error("data file holds a matrix, not a vector");
+	internal::bitstream_reader reader(istr, header.payloadSize);
+	v.resize(size_t(header.rows));
+	for (size_t i = 0; i < v.size(); ++i) internal::read_element(reader, v[i]);
+	reader.finish();
+}
+
+// read a data file holding a matrix of Scalar
+template<typename Scalar>
+void read_binary(std::istream& istr, matrix<Scalar>& A) {
+	datafile_header header = internal::read_datafile_header(istr);
+	check_datafile_type<Scalar>(header);
+	if (header.rank != 2) throw datafile_error("data file holds a vector, not a matrix");
+	internal::bitstream_reader reader(istr, header.payloadSize);
+	A.resize(size_t(header.rows), size_t(header.cols));
+	for (size_t i = 0; i < A.rows(); ++i) {
+		for (size_t j = 0; j < A.cols(); ++j) internal::read_element(reader, A(i, j));
+	}
+	reader.finish();
+}
+
+}}}  // namespace sw::unum::blas
@@ -0,0 +1,189 @@
+#pragma once
+// mapped_dataset.hpp: memory-mapped access to the vectors and matrices of a data file
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UNIVERSAL_MMAP_POSIX 1
+#endif
+#include <universal/blas/views.hpp>
+#include <universal/blas/serialization/datafile.hpp>
+
+namespace sw { namespace unum { namespace blas {
+
+// read-only mapping of a file into memory
+// on platforms without a mapping API the file is read into an owned buffer
+class mapped_file {
+public:
+	mapped_file() : _data{ nullptr }, _size{ 0 } {}
+	explicit mapped_file(const std::string& filename) : _data{ nullptr }, _size{ 0 } { open(filename); }
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+	mapped_file(mapped_file&& rhs) noexcept : _data{ nullptr }, _size{ 0 } { swap(rhs); }
+	mapped_file& operator=(mapped_file&& rhs) noexcept { close(); swap(rhs); return *this; }
+	~mapped_file() { close(); }
+
+	void open(const std::string& filename) {
+		close();
+#if defined(_WIN32)
+		_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (_file == INVALID_HANDLE_VALUE) throw datafile_error("unable to open " + filename);
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0) { close(); throw datafile_error("unable to map " + filename); }
+		_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (_mapping == nullptr) { close(); throw datafile_error("unable to map " + filename); }
+		void* view = MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr) { close(); throw datafile_error("unable to map " + filename); }
+		_data = static_cast<const uint8_t*>(view);
+		_size = size_t(size.QuadPart);
+#elif defined(UNIVERSAL_MMAP_POSIX)
+		int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd < 0) throw datafile_error("unable to open " + filename);
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); throw datafile_error("unable to map " + filename); }
+		void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (view == MAP_FAILED) throw datafile_error("unable to map " + filename);
+		_data = static_cast<const uint8_t*>(view);
+		_size = size_t(st.st_size);
+#else
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
+		if (!file) throw datafile_error("unable to open " + filename);
+		_buffer.resize(size_t(file.tellg()));
+		file.seekg(0);
+		file.read(reinterpret_cast<char*>(_buffer.data()), std::streamsize(_buffer.size()));
+		if (!file) throw datafile_error("unable to read " + filename);
+		_data = _buffer.data();
+		_size = _buffer.size();
+#endif
+	}
+
+	void close() {
+#if defined(_WIN32)
+		if (_data != nullptr) UnmapViewOfFile(_data);
+		if (_mapping != nullptr) CloseHandle(_mapping);
+		if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+		_mapping = nullptr;
+		_file = INVALID_HANDLE_VALUE;
+#elif defined(UNIVERSAL_MMAP_POSIX)
+		if (_data != nullptr) munmap(const_cast<uint8_t*>(_data), _size);
+#else
+		_buffer.clear();
+#endif
+		_data = nullptr;
+		_size = 0;
+	}
+
+	// selectors
+	const uint8_t* data() const { return _data; }
+	size_t size() const { return _size; }
+
+private:
+	void swap(mapped_file& rhs) noexcept {
+		std::swap(_data, rhs._data);
+		std::swap(_size, rhs._size);
+#if defined(_WIN32)
+		std::swap(_file, rhs._file);
+		std::swap(_mapping, rhs._mapping);
+#elif !defined(UNIVERSAL_MMAP_POSIX)
+		std::swap(_buffer, rhs._buffer);
+#endif
+	}
+
+	const uint8_t* _data;
+	size_t         _size;
+#if defined(_WIN32)
+	HANDLE _file = INVALID_HANDLE_VALUE;
+	HANDLE _mapping = nullptr;
+#elif !defined(UNIVERSAL_MMAP_POSIX)
+	std::vector<uint8_t> _buffer;
+#endif
+};
+
+// A data file of elements of type Scalar, mapped into memory.
+// When the payload can be used in place, see zero_copy(), as_vector() and as_matrix() present it
+// as views without copying or decoding, so loading runs at the speed of the page cache or the disk.
+// Otherwise, which is the case for widths that are not a multiple of 8 bits, such as posit<10,1>,
+// and for types whose representation is padded, the elements are decoded from the payload on access.
+template<typename Scalar>
+class mapped_dataset {
+public:
+	typedef Scalar value_type;
+
+	explicit mapped_dataset(const std::string& filename) : _file(filename) {
+		if (_file.size() < DATAFILE_HEADER_SIZE) throw datafile_error(filename + " is too small to be a data file");
+		_header = internal::decode_datafile_header(_file.data());
+		check_datafile_type<Scalar>(_header);
+		if (_header.payloadOffset > _file.size() || _header.payloadSize > _file.size() - _header.payloadOffset) throw datafile_error(filename + " is truncated");
+		_payload = _file.data() + _header.payloadOffset;
+	}
+
+	// selectors
+	uint32_t rank() const { return _header.rank; }
+	size_t rows() const { return size_t(_header.rows); }
+	size_t cols() const { return size_t(_header.cols); }
+	size_t size() const { return size_t(_header.rows * _header.cols); }
+	const datafile_header& header() const { return _header; }
+
+	// true when the payload can be presented as an array of Scalar
+	bool zero_copy() const {
+		return has_native_layout<Scalar>() && reinterpret_cast<uintptr_t>(_payload) % alignof(Scalar) == 0;
+	}
+
+	// zero-copy view of all elements in row-major order: requires zero_copy()
+	vector_view<Scalar> as_vector() const {
+		if (!zero_copy()) throw datafile_error("the payload cannot be viewed in place: use load or element access");
+		return vector_view<Scalar>(reinterpret_cast<const Scalar*>(_payload), size());
+	}
+	// zero-copy view of the elements as a matrix: requires zero_copy()
+	matrix_view<Scalar> as_matrix() const {
+		if (!zero_copy()) throw datafile_error("the payload cannot be viewed in place: use load or element access");
+		return matrix_view<Scalar>(reinterpret_cast<const Scalar*>(_payload), rows(), cols());
+	}
+
+	// decode element i in row-major order
+	Scalar operator[](size_t i) const {
+		using Encoding = binary_encoding<Scalar>;
+		uint64_t limbs[(Encoding::nbits + 63) / 64];
+		internal::extract_bits(_payload, uint64_t(i) * Encoding::nbits, Encoding::nbits, limbs);
+		Scalar v;
+		Encoding::load(v, limbs);
+		return v;
+	}
+	Scalar operator()(size_t i, size_t j) const { return (*this)[i * cols() + j]; }
+
+	// copy the elements into a vector or a matrix
+	void load(vector<Scalar>& v) const {
+		v.resize(size());
+		for (size_t i = 0; i < v.size(); ++i) v[i] = (*this)[i];
+	}
+	void load(matrix<Scalar>& A) const {
+		A.resize(rows(), cols());
+		for (size_t i = 0; i < rows(); ++i) {
+			for (size_t j = 0; j < cols(); ++j) A(i, j) = (*this)(i, j);
+		}
+	}
+
+private:
+	mapped_file     _file;
+	datafile_header _header;
+	const uint8_t*  _payload;
+};
+
+}}}  // namespace sw::unum::blas
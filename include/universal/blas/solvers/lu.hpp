@@ -7,6 +7,7 @@
 #include <iostream>
 #include <universal/posit/posit_fwd.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/blas/blas_l3.hpp>
 
 // compilation flags
 // BLAS_TRACE_ROUNDING_EVENTS
@@ -348,6 +349,141 @@ int ludcmp(matrix< posit<nbits, es> >& A, vector<size_t>& indx) {
 	return 0; // success
 }
 
+/// //////////////////////////////////////////////////////////////////
+/// blocked LU decomposition with fused dot products
+///
+/// ludcmp_blocked computes the same factorization as the posit ludcmp, bit for bit,
+/// including the pivot sequence, but processes the matrix in panels of LU_PANEL_WIDTH columns.
+/// Every element of L and U is a single fused dot product A(i,j) - sum_k L(i,k) * U(k,j)
+/// with one rounding step. A right-looking update would round the trailing matrix once per
+/// panel, so the updates are instead deferred into one quire per element of the panel.
+/// For the panel starting at column j0:
+///   1. the quires of the panel rows i >= j0 are loaded with A(i,j) and accumulate the
+///      products with the finished part of L and U, k < j0, in parallel across row blocks
+///   2. the panel is factored column by column, finishing the quires with the products
+///      inside the panel, k >= j0, and selecting the pivot rows
+///   3. the rows of U to the right of the panel are computed in parallel across columns
+/// Steps 1 and 3 stream through decoded operands with the fmm kernels of blas_l3.hpp.
+
+constexpr size_t LU_PANEL_WIDTH = 64;   // columns of a panel, and rows of a U block row
+
+template<size_t nbits, size_t es, size_t capacity = 10>
+int ludcmp_blocked(matrix< posit<nbits, es> >& A, vector<size_t>& indx, unsigned nrThreads = 0) {
+	using Scalar = posit<nbits, es>;
+	using Quire = quire<nbits, es, capacity>;
+	constexpr size_t fbits  = nbits - 3 - es;
+	constexpr size_t mbits  = 2 * (fbits + 1);
+	const size_t N = num_rows(A);
+	if (N != num_cols(A)) {
+		std::cerr << "matrix argument to ludcmp is not square: (" << num_rows(A) << " x " << num_cols(A) << ")\n";
+		return 1;
+	}
+	indx.resize(N);
+	indx = 0;
+	// implicit pivoting pre-calculation
+	vector<Scalar> implicitScale(N);
+	for (size_t i = 0; i < N; ++i) { // for each row
+		Scalar pivot = 0;
+		for (size_t j = 0; j < N; ++j) { // scan the columns for the biggest abs value
+			Scalar e = fabs(A(i, j));
+			if (e > pivot) pivot = e;
+		}
+		if (pivot == 0) {
+			std::cerr << "LU argument matrix is singular\n";
+			return 2;
+		}
+		implicitScale[i] = Scalar(1.0) / pivot; // save the scaling factor for that row
+	}
+
+	// the factorization subtracts the products from the quires: L is decoded with the sign flipped
+	auto decode_negated = [](const Scalar& p) { return -fmm_decode(p); };
+
+	std::vector<Quire> panel(N * LU_PANEL_WIDTH);  // quires of the panel: row i - j0, column j - j0
+	for (size_t j0 = 0; j0 < N; j0 += LU_PANEL_WIDTH) {
+		const size_t j1 = (j0 + LU_PANEL_WIDTH < N ? j0 + LU_PANEL_WIDTH : N);
+		const size_t nb = j1 - j0;
+
+		// step 1: load the panel quires and accumulate the products with k < j0
+		{
+			// decode the finished rows of U in the panel, transposed: column j is contiguous along k
+			std::vector< value<fbits> > Upanel(nb * j0);
+			for (size_t k = 0; k < j0; ++k) {
+				for (size_t j = 0; j < nb; ++j) Upanel[j * j0 + k] = fmm_decode(A(k, j0 + j));
+			}
+			const size_t rows = N - j0;
+			const size_t nrRowBlocks = (rows + FMM_TILE_ROWS - 1) / FMM_TILE_ROWS;
+			parallel_for(nrRowBlocks, nrThreads, [&](size_t rb) {
+				const size_t i0 = j0 + rb * FMM_TILE_ROWS;
+				const size_t i1 = (i0 + FMM_TILE_ROWS < N ? i0 + FMM_TILE_ROWS : N);
+				std::vector< value<fbits> > Lrow(j0);
+				value<mbits> product;
+				for (size_t i = i0; i < i1; ++i) {
+					for (size_t k = 0; k < j0; ++k) Lrow[k] = decode_negated(A(i, k));
+					for (size_t j = 0; j < nb; ++j) {
+						Quire& q = panel[(i - j0) * LU_PANEL_WIDTH + j];
+						q = A(i, j0 + j);
+						fmm_accumulate(q, Lrow.data(), &Upanel[j * j0], j0, product);
+					}
+				}
+			});
+		}
+
+		// step 2: factor the panel, identical to the column loop of ludcmp
+		for (size_t j = j0; j < j1; ++j) {
+			for (size_t i = j0; i < j; ++i) {
+				Quire& q = panel[(i - j0) * LU_PANEL_WIDTH + (j - j0)];
+				for (size_t k = j0; k < i; ++k) q -= quire_mul(A(i, k), A(k, j));
+				convert(q.to_value(), A(i, j));     // one and only rounding step of the fused-dot product
+			}
+			Scalar pivot = 0; // initialize for search for largest pivot element
+			size_t imax = j;
+			for (size_t i = j; i < N; ++i) {
+				Quire& q = panel[(i - j0) * LU_PANEL_WIDTH + (j - j0)];
+				for (size_t k = j0; k < j; ++k) q -= quire_mul(A(i, k), A(k, j));
+				Scalar sum;
+				convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
+				A(i, j) = sum;
+				Scalar dum = implicitScale[i] * fabs(sum);
+				if (dum >= pivot) { // is figure of merit better than the best so far?
+					pivot = dum;
+					imax = i;
+				}
+			}
+			if (j != imax) {
+				for (size_t k = 0; k < N; ++k) std::swap(A(imax, k), A(j, k));
+				for (size_t k = j - j0 + 1; k < nb; ++k) std::swap(panel[(imax - j0) * LU_PANEL_WIDTH + k], panel[(j - j0) * LU_PANEL_WIDTH + k]);
+				implicitScale[imax] = implicitScale[j]; // interchange scaling factor
+			}
+			indx[j] = imax;
+			if (A(j, j) == 0) A(j, j) = std::numeric_limits<Scalar>::epsilon();
+			Scalar dum = Scalar(1) / A(j, j);
+			for (size_t i = j + 1; i < N; ++i) A(i, j) *= dum;
+		}
+
+		// step 3: the block row of U to the right of the panel, one column per task
+		if (j1 < N) {
+			// decode the rows of L in the block row: row i is contiguous along k < i
+			std::vector< value<fbits> > Lblock(nb * j1);
+			for (size_t i = j0; i < j1; ++i) {
+				for (size_t k = 0; k < i; ++k) Lblock[(i - j0) * j1 + k] = decode_negated(A(i, k));
+			}
+			parallel_for(N - j1, nrThreads, [&](size_t c) {
+				const size_t j = j1 + c;
+				std::vector< value<fbits> > Ucolumn(j1);
+				for (size_t k = 0; k < j0; ++k) Ucolumn[k] = fmm_decode(A(k, j));
+				value<mbits> product;
+				for (size_t i = j0; i < j1; ++i) {
+					Quire q(A(i, j));
+					fmm_accumulate(q, &Lblock[(i - j0) * j1], Ucolumn.data(), i, product);
+					convert(q.to_value(), A(i, j));     // one and only rounding step of the fused-dot product
+					Ucolumn[i] = fmm_decode(A(i, j));
+				}
+			});
+		}
+	}
+	return 0; // success
+}
+
 // LU decomposition using partial pivoting with implicit pivoting applied
 template<typename Scalar>
 matrix<Scalar> lu(const matrix<Scalar>& A) {
@@ -458,11 +594,11 @@ vector<Scalar> solve(const matrix<Scalar>& _A, const vector<Scalar>& _b) {
 	const size_t N = num_rows(_A);
 	if (N != num_cols(_A)) {
 		std::cerr << "matrix is not square: (" << num_rows(_A) << " x " << num_cols(_A) << ")\n";
-		return 1;
+		return vector<Scalar>{};
 	}
 	if (N != size(_b)) {
 		std::cerr << "matrix shape (" << num_rows(_A) << " x " << num_cols(_A) << ") is not congruous with vector size (" << size(_b) << ")\n";
-		return 1;
+		return vector<Scalar>{};
 	}
 	matrix<Scalar> A(_A);
 	// implicit pivoting pre-calculation
@@ -476,7 +612,7 @@ vector<Scalar> solve(const matrix<Scalar>& _A, const vector<Scalar>& _b) {
 		}
 		if (pivot == 0) {
 			std::cerr << "LU argument matrix is singular\n";
-			return 2;
+			return vector<Scalar>{};
 		}
 		implicitScale[i] = Scalar(1.0) / pivot; // save the scaling factor for that row
 	}
@@ -548,76 +684,20 @@ vector<Scalar> solve(const matrix<Scalar>& _A, const vector<Scalar>& _b) {
 template<size_t nbits, size_t es, size_t capacity = 10>
 vector<sw::unum::posit<nbits, es> > solve(const matrix<sw::unum::posit<nbits, es> >& _A, const vector<sw::unum::posit<nbits, es>>& _b) {
 	using namespace std;
+	using Scalar = sw::unum::posit<nbits, es>;
 	const size_t N = num_rows(_A);
 	if (N != num_cols(_A)) {
 		cerr << "matrix is not square: (" << num_rows(_A) << " x " << num_cols(_A) << ")\n";
-		return 1;
+		return vector<Scalar>{};
 	}
 	if (N != size(_b)) {
 		cerr << "matrix shape (" << num_rows(_A) << " x " << num_cols(_A) << ") is not congruous with vector size (" << size(_b) << ")\n";
-		return 1;
+		return vector<Scalar>{};
 	}
-	using Scalar = sw::unum::posit<nbits, es>;
 	cerr << typeid(Scalar).name() << " specialization of LU decomposition solver with fused-dot-product operators" << endl;
 	matrix<Scalar> A(_A);
-	// implicit pivoting pre-calculation
-	vector<Scalar> implicitScale(N);
 	vector<size_t> indx(N);
-	for (size_t i = 0; i < N; ++i) { // for each row
-		Scalar pivot = 0;
-		for (size_t j = 0; j < N; ++j) { // scan the columns for the biggest abs value
-			Scalar e = fabs(A(i, j));
-			if (e > pivot) pivot = e;
-		}
-		if (pivot == 0) {
-			std::cerr << "LU argument matrix is singular\n";
-			return 2;
-		}
-		implicitScale[i] = Scalar(1.0) / pivot; // save the scaling factor for that row
-	}
-	int nrOfRowExchanges = 0;
-	size_t imax = 0;
-	for (size_t j = 0; j < N; ++j) { // loop over columns of Crout's method
-		Scalar sum = 0;
-		for (size_t i = 0; i < j; ++i) {
-			quire<nbits, es, capacity> q(A(i, j));
-			for (size_t k = 0; k < i; ++k) q -= quire_mul(A(i, k), A(k, j));
-			posit<nbits, es> sum;
-			convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
-			A(i, j) = sum;
-		}
-		Scalar pivot = 0; // initialize for search for largest pivot element
-		for (size_t i = j; i < N; ++i) {
-			quire<nbits, es, capacity> q(A(i, j));
-			for (size_t k = 0; k < j; ++k) q -= quire_mul(A(i, k), A(k, j));
-			posit<nbits, es> sum;
-			convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
-			A(i, j) = sum;
-			Scalar dum = implicitScale[i] * fabs(sum);
-			if (dum >= pivot) { // is figure of merit better than the best so far?
-				pivot = dum;
-				imax = i;
-			}
-		}
-		if (j != imax) {
-			for (size_t k = 0; k < N; ++k) std::swap(A(imax, k), A(j, k));
-			++nrOfRowExchanges;
-			implicitScale[imax] = implicitScale[j]; // interchange scaling factor
-		}
-		//		cout << "indx: " << indx << endl;
-		indx[j] = imax;
-		//		cout << "      " << indx << endl;
-		if (A(j, j) == 0) {
-			std::cerr << "injecting tiny value to replace 0" << std::endl;
-			A(j, j) = std::numeric_limits<Scalar>::epsilon();
-		}
-		if (j != N) {
-			Scalar dum = Scalar(1) / A(j, j);
-			for (size_t i = j + 1; i < N; ++i) A(i, j) *= dum;
-		}
-	}
-	//	cout << "index array\n" << indx << endl;
-	//	cout << "A\n" << A << endl;
+	if (ludcmp_blocked<nbits, es, capacity>(A, indx) != 0) return vector<Scalar>{};  // singular: ludcmp_blocked reported it
 
 	vector<Scalar> x(_b);
 	Scalar sum = 0;
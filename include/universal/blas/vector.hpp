@@ -9,6 +9,7 @@
 #include <vector>
 #include <initializer_list>
 #include <cmath>  // for std::sqrt
+#include <universal/blas/expressions.hpp>
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -75,6 +76,24 @@ public:
 	vector& operator=(const vector& v) = default;
 	vector& operator=(vector&& v) = default;
 
+	// evaluate a vector expression
+	template<typename Expression, typename = std::enable_if_t<std::is_base_of<internal::vector_expression_tag, Expression>::value>>
+	vector(const Expression& e) : data(e.size()) {
+		for (size_t i = 0; i < data.size(); ++i) data[i] = internal::element(e, i);
+	}
+	template<typename Expression, typename = std::enable_if_t<std::is_base_of<internal::vector_expression_tag, Expression>::value>>
+	vector& operator=(const Expression& e) {
+		if (internal::hazard(e, this)) {
+			// the expression reads elements of this vector that the loop would already have overwritten
+			vector tmp(e);
+			data.swap(tmp.data);
+			return *this;
+		}
+		data.resize(e.size());
+		for (size_t i = 0; i < data.size(); ++i) data[i] = internal::element(e, i);
+		return *this;
+	}
+
 // operators
 	vector& operator=(const Scalar& val) {
 		for (auto& v : data) v = val;
@@ -129,6 +148,15 @@ public:
 		}
 		return *this;
 	}
+	// element-wise add and subtract of an expression, evaluated in the same loop
+	template<typename Expression, typename = std::enable_if_t<std::is_base_of<internal::vector_expression_tag, Expression>::value>>
+	vector& operator+=(const Expression& e) {
+		return *this = *this + e;
+	}
+	template<typename Expression, typename = std::enable_if_t<std::is_base_of<internal::vector_expression_tag, Expression>::value>>
+	vector& operator-=(const Expression& e) {
+		return *this = *this - e;
+	}
 	// element-wise multiply
 	vector& operator*=(const vector<Scalar>& scaler) {
 		for (size_t i = 0; i < size(); ++i) {
@@ -0,0 +1,100 @@
+#pragma once
+// views.hpp: non-owning, read-only views of vectors and matrices held in external storage
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <utility>
+#include <universal/blas/expressions.hpp>
+
+namespace sw { namespace unum { namespace blas {
+
+// A view presents an array of elements owned by someone else, for example a memory-mapped
+// data file, with the selectors of vector and matrix, so that the generic BLAS functions,
+// which only need value_type, size(), and operator[], can operate on it without a copy.
+// The owner of the storage must outlive the view.
+
+template<typename Scalar>
+class vector_view {
+public:
+	typedef Scalar            value_type;
+	typedef const value_type& const_reference;
+	typedef const value_type* const_pointer_type;
+	typedef const value_type* const_iterator;
+
+	vector_view() : _data{ nullptr }, _size{ 0 } {}
+	vector_view(const Scalar* data, size_t size) : _data{ data }, _size{ size } {}
+
+	const_reference operator[](size_t index) const { return _data[index]; }
+	const_reference operator()(size_t index) const { return _data[index]; }
+
+// selectors
+	size_t size() const { return _size; }
+	const_pointer_type data() const { return _data; }
+
+// iterators
+	const_iterator begin() const noexcept { return _data; }
+	const_iterator end() const noexcept { return _data + _size; }
+
+private:
+	const Scalar* _data;
+	size_t        _size;
+};
+
+template<typename Scalar> auto size(const vector_view<Scalar>& v) { return v.size(); }
+// views are operands of vector and matrix expressions
+template<typename Scalar> struct is_vector_operand< vector_view<Scalar> > : std::true_type {};
+
+template<typename Scalar>
+std::ostream& operator<<(std::ostream& ostr, const vector_view<Scalar>& v) {
+	auto width = ostr.precision() + 2;
+	for (size_t j = 0; j < size(v); ++j) ostr << std::setw(width) << v[j] << " ";
+	return ostr;
+}
+
+// row-major matrix view
+template<typename Scalar>
+class matrix_view {
+public:
+	typedef Scalar            value_type;
+	typedef const value_type& const_reference;
+	typedef const value_type* const_pointer_type;
+
+	matrix_view() : _m{ 0 }, _n{ 0 }, _data{ nullptr } {}
+	matrix_view(const Scalar* data, size_t m, size_t n) : _m{ m }, _n{ n }, _data{ data } {}
+
+	const_reference operator()(size_t i, size_t j) const { return _data[i*_n + j]; }
+	// row i as a vector view
+	vector_view<Scalar> operator[](size_t i) const { return vector_view<Scalar>(_data + i*_n, _n); }
+
+// selectors
+	inline size_t rows() const { return _m; }
+	inline size_t cols() const { return _n; }
+	inline std::pair<size_t, size_t> size() const { return std::make_pair(_m, _n); }
+	const_pointer_type data() const { return _data; }
+
+private:
+	size_t        _m, _n; // m rows and n columns
+	const Scalar* _data;
+};
+
+template<typename Scalar> struct is_matrix_operand< matrix_view<Scalar> > : std::true_type {};
+template<typename Scalar>
+inline size_t num_rows(const matrix_view<Scalar>& A) { return A.rows(); }
+template<typename Scalar>
+inline size_t num_cols(const matrix_view<Scalar>& A) { return A.cols(); }
+
+template<typename Scalar>
+std::ostream& operator<<(std::ostream& ostr, const matrix_view<Scalar>& A) {
+	auto width = ostr.precision() + 2;
+	for (size_t i = 0; i < A.rows(); ++i) {
+		for (size_t j = 0; j < A.cols(); ++j) ostr << std::setw(width) << A(i, j) << " ";
+		ostr << '\n';
+	}
+	return ostr;
+}
+
+}}}  // namespace sw::unum::blas
@@ -7,6 +7,8 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <universal/native/limb_arithmetic.hpp>
 
 // compiler specific operators
 #if defined(__clang__)
@@ -83,6 +85,31 @@ blockbinary<nbits, bt> twosComplement(const blockbinary<nbits, bt>& orig) {
 	return twosC;
 }
 
+namespace internal {
+
+// pack the blocks of a blockbinary into an array of wider limbs, least significant limb first
+template<typename Limb, size_t nbits, typename bt>
+inline void pack_blocks(Limb* limbs, size_t nrLimbs, const blockbinary<nbits, bt>& a) {
+	constexpr size_t bitsInBlock = sizeof(bt) * 8;
+	constexpr size_t blocksInLimb = sizeof(Limb) / sizeof(bt);
+	for (size_t i = 0; i < nrLimbs; ++i) limbs[i] = 0;
+	for (size_t i = 0; i < blockbinary<nbits, bt>::nrBlocks && i / blocksInLimb < nrLimbs; ++i) {
+		limbs[i / blocksInLimb] |= Limb(a.block(i)) << ((i % blocksInLimb) * bitsInBlock);
+	}
+}
+
+// unpack an array of limbs into the blocks of a blockbinary, the bits beyond nbits are dropped
+template<typename Limb, size_t nbits, typename bt>
+inline void unpack_blocks(blockbinary<nbits, bt>& a, const Limb* limbs, size_t nrLimbs) {
+	constexpr size_t bitsInBlock = sizeof(bt) * 8;
+	constexpr size_t blocksInLimb = sizeof(Limb) / sizeof(bt);
+	for (size_t i = 0; i < blockbinary<nbits, bt>::nrBlocks; ++i) {
+		a.setblock(i, (i / blocksInLimb < nrLimbs) ? bt(limbs[i / blocksInLimb] >> ((i % blocksInLimb) * bitsInBlock)) : bt(0));
+	}
+}
+
+} // namespace internal
+
 /*
 NOTES
 
@@ -203,17 +230,13 @@ public:
 		return operator+=(twosComplement(rhs));
 	}
 	blockbinary& operator*=(const blockbinary& rhs) { // modulo in-place
-		blockbinary base(*this);
-		blockbinary multiplicant(rhs);
-		clear();
-		for (size_t i = 0; i < nbits; ++i) {
-			if (base.at(i)) {
-				operator+=(multiplicant);
-			}
-			multiplicant <<= 1;
-		}
-		// since we used operator+=, which enforces the nulling of leading bits
-		// we don't need to null here
+		// pack the blocks into 64-bit limbs and use the truncated limb multiply
+		constexpr size_t nrLimbs = 1 + ((nbits - 1) / 64);
+		uint64_t a[nrLimbs], b[nrLimbs], r[nrLimbs];
+		internal::pack_blocks(a, nrLimbs, *this);
+		internal::pack_blocks(b, nrLimbs, rhs);
+		internal::limb_multiply_low(r, a, b, nrLimbs);
+		internal::unpack_blocks(*this, r, nrLimbs);
 		return *this;
 	}
 	blockbinary& operator/=(const blockbinary& rhs) {
@@ -411,6 +434,14 @@ public:
 		}
 		throw "block index out of bounds";
 	}
+	inline constexpr void setblock(size_t b, bt data) {
+		if (b < nrBlocks) {
+			_block[b] = data;
+			_block[MSU] &= MSU_MASK; // enforce precondition of properly nulled leading non-bits
+			return;
+		}
+		throw "block index out of bounds";
+	}
 
 	template<size_t nnbits>
 	inline blockbinary<nbits, bt>& assign(const blockbinary<nnbits, bt>& rhs) {
@@ -603,25 +634,15 @@ quorem<nbits, bt> longdivision(const blockbinary<nbits, bt>& _a, const blockbina
 		result.rem = _a; // a % b = a when a / b = 0
 		return result;   // a / b = 0 when b > a
 	}
-	// initialize the long division
-	blockbinary<nbits + 1, bt> accumulator = a;
-	// prepare the subtractand
-	blockbinary<nbits + 1, bt> subtractand = b;
-	int msb_b = b.msb();
-	int msb_a = a.msb();
-	int shift = msb_a - msb_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			accumulator -= subtractand;
-			result.quo.set(i);
-		}
-		else {
-			result.quo.reset(i);
-		}
-		subtractand >>= 1;
-	}
+	// Knuth Algorithm D on 32-bit digits
+	constexpr size_t nrDigits = 1 + (nbits / 32); // digits to hold nbits + 1 bits
+	uint32_t u[nrDigits], v[nrDigits], q[nrDigits], r[nrDigits];
+	internal::pack_blocks(u, nrDigits, a);
+	internal::pack_blocks(v, nrDigits, b);
+	internal::limb_divide(q, r, u, nrDigits, v, nrDigits);
+	internal::unpack_blocks(result.quo, q, nrDigits);
+	blockbinary<nbits + 1, bt> accumulator;
+	internal::unpack_blocks(accumulator, r, nrDigits);
 	if (result_negative) {  // take 2's complement
 		result.quo.flip();
 		result.quo += 1;
@@ -665,24 +686,13 @@ inline blockbinary<2*nbits, bt> urmul(const blockbinary<nbits, bt>& a, const blo
 	blockbinary<2 * nbits, bt> multiplicant(b);
 #if TRACE_URMUL
 	std::cout << "    " << to_binary(a) << " * " << to_binary(b) << std::endl;
-	std::cout << std::setw(3) << 0 << ' ' << to_binary(multiplicant) << ' ' << to_binary(result) << std::endl;
 #endif
-	for (size_t i = 0; i < 2* nbits; ++i) {
-		if (signextended_a.at(i)) {
-			result += multiplicant;
-		}
-		multiplicant <<= 1;
-#if TRACE_URMUL
-		std::cout << std::setw(3) << i << ' ' << to_binary(multiplicant) << ' ' << to_binary(result) << std::endl;
-#endif
-
-	}
+	// the product of the sign-extended operands modulo 2^(2*nbits) is the 2's complement product
+	result = signextended_a;
+	result *= multiplicant;
 #if TRACE_URMUL
 	std::cout << "fnl " << to_binary(result) << std::endl;
 #endif
-	//blockbinary<2 * nbits, bt> clipped(result);
-	// since we used operator+=, which enforces the nulling of leading bits
-	// we don't need to null here
 	return result;
 }
 
@@ -294,46 +294,19 @@ public:
 			return *this;
 		}
 		bool signOfFinalResult = (negative != rhs.negative) ? true : false;
-		decimal product;
-		// find the smallest decimal to minimize the amount of work
+		// accumulate the rows of the schoolbook product in place, instead of a partial sum per row
 		size_t l = size();
 		size_t r = rhs.size();
-		decimal::const_iterator sit, bit; // sit = smallest iterator, bit = biggest iterator
-		if (l < r) {
-			int64_t position = 0;
-			for (sit = begin(); sit != end(); ++sit) {
-				decimal partial_sum; partial_sum.clear(); // TODO: this is silly, create and immediately destruct to make the insert work
-				partial_sum.insert(partial_sum.end(), r + position, 0);
-				decimal::iterator pit = partial_sum.begin() + position;
-				uint8_t carry = 0;
-				for (bit = rhs.begin(); bit != rhs.end() && pit != partial_sum.end(); ++bit, ++pit) {
-					uint8_t digit = static_cast<uint8_t>(*sit * *bit + carry);
-					*pit = static_cast<uint8_t>(digit % 10);
-					carry = static_cast<uint8_t>(digit / 10);
-				}
-				if (carry) partial_sum.push_back(carry);
-				product += partial_sum;
-				//				std::cout << "partial sum " << partial_sum << " intermediate product " << product << std::endl;
-				++position;
-			}
-		}
-		else {
-			int64_t position = 0;
-			for (sit = rhs.begin(); sit != rhs.end(); ++sit) {
-				decimal partial_sum; partial_sum.clear(); // TODO: this is silly, create and immediately destruct to make the insert work
-				partial_sum.insert(partial_sum.end(), l + position, 0);
-				decimal::iterator pit = partial_sum.begin() + position;
-				uint8_t carry = 0;
-				for (bit = begin(); bit != end() && pit != partial_sum.end(); ++bit, ++pit) {
-					uint8_t digit = static_cast<uint8_t>(*sit * *bit + carry);
-					*pit = static_cast<uint8_t>(digit % 10);
-					carry = static_cast<uint8_t>(digit / 10);
-				}
-				if (carry) partial_sum.push_back(carry);
-				product += partial_sum;
-				//				std::cout << "partial sum " << partial_sum << " intermediate product " << product << std::endl;
-				++position;
+		decimal product;
+		product.assign(l + r, 0);
+		for (size_t i = 0; i < l; ++i) {
+			unsigned carry = 0;
+			for (size_t j = 0; j < r; ++j) {
+				unsigned digit = product[i + j] + unsigned(operator[](i)) * rhs[j] + carry;
+				product[i + j] = static_cast<uint8_t>(digit % 10);
+				carry = digit / 10;
 			}
+			product[i + r] = static_cast<uint8_t>(carry);
 		}
 		product.unpad();
 		*this = product;
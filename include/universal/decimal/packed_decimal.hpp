@@ -0,0 +1,841 @@
+#pragma once
+// packed_decimal.hpp: definition of an arbitrary precision decimal integer with multi-digit limbs
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+#include <universal/native/limb_arithmetic.hpp>
+#include <universal/decimal/decimal.hpp>
+
+// products of operands with at least DECIMAL_KARATSUBA_THRESHOLD limbs use Karatsuba
+#if !defined(DECIMAL_KARATSUBA_THRESHOLD)
+#define DECIMAL_KARATSUBA_THRESHOLD 32
+#endif
+
+namespace sw { namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// packed decimal
+///
+/// A sign-magnitude decimal integer that packs 9 digits into each 32-bit limb, base 10^9,
+/// or 18 digits into each 64-bit limb, base 10^18, least significant limb first.
+/// Values of up to 72 digits live in an inline buffer, and do not touch the heap.
+/// Multiplication is in place: schoolbook for short operands, Karatsuba for long operands.
+/// Division is Knuth's Algorithm D on the base 10^9 or 10^18 limbs.
+
+namespace internal {
+
+// the arithmetic of a single base 10^9 or 10^18 limb
+template<typename Limb> struct decimal_limb;
+
+template<>
+struct decimal_limb<uint32_t> {
+	static constexpr uint32_t base = 1000000000u;
+	static constexpr unsigned digits = 9;
+
+	// a * b + c + carry: returns the lower limb, and the upper limb in carry
+	static inline uint32_t mul_add(uint32_t a, uint32_t b, uint32_t c, uint32_t& carry) {
+		uint64_t t = uint64_t(a) * b + c + carry;
+		carry = uint32_t(t / base);
+		return uint32_t(t - uint64_t(carry) * base);
+	}
+	// (hi * base + lo) / d for hi < d: returns the quotient, and the remainder in r
+	static inline uint32_t divrem(uint32_t hi, uint32_t lo, uint32_t d, uint32_t& r) {
+		uint64_t t = uint64_t(hi) * base + lo;
+		uint32_t q = uint32_t(t / d);
+		r = uint32_t(t - uint64_t(q) * d);
+		return q;
+	}
+	// q * v > r * base + u, for r < base
+	static inline bool exceeds(uint32_t q, uint32_t v, uint32_t r, uint32_t u) {
+		return uint64_t(q) * v > uint64_t(r) * base + u;
+	}
+};
+
+template<>
+struct decimal_limb<uint64_t> {
+	static constexpr uint64_t base = 1000000000000000000ull;
+	static constexpr unsigned digits = 18;
+
+	// (hi * 2^64 + lo) = q * base + r for a value below base^2: returns r, and q in carry
+	// Moller and Granlund's division by the normalized divisor base * 2^4, with its precomputed reciprocal
+	static inline uint64_t split(uint64_t hi, uint64_t lo, uint64_t& carry) {
+		constexpr uint64_t d = base << 4;
+		constexpr uint64_t v = 0x2725DD1D243ABA0Eull;  // floor((2^128 - 1) / d) - 2^64
+		uint64_t u1 = (hi << 4) | (lo >> 60), u0 = lo << 4;
+		uint64_t q1;
+		uint64_t q0 = limb_mul(v, u1, q1);
+		q0 += u0;
+		q1 += u1 + 1 + (q0 < u0);
+		uint64_t r = u0 - q1 * d;
+		if (r > q0) { --q1; r += d; }
+		if (r >= d) { ++q1; r -= d; }
+		carry = q1;
+		return r >> 4;
+	}
+	// a * b + c + carry: returns the lower limb, and the upper limb in carry
+	static inline uint64_t mul_add(uint64_t a, uint64_t b, uint64_t c, uint64_t& carry) {
+		uint64_t hi;
+		uint64_t lo = limb_mul(a, b, hi);
+		lo += c;
+		hi += (lo < c);
+		lo += carry;
+		hi += (lo < carry);
+		return split(hi, lo, carry);
+	}
+	// (hi * base + lo) / d for hi < d: returns the quotient, and the remainder in r
+	static inline uint64_t divrem(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& r) {
+		uint64_t th;
+		uint64_t tl = limb_mul(hi, base, th);
+		tl += lo;
+		th += (tl < lo);
+#if defined(__SIZEOF_INT128__)
+		uint128_t_ t = (uint128_t_(th) << 64) | tl;
+		uint64_t q = uint64_t(t / d);
+		r = uint64_t(t - uint128_t_(q) * d);
+		return q;
+#else
+		// restoring division, a quotient bit per step
+		uint64_t q = 0;
+		for (int i = 0; i < 64; ++i) {
+			bool top = (th >> 63) != 0;
+			th = (th << 1) | (tl >> 63);
+			tl <<= 1;
+			q <<= 1;
+			if (top || th >= d) { th -= d; q |= 1; }
+		}
+		r = th;
+		return q;
+#endif
+	}
+	// q * v > r * base + u, for r < base
+	static inline bool exceeds(uint64_t q, uint64_t v, uint64_t r, uint64_t u) {
+		uint64_t ph, rh;
+		uint64_t pl = limb_mul(q, v, ph);
+		uint64_t rl = limb_mul(r, base, rh);
+		rl += u;
+		rh += (rl < u);
+		return ph > rh || (ph == rh && pl > rl);
+	}
+};
+
+// compare the magnitudes a[0..na) and b[0..nb), without leading zero limbs: returns -1, 0, or 1
+template<typename Limb>
+inline int decimal_compare(const Limb* a, size_t na, const Limb* b, size_t nb) {
+	if (na != nb) return (na < nb) ? -1 : 1;
+	for (size_t i = na; i-- > 0; ) {
+		if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+	}
+	return 0;
+}
+
+// r[0..na) = a[0..na) + b[0..nb) for na >= nb, returns the carry; r may alias a or b
+template<typename Limb>
+inline Limb decimal_add(Limb* r, const Limb* a, size_t na, const Limb* b, size_t nb) {
+	constexpr Limb base = decimal_limb<Limb>::base;
+	Limb carry = 0;
+	for (size_t i = 0; i < na; ++i) {
+		Limb s = Limb(a[i] + (i < nb ? b[i] : 0) + carry);
+		carry = (s >= base);
+		r[i] = carry ? Limb(s - base) : s;
+	}
+	return carry;
+}
+
+// r[0..na) = a[0..na) - b[0..nb) for a >= b, returns the borrow; r may alias a or b
+template<typename Limb>
+inline Limb decimal_sub(Limb* r, const Limb* a, size_t na, const Limb* b, size_t nb) {
+	constexpr Limb base = decimal_limb<Limb>::base;
+	Limb borrow = 0;
+	for (size_t i = 0; i < na; ++i) {
+		Limb s = Limb((i < nb ? b[i] : 0) + borrow);
+		borrow = (a[i] < s);
+		r[i] = borrow ? Limb(a[i] + (base - s)) : Limb(a[i] - s);
+	}
+	return borrow;
+}
+
+// a[0..n) = a[0..n) * m + c for m, c < base, returns the carry limb
+template<typename Limb>
+inline Limb decimal_mul_small_add(Limb* a, size_t n, Limb m, Limb c) {
+	for (size_t i = 0; i < n; ++i) a[i] = decimal_limb<Limb>::mul_add(a[i], m, 0, c);
+	return c;
+}
+
+// a[0..n) /= d for 0 < d < base, returns the remainder
+template<typename Limb>
+inline Limb decimal_divide_small(Limb* a, size_t n, Limb d) {
+	Limb r = 0;
+	for (size_t i = n; i-- > 0; ) a[i] = decimal_limb<Limb>::divrem(r, a[i], d, r);
+	return r;
+}
+
+// r[0..na+nb) = a[0..na) * b[0..nb)
+template<typename Limb>
+inline void decimal_mul_schoolbook(Limb* r, const Limb* a, size_t na, const Limb* b, size_t nb) {
+	for (size_t i = 0; i < na + nb; ++i) r[i] = 0;
+	for (size_t i = 0; i < na; ++i) {
+		if (a[i] == 0) continue;
+		Limb carry = 0;
+		for (size_t j = 0; j < nb; ++j) r[i + j] = decimal_limb<Limb>::mul_add(a[i], b[j], r[i + j], carry);
+		r[i + nb] = carry;
+	}
+}
+
+// in place product: r[0..na+nb) = r[0..na) * b[0..nb), where r[na..na+nb) is zero and b does not overlap r
+// the limbs of r are consumed from the most significant down, so that every row accumulates above the limbs still to come
+template<typename Limb>
+inline void decimal_mul_inplace(Limb* r, size_t na, const Limb* b, size_t nb) {
+	constexpr Limb base = decimal_limb<Limb>::base;
+	for (size_t i = na; i-- > 0; ) {
+		Limb ai = r[i];
+		r[i] = 0;
+		if (ai == 0) continue;
+		Limb carry = 0;
+		for (size_t j = 0; j < nb; ++j) r[i + j] = decimal_limb<Limb>::mul_add(ai, b[j], r[i + j], carry);
+		for (size_t k = i + nb; carry; ++k) {
+			Limb s = Limb(r[k] + carry);
+			carry = (s >= base);
+			r[k] = carry ? Limb(s - base) : s;
+		}
+	}
+}
+
+template<typename Limb>
+inline void decimal_multiply(Limb* r, const Limb* a, size_t na, const Limb* b, size_t nb);
+
+// Karatsuba multiplication: r[0..2n) = a[0..n) * b[0..n)
+template<typename Limb>
+inline void decimal_mul_karatsuba(Limb* r, const Limb* a, const Limb* b, size_t n) {
+	if (n < DECIMAL_KARATSUBA_THRESHOLD || n < 4) {
+		decimal_mul_schoolbook(r, a, n, b, n);
+		return;
+	}
+	// a = a1 * B^h + a0, b = b1 * B^h + b0, with the upper halves of l = n - h <= h limbs
+	size_t h = (n + 1) / 2;
+	size_t l = n - h;
+	decimal_mul_karatsuba(r, a, b, h);              // z0 = a0 * b0 in r[0..2h)
+	decimal_multiply(r + 2 * h, a + h, l, b + h, l);  // z2 = a1 * b1 in r[2h..2n)
+	// z1 = (a0 + a1) * (b0 + b1) - z0 - z2, where the sums have h + 1 limbs
+	std::vector<Limb> sa(h + 1), sb(h + 1), z1(2 * h + 2);
+	sa[h] = decimal_add(sa.data(), a, h, a + h, l);
+	sb[h] = decimal_add(sb.data(), b, h, b + h, l);
+	decimal_mul_karatsuba(z1.data(), sa.data(), sb.data(), h + 1);
+	decimal_sub(z1.data(), z1.data(), 2 * h + 2, r, 2 * h);
+	decimal_sub(z1.data(), z1.data(), 2 * h + 2, r + 2 * h, 2 * l);
+	// r += z1 * B^h, where z1 < 2 B^n has at most n + 1 <= 2n - h limbs
+	decimal_add(r + h, r + h, 2 * n - h, z1.data(), limb_significant(z1.data(), 2 * h + 2));
+}
+
+// r[0..na+nb) = a[0..na) * b[0..nb), where r does not overlap the operands
+// long operands of unequal length are multiplied in Karatsuba blocks of the shorter operand
+template<typename Limb>
+inline void decimal_multiply(Limb* r, const Limb* a, size_t na, const Limb* b, size_t nb) {
+	if (na < nb) {
+		std::swap(a, b);
+		std::swap(na, nb);
+	}
+	if (nb < DECIMAL_KARATSUBA_THRESHOLD) {
+		decimal_mul_schoolbook(r, a, na, b, nb);
+		return;
+	}
+	for (size_t i = 0; i < na + nb; ++i) r[i] = 0;
+	std::vector<Limb> t(2 * nb);
+	for (size_t i = 0; i < na; i += nb) {
+		size_t len = (na - i < nb) ? na - i : nb;
+		if (len == nb) decimal_mul_karatsuba(t.data(), a + i, b, nb); else decimal_multiply(t.data(), b, nb, a + i, len);
+		decimal_add(r + i, r + i, na + nb - i, t.data(), len + nb);
+	}
+}
+
+// Knuth Algorithm D: q[0..m-n] = u[0..m) / v[0..n), r[0..n) = u[0..m) % v[0..n), for m >= n and v[n-1] != 0
+// un[0..m] and vn[0..n) are scratch
+template<typename Limb>
+inline void decimal_divide(Limb* q, Limb* r, const Limb* u, size_t m, const Limb* v, size_t n, Limb* un, Limb* vn) {
+	using limb = decimal_limb<Limb>;
+	constexpr Limb base = limb::base;
+	for (size_t i = 0; i < m; ++i) un[i] = u[i];
+	if (n == 1) {
+		r[0] = decimal_divide_small(un, m, v[0]);
+		for (size_t i = 0; i < m; ++i) q[i] = un[i];
+		return;
+	}
+	// normalize so that the most significant limb of the divisor is at least base / 2
+	Limb f = Limb(base / (Limb(v[n - 1]) + 1));
+	for (size_t i = 0; i < n; ++i) vn[i] = v[i];
+	un[m] = decimal_mul_small_add(un, m, f, Limb(0));
+	decimal_mul_small_add(vn, n, f, Limb(0));
+	Limb v1 = vn[n - 1], v2 = vn[n - 2];
+	for (size_t j = m - n + 1; j-- > 0; ) {
+		// estimate the quotient limb from the top two limbs of the running remainder
+		Limb qhat, rhat;
+		if (un[j + n] >= v1) {
+			qhat = base - 1;
+			rhat = Limb(un[j + n - 1] + v1);
+		}
+		else {
+			qhat = limb::divrem(un[j + n], un[j + n - 1], v1, rhat);
+		}
+		while (rhat < base && limb::exceeds(qhat, v2, rhat, un[j + n - 2])) {
+			--qhat;
+			rhat = Limb(rhat + v1);
+		}
+		// multiply and subtract
+		Limb carry = 0, borrow = 0;
+		for (size_t i = 0; i < n; ++i) {
+			Limb s = Limb(limb::mul_add(qhat, vn[i], 0, carry) + borrow);
+			borrow = (un[i + j] < s);
+			un[i + j] = borrow ? Limb(un[i + j] + (base - s)) : Limb(un[i + j] - s);
+		}
+		Limb s = Limb(carry + borrow);
+		bool negative = (un[j + n] < s);
+		un[j + n] = negative ? Limb(un[j + n] + (base - s)) : Limb(un[j + n] - s);
+		if (negative) {
+			// the estimate was one too large: add back
+			--qhat;
+			Limb c = decimal_add(un + j, un + j, n, vn, n);
+			un[j + n] = Limb(un[j + n] + c);
+			if (un[j + n] >= base) un[j + n] = Limb(un[j + n] - base);
+		}
+		q[j] = qhat;
+	}
+	// unnormalize the remainder
+	for (size_t i = 0; i < n; ++i) r[i] = un[i];
+	decimal_divide_small(r, n, f);
+}
+
+// 64-bit limbs need a 128/64-bit division for the quotient estimates: without a native one, 32-bit limbs are faster
+#if defined(__SIZEOF_INT128__)
+using packed_decimal_limb = uint64_t;
+#else
+using packed_decimal_limb = uint32_t;
+#endif
+
+} // namespace internal
+
+// Arbitrary precision decimal integer with 9 or 18 digits per limb
+template<typename Limb = internal::packed_decimal_limb>
+class packed_decimal {
+	static_assert(std::is_same<Limb, uint32_t>::value || std::is_same<Limb, uint64_t>::value, "packed_decimal limbs are uint32_t or uint64_t");
+public:
+	using limb_type = Limb;
+	static constexpr Limb base = internal::decimal_limb<Limb>::base;
+	static constexpr unsigned digitsInLimb = internal::decimal_limb<Limb>::digits;
+	static constexpr size_t nrInlineLimbs = 32 / sizeof(Limb);
+
+	packed_decimal() : _limb(_inline), _size(0), _capacity(nrInlineLimbs), _negative(false) {}
+
+	packed_decimal(const packed_decimal& rhs) : packed_decimal() { *this = rhs; }
+	packed_decimal(packed_decimal&& rhs) noexcept : packed_decimal() { *this = std::move(rhs); }
+	~packed_decimal() { release(); }
+
+	packed_decimal& operator=(const packed_decimal& rhs) {
+		if (this == &rhs) return *this;
+		reserve(rhs._size);
+		for (size_t i = 0; i < rhs._size; ++i) _limb[i] = rhs._limb[i];
+		_size = rhs._size;
+		_negative = rhs._negative;
+		return *this;
+	}
+	packed_decimal& operator=(packed_decimal&& rhs) noexcept {
+		if (this == &rhs) return *this;
+		if (rhs._limb != rhs._inline) {
+			// take over the heap buffer
+			release();
+			_limb = rhs._limb;
+			_capacity = rhs._capacity;
+			rhs._limb = rhs._inline;
+			rhs._capacity = nrInlineLimbs;
+		}
+		else {
+			for (size_t i = 0; i < rhs._size; ++i) _limb[i] = rhs._limb[i];
+		}
+		_size = rhs._size;
+		_negative = rhs._negative;
+		rhs._size = 0;
+		rhs._negative = false;
+		return *this;
+	}
+
+	// initializers for native integer types
+	template<typename Ty, typename = typename std::enable_if<std::is_integral<Ty>::value>::type>
+	packed_decimal(Ty initial_value) : packed_decimal() { *this = initial_value; }
+	// conversion from and to the digit per byte decimal
+	explicit packed_decimal(const decimal& d) : packed_decimal() { *this = d; }
+	explicit packed_decimal(const std::string& digits) : packed_decimal() { parse(digits); }
+
+	// assignment operators for native integer types
+	template<typename Ty>
+	typename std::enable_if<std::is_integral<Ty>::value, packed_decimal&>::type operator=(Ty rhs) {
+		setzero();
+		unsigned long long magnitude = static_cast<unsigned long long>(rhs);
+		if (std::is_signed<Ty>::value && rhs < 0) {
+			_negative = true;
+			magnitude = 0ull - magnitude;
+		}
+		for (; magnitude > 0; magnitude /= base) push_back(Limb(magnitude % base));
+		return *this;
+	}
+	packed_decimal& operator=(const decimal& d) {
+		// d holds a digit per byte, least significant first
+		size_t n = (d.size() + digitsInLimb - 1) / digitsInLimb;
+		setzero();
+		resize(n);
+		for (size_t i = 0; i < n; ++i) {
+			Limb l = 0;
+			for (size_t k = digitsInLimb; k-- > 0; ) {
+				size_t digit = i * digitsInLimb + k;
+				l = Limb(l * 10 + (digit < d.size() ? d[digit] : 0));
+			}
+			_limb[i] = l;
+		}
+		normalize();
+		if (_size > 0) _negative = d.sign();
+		return *this;
+	}
+	packed_decimal& operator=(const std::string& digits) {
+		parse(digits);
+		return *this;
+	}
+
+	// arithmetic operators
+	packed_decimal& operator+=(const packed_decimal& rhs) { return accumulate(rhs, rhs._negative); }
+	packed_decimal& operator-=(const packed_decimal& rhs) { return accumulate(rhs, !rhs._negative); }
+	packed_decimal& operator*=(const packed_decimal& rhs) {
+		if (iszero() || rhs.iszero()) {
+			setzero();
+			return *this;
+		}
+		if (this == &rhs) return operator*=(packed_decimal(rhs));
+		bool negative = (_negative != rhs._negative);
+		size_t na = _size, nb = rhs._size;
+		if (na >= DECIMAL_KARATSUBA_THRESHOLD && nb >= DECIMAL_KARATSUBA_THRESHOLD) {
+			std::vector<Limb> product(na + nb);
+			internal::decimal_multiply(product.data(), _limb, na, rhs._limb, nb);
+			resize(na + nb);
+			for (size_t i = 0; i < na + nb; ++i) _limb[i] = product[i];
+		}
+		else {
+			resize(na + nb);
+			internal::decimal_mul_inplace(_limb, na, rhs._limb, nb);
+		}
+		normalize();
+		_negative = negative;
+		return *this;
+	}
+	packed_decimal& operator/=(const packed_decimal& rhs) {
+		packed_decimal q;
+		divide(*this, rhs, &q, nullptr);
+		return *this = std::move(q);
+	}
+	packed_decimal& operator%=(const packed_decimal& rhs) {
+		packed_decimal r;
+		divide(*this, rhs, nullptr, &r);
+		return *this = std::move(r);
+	}
+
+	// unitary operators
+	packed_decimal operator-() const {
+		packed_decimal tmp(*this);
+		if (!tmp.iszero()) tmp._negative = !tmp._negative;
+		return tmp;
+	}
+	packed_decimal operator++(int) { // postfix
+		packed_decimal tmp(*this);
+		increment(!_negative);
+		return tmp;
+	}
+	packed_decimal& operator++() { // prefix
+		increment(!_negative);
+		return *this;
+	}
+	packed_decimal operator--(int) { // postfix
+		packed_decimal tmp(*this);
+		increment(_negative);
+		return tmp;
+	}
+	packed_decimal& operator--() { // prefix
+		increment(_negative);
+		return *this;
+	}
+
+	// conversion operators
+	explicit operator unsigned short() const { return static_cast<unsigned short>(to_long_long()); }
+	explicit operator unsigned int() const { return static_cast<unsigned int>(to_long_long()); }
+	explicit operator unsigned long() const { return static_cast<unsigned long>(to_long_long()); }
+	explicit operator unsigned long long() const { return static_cast<unsigned long long>(to_long_long()); }
+	explicit operator short() const { return static_cast<short>(to_long_long()); }
+	explicit operator int() const { return static_cast<int>(to_long_long()); }
+	explicit operator long() const { return static_cast<long>(to_long_long()); }
+	explicit operator long long() const { return to_long_long(); }
+	explicit operator decimal() const {
+		decimal d;
+		d.clear();
+		for (size_t i = 0; i < _size; ++i) {
+			Limb l = _limb[i];
+			for (unsigned k = 0; k < digitsInLimb; ++k, l /= 10) d.push_back(uint8_t(l % 10));
+		}
+		if (d.empty()) d.push_back(0);
+		d.unpad();
+		d.setsign(_negative);
+		return d;
+	}
+
+	// selectors
+	inline bool iszero() const { return _size == 0; }
+	inline bool sign() const { return _negative; }
+	inline bool isneg() const { return _negative; }   // <  0
+	inline bool ispos() const { return !_negative; }  // >= 0
+	// number of significant limbs, and the limbs themselves, least significant first
+	inline size_t size() const { return _size; }
+	inline Limb limb(size_t i) const { return (i < _size) ? _limb[i] : Limb(0); }
+	// number of decimal digits, one for zero
+	inline size_t nrDigits() const {
+		if (_size == 0) return 1;
+		size_t n = (_size - 1) * digitsInLimb;
+		for (Limb l = _limb[_size - 1]; l > 0; l /= 10) ++n;
+		return n;
+	}
+
+	// modifiers
+	inline void setzero() { _size = 0; _negative = false; }
+	inline void setsign(bool sign) { _negative = sign && !iszero(); }
+	inline void setneg() { setsign(true); }
+	inline void setpos() { _negative = false; }
+
+	// read a decimal ASCII format [+-]?[0-9]+ and make a packed decimal out of it
+	bool parse(const std::string& _digits) {
+		std::string digits(_digits);
+		trim(digits);
+		size_t first = (!digits.empty() && (digits[0] == '-' || digits[0] == '+')) ? 1 : 0;
+		if (first == digits.size()) return false;
+		for (size_t i = first; i < digits.size(); ++i) {
+			if (digits[i] < '0' || digits[i] > '9') return false;
+		}
+		size_t nrDigits = digits.size() - first;
+		size_t n = (nrDigits + digitsInLimb - 1) / digitsInLimb;
+		setzero();
+		resize(n);
+		// limb i holds the digits that end digitsInLimb * i characters from the end
+		for (size_t i = 0; i < n; ++i) {
+			size_t end = digits.size() - i * digitsInLimb;
+			size_t begin = (end - first > digitsInLimb) ? end - digitsInLimb : first;
+			Limb l = 0;
+			for (size_t k = begin; k < end; ++k) l = Limb(l * 10 + Limb(digits[k] - '0'));
+			_limb[i] = l;
+		}
+		normalize();
+		setsign(digits[0] == '-');
+		return true;
+	}
+
+	// quotient and remainder of a truncating division: the remainder takes the sign of the dividend
+	static void divide(const packed_decimal& a, const packed_decimal& b, packed_decimal* quot, packed_decimal* rem) {
+		if (b.iszero()) {
+#if DECIMAL_THROW_ARITHMETIC_EXCEPTION
+			throw decimal_integer_divide_by_zero{};
+#else
+			std::cerr << "integer_divide_by_zero\n";
+			if (quot) quot->setzero();
+			if (rem) rem->setzero();
+			return;
+#endif // DECIMAL_THROW_ARITHMETIC_EXCEPTION
+		}
+		if (internal::decimal_compare(a._limb, a._size, b._limb, b._size) < 0) {
+			if (rem) *rem = a;
+			if (quot) quot->setzero();
+			return;
+		}
+		size_t m = a._size, n = b._size;
+		packed_decimal q, r;
+		q.resize(m - n + 1);
+		r.resize(n);
+		// scratch for the normalized operands, inline when they are short
+		Limb local[2 * nrInlineLimbs + 1];
+		std::vector<Limb> scratch;
+		Limb* un = local;
+		if (m + 1 + n > 2 * nrInlineLimbs + 1) {
+			scratch.resize(m + 1 + n);
+			un = scratch.data();
+		}
+		internal::decimal_divide(q._limb, r._limb, a._limb, m, b._limb, n, un, un + m + 1);
+		q.normalize();
+		q.setsign(a._negative != b._negative);
+		r.normalize();
+		r.setsign(a._negative);
+		if (quot) *quot = std::move(q);
+		if (rem) *rem = std::move(r);
+	}
+
+private:
+	Limb* _limb;      // points at _inline, or at a heap buffer of _capacity limbs
+	size_t _size;     // number of significant limbs, zero for the value zero
+	size_t _capacity;
+	bool _negative;   // sign-magnitude number: indicate if number is positive or negative
+	Limb _inline[nrInlineLimbs];
+
+	void release() {
+		if (_limb != _inline) delete[] _limb;
+		_limb = _inline;
+		_capacity = nrInlineLimbs;
+	}
+	void reserve(size_t n) {
+		if (n <= _capacity) return;
+		size_t capacity = (2 * _capacity > n) ? 2 * _capacity : n;
+		Limb* limbs = new Limb[capacity];
+		for (size_t i = 0; i < _size; ++i) limbs[i] = _limb[i];
+		release();
+		_limb = limbs;
+		_capacity = capacity;
+	}
+	// grow to n limbs with zero limbs on top
+	void resize(size_t n) {
+		reserve(n);
+		for (size_t i = _size; i < n; ++i) _limb[i] = 0;
+		_size = n;
+	}
+	void push_back(Limb l) {
+		reserve(_size + 1);
+		_limb[_size++] = l;
+	}
+	// remove leading zero limbs, and the sign of zero
+	void normalize() {
+		_size = internal::limb_significant(_limb, _size);
+		if (_size == 0) _negative = false;
+	}
+
+	// add, when rhsNegative is the sign of this, or subtract the magnitude of rhs
+	packed_decimal& accumulate(const packed_decimal& rhs, bool rhsNegative) {
+		if (rhs.iszero()) return *this;
+		if (iszero()) {
+			*this = rhs;
+			_negative = rhsNegative;
+			return *this;
+		}
+		if (_negative == rhsNegative) {
+			size_t n = (_size > rhs._size) ? _size : rhs._size;
+			resize(n);  // rhs may be *this, whose limbs are read after the resize
+			Limb carry = internal::decimal_add(_limb, _limb, n, rhs._limb, rhs._size);
+			if (carry) push_back(carry);
+		}
+		else if (internal::decimal_compare(_limb, _size, rhs._limb, rhs._size) >= 0) {
+			internal::decimal_sub(_limb, _limb, _size, rhs._limb, rhs._size);
+			normalize();
+		}
+		else {
+			size_t n = _size;
+			resize(rhs._size);
+			internal::decimal_sub(_limb, rhs._limb, rhs._size, _limb, n);
+			_negative = rhsNegative;
+			normalize();
+		}
+		return *this;
+	}
+	// add one to the magnitude when grow, subtract one otherwise, without temporaries
+	void increment(bool grow) {
+		if (iszero()) {
+			// ++ grows zero to 1, -- shrinks zero to -1
+			push_back(1);
+			_negative = !grow;
+			return;
+		}
+		if (grow) {
+			size_t i = 0;
+			for (; i < _size && _limb[i] == base - 1; ++i) _limb[i] = 0;
+			if (i == _size) push_back(1); else ++_limb[i];
+		}
+		else {
+			size_t i = 0;
+			for (; _limb[i] == 0; ++i) _limb[i] = base - 1;
+			--_limb[i];
+			normalize();
+		}
+	}
+	long long to_long_long() const {
+		unsigned long long v = 0;
+		for (size_t i = _size; i-- > 0; ) v = v * base + _limb[i];
+		return static_cast<long long>(_negative ? 0ull - v : v);
+	}
+};
+
+////////////////// helper functions
+
+// generate an ASCII decimal string
+template<typename Limb>
+inline std::string to_string(const packed_decimal<Limb>& d) {
+	constexpr unsigned digitsInLimb = packed_decimal<Limb>::digitsInLimb;
+	if (d.iszero()) return std::string("0");
+	size_t nrDigits = d.nrDigits();
+	std::string str(nrDigits + (d.isneg() ? 1 : 0), '0');
+	if (d.isneg()) str[0] = '-';
+	size_t pos = str.size();
+	for (size_t i = 0; i < d.size(); ++i) {
+		Limb l = d.limb(i);
+		for (unsigned k = 0; k < digitsInLimb && (l > 0 || i + 1 < d.size()); ++k, l /= 10) str[--pos] = char('0' + l % 10);
+	}
+	return str;
+}
+
+// return quotient of a decimal integer division
+template<typename Limb>
+inline packed_decimal<Limb> quotient(const packed_decimal<Limb>& a, const packed_decimal<Limb>& b) {
+	packed_decimal<Limb> q;
+	packed_decimal<Limb>::divide(a, b, &q, nullptr);
+	return q;
+}
+// return remainder of a decimal integer division
+template<typename Limb>
+inline packed_decimal<Limb> remainder(const packed_decimal<Limb>& a, const packed_decimal<Limb>& b) {
+	packed_decimal<Limb> r;
+	packed_decimal<Limb>::divide(a, b, nullptr, &r);
+	return r;
+}
+
+////////////////// PACKED DECIMAL operators
+
+/// stream operators
+
+// generate an ASCII decimal format and send to ostream
+template<typename Limb>
+inline std::ostream& operator<<(std::ostream& ostr, const packed_decimal<Limb>& d) {
+	return ostr << to_string(d);
+}
+
+// read an ASCII decimal format from an istream
+template<typename Limb>
+inline std::istream& operator>>(std::istream& istr, packed_decimal<Limb>& p) {
+	std::string txt;
+	istr >> txt;
+	if (!p.parse(txt)) {
+		std::cerr << "unable to parse -" << txt << "- into a packed decimal value\n";
+	}
+	return istr;
+}
+
+/// binary arithmetic operators
+
+template<typename Limb>
+inline packed_decimal<Limb> operator+(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	packed_decimal<Limb> sum(lhs);
+	return sum += rhs;
+}
+template<typename Limb>
+inline packed_decimal<Limb> operator-(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	packed_decimal<Limb> diff(lhs);
+	return diff -= rhs;
+}
+template<typename Limb>
+inline packed_decimal<Limb> operator*(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	packed_decimal<Limb> mul(lhs);
+	return mul *= rhs;
+}
+template<typename Limb>
+inline packed_decimal<Limb> operator/(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	return quotient(lhs, rhs);
+}
+template<typename Limb>
+inline packed_decimal<Limb> operator%(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	return remainder(lhs, rhs);
+}
+
+/// logic operators
+
+// packed_decimal - packed_decimal logic operators
+template<typename Limb>
+inline bool operator==(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	if (lhs.sign() != rhs.sign() || lhs.size() != rhs.size()) return false;
+	for (size_t i = 0; i < lhs.size(); ++i) if (lhs.limb(i) != rhs.limb(i)) return false;
+	return true;
+}
+template<typename Limb>
+inline bool operator!=(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	return !operator==(lhs, rhs);
+}
+template<typename Limb>
+inline bool operator<(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	if (lhs.sign() != rhs.sign()) return lhs.sign();
+	// compare the magnitudes, most significant limb first
+	int cmp = 0;
+	if (lhs.size() != rhs.size()) {
+		cmp = (lhs.size() < rhs.size()) ? -1 : 1;
+	}
+	else {
+		for (size_t i = lhs.size(); i-- > 0 && cmp == 0; ) {
+			if (lhs.limb(i) != rhs.limb(i)) cmp = (lhs.limb(i) < rhs.limb(i)) ? -1 : 1;
+		}
+	}
+	return lhs.sign() ? (cmp > 0) : (cmp < 0);
+}
+template<typename Limb>
+inline bool operator>(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	return operator<(rhs, lhs);
+}
+template<typename Limb>
+inline bool operator<=(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	return !operator<(rhs, lhs);
+}
+template<typename Limb>
+inline bool operator>=(const packed_decimal<Limb>& lhs, const packed_decimal<Limb>& rhs) {
+	return !operator<(lhs, rhs);
+}
+
+// packed_decimal - long long logic operators
+template<typename Limb>
+inline bool operator==(const packed_decimal<Limb>& lhs, long long rhs) {
+	return lhs == packed_decimal<Limb>(rhs);
+}
+template<typename Limb>
+inline bool operator!=(const packed_decimal<Limb>& lhs, long long rhs) {
+	return lhs != packed_decimal<Limb>(rhs);
+}
+template<typename Limb>
+inline bool operator< (const packed_decimal<Limb>& lhs, long long rhs) {
+	return lhs < packed_decimal<Limb>(rhs);
+}
+template<typename Limb>
+inline bool operator> (const packed_decimal<Limb>& lhs, long long rhs) {
+	return lhs > packed_decimal<Limb>(rhs);
+}
+template<typename Limb>
+inline bool operator<=(const packed_decimal<Limb>& lhs, long long rhs) {
+	return lhs <= packed_decimal<Limb>(rhs);
+}
+template<typename Limb>
+inline bool operator>=(const packed_decimal<Limb>& lhs, long long rhs) {
+	return lhs >= packed_decimal<Limb>(rhs);
+}
+
+// long long - packed_decimal logic operators
+template<typename Limb>
+inline bool operator==(long long lhs, const packed_decimal<Limb>& rhs) {
+	return packed_decimal<Limb>(lhs) == rhs;
+}
+template<typename Limb>
+inline bool operator!=(long long lhs, const packed_decimal<Limb>& rhs) {
+	return packed_decimal<Limb>(lhs) != rhs;
+}
+template<typename Limb>
+inline bool operator< (long long lhs, const packed_decimal<Limb>& rhs) {
+	return packed_decimal<Limb>(lhs) < rhs;
+}
+template<typename Limb>
+inline bool operator> (long long lhs, const packed_decimal<Limb>& rhs) {
+	return packed_decimal<Limb>(lhs) > rhs;
+}
+template<typename Limb>
+inline bool operator<=(long long lhs, const packed_decimal<Limb>& rhs) {
+	return packed_decimal<Limb>(lhs) <= rhs;
+}
+template<typename Limb>
+inline bool operator>=(long long lhs, const packed_decimal<Limb>& rhs) {
+	return packed_decimal<Limb>(lhs) >= rhs;
+}
+
+}} // namespace sw::unum
@@ -11,6 +11,7 @@
 #include <regex>
 #include <vector>
 #include <map>
+#include <array>
 #include <cassert>
 
 /*
@@ -33,6 +34,7 @@ Run-time configuration is used to select modular vs saturation arithmetic.
 #endif // FIXPNT_THROW_ARITHMETIC_EXCEPTION
 #include "universal/native/ieee-754.hpp"   // IEEE-754 decoders
 #include "universal/native/integers.hpp"   // manipulators for native integer types
+#include "universal/native/limb_radix_conversion.hpp" // decimal conversion of multi-precision magnitudes
 #include "universal/blockbin/blockbinary.hpp"
 
 #if defined(__clang__)
@@ -688,6 +690,11 @@ public:
 	inline constexpr fixpnt& flip() noexcept { bb.flip(); return *this; }
 	// use un-interpreted raw bits to set the bits of the fixpnt: TODO: expand the API to support fixed-points > 64 bits
 	inline constexpr void set_raw_bits(uint64_t value) noexcept { bb.set_raw_bits(value); }
+	// use the bits of a blockbinary as the bits of the fixpnt
+	inline void setbb(const blockbinary<nbits, bt>& bits) noexcept { bb = bits; }
+	inline constexpr void setbyte(size_t byteIndex, uint8_t byte) {
+		for (size_t i = 0; i < 8 && 8 * byteIndex + i < nbits; ++i) bb.set(8 * byteIndex + i, (byte >> i) & 0x1);
+	}
 	inline fixpnt& assign(const std::string& txt) noexcept {
 		if (!parse(txt, *this)) {
 			std::cerr << "Unable to parse: " << txt << std::endl;
@@ -1974,85 +1981,117 @@ namespace support {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+// maximum number of characters of the decimal representation of a fixpnt<nbits, rbits>, i.e. "-1234.5678"
+template<size_t nbits, size_t rbits, bool arithmetic = Modulo, typename bt = uint8_t>
+constexpr size_t max_decimal_chars() {
+	return 1 + internal::limb_decimal_digits(nbits > rbits ? nbits - rbits : 0) + (rbits > 0 ? 1 + rbits : 0);
+}
+
+// write the decimal representation of a fixpnt into [first, last), without a terminating null
+// the fraction is exact, with rbits digits; returns the end of the characters written, or nullptr when the buffer is too small
+template<size_t nbits, size_t rbits, bool arithmetic, typename bt>
+inline char* to_decimal_chars(char* first, char* last, const fixpnt<nbits, rbits, arithmetic, bt>& value) {
+	constexpr size_t nrLimbs = (nbits + 63) / 64;
+	constexpr size_t nrIntegerLimbs = (nbits > rbits) ? (nbits - rbits + 63) / 64 : 1;
+	constexpr size_t nrFractionLimbs = (rbits + 63) / 64 + 1;
+	constexpr size_t nrFiveLimbs = (rbits * 2322 / 1000 + 64) / 64;  // 5^rbits < 2^(2.322 rbits)
+	// the fraction f / 2^rbits is f * 5^rbits / 10^rbits
+	static const std::array<uint64_t, nrFiveLimbs> five = [] {
+		std::array<uint64_t, nrFiveLimbs> p{};
+		internal::limb_power_of_five(p.data(), nrFiveLimbs, rbits);
+		return p;
+	}();
+	uint64_t limbs[nrLimbs];
+	internal::pack_blocks(limbs, nrLimbs, value.getbb());
+	if (value.sign()) {
+		if (first == last) return nullptr;
+		*first++ = '-';
+		internal::limb_negate(limbs, limbs, nrLimbs);
+		if (nbits % 64) limbs[nrLimbs - 1] &= (uint64_t(1) << (nbits % 64)) - 1;
+	}
+	uint64_t integerPart[nrLimbs];
+	internal::limb_shift_right(integerPart, limbs, nrLimbs, rbits);
+	first = internal::limb_to_decimal<nrIntegerLimbs>(first, last, integerPart);
+	if (first == nullptr || rbits == 0) return first;
+	if (first == last) return nullptr;
+	*first++ = '.';
+	uint64_t fraction[nrFractionLimbs] = { 0 };
+	uint64_t scaled[nrFractionLimbs + nrFiveLimbs];
+	for (size_t i = 0; i < rbits / 64; ++i) fraction[i] = limbs[i];
+	if (rbits % 64) fraction[rbits / 64] = limbs[rbits / 64] & ((uint64_t(1) << (rbits % 64)) - 1);
+	internal::limb_multiply(scaled, fraction, nrFractionLimbs, five.data(), nrFiveLimbs);
+	return internal::limb_to_decimal<nrFractionLimbs + nrFiveLimbs>(first, last, scaled, rbits);
+}
+
+// parse an optionally signed decimal fixed-point number [-+]digits[.digits] at the start of [first, last)
+// the fraction rounds to nearest, ties to even, and the integer part wraps or saturates with the arithmetic
+// returns the end of the characters consumed, or first when there are no digits
+template<size_t nbits, size_t rbits, bool arithmetic, typename bt>
+inline const char* from_decimal_chars(const char* first, const char* last, fixpnt<nbits, rbits, arithmetic, bt>& value) {
+	constexpr size_t nrLimbs = (nbits + 63) / 64 + 1;  // a spare limb for the carry of the rounding
+	constexpr size_t nrDigits = rbits + 1;  // the midpoints between fixpnt values have rbits + 1 decimal digits
+	constexpr size_t nrFractionLimbs = (nrDigits * 3322 / 1000 + 64) / 64 + 1;
+	const char* p = first;
+	bool negative = false;
+	if (p != last && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+	if (p == last || *p < '0' || *p > '9') return first;
+	uint64_t magnitude[nrLimbs];
+	bool overflow;
+	p = internal::limb_from_decimal<nrLimbs>(magnitude, p, last, overflow);
+	overflow = overflow || internal::limb_leading_zeros(magnitude, nrLimbs) + nbits < 64 * nrLimbs + rbits;
+	internal::limb_shift_left(magnitude, magnitude, nrLimbs, rbits);
+	if (p != last && *p == '.') {
+		// the digits beyond the first rbits + 1 only break ties
+		char digits[nrDigits];
+		size_t d = 0;
+		bool sticky = false;
+		for (++p; p != last && *p >= '0' && *p <= '9'; ++p) {
+			if (d < nrDigits) digits[d++] = *p; else sticky = sticky || (*p != '0');
+		}
+		while (d < nrDigits) digits[d++] = '0';
+		// fraction * 2^rbits = D / (2 * 5^(rbits + 1)) for the rbits + 1 digits D
+		uint64_t D[nrFractionLimbs], half[nrFractionLimbs], divisor[nrFractionLimbs];
+		bool unused;
+		internal::limb_from_decimal<nrFractionLimbs>(D, digits, digits + nrDigits, unused);
+		internal::limb_power_of_five(half, nrFractionLimbs, nrDigits);
+		internal::limb_shift_left(divisor, half, nrFractionLimbs, 1);
+		uint32_t u[2 * nrFractionLimbs], v[2 * nrFractionLimbs], q[2 * nrFractionLimbs], r[2 * nrFractionLimbs];
+		for (size_t i = 0; i < nrFractionLimbs; ++i) {
+			u[2 * i] = uint32_t(D[i]);
+			u[2 * i + 1] = uint32_t(D[i] >> 32);
+			v[2 * i] = uint32_t(divisor[i]);
+			v[2 * i + 1] = uint32_t(divisor[i] >> 32);
+		}
+		internal::limb_divide(q, r, u, 2 * nrFractionLimbs, v, 2 * nrFractionLimbs);
+		for (size_t i = 0; i < nrFractionLimbs; ++i) {
+			if (i < nrLimbs) magnitude[i] |= uint64_t(q[2 * i]) | (uint64_t(q[2 * i + 1]) << 32);
+			D[i] = uint64_t(r[2 * i]) | (uint64_t(r[2 * i + 1]) << 32);
+		}
+		int cmp = internal::limb_compare(D, half, nrFractionLimbs);
+		if (cmp > 0 || (cmp == 0 && (sticky || (magnitude[0] & 0x1)))) internal::limb_add_carry(magnitude, nrLimbs, 1);
+	}
+	if (arithmetic == Saturating) {
+		// magnitudes beyond maxpos = 2^(nbits-1) - 1 ulp, or maxneg = -2^(nbits-1) ulp, saturate
+		uint64_t limit[nrLimbs] = { 0 };
+		limit[(nbits - 1) / 64] = uint64_t(1) << ((nbits - 1) % 64);
+		int cmp = internal::limb_compare(magnitude, limit, nrLimbs);
+		if (overflow || cmp > 0 || (cmp == 0 && !negative)) {
+			if (negative) maxneg(value); else maxpos(value);
+			return p;
+		}
+	}
+	if (negative) internal::limb_negate(magnitude, magnitude, nrLimbs);
+	blockbinary<nbits, bt> bits;
+	internal::unpack_blocks(bits, magnitude, nrLimbs);
+	value.setbb(bits);
+	return p;
+}
+
 // convert fixpnt to decimal string, i.e. "-1234.5678"
 template<size_t nbits, size_t rbits, bool arithmetic, typename bt>
 std::string convert_to_decimal_string(const fixpnt<nbits, rbits, arithmetic, bt>& value) {
-	std::stringstream ss;
-	if (value.iszero()) {
-		ss << '0';
-		if (rbits > 0) {
-			ss << '.';
-			for (size_t i = 0; i < rbits; ++i) {
-				ss << '0';
-			}
-		}
-		return ss.str();
-	}
-	if (value.sign()) ss << '-';
-	support::decimal partial, multiplier;
-	fixpnt<nbits, rbits, arithmetic, bt> number;
-	number = value.sign() ? twos_complement(value) : value;
-	if (nbits > rbits) {
-		// convert the fixed point by first handling the integer part
-		multiplier.setdigit(1);
-		// convert fixpnt to decimal by adding and doubling multipliers
-		for (unsigned i = rbits; i < nbits; ++i) {
-			if (number.at(i)) {
-				support::add(partial, multiplier);
-				//std::cout << partial << std::endl;
-			}
-			support::add(multiplier, multiplier);
-		}
-		for (support::decimal::const_reverse_iterator rit = partial.rbegin(); rit != partial.rend(); ++rit) {
-			ss << (int)*rit;
-		}
-	}
-	else {
-		ss << '0';
-	}
-
-	if (rbits > 0) {
-		ss << ".";
-		// and secondly, the fraction part
-		support::decimal range, discretizationLevels, step;
-		// create the decimal range we are discretizing
-		range.setdigit(1);
-		range.shiftLeft(rbits);
-		// calculate the discretization levels of this range
-		discretizationLevels.setdigit(1);
-		for (size_t i = 0; i < rbits; ++i) {
-			support::add(discretizationLevels, discretizationLevels);
-		}
-		step = div(range, discretizationLevels);
-		// now construct the parts of this range the fraction samples
-		partial.setzero();
-		multiplier.setdigit(1);
-		// convert the fraction part
-		for (unsigned i = 0; i < rbits; ++i) {
-			if (number.at(i)) {
-				support::add(partial, multiplier);
-			}
-			support::add(multiplier, multiplier);
-		}
-		support::mul(partial, step);
-		// leading 0s will cause the partial to be represented incorrectly
-		// if we simply convert it to digits.
-		// The partial represents the parts in the range, so we can deduce
-		// the number of leading zeros by comparing to the length of range
-		size_t nrLeadingZeros = range.size() - partial.size() - 1;
-		for (size_t i = 0; i < nrLeadingZeros; ++i) ss << '0';
-		size_t digitsWritten = nrLeadingZeros;
-		for (support::decimal::const_reverse_iterator rit = partial.rbegin(); rit != partial.rend(); ++rit) {
-			ss << (int)*rit;
-			++digitsWritten;
-		}
-		if (digitsWritten < rbits) { // deal with trailing 0s
-			for (size_t i = digitsWritten; i < rbits; ++i) {
-				ss << '0';
-			}
-		}
-	}
-	return ss.str();
+	char buffer[max_decimal_chars<nbits, rbits, arithmetic, bt>()];
+	return std::string(buffer, to_decimal_chars(buffer, buffer + sizeof(buffer), value));
 }
 
 // read a fixed-point ASCII format and make a binary fixpnt out of it
@@ -2061,7 +2100,7 @@ bool parse(const std::string& number, fixpnt<nbits, rbits, arithmetic, bt>& valu
 	bool bSuccess = false;
 	value.clear();
 	// check if the txt is an fixpnt form: [0123456789]+
-	std::regex decimal_regex("[0-9]+");
+	std::regex decimal_regex("[-+]?[0-9]+(\\.[0-9]*)?");
 	std::regex octal_regex("^0[1-7][0-7]*$");
 	std::regex hex_regex("0[xX][0-9a-fA-F']+");
 	// setup associative array to map chars to nibbles
@@ -2133,14 +2172,7 @@ bool parse(const std::string& number, fixpnt<nbits, rbits, arithmetic, bt>& valu
 	}
 	else if (std::regex_match(number, decimal_regex)) {
 		//std::cout << "found a decimal fixpnt representation\n";
-		fixpnt<nbits, rbits, arithmetic, bt> scale = 1;
-		for (std::string::const_reverse_iterator r = number.rbegin();
-			r != number.rend();
-			++r) {
-			fixpnt<nbits, rbits, arithmetic, bt> digit = charLookup.at(*r);
-			value += scale * digit;
-			scale *= 10;
-		}
+		from_decimal_chars(number.data(), number.data() + number.size(), value);
 		bSuccess = true;
 	}
 
@@ -0,0 +1,241 @@
+#pragma once
+// native_quire.hpp: limb-based Kulisch accumulator for IEEE-754 float and double
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <array>
+#include <universal/native/limb_arithmetic.hpp>
+
+namespace sw {
+	namespace ieee {
+
+/// //////////////////////////////////////////////////////////////////
+/// native_quire: Kulisch accumulator for IEEE-754 float and double
+///
+/// The accumulator is a two's complement fixed-point number on 64-bit limbs that spans
+/// the full range of the products of two values of the format: from the product of two
+/// smallest subnormals to the square of the largest value, plus capacity bits to absorb
+/// the carries of 2^capacity accumulations. Values and exact products are deposited with
+/// word-level adds, so every accumulation is exact, and the accumulated sum is rounded
+/// once, to nearest with ties to even, when it is converted back to the native type.
+/// As the accumulation is exact, the result does not depend on the order of the terms,
+/// and accumulators of partial sums can be merged exactly: the result of a parallel
+/// reduction is bit-identical for any partitioning and any number of threads.
+/// Infinities and NaNs are tracked apart from the fixed-point sum and follow IEEE-754:
+/// NaN, or infinities of both signs, yield NaN, and otherwise an infinity dominates.
+
+namespace internal {
+
+	// encoding parameters of the IEEE-754 binary formats
+	template<typename Real> struct ieee_format;
+	template<> struct ieee_format<float> {
+		using bits_type = uint32_t;
+		static constexpr int fbits = 23;
+		static constexpr int ebits = 8;
+	};
+	template<> struct ieee_format<double> {
+		using bits_type = uint64_t;
+		static constexpr int fbits = 52;
+		static constexpr int ebits = 11;
+	};
+
+	// special value classes of the operands of a native_quire
+	constexpr uint8_t QUIRE_NAN     = 0x1;
+	constexpr uint8_t QUIRE_POS_INF = 0x2;
+	constexpr uint8_t QUIRE_NEG_INF = 0x4;
+
+	// decompose a finite value into sign, integer significand, and the scale of its lsb
+	// returns the special value class of a non-finite value, and 0 otherwise
+	template<typename Real>
+	inline uint8_t ieee_decompose(Real v, bool& sign, uint64_t& significand, int& lsb_scale) {
+		using format = ieee_format<Real>;
+		using bits_type = typename format::bits_type;
+		constexpr int bias = (1 << (format::ebits - 1)) - 1;
+		constexpr bits_type emask = (bits_type(1) << format::ebits) - 1;
+		constexpr bits_type fmask = (bits_type(1) << format::fbits) - 1;
+		bits_type raw;
+		std::memcpy(&raw, &v, sizeof(Real));
+		sign = (raw >> (format::fbits + format::ebits)) != 0;
+		bits_type biased = (raw >> format::fbits) & emask;
+		bits_type fraction = raw & fmask;
+		if (biased == emask) {
+			if (fraction) return QUIRE_NAN;
+			return sign ? QUIRE_NEG_INF : QUIRE_POS_INF;
+		}
+		if (biased == 0) {  // subnormal or zero
+			significand = fraction;
+			lsb_scale = 1 - bias - format::fbits;
+		}
+		else {
+			significand = fraction | (bits_type(1) << format::fbits);
+			lsb_scale = int(biased) - bias - format::fbits;
+		}
+		return 0;
+	}
+
+} // namespace internal
+
+// exact product of two IEEE-754 values, the operand of native_quire accumulation
+template<typename Real>
+struct native_product {
+	bool     sign;
+	uint64_t hi, lo;     // integer significand of the product
+	int      lsb_scale;  // scale of the lsb of the significand
+	uint8_t  special;    // special value class of a non-finite product
+};
+
+// multiply two values without rounding
+template<typename Real>
+inline native_product<Real> quire_mul(Real a, Real b) {
+	native_product<Real> p{ false, 0, 0, 0, 0 };
+	bool sa, sb;
+	uint64_t ma = 0, mb = 0;
+	int ea = 0, eb = 0;
+	uint8_t ca = internal::ieee_decompose(a, sa, ma, ea);
+	uint8_t cb = internal::ieee_decompose(b, sb, mb, eb);
+	p.sign = sa != sb;
+	if (ca | cb) {
+		// NaN operands, and the product of an infinity and zero, are NaN
+		if ((ca | cb) & internal::QUIRE_NAN || (ca && cb == 0 && mb == 0) || (cb && ca == 0 && ma == 0)) {
+			p.special = internal::QUIRE_NAN;
+		}
+		else {
+			p.special = p.sign ? internal::QUIRE_NEG_INF : internal::QUIRE_POS_INF;
+		}
+		return p;
+	}
+	p.lo = sw::unum::internal::limb_mul(ma, mb, p.hi);
+	p.lsb_scale = ea + eb;
+	return p;
+}
+
+template<typename Real, size_t capacity = 30>
+class native_quire {
+	using format = internal::ieee_format<Real>;
+	static constexpr int bias = (1 << (format::ebits - 1)) - 1;
+public:
+	static constexpr int    min_lsb_scale = 2 * (1 - bias - format::fbits);  // lsb of the product of two smallest subnormals
+	static constexpr int    max_scale     = 2 * (bias + 1) + int(capacity);   // products are smaller than 2^(2*(bias+1))
+	static constexpr size_t radix_point   = size_t(-min_lsb_scale);           // bit position of 2^0
+	static constexpr size_t qbits         = radix_point + size_t(max_scale) + 1;
+	static constexpr size_t nrLimbs       = (qbits + 127) / 64;                // a guard limb above the sign bit
+
+	native_quire() { reset(); }
+	native_quire(Real v) { reset(); *this += v; }
+
+	// add or subtract a value
+	native_quire& operator+=(Real v) { accumulate(v, false); return *this; }
+	native_quire& operator-=(Real v) { accumulate(v, true); return *this; }
+	// add or subtract an exact product
+	native_quire& operator+=(const native_product<Real>& p) { accumulate(p, false); return *this; }
+	native_quire& operator-=(const native_product<Real>& p) { accumulate(p, true); return *this; }
+	// exact merge of two accumulators
+	native_quire& operator+=(const native_quire& q) {
+		sw::unum::internal::limb_add(_limbs.data(), _limbs.data(), q._limbs.data(), nrLimbs);
+		_special |= q._special;
+		return *this;
+	}
+
+	void reset() { _limbs.fill(0); _special = 0; }
+	void clear() { reset(); }
+	bool iszero() const { return _special == 0 && sw::unum::internal::limb_is_zero(_limbs.data(), nrLimbs); }
+	bool isneg() const { return _special == 0 && (_limbs[nrLimbs - 1] >> 63) != 0; }
+
+	// round the accumulated sum to the nearest value of the native type, ties to even
+	Real to_native() const {
+		if (_special) {
+			if ((_special & internal::QUIRE_NAN) || (_special & internal::QUIRE_POS_INF && _special & internal::QUIRE_NEG_INF)) return std::numeric_limits<Real>::quiet_NaN();
+			return (_special & internal::QUIRE_POS_INF) ? std::numeric_limits<Real>::infinity() : -std::numeric_limits<Real>::infinity();
+		}
+		bool negative = (_limbs[nrLimbs - 1] >> 63) != 0;
+		std::array<uint64_t, nrLimbs> magnitude = _limbs;
+		if (negative) sw::unum::internal::limb_negate(magnitude.data(), _limbs.data(), nrLimbs);
+		size_t lz = sw::unum::internal::limb_leading_zeros(magnitude.data(), nrLimbs);
+		if (lz == 64 * nrLimbs) return Real(0);
+		int msb = int(64 * nrLimbs - 1 - lz);
+		// the 64 bits below and including the msb, and the sticky bit of the rest
+		uint64_t window;
+		bool sticky = false;
+		int shift = msb - 63;
+		if (shift >= 0) {
+			size_t w = size_t(shift) / 64, s = size_t(shift) % 64;
+			window = magnitude[w] >> s;
+			if (s) {
+				window |= magnitude[w + 1] << (64 - s);
+				sticky = (magnitude[w] << (64 - s)) != 0;
+			}
+			for (size_t i = 0; i < w && !sticky; ++i) sticky = magnitude[i] != 0;
+		}
+		else {
+			window = magnitude[0] << -shift;
+		}
+		// significant bits of the result: fewer than the precision for subnormal results
+		int scale = msb - int(radix_point);
+		int digits = format::fbits + 1;
+		int kept = scale - (1 - bias - format::fbits) + 1;
+		if (kept > digits) kept = digits;
+		if (kept < 0) return negative ? -Real(0) : Real(0);
+		uint64_t q = (kept == 0) ? 0 : window >> (64 - kept);
+		uint64_t rest = (kept == 0) ? window : window << kept;
+		bool round = (rest >> 63) != 0;
+		bool tail = (rest << 1) != 0 || sticky;
+		if (round && (tail || (q & 1))) ++q;
+		Real v = std::ldexp(Real(q), scale - kept + 1);  // exact, or the overflow to infinity
+		return negative ? -v : v;
+	}
+	explicit operator Real() const { return to_native(); }
+
+private:
+	std::array<uint64_t, nrLimbs> _limbs;  // two's complement, least significant limb first
+	uint8_t                       _special;
+
+	void accumulate(Real v, bool subtract) {
+		bool sign;
+		uint64_t significand = 0;
+		int lsb_scale = 0;
+		uint8_t special = internal::ieee_decompose(v, sign, significand, lsb_scale);
+		if (special) {
+			if (subtract && special != internal::QUIRE_NAN) special ^= (internal::QUIRE_POS_INF | internal::QUIRE_NEG_INF);
+			_special |= special;
+			return;
+		}
+		if (significand) deposit(0, significand, lsb_scale, sign != subtract);
+	}
+	void accumulate(const native_product<Real>& p, bool subtract) {
+		if (p.special) {
+			uint8_t special = p.special;
+			if (subtract && special != internal::QUIRE_NAN) special ^= (internal::QUIRE_POS_INF | internal::QUIRE_NEG_INF);
+			_special |= special;
+			return;
+		}
+		if (p.hi | p.lo) deposit(p.hi, p.lo, p.lsb_scale, p.sign != subtract);
+	}
+	// add, or subtract, the 128-bit significand hi:lo with its lsb at lsb_scale
+	void deposit(uint64_t hi, uint64_t lo, int lsb_scale, bool subtract) {
+		size_t position = size_t(lsb_scale - min_lsb_scale);
+		size_t w = position / 64, s = position % 64;
+		uint64_t word[3];
+		word[0] = lo << s;
+		word[1] = s ? (hi << s) | (lo >> (64 - s)) : hi;
+		word[2] = s ? hi >> (64 - s) : 0;
+		uint64_t* limbs = _limbs.data() + w;
+		size_t remaining = nrLimbs - w - 3;
+		if (subtract) {
+			uint64_t borrow = sw::unum::internal::limb_sub(limbs, limbs, word, 3);
+			for (size_t i = 3; borrow && i < 3 + remaining; ++i) borrow = (limbs[i]-- == 0);
+		}
+		else {
+			uint64_t carry = sw::unum::internal::limb_add(limbs, limbs, word, 3);
+			sw::unum::internal::limb_add_carry(limbs + 3, remaining, carry);
+		}
+	}
+};
+
+}  // namespace ieee
+
+}  // namespace sw
@@ -4,6 +4,7 @@
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -12,6 +13,8 @@
 #include <vector>
 #include <map>
 
+#include <universal/native/limb_arithmetic.hpp>
+#include <universal/native/limb_radix_conversion.hpp>
 #include "./integer_exceptions.hpp"
 
 #if defined(__clang__)
@@ -126,6 +129,30 @@ struct idiv_t {
 	integer<nbits, BlockType> rem;  // remainder
 };
 
+namespace internal {
+
+// pack the bytes of an integer into an array of wider limbs, least significant limb first
+template<typename Limb, size_t nbits, typename BlockType>
+inline void pack_bytes(Limb* limbs, size_t nrLimbs, const integer<nbits, BlockType>& a) {
+	constexpr unsigned nrBytes = integer<nbits, BlockType>::nrBytes;
+	for (size_t i = 0; i < nrLimbs; ++i) limbs[i] = 0;
+	for (unsigned i = 0; i < nrBytes && i / sizeof(Limb) < nrLimbs; ++i) {
+		limbs[i / sizeof(Limb)] |= Limb(a.byte(i)) << ((i % sizeof(Limb)) * 8);
+	}
+}
+
+// unpack an array of limbs into the bytes of an integer, the bits beyond nbits are dropped
+template<typename Limb, size_t nbits, typename BlockType>
+inline void unpack_bytes(integer<nbits, BlockType>& a, const Limb* limbs, size_t nrLimbs) {
+	constexpr unsigned nrBytes = integer<nbits, BlockType>::nrBytes;
+	for (unsigned i = 0; i < nrBytes; ++i) {
+		a.setbyte(i, (i / sizeof(Limb) < nrLimbs) ? uint8_t(limbs[i / sizeof(Limb)] >> ((i % sizeof(Limb)) * 8)) : uint8_t(0));
+	}
+	a.setbyte(nrBytes - 1, a.byte(nrBytes - 1) & integer<nbits, BlockType>::MS_BYTE_MASK);
+}
+
+} // namespace internal
+
 /*
 The rules for detecting overflow in a two's complement sum are simple:
  - If the sum of two positive numbers yields a negative result, the sum has overflowed.
@@ -392,17 +419,13 @@ public:
 		return *this;
 	}
 	integer& operator*=(const integer& rhs) {
-		integer<nbits, BlockType> base(*this);
-		integer<nbits, BlockType> multiplicant(rhs);
-		clear();
-		for (unsigned i = 0; i < nbits; ++i) {
-			if (base.at(i)) {
-				operator+=(multiplicant);
-			}
-			multiplicant <<= 1;
-		}
-		// since we used operator+=, which enforces the nulling of leading bits
-		// we don't need to null here
+		// pack the bytes into 64-bit limbs and use the truncated limb multiply
+		constexpr size_t nrLimbs = 1 + ((nbits - 1) / 64);
+		uint64_t a[nrLimbs], b[nrLimbs], r[nrLimbs];
+		internal::pack_bytes(a, nrLimbs, *this);
+		internal::pack_bytes(b, nrLimbs, rhs);
+		internal::limb_multiply_low(r, a, b, nrLimbs);
+		internal::unpack_bytes(*this, r, nrLimbs);
 		return *this;
 	}
 	integer& operator/=(const integer& rhs) {
@@ -924,30 +947,50 @@ inline integer<nbits, BlockType> twos_complement(const integer<nbits, BlockType>
 	return complement;
 }
 
+// maximum number of characters of the decimal representation of an integer<nbits>, including the sign
+template<size_t nbits, typename BlockType = uint8_t>
+constexpr size_t max_decimal_chars() {
+	return internal::limb_decimal_digits(nbits) + 1;
+}
+
+// write the decimal representation of an integer into [first, last), without a terminating null
+// returns the end of the characters written, or nullptr when the buffer is too small
+template<size_t nbits, typename BlockType>
+inline char* to_decimal_chars(char* first, char* last, const integer<nbits, BlockType>& value) {
+	constexpr size_t nrLimbs = (nbits + 63) / 64;
+	uint64_t limbs[nrLimbs];
+	internal::pack_bytes(limbs, nrLimbs, value);
+	if (value.sign()) {
+		if (first == last) return nullptr;
+		*first++ = '-';
+		internal::limb_negate(limbs, limbs, nrLimbs);
+		if (nbits % 64) limbs[nrLimbs - 1] &= (uint64_t(1) << (nbits % 64)) - 1;
+	}
+	return internal::limb_to_decimal<nrLimbs>(first, last, limbs);
+}
+
+// parse an optionally signed decimal integer at the start of [first, last), modulo 2^nbits
+// returns the end of the characters consumed, or first when there are no digits
+template<size_t nbits, typename BlockType>
+inline const char* from_decimal_chars(const char* first, const char* last, integer<nbits, BlockType>& value) {
+	constexpr size_t nrLimbs = (nbits + 63) / 64;
+	const char* p = first;
+	bool negative = false;
+	if (p != last && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+	if (p == last || *p < '0' || *p > '9') return first;
+	uint64_t limbs[nrLimbs];
+	bool overflow;
+	p = internal::limb_from_decimal<nrLimbs>(limbs, p, last, overflow);
+	if (negative) internal::limb_negate(limbs, limbs, nrLimbs);
+	internal::unpack_bytes(value, limbs, nrLimbs);
+	return p;
+}
+
 // convert integer to decimal string
 template<size_t nbits, typename BlockType>
 std::string convert_to_decimal_string(const integer<nbits, BlockType>& value) {
-	if (value.iszero()) {
-		return std::string("0");
-	}
-	integer<nbits, BlockType> number = value.sign() ? twos_complement(value) : value;
-	impl::decimal partial, multiplier;
-	partial.push_back(0); partial.sign = false;
-	multiplier.push_back(1); multiplier.sign = false;
-	// convert integer to decimal by adding and doubling multipliers
-	for (unsigned i = 0; i < nbits; ++i) {
-		if (number.at(i)) {
-			impl::add(partial, multiplier);
-			// std::cout << partial << std::endl;
-		}
-		impl::add(multiplier, multiplier);
-	}
-	std::stringstream ss;
-	if (value.sign()) ss << '-';
-	for (impl::decimal::const_reverse_iterator rit = partial.rbegin(); rit != partial.rend(); ++rit) {
-		ss << (int)*rit;
-	}
-	return ss.str();
+	char buffer[max_decimal_chars<nbits, BlockType>()];
+	return std::string(buffer, to_decimal_chars(buffer, buffer + sizeof(buffer), value));
 }
 
 // findMsb takes an integer<nbits, BlockType> reference and returns the position of the most significant bit, -1 if v == 0
@@ -1019,25 +1062,15 @@ idiv_t<nbits, BlockType> idiv(const integer<nbits, BlockType>& _a, const integer
 		divresult.rem = _a; // a % b = a when a / b = 0
 		return divresult; // a / b = 0 when b > a
 	}
-	// initialize the long division
-	integer<nbits + 1, BlockType> accumulator = a;
-	// prepare the subtractand
-	integer<nbits + 1, BlockType> subtractand = b;
-	int msb_b = findMsb(b);
-	int msb_a = findMsb(a);
-	int shift = msb_a - msb_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			accumulator -= subtractand;
-			divresult.quot.set(i);
-		}
-		else {
-			divresult.quot.reset(i);
-		}
-		subtractand >>= 1;
-	}
+	// Knuth Algorithm D on 32-bit digits
+	constexpr size_t nrDigits = 1 + (nbits / 32); // digits to hold nbits + 1 bits
+	uint32_t u[nrDigits], v[nrDigits], q[nrDigits], r[nrDigits];
+	internal::pack_bytes(u, nrDigits, a);
+	internal::pack_bytes(v, nrDigits, b);
+	internal::limb_divide(q, r, u, nrDigits, v, nrDigits);
+	internal::unpack_bytes(divresult.quot, q, nrDigits);
+	integer<nbits + 1, BlockType> accumulator;
+	internal::unpack_bytes(accumulator, r, nrDigits);
 	if (result_negative) {  // take 2's complement
 		divresult.quot.flip();
 		divresult.quot += 1;
@@ -1166,22 +1199,10 @@ bool parse(const std::string& number, integer<nbits, BlockType>& value) {
 	}
 	else if (std::regex_match(number, decimal_regex)) {
 		//std::cout << "found a decimal integer representation\n";
-		integer<nbits, BlockType> scale = 1;
-		for (std::string::const_reverse_iterator r = number.rbegin();
-			r != number.rend();
-			++r) {
-			if (*r == '-') {
-				value = -value;
-			}
-			else if (*r == '+') {
-				break;
-			}
-			else {
-				integer<nbits, BlockType> digit = charLookup.at(*r);
-				value += scale * digit;
-				scale *= 10;
-			}
-		}
+		// the signs apply right to left, up to the first '+'
+		size_t digits = number.find_first_not_of("+-");
+		from_decimal_chars(number.data() + digits, number.data() + number.size(), value);
+		for (size_t i = digits; i-- > 0 && number[i] == '-'; ) value = -value;
 		bSuccess = true;
 	}
 
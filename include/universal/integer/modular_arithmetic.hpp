@@ -0,0 +1,404 @@
+#pragma once
+// modular_arithmetic.hpp: modular multiplication, exponentiation, and inversion with a fixed modulus
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <universal/native/limb_arithmetic.hpp>
+#include "./integer_exceptions.hpp"
+
+// the number of exponentiations that the batch mode interleaves
+#if !defined(INTEGER_MODULAR_BATCH_LANES)
+#define INTEGER_MODULAR_BATCH_LANES 4
+#endif
+
+#if defined(__clang__)
+/* Clang/LLVM. ---------------------------------------------- */
+
+
+#elif defined(__ICC) || defined(__INTEL_COMPILER)
+/* Intel ICC/ICPC. ------------------------------------------ */
+
+
+#elif defined(__GNUC__) || defined(__GNUG__)
+/* GNU GCC/G++. --------------------------------------------- */
+
+
+#elif defined(__HP_cc) || defined(__HP_aCC)
+/* Hewlett-Packard C/aC++. ---------------------------------- */
+
+#elif defined(__IBMC__) || defined(__IBMCPP__)
+/* IBM XL C/C++. -------------------------------------------- */
+
+#elif defined(_MSC_VER)
+/* Microsoft Visual Studio. --------------------------------- */
+
+
+#elif defined(__PGI)
+/* Portland Group PGCC/PGCPP. ------------------------------- */
+
+#elif defined(__SUNPRO_C) || defined(__SUNPRO_CC)
+/* Oracle Solaris Studio. ----------------------------------- */
+
+#endif
+
+namespace sw {
+namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// modular arithmetic
+///
+/// A modular_context precomputes the constants of a modulus m once, so that the products
+/// modulo m need no division. The residues are arrays of the 64-bit limbs of the significant
+/// limbs k of m. An odd modulus uses Montgomery's representation a R mod m, R = 2^(64k),
+/// whose products are reduced by interleaving the multiplication with the reduction (CIOS);
+/// an even modulus keeps its residues as they are and reduces products by Barrett's method
+/// with mu = floor(2^(128k) / m).
+
+namespace internal {
+
+// a * b + c + d, which can't overflow 128 bits: returns the lower limb, and the upper limb in hi
+inline uint64_t limb_mul_add(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t& hi) {
+	uint64_t lo = limb_mul(a, b, hi);
+	lo += c;
+	hi += (lo < c);
+	lo += d;
+	hi += (lo < d);
+	return lo;
+}
+
+// the remainder of 2^e by a modulus of k limbs, by Knuth's Algorithm D on 32-bit digits
+inline void limb_power_of_two_mod(uint64_t* r, size_t e, const uint64_t* m, size_t k) {
+	size_t nu = e / 32 + 1;
+	std::vector<uint32_t> u(nu, 0), v(2 * k), q(nu), rem(2 * k);
+	u[e / 32] = uint32_t(1) << (e % 32);
+	for (size_t i = 0; i < k; ++i) {
+		v[2 * i] = uint32_t(m[i]);
+		v[2 * i + 1] = uint32_t(m[i] >> 32);
+	}
+	limb_divide(q.data(), rem.data(), u.data(), nu, v.data(), 2 * k);
+	for (size_t i = 0; i < k; ++i) r[i] = uint64_t(rem[2 * i]) | (uint64_t(rem[2 * i + 1]) << 32);
+}
+
+} // namespace internal
+
+template<typename IntegerType> class modular_context;
+
+// arithmetic modulo a positive m that fits integer<nbits, BlockType>
+template<size_t nbits, typename BlockType>
+class modular_context< integer<nbits, BlockType> > {
+public:
+	using Integer = integer<nbits, BlockType>;
+	static constexpr size_t nrLimbs = 1 + (nbits - 1) / 64;
+	using residue = std::array<uint64_t, nrLimbs>;
+
+	explicit modular_context(const Integer& modulus) : m(modulus), n{}, k(1), montgomery(true), ninv(0), r1{}, r2{}, mu{} {
+		if (m.sign()) m = -m;
+		if (m.iszero()) {
+#if INTEGER_THROW_ARITHMETIC_EXCEPTION
+			throw integer_divide_by_zero{};
+#else
+			std::cerr << "integer_divide_by_zero\n";
+			m = 1;
+#endif
+		}
+		internal::pack_bytes(n.data(), nrLimbs, m);
+		k = std::max<size_t>(1, internal::limb_significant(n.data(), nrLimbs));
+		montgomery = (n[0] & 1) != 0;
+		if (montgomery) {
+			// Newton's iteration doubles the number of correct bits of 1/n[0] mod 2^64, and n[0] is its own inverse mod 8
+			uint64_t inv = n[0];
+			for (int i = 0; i < 5; ++i) inv *= 2 - n[0] * inv;
+			ninv = 0 - inv;
+			internal::limb_power_of_two_mod(r1.data(), 64 * k, n.data(), k);
+			internal::limb_power_of_two_mod(r2.data(), 128 * k, n.data(), k);
+		}
+		else {
+			// mu = floor(2^(128k) / m) has at most k + 1 limbs
+			size_t nu = 4 * k + 1;
+			std::vector<uint32_t> u(nu, 0), v(2 * k), q(nu), rem(2 * k);
+			u[4 * k] = 1;
+			for (size_t i = 0; i < k; ++i) {
+				v[2 * i] = uint32_t(n[i]);
+				v[2 * i + 1] = uint32_t(n[i] >> 32);
+			}
+			internal::limb_divide(q.data(), rem.data(), u.data(), nu, v.data(), 2 * k);
+			for (size_t i = 0; i <= k; ++i) mu[i] = uint64_t(q[2 * i]) | (uint64_t(q[2 * i + 1]) << 32);
+			r1[0] = (k == 1 && n[0] == 1) ? 0 : 1;
+		}
+	}
+
+	const Integer& modulus() const { return m; }
+	bool isMontgomery() const { return montgomery; }
+
+	// residues
+	residue zero() const { return residue{}; }
+	residue one() const { return r1; }
+	residue to_residue(const Integer& a) const {
+		Integer v(a);
+		residue r{};
+		if (v.sign() || v >= m) {
+			v = v % m;
+			if (v.sign()) v += m;
+		}
+		internal::pack_bytes(r.data(), nrLimbs, v);
+		return montgomery ? mul(r, r2) : r;
+	}
+	Integer to_integer(const residue& a) const {
+		residue r(a);
+		if (montgomery) {
+			residue unity{};
+			unity[0] = 1;
+			r = mul(a, unity);
+		}
+		Integer v;
+		internal::unpack_bytes(v, r.data(), nrLimbs);
+		return v;
+	}
+	bool iszero(const residue& a) const { return internal::limb_is_zero(a.data(), k); }
+
+	residue add(const residue& a, const residue& b) const {
+		residue r{};
+		uint64_t carry = internal::limb_add(r.data(), a.data(), b.data(), k);
+		if (carry || internal::limb_compare(r.data(), n.data(), k) >= 0) internal::limb_sub(r.data(), r.data(), n.data(), k);
+		return r;
+	}
+	residue sub(const residue& a, const residue& b) const {
+		residue r{};
+		if (internal::limb_sub(r.data(), a.data(), b.data(), k)) internal::limb_add(r.data(), r.data(), n.data(), k);
+		return r;
+	}
+	// a / 2 for an odd modulus
+	residue half(const residue& a) const {
+		residue r(a);
+		uint64_t carry = 0;
+		if (r[0] & 1) carry = internal::limb_add(r.data(), r.data(), n.data(), k);
+		internal::limb_shift_right(r.data(), r.data(), k, 1);
+		r[k - 1] |= carry << 63;
+		return r;
+	}
+	residue mul(const residue& a, const residue& b) const {
+		residue r{};
+		if (montgomery) montgomery_multiply(r.data(), a.data(), b.data());
+		else barrett_multiply(r.data(), a.data(), b.data());
+		return r;
+	}
+
+	// (a * b) mod m
+	Integer mulmod(const Integer& a, const Integer& b) const {
+		residue x = reduced(a), y = reduced(b);
+		residue r = mul(x, y);
+		// the Montgomery product of the plain values is a b / R: one more with R^2 restores a b
+		if (montgomery) r = mul(r, r2);
+		Integer v;
+		internal::unpack_bytes(v, r.data(), nrLimbs);
+		return v;
+	}
+
+	// base^exponent mod m by sliding windows of the exponent bits, a negative exponent raises the inverse
+	Integer powmod(const Integer& base, const Integer& exponent) const {
+		if (exponent.sign()) return powmod(invmod(base), -exponent);
+		return to_integer(power(to_residue(base), exponent));
+	}
+	residue power(const residue& base, const Integer& exponent) const {
+		int msb = findMsb(exponent);
+		if (msb < 0) return r1;
+		unsigned w = window_width(msb + 1);
+		// the odd powers base^1, base^3, ..., base^(2^w - 1)
+		std::vector<residue> odd(size_t(1) << (w - 1));
+		odd[0] = base;
+		residue square = mul(base, base);
+		for (size_t i = 1; i < odd.size(); ++i) odd[i] = mul(odd[i - 1], square);
+		residue r = r1;
+		bool bStarted = false;
+		for (int i = msb; i >= 0; ) {
+			if (!exponent.at(unsigned(i))) {
+				if (bStarted) r = mul(r, r);
+				--i;
+				continue;
+			}
+			// the longest window of at most w bits that ends in a set bit
+			int l = std::max(i - int(w) + 1, 0);
+			while (!exponent.at(unsigned(l))) ++l;
+			size_t value = 0;
+			for (int j = i; j >= l; --j) value = (value << 1) | (exponent.at(unsigned(j)) ? 1 : 0);
+			if (bStarted) {
+				for (int j = i; j >= l; --j) r = mul(r, r);
+				r = mul(r, odd[value >> 1]);
+			}
+			else {
+				r = odd[value >> 1];
+				bStarted = true;
+			}
+			i = l - 1;
+		}
+		return r;
+	}
+
+	// the inverse of a modulo m by the extended Euclidean algorithm, 0 when gcd(a, m) != 1
+	Integer invmod(const Integer& a) const {
+		Integer g0(m), g1(a % m), s0(0), s1(1);
+		if (g1.sign()) g1 += m;
+		while (!g1.iszero()) {
+			Integer q = g0 / g1;
+			Integer g2 = g0 - q * g1;
+			g0 = g1;
+			g1 = g2;
+			Integer s2 = s0 - q * s1;
+			s0 = s1;
+			s1 = s2;
+		}
+		if (!g0.isone()) return Integer(0);
+		if (s0.sign()) s0 += m;
+		return s0;
+	}
+
+	// bases[i]^exponents[i] mod m for many independent exponentiations: the lanes of a batch step through
+	// their fixed windows together, so that the independent products overlap and share the modulus in cache
+	void powmod(const std::vector<Integer>& bases, const std::vector<Integer>& exponents, std::vector<Integer>& results) const {
+		constexpr size_t L = INTEGER_MODULAR_BATCH_LANES;
+		constexpr unsigned w = 4;
+		constexpr size_t T = size_t(1) << w;
+		size_t count = std::min(bases.size(), exponents.size());
+		results.resize(count);
+		std::vector<residue> table(L * T);  // the powers 0..T-1 of the bases of a batch, lane by lane
+		for (size_t first = 0; first < count; first += L) {
+			size_t lanes = std::min(L, count - first);
+			residue r[L];
+			int msb = -1;
+			for (size_t j = 0; j < lanes; ++j) {
+				const Integer& e = exponents[first + j];
+				if (e.sign()) {
+					// a negative exponent takes the slow lane
+					results[first + j] = powmod(bases[first + j], e);
+					continue;
+				}
+				msb = std::max(msb, findMsb(e));
+				residue* t = &table[j * T];
+				t[0] = r1;
+				t[1] = to_residue(bases[first + j]);
+				for (size_t i = 2; i < T; ++i) t[i] = mul(t[i - 1], t[1]);
+				r[j] = r1;
+			}
+			int windows = (msb + int(w)) / int(w);
+			for (int win = windows - 1; win >= 0; --win) {
+				if (win != windows - 1) {
+					for (unsigned s = 0; s < w; ++s) {
+						for (size_t j = 0; j < lanes; ++j) r[j] = mul(r[j], r[j]);
+					}
+				}
+				for (size_t j = 0; j < lanes; ++j) {
+					const Integer& e = exponents[first + j];
+					if (e.sign()) continue;
+					size_t value = 0;
+					for (int b = int(w) - 1; b >= 0; --b) {
+						unsigned bit = unsigned(win) * w + unsigned(b);
+						value = (value << 1) | ((bit < nbits && e.at(bit)) ? 1 : 0);
+					}
+					if (value) r[j] = mul(r[j], table[j * T + value]);
+				}
+			}
+			for (size_t j = 0; j < lanes; ++j) {
+				if (!exponents[first + j].sign()) results[first + j] = to_integer(r[j]);
+			}
+		}
+	}
+	// many bases raised to the same exponent
+	void powmod(const std::vector<Integer>& bases, const Integer& exponent, std::vector<Integer>& results) const {
+		powmod(bases, std::vector<Integer>(bases.size(), exponent), results);
+	}
+
+private:
+	Integer m;
+	residue n;       // the limbs of the modulus
+	size_t k;        // its significant limbs
+	bool montgomery;
+	uint64_t ninv;   // -1/n mod 2^64
+	residue r1;      // the residue of 1: R mod m for Montgomery
+	residue r2;      // R^2 mod m
+	std::array<uint64_t, nrLimbs + 1> mu;  // Barrett's floor(2^(128k) / m)
+
+	// the plain value of a mod m
+	residue reduced(const Integer& a) const {
+		Integer v(a);
+		if (v.sign() || v >= m) {
+			v = v % m;
+			if (v.sign()) v += m;
+		}
+		residue r{};
+		internal::pack_bytes(r.data(), nrLimbs, v);
+		return r;
+	}
+
+	// the sliding window width that minimizes the multiplications of an exponent of a number of bits
+	static unsigned window_width(int bits) {
+		if (bits > 768) return 6;
+		if (bits > 240) return 5;
+		if (bits > 80) return 4;
+		if (bits > 24) return 3;
+		return bits > 6 ? 2 : 1;
+	}
+
+	// r = a b / R mod m by coarsely integrated operand scanning, for a, b < m
+	void montgomery_multiply(uint64_t* r, const uint64_t* a, const uint64_t* b) const {
+		uint64_t t[nrLimbs + 2] = { 0 };
+		for (size_t i = 0; i < k; ++i) {
+			uint64_t carry = 0;
+			for (size_t j = 0; j < k; ++j) t[j] = internal::limb_mul_add(a[j], b[i], t[j], carry, carry);
+			uint64_t s = t[k] + carry;
+			t[k + 1] = (s < carry);
+			t[k] = s;
+			// add the multiple of n that clears the lowest limb, and shift it out
+			uint64_t q = t[0] * ninv;
+			internal::limb_mul_add(q, n[0], t[0], 0, carry);
+			for (size_t j = 1; j < k; ++j) t[j - 1] = internal::limb_mul_add(q, n[j], t[j], carry, carry);
+			s = t[k] + carry;
+			t[k - 1] = s;
+			t[k] = t[k + 1] + (s < carry);
+		}
+		// t < 2m
+		if (t[k] != 0 || internal::limb_compare(t, n.data(), k) >= 0) internal::limb_sub(t, t, n.data(), k);
+		for (size_t i = 0; i < nrLimbs; ++i) r[i] = (i < k) ? t[i] : 0;
+	}
+
+	// r = a b mod m by Barrett's reduction, for a, b < m
+	void barrett_multiply(uint64_t* r, const uint64_t* a, const uint64_t* b) const {
+		uint64_t x[2 * nrLimbs] = { 0 }, q[2 * nrLimbs + 2] = { 0 }, qm[2 * nrLimbs + 1] = { 0 }, t[nrLimbs + 1];
+		// k is in [1, nrLimbs]: the bound lets the compiler prove the products fit the buffers
+		const size_t kl = (k > 0 && k <= nrLimbs) ? k : nrLimbs;
+		internal::limb_multiply(x, a, kl, b, kl);
+		// q = floor(floor(x / 2^(64(k-1))) mu / 2^(64(k+1))) underestimates x / m by at most 2
+		internal::limb_multiply(q, x + kl - 1, kl + 1, mu.data(), kl + 1);
+		internal::limb_multiply(qm, q + kl + 1, kl + 1, n.data(), kl);
+		internal::limb_sub(t, x, qm, kl + 1);
+		uint64_t mk[nrLimbs + 1] = { 0 };
+		for (size_t i = 0; i < kl; ++i) mk[i] = n[i];
+		while (internal::limb_compare(t, mk, kl + 1) >= 0) internal::limb_sub(t, t, mk, kl + 1);
+		for (size_t i = 0; i < nrLimbs; ++i) r[i] = (i < kl) ? t[i] : 0;
+	}
+};
+
+// (a * b) mod m
+template<size_t nbits, typename BlockType>
+integer<nbits, BlockType> mulmod(const integer<nbits, BlockType>& a, const integer<nbits, BlockType>& b, const integer<nbits, BlockType>& m) {
+	return modular_context< integer<nbits, BlockType> >(m).mulmod(a, b);
+}
+
+// base^exponent mod m
+template<size_t nbits, typename BlockType>
+integer<nbits, BlockType> powmod(const integer<nbits, BlockType>& base, const integer<nbits, BlockType>& exponent, const integer<nbits, BlockType>& m) {
+	return modular_context< integer<nbits, BlockType> >(m).powmod(base, exponent);
+}
+
+// the inverse of a modulo m, 0 when a is not invertible
+template<size_t nbits, typename BlockType>
+integer<nbits, BlockType> invmod(const integer<nbits, BlockType>& a, const integer<nbits, BlockType>& m) {
+	return modular_context< integer<nbits, BlockType> >(m).invmod(a);
+}
+
+} // namespace unum
+} // namespace sw
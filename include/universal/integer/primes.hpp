@@ -5,7 +5,10 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <vector>
+#include <algorithm>
 #include "./integer_exceptions.hpp"
+#include "./modular_arithmetic.hpp"
+#include "./sieves.hpp"
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -148,50 +151,429 @@ integer<nbits, BlockType> lcm(const std::vector< integer<nbits, BlockType> >& v)
 	return lcm;
 }
 
-// check if a number is prime
+namespace internal {
+
+// the odd primes below 1024 that trial division removes before the probabilistic tests
+inline const std::vector<uint32_t>& small_primes() {
+	static const std::vector<uint32_t> primes = sieving_primes(1024);
+	return primes;
+}
+
+// Montgomery arithmetic modulo an odd n < 2^64: the residue of a is a R mod n, R = 2^64
+class montgomery64 {
+public:
+	using residue = uint64_t;
+	using natural = uint64_t;
+	explicit montgomery64(uint64_t n) : n(n), halfn(n >> 1) {
+		// Newton's iteration doubles the number of correct bits of 1/n mod R, and n is its own inverse mod 8
+		uint64_t inv = n;
+		for (int i = 0; i < 5; ++i) inv *= 2 - n * inv;
+		ninv = 0 - inv;
+		r1 = (0 - n) % n;
+		r2 = r1;
+		for (int i = 0; i < 64; ++i) r2 = add(r2, r2);
+	}
+	uint64_t modulus() const { return n; }
+	residue zero() const { return 0; }
+	residue one() const { return r1; }
+	residue convert(uint64_t a) const { return mul(a % n, r2); }
+	uint64_t value(residue a) const { return reduce(0, a); }
+	residue add(residue a, residue b) const {
+		uint64_t s = a + b;
+		return (s < a || s >= n) ? s - n : s;
+	}
+	residue sub(residue a, residue b) const { return a >= b ? a - b : a - b + n; }
+	residue half(residue a) const { return (a & 1) ? (a >> 1) + halfn + 1 : a >> 1; }
+	residue mul(residue a, residue b) const {
+		uint64_t hi;
+		uint64_t lo = limb_mul(a, b, hi);
+		return reduce(hi, lo);
+	}
+	bool iszero(residue a) const { return a == 0; }
+	// gcd(a, n) of the value of a residue, which R does not change as n is odd
+	uint64_t gcd(residue a) const {
+		uint64_t u = a, v = n;
+		if (u == 0) return v;
+		u >>= limb_ctz(u);
+		while (u != v) {
+			if (u > v) std::swap(u, v);
+			v -= u;
+			v >>= limb_ctz(v);
+		}
+		return u;
+	}
+
+private:
+	uint64_t n, halfn, ninv, r1, r2;
+
+	// (hi:lo + m n) / R with m = lo (-1/n) mod R, which clears the low limb, for hi:lo < n R
+	residue reduce(uint64_t hi, uint64_t lo) const {
+		uint64_t mhi;
+		limb_mul(lo * ninv, n, mhi);
+		uint64_t t = hi + mhi;
+		bool overflow = t < hi;
+		if (lo != 0) overflow |= (++t == 0);  // the carry out of lo + m n mod R
+		return (overflow || t >= n) ? t - n : t;
+	}
+};
+
+// the residues of a modular_context with the conversions and gcd of the primality tests and factorizations
 template<size_t nbits, typename BlockType>
-bool isPrime(const integer<nbits, BlockType>& a) {
-	if (a.iszero() || a == 1) return false; // smallest prime number is 2
-	for (integer<nbits, BlockType> i = 2; i < a / 2; ++i) if ((a % i) == 0) return false;
+class integer_residues : public modular_context< integer<nbits, BlockType> > {
+public:
+	using Integer = integer<nbits, BlockType>;
+	using Context = modular_context<Integer>;
+	using natural = Integer;
+	explicit integer_residues(const Integer& n) : Context(n) {}
+	typename Context::residue convert(uint64_t a) const { return this->to_residue(Integer((unsigned long long)a)); }
+	typename Context::residue convert(const Integer& a) const { return this->to_residue(a); }
+	// gcd(a, n) of the value of a residue, which R does not change as n is odd
+	Integer gcd(const typename Context::residue& a) const {
+		Integer v;
+		unpack_bytes(v, a.data(), Context::nrLimbs);
+		return sw::unum::gcd(v, this->modulus());
+	}
+};
+
+// the bits of the exponents of the modular powers
+inline int exponent_msb(uint64_t e) { return e == 0 ? -1 : 63 - int(limb_clz(e)); }
+inline bool exponent_bit(uint64_t e, int i) { return (e >> i) & 1; }
+template<size_t nbits, typename BlockType>
+inline int exponent_msb(const integer<nbits, BlockType>& e) { return findMsb(e); }
+template<size_t nbits, typename BlockType>
+inline bool exponent_bit(const integer<nbits, BlockType>& e, int i) { return e.at(unsigned(i)); }
+
+// the remainder of a natural number by a small divisor
+inline uint32_t natural_remainder(uint64_t n, uint32_t d) { return uint32_t(n % d); }
+template<size_t nbits, typename BlockType>
+inline uint32_t natural_remainder(const integer<nbits, BlockType>& n, uint32_t d) {
+	std::vector<uint32_t> digits(1 + (nbits - 1) / 32);
+	pack_bytes(digits.data(), digits.size(), n);
+	return limb_remainder_small(digits, d);
+}
+
+// the odd part d of v = d 2^s
+inline uint64_t odd_part(uint64_t v, unsigned& s) {
+	s = limb_ctz(v);
+	return v >> s;
+}
+template<size_t nbits, typename BlockType>
+inline integer<nbits, BlockType> odd_part(integer<nbits, BlockType> v, unsigned& s) {
+	s = 0;
+	while (!v.at(s)) ++s;
+	v >>= int(s);
+	return v;
+}
+
+inline bool natural_is_square(uint64_t n) {
+	uint64_t r = uint64_t(std::sqrt(double(n)));
+	while (r * r > n) --r;
+	while ((r + 1) * (r + 1) <= n && r < 0xFFFFFFFFull) ++r;
+	return r * r == n;
+}
+template<size_t nbits, typename BlockType>
+inline bool natural_is_square(const integer<nbits, BlockType>& n) { return perfect_square(n); }
+
+// the residue of a signed small number
+template<typename Modular>
+typename Modular::residue signed_residue(const Modular& M, int64_t v) {
+	return v < 0 ? M.sub(M.zero(), M.convert(uint64_t(-v))) : M.convert(uint64_t(v));
+}
+
+// the Jacobi symbol (a/m) for an odd m
+inline int jacobi_small(uint64_t a, uint64_t m) {
+	int j = 1;
+	a %= m;
+	while (a != 0) {
+		while ((a & 1) == 0) {
+			a >>= 1;
+			if ((m & 7) == 3 || (m & 7) == 5) j = -j;
+		}
+		std::swap(a, m);
+		if ((a & 3) == 3 && (m & 3) == 3) j = -j;
+		a %= m;
+	}
+	return m == 1 ? j : 0;
+}
+
+// base^e by left to right binary exponentiation
+template<typename Modular, typename Exponent>
+typename Modular::residue modular_power(const Modular& M, const typename Modular::residue& base, const Exponent& e) {
+	int msb = exponent_msb(e);
+	if (msb < 0) return M.one();
+	typename Modular::residue r = base;
+	for (int i = msb - 1; i >= 0; --i) {
+		r = M.mul(r, r);
+		if (exponent_bit(e, i)) r = M.mul(r, base);
+	}
+	return r;
+}
+
+// the strong probable prime test to base a of n - 1 = d 2^s
+template<typename Modular, typename Exponent>
+bool strong_probable_prime(const Modular& M, const typename Modular::residue& a, const Exponent& d, unsigned s) {
+	typename Modular::residue minusOne = M.sub(M.zero(), M.one());
+	typename Modular::residue x = modular_power(M, a, d);
+	if (x == M.one() || x == minusOne) return true;
+	for (unsigned r = 1; r < s; ++r) {
+		x = M.mul(x, x);
+		if (x == minusOne) return true;
+		if (x == M.one()) return false;
+	}
+	return false;
+}
+
+// the strong Lucas probable prime test with Selfridge's parameters P = 1, Q = (1 - D)/4,
+// D the first of 5, -7, 9, -11, ... with (D/n) = -1, for an odd n that has no factor below 1024
+template<typename Modular, typename Natural>
+bool strong_lucas_probable_prime(const Modular& M, const Natural& n) {
+	using residue = typename Modular::residue;
+	uint32_t n4 = natural_remainder(n, 4);
+	int64_t D = 5;
+	for (int k = 0; ; ++k) {
+		uint32_t a = uint32_t(D < 0 ? -D : D);
+		// (D/n) = (-1/n) (|D|/n), and (|D|/n) = (n/|D|) by reciprocity, negated when both are 3 mod 4
+		int j = jacobi_small(natural_remainder(n, a), a);
+		if (D < 0 && n4 == 3) j = -j;
+		if ((a & 3) == 3 && n4 == 3) j = -j;
+		if (j == -1) break;
+		if (j == 0 && natural_remainder(n, a) == 0) return false;
+		// a D never shows up for a square
+		if (k == 20 && natural_is_square(n)) return false;
+		D = D > 0 ? -(D + 2) : -D + 2;
+	}
+	residue Dr = signed_residue(M, D), Qr = signed_residue(M, (1 - D) / 4);
+	unsigned s;
+	Natural d = odd_part(n + Natural(1), s);
+	// U_1 = 1, V_1 = P = 1, and the doubling and increment formulas of the Lucas sequences
+	residue U = M.one(), V = M.one(), Qk = Qr;
+	for (int i = exponent_msb(d) - 1; i >= 0; --i) {
+		U = M.mul(U, V);
+		V = M.sub(M.mul(V, V), M.add(Qk, Qk));
+		Qk = M.mul(Qk, Qk);
+		if (exponent_bit(d, i)) {
+			residue U1 = M.half(M.add(U, V));
+			V = M.half(M.add(M.mul(Dr, U), V));
+			U = U1;
+			Qk = M.mul(Qk, Qr);
+		}
+	}
+	if (M.iszero(U) || M.iszero(V)) return true;
+	for (unsigned r = 1; r < s; ++r) {
+		V = M.sub(M.mul(V, V), M.add(Qk, Qk));
+		if (M.iszero(V)) return true;
+		Qk = M.mul(Qk, Qk);
+	}
+	return false;
+}
+
+// Baillie-PSW: a strong probable prime to base 2 that is also a strong Lucas probable prime
+template<typename Modular, typename Natural>
+bool bpsw_probable_prime(const Modular& M, const Natural& n) {
+	unsigned s;
+	Natural d = odd_part(n - Natural(1), s);
+	if (!strong_probable_prime(M, M.convert(2), d, s)) return false;
+	return strong_lucas_probable_prime(M, n);
+}
+
+// 1 when trial division by the small primes proves n prime, 0 when it proves n composite, -1 otherwise
+inline int trial_division(uint64_t n) {
+	if (n < 2) return 0;
+	if ((n & 1) == 0) return n == 2;
+	for (uint32_t p : small_primes()) {
+		if (uint64_t(p) * p > n) return 1;
+		if (n % p == 0) return 0;
+	}
+	return -1;
+}
+
+// primality of n < 2^64: the strong probable prime tests to the seven bases of Jim Sinclair are deterministic
+inline bool is_prime64(uint64_t n) {
+	int verdict = trial_division(n);
+	if (verdict >= 0) return verdict == 1;
+	montgomery64 M(n);
+	unsigned s;
+	uint64_t d = odd_part(n - 1, s);
+	for (uint64_t a : { 2ull, 325ull, 9375ull, 28178ull, 450775ull, 9780504ull, 1795265022ull }) {
+		uint64_t r = M.convert(a);
+		if (M.iszero(r)) continue;  // a multiple of n is no witness
+		if (!strong_probable_prime(M, r, d, s)) return false;
+	}
 	return true;
 }
 
-// generate prime numbers in a range
+// the value of a nonnegative integer that fits 64 bits
+template<size_t nbits, typename BlockType>
+inline uint64_t to_uint64(const integer<nbits, BlockType>& a) {
+	uint64_t limbs[1];
+	pack_bytes(limbs, 1, a);
+	return limbs[0];
+}
+
+// trial division of an integer beyond 64 bits, which can only prove it composite
 template<size_t nbits, typename BlockType>
-bool primeNumbersInRange(const integer<nbits, BlockType>& low, const integer<nbits, BlockType>& high, std::vector< integer<nbits, BlockType> >& primes) {
-	bool bFound = false;
-	for (integer<nbits, BlockType> i = low; i < high; ++i) {
-		if (isPrime(i)) {
-			primes.push_back(i);
-			bFound = true;
+inline bool has_small_factor(const integer<nbits, BlockType>& a) {
+	std::vector<uint32_t> digits(1 + (nbits - 1) / 32);
+	pack_bytes(digits.data(), digits.size(), a);
+	if ((digits[0] & 1) == 0) return true;
+	for (uint32_t p : small_primes()) {
+		if (limb_remainder_small(digits, p) == 0) return true;
+	}
+	return false;
+}
+
+// Brent's variant of Pollard's rho with f(y) = y^2 + c: a factor of n, which is n itself when the walk failed
+// the differences of a batch are multiplied so that a batch costs a single gcd
+template<typename Modular>
+typename Modular::natural pollard_rho_brent(const Modular& M, uint64_t c, uint64_t maxIterations) {
+	using residue = typename Modular::residue;
+	using natural = typename Modular::natural;
+	constexpr uint64_t batch = 128;
+	residue C = M.convert(c), y = M.convert(2), x = y, ys = y, q = M.one();
+	auto f = [&](const residue& v) { return M.add(M.mul(v, v), C); };
+	natural g(1);
+	uint64_t iterations = 0;
+	for (uint64_t r = 1; g == natural(1); r *= 2) {
+		if (iterations > maxIterations) return M.modulus();
+		x = y;
+		for (uint64_t i = 0; i < r; ++i) y = f(y);
+		for (uint64_t k = 0; k < r && g == natural(1); k += batch) {
+			ys = y;
+			uint64_t steps = std::min(batch, r - k);
+			for (uint64_t i = 0; i < steps; ++i) {
+				y = f(y);
+				q = M.mul(q, M.sub(x, y));
+			}
+			g = M.gcd(q);
+			iterations += steps;
 		}
 	}
-	return bFound;
+	if (g == M.modulus()) {
+		// the batch collected all the factors: retrace it one difference at a time
+		do {
+			ys = f(ys);
+			g = M.gcd(M.sub(x, ys));
+		} while (g == natural(1));
+	}
+	return g;
+}
+
+} // namespace internal
+
+// check if a number is prime
+// trial division by the primes below 1024, then the deterministic Miller-Rabin test when the number fits 64 bits,
+// and the Baillie-PSW test, which has no known counterexample, beyond that
+template<size_t nbits, typename BlockType>
+bool isPrime(const integer<nbits, BlockType>& a) {
+	if (a.sign() || a.iszero()) return false;
+	if (findMsb(a) < 64) return internal::is_prime64(internal::to_uint64(a));
+	if (internal::has_small_factor(a)) return false;
+	return internal::bpsw_probable_prime(internal::integer_residues<nbits, BlockType>(a), a);
+}
+
+// the strong probable prime test of an odd n > 2 to a base, the step of the Miller-Rabin test
+template<size_t nbits, typename BlockType>
+bool millerRabin(const integer<nbits, BlockType>& n, const integer<nbits, BlockType>& base) {
+	using Integer = integer<nbits, BlockType>;
+	if (n.sign() || n < Integer(3) || n.iseven()) return n == Integer(2);
+	unsigned s;
+	if (findMsb(n) < 64) {
+		internal::montgomery64 M(internal::to_uint64(n));
+		Integer b = base % n;
+		if (b.sign()) b += n;
+		uint64_t d = internal::odd_part(M.modulus() - 1, s);
+		return internal::strong_probable_prime(M, M.convert(internal::to_uint64(b)), d, s);
+	}
+	internal::integer_residues<nbits, BlockType> M(n);
+	Integer d = internal::odd_part(n - Integer(1), s);
+	return internal::strong_probable_prime(M, M.convert(base), d, s);
+}
+
+// the Baillie-PSW probable prime test
+template<size_t nbits, typename BlockType>
+bool isPrimeBPSW(const integer<nbits, BlockType>& n) {
+	if (n.sign() || n.iszero()) return false;
+	if (findMsb(n) < 64) {
+		uint64_t v = internal::to_uint64(n);
+		int verdict = internal::trial_division(v);
+		if (verdict >= 0) return verdict == 1;
+		return internal::bpsw_probable_prime(internal::montgomery64(v), v);
+	}
+	if (internal::has_small_factor(n)) return false;
+	return internal::bpsw_probable_prime(internal::integer_residues<nbits, BlockType>(n), n);
+}
+
+// a factor of an odd composite n by Brent's variant of Pollard's rho with the polynomial x^2 + c,
+// n itself when the walk failed to split n within maxIterations
+template<size_t nbits, typename BlockType>
+integer<nbits, BlockType> pollardRhoBrent(const integer<nbits, BlockType>& n, unsigned long long c = 1, uint64_t maxIterations = uint64_t(1) << 22) {
+	using Integer = integer<nbits, BlockType>;
+	if (n.iseven()) return Integer(2);
+	if (findMsb(n) < 64) {
+		uint64_t v = internal::to_uint64(n);
+		return Integer((unsigned long long)internal::pollard_rho_brent(internal::montgomery64(v), c, maxIterations));
+	}
+	return internal::pollard_rho_brent(internal::integer_residues<nbits, BlockType>(n), c, maxIterations);
 }
 
 // prime factors of an arbitrary integer
 template<size_t nbits, typename BlockType>
 class primefactors : public std::vector< std::pair< integer<nbits, BlockType>, integer<nbits, BlockType> > > { };
 
-// generate prime factors of an arbitrary integer
+// generate prime factors of an arbitrary integer, in increasing order, of its magnitude
+// the small primes are found by trial division, the larger ones by Pollard's rho, and the quadratic sieve
+// splits what the rho walks could not; a composite that resists both is reported as a factor
 template<size_t nbits, typename BlockType>
 void primeFactorization(const integer<nbits, BlockType>& a, primefactors<nbits, BlockType>& factors) {
 	using Integer = integer<nbits, BlockType>;
 	Integer i(a);
-	Integer factor = 2;
-	Integer power = 0;
-	// powers of 2
-	while (i.iseven()) { ++power; i >>= 1; }
-	if (power > 0) factors.push_back(std::pair<Integer, Integer>(factor, power));
-	// powers of odd numbers > 2
-	for (factor = 3; factor <= sqrt(i); factor += 2) {
-		if (isPrime(factor)) {
-			power = 0;
-			while ((i % factor) == 0) { ++power; i /= factor; }
-			if (power > 0) factors.push_back(std::pair<Integer, Integer>(factor, power));
+	if (i.sign()) i = -i;
+	if (i.iszero()) return;
+	std::vector<Integer> primes;  // with multiplicity
+	// trial division on 32-bit digits
+	constexpr size_t nrDigits = 1 + (nbits - 1) / 32;
+	std::vector<uint32_t> digits(nrDigits);
+	internal::pack_bytes(digits.data(), nrDigits, i);
+	while ((digits[0] & 1) == 0) {
+		internal::limb_divide_small(digits, 2);
+		primes.push_back(Integer(2));
+	}
+	for (uint32_t p : internal::small_primes()) {
+		std::vector<uint32_t> quotient(digits);
+		while (internal::limb_divide_small(quotient, p) == 0) {
+			digits = quotient;
+			primes.push_back(Integer((unsigned long long)p));
+		}
+	}
+	internal::unpack_bytes(i, digits.data(), nrDigits);
+	std::vector<Integer> pending;
+	if (i > Integer(1)) pending.push_back(i);
+	while (!pending.empty()) {
+		Integer n = pending.back();
+		pending.pop_back();
+		if (isPrime(n)) {
+			primes.push_back(n);
+			continue;
+		}
+		Integer d = n;
+		for (unsigned long long c = 1; c <= 4 && (d == n || d.isone()); ++c) d = pollardRhoBrent(n, c, uint64_t(1) << 20);
+		if (d == n || d.isone()) d = quadraticSieve(n);
+		if (d == n || d.isone()) {
+			primes.push_back(n);
+			continue;
+		}
+		pending.push_back(d);
+		pending.push_back(n / d);
+	}
+	std::sort(primes.begin(), primes.end());
+	for (const Integer& p : primes) {
+		if (!factors.empty() && factors.back().first == p) {
+			++factors.back().second;
+		}
+		else {
+			factors.push_back(std::pair<Integer, Integer>(p, Integer(1)));
 		}
 	}
-	if (i > 2) factors.push_back(std::pair < Integer, Integer>(i, 1));
 }
 
 // Factorization using Fermat's method: precondition number must be odd
@@ -4,9 +4,20 @@
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <cstring>
 #include <vector>
+#include <thread>
+#include <algorithm>
+#include <universal/native/limb_arithmetic.hpp>
 #include "./integer_exceptions.hpp"
 
+// the segments of the sieve of Eratosthenes are sized to stay in the L1 data cache
+#if !defined(INTEGER_SIEVE_SEGMENT_BYTES)
+#define INTEGER_SIEVE_SEGMENT_BYTES 32768
+#endif
+
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
 
@@ -40,6 +51,363 @@
 namespace sw {
 namespace unum {
 
+/// //////////////////////////////////////////////////////////////////
+/// sieves
+///
+/// The segmented sieve of Eratosthenes sieves the odd numbers of a range in segments of
+/// INTEGER_SIEVE_SEGMENT_BYTES, one byte per odd number, so that the crossing off stays in
+/// the L1 cache. Every sieving prime remembers its next multiple from one segment to the next.
+/// A range can be split over threads, each of which sieves its own consecutive segments.
+///
+/// The quadratic sieve factors n by collecting x for which Q(x) = (x + m)^2 - n, m = floor(sqrt(n)),
+/// factors completely over a base of small primes p for which n is a quadratic residue.
+/// The candidates are found by sieving the logarithms of the primes over blocks of x on both
+/// sides of 0, and confirmed by trial division. A set of relations whose exponents are all even,
+/// found by Gaussian elimination over GF(2), yields a congruence of squares X^2 = Y^2 mod n,
+/// and gcd(X - Y, n) is a factor of n with probability 1/2 or more.
+
+namespace internal {
+
+// odd primes up to and including limit <= 2^32 by the plain sieve of Eratosthenes
+inline std::vector<uint32_t> sieving_primes(uint64_t limit) {
+	std::vector<uint32_t> primes;
+	if (limit < 3) return primes;
+	std::vector<uint8_t> composite(size_t(limit / 2 + 1), 0);  // composite[i] for 2i+1
+	for (uint64_t i = 1; 2 * i + 1 <= limit; ++i) {
+		if (composite[size_t(i)]) continue;
+		uint64_t p = 2 * i + 1;
+		primes.push_back(uint32_t(p));
+		for (uint64_t j = p * p / 2; 2 * j + 1 <= limit; j += p) composite[size_t(j)] = 1;
+	}
+	return primes;
+}
+
+// visit the odd primes in [low, high) in increasing order, primes must hold the odd primes up to sqrt(high)
+template<typename Visitor>
+void sieve_segments(uint64_t low, uint64_t high, const std::vector<uint32_t>& primes, Visitor&& visit) {
+	constexpr uint64_t S = INTEGER_SIEVE_SEGMENT_BYTES;  // odd numbers per segment
+	if (low < 3) low = 3;
+	low |= 1;  // the first odd number of the range
+	if (low >= high) return;
+	std::vector<uint8_t> segment(static_cast<size_t>(S));
+	// the next odd multiple of every sieving prime
+	std::vector<uint64_t> next(primes.size());
+	for (size_t j = 0; j < primes.size(); ++j) {
+		uint64_t p = primes[j];
+		uint64_t start = std::max(p * p, ((low + p - 1) / p) * p);
+		if ((start & 1) == 0) start += p;
+		next[j] = start;
+	}
+	for (uint64_t segLow = low; segLow < high; segLow += 2 * S) {
+		uint64_t segHigh = std::min(high, segLow + 2 * S);
+		size_t size = size_t((segHigh - segLow + 1) / 2);
+		std::memset(segment.data(), 1, size);
+		for (size_t j = 0; j < primes.size(); ++j) {
+			uint64_t p = primes[j];
+			if (p * p >= segHigh) break;
+			uint64_t k = (next[j] - segLow) / 2;
+			for (; k < size; k += p) segment[size_t(k)] = 0;
+			next[j] = segLow + 2 * k;
+		}
+		for (size_t i = 0; i < size; ++i) {
+			if (segment[i]) visit(segLow + 2 * i);
+		}
+	}
+}
+
+// sieve [low, high) in nrThreads chunks, each visited by its own visitor
+template<typename Visitor>
+void sieve_in_parallel(uint64_t low, uint64_t high, unsigned nrThreads, std::vector<Visitor>& visitors) {
+	uint64_t limit = uint64_t(std::sqrt(double(high))) + 1;
+	while (limit * limit > high && limit > 1) --limit;
+	std::vector<uint32_t> primes = sieving_primes(limit);
+	// chunks of whole segments
+	constexpr uint64_t span = 2 * INTEGER_SIEVE_SEGMENT_BYTES;
+	uint64_t chunk = ((high - low) / nrThreads / span + 1) * span;
+	std::vector<std::thread> threads;
+	for (unsigned t = 0; t < nrThreads; ++t) {
+		uint64_t lo = low + t * chunk;
+		uint64_t hi = std::min(high, lo + chunk);
+		if (lo >= hi) break;
+		threads.emplace_back([lo, hi, t, &primes, &visitors]() { sieve_segments(lo, hi, primes, visitors[t]); });
+	}
+	for (auto& thread : threads) thread.join();
+}
+
+// a^e mod p for p < 2^32
+inline uint64_t powmod_small(uint64_t a, uint64_t e, uint64_t p) {
+	uint64_t r = 1;
+	a %= p;
+	while (e) {
+		if (e & 1) r = r * a % p;
+		a = a * a % p;
+		e >>= 1;
+	}
+	return r;
+}
+
+// a square root of a quadratic residue a modulo an odd prime p < 2^32 by Tonelli-Shanks
+inline uint64_t sqrtmod_small(uint64_t a, uint64_t p) {
+	a %= p;
+	if (a == 0) return 0;
+	if (p % 4 == 3) return powmod_small(a, (p + 1) / 4, p);
+	// p - 1 = q 2^s
+	uint64_t q = p - 1;
+	unsigned s = 0;
+	while ((q & 1) == 0) { q >>= 1; ++s; }
+	uint64_t z = 2;
+	while (powmod_small(z, (p - 1) / 2, p) != p - 1) ++z;
+	uint64_t c = powmod_small(z, q, p), r = powmod_small(a, (q + 1) / 2, p), t = powmod_small(a, q, p);
+	unsigned m = s;
+	while (t != 1) {
+		unsigned i = 0;
+		for (uint64_t t2 = t; t2 != 1; t2 = t2 * t2 % p) ++i;
+		uint64_t b = c;
+		for (unsigned j = 0; j + i + 1 < m; ++j) b = b * b % p;
+		r = r * b % p;
+		c = b * b % p;
+		t = t * c % p;
+		m = i;
+	}
+	return r;
+}
+
+// remainder of a magnitude of 32-bit digits, least significant first, by d < 2^32
+inline uint32_t limb_remainder_small(const std::vector<uint32_t>& u, uint32_t d) {
+	uint64_t r = 0;
+	for (size_t i = u.size(); i-- > 0; ) r = ((r << 32) | u[i]) % d;
+	return uint32_t(r);
+}
+
+// u = u / d, returns the remainder
+inline uint32_t limb_divide_small(std::vector<uint32_t>& u, uint32_t d) {
+	uint64_t r = 0;
+	for (size_t i = u.size(); i-- > 0; ) {
+		uint64_t t = (r << 32) | u[i];
+		u[i] = uint32_t(t / d);
+		r = t % d;
+	}
+	return uint32_t(r);
+}
+
+} // namespace internal
+
+// the primes in [low, high), sieved in segments by nrThreads threads
+inline std::vector<uint64_t> segmentedSieve(uint64_t low, uint64_t high, unsigned nrThreads = 1) {
+	std::vector<uint64_t> primes;
+	if (low <= 2 && high > 2) primes.push_back(2);
+	if (high <= 3 || low >= high) return primes;
+	if (nrThreads == 0) nrThreads = 1;
+	std::vector< std::vector<uint64_t> > chunks(nrThreads);
+	struct collect {
+		std::vector<uint64_t>* chunk;
+		void operator()(uint64_t p) { chunk->push_back(p); }
+	};
+	std::vector<collect> visitors;
+	for (auto& chunk : chunks) visitors.push_back(collect{ &chunk });
+	internal::sieve_in_parallel(low, high, nrThreads, visitors);
+	for (auto& chunk : chunks) primes.insert(primes.end(), chunk.begin(), chunk.end());
+	return primes;
+}
+
+// the number of primes in [low, high), sieved in segments by nrThreads threads
+inline uint64_t countPrimes(uint64_t low, uint64_t high, unsigned nrThreads = 1) {
+	uint64_t count = (low <= 2 && high > 2) ? 1 : 0;
+	if (high <= 3 || low >= high) return count;
+	if (nrThreads == 0) nrThreads = 1;
+	struct counter {
+		uint64_t count = 0;
+		void operator()(uint64_t) { ++count; }
+	};
+	std::vector<counter> visitors(nrThreads);
+	internal::sieve_in_parallel(low, high, nrThreads, visitors);
+	for (auto& v : visitors) count += v.count;
+	return count;
+}
+
+// generate prime numbers in a range
+template<size_t nbits, typename BlockType>
+bool primeNumbersInRange(const integer<nbits, BlockType>& low, const integer<nbits, BlockType>& high, std::vector< integer<nbits, BlockType> >& primes) {
+	using Integer = integer<nbits, BlockType>;
+	bool bFound = false;
+	if (high <= low || high <= Integer(2)) return false;
+	Integer start = (low < Integer(2) ? Integer(2) : low);
+	if (findMsb(high) < 63) {
+		// the range fits the native sieve
+		uint64_t limbs[1];
+		internal::pack_bytes(limbs, 1, start);
+		uint64_t lo = limbs[0];
+		internal::pack_bytes(limbs, 1, high);
+		for (uint64_t p : segmentedSieve(lo, limbs[0])) {
+			primes.push_back(Integer((unsigned long long)p));
+			bFound = true;
+		}
+		return bFound;
+	}
+	for (Integer i = start; i < high; ++i) {
+		if (isPrime(i)) {
+			primes.push_back(i);
+			bFound = true;
+		}
+	}
+	return bFound;
+}
+
+// a nontrivial factor of n by the quadratic sieve, or 1 when none was found
+// n must be odd, composite, and not a perfect power, and n^2 must be representable in integer<2*nbits>
+// the factor base holds factorBaseSize primes, 0 selects a size for the number of digits of n
+template<size_t nbits, typename BlockType>
+integer<nbits, BlockType> quadraticSieve(const integer<nbits, BlockType>& n, size_t factorBaseSize = 0, bool bTrace = false) {
+	using Integer = integer<nbits, BlockType>;
+	using Wide = integer<2 * nbits, BlockType>;
+	constexpr int64_t S = 65536;  // the sieve block
+	if (n < Integer(4) || n.iseven()) return Integer(n.iseven() ? 2 : 1);
+	Integer m = floor_sqrt(n);
+	if (m * m == n) return m;
+
+	// the factor base: -1, 2, and the odd primes p for which n is a quadratic residue mod p
+	double bits = double(findMsb(n) + 1);
+	double digits = bits * 0.30102999566398;
+	if (factorBaseSize == 0) {
+		// about exp(0.35 sqrt(ln n ln ln n)) primes, tuned for the single polynomial
+		double lnn = bits * 0.69314718055994530942;
+		factorBaseSize = size_t(std::max(40.0, std::exp(0.35 * std::sqrt(lnn * std::log(lnn)))));
+	}
+	constexpr size_t nrDigits = 1 + (nbits - 1) / 32;
+	std::vector<uint32_t> nDigits(nrDigits), mDigits(nrDigits);
+	internal::pack_bytes(nDigits.data(), nrDigits, n);
+	internal::pack_bytes(mDigits.data(), nrDigits, m);
+	std::vector<uint32_t> fb = { 0, 2 };  // 0 stands for -1
+	std::vector<uint32_t> root1 = { 0, 0 }, root2 = { 0, 0 };
+	std::vector<uint8_t> logp = { 0, 1 };
+	uint64_t limit = 1024;
+	while (fb.size() < factorBaseSize) {
+		fb.resize(2); root1.resize(2); root2.resize(2); logp.resize(2);
+		for (uint32_t p : internal::sieving_primes(limit)) {
+			uint32_t np = internal::limb_remainder_small(nDigits, p);
+			// a prime of the factor base that divides n is a factor
+			if (np == 0) return Integer((unsigned long long)p);
+			if (internal::powmod_small(np, (p - 1) / 2, p) != 1) continue;
+			uint64_t t = internal::sqrtmod_small(np, p);
+			uint64_t mp = internal::limb_remainder_small(mDigits, p);
+			fb.push_back(p);
+			root1.push_back(uint32_t((t + p - mp) % p));
+			root2.push_back(uint32_t((p - t + p - mp) % p));
+			logp.push_back(uint8_t(std::lround(std::log2(double(p)))));
+			if (fb.size() == factorBaseSize) break;
+		}
+		limit *= 2;
+	}
+	size_t F = fb.size();
+	uint32_t pmax = fb.back();
+	if (bTrace) std::cout << "quadratic sieve: " << size_t(digits) + 1 << " digits, factor base of " << F << " primes up to " << pmax << std::endl;
+
+	// relations: x + m, and the exponents of the factor base in Q(x)
+	struct relation {
+		Integer y;
+		std::vector< std::pair<uint32_t, uint32_t> > exponents;  // factor base index, exponent
+	};
+	std::vector<relation> relations;
+	size_t needed = F + 16;
+	std::vector<uint8_t> sieve(static_cast<size_t>(S));
+	// |Q(x)| ~ 2|x|m; the logarithms of small primes and prime powers are missing, so allow for a couple of large primes
+	double log2m = double(findMsb(m) + 1);
+	double slack = 2.0 * std::log2(double(pmax)) + 4.0;
+	std::vector<uint32_t> q(2 * nrDigits);
+	for (int64_t block = 0; block < 20000 && relations.size() < needed; ++block) {
+		// alternate the sides of 0: [0, S), [-S, 0), [S, 2S), ...
+		int64_t X0 = (block & 1) ? -(block / 2 + 1) * S : (block / 2) * S;
+		double far = double(std::max<int64_t>(std::abs(X0), std::abs(X0 + S)));
+		int threshold = int(std::max(0.0, 1.0 + std::log2(far) + log2m - slack));
+		std::fill(sieve.begin(), sieve.end(), uint8_t(0));
+		for (size_t j = 2; j < F; ++j) {
+			int64_t p = fb[j];
+			int64_t offset = ((X0 % p) + p) % p;  // X0 mod p
+			for (uint32_t r : { root1[j], root2[j] }) {
+				for (int64_t i = (int64_t(r) - offset + p) % p; i < S; i += p) sieve[size_t(i)] += logp[j];
+				if (root1[j] == root2[j]) break;
+			}
+		}
+		for (int64_t i = 0; i < S && relations.size() < needed; ++i) {
+			if (sieve[size_t(i)] < threshold) continue;
+			int64_t x = X0 + i;
+			Integer y = m + Integer((long long)x);
+			Wide Q = Wide(y) * Wide(y) - Wide(n);
+			relation rel{ y, {} };
+			if (Q.sign()) {
+				Q = -Q;
+				rel.exponents.push_back({ 0, 1 });
+			}
+			if (Q.iszero()) continue;
+			internal::pack_bytes(q.data(), q.size(), Q);
+			uint32_t e = 0;
+			while ((q[0] & 1) == 0) { internal::limb_divide_small(q, 2); ++e; }
+			if (e) rel.exponents.push_back({ 1, e });
+			for (size_t j = 2; j < F; ++j) {
+				int64_t p = fb[j];
+				int64_t xp = ((x % p) + p) % p;
+				if (xp != root1[j] && xp != root2[j]) continue;
+				e = 0;
+				std::vector<uint32_t> t(q);
+				while (internal::limb_divide_small(t, uint32_t(p)) == 0) { q = t; ++e; }
+				if (e) rel.exponents.push_back({ uint32_t(j), e });
+			}
+			// a full relation factors completely over the factor base
+			if (q[0] == 1 && internal::limb_significant(q.data(), q.size()) == 1) relations.push_back(rel);
+		}
+	}
+	if (bTrace) std::cout << "quadratic sieve: " << relations.size() << " relations" << std::endl;
+	if (relations.size() <= F) return Integer(1);
+
+	// Gaussian elimination over GF(2) of the exponent parities, tracking the combinations of the relations
+	size_t R = relations.size();
+	size_t wordsF = (F + 63) / 64, wordsR = (R + 63) / 64;
+	std::vector< std::vector<uint64_t> > parity(R, std::vector<uint64_t>(wordsF, 0)), history(R, std::vector<uint64_t>(wordsR, 0));
+	for (size_t r = 0; r < R; ++r) {
+		for (auto& e : relations[r].exponents) if (e.second & 1) parity[r][e.first / 64] ^= uint64_t(1) << (e.first % 64);
+		history[r][r / 64] = uint64_t(1) << (r % 64);
+	}
+	std::vector<bool> used(R, false);
+	for (size_t col = 0; col < F; ++col) {
+		size_t pivot = R;
+		for (size_t r = 0; r < R; ++r) {
+			if (!used[r] && ((parity[r][col / 64] >> (col % 64)) & 1)) { pivot = r; break; }
+		}
+		if (pivot == R) continue;
+		used[pivot] = true;
+		for (size_t r = 0; r < R; ++r) {
+			if (r != pivot && ((parity[r][col / 64] >> (col % 64)) & 1)) {
+				for (size_t w = 0; w < wordsF; ++w) parity[r][w] ^= parity[pivot][w];
+				for (size_t w = 0; w < wordsR; ++w) history[r][w] ^= history[pivot][w];
+			}
+		}
+	}
+
+	// every relation without a pivot has a zero parity row: its history is a congruence of squares
+	Wide N(n);
+	for (size_t r = 0; r < R; ++r) {
+		if (used[r]) continue;
+		Wide X(1);
+		std::vector<uint64_t> exponents(F, 0);
+		for (size_t k = 0; k < R; ++k) {
+			if (!((history[r][k / 64] >> (k % 64)) & 1)) continue;
+			X = (X * Wide(relations[k].y)) % N;
+			for (auto& e : relations[k].exponents) exponents[e.first] += e.second;
+		}
+		Wide Y(1);
+		for (size_t j = 1; j < F; ++j) {
+			for (uint64_t e = 0; e < exponents[j] / 2; ++e) Y = (Y * Wide((unsigned long long)fb[j])) % N;
+		}
+		Wide difference = (X + N - Y) % N;
+		Integer g;
+		g.bitcopy(gcd(difference, N));
+		if (!g.isone() && g != n && !g.iszero()) {
+			if (bTrace) std::cout << "quadratic sieve: factor " << g << std::endl;
+			return g;
+		}
+	}
+	return Integer(1);
+}
 
 } // namespace unum
 } // namespace sw
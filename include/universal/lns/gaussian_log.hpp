@@ -0,0 +1,191 @@
+#pragma once
+// gaussian_log.hpp: compile-time generated Gaussian logarithm tables for logarithmic number system addition
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <universal/native/limb_arithmetic.hpp>
+
+// logarithms with up to LNS_GAUSSIAN_LOG_TABLE_RBITS fraction bits use interpolated tables,
+// logarithms with more fraction bits evaluate the Gaussian logarithms with the standard library
+#if !defined(LNS_GAUSSIAN_LOG_TABLE_RBITS)
+#define LNS_GAUSSIAN_LOG_TABLE_RBITS 16
+#endif
+
+namespace sw { namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// Gaussian logarithms
+///
+/// The sum and difference of two values with base-2 logarithms x >= y are
+///     log2(2^x + 2^y) = x + sb(x - y),   sb(d) = log2(1 + 2^-d)
+///     log2(2^x - 2^y) = x + db(x - y),   db(d) = log2(1 - 2^-d)
+/// The arguments and results are fixed-point logarithms with rbits fraction bits.
+///
+/// sb and db are sampled at a spacing of 2^-S, S = ceil(rbits/2), which bounds the error of
+/// linear interpolation by a small fraction of an ulp. The samples are fixed-point integers
+/// with LNS_GUARD_BITS more fraction bits than the logarithm, so the interpolation is integer
+/// arithmetic. Beyond d = rbits + 2 both functions round to zero. db has a singularity at 0:
+/// below d = 2 it is evaluated as log2(d) + g(d), g(d) = log2((1 - 2^-d)/d), which is smooth,
+/// with log2(d) from the exponent of d and a table of log2 of its mantissa.
+/// The interpolated results are faithful: the error is below one ulp of the logarithm.
+
+namespace internal {
+
+constexpr int LNS_GUARD_BITS = 8;
+constexpr double LNS_LN2 = 0.69314718055994530942;
+constexpr double LNS_SQRT2 = 1.41421356237309504880;
+
+// e^x - 1 for |x| <= 2, by its Taylor series
+constexpr double lns_expm1(double x) {
+	double term = x, sum = x;
+	for (int k = 2; k < 32; ++k) {
+		term *= x / k;
+		sum += term;
+	}
+	return sum;
+}
+
+// 2^x
+constexpr double lns_exp2(double x) {
+	int i = int(x);
+	if (double(i) > x) --i;
+	double r = 1.0 + lns_expm1((x - i) * LNS_LN2);
+	for (; i > 0; --i) r *= 2.0;
+	for (; i < 0; ++i) r *= 0.5;
+	return r;
+}
+
+// log2(y) for y > 0: reduce y to [sqrt(1/2), sqrt(2)] and use ln(y) = 2 atanh((y-1)/(y+1))
+constexpr double lns_log2(double y) {
+	int e = 0;
+	while (y >= 2.0) { y *= 0.5; ++e; }
+	while (y < 1.0) { y *= 2.0; --e; }
+	if (y > LNS_SQRT2) { y *= 0.5; ++e; }
+	double z = (y - 1.0) / (y + 1.0), z2 = z * z, term = z, sum = 0.0;
+	for (int k = 1; k < 40; k += 2) {
+		sum += term / k;
+		term *= z2;
+	}
+	return e + 2.0 * sum / LNS_LN2;
+}
+
+// round a real to a fixed-point integer with fbits fraction bits
+constexpr int64_t lns_fixed(double v, int fbits) {
+	for (int i = 0; i < fbits; ++i) v *= 2.0;
+	return int64_t(v < 0 ? v - 0.5 : v + 0.5);
+}
+
+enum class gaussian_log_function { sb, db, g, log2m };
+
+template<size_t rbits>
+struct gaussian_log_layout {
+	static constexpr int S = int(rbits + 1) / 2;            // samples per unit: 2^S
+	static constexpr int shift = int(rbits) - S;            // argument bits below the sample index
+	static constexpr int dmax = int(rbits) + 2;             // sb and db round to zero beyond dmax
+	static constexpr int dmin = 2;                          // db below dmin is log2(d) + g(d)
+	static constexpr int fbits = int(rbits) + LNS_GUARD_BITS; // fraction bits of the samples
+};
+
+// number of samples of a table: one more than the intervals to interpolate the last one
+template<size_t rbits>
+constexpr size_t gaussian_log_table_size(gaussian_log_function f) {
+	using L = gaussian_log_layout<rbits>;
+	switch (f) {
+	case gaussian_log_function::sb:    return (size_t(L::dmax) << L::S) + 1;
+	case gaussian_log_function::db:    return (size_t(L::dmax - L::dmin) << L::S) + 1;
+	case gaussian_log_function::g:     return (size_t(L::dmin) << L::S) + 1;
+	case gaussian_log_function::log2m: return (size_t(1) << L::S) + 1;
+	}
+	return 0;
+}
+
+template<size_t rbits, gaussian_log_function f>
+constexpr std::array<int64_t, gaussian_log_table_size<rbits>(f)> generate_gaussian_log_table() {
+	using L = gaussian_log_layout<rbits>;
+	std::array<int64_t, gaussian_log_table_size<rbits>(f)> table{};
+	double h = 1.0;
+	for (int i = 0; i < L::S; ++i) h *= 0.5;
+	for (size_t i = 0; i < table.size(); ++i) {
+		double v = 0.0;
+		switch (f) {
+		case gaussian_log_function::sb:
+			v = lns_log2(1.0 + lns_exp2(-(i * h)));
+			break;
+		case gaussian_log_function::db:
+			v = lns_log2(1.0 - lns_exp2(-(L::dmin + i * h)));
+			break;
+		case gaussian_log_function::g:
+			// the limit at d = 0 is log2(ln 2)
+			v = (i == 0) ? lns_log2(LNS_LN2) : lns_log2(-lns_expm1(-(i * h) * LNS_LN2) / (i * h));
+			break;
+		case gaussian_log_function::log2m:
+			v = lns_log2(1.0 + i * h);
+			break;
+		}
+		table[i] = lns_fixed(v, L::fbits);
+	}
+	return table;
+}
+
+template<size_t rbits, gaussian_log_function f>
+inline constexpr auto gaussian_log_table = generate_gaussian_log_table<rbits, f>();
+
+// interpolate a table at a fixed-point argument with rbits fraction bits, measured from the first sample
+template<size_t rbits, gaussian_log_function f>
+inline int64_t gaussian_log_interpolate(uint64_t d) {
+	using L = gaussian_log_layout<rbits>;
+	const auto& table = gaussian_log_table<rbits, f>;
+	size_t i = size_t(d >> L::shift);
+	int64_t fraction = int64_t(d & ((uint64_t(1) << L::shift) - 1));
+	return table[i] + (((table[i + 1] - table[i]) * fraction) >> L::shift);
+}
+
+// remove the guard bits of an interpolated value, rounding to nearest
+inline int64_t gaussian_log_round(int64_t v) {
+	return (v + (int64_t(1) << (LNS_GUARD_BITS - 1))) >> LNS_GUARD_BITS;
+}
+
+} // namespace internal
+
+// sb(d) = log2(1 + 2^-d) of a fixed-point d >= 0 with rbits fraction bits
+template<size_t rbits>
+inline int64_t gaussian_log_sum(uint64_t d) {
+	using namespace internal;
+	using L = gaussian_log_layout<rbits>;
+	if (d >= (uint64_t(L::dmax) << rbits)) return 0;
+	if constexpr (rbits <= LNS_GAUSSIAN_LOG_TABLE_RBITS) {
+		return gaussian_log_round(gaussian_log_interpolate<rbits, gaussian_log_function::sb>(d));
+	}
+	else {
+		long double scaling = std::ldexp(1.0l, int(rbits));
+		return int64_t(std::llround(std::log1p(std::exp2(-(long double)(d) / scaling)) / std::log(2.0l) * scaling));
+	}
+}
+
+// db(d) = log2(1 - 2^-d) of a fixed-point d > 0 with rbits fraction bits
+template<size_t rbits>
+inline int64_t gaussian_log_difference(uint64_t d) {
+	using namespace internal;
+	using L = gaussian_log_layout<rbits>;
+	if (d >= (uint64_t(L::dmax) << rbits)) return 0;
+	if constexpr (rbits <= LNS_GAUSSIAN_LOG_TABLE_RBITS) {
+		constexpr uint64_t dmin = uint64_t(L::dmin) << rbits;
+		if (d >= dmin) return gaussian_log_round(gaussian_log_interpolate<rbits, gaussian_log_function::db>(d - dmin));
+		// log2(d) = (msb - rbits) + log2(mantissa), mantissa in [1, 2) aligned to rbits fraction bits
+		int msb = 63 - limb_clz(d);
+		uint64_t mantissa = (msb >= int(rbits)) ? (d >> (msb - int(rbits))) : (d << (int(rbits) - msb));
+		mantissa -= uint64_t(1) << rbits;
+		int64_t log2d = int64_t(msb - int(rbits)) * (int64_t(1) << L::fbits) + gaussian_log_interpolate<rbits, gaussian_log_function::log2m>(mantissa);
+		return gaussian_log_round(log2d + gaussian_log_interpolate<rbits, gaussian_log_function::g>(d));
+	}
+	else {
+		long double scaling = std::ldexp(1.0l, int(rbits));
+		return int64_t(std::llround(std::log1p(-std::exp2(-(long double)(d) / scaling)) / std::log(2.0l) * scaling));
+	}
+}
+
+}} // namespace sw::unum
@@ -5,53 +5,68 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cassert>
+#include <cstdint>
+#include <cmath>
 #include <limits>
+#include <string>
+#include <sstream>
+#include <iomanip>
 
 #include <universal/native/ieee-754.hpp>
 #include <universal/blockbin/blockbinary.hpp>
-#include <universal/abstract/triple.hpp>
+#include <universal/lns/exceptions.hpp>
+#include <universal/lns/gaussian_log.hpp>
 
 namespace sw {	namespace unum {
-		
+
+/*
+ An lns represents a value X by its sign and the base-2 logarithm of its magnitude:
+
+     [ sign | log2(|X|) (nbits-1 bits) ]
+
+ The logarithm is a two's complement fixed-point number with rbits = nbits/2 fraction bits.
+ The most negative logarithm encodes the specials: with the sign clear it is zero, with the
+ sign set it is NaN. There is no infinity: results beyond maxpos saturate to maxpos, and
+ nonzero results below minpos saturate to minpos, in the manner of posits.
+
+ Multiplication and division add and subtract the logarithms and are exact up to saturation.
+ Addition and subtraction use the Gaussian logarithms of gaussian_log.hpp and are faithful.
+ Conversions from and to native types round to the nearest logarithm.
+ */
+
 // Forward definitions
 template<size_t nbits, typename bt> class lns;
 template<size_t nbits, typename bt> lns<nbits,bt> abs(const lns<nbits,bt>& v);
 
-// convert a floating-point value to a specific lns configuration. Semantically, p = v, return reference to p
-template<size_t nbits, typename bt>
-inline lns<nbits, bt>& convert(const triple<nbits,bt>& v, lns<nbits,bt>& p) {
-	if (v.iszero()) {
-		return p.setnan();
-	}
-	if (v.isnan() || v.isinf()) {
-		return p.setnan();
-	}
-	return p;
-}
-
 template<size_t nbits, typename bt>
 lns<nbits, bt>& minpos(lns<nbits, bt>& lminpos) {
-	return lminpos;
+	return lminpos.minpos(false);
 }
 template<size_t nbits, typename bt>
 lns<nbits, bt>& maxpos(lns<nbits, bt>& lmaxpos) {
-	return lmaxpos;
+	return lmaxpos.maxpos(false);
 }
 template<size_t nbits, typename bt>
 lns<nbits, bt>& minneg(lns<nbits, bt>& lminneg) {
-	return lminneg;
+	return lminneg.minpos(true);
 }
 template<size_t nbits, typename bt>
 lns<nbits, bt>& maxneg(lns<nbits, bt>& lmaxneg) {
-	return lmaxneg;
+	return lmaxneg.maxpos(true);
 }
 
-// template class representing a value in scientific notation, using a template size for the number of fraction bits
+// template class representing a value in logarithmic form, using a template size for the number of bits
 template<size_t nbits, typename bt = uint8_t>
 class lns {
+	static_assert(nbits >= 4, "lns requires at least 4 bits");
+	static_assert(nbits <= 64, "lns is limited to 64 bits");
 public:
 	static constexpr size_t rbits = nbits / 2;
-	static constexpr double scaling = double(1 << rbits);
+	static constexpr double scaling = double(uint64_t(1) << rbits);
+	// fixed-point logarithms of the specials and the extreme values
+	static constexpr int64_t log_special = -(int64_t(1) << (nbits - 2));
+	static constexpr int64_t log_minpos = log_special + 1;
+	static constexpr int64_t log_maxpos = (int64_t(1) << (nbits - 2)) - 1;
 
 	lns() : _bits{ 0 } {}
 
@@ -74,36 +89,72 @@ public:
 	lns& operator=(signed char rhs) { return *this = (long long)(rhs); }
 	lns& operator=(short rhs) { return *this = (long long)(rhs); }
 	lns& operator=(int rhs) { return *this = (long long)(rhs); }
-	lns& operator=(long long rhs) { return *this; }
-	lns& operator=(unsigned long long rhs) { return *this; }
-	constexpr lns& operator=(float rhs) { _bits = (long long)(std::log(rhs) * scaling); return *this; }
-	constexpr lns& operator=(double rhs) { _bits = (long long)(std::log(rhs) * scaling); return *this; }
-	lns& operator=(long double rhs) { _bits = (long long)(std::log(rhs) * scaling); return *this; }
+	lns& operator=(long long rhs) { return *this = (long double)(rhs); }
+	lns& operator=(unsigned long long rhs) { return *this = (long double)(rhs); }
+	lns& operator=(float rhs) { return *this = (long double)(rhs); }
+	lns& operator=(double rhs) { return *this = (long double)(rhs); }
+	lns& operator=(long double rhs) {
+		if (std::isnan(rhs)) return setnan();
+		if (rhs == 0) return setzero();
+		bool negative = std::signbit(rhs);
+		if (std::isinf(rhs)) return maxpos(negative);
+		long double logarithm = std::round(std::log2(std::fabs(rhs)) * scaling);
+		if (logarithm > (long double)(log_maxpos)) return maxpos(negative);
+		if (logarithm < (long double)(log_minpos)) return minpos(negative);
+		store(negative, int64_t(logarithm));
+		return *this;
+	}
 
 	// arithmetic operators
 	// prefix operator
-	lns operator-() const {				
-		return *this;
+	lns operator-() const {
+		lns negated(*this);
+		if (!isspecial(encoding())) negated._bits.set(nbits - 1, !sign());
+		return negated;
 	}
 
 	// in-place arithmetic assignment operators
-	lns& operator+=(const lns& rhs) { return *this; }
+	lns& operator+=(const lns& rhs) { return add(rhs, false); }
 	lns& operator+=(double rhs) { return *this += lns(rhs); }
-	lns& operator-=(const lns& rhs) { return *this; }
-	lns& operator-=(double rhs) { return *this -= lns<nbits>(rhs); }
+	lns& operator-=(const lns& rhs) { return add(rhs, true); }
+	lns& operator-=(double rhs) { return *this -= lns(rhs); }
 	lns& operator*=(const lns& rhs) {
-		this->_bits += rhs._bits;
-		return *this; 
+		uint64_t a = encoding(), b = rhs.encoding();
+		if (isspecial(a) || isspecial(b)) {
+			if (isnan(a) || isnan(b)) return setnan();
+			return setzero();
+		}
+		return saturate(sign(a) != sign(b), logarithm(a) + logarithm(b));
 	}
-	lns& operator*=(double rhs) { return *this *= lns<nbits>(rhs); }
+	lns& operator*=(double rhs) { return *this *= lns(rhs); }
 	lns& operator/=(const lns& rhs) {
-		this->_bits -= rhs._bits;
-		return *this;
+		uint64_t a = encoding(), b = rhs.encoding();
+		if (isspecial(b)) {
+			if (isnan(b)) return setnan();
+#if LNS_THROW_ARITHMETIC_EXCEPTION
+			throw lns_divide_by_zero();
+#else
+			std::cerr << "lns_divide_by_zero" << std::endl;
+			return setnan();
+#endif
+		}
+		if (isspecial(a)) return *this;
+		return saturate(sign(a) != sign(b), logarithm(a) - logarithm(b));
 	}
-	lns& operator/=(double rhs) { return *this /= lns<nbits>(rhs); }
+	lns& operator/=(double rhs) { return *this /= lns(rhs); }
 
-	// prefix/postfix operators
+	// prefix/postfix operators step to the next larger and next smaller value
 	lns& operator++() {
+		uint64_t a = encoding();
+		if (isnan(a)) return *this;
+		if (iszero(a)) return minpos(false);
+		if (sign(a)) {
+			if (logarithm(a) == log_minpos) return setzero();
+			store(true, logarithm(a) - 1);
+		}
+		else if (logarithm(a) < log_maxpos) {
+			store(false, logarithm(a) + 1);
+		}
 		return *this;
 	}
 	lns operator++(int) {
@@ -112,6 +163,16 @@ public:
 		return tmp;
 	}
 	lns& operator--() {
+		uint64_t a = encoding();
+		if (isnan(a)) return *this;
+		if (iszero(a)) return minpos(true);
+		if (!sign(a)) {
+			if (logarithm(a) == log_minpos) return setzero();
+			store(false, logarithm(a) - 1);
+		}
+		else if (logarithm(a) < log_maxpos) {
+			store(true, logarithm(a) + 1);
+		}
 		return *this;
 	}
 	lns operator--(int) {
@@ -121,29 +182,37 @@ public:
 	}
 
 	// modifiers
-	void reset() {	}
+	inline void reset() { _bits.clear(); }
+	inline lns& setzero() { store(false, log_special); return *this; }
+	inline lns& setnan() { store(true, log_special); return *this; }
+	inline lns& set_raw_bits(uint64_t raw) { _bits.set_raw_bits(raw); return *this; }
+	inline lns& minpos(bool negative = false) { store(negative, log_minpos); return *this; }
+	inline lns& maxpos(bool negative = false) { store(negative, log_maxpos); return *this; }
 
 	// selectors
-	inline constexpr bool isneg() const { return false; }
-	inline constexpr bool iszero() const { return false; }
-	inline constexpr bool isinf() const { return false; }
-	inline constexpr bool isnan() const { return false; }
-	inline constexpr bool sign() const { return false; }
-	inline constexpr int scale() const { return false; }
-	inline std::string get() const { 
-		std::stringstream s;
-		s << std::exp(double(_bits.to_long_long()));
-		return s.str(); 
-	}
+	inline bool sign() const { return _bits.test(nbits - 1); }
+	inline bool isneg() const { return sign() && !isnan(); }
+	inline bool iszero() const { return iszero(encoding()); }
+	inline bool isinf() const { return false; }
+	inline bool isnan() const { return isnan(encoding()); }
+	// the fixed-point logarithm of the magnitude with rbits fraction bits
+	inline int64_t logarithm() const { return logarithm(encoding()); }
+	// the binary scale, the integer part of the logarithm
+	inline int scale() const { return isspecial(encoding()) ? 0 : int(logarithm() >> rbits); }
+	inline blockbinary<nbits, bt> get() const { return _bits; }
 
 	long double to_long_double() const {
-		return std::exp((long double)(_bits.to_long_long()))/scaling;
+		uint64_t a = encoding();
+		if (isnan(a)) return std::numeric_limits<long double>::quiet_NaN();
+		if (iszero(a)) return 0.0l;
+		long double magnitude = std::exp2((long double)(logarithm(a)) / scaling);
+		return sign(a) ? -magnitude : magnitude;
 	}
 	double to_double() const {
-		return std::exp(double(_bits.to_long_long()))/scaling;
+		return double(to_long_double());
 	}
 	float to_float() const {
-		return std::exp(float(_bits.to_long_long()))/scaling;
+		return float(to_long_double());
 	}
 	// Maybe remove explicit
 	explicit operator long double() const { return to_long_double(); }
@@ -153,6 +222,65 @@ public:
 private:
 	blockbinary<nbits,bt>  _bits;
 
+	static constexpr uint64_t logarithm_mask = (uint64_t(1) << (nbits - 1)) - 1;
+
+	// the raw bits as a native word, the sign bit at position nbits-1
+	uint64_t encoding() const {
+		uint64_t raw;
+		internal::pack_blocks(&raw, 1, _bits);
+		return raw;
+	}
+	void store(bool negative, int64_t logarithm) {
+		uint64_t raw = (uint64_t(logarithm) & logarithm_mask) | (uint64_t(negative) << (nbits - 1));
+		internal::unpack_blocks(_bits, &raw, 1);
+	}
+	static bool sign(uint64_t raw) { return (raw >> (nbits - 1)) & 1; }
+	// sign-extend the logarithm field
+	static int64_t logarithm(uint64_t raw) {
+		constexpr int unused = 65 - int(nbits);
+		return int64_t(raw << unused) >> unused;
+	}
+	static bool isspecial(uint64_t raw) { return logarithm(raw) == log_special; }
+	static bool iszero(uint64_t raw) { return isspecial(raw) && !sign(raw); }
+	static bool isnan(uint64_t raw) { return isspecial(raw) && sign(raw); }
+
+	lns& saturate(bool negative, int64_t logarithm) {
+		if (logarithm > log_maxpos) logarithm = log_maxpos;
+		if (logarithm < log_minpos) logarithm = log_minpos;
+		store(negative, logarithm);
+		return *this;
+	}
+
+	// Gaussian logarithm addition: log2(|a| +- |b|) = max + sb/db(|max - min|)
+	lns& add(const lns& rhs, bool subtract) {
+		uint64_t a = encoding(), b = rhs.encoding();
+		if (isnan(a) || isnan(b)) return setnan();
+		if (iszero(b)) return *this;
+		bool sa = sign(a), sb = sign(b) != subtract;
+		int64_t la = logarithm(a), lb = logarithm(b);
+		if (iszero(a)) {
+			store(sb, lb);
+			return *this;
+		}
+		if (la < lb) {
+			std::swap(la, lb);
+			std::swap(sa, sb);
+		}
+		uint64_t d = uint64_t(la - lb);
+		if (sa == sb) return saturate(sa, la + gaussian_log_sum<rbits>(d));
+		if (d == 0) return setzero();
+		return saturate(sa, la + gaussian_log_difference<rbits>(d));
+	}
+
+	bool less_than(const lns& rhs) const {
+		uint64_t a = encoding(), b = rhs.encoding();
+		if (isnan(a) || isnan(b)) return false;
+		bool sa = sign(a), sb = sign(b);
+		if (sa != sb) return sa;
+		// the logarithm of zero is the smallest
+		return sa ? logarithm(b) < logarithm(a) : logarithm(a) < logarithm(b);
+	}
+
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<size_t nnbits, typename nbt>
 	friend std::ostream& operator<< (std::ostream& ostr, const lns<nnbits,nbt>& r);
@@ -176,80 +304,84 @@ private:
 ////////////////////// operators
 template<size_t nnbits, typename nbt>
 inline std::ostream& operator<<(std::ostream& ostr, const lns<nnbits,nbt>& v) {
-	ostr << v.to_double();
+	ostr << v.to_long_double();
 	return ostr;
 }
 
 template<size_t nnbits, typename nbt>
-inline std::istream& operator>>(std::istream& istr, const lns<nnbits,nbt>& v) {
-	istr >> v._fraction;
+inline std::istream& operator>>(std::istream& istr, lns<nnbits,nbt>& v) {
+	long double value;
+	istr >> value;
+	v = value;
 	return istr;
 }
 
 template<size_t nnbits, typename nbt>
-inline bool operator==(const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return false; }
+inline bool operator==(const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) {
+	if (lhs.isnan() || rhs.isnan()) return false;
+	return lhs._bits == rhs._bits;
+}
 template<size_t nnbits, typename nbt>
 inline bool operator!=(const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return !operator==(lhs, rhs); }
 template<size_t nnbits, typename nbt>
-inline bool operator< (const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return false; }
+inline bool operator< (const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return lhs.less_than(rhs); }
 template<size_t nnbits, typename nbt>
 inline bool operator> (const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return  operator< (rhs, lhs); }
 template<size_t nnbits, typename nbt>
-inline bool operator<=(const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return !operator> (lhs, rhs); }
+inline bool operator<=(const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return operator< (lhs, rhs) || operator==(lhs, rhs); }
 template<size_t nnbits, typename nbt>
-inline bool operator>=(const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return !operator< (lhs, rhs); }
+inline bool operator>=(const lns<nnbits,nbt>& lhs, const lns<nnbits,nbt>& rhs) { return operator> (lhs, rhs) || operator==(lhs, rhs); }
 
 // lns - lns binary arithmetic operators
 // BINARY ADDITION
 template<size_t nbits, typename bt>
 inline lns<nbits, bt> operator+(const lns<nbits, bt>& lhs, const lns<nbits, bt>& rhs) {
-	lns<nbits> sum(lhs);
+	lns<nbits, bt> sum(lhs);
 	sum += rhs;
 	return sum;
 }
 // BINARY SUBTRACTION
 template<size_t nbits, typename bt>
 inline lns<nbits, bt> operator-(const lns<nbits, bt>& lhs, const lns<nbits, bt>& rhs) {
-	lns<nbits> diff(lhs);
+	lns<nbits, bt> diff(lhs);
 	diff -= rhs;
 	return diff;
 }
 // BINARY MULTIPLICATION
 template<size_t nbits, typename bt>
 inline lns<nbits, bt> operator*(const lns<nbits, bt>& lhs, const lns<nbits, bt>& rhs) {
-	lns<nbits> mul(lhs);
+	lns<nbits, bt> mul(lhs);
 	mul *= rhs;
 	return mul;
 }
 // BINARY DIVISION
 template<size_t nbits, typename bt>
 inline lns<nbits, bt> operator/(const lns<nbits, bt>& lhs, const lns<nbits, bt>& rhs) {
-	lns<nbits> ratio(lhs);
+	lns<nbits, bt> ratio(lhs);
 	ratio /= rhs;
 	return ratio;
 }
 
-
+// sign and fixed-point logarithm of an lns value
 template<size_t nbits, typename bt>
 inline std::string components(const lns<nbits,bt>& v) {
 	std::stringstream s;
-	if (v.iszero()) {
-		s << " zero b" << std::setw(nbits) << v.fraction();
+	if (v.isnan()) {
+		s << " nan b" << v.get();
 		return s.str();
 	}
-	else if (v.isinf()) {
-		s << " infinite b" << std::setw(nbits) << v.fraction();
+	else if (v.iszero()) {
+		s << " zero b" << v.get();
 		return s.str();
 	}
-	s << "(" << (v.sign() ? "-" : "+") << "," << v.scale() << "," << v.fraction() << ")";
+	s << "(" << (v.sign() ? "-" : "+") << "," << std::ldexp(double(v.logarithm()), -int(lns<nbits, bt>::rbits)) << ")";
 	return s.str();
 }
 
-/// Magnitude of a scientific notation value (equivalent to turning the sign bit off).
+/// Magnitude of an lns value (equivalent to turning the sign bit off).
 template<size_t nbits, typename bt>
-lns<nbits> abs(const lns<nbits,bt>& v) {
-	return lns<nbits>();
+lns<nbits, bt> abs(const lns<nbits,bt>& v) {
+	return v.isneg() ? -v : v;
 }
 
-
 }}  // namespace sw::unum
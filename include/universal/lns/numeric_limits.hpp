@@ -13,53 +13,57 @@ class numeric_limits< sw::unum::lns<nbits,bt> > {
 public:
 	using LNS = sw::unum::lns<nbits, bt>;
 	static constexpr bool is_specialized = true;
-	static constexpr LNS  min() { // return minimum value
+	static LNS min() { // return minimum value
 		LNS lminpos;
 		return sw::unum::minpos<nbits, bt>(lminpos);
 	} 
-	static constexpr LNS  max() { // return maximum value
+	static LNS max() { // return maximum value
 		LNS lmaxpos;
 		return sw::unum::maxpos<nbits, bt>(lmaxpos);
 	} 
-	static constexpr LNS  lowest() { // return most negative value
+	static LNS lowest() { // return most negative value
 		LNS lmaxneg;
 		return sw::unum::maxneg<nbits, bt>(lmaxneg);
 	} 
-	static constexpr LNS  epsilon() { // return smallest effective increment from 1.0
+	static LNS epsilon() { // return smallest effective increment from 1.0
 		LNS one{ 1.0f }, incr{ 1.0f };
 		++incr;
-		return incr - one;
+		return LNS(incr.to_long_double() - one.to_long_double());
 	}
-	static constexpr LNS  round_error() { // return largest rounding error
+	static LNS round_error() { // return largest rounding error
 		return LNS(0.5);
 	}
-	static constexpr LNS  denorm_min() {  // return minimum denormalized value
-		return LNS(1.0); 
+	static LNS denorm_min() {  // return minimum denormalized value, lns has no denormals
+		LNS lminpos;
+		return sw::unum::minpos<nbits, bt>(lminpos);
 	}
-	static constexpr LNS  infinity() { // return positive infinity
-		return LNS(INFINITY); 
+	static LNS infinity() { // return positive infinity, lns saturates to maxpos
+		LNS lmaxpos;
+		return sw::unum::maxpos<nbits, bt>(lmaxpos);
 	}
-	static constexpr LNS  quiet_NaN() { // return non-signaling NaN
-		return LNS(NAN); 
+	static LNS quiet_NaN() { // return non-signaling NaN
+		LNS nan;
+		return nan.setnan();
 	}
-	static constexpr LNS  signaling_NaN() { // return signaling NaN
-		return LNS(NAN);
+	static LNS signaling_NaN() { // return signaling NaN
+		LNS nan;
+		return nan.setnan();
 	}
 
-	static constexpr int digits       = 3333333;
-	static constexpr int digits10     = 1000000;
-	static constexpr int max_digits10 = 1000000;
+	static constexpr int digits       = int(LNS::rbits);
+	static constexpr int digits10     = int(digits / 3.3);
+	static constexpr int max_digits10 = digits10 + 2;
 	static constexpr bool is_signed   = true;
 	static constexpr bool is_integer  = false;
 	static constexpr bool is_exact    = false;
 	static constexpr int radix        = 2;
 
-	static constexpr int min_exponent = 0;
-	static constexpr int min_exponent10 = 0;
-	static constexpr int max_exponent = 0;
-	static constexpr int max_exponent10 = 0;
+	static constexpr int min_exponent   = int(LNS::log_minpos >> LNS::rbits) + 1;
+	static constexpr int min_exponent10 = int(min_exponent / 3.3);
+	static constexpr int max_exponent   = int(LNS::log_maxpos >> LNS::rbits) + 1;
+	static constexpr int max_exponent10 = int(max_exponent / 3.3);
 	static constexpr bool has_infinity = false;
-	static constexpr bool has_quiet_NaN = false;
+	static constexpr bool has_quiet_NaN = true;
 	static constexpr bool has_signaling_NaN = false;
 	static constexpr float_denorm_style has_denorm = denorm_absent;
 	static constexpr bool has_denorm_loss = false;
@@ -69,7 +73,7 @@ public:
 	static constexpr bool is_modulo = false;
 	static constexpr bool traps = false;
 	static constexpr bool tinyness_before = false;
-	static constexpr float_round_style round_style = round_toward_zero;
+	static constexpr float_round_style round_style = round_to_nearest;
 };
 
 }
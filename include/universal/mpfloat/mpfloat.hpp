@@ -1,19 +1,29 @@
 #pragma once
-// mpfloat.hpp: definition of a fixed-size arbitrary mpfloat precision number
+// mpfloat.hpp: definition of an arbitrary precision binary floating-point number
 //
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
-#include <regex>
 #include <vector>
-#include <map>
+#include <algorithm>
+
+#include <universal/native/limb_arithmetic.hpp>
+#include <universal/bitblock/bitblock.hpp>
+#include <universal/value/value.hpp>
 
 //#include "./mpfloat_exceptions.hpp"
 
+// default precision, in bits of the significand, of mpfloats assigned from native types
+#if !defined(MPFLOAT_DEFAULT_PRECISION)
+#define MPFLOAT_DEFAULT_PRECISION 256
+#endif
+
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
 
@@ -47,17 +57,76 @@
 namespace sw {
 namespace unum {
 
+/*
+ An mpfloat is a binary floating-point number with a runtime precision p, in bits, and an unbounded exponent:
+
+     (-1)^sign * M * 2^(scale - (64n - 1)),   2^(64n-1) <= M < 2^(64n),   n = ceil(p / 64)
+
+ M is a vector of n 64-bit limbs, least significant limb first, of which the p most significant bits are
+ significant and the others are zero. There are signed zeros, infinities, and NaN, as in IEEE-754.
+
+ Addition, subtraction, multiplication, division, and sqrt are correctly rounded to nearest, ties to even,
+ at the larger of the precisions of the operands. Native values are assigned at the default precision,
+ or at the precision of the native type when that is larger. Multiplication of operands of
+ LIMB_KARATSUBA_THRESHOLD limbs and up uses Karatsuba, division is Knuth's Algorithm D, and sqrt a
+ Newton iteration on integers; all arithmetic kernels are those of limb_arithmetic.hpp.
+ */
+
 // forward references
 class mpfloat;
-inline mpfloat& convert(int64_t v, mpfloat& result);
-inline mpfloat& convert_unsigned(uint64_t v, mpfloat& result);
+template<size_t nbits, size_t es> class posit;
 bool parse(const std::string& number, mpfloat& v);
+mpfloat sqrt(const mpfloat& a);
+mpfloat ldexp(const mpfloat& a, int64_t exponent);
+
+namespace internal {
+
+// q = u / v, r = u % v of magnitudes of 64-bit limbs, through Algorithm D on 32-bit digits
+inline void mp_divide(const std::vector<uint64_t>& u, const std::vector<uint64_t>& v, std::vector<uint64_t>& q, std::vector<uint64_t>& r) {
+	size_t m = 2 * u.size(), n = 2 * v.size();
+	std::vector<uint32_t> u32(m), v32(n), q32(m), r32(n);
+	for (size_t i = 0; i < u.size(); ++i) { u32[2 * i] = uint32_t(u[i]); u32[2 * i + 1] = uint32_t(u[i] >> 32); }
+	for (size_t i = 0; i < v.size(); ++i) { v32[2 * i] = uint32_t(v[i]); v32[2 * i + 1] = uint32_t(v[i] >> 32); }
+	limb_divide(q32.data(), r32.data(), u32.data(), m, v32.data(), n);
+	q.assign(u.size(), 0);
+	r.assign(v.size(), 0);
+	for (size_t i = 0; i < q.size(); ++i) q[i] = uint64_t(q32[2 * i]) | (uint64_t(q32[2 * i + 1]) << 32);
+	for (size_t i = 0; i < r.size(); ++i) r[i] = uint64_t(r32[2 * i]) | (uint64_t(r32[2 * i + 1]) << 32);
+}
+
+// floor(sqrt(a)) by Newton's iteration from above
+inline std::vector<uint64_t> mp_isqrt(const std::vector<uint64_t>& a) {
+	size_t n = a.size();
+	size_t bits = n * 64 - limb_leading_zeros(a.data(), n);
+	std::vector<uint64_t> x(n, 0), q, r, y(n);
+	if (bits == 0) return x;
+	// seed from the root of the leading 64 bits t = a >> s, s even: sqrt(a) < (floor(sqrt(t)) + 2) * 2^(s/2)
+	size_t s = (bits > 64 ? (bits - 63) & ~size_t(1) : 0);
+	std::vector<uint64_t> t(a);
+	limb_shift_right(t.data(), t.data(), n, s);
+	uint64_t seed = uint64_t(std::sqrt((long double)t[0])) + 2;
+	x[0] = seed;
+	limb_shift_left(x.data(), x.data(), n, s / 2);
+	for (;;) {
+		mp_divide(a, x, q, r);
+		// y = (x + a/x) / 2, x + a/x < 2^(64n) as both terms are at most 2^(e+1)
+		limb_add(y.data(), x.data(), q.data(), n);
+		limb_shift_right(y.data(), y.data(), n, 1);
+		if (limb_compare(y.data(), x.data(), n) >= 0) break;
+		x.swap(y);
+	}
+	return x;
+}
+
+} // namespace internal
 
 // mpfloat is an arbitrary precision and scale linear floating point type
 class mpfloat {
-	using BlockType = uint32_t;
 public:
-	mpfloat() : sign(false), exp(0) { }
+	using Limb = uint64_t;
+	static constexpr size_t bitsInLimb = 64;
+
+	mpfloat() : _sign(false), _zero(true), _inf(false), _nan(false), _scale(0), _precision(default_precision()) { }
 
 	mpfloat(const mpfloat&) = default;
 	mpfloat(mpfloat&&) = default;
@@ -79,265 +148,626 @@ public:
 	explicit mpfloat(const float initial_value)              { *this = initial_value; }
 	explicit mpfloat(const double initial_value)             { *this = initial_value; }
 	explicit mpfloat(const long double initial_value)        { *this = initial_value; }
+	template<size_t fbits>
+	explicit mpfloat(const value<fbits>& initial_value)      { *this = initial_value; }
+	template<size_t nbits, size_t es>
+	explicit mpfloat(const posit<nbits, es>& initial_value)  { *this = initial_value; }
+	// initializers with a precision in bits
+	mpfloat(const long long initial_value, size_t precision) { *this = initial_value; setprecision(precision); }
+	mpfloat(const double initial_value, size_t precision)    { *this = initial_value; setprecision(precision); }
+	mpfloat(const std::string& initial_value, size_t precision = default_precision()) {
+		_precision = precision;
+		if (!parse(initial_value, *this)) setnan();
+	}
 
 	// assignment operators for native types
-	mpfloat& operator=(const signed char rhs)        { return convert(rhs, *this); }
-	mpfloat& operator=(const short rhs)              { return convert(rhs, *this); }
-	mpfloat& operator=(const int rhs)                { return convert(rhs, *this); }
-	mpfloat& operator=(const long rhs)               { return convert(rhs, *this); }
-	mpfloat& operator=(const long long rhs)          { return convert(rhs, *this); }
-	mpfloat& operator=(const char rhs)               { return convert_unsigned(rhs, *this); }
-	mpfloat& operator=(const unsigned short rhs)     { return convert_unsigned(rhs, *this); }
-	mpfloat& operator=(const unsigned int rhs)       { return convert_unsigned(rhs, *this); }
-	mpfloat& operator=(const unsigned long rhs)      { return convert_unsigned(rhs, *this); }
-	mpfloat& operator=(const unsigned long long rhs) { return convert_unsigned(rhs, *this); }
+	mpfloat& operator=(const signed char rhs)        { return convert_signed(rhs); }
+	mpfloat& operator=(const short rhs)              { return convert_signed(rhs); }
+	mpfloat& operator=(const int rhs)                { return convert_signed(rhs); }
+	mpfloat& operator=(const long rhs)               { return convert_signed(rhs); }
+	mpfloat& operator=(const long long rhs)          { return convert_signed(rhs); }
+	mpfloat& operator=(const char rhs)               { return convert_unsigned(uint64_t(rhs), false); }
+	mpfloat& operator=(const unsigned short rhs)     { return convert_unsigned(rhs, false); }
+	mpfloat& operator=(const unsigned int rhs)       { return convert_unsigned(rhs, false); }
+	mpfloat& operator=(const unsigned long rhs)      { return convert_unsigned(rhs, false); }
+	mpfloat& operator=(const unsigned long long rhs) { return convert_unsigned(rhs, false); }
 	mpfloat& operator=(const float rhs)              { return float_assign(rhs); }
 	mpfloat& operator=(const double rhs)             { return float_assign(rhs); }
 	mpfloat& operator=(const long double rhs)        { return float_assign(rhs); }
 
-#ifdef ADAPTER_POSIT_AND_MPFLOAT
-	// POSIT_CONCEPT_GENERALIZATION
-	// TODO: SFINAE to assure we only match a posit<nbits,es> concept
-	template<typename PositType>
-	mpfloat& operator=(const PositType& rhs) {
-		convert_p2i(rhs, *this);
+	// the values of posits and values are assigned exactly
+	template<size_t fbits>
+	mpfloat& operator=(const value<fbits>& rhs) {
+		if (rhs.isnan()) return setnan();
+		if (rhs.isinf()) return setinf(rhs.sign());
+		if (rhs.iszero()) return setzero(rhs.sign());
+		std::vector<Limb> m((fbits + bitsInLimb) / bitsInLimb, 0);
+		bitblock<fbits> fraction = rhs.fraction();
+		for (size_t i = 0; i < fbits; ++i) {
+			if (fraction.test(i)) m[i / bitsInLimb] |= Limb(1) << (i % bitsInLimb);
+		}
+		m[fbits / bitsInLimb] |= Limb(1) << (fbits % bitsInLimb);
+		round(rhs.sign(), int64_t(rhs.scale()) - int64_t(fbits), m, false, std::max(default_precision(), fbits + 1));
 		return *this;
 	}
-#endif // ADAPTER_POSIT_AND_MPFLOAT
+	template<size_t nbits, size_t es>
+	mpfloat& operator=(const posit<nbits, es>& rhs) {
+		if (rhs.isnar()) return setnan();
+		return *this = rhs.to_value();
+	}
 
 	// prefix operators
 	mpfloat operator-() const {
 		mpfloat negated(*this);
+		if (!_nan) negated._sign = !_sign;
 		return negated;
 	}
 
 	// conversion operators
-	explicit operator float() const { return float(toNativeFloatingPoint()); }
-	explicit operator double() const { return float(toNativeFloatingPoint()); }
-	explicit operator long double() const { return toNativeFloatingPoint(); }
+	explicit operator float() const { return to_native<float>(); }
+	explicit operator double() const { return to_native<double>(); }
+	explicit operator long double() const { return to_native<long double>(); }
 
 	// arithmetic operators
 	mpfloat& operator+=(const mpfloat& rhs) {
-		return *this;
+		return add(rhs, false);
 	}
 	mpfloat& operator-=(const mpfloat& rhs) {
-		return *this;
+		return add(rhs, true);
 	}
 	mpfloat& operator*=(const mpfloat& rhs) {
+		size_t precision = std::max(_precision, rhs._precision);
+		bool negative = (_sign != rhs._sign);
+		if (_nan || rhs._nan || (_inf && rhs._zero) || (_zero && rhs._inf)) return setnan(precision);
+		if (_inf || rhs._inf) return setinf(negative, precision);
+		if (_zero || rhs._zero) return setzero(negative, precision);
+		// equal lengths select the Karatsuba kernel for large operands
+		std::vector<Limb> a(_limbs), b(rhs._limbs);
+		int64_t lsb_scale = lsb(_scale, a.size()) + lsb(rhs._scale, b.size());
+		if (a.size() < b.size()) {
+			lsb_scale -= int64_t(bitsInLimb * (b.size() - a.size()));
+			a.insert(a.begin(), b.size() - a.size(), 0);
+		}
+		else if (b.size() < a.size()) {
+			lsb_scale -= int64_t(bitsInLimb * (a.size() - b.size()));
+			b.insert(b.begin(), a.size() - b.size(), 0);
+		}
+		std::vector<Limb> product(2 * a.size());
+		internal::limb_multiply(product.data(), a.data(), a.size(), b.data(), b.size());
+		round(negative, lsb_scale, product, false, precision);
 		return *this;
 	}
 	mpfloat& operator/=(const mpfloat& rhs) {
+		size_t precision = std::max(_precision, rhs._precision);
+		bool negative = (_sign != rhs._sign);
+		if (_nan || rhs._nan || (_inf && rhs._inf) || (_zero && rhs._zero)) return setnan(precision);
+		if (_inf || rhs._zero) return setinf(negative, precision);
+		if (_zero || rhs._inf) return setzero(negative, precision);
+		// shift the dividend so that the quotient has at least precision + 64 bits
+		size_t na = _limbs.size(), nb = rhs._limbs.size(), shift = nb + nrLimbs(precision) + 1;
+		std::vector<Limb> dividend(shift + na, 0), quotient, remainder;
+		std::copy(_limbs.begin(), _limbs.end(), dividend.begin() + shift);
+		internal::mp_divide(dividend, rhs._limbs, quotient, remainder);
+		bool sticky = !internal::limb_is_zero(remainder.data(), remainder.size());
+		round(negative, lsb(_scale, na) - int64_t(bitsInLimb * shift) - lsb(rhs._scale, nb), quotient, sticky, precision);
 		return *this;
 	}
 
 	// modifiers
-	inline void clear() { sign = false; exp = 0; coef.clear(); }
-	inline void setzero() { clear(); }
-	// use un-interpreted raw bits to set the bits of the mpfloat
-	inline void set_raw_bits(unsigned long long value) {
-		clear();
+	inline void clear() { _sign = false; _zero = true; _inf = false; _nan = false; _scale = 0; _limbs.clear(); }
+	inline mpfloat& setzero(bool negative = false) { clear(); _sign = negative; return *this; }
+	inline mpfloat& setinf(bool negative = false) { clear(); _zero = false; _inf = true; _sign = negative; return *this; }
+	inline mpfloat& setnan() { clear(); _zero = false; _nan = true; return *this; }
+	// round to a new precision in bits
+	mpfloat& setprecision(size_t precision) {
+		if (precision == 0) precision = 1;
+		if (_zero || _inf || _nan) {
+			_precision = precision;
+			return *this;
+		}
+		std::vector<Limb> m(_limbs);
+		round(_sign, lsb(_scale, m.size()), m, false, precision);
+		return *this;
 	}
 	inline mpfloat& assign(const std::string& txt) {
+		if (!parse(txt, *this)) setnan();
 		return *this;
 	}
 
+	// the precision in bits of the values assigned from native types
+	static size_t default_precision() { return _default_precision; }
+	static void set_default_precision(size_t precision) { _default_precision = (precision ? precision : 1); }
+
 	// selectors
-	inline bool iszero() const { return !sign && coef.size() == 0; }
-	inline bool isone() const  { return true; }
-	inline bool isodd() const  { return false; }
-	inline bool iseven() const { return !isodd(); }
-	inline bool ispos() const  { return !sign; }
-	inline bool ineg() const   { return sign; }
-	inline int64_t scale() const { return exp + int64_t(coef.size()); }
-
-	// convert to string containing digits number of digits
-	std::string str(size_t nrDigits = 0) const {
-		if (iszero()) return std::string("0.0");
+	inline bool iszero() const { return _zero; }
+	inline bool isinf() const  { return _inf; }
+	inline bool isnan() const  { return _nan; }
+	inline bool isone() const  { return !_sign && !_zero && !_inf && !_nan && _scale == 0 && isPowerOfTwo(); }
+	inline bool ispos() const  { return !_sign && !_nan; }
+	inline bool isneg() const  { return _sign && !_nan; }
+	inline bool sign() const   { return _sign; }
+	inline int64_t scale() const { return _scale; }
+	inline size_t precision() const { return _precision; }
+	// the significand limbs, least significant first, with the most significant bit set
+	inline const std::vector<Limb>& limbs() const { return _limbs; }
+
+	// the value rounded to a native floating-point type
+	template<typename Real>
+	Real to_native() const {
+		if (_nan) return std::numeric_limits<Real>::quiet_NaN();
+		if (_inf) return _sign ? -std::numeric_limits<Real>::infinity() : std::numeric_limits<Real>::infinity();
+		if (_zero) return _sign ? -Real(0) : Real(0);
+		// subnormal results have fewer significant digits, so that ldexp is exact
+		int64_t subnormal = int64_t(std::numeric_limits<Real>::min_exponent - 1) - _scale;
+		if (subnormal >= std::numeric_limits<Real>::digits) {
+			// below the smallest subnormal: round to it or to zero, a tie to zero
+			bool up = subnormal == std::numeric_limits<Real>::digits && !isPowerOfTwo();
+			Real magnitude = up ? std::numeric_limits<Real>::denorm_min() : Real(0);
+			return _sign ? -magnitude : magnitude;
+		}
+		int digits = std::numeric_limits<Real>::digits - int(std::max<int64_t>(0, subnormal));
+		mpfloat rounded(*this);
+		rounded.setprecision(size_t(digits));
+		int64_t scale = std::max<int64_t>(std::min<int64_t>(rounded._scale, 1 << 20), -(1 << 20));
+		Real magnitude = std::ldexp(Real(rounded._limbs.back() >> (bitsInLimb - digits)), int(scale) - (digits - 1));
+		return _sign ? -magnitude : magnitude;
+	}
+	long double to_long_double() const { return to_native<long double>(); }
+	double to_double() const { return to_native<double>(); }
+	float to_float() const { return to_native<float>(); }
+
+	// the value rounded to nearest to a value with fbits fraction bits
+	template<size_t fbits>
+	value<fbits> to_value() const {
+		value<fbits> v;
+		if (_nan) { v.setnan(); return v; }
+		if (_inf) { v.setinf(); return v; }
+		if (_zero) { v.setzero(); return v; }
+		mpfloat rounded(*this);
+		rounded.setprecision(fbits + 1);
+		return rounded.truncate<fbits>(false);
+	}
 
-		int64_t magnitude = scale();
-		if (magnitude > 1 || magnitude < 0) {
-			// use scientific notation for non-trivial exponent values
-			return sci_notation(nrDigits);
+	// convert to string containing nrDigits significant digits
+	std::string str(size_t nrDigits = 0) const {
+		if (_nan) return std::string("nan");
+		if (_inf) return std::string(_sign ? "-inf" : "inf");
+		if (nrDigits == 0) nrDigits = size_t(double(_precision) * 0.30102999566398) + 1;
+		std::string digits;
+		int64_t exponent = 0;
+		if (_zero) {
+			digits.assign(nrDigits, '0');
 		}
+		else {
+			exponent = decimal_digits(nrDigits, digits);
+		}
+		// like %g, trailing zeros of the fraction are not shown
+		while (digits.size() > 1 && digits.back() == '0') digits.pop_back();
+		std::string s = (_sign ? "-" : "");
+		if (exponent >= -5 && exponent < int64_t(nrDigits)) {
+			// fixed notation
+			if (exponent < 0) {
+				s += "0." + std::string(size_t(-exponent - 1), '0') + digits;
+			}
+			else {
+				if (digits.size() < size_t(exponent + 1)) digits.resize(size_t(exponent + 1), '0');
+				s += digits.substr(0, size_t(exponent + 1));
+				if (size_t(exponent + 1) < digits.size()) s += "." + digits.substr(size_t(exponent + 1));
+			}
+		}
+		else {
+			// scientific notation for large and small exponents
+			s += digits.substr(0, 1);
+			if (digits.size() > 1) s += "." + digits.substr(1);
+			std::string e = std::to_string(exponent < 0 ? -exponent : exponent);
+			s += (exponent < 0 ? "e-" : "e+") + (e.size() < 2 ? "0" + e : e);
+		}
+		return s;
+	}
 
-		std::string str;
-		int64_t exponent = trimmed(nrDigits, str);
+protected:
+	bool              _sign;      // sign of the number: -1 if true, +1 if false
+	bool              _zero, _inf, _nan;
+	int64_t           _scale;     // binary scale of the most significant bit of the significand
+	size_t            _precision; // number of significant bits
+	std::vector<Limb> _limbs;     // significand, least significant limb first
 
-		if (magnitude == 0) {
-			if (sign)
-				return std::string("-0.0") + str;
-			else
-				return std::string("0.0") + str;
-		}
+	inline static size_t _default_precision = MPFLOAT_DEFAULT_PRECISION;
 
-		std::string before_decimal = std::to_string(coef.back());
+	// HELPER methods
+
+	static size_t nrLimbs(size_t precision) { return (precision + bitsInLimb - 1) / bitsInLimb; }
+	// scale of the least significant bit of a significand of n limbs
+	static int64_t lsb(int64_t scale, size_t n) { return scale - int64_t(n * bitsInLimb - 1); }
 
-		if (exponent >= 0) {
-			if (sign)
-				return std::string("-") + before_decimal + ".0";
-			else
-				return before_decimal + ".0";
+	bool isPowerOfTwo() const {
+		for (size_t i = 0; i + 1 < _limbs.size(); ++i) if (_limbs[i]) return false;
+		return _limbs.back() == (Limb(1) << (bitsInLimb - 1));
+	}
+	mpfloat& setzero(bool negative, size_t precision) { setzero(negative); _precision = precision; return *this; }
+	mpfloat& setinf(bool negative, size_t precision) { setinf(negative); _precision = precision; return *this; }
+	mpfloat& setnan(size_t precision) { setnan(); _precision = precision; return *this; }
+
+	// round the magnitude m * 2^lsb_scale, with a sticky bit for nonzero bits below m, to nearest even with precision bits
+	void round(bool negative, int64_t lsb_scale, std::vector<Limb>& m, bool sticky, size_t precision) {
+		using namespace internal;
+		size_t n = m.size();
+		size_t lz = limb_leading_zeros(m.data(), n);
+		_precision = precision;
+		if (lz == n * bitsInLimb) {
+			setzero(negative);
+			return;
+		}
+		size_t top = n * bitsInLimb - 1 - lz;
+		int64_t scale = lsb_scale + int64_t(top);
+		// align the most significant bit to the top of a word with at least 64 rounding bits below the precision
+		size_t W = nrLimbs(precision) + 1;
+		std::vector<Limb> w(W, 0);
+		if (top + 1 > W * bitsInLimb) {
+			sticky |= limb_shift_right(m.data(), m.data(), n, top + 1 - W * bitsInLimb);
+			std::copy(m.begin(), m.begin() + W, w.begin());
+		}
+		else {
+			std::copy(m.begin(), m.begin() + std::min(n, W), w.begin());
+			limb_shift_left(w.data(), w.data(), W, W * bitsInLimb - 1 - top);
+		}
+		size_t lsbpos = W * bitsInLimb - precision;
+		size_t rpos = lsbpos - 1;
+		bool lsbit = (w[lsbpos / bitsInLimb] >> (lsbpos % bitsInLimb)) & 1;
+		bool roundbit = (w[rpos / bitsInLimb] >> (rpos % bitsInLimb)) & 1;
+		for (size_t i = 0; i < rpos / bitsInLimb; ++i) sticky |= (w[i] != 0);
+		sticky |= (w[rpos / bitsInLimb] & ((Limb(1) << (rpos % bitsInLimb)) - 1)) != 0;
+		// clear the rounding bits
+		for (size_t i = 0; i < lsbpos / bitsInLimb; ++i) w[i] = 0;
+		w[lsbpos / bitsInLimb] &= ~((Limb(1) << (lsbpos % bitsInLimb)) - 1);
+		if (roundbit && (sticky || lsbit)) {
+			if (limb_add_carry(w.data() + lsbpos / bitsInLimb, W - lsbpos / bitsInLimb, Limb(1) << (lsbpos % bitsInLimb))) {
+				// the significand rounded up to the next power of 2
+				w[W - 1] = Limb(1) << (bitsInLimb - 1);
+				++scale;
+			}
 		}
+		_sign = negative;
+		_zero = _inf = _nan = false;
+		_scale = scale;
+		_limbs.assign(w.begin() + 1, w.end());
+	}
 
-		// now the digits after the radix point
-		std::string after_decimal = str.substr((size_t)(str.size() + exponent), (size_t)-exponent);
-		if (sign)
-			return std::string("-") + before_decimal + "." + after_decimal;
-		else
-			return before_decimal + "." + after_decimal;
+	// a significand of n limbs positioned with its most significant bit at bit top of a word of W limbs
+	static std::vector<Limb> place(const std::vector<Limb>& m, int64_t top, size_t W, bool& sticky) {
+		size_t n = m.size();
+		std::vector<Limb> t(W + n, 0);
+		std::copy(m.begin(), m.end(), t.begin() + W);
+		int64_t shift = int64_t((W + n) * bitsInLimb - 1) - top;
+		if (shift >= int64_t((W + n) * bitsInLimb)) {
+			sticky = true;
+			return std::vector<Limb>(W, 0);
+		}
+		sticky = internal::limb_shift_right(t.data(), t.data(), W + n, size_t(shift));
+		t.resize(W);
+		return t;
+	}
 
-		return std::string("bad");
+	// -1, 0, 1 when |*this| is smaller, equal, or larger than |rhs|, both finite and nonzero
+	int compare_magnitude(const mpfloat& rhs) const {
+		if (_scale != rhs._scale) return _scale < rhs._scale ? -1 : 1;
+		size_t na = _limbs.size(), nb = rhs._limbs.size();
+		for (size_t i = 0; i < std::max(na, nb); ++i) {
+			Limb a = (i < na ? _limbs[na - 1 - i] : 0), b = (i < nb ? rhs._limbs[nb - 1 - i] : 0);
+			if (a != b) return a < b ? -1 : 1;
+		}
+		return 0;
 	}
 
-	void test(bool _sign, int _exp, std::vector<BlockType>& _coef) {
-		sign = _sign;
-		coef = _coef;
-		exp = _exp;
+	mpfloat& add(const mpfloat& rhs, bool subtract) {
+		size_t precision = std::max(_precision, rhs._precision);
+		bool rsign = (rhs._sign != subtract);
+		if (_nan || rhs._nan) return setnan(precision);
+		if (_inf || rhs._inf) {
+			if (_inf && rhs._inf && _sign != rsign) return setnan(precision);
+			return setinf(_inf ? _sign : rsign, precision);
+		}
+		if (rhs._zero) {
+			// -0 + -0 = -0, otherwise the sum of zeros is +0
+			if (_zero) return setzero(_sign && rsign, precision);
+			return setprecision(precision);
+		}
+		if (_zero) {
+			*this = rhs;
+			_sign = rsign;
+			return setprecision(precision);
+		}
+		const mpfloat* big = this;
+		const mpfloat* small = &rhs;
+		bool bsign = _sign, ssign = rsign;
+		int order = compare_magnitude(rhs);
+		if (order == 0 && _sign != rsign) return setzero(false, precision);
+		if (order < 0) {
+			std::swap(big, small);
+			std::swap(bsign, ssign);
+		}
+		// a word with a bit of headroom for the carry and at least 64 rounding bits
+		size_t W = nrLimbs(precision) + 2;
+		int64_t top = int64_t(W * bitsInLimb) - 2;
+		bool sticky = false;
+		std::vector<Limb> a = place(big->_limbs, top, W, sticky);
+		std::vector<Limb> b = place(small->_limbs, top - (big->_scale - small->_scale), W, sticky);
+		// the bits of the smaller operand below the word are jammed into its least significant bit
+		if (sticky) b[0] |= 1;
+		if (bsign == ssign) {
+			internal::limb_add(a.data(), a.data(), b.data(), W);
+		}
+		else {
+			internal::limb_sub(a.data(), a.data(), b.data(), W);
+		}
+		round(bsign, big->_scale - top, a, false, precision);
+		return *this;
 	}
-protected:
-	bool                   sign;  // sign of the number: -1 if true, +1 if false, zero is positive
-	int64_t                exp;   // exponent of the number
-	std::vector<BlockType> coef;  // coefficients of the polynomial
 
-	// HELPER methods
+	// truncate to fbits fraction bits, jamming the discarded bits into the least significant bit
+	template<size_t fbits>
+	value<fbits> truncate(bool jam) const {
+		bitblock<fbits> fraction;
+		size_t n = _limbs.size();
+		bool sticky = false;
+		for (size_t i = 0; i < n * bitsInLimb - 1; ++i) {
+			size_t bit = n * bitsInLimb - 2 - i;  // the bits below the hidden bit
+			bool set = (_limbs[bit / bitsInLimb] >> (bit % bitsInLimb)) & 1;
+			if (i < fbits) {
+				fraction.set(fbits - 1 - i, set);
+			}
+			else {
+				sticky |= set;
+			}
+		}
+		if (jam && sticky && fbits > 0) fraction.set(0, true);
+		return value<fbits>(_sign, int(_scale), fraction, false, false);
+	}
 
 	// convert to native floating-point, use conversion rules to cast down to float and double
 	long double toNativeFloatingPoint() const {
-		long double ld = 0;
-		return ld;
+		return to_native<long double>();
+	}
+
+	mpfloat& convert_signed(long long rhs) {
+		return convert_unsigned(rhs < 0 ? uint64_t(0) - uint64_t(rhs) : uint64_t(rhs), rhs < 0);
+	}
+	mpfloat& convert_unsigned(uint64_t rhs, bool negative) {
+		if (rhs == 0) return setzero(false, default_precision());
+		std::vector<Limb> m(1, rhs);
+		round(negative, 0, m, false, std::max<size_t>(default_precision(), 64));
+		return *this;
 	}
 
 	template<typename Ty>
-	mpfloat& float_assign(Ty& rhs) {
-		clear();
-		long long base = (long long)rhs;
-		*this = base;
+	mpfloat& float_assign(Ty rhs) {
+		constexpr size_t digits = std::numeric_limits<Ty>::digits;
+		size_t precision = std::max(default_precision(), digits);
+		if (std::isnan(rhs)) return setnan(precision);
+		if (std::isinf(rhs)) return setinf(std::signbit(rhs), precision);
+		if (rhs == 0) return setzero(std::signbit(rhs), precision);
+		// the significand of a long double has at most 64 bits
+		int exponent;
+		long double fraction = std::frexp(std::fabs((long double)rhs), &exponent);
+		std::vector<Limb> m(1, Limb(std::ldexp(fraction, 64)));
+		round(std::signbit(rhs), int64_t(exponent) - 64, m, false, precision);
 		return *this;
 	}
 
-	// convert to string with nrDigits of significant digits and return the scale
-	// value = str + "10^" + scale
-	int64_t trimmed(size_t nrDigits, std::string& number) const {
-		if (coef.size() == 0) return 0;
-		int64_t exponent = exp;
-		size_t length = coef.size();
-		size_t index = 0; 
-		if (nrDigits == 0) {
-			nrDigits = length * 9;
-		}
-		else {
-			size_t nrSegments = (nrDigits + 17) / 9;
-			if (nrSegments < length) {
-				index = length - nrSegments;
-				exponent += index;
-				length = nrSegments;
+	// the nrDigits most significant decimal digits, rounded to nearest, and the decimal exponent of the first
+	int64_t decimal_digits(size_t nrDigits, std::string& digits) const {
+		// working precision with guard bits for the scaling by a power of 10
+		size_t precision = size_t(double(nrDigits) * 3.3219280948873623) + 64;
+		int64_t exponent = int64_t(std::floor(double(_scale) * 0.30102999566398));
+		for (int attempt = 0; attempt < 3; ++attempt) {
+			mpfloat scaled(*this);
+			scaled._sign = false;
+			scaled.setprecision(precision + size_t(std::abs(double(_scale))) / 16);
+			int64_t power = int64_t(nrDigits) - 1 - exponent;
+			mpfloat p10 = power10(power < 0 ? -power : power, precision + 64);
+			if (power >= 0) scaled *= p10; else scaled /= p10;
+			std::vector<Limb> integer = scaled.integer_part();
+			digits = decimal_string(integer);
+			if (digits.size() > nrDigits) {
+				// rounding carried into a new digit, or the estimated exponent was too small
+				if (digits.size() == nrDigits + 1 && digits.back() == '0' && attempt > 0) {
+					digits.pop_back();
+					return exponent + 1;
+				}
+				++exponent;
+				continue;
 			}
-		}
-		exponent *= 9;
-		char segment[] = "012345678";
-		number.clear();
-		size_t i = length;
-		while (i-- > 0) {
-			BlockType w = coef[i];
-			for (int i = 8; i >= 0; --i) {
-				segment[i] = w % 10 + '0';
-				w /= 10;
+			if (digits.size() < nrDigits) {
+				--exponent;
+				continue;
 			}
-			number += segment;
+			return exponent;
 		}
+		return exponent;
+	}
 
-		// process leading zeros
-		size_t lz = 0;
-		while (number[lz] == '0') ++lz;
-		nrDigits += lz;
-		if (nrDigits < number.size()) {
-			exponent += number.size() - nrDigits;
-			number.resize(nrDigits);
+	// 10^n at a precision
+	static mpfloat power10(int64_t n, size_t precision) {
+		mpfloat result(1ll, precision), base(10ll, precision);
+		while (n > 0) {
+			if (n & 1) result *= base;
+			n >>= 1;
+			if (n) base *= base;
 		}
+		return result;
+	}
 
-		return exponent;
+	// the magnitude rounded to the nearest integer
+	std::vector<Limb> integer_part() const {
+		if (_zero || _scale < -1) return std::vector<Limb>(1, 0);
+		size_t n = _limbs.size();
+		int64_t shift = int64_t(n * bitsInLimb - 1) - _scale;
+		std::vector<Limb> m(_limbs);
+		if (shift <= 0) {
+			m.insert(m.begin(), size_t(-shift) / bitsInLimb + 1, 0);
+			internal::limb_shift_left(m.data(), m.data(), m.size(), size_t(-shift) % bitsInLimb + bitsInLimb);
+			return m;
+		}
+		// keep the half bit to round to nearest, ties away from zero
+		internal::limb_shift_right(m.data(), m.data(), n, size_t(shift - 1));
+		bool half = m[0] & 1;
+		internal::limb_shift_right(m.data(), m.data(), n, 1);
+		if (half) internal::limb_add_carry(m.data(), n, 1);
+		return m;
 	}
 
-	std::string sci_notation(size_t nrDigits) const {
-		if (coef.size() == 0) return std::string("0.0");
-		std::string str;
-		int64_t exponent = trimmed(nrDigits, str);
-		// remove leading zeros
-		str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](int ch) { return (ch != '0'); }));
-		exponent += str.size() - 1;
-		str = str.substr(0, 1) + "." + &str[1];
-		if (exponent != 0) {
-			str += "*10^";
-			str += std::to_string(exponent);
+	// decimal representation of a magnitude, without leading zeros
+	static std::string decimal_string(const std::vector<Limb>& integer) {
+		constexpr uint32_t billion = 1000000000u;
+		std::vector<uint32_t> u(2 * integer.size()), q(u.size()), r(1);
+		for (size_t i = 0; i < integer.size(); ++i) { u[2 * i] = uint32_t(integer[i]); u[2 * i + 1] = uint32_t(integer[i] >> 32); }
+		std::string s;
+		while (internal::limb_significant(u.data(), u.size()) > 0) {
+			internal::limb_divide(q.data(), r.data(), u.data(), u.size(), &billion, 1);
+			uint32_t chunk = r[0];
+			for (int i = 0; i < 9; ++i) {
+				s.push_back(char('0' + chunk % 10));
+				chunk /= 10;
+			}
+			u.swap(q);
 		}
-		if (sign) str = std::string("-") + str;
-		return str;
+		while (s.size() > 1 && s.back() == '0') s.pop_back();
+		std::reverse(s.begin(), s.end());
+		return s;
 	}
 
 private:
-
 	// mpfloat - mpfloat logic comparisons
 	friend bool operator==(const mpfloat& lhs, const mpfloat& rhs);
+	friend bool operator< (const mpfloat& lhs, const mpfloat& rhs);
 
-	// mpfloat - literal logic comparisons
-	friend bool operator==(const mpfloat& lhs, const long long rhs);
-
-	// literal - mpfloat logic comparisons
-	friend bool operator==(const long long lhs, const mpfloat& rhs);
+	friend bool parse(const std::string& number, mpfloat& v);
+	friend mpfloat sqrt(const mpfloat& a);
+	friend mpfloat ldexp(const mpfloat& a, int64_t exponent);
+	template<size_t nbits, size_t es>
+	friend posit<nbits, es>& convert(const mpfloat& v, posit<nbits, es>& p);
 
 	// find the most significant bit set
 	friend signed findMsb(const mpfloat& v);
 };
 
-inline mpfloat& convert(int64_t v, mpfloat& result) {
-	if (0 == v) {
-		result.setzero();
-	}
-	else {
-		// convert 
-	}
-	return result;
-}
+////////////////////////    MPFLOAT functions   /////////////////////////////////
 
-inline mpfloat& convert_unsigned(uint64_t v, mpfloat& result) {
-	if (0 == v) {
-		result.setzero();
-	}
-	else {
-		// convert 
+inline mpfloat abs(const mpfloat& a) {
+	return (a.isneg() ? -a : a);
+}
+
+// correctly rounded square root
+inline mpfloat sqrt(const mpfloat& a) {
+	using Limb = mpfloat::Limb;
+	mpfloat result(a);
+	if (a._nan || a._zero || (a._inf && !a._sign)) return result;
+	if (a._sign) return result.setnan(a._precision);
+	// a = m * 2^e: shift m left by s, with e - s even, for a root of at least precision + 64 bits
+	size_t n = a._limbs.size(), shiftLimbs = 2 * (mpfloat::nrLimbs(a._precision) + 1) - n + 1;
+	int64_t e = mpfloat::lsb(a._scale, n) - int64_t(shiftLimbs * mpfloat::bitsInLimb);
+	std::vector<Limb> radicand(shiftLimbs + n + 1, 0);
+	std::copy(a._limbs.begin(), a._limbs.end(), radicand.begin() + shiftLimbs);
+	if (e & 1) {
+		internal::limb_shift_left(radicand.data(), radicand.data(), radicand.size(), 1);
+		--e;
 	}
+	std::vector<Limb> root = internal::mp_isqrt(radicand);
+	std::vector<Limb> square(2 * root.size());
+	internal::limb_multiply(square.data(), root.data(), root.size(), root.data(), root.size());
+	bool sticky = !std::equal(radicand.begin(), radicand.end(), square.begin()) ||
+		!internal::limb_is_zero(square.data() + radicand.size(), square.size() - radicand.size());
+	result.round(false, e / 2, root, sticky, a._precision);
 	return result;
 }
 
-////////////////////////    MPFLOAT functions   /////////////////////////////////
-
-
-inline mpfloat abs(const mpfloat& a) {
-	return a; // (a < 0 ? -a : a);
+// a * 2^exponent, which is exact
+inline mpfloat ldexp(const mpfloat& a, int64_t exponent) {
+	mpfloat result(a);
+	if (!a._zero && !a._inf && !a._nan) result._scale += exponent;
+	return result;
 }
 
-
 // findMsb takes an mpfloat reference and returns the position of the most significant bit, -1 if v == 0
-
 inline signed findMsb(const mpfloat& v) {
-	return -1; // no significant bit found, all bits are zero
+	if (v._zero || v._inf || v._nan) return -1;
+	return signed(v._scale);
 }
 
-////////////////////////    INTEGER operators   /////////////////////////////////
-
-// divide mpfloat a and b and return result argument
-
-void divide(const mpfloat& a, const mpfloat& b, mpfloat& quotient) {
+// round an mpfloat to a posit
+template<size_t nbits, size_t es>
+inline posit<nbits, es>& convert(const mpfloat& v, posit<nbits, es>& p) {
+	if (v._nan || v._inf) {
+		p.setnar();
+		return p;
+	}
+	if (v._zero) {
+		p.setzero();
+		return p;
+	}
+	// jamming the discarded bits into the last of nbits fraction bits rounds once, at the posit
+	constexpr size_t fbits = nbits;
+	value<fbits> truncated = v.truncate<fbits>(true);
+	return convert(truncated, p);
 }
 
 /// stream operators
 
-// read a mpfloat ASCII format and make a binary mpfloat out of it
-
-bool parse(const std::string& number, mpfloat& value) {
-	bool bSuccess = false;
-
-	return bSuccess;
+// read a decimal ASCII format and make a binary mpfloat out of it: [+-]digits[.digits][(e|E)[+-]digits]
+// the value is scaled by the power of 10 with 64 guard bits and rounded once to the precision of v
+inline bool parse(const std::string& number, mpfloat& v) {
+	using Limb = mpfloat::Limb;
+	size_t precision = v.precision(), i = 0;
+	bool negative = false;
+	if (i < number.size() && (number[i] == '+' || number[i] == '-')) negative = (number[i++] == '-');
+	if (number.compare(i, std::string::npos, "inf") == 0) { v.setinf(negative, precision); return true; }
+	if (number.compare(i, std::string::npos, "nan") == 0) { v.setnan(precision); return true; }
+	// accumulate the digits into an integer
+	std::vector<Limb> integer(1, 0);
+	int64_t exponent = 0;
+	size_t nrDigits = 0;
+	bool fraction = false;
+	for (; i < number.size(); ++i) {
+		char c = number[i];
+		if (c == '.' && !fraction) { fraction = true; continue; }
+		if (c < '0' || c > '9') break;
+		// integer = integer * 10 + digit
+		Limb carry = Limb(c - '0');
+		for (auto& limb : integer) {
+			Limb hi;
+			Limb lo = internal::limb_mul(limb, 10, hi);
+			limb = lo + carry;
+			carry = hi + (limb < lo);
+		}
+		if (carry) integer.push_back(carry);
+		if (fraction) --exponent;
+		++nrDigits;
+	}
+	if (nrDigits == 0) return false;
+	if (i < number.size() && (number[i] == 'e' || number[i] == 'E')) {
+		++i;
+		bool negativeExponent = false;
+		if (i < number.size() && (number[i] == '+' || number[i] == '-')) negativeExponent = (number[i++] == '-');
+		if (i == number.size()) return false;
+		int64_t e = 0;
+		for (; i < number.size() && number[i] >= '0' && number[i] <= '9'; ++i) e = 10 * e + (number[i] - '0');
+		exponent += negativeExponent ? -e : e;
+	}
+	if (i != number.size()) return false;
+	if (internal::limb_is_zero(integer.data(), integer.size())) {
+		v.setzero(negative, precision);
+		return true;
+	}
+	size_t working = std::max(precision, integer.size() * mpfloat::bitsInLimb) + 64;
+	mpfloat m;
+	m.round(negative, 0, integer, false, working);
+	if (exponent != 0) {
+		mpfloat p10 = mpfloat::power10(exponent < 0 ? -exponent : exponent, working);
+		if (exponent > 0) m *= p10; else m /= p10;
+	}
+	v = m;
+	v.setprecision(precision);
+	return true;
 }
 
 // generate an mpfloat format ASCII format
@@ -362,21 +792,21 @@ inline std::istream& operator>>(std::istream& istr, mpfloat& p) {
 	std::string txt;
 	istr >> txt;
 	if (!parse(txt, p)) {
-		std::cerr << "unable to parse -" << txt << "- into a posit value\n";
+		std::cerr << "unable to parse -" << txt << "- into an mpfloat value\n";
 	}
 	return istr;
 }
 
-////////////////// string operators
-
-
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // mpfloat - mpfloat binary logic operators
 
-// equal: precondition is that the storage is properly nulled in all arithmetic paths
-
+// equal: NaN is unequal to everything, and -0 == +0; values of different precision compare by value
 inline bool operator==(const mpfloat& lhs, const mpfloat& rhs) {
-	return true;
+	if (lhs._nan || rhs._nan) return false;
+	if (lhs._zero || rhs._zero) return lhs._zero && rhs._zero;
+	if (lhs._sign != rhs._sign || lhs._inf != rhs._inf) return false;
+	if (lhs._inf) return true;
+	return lhs.compare_magnitude(rhs) == 0;
 }
 
 inline bool operator!=(const mpfloat& lhs, const mpfloat& rhs) {
@@ -384,7 +814,19 @@ inline bool operator!=(const mpfloat& lhs, const mpfloat& rhs) {
 }
 
 inline bool operator< (const mpfloat& lhs, const mpfloat& rhs) {
-	return false; // lhs and rhs are the same
+	if (lhs._nan || rhs._nan) return false;
+	if (lhs._zero && rhs._zero) return false;
+	if (lhs._zero) return !rhs._sign;
+	if (rhs._zero) return lhs._sign;
+	if (lhs._sign != rhs._sign) return lhs._sign;
+	int order;
+	if (lhs._inf || rhs._inf) {
+		order = (lhs._inf && rhs._inf) ? 0 : (lhs._inf ? 1 : -1);
+	}
+	else {
+		order = lhs.compare_magnitude(rhs);
+	}
+	return lhs._sign ? order > 0 : order < 0;
 }
 
 inline bool operator> (const mpfloat& lhs, const mpfloat& rhs) {
@@ -396,12 +838,11 @@ inline bool operator<=(const mpfloat& lhs, const mpfloat& rhs) {
 }
 
 inline bool operator>=(const mpfloat& lhs, const mpfloat& rhs) {
-	return !operator< (lhs, rhs);
+	return operator< (rhs, lhs) || operator==(lhs, rhs);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // mpfloat - literal binary logic operators
-// equal: precondition is that the byte-storage is properly nulled in all arithmetic paths
 
 inline bool operator==(const mpfloat& lhs, const long long rhs) {
 	return operator==(lhs, mpfloat(rhs));
@@ -424,13 +865,11 @@ inline bool operator<=(const mpfloat& lhs, const long long rhs) {
 }
 
 inline bool operator>=(const mpfloat& lhs, const long long rhs) {
-	return !operator< (lhs, rhs);
+	return operator> (lhs, rhs) || operator==(lhs, rhs);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // literal - mpfloat binary logic operators
-// precondition is that the byte-storage is properly nulled in all arithmetic paths
-
 
 inline bool operator==(const long long lhs, const mpfloat& rhs) {
 	return operator==(mpfloat(lhs), rhs);
@@ -453,7 +892,7 @@ inline bool operator<=(const long long lhs, const mpfloat& rhs) {
 }
 
 inline bool operator>=(const long long lhs, const mpfloat& rhs) {
-	return !operator< (lhs, rhs);
+	return operator> (lhs, rhs) || operator==(lhs, rhs);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,417 @@
+#pragma once
+// limb_arithmetic.hpp: multi-precision kernels on arrays of native limbs
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#pragma intrinsic(_umul128)
+#endif
+
+// multiplications of operands with at least LIMB_KARATSUBA_THRESHOLD 64-bit limbs use Karatsuba
+#if !defined(LIMB_KARATSUBA_THRESHOLD)
+#define LIMB_KARATSUBA_THRESHOLD 32
+#endif
+
+namespace sw { namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// multi-precision kernels
+///
+/// Unsigned magnitudes are arrays of limbs, least significant limb first.
+/// Multiplication uses 64-bit limbs with 64x64->128-bit products: schoolbook
+/// for small operands, and Karatsuba for operands of LIMB_KARATSUBA_THRESHOLD limbs and up.
+/// Division is Knuth's Algorithm D on 32-bit digits, so that all the intermediate
+/// quotient estimates fit in native 64-bit arithmetic.
+/// The number systems pack their blocks into limbs or digits, call the kernels, and unpack the result.
+
+namespace internal {
+
+#if defined(__SIZEOF_INT128__)
+// the compiler's 128-bit unsigned integer: __extension__ keeps -Wpedantic quiet about the non-ISO type
+__extension__ typedef unsigned __int128 uint128_t_;
+#endif
+
+// 64x64 -> 128-bit product: returns the lower limb, and the upper limb in hi
+inline uint64_t limb_mul(uint64_t a, uint64_t b, uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+	uint128_t_ p = uint128_t_(a) * b;
+	hi = uint64_t(p >> 64);
+	return uint64_t(p);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(a, b, &hi);
+#else
+	uint64_t a0 = a & 0xFFFFFFFFull, a1 = a >> 32;
+	uint64_t b0 = b & 0xFFFFFFFFull, b1 = b >> 32;
+	uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+	uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFFull) + (p10 & 0xFFFFFFFFull);
+	hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+	return (mid << 32) | (p00 & 0xFFFFFFFFull);
+#endif
+}
+
+// 128/64-bit division of hi:lo by d, requires hi < d: returns the quotient, and the remainder in rem
+inline uint64_t limb_div(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& rem) {
+#if defined(__SIZEOF_INT128__)
+	uint128_t_ n = (uint128_t_(hi) << 64) | lo;
+	rem = uint64_t(n % d);
+	return uint64_t(n / d);
+#else
+	uint64_t q = 0;
+	for (int i = 63; i >= 0; --i) {
+		bool carry = (hi >> 63) != 0;
+		hi = (hi << 1) | (lo >> 63);
+		lo <<= 1;
+		q <<= 1;
+		if (carry || hi >= d) {
+			hi -= d;
+			q |= 1;
+		}
+	}
+	rem = hi;
+	return q;
+#endif
+}
+
+// number of leading zeros of a nonzero limb
+inline int limb_clz(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(x);
+#else
+	int n = 0;
+	while (!(x & 0x8000000000000000ull)) { x <<= 1; ++n; }
+	return n;
+#endif
+}
+
+// number of trailing zeros of a nonzero limb
+inline int limb_ctz(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(x);
+#else
+	int n = 0;
+	while (!(x & 1ull)) { x >>= 1; ++n; }
+	return n;
+#endif
+}
+
+// number of set bits in a limb
+inline int limb_popcount(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(x);
+#else
+	int n = 0;
+	for (; x; x &= x - 1) ++n;
+	return n;
+#endif
+}
+
+// r[0..n) = a[0..n) + b[0..n), returns the carry
+inline uint64_t limb_add(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+	uint64_t carry = 0;
+	for (size_t i = 0; i < n; ++i) {
+		uint64_t s = a[i] + carry;
+		carry = (s < carry);
+		r[i] = s + b[i];
+		carry += (r[i] < s);
+	}
+	return carry;
+}
+
+// r[0..n) = a[0..n) - b[0..n), returns the borrow
+inline uint64_t limb_sub(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+	uint64_t borrow = 0;
+	for (size_t i = 0; i < n; ++i) {
+		uint64_t d = a[i] - b[i];
+		uint64_t bout = (a[i] < b[i]);
+		r[i] = d - borrow;
+		borrow = bout + (d < borrow);
+	}
+	return borrow;
+}
+
+// r[0..n) += c, returns the carry out of the most significant limb
+inline uint64_t limb_add_carry(uint64_t* r, size_t n, uint64_t c) {
+	for (size_t i = 0; i < n && c; ++i) {
+		r[i] += c;
+		c = (r[i] < c);
+	}
+	return c;
+}
+
+// r[0..n) = -a[0..n) in two's complement
+inline void limb_negate(uint64_t* r, const uint64_t* a, size_t n) {
+	uint64_t carry = 1;
+	for (size_t i = 0; i < n; ++i) {
+		r[i] = ~a[i] + carry;
+		carry = (r[i] < carry);
+	}
+}
+
+// true if all limbs of a[0..n) are zero
+inline bool limb_is_zero(const uint64_t* a, size_t n) {
+	for (size_t i = 0; i < n; ++i) if (a[i]) return false;
+	return true;
+}
+
+// compare the magnitudes a[0..n) and b[0..n): returns -1, 0, or 1
+inline int limb_compare(const uint64_t* a, const uint64_t* b, size_t n) {
+	for (size_t i = n; i-- > 0; ) {
+		if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+	}
+	return 0;
+}
+
+// number of leading zeros of a[0..n), 64n when a is zero
+inline size_t limb_leading_zeros(const uint64_t* a, size_t n) {
+	for (size_t i = n; i-- > 0; ) {
+		if (a[i]) return (n - 1 - i) * 64 + size_t(limb_clz(a[i]));
+	}
+	return n * 64;
+}
+
+// r[0..n) = a[0..n) << shift, truncated to n limbs; r may alias a
+inline void limb_shift_left(uint64_t* r, const uint64_t* a, size_t n, size_t shift) {
+	size_t ws = shift / 64, bs = shift % 64;
+	for (size_t i = n; i-- > 0; ) {
+		uint64_t w = (i >= ws) ? (a[i - ws] << bs) : 0;
+		if (bs && i > ws) w |= a[i - ws - 1] >> (64 - bs);
+		r[i] = w;
+	}
+}
+
+// r[0..n) = a[0..n) >> shift; r may alias a
+// returns true when any of the bits that are shifted out are set
+inline bool limb_shift_right(uint64_t* r, const uint64_t* a, size_t n, size_t shift) {
+	size_t ws = shift / 64, bs = shift % 64;
+	bool sticky = false;
+	for (size_t i = 0; i < n && i < ws; ++i) sticky |= (a[i] != 0);
+	if (ws < n && bs) sticky |= (a[ws] << (64 - bs)) != 0;
+	for (size_t i = 0; i < n; ++i) {
+		uint64_t w = (i + ws < n) ? (a[i + ws] >> bs) : 0;
+		if (bs && i + ws + 1 < n) w |= a[i + ws + 1] << (64 - bs);
+		r[i] = w;
+	}
+	return sticky;
+}
+
+// the 64 bits of a[0..n) starting at bit position 'bit', which may be negative: bits outside of a read as zero
+inline uint64_t limb_extract(const uint64_t* a, size_t n, int bit) {
+	if (bit < 0) {
+		if (bit <= -64) return 0;
+		return a[0] << (-bit);
+	}
+	size_t q = size_t(bit) / 64;
+	unsigned s = unsigned(bit) % 64;
+	if (q >= n) return 0;
+	uint64_t w = a[q] >> s;
+	if (s && q + 1 < n) w |= a[q + 1] << (64 - s);
+	return w;
+}
+
+// schoolbook multiplication: r[0..na+nb) = a[0..na) * b[0..nb)
+inline void limb_mul_schoolbook(uint64_t* r, const uint64_t* a, size_t na, const uint64_t* b, size_t nb) {
+	size_t rn = na + nb;
+	if (rn == 0) return;
+	for (size_t i = 0; i < rn; ++i) r[i] = 0;
+	for (size_t i = 0; i < na; ++i) {
+		if (a[i] == 0) continue;
+		uint64_t carry = 0;
+		for (size_t j = 0; j < nb; ++j) {
+			uint64_t hi;
+			uint64_t lo = limb_mul(a[i], b[j], hi);
+			lo += carry;
+			hi += (lo < carry);
+			r[i + j] += lo;
+			hi += (r[i + j] < lo);
+			carry = hi;
+		}
+		r[i + nb] = carry;
+	}
+}
+
+// truncated schoolbook multiplication: r[0..n) = (a[0..n) * b[0..n)) mod 2^(64n)
+inline void limb_mul_low_schoolbook(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+	for (size_t i = 0; i < n; ++i) r[i] = 0;
+	for (size_t i = 0; i < n; ++i) {
+		if (a[i] == 0) continue;
+		uint64_t carry = 0;
+		for (size_t j = 0; i + j < n; ++j) {
+			uint64_t hi;
+			uint64_t lo = limb_mul(a[i], b[j], hi);
+			lo += carry;
+			hi += (lo < carry);
+			r[i + j] += lo;
+			hi += (r[i + j] < lo);
+			carry = hi;
+		}
+	}
+}
+
+// Karatsuba multiplication: r[0..2n) = a[0..n) * b[0..n)
+inline void limb_mul_karatsuba(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+	if (n < LIMB_KARATSUBA_THRESHOLD || n < 4) {
+		limb_mul_schoolbook(r, a, n, b, n);
+		return;
+	}
+	// a = a1 * B^h + a0, b = b1 * B^h + b0, with the upper halves of l = n - h <= h limbs
+	size_t h = (n + 1) / 2;
+	size_t l = n - h;
+	// z0 = a0 * b0 in r[0..2h), z2 = a1 * b1 in r[2h..2n)
+	limb_mul_karatsuba(r, a, b, h);
+	std::vector<uint64_t> t(2 * h, 0);
+	if (l == h) {
+		limb_mul_karatsuba(r + 2 * h, a + h, b + h, l);
+	}
+	else {
+		// zero extend the upper halves to h limbs
+		std::vector<uint64_t> a1(h, 0), b1(h, 0);
+		for (size_t i = 0; i < l; ++i) { a1[i] = a[h + i]; b1[i] = b[h + i]; }
+		limb_mul_karatsuba(t.data(), a1.data(), b1.data(), h);
+		for (size_t i = 0; i < 2 * l; ++i) r[2 * h + i] = t[i];
+	}
+	// (a0 + a1) and (b0 + b1) have h limbs and a carry
+	std::vector<uint64_t> sa(h, 0), sb(h, 0);
+	for (size_t i = 0; i < l; ++i) { sa[i] = a[h + i]; sb[i] = b[h + i]; }
+	uint64_t ca = limb_add(sa.data(), sa.data(), a, h);
+	uint64_t cb = limb_add(sb.data(), sb.data(), b, h);
+	// z1 = (a0 + a1) * (b0 + b1) - z0 - z2, which has 2h + 1 limbs
+	std::vector<uint64_t> z1(2 * h + 1, 0);
+	limb_mul_karatsuba(z1.data(), sa.data(), sb.data(), h);
+	if (ca) z1[2 * h] += limb_add(z1.data() + h, z1.data() + h, sb.data(), h);
+	if (cb) z1[2 * h] += limb_add(z1.data() + h, z1.data() + h, sa.data(), h);
+	if (ca && cb) z1[2 * h] += 1;
+	z1[2 * h] -= limb_sub(z1.data(), z1.data(), r, 2 * h);
+	for (size_t i = 0; i < 2 * h; ++i) t[i] = (i < 2 * l ? r[2 * h + i] : 0);
+	z1[2 * h] -= limb_sub(z1.data(), z1.data(), t.data(), 2 * h);
+	// r += z1 * B^h
+	uint64_t carry = limb_add(r + h, r + h, z1.data(), 2 * h + 1 <= 2 * n - h ? 2 * h + 1 : 2 * n - h);
+	limb_add_carry(r + 3 * h + 1, (3 * h + 1 < 2 * n ? 2 * n - 3 * h - 1 : 0), carry);
+}
+
+// full multiplication: r[0..na+nb) = a[0..na) * b[0..nb)
+inline void limb_multiply(uint64_t* r, const uint64_t* a, size_t na, const uint64_t* b, size_t nb) {
+	if (na == nb && na >= LIMB_KARATSUBA_THRESHOLD) {
+		limb_mul_karatsuba(r, a, b, na);
+	}
+	else {
+		limb_mul_schoolbook(r, a, na, b, nb);
+	}
+}
+
+// truncated multiplication: r[0..n) = (a[0..n) * b[0..n)) mod 2^(64n)
+// a0*b0 is a full Karatsuba product, the cross terms a1*b0 + a0*b1 are truncated products
+inline void limb_multiply_low(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+	if (n < 2 * LIMB_KARATSUBA_THRESHOLD) {
+		limb_mul_low_schoolbook(r, a, b, n);
+		return;
+	}
+	// with h >= n/2, a1*b1*B^(2h) vanishes modulo B^n
+	size_t h = (n + 1) / 2;
+	size_t l = n - h;  // l <= h
+	std::vector<uint64_t> z0(2 * h), cross(l);
+	limb_mul_karatsuba(z0.data(), a, b, h);
+	for (size_t i = 0; i < n; ++i) r[i] = z0[i];
+	// only the lower l limbs of a0 and b0 contribute to the truncated cross terms
+	limb_multiply_low(cross.data(), a + h, b, l);
+	limb_add(r + h, r + h, cross.data(), l);
+	limb_multiply_low(cross.data(), a, b + h, l);
+	limb_add(r + h, r + h, cross.data(), l);
+}
+
+// number of significant digits of a magnitude
+template<typename Digit>
+inline size_t limb_significant(const Digit* u, size_t n) {
+	while (n > 0 && u[n - 1] == 0) --n;
+	return n;
+}
+
+// count of leading zeros of a nonzero 32-bit digit
+inline int limb_nlz(uint32_t x) {
+	int n = 0;
+	if (x <= 0x0000FFFFu) { n += 16; x <<= 16; }
+	if (x <= 0x00FFFFFFu) { n += 8; x <<= 8; }
+	if (x <= 0x0FFFFFFFu) { n += 4; x <<= 4; }
+	if (x <= 0x3FFFFFFFu) { n += 2; x <<= 2; }
+	if (x <= 0x7FFFFFFFu) { n += 1; }
+	return n;
+}
+
+// Knuth Algorithm D: q[0..m) = u[0..m) / v[0..n), r[0..n) = u[0..m) % v[0..n)
+// returns false on division by zero
+inline bool limb_divide(uint32_t* q, uint32_t* r, const uint32_t* u, size_t m, const uint32_t* v, size_t n) {
+	constexpr uint64_t b = (uint64_t(1) << 32);
+	for (size_t i = 0; i < m; ++i) q[i] = 0;
+	for (size_t i = 0; i < n; ++i) r[i] = 0;
+	size_t sv = limb_significant(v, n);
+	if (sv == 0) return false;
+	size_t su = limb_significant(u, m);
+	if (su < sv) {
+		for (size_t i = 0; i < su; ++i) r[i] = u[i];
+		return true;
+	}
+	if (sv == 1) {
+		// short division by a single digit
+		uint64_t rem = 0;
+		for (size_t j = su; j-- > 0; ) {
+			uint64_t num = (rem << 32) | u[j];
+			q[j] = uint32_t(num / v[0]);
+			rem = num - q[j] * uint64_t(v[0]);
+		}
+		r[0] = uint32_t(rem);
+		return true;
+	}
+	// normalize so that the most significant digit of the divisor has its msb set
+	int s = limb_nlz(v[sv - 1]);
+	std::vector<uint32_t> vn(sv), un(su + 1);
+	for (size_t i = sv - 1; i > 0; --i) vn[i] = (v[i] << s) | uint32_t(s ? (uint64_t(v[i - 1]) >> (32 - s)) : 0);
+	vn[0] = v[0] << s;
+	un[su] = uint32_t(s ? (uint64_t(u[su - 1]) >> (32 - s)) : 0);
+	for (size_t i = su - 1; i > 0; --i) un[i] = (u[i] << s) | uint32_t(s ? (uint64_t(u[i - 1]) >> (32 - s)) : 0);
+	un[0] = u[0] << s;
+	for (size_t j = su - sv + 1; j-- > 0; ) {
+		// estimate the quotient digit from the top two digits of the running remainder
+		uint64_t num = (uint64_t(un[j + sv]) << 32) | un[j + sv - 1];
+		uint64_t qhat = num / vn[sv - 1];
+		uint64_t rhat = num - qhat * vn[sv - 1];
+		while (qhat >= b || qhat * vn[sv - 2] > ((rhat << 32) | un[j + sv - 2])) {
+			--qhat;
+			rhat += vn[sv - 1];
+			if (rhat >= b) break;
+		}
+		// multiply and subtract
+		int64_t t = 0;
+		uint64_t k = 0;
+		for (size_t i = 0; i < sv; ++i) {
+			uint64_t p = qhat * vn[i];
+			t = int64_t(un[i + j]) - int64_t(k) - int64_t(p & 0xFFFFFFFFull);
+			un[i + j] = uint32_t(t);
+			k = (p >> 32) - uint64_t(t >> 32);
+		}
+		t = int64_t(un[j + sv]) - int64_t(k);
+		un[j + sv] = uint32_t(t);
+		q[j] = uint32_t(qhat);
+		if (t < 0) {
+			// the estimate was one too large: add back
+			--q[j];
+			k = 0;
+			for (size_t i = 0; i < sv; ++i) {
+				t = int64_t(uint64_t(un[i + j]) + vn[i] + k);
+				un[i + j] = uint32_t(t);
+				k = uint64_t(t) >> 32;
+			}
+			un[j + sv] = uint32_t(un[j + sv] + k);
+		}
+	}
+	// unnormalize the remainder
+	for (size_t i = 0; i < sv; ++i) r[i] = (un[i] >> s) | uint32_t(s ? (uint64_t(un[i + 1]) << (32 - s)) : 0);
+	return true;
+}
+
+} // namespace internal
+
+}} // namespace sw::unum
@@ -0,0 +1,330 @@
+#pragma once
+// limb_radix_conversion.hpp: decimal conversion of multi-precision magnitudes
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "./limb_arithmetic.hpp"
+
+// magnitudes of at least LIMB_RADIX_DC_THRESHOLD 64-bit limbs are converted by divide-and-conquer
+#if !defined(LIMB_RADIX_DC_THRESHOLD)
+#define LIMB_RADIX_DC_THRESHOLD 16
+#endif
+
+namespace sw { namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// decimal radix conversion
+///
+/// Magnitudes are converted through base 10^19, the largest power of ten that fits a 64-bit limb.
+/// Small magnitudes use schoolbook conversion: repeated division by 10^19 with a precomputed
+/// reciprocal in one direction, and Horner accumulation of 19-digit chunks in the other.
+/// Large magnitudes are split, and joined, at the powers 10^(19*2^k). These are computed once per limb count
+/// together with their Barrett reciprocals, so that every level of the recursion costs a few multiplications.
+/// The kernels write into caller-provided buffers, and do not allocate below LIMB_RADIX_DC_THRESHOLD limbs.
+
+namespace internal {
+
+constexpr uint64_t limb_decimal_base = 10000000000000000000ull;  // 10^19
+constexpr size_t limb_decimal_base_digits = 19;
+// floor((2^128 - 1) / 10^19) - 2^64: the reciprocal of the normalized divisor 10^19
+constexpr uint64_t limb_decimal_base_reciprocal = 0xD83C94FB6D2AC34Aull;
+
+// upper bound on the number of decimal digits of a magnitude of nbits bits, at least one
+constexpr size_t limb_decimal_digits(size_t nbits) {
+	return nbits * 30103 / 100000 + 1;
+}
+
+// number of chunks in the largest group of 19-digit chunks that the power table of a limb count joins exactly:
+// the smallest power of two for which 10^(19*group) exceeds 2^(64*nrLimbs)
+constexpr size_t limb_decimal_group(size_t nrLimbs) {
+	size_t group = 1;
+	while (group < nrLimbs + nrLimbs / 64 + 1) group <<= 1;
+	return group;
+}
+
+// floor(log2(x)) for x > 0
+inline size_t limb_log2(size_t x) {
+	size_t k = 0;
+	while (x >>= 1) ++k;
+	return k;
+}
+
+// (u1 * 2^64 + u0) / 10^19 for u1 < 10^19: returns the quotient, and the remainder in r
+// this is the 2-by-1 division by an invariant integer of Moller and Granlund
+inline uint64_t limb_divrem_decimal_base(uint64_t u1, uint64_t u0, uint64_t& r) {
+	uint64_t q1;
+	uint64_t q0 = limb_mul(limb_decimal_base_reciprocal, u1, q1);
+	q0 += u0;
+	q1 += u1 + 1 + (q0 < u0);
+	r = u0 - q1 * limb_decimal_base;
+	if (r > q0) { --q1; r += limb_decimal_base; }
+	if (r >= limb_decimal_base) { ++q1; r -= limb_decimal_base; }
+	return q1;
+}
+
+// a[0..n) /= 10^19, returns the remainder
+inline uint64_t limb_divide_decimal_base(uint64_t* a, size_t n) {
+	uint64_t r = 0;
+	for (size_t i = n; i-- > 0; ) a[i] = limb_divrem_decimal_base(r, a[i], r);
+	return r;
+}
+
+// a[0..n) = a[0..n) * m + c, returns the carry out of the most significant limb
+inline uint64_t limb_mul_small_add(uint64_t* a, size_t n, uint64_t m, uint64_t c) {
+	for (size_t i = 0; i < n; ++i) {
+		uint64_t hi;
+		uint64_t lo = limb_mul(a[i], m, hi);
+		lo += c;
+		c = hi + (lo < c);
+		a[i] = lo;
+	}
+	return c;
+}
+
+// r[0..n) = 5^e modulo 2^(64n)
+inline void limb_power_of_five(uint64_t* r, size_t n, size_t e) {
+	constexpr uint64_t five27 = 7450580596923828125ull;  // 5^27, the largest power of five in a limb
+	for (size_t i = 0; i < n; ++i) r[i] = 0;
+	if (n == 0) return;
+	r[0] = 1;
+	for (; e >= 27; e -= 27) limb_mul_small_add(r, n, five27, 0);
+	uint64_t m = 1;
+	while (e-- > 0) m *= 5;
+	limb_mul_small_add(r, n, m, 0);
+}
+
+// write v as exactly n decimal digits
+inline void limb_write_digits(char* p, uint32_t v, size_t n) {
+	for (size_t i = n; i-- > 0; ) {
+		p[i] = char('0' + v % 10);
+		v /= 10;
+	}
+}
+
+// write a chunk as exactly 19 decimal digits, with leading zeros
+inline void limb_write_decimal_chunk(char* p, uint64_t chunk) {
+	uint64_t lo = chunk % 10000000000ull;
+	limb_write_digits(p, uint32_t(chunk / 10000000000ull), 9);
+	limb_write_digits(p + 9, uint32_t(lo / 100000), 5);
+	limb_write_digits(p + 14, uint32_t(lo % 100000), 5);
+}
+
+// number of decimal digits of a nonzero chunk
+inline size_t limb_decimal_chunk_digits(uint64_t chunk) {
+	size_t n = 1;
+	for (uint64_t p = 10; n < limb_decimal_base_digits && chunk >= p; p *= 10) ++n;
+	return n;
+}
+
+// value of the decimal digits [first, last), at most 19 of them
+inline uint64_t limb_read_decimal_chunk(const char* first, const char* last) {
+	uint64_t chunk = 0;
+	for (; first != last; ++first) chunk = chunk * 10 + uint64_t(*first - '0');
+	return chunk;
+}
+
+// the powers 10^(19*2^k) and their Barrett reciprocals
+class limb_decimal_powers {
+public:
+	explicit limb_decimal_powers(size_t nrLevels) : _power(nrLevels), _reciprocal(nrLevels), _size(nrLevels) {
+		_power[0].assign(1, limb_decimal_base);
+		for (size_t k = 1; k < nrLevels; ++k) {
+			size_t n = size_t(1) << (k - 1);
+			_power[k].assign(2 * n, 0);
+			limb_multiply(_power[k].data(), _power[k - 1].data(), n, _power[k - 1].data(), n);
+		}
+		for (size_t k = 0; k < nrLevels; ++k) {
+			// floor(2^(128m) / P) over the m significant limbs of P, on 32-bit digits
+			size_t m = limb_significant(_power[k].data(), _power[k].size());
+			std::vector<uint32_t> u(4 * m + 1, 0), v(2 * m), q(4 * m + 1), r(2 * m);
+			u[4 * m] = 1;
+			for (size_t i = 0; i < m; ++i) {
+				v[2 * i] = uint32_t(_power[k][i]);
+				v[2 * i + 1] = uint32_t(_power[k][i] >> 32);
+			}
+			limb_divide(q.data(), r.data(), u.data(), u.size(), v.data(), v.size());
+			_reciprocal[k].assign(m + 1, 0);
+			for (size_t i = 0; i < 2 * m + 2; ++i) _reciprocal[k][i / 2] |= uint64_t(q[i]) << (32 * (i % 2));
+			_size[k] = m;
+		}
+	}
+
+	size_t levels() const { return _power.size(); }
+	// 10^(19*2^k) in 2^k limbs
+	const uint64_t* power(size_t k) const { return _power[k].data(); }
+	// number of significant limbs m of 10^(19*2^k)
+	size_t size(size_t k) const { return _size[k]; }
+	// floor(2^(128m) / 10^(19*2^k)) in m + 1 limbs
+	const uint64_t* reciprocal(size_t k) const { return _reciprocal[k].data(); }
+
+private:
+	std::vector<std::vector<uint64_t>> _power, _reciprocal;
+	std::vector<size_t> _size;
+};
+
+// the power table for magnitudes of up to nrLimbs limbs, built on first use
+template<size_t nrLimbs>
+inline const limb_decimal_powers& limb_decimal_power_table() {
+	static const limb_decimal_powers table(limb_log2(limb_decimal_group(nrLimbs)) + 1);
+	return table;
+}
+
+// q[0..m] = u / P, r[0..m) = u % P for P = 10^(19*2^k) with m significant limbs, and u[0..n) < P^2
+inline void limb_divide_decimal_power(uint64_t* q, uint64_t* r, const uint64_t* u, size_t n, const limb_decimal_powers& powers, size_t k) {
+	size_t m = powers.size(k);
+	for (size_t i = 0; i <= m; ++i) q[i] = 0;
+	if (n < m) {
+		for (size_t i = 0; i < m; ++i) r[i] = (i < n ? u[i] : 0);
+		return;
+	}
+	// Barrett: the estimate from the upper limbs of u is at most two below the quotient
+	std::vector<uint64_t> t(m + 1, 0), p(m + 1, 0), product(2 * m + 2), rem(m + 1);
+	for (size_t i = m - 1; i < n; ++i) t[i - m + 1] = u[i];
+	limb_multiply(product.data(), t.data(), m + 1, powers.reciprocal(k), m + 1);
+	for (size_t i = 0; i <= m; ++i) q[i] = product[m + 1 + i];
+	for (size_t i = 0; i < m; ++i) p[i] = powers.power(k)[i];
+	limb_multiply_low(product.data(), q, p.data(), m + 1);
+	for (size_t i = 0; i <= m; ++i) rem[i] = (i < n ? u[i] : 0);
+	limb_sub(rem.data(), rem.data(), product.data(), m + 1);
+	while (limb_compare(rem.data(), p.data(), m + 1) >= 0) {
+		limb_sub(rem.data(), rem.data(), p.data(), m + 1);
+		limb_add_carry(q, m + 1, 1);
+	}
+	for (size_t i = 0; i < m; ++i) r[i] = rem[i];
+}
+
+// split u[0..n) < 10^(19*count) into count = 2^k chunks, least significant first
+inline void limb_split_decimal(uint64_t* chunks, size_t count, const uint64_t* u, size_t n, const limb_decimal_powers& powers) {
+	n = limb_significant(u, n);
+	if (n < LIMB_RADIX_DC_THRESHOLD) {
+		uint64_t w[LIMB_RADIX_DC_THRESHOLD];
+		for (size_t i = 0; i < n; ++i) w[i] = u[i];
+		size_t i = 0;
+		for (; n > 0; n = limb_significant(w, n)) chunks[i++] = limb_divide_decimal_base(w, n);
+		while (i < count) chunks[i++] = 0;
+		return;
+	}
+	size_t half = count / 2;
+	size_t k = limb_log2(half);
+	size_t m = powers.size(k);
+	std::vector<uint64_t> q(m + 1), r(m);
+	limb_divide_decimal_power(q.data(), r.data(), u, n, powers, k);
+	limb_split_decimal(chunks, half, r.data(), m, powers);
+	limb_split_decimal(chunks + half, half, q.data(), m + 1, powers);
+}
+
+// r[0..count) = the value of count = 2^k chunks, least significant first
+inline void limb_join_decimal(uint64_t* r, const uint64_t* chunks, size_t count, const limb_decimal_powers& powers) {
+	if (count < LIMB_RADIX_DC_THRESHOLD) {
+		size_t n = 0;
+		for (size_t i = count; i-- > 0; ) {
+			uint64_t carry = limb_mul_small_add(r, n, limb_decimal_base, chunks[i]);
+			if (carry) r[n++] = carry;
+		}
+		while (n < count) r[n++] = 0;
+		return;
+	}
+	// r = hi * 10^(19*half) + lo, where hi and lo fit in half limbs
+	size_t half = count / 2;
+	std::vector<uint64_t> hi(half), product(count);
+	limb_join_decimal(r, chunks, half, powers);
+	limb_join_decimal(hi.data(), chunks + half, half, powers);
+	limb_multiply(product.data(), hi.data(), half, powers.power(limb_log2(half)), half);
+	uint64_t carry = limb_add(r, r, product.data(), half);
+	for (size_t i = half; i < count; ++i) r[i] = product[i];
+	limb_add_carry(r + half, half, carry);
+}
+
+// write the decimal digits of u[0..nrLimbs) into [first, last), with leading zeros up to minDigits
+// returns the end of the digits, or nullptr when they do not fit
+template<size_t nrLimbs>
+inline char* limb_to_decimal(char* first, char* last, const uint64_t* u, size_t minDigits = 1) {
+	size_t n = limb_significant(u, nrLimbs);
+	uint64_t small[LIMB_RADIX_DC_THRESHOLD + 1];
+	std::vector<uint64_t> large;
+	uint64_t* chunks = small;
+	size_t count = 0;
+	if (n < LIMB_RADIX_DC_THRESHOLD) {
+		uint64_t w[LIMB_RADIX_DC_THRESHOLD];
+		for (size_t i = 0; i < n; ++i) w[i] = u[i];
+		for (; n > 0; n = limb_significant(w, n)) small[count++] = limb_divide_decimal_base(w, n);
+	}
+	else {
+		count = limb_decimal_group(n);
+		large.resize(count);
+		chunks = large.data();
+		limb_split_decimal(chunks, count, u, n, limb_decimal_power_table<nrLimbs>());
+		count = limb_significant(chunks, count);
+	}
+	size_t digits = (count == 0) ? 0 : (count - 1) * limb_decimal_base_digits + limb_decimal_chunk_digits(chunks[count - 1]);
+	if (digits < minDigits) digits = minDigits;
+	if (size_t(last - first) < digits) return nullptr;
+	char* end = first + digits;
+	char* p = end;
+	for (size_t i = 0; i + 1 < count; ++i) {
+		p -= limb_decimal_base_digits;
+		limb_write_decimal_chunk(p, chunks[i]);
+	}
+	for (uint64_t chunk = (count ? chunks[count - 1] : 0); chunk; chunk /= 10) *--p = char('0' + chunk % 10);
+	while (p != first) *--p = '0';
+	return end;
+}
+
+// parse the decimal digits at the start of [first, last) into u[0..nrLimbs), modulo 2^(64*nrLimbs)
+// returns the end of the digits; overflow is set when the value does not fit in nrLimbs limbs
+template<size_t nrLimbs>
+inline const char* limb_from_decimal(uint64_t* u, const char* first, const char* last, bool& overflow) {
+	const char* end = first;
+	while (end != last && *end >= '0' && *end <= '9') ++end;
+	while (first != end && *first == '0') ++first;
+	for (size_t i = 0; i < nrLimbs; ++i) u[i] = 0;
+	overflow = false;
+	size_t nrChunks = (size_t(end - first) + limb_decimal_base_digits - 1) / limb_decimal_base_digits;
+	// chunk i counts from the least significant digits
+	auto chunk = [=](size_t i) {
+		const char* e = end - i * limb_decimal_base_digits;
+		return limb_read_decimal_chunk(size_t(e - first) > limb_decimal_base_digits ? e - limb_decimal_base_digits : first, e);
+	};
+	if (nrChunks < LIMB_RADIX_DC_THRESHOLD) {
+		size_t n = 0;
+		for (size_t i = nrChunks; i-- > 0; ) {
+			uint64_t carry = limb_mul_small_add(u, n, limb_decimal_base, chunk(i));
+			if (carry) {
+				if (n < nrLimbs) u[n++] = carry; else overflow = true;
+			}
+		}
+		return end;
+	}
+	const limb_decimal_powers& powers = limb_decimal_power_table<nrLimbs>();
+	constexpr size_t group = limb_decimal_group(nrLimbs);
+	size_t count = 1;
+	while (count < nrChunks) count <<= 1;
+	if (count <= group) {
+		std::vector<uint64_t> chunks(count), r(count);
+		for (size_t i = 0; i < nrChunks; ++i) chunks[i] = chunk(i);
+		limb_join_decimal(r.data(), chunks.data(), count, powers);
+		for (size_t i = 0; i < count; ++i) {
+			if (i < nrLimbs) u[i] = r[i]; else overflow |= (r[i] != 0);
+		}
+		return end;
+	}
+	// more digits than the largest group: Horner over groups, modulo 2^(64*nrLimbs)
+	overflow = true;
+	std::vector<uint64_t> chunks(group), r(group), p(nrLimbs), product(nrLimbs);
+	for (size_t i = 0; i < nrLimbs; ++i) p[i] = powers.power(limb_log2(group))[i];
+	for (size_t g = (nrChunks + group - 1) / group; g-- > 0; ) {
+		for (size_t i = 0; i < group; ++i) chunks[i] = (g * group + i < nrChunks) ? chunk(g * group + i) : 0;
+		limb_join_decimal(r.data(), chunks.data(), group, powers);
+		limb_multiply_low(product.data(), u, p.data(), nrLimbs);
+		limb_add(u, product.data(), r.data(), nrLimbs);
+	}
+	return end;
+}
+
+} // namespace internal
+
+}} // namespace sw::unum
@@ -0,0 +1,22 @@
+#pragma once
+// lookup_config.hpp: configuration of the table lookup arithmetic of small posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// POSIT_LOOKUP_ARITHMETIC, when set, replaces the arithmetic operators of small posits, such as
+// posit<8,0> and posit<8,1>, with single loads from the compile-time generated operator tables of posit_lookup.hpp
+#if !defined(POSIT_LOOKUP_ARITHMETIC)
+// default is to compute the arithmetic operators
+#define POSIT_LOOKUP_ARITHMETIC 0
+#endif
+
+// posit configurations up to POSIT_LOOKUP_BINARY_NBITS have binary operator tables,
+// and up to POSIT_LOOKUP_UNARY_NBITS unary operator tables
+#if !defined(POSIT_LOOKUP_BINARY_NBITS)
+#define POSIT_LOOKUP_BINARY_NBITS 8
+#endif
+#if !defined(POSIT_LOOKUP_UNARY_NBITS)
+#define POSIT_LOOKUP_UNARY_NBITS 12
+#endif
@@ -0,0 +1,1250 @@
+#pragma once
+// elementary_kernels.hpp: native evaluation kernels for the elementary functions of posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <universal/native/limb_arithmetic.hpp>
+#include <universal/posit/posit_lookup.hpp>
+
+/*
+The elementary functions are evaluated natively, without a round-trip through double.
+
+The kernels operate on xfloat<L>, a working format with a sign, a binary scale, and a normalized
+significand of L 64-bit limbs. The arguments are decoded from the posit exactly, the kernels
+reduce the argument and evaluate table-driven series in the working precision, and the result
+is rounded to the posit once.
+
+Every kernel evaluation comes with an error bound: the truncation errors of the xfloat operations
+are covered by XFLOAT_GUARD_BITS, and the kernel reports the bits by which cancellation and
+argument reduction amplify them. The result is accepted when both ends of the error interval
+round to the same posit. If not, the evaluation is repeated with about twice the number of limbs,
+for up to three stages (Ziv's strategy). Results that are exact, such as exp2 of an integer or
+log2 of a power of 2, are flagged and rounded directly, so that the round-to-nearest-even tie
+rule of the posit encoding is honored.
+
+The rounding is verified unless the error interval of the last stage, at about four times the
+first precision, still contains a rounding boundary. That result is taken to be on the boundary
+and rounds to the even encoding. No proof excludes a result that is not exact but agrees with a
+boundary to that many bits, so the rounding of such results is not verified. The same holds in
+the unlikely event that the reductions of the last stage lose so many bits that the error bound
+is wider than the posit's precision.
+
+Small posits, nbits <= POSIT_ELEMENTARY_LOOKUP_NBITS, use lookup tables of all encodings
+that are generated with the native kernels upon first use.
+*/
+
+// posits with nbits <= POSIT_ELEMENTARY_LOOKUP_NBITS evaluate the unary elementary functions through lookup tables
+#if !defined(POSIT_ELEMENTARY_LOOKUP_NBITS)
+#define POSIT_ELEMENTARY_LOOKUP_NBITS 10
+#endif
+
+namespace sw { namespace unum {
+
+namespace internal {
+
+// number of bits of the error bound that are reserved for the accumulated truncation error of a kernel
+constexpr int XFLOAT_GUARD_BITS = 20;
+// the lost-bits value that flags an exact kernel result
+constexpr int XFLOAT_EXACT = -1;
+// bits lost to cancellation in xf_log: the terms of the table path only cancel for the binary
+// exponents e = 0 and e = -1, where they are below 2 ln(2) in magnitude, and the result is at least
+// log(1 + 2^-6) > 2^-6.1 for |x - 1| >= 2^-6, which is 6.5 bits. The atanh series for |x - 1| < 2^-6
+// does not cancel. log1p, asinh, acosh, and atanh apply xf_log
+// to an argument u >= 0, and log1p(u) >= u / (1 + u) keeps the relative error of u from growing.
+constexpr int XFLOAT_LOG_LOST = 8;
+// bits lost to cancellation in xf_atan2: the table path of xf_atan loses at most 1.6 bits, and
+// each of the reflections pi/2 - t and pi - t loses at most one more, which is 3.6 bits
+constexpr int XFLOAT_ATAN_LOST = 8;
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// xfloat<L>: the working format of the kernels
+///
+/// value = (-1)^sign * significand * 2^(scale - (64*L - 1)), with the significand a
+/// little-endian array of L limbs that is normalized to have its most significant bit set.
+/// All operations truncate.
+template<size_t L>
+class xfloat {
+public:
+	static constexpr int mbits = int(64 * L);   // number of bits of the significand
+
+	xfloat() { setzero(); }
+	xfloat(int v) { set_integer(v < 0, v < 0 ? uint64_t(-int64_t(v)) : uint64_t(v)); }
+	explicit xfloat(long long v) { set_integer(v < 0, v < 0 ? uint64_t(0) - uint64_t(v) : uint64_t(v)); }
+	// conversion of a double is exact
+	explicit xfloat(double v) {
+		setzero();
+		if (v == 0.0 || !std::isfinite(v)) return;
+		int e;
+		double m = std::frexp(std::fabs(v), &e);  // m in [0.5, 1)
+		uint64_t bits = uint64_t(std::ldexp(m, 64));
+		assign(v < 0, &bits, 1, e - 64);
+	}
+	// change of precision: truncates or extends the significand
+	template<size_t M>
+	explicit xfloat(const xfloat<M>& rhs) {
+		setzero();
+		if (rhs.iszero()) return;
+		assign(rhs.sign(), rhs.limbs(), M, rhs.scale() - (xfloat<M>::mbits - 1));
+	}
+	// decoding of a posit is exact when the significand has enough limbs
+	template<size_t nbits, size_t es>
+	explicit xfloat(const posit<nbits, es>& p) {
+		constexpr size_t fbits = (es + 2 >= nbits ? 0 : nbits - 3 - es);
+		setzero();
+		if (p.iszero() || p.isnar()) return;
+		bool                 _s;
+		regime<nbits, es>    _regime;
+		exponent<nbits, es>  _exponent;
+		fraction<fbits>      _fraction;
+		decode(p.get(), _s, _regime, _exponent, _fraction);
+		bitblock<fbits> f = _fraction.get();
+		_sign = _s;
+		_zero = false;
+		_scale = _regime.scale() + _exponent.scale();
+		_limb[L - 1] = uint64_t(1) << 63;
+		for (size_t i = 0; i < fbits; ++i) {
+			int bit = mbits - 2 - int(i);
+			if (bit < 0) break;
+			if (f[fbits - 1 - i]) _limb[bit / 64] |= uint64_t(1) << (bit % 64);
+		}
+	}
+
+	void setzero() {
+		_sign = false;
+		_zero = true;
+		_scale = 0;
+		for (size_t i = 0; i < L; ++i) _limb[i] = 0;
+	}
+
+	// set to +/- m * 2^lsb_scale, with m a little-endian n-limb integer; truncates to L limbs
+	void assign(bool negative, const uint64_t* m, size_t n, int lsb_scale) {
+		int top = int(n) - 1;
+		while (top >= 0 && m[top] == 0) --top;
+		if (top < 0) {
+			setzero();
+			return;
+		}
+		int msb = 64 * top + 63 - limb_clz(m[top]);
+		_sign = negative;
+		_zero = false;
+		_scale = lsb_scale + msb;
+		int lowbit = msb - mbits + 1;
+		for (size_t i = 0; i < L; ++i) _limb[i] = limb_extract(m, n, lowbit + 64 * int(i));
+	}
+
+	bool iszero() const { return _zero; }
+	bool sign() const { return _sign; }
+	bool isneg() const { return !_zero && _sign; }
+	int scale() const { return _scale; }
+	const uint64_t* limbs() const { return _limb; }
+	uint64_t limb(size_t i) const { return _limb[i]; }
+
+	// number of significant bits of the significand
+	int significant_bits() const {
+		if (_zero) return 0;
+		for (size_t i = 0; i < L; ++i) {
+			if (_limb[i]) return mbits - int(64 * i) - limb_ctz(_limb[i]);
+		}
+		return 0;
+	}
+	bool ispowerof2() const { return !_zero && significant_bits() == 1; }
+
+	// approximation of the value, only used to select table entries and initial approximations
+	double to_double() const {
+		if (_zero) return 0.0;
+		double d = std::ldexp(double(_limb[L - 1]), _scale - 63);
+		return _sign ? -d : d;
+	}
+
+	xfloat operator-() const {
+		xfloat r(*this);
+		if (!r._zero) r._sign = !r._sign;
+		return r;
+	}
+	xfloat& set_sign(bool negative) {
+		if (!_zero) _sign = negative;
+		return *this;
+	}
+	xfloat& scale_by(int e) {
+		if (!_zero) _scale += e;
+		return *this;
+	}
+
+private:
+	bool     _sign;
+	bool     _zero;
+	int      _scale;
+	uint64_t _limb[L];
+
+	void set_integer(bool negative, uint64_t magnitude) {
+		setzero();
+		assign(negative, &magnitude, 1, 0);
+	}
+};
+
+template<size_t L>
+inline xfloat<L> xf_abs(const xfloat<L>& x) {
+	xfloat<L> r(x);
+	return r.set_sign(false);
+}
+
+template<size_t L>
+inline xfloat<L> xf_ldexp(const xfloat<L>& x, int e) {
+	xfloat<L> r(x);
+	return r.scale_by(e);
+}
+
+// compare the magnitudes: -1, 0, 1
+template<size_t L>
+inline int xf_compare_magnitude(const xfloat<L>& a, const xfloat<L>& b) {
+	if (a.iszero()) return b.iszero() ? 0 : -1;
+	if (b.iszero()) return 1;
+	if (a.scale() != b.scale()) return a.scale() < b.scale() ? -1 : 1;
+	for (int i = int(L) - 1; i >= 0; --i) {
+		if (a.limb(size_t(i)) != b.limb(size_t(i))) return a.limb(size_t(i)) < b.limb(size_t(i)) ? -1 : 1;
+	}
+	return 0;
+}
+
+// exact equality of value
+template<size_t L>
+inline bool xf_equal(const xfloat<L>& a, const xfloat<L>& b) {
+	return a.sign() == b.sign() && xf_compare_magnitude(a, b) == 0;
+}
+
+// a + b or a - b: the operands are aligned in L+1 limbs, so that the truncation error is bounded by one ulp
+template<size_t L>
+xfloat<L> xf_add(const xfloat<L>& a, const xfloat<L>& b, bool subtract) {
+	bool bsign = b.sign() ^ subtract;
+	if (b.iszero()) return a;
+	if (a.iszero()) {
+		xfloat<L> r(b);
+		return r.set_sign(bsign);
+	}
+	const xfloat<L>* big = &a;
+	const xfloat<L>* small = &b;
+	bool bigsign = a.sign(), smallsign = bsign;
+	if (xf_compare_magnitude(a, b) < 0) {
+		big = &b;
+		small = &a;
+		bigsign = bsign;
+		smallsign = a.sign();
+	}
+	int d = big->scale() - small->scale();
+	if (d > 64 * int(L + 1)) return bigsign == big->sign() ? *big : -*big;
+
+	uint64_t acc[L + 2], frame[L + 1], addend[L + 1];
+	acc[0] = 0;
+	frame[0] = 0;
+	for (size_t i = 0; i < L; ++i) {
+		acc[i + 1] = big->limb(i);
+		frame[i + 1] = small->limb(i);
+	}
+	acc[L + 1] = 0;
+	for (size_t i = 0; i <= L; ++i) addend[i] = limb_extract(frame, L + 1, 64 * int(i) + d);
+	if (bigsign == smallsign) {
+		uint64_t carry = 0;
+		for (size_t i = 0; i <= L; ++i) {
+			uint64_t s = acc[i] + addend[i];
+			uint64_t c1 = s < acc[i];
+			s += carry;
+			uint64_t c2 = s < carry;
+			acc[i] = s;
+			carry = c1 | c2;
+		}
+		acc[L + 1] = carry;
+	}
+	else {
+		uint64_t borrow = 0;
+		for (size_t i = 0; i <= L; ++i) {
+			uint64_t s = acc[i] - addend[i];
+			uint64_t b1 = acc[i] < addend[i];
+			uint64_t b2 = s < borrow;
+			acc[i] = s - borrow;
+			borrow = b1 | b2;
+		}
+	}
+	xfloat<L> r;
+	r.assign(bigsign, acc, L + 2, big->scale() - (xfloat<L>::mbits - 1) - 64);
+	return r;
+}
+
+template<size_t L>
+inline xfloat<L> operator+(const xfloat<L>& a, const xfloat<L>& b) { return xf_add(a, b, false); }
+template<size_t L>
+inline xfloat<L> operator-(const xfloat<L>& a, const xfloat<L>& b) { return xf_add(a, b, true); }
+
+template<size_t L>
+xfloat<L> operator*(const xfloat<L>& a, const xfloat<L>& b) {
+	xfloat<L> r;
+	if (a.iszero() || b.iszero()) return r;
+	uint64_t p[2 * L];
+	for (size_t i = 0; i < 2 * L; ++i) p[i] = 0;
+	for (size_t i = 0; i < L; ++i) {
+		uint64_t carry = 0;
+		for (size_t j = 0; j < L; ++j) {
+			uint64_t hi, lo = limb_mul(a.limb(i), b.limb(j), hi);
+			lo += p[i + j];
+			hi += (lo < p[i + j]);
+			lo += carry;
+			hi += (lo < carry);
+			p[i + j] = lo;
+			carry = hi;
+		}
+		p[i + L] = carry;
+	}
+	r.assign(a.sign() ^ b.sign(), p, 2 * L, a.scale() + b.scale() - 2 * (xfloat<L>::mbits - 1));
+	return r;
+}
+
+// multiply by a small unsigned integer
+template<size_t L>
+xfloat<L> xf_mul_small(const xfloat<L>& x, uint64_t m) {
+	xfloat<L> r;
+	if (x.iszero() || m == 0) return r;
+	uint64_t p[L + 1];
+	uint64_t carry = 0;
+	for (size_t i = 0; i < L; ++i) {
+		uint64_t hi, lo = limb_mul(x.limb(i), m, hi);
+		lo += carry;
+		hi += (lo < carry);
+		p[i] = lo;
+		carry = hi;
+	}
+	p[L] = carry;
+	r.assign(x.sign(), p, L + 1, x.scale() - (xfloat<L>::mbits - 1));
+	return r;
+}
+
+// divide by a small unsigned integer, with a guard limb for the normalization shift
+template<size_t L>
+xfloat<L> xf_div_small(const xfloat<L>& x, uint64_t d) {
+	xfloat<L> r;
+	if (x.iszero()) return r;
+	uint64_t q[L + 1];
+	uint64_t rem = 0;
+	for (int i = int(L) - 1; i >= 0; --i) q[i + 1] = limb_div(rem, x.limb(size_t(i)), d, rem);
+	q[0] = limb_div(rem, 0, d, rem);
+	r.assign(x.sign(), q, L + 1, x.scale() - (xfloat<L>::mbits - 1) - 64);
+	return r;
+}
+
+// reciprocal by Newton iteration from a double precision approximation
+template<size_t L>
+xfloat<L> xf_reciprocal(const xfloat<L>& b) {
+	double m = std::ldexp(double(b.limb(L - 1) >> 11), -52);  // [1, 2)
+	xfloat<L> y(1.0 / m);
+	y.scale_by(-b.scale());
+	y.set_sign(b.sign());
+	const xfloat<L> one(1);
+	for (int bits = 48; bits < xfloat<L>::mbits; bits *= 2) {
+		y = y + y * (one - b * y);
+	}
+	return y;
+}
+
+template<size_t L>
+inline xfloat<L> operator/(const xfloat<L>& a, const xfloat<L>& b) {
+	return a * xf_reciprocal(b);
+}
+
+// square root by Newton iteration on the reciprocal square root
+template<size_t L>
+xfloat<L> xf_sqrt(const xfloat<L>& a) {
+	if (a.iszero()) return a;
+	int e = a.scale() >= 0 ? a.scale() / 2 : -((1 - a.scale()) / 2);  // floor(scale / 2)
+	xfloat<L> t = xf_ldexp(a, -2 * e);   // [1, 4)
+	xfloat<L> y(1.0 / std::sqrt(t.to_double()));
+	const xfloat<L> one(1);
+	for (int bits = 48; bits < xfloat<L>::mbits; bits *= 2) {
+		y = y + xf_ldexp(y * (one - t * y * y), -1);
+	}
+	xfloat<L> s = t * y;
+	s = s + xf_ldexp(y * (t - s * s), -1);
+	return s.scale_by(e);
+}
+
+// split x into the nearest integer n and the remainder f = x - n, |f| <= 1/2
+// returns the low 64 bits of n in two's complement
+template<size_t L>
+uint64_t xf_split_nearest(const xfloat<L>& x, xfloat<L>& f) {
+	constexpr int mbits = xfloat<L>::mbits;
+	f.setzero();
+	if (x.iszero()) return 0;
+	if (x.scale() < -1) {
+		f = x;
+		return 0;
+	}
+	uint64_t n = 0;
+	if (x.scale() >= mbits - 1) {
+		// x is an integer
+		int shift = x.scale() - (mbits - 1);
+		n = shift >= 64 ? 0 : (x.limb(0) << shift);
+	}
+	else {
+		int fb = mbits - 1 - x.scale();      // number of fraction bits: [1, mbits]
+		uint64_t m[L];
+		for (size_t i = 0; i < L; ++i) m[i] = x.limb(i);
+		n = limb_extract(m, L, fb);
+		if (fb < mbits && mbits - fb < 64) n &= (uint64_t(1) << (mbits - fb)) - 1;
+		// isolate the fraction bits
+		for (size_t i = 0; i < L; ++i) {
+			int lo = 64 * int(i);
+			if (lo >= fb) m[i] = 0;
+			else if (lo + 64 > fb) m[i] &= (uint64_t(1) << (fb - lo)) - 1;
+		}
+		int half = fb - 1;
+		bool roundup = (m[half / 64] >> (half % 64)) & 0x1;
+		bool fsign = x.sign();
+		if (roundup) {
+			// f = 1 - fraction: two's complement of the fb-bit field
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < L; ++i) {
+				uint64_t v = 0 - m[i] - borrow;
+				borrow = (m[i] | borrow) != 0;
+				m[i] = v;
+			}
+			for (size_t i = 0; i < L; ++i) {
+				int lo = 64 * int(i);
+				if (lo >= fb) m[i] = 0;
+				else if (lo + 64 > fb) m[i] &= (uint64_t(1) << (fb - lo)) - 1;
+			}
+			fsign = !fsign;
+			++n;
+		}
+		f.assign(fsign, m, L, x.scale() - (mbits - 1));
+	}
+	return x.sign() ? uint64_t(0) - n : n;
+}
+
+// is x an integer
+template<size_t L>
+inline bool xf_isinteger(const xfloat<L>& x) {
+	xfloat<L> f;
+	xf_split_nearest(x, f);
+	return f.iszero();
+}
+
+// exact integer power when the significand has room for the result
+template<size_t L>
+xfloat<L> xf_integer_power(const xfloat<L>& base, uint64_t n) {
+	xfloat<L> result(1), b(base);
+	while (n) {
+		if (n & 0x1) result = result * b;
+		n >>= 1;
+		if (n) b = b * b;
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// series
+
+// number of terms N for which x^N/N! < 2^-(mbits + 8), with |x| < 2^(xscale + 1)
+inline unsigned xf_taylor_terms(int xscale, int mbits) {
+	double bits = 0.0;
+	unsigned n = 0;
+	double lg = double(-xscale - 1);
+	while (bits < double(mbits + 8) && n < 4096) {
+		++n;
+		bits += lg + std::log2(double(n));
+	}
+	return n;
+}
+
+// atanh(z) = z + z^3/3 + z^5/5 + ...
+template<size_t L>
+xfloat<L> xf_atanh_series(const xfloat<L>& z) {
+	if (z.iszero()) return z;
+	xfloat<L> z2 = z * z, p = z, sum = z;
+	for (uint64_t k = 1; ; ++k) {
+		p = p * z2;
+		xfloat<L> t = xf_div_small(p, 2 * k + 1);
+		if (t.iszero() || t.scale() < sum.scale() - xfloat<L>::mbits - 2) break;
+		sum = sum + t;
+	}
+	return sum;
+}
+
+// atan(z) = z - z^3/3 + z^5/5 - ...
+template<size_t L>
+xfloat<L> xf_atan_series(const xfloat<L>& z) {
+	if (z.iszero()) return z;
+	xfloat<L> z2 = z * z, p = z, sum = z;
+	for (uint64_t k = 1; ; ++k) {
+		p = p * z2;
+		xfloat<L> t = xf_div_small(p, 2 * k + 1);
+		if (t.iszero() || t.scale() < sum.scale() - xfloat<L>::mbits - 2) break;
+		sum = (k & 0x1) ? sum - t : sum + t;
+	}
+	return sum;
+}
+
+// atan(1/n) for a small integer n
+template<size_t L>
+xfloat<L> xf_atan_inverse(uint64_t n) {
+	xfloat<L> p = xf_div_small(xfloat<L>(1), n), sum = p;
+	for (uint64_t k = 1; ; ++k) {
+		p = xf_div_small(p, n * n);
+		xfloat<L> t = xf_div_small(p, 2 * k + 1);
+		if (t.iszero() || t.scale() < sum.scale() - xfloat<L>::mbits - 2) break;
+		sum = (k & 0x1) ? sum - t : sum + t;
+	}
+	return sum;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// constants, computed once per precision with an extra limb
+
+// ln(2) = 2 * atanh(1/3)
+template<size_t L>
+const xfloat<L>& xf_ln2() {
+	static const xfloat<L> ln2 = xfloat<L>(xf_ldexp(xf_atanh_series(xf_div_small(xfloat<L + 1>(1), 3)), 1));
+	return ln2;
+}
+
+// pi = 16 * atan(1/5) - 4 * atan(1/239)
+template<size_t L>
+const xfloat<L>& xf_pi() {
+	static const xfloat<L> pi = xfloat<L>(xf_ldexp(xf_atan_inverse<L + 1>(5), 4) - xf_ldexp(xf_atan_inverse<L + 1>(239), 2));
+	return pi;
+}
+
+template<size_t L>
+const xfloat<L>& xf_half_pi() {
+	static const xfloat<L> half_pi = xf_ldexp(xf_pi<L>(), -1);
+	return half_pi;
+}
+
+template<size_t L>
+const xfloat<L>& xf_two_over_pi() {
+	static const xfloat<L> two_over_pi = xfloat<L>(xf_reciprocal(xf_half_pi<L + 1>()));
+	return two_over_pi;
+}
+
+template<size_t L> xfloat<L> xf_log(const xfloat<L>& x);
+
+template<size_t L>
+const xfloat<L>& xf_ln10() {
+	static const xfloat<L> ln10 = xfloat<L>(xf_log(xfloat<L + 1>(10)));
+	return ln10;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// table-driven kernels
+
+// log table: m in [1 + i/64, 1 + (i+1)/64) is multiplied by r_i = R_i / 1024 ~ 1/m, and log(m) = log(m * r_i) - log(r_i)
+template<size_t L>
+struct xf_log_table {
+	static constexpr unsigned size = 64;
+	uint64_t   R[size];
+	xfloat<L>  minus_log_r[size];
+	xf_log_table() {
+		for (unsigned i = 0; i < size; ++i) {
+			R[i] = uint64_t(std::lround(1024.0 / (1.0 + (double(i) + 0.5) / 64.0)));
+			// log(r) = 2 * atanh((r - 1)/(r + 1))
+			xfloat<L + 1> r = xf_ldexp(xfloat<L + 1>((long long)R[i]), -10);
+			xfloat<L + 1> one(1);
+			xfloat<L + 1> logr = xf_ldexp(xf_atanh_series((r - one) / (r + one)), 1);
+			minus_log_r[i] = xfloat<L>(-logr);
+		}
+	}
+};
+
+template<size_t L>
+const xf_log_table<L>& xf_get_log_table() {
+	static const xf_log_table<L> table;
+	return table;
+}
+
+// atan table: atan(a) = atan(c_i) + atan((a - c_i)/(1 + a c_i)) with c_i = i/64
+template<size_t L>
+struct xf_atan_table {
+	static constexpr unsigned size = 65;
+	xfloat<L>  atan_c[size];
+	xf_atan_table() {
+		using X = xfloat<L + 1>;
+		const X one(1);
+		for (unsigned i = 0; i < size; ++i) {
+			// three argument halvings: atan(c) = 2 atan(c / (1 + sqrt(1 + c^2)))
+			X c = xf_ldexp(X(int(i)), -6);
+			for (int h = 0; h < 3; ++h) c = c / (one + xf_sqrt(one + c * c));
+			atan_c[i] = xfloat<L>(xf_ldexp(xf_atan_series(c), 3));
+		}
+	}
+};
+
+template<size_t L>
+const xf_atan_table<L>& xf_get_atan_table() {
+	static const xf_atan_table<L> table;
+	return table;
+}
+
+// e^r - 1 for |r| < 1: the argument is scaled down to |r| < 2^-q, the Taylor series is evaluated,
+// and the result is squared back up in the expm1 form e^2a - 1 = (e^a - 1)(e^a + 1)
+template<size_t L>
+xfloat<L> xf_expm1_core(const xfloat<L>& r, int& lost) {
+	if (r.iszero()) return r;
+	int q = int(std::sqrt(double(xfloat<L>::mbits) / 2.0));
+	int s = r.scale() + q > 0 ? r.scale() + q : 0;
+	xfloat<L> x = xf_ldexp(r, -s);
+	unsigned N = xf_taylor_terms(x.scale(), xfloat<L>::mbits);
+	const xfloat<L> one(1), two(2);
+	xfloat<L> p = one;
+	for (unsigned n = N; n >= 2; --n) p = one + xf_div_small(p * x, n);
+	xfloat<L> t = p * x;
+	for (int i = 0; i < s; ++i) t = t * (t + two);
+	lost += s;
+	return t;
+}
+
+// e^x, |x| < 2^20
+template<size_t L>
+xfloat<L> xf_exp(const xfloat<L>& x, int& lost) {
+	const xfloat<L>& ln2 = xf_ln2<L>();
+	long long k = (long long)std::llround(x.to_double() / 0.69314718055994530942);
+	xfloat<L> r = k ? x - xfloat<L>(k) * ln2 : x;
+	xfloat<L> y = xfloat<L>(1) + xf_expm1_core(r, lost);
+	for (long long a = (k < 0 ? -k : k); a; a >>= 1) ++lost;
+	return y.scale_by(int(k));
+}
+
+// e^x - 1
+template<size_t L>
+xfloat<L> xf_expm1(const xfloat<L>& x, int& lost) {
+	if (x.scale() < -1) return xf_expm1_core(x, lost);
+	lost += 2;
+	return xf_exp(x, lost) - xfloat<L>(1);
+}
+
+// natural logarithm, x > 0
+template<size_t L>
+xfloat<L> xf_log(const xfloat<L>& x) {
+	const xfloat<L> one(1), two(2);
+	xfloat<L> u = x - one;
+	if (u.iszero()) return u;
+	if (u.scale() < -6) {
+		// |x - 1| < 1/64: log(x) = 2 atanh(u / (2 + u)), without cancellation
+		return xf_ldexp(xf_atanh_series(u / (two + u)), 1);
+	}
+	const xf_log_table<L>& table = xf_get_log_table<L>();
+	int e = x.scale();
+	xfloat<L> m = xf_ldexp(xf_abs(x), -e);                        // [1, 2)
+	unsigned i = unsigned(m.limb(L - 1) >> 57) & 0x3F;
+	xfloat<L> w = xf_ldexp(xf_mul_small(m, table.R[i]), -10) - one;  // |w| < 2^-6.8
+	xfloat<L> y = xf_ldexp(xf_atanh_series(w / (two + w)), 1) + table.minus_log_r[i];
+	if (e) y = y + xfloat<L>(e) * xf_ln2<L>();
+	return y;
+}
+
+// log(1 + x), x > -1
+template<size_t L>
+xfloat<L> xf_log1p(const xfloat<L>& x) {
+	if (x.scale() < -6) {
+		return xf_ldexp(xf_atanh_series(x / (xfloat<L>(2) + x)), 1);
+	}
+	return xf_log(xfloat<L>(1) + x);
+}
+
+// reduce x by multiples of pi/2 in a precision of R limbs: x = n * pi/2 + r, returns n mod 4
+template<size_t L, size_t R>
+unsigned xf_reduce_half_pi(const xfloat<L>& x, xfloat<L>& r, int& lost) {
+	xfloat<R> t = xfloat<R>(x) * xf_two_over_pi<R>();
+	xfloat<R> f;
+	uint64_t n = xf_split_nearest(t, f);
+	if (f.iszero()) {
+		r.setzero();
+		lost = xfloat<L>::mbits;
+		return unsigned(n & 0x3);
+	}
+	// t carries a relative error of a few ulps, which f inherits as an absolute error
+	int precision = xfloat<R>::mbits - 3 - t.scale() + f.scale();
+	if (precision < xfloat<L>::mbits) lost += xfloat<L>::mbits - precision;
+	r = xfloat<L>(f * xf_half_pi<R>());
+	return unsigned(n & 0x3);
+}
+
+// argument reduction for the trigonometric functions of posit<nbits, es> arguments
+template<size_t nbits, size_t es, size_t L>
+unsigned xf_trigonometric_reduction(const xfloat<L>& x, xfloat<L>& r, int& lost) {
+	if (x.scale() < -1) {   // |x| < 1/2 < pi/4
+		r = x;
+		return 0;
+	}
+	if (x.scale() < 62) return xf_reduce_half_pi<L, L + 2>(x, r, lost);
+	// large arguments need pi to the full dynamic range of the posit
+	constexpr size_t RL = L + 2 + size_t(maxpos_scale<nbits, es>() + 63) / 64;
+	return xf_reduce_half_pi<L, RL>(x, r, lost);
+}
+
+// sin(r) and cos(r) for |r| <= pi/4
+template<size_t L>
+xfloat<L> xf_sin_taylor(const xfloat<L>& r) {
+	if (r.iszero()) return r;
+	const xfloat<L> one(1);
+	xfloat<L> r2 = r * r, p = one;
+	unsigned N = (xf_taylor_terms(r.scale(), xfloat<L>::mbits) + 1) / 2;
+	for (uint64_t n = N; n >= 1; --n) p = one - xf_div_small(p * r2, (2 * n) * (2 * n + 1));
+	return r * p;
+}
+
+template<size_t L>
+xfloat<L> xf_cos_taylor(const xfloat<L>& r) {
+	const xfloat<L> one(1);
+	if (r.iszero()) return one;
+	xfloat<L> r2 = r * r, p = one;
+	unsigned N = (xf_taylor_terms(r.scale(), xfloat<L>::mbits) + 1) / 2;
+	for (uint64_t n = N; n >= 1; --n) p = one - xf_div_small(p * r2, (2 * n - 1) * (2 * n));
+	return p;
+}
+
+// atan(x)
+template<size_t L>
+xfloat<L> xf_atan(const xfloat<L>& x) {
+	const xfloat<L> one(1);
+	xfloat<L> a = xf_abs(x);
+	bool invert = xf_compare_magnitude(a, one) > 0;
+	if (invert) a = xf_reciprocal(a);
+	int i = int(std::lround(a.to_double() * 64.0));
+	xfloat<L> y;
+	if (i == 0) {
+		y = xf_atan_series(a);
+	}
+	else {
+		xfloat<L> c = xf_ldexp(xfloat<L>(i), -6);
+		y = xf_atan_series((a - c) / (one + a * c)) + xf_get_atan_table<L>().atan_c[i];
+	}
+	if (invert) y = xf_half_pi<L>() - y;
+	return y.set_sign(x.sign());
+}
+
+// atan2(y, x)
+template<size_t L>
+xfloat<L> xf_atan2(const xfloat<L>& y, const xfloat<L>& x) {
+	if (x.iszero()) {
+		if (y.iszero()) return y;
+		xfloat<L> r(xf_half_pi<L>());
+		return r.set_sign(y.sign());
+	}
+	if (y.iszero()) return x.sign() ? xf_pi<L>() : y;
+	xfloat<L> t = xf_atan(xf_abs(y) / xf_abs(x));
+	if (x.sign()) t = xf_pi<L>() - t;
+	return t.set_sign(y.sign());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// elementary function evaluation
+
+enum class elementary_function {
+	exp, exp2, exp10, expm1,
+	log, log2, log10, log1p,
+	sin, cos, tan, cot, sec, csc,
+	atan, asin, acos,
+	sinh, cosh, tanh, asinh, acosh, atanh
+};
+
+// bit length of a positive integer
+constexpr int xf_bit_length(unsigned long long v) {
+	return v ? 1 + xf_bit_length(v >> 1) : 0;
+}
+
+// evaluate an elementary function in precision L
+// lost returns the number of bits of precision lost in the evaluation, or XFLOAT_EXACT when the result is exact.
+// The budget starts at 4 bits for the operations that combine the series results, and the argument
+// reductions add what they lose: the bit length of the multiple of ln(2) in xf_exp, the squarings of
+// xf_expm1_core, and the cancellation of x - n pi/2 in xf_reduce_half_pi. e^x - 1 for |x| >= 1/2
+// and e^a - 1/e^a for a >= 1 lose less than 2 bits to the subtraction.
+template<size_t nbits, size_t es, size_t L>
+xfloat<L> xf_elementary(elementary_function f, const xfloat<L>& x, int& lost) {
+	using X = xfloat<L>;
+	const X one(1), two(2);
+	lost = 4;
+	switch (f) {
+	case elementary_function::exp:
+		return xf_exp(x, lost);
+	case elementary_function::exp2:
+	{
+		X r;
+		uint64_t n = xf_split_nearest(x, r);
+		if (r.iszero()) {
+			lost = XFLOAT_EXACT;
+			return X(1).scale_by(int(int64_t(n)));
+		}
+		X y = xf_exp(r * xf_ln2<L>(), lost);
+		return y.scale_by(int(int64_t(n)));
+	}
+	case elementary_function::exp10:
+	{
+		// exact powers of 10
+		if (!x.isneg() && xf_isinteger(x) && x.scale() < 30) {
+			X r;
+			uint64_t n = xf_split_nearest(x, r);
+			if (n * 3322 / 1000 + 4 < uint64_t(X::mbits)) {
+				lost = XFLOAT_EXACT;
+				return xf_integer_power(X(10), n);
+			}
+		}
+		return xf_exp(x * xf_ln10<L>(), lost);
+	}
+	case elementary_function::expm1:
+		return xf_expm1(x, lost);
+	case elementary_function::log:
+		lost = XFLOAT_LOG_LOST;
+		return xf_log(x);
+	case elementary_function::log2:
+		if (x.ispowerof2()) {
+			lost = XFLOAT_EXACT;
+			return X(x.scale());
+		}
+		lost = XFLOAT_LOG_LOST;
+		return xf_log(x) / xf_ln2<L>();
+	case elementary_function::log10:
+	{
+		lost = XFLOAT_LOG_LOST;
+		X y = xf_log(x) / xf_ln10<L>();
+		X r;
+		uint64_t n = xf_split_nearest(y, r);
+		// exact powers of 10
+		bool nearinteger = r.iszero() || r.scale() < y.scale() - X::mbits / 2;
+		if (nearinteger && !y.isneg() && n * 3322 / 1000 + 4 < uint64_t(X::mbits) && xf_equal(xf_integer_power(X(10), n), x)) {
+			lost = XFLOAT_EXACT;
+			return X((long long)n);
+		}
+		return y;
+	}
+	case elementary_function::log1p:
+		lost = XFLOAT_LOG_LOST;
+		return xf_log1p(x);
+	case elementary_function::sin:
+	case elementary_function::cos:
+	case elementary_function::tan:
+	case elementary_function::cot:
+	case elementary_function::sec:
+	case elementary_function::csc:
+	{
+		X r;
+		unsigned q = xf_trigonometric_reduction<nbits, es>(x, r, lost);
+		if (f == elementary_function::cos || f == elementary_function::sec) q = (q + 1) & 0x3;  // cos(x) = sin(x + pi/2)
+		bool both = (f == elementary_function::tan || f == elementary_function::cot);
+		X s, c;
+		if (both || !(q & 0x1)) s = xf_sin_taylor(r);
+		if (both || (q & 0x1)) c = xf_cos_taylor(r);
+		X sine   = (q & 0x1) ? c : s;
+		X cosine = (q & 0x1) ? s : c;
+		if (q & 0x1) cosine = -cosine;
+		if (q & 0x2) sine = -sine;
+		if (q & 0x2) cosine = -cosine;
+		lost += 4;
+		switch (f) {
+		case elementary_function::sin:
+		case elementary_function::cos:
+			return sine;
+		case elementary_function::sec:
+		case elementary_function::csc:
+			return xf_reciprocal(sine);
+		case elementary_function::tan:
+			return sine / cosine;
+		default:
+			return cosine / sine;
+		}
+	}
+	case elementary_function::atan:
+		return xf_atan(x);
+	case elementary_function::asin:
+		// asin(x) = atan2(x, sqrt((1 - x)(1 + x)))
+		lost = XFLOAT_ATAN_LOST;
+		return xf_atan2(x, xf_sqrt((one - x) * (one + x)));
+	case elementary_function::acos:
+		lost = XFLOAT_ATAN_LOST;
+		return xf_atan2(xf_sqrt((one - x) * (one + x)), x);
+	case elementary_function::sinh:
+	{
+		X a = xf_abs(x), y;
+		if (a.scale() < 0) {
+			// sinh(a) = (E + E/(E + 1))/2, E = e^a - 1
+			X E = xf_expm1_core(a, lost);
+			y = xf_ldexp(E + E / (E + one), -1);
+		}
+		else {
+			X E = xf_exp(a, lost);
+			y = xf_ldexp(E - xf_reciprocal(E), -1);
+		}
+		lost += 2;
+		return y.set_sign(x.sign());
+	}
+	case elementary_function::cosh:
+	{
+		X E = xf_exp(xf_abs(x), lost);
+		return xf_ldexp(E + xf_reciprocal(E), -1);
+	}
+	case elementary_function::tanh:
+	{
+		// tanh(a) = E/(E + 2), E = e^2a - 1
+		X E = xf_expm1(xf_ldexp(xf_abs(x), 1), lost);
+		X y = E / (E + two);
+		lost += 2;
+		return y.set_sign(x.sign());
+	}
+	case elementary_function::asinh:
+	{
+		// asinh(a) = log1p(a + a^2/(1 + sqrt(1 + a^2)))
+		X a = xf_abs(x), a2 = a * a;
+		X y = xf_log1p(a + a2 / (one + xf_sqrt(one + a2)));
+		lost = XFLOAT_LOG_LOST;
+		return y.set_sign(x.sign());
+	}
+	case elementary_function::acosh:
+	{
+		// acosh(x) = log1p(t + sqrt(t (2 + t))), t = x - 1
+		X t = x - one;
+		lost = XFLOAT_LOG_LOST;
+		return xf_log1p(t + xf_sqrt(t * (two + t)));
+	}
+	case elementary_function::atanh:
+	{
+		// atanh(a) = log1p(2a/(1 - a))/2
+		X a = xf_abs(x);
+		X y = xf_ldexp(xf_log1p(xf_ldexp(a, 1) / (one - a)), -1);
+		lost = XFLOAT_LOG_LOST;
+		return y.set_sign(x.sign());
+	}
+	}
+	return x;
+}
+
+// |x|^y for x != 0
+template<size_t nbits, size_t es, size_t L>
+xfloat<L> xf_pow(const xfloat<L>& x, const xfloat<L>& y, int& lost) {
+	using X = xfloat<L>;
+	X a = xf_abs(x);
+	lost = 4;
+	X r;
+	uint64_t n = xf_split_nearest(y, r);
+	if (r.iszero() && !y.isneg() && y.scale() < 62 && uint64_t(a.significant_bits()) * n <= uint64_t(X::mbits)) {
+		// exact integer power
+		lost = XFLOAT_EXACT;
+		return xf_integer_power(a, n);
+	}
+	if (a.ispowerof2() && y.scale() < 16) {
+		// (2^s)^y is exact when s*y is an integer
+		X sy = X(a.scale()) * y;
+		uint64_t m = xf_split_nearest(sy, r);
+		if (r.iszero()) {
+			lost = XFLOAT_EXACT;
+			return X(1).scale_by(int(int64_t(m)));
+		}
+	}
+	X z = y * xf_log(a);
+	constexpr int saturation = xf_bit_length(maxpos_scale<nbits, es>()) + 1;
+	if (z.scale() >= saturation) {
+		// the result is beyond the dynamic range of the posit: project onto maxpos or minpos
+		lost = XFLOAT_EXACT;
+		return X(1).scale_by(z.isneg() ? 2 * minpos_scale<nbits, es>() : 2 * maxpos_scale<nbits, es>());
+	}
+	// the relative error of z is that of the logarithm, and becomes an absolute error of z in the exponential
+	if (z.scale() > 0) lost += z.scale() + 1;
+	lost += XFLOAT_LOG_LOST;
+	return xf_exp(z, lost);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// rounding to the posit
+
+// round x to the nearest posit
+template<size_t nbits, size_t es, size_t L>
+posit<nbits, es>& xf_round(const xfloat<L>& x, posit<nbits, es>& p) {
+	if (x.iszero()) {
+		p.setzero();
+		return p;
+	}
+	// the most significant nbits + 8 bits of the fraction, with the remaining bits collapsed into a sticky bit
+	constexpr int mbits = xfloat<L>::mbits;
+	constexpr size_t fbits = (size_t(mbits - 1) < nbits + 8 ? size_t(mbits - 1) : nbits + 8);
+	bitblock<fbits> fraction;
+	int bit = mbits - 2;
+	for (int i = int(fbits) - 1; i >= 0; --i, --bit) {
+		fraction[size_t(i)] = (x.limb(size_t(bit) / 64) >> (bit % 64)) & 0x1;
+	}
+	int low = bit + 1;   // number of bits below the retained fraction
+	bool sticky = false;
+	for (size_t i = 0; i < L && !sticky && 64 * int(i) < low; ++i) {
+		uint64_t w = x.limb(i);
+		if (64 * int(i) + 64 > low) w &= (uint64_t(1) << (low - 64 * int(i))) - 1;
+		sticky = (w != 0);
+	}
+	if (sticky) fraction[0] = true;
+	return convert_<nbits, es, fbits>(x.sign(), x.scale(), fraction, p);
+}
+
+// round y to the posit, and report whether the error bound guarantees correct rounding
+// with boundary set, an error interval that contains a rounding boundary is taken to be the boundary itself,
+// and the result is the even encoding of the two posits on either side
+template<size_t nbits, size_t es, size_t L>
+bool xf_round_verified(const xfloat<L>& y, int lost, posit<nbits, es>& p, bool boundary = false) {
+	if (lost == XFLOAT_EXACT || y.iszero()) {
+		xf_round(y, p);
+		return true;
+	}
+	int precision = xfloat<L>::mbits - XFLOAT_GUARD_BITS - lost;
+	if (precision < int(nbits) + 2) {
+		xf_round(y, p);
+		return false;
+	}
+	xfloat<L> delta = xf_ldexp(xf_abs(y), -precision);
+	posit<nbits, es> lo, hi;
+	xf_round(y - delta, lo);
+	xf_round(y + delta, hi);
+	p = lo;
+	if (lo == hi) return true;
+	if (boundary) {
+		// delta is below a quarter of the posit's ulp, so lo and hi are neighbours
+		if (lo.get()[0]) p = hi;
+		return true;
+	}
+	xf_round(y, p);
+	return false;
+}
+
+// working precisions of the three evaluation stages
+template<size_t nbits>
+struct xf_precision {
+	static constexpr size_t first = (nbits + 40 + 63) / 64;
+	static constexpr size_t second = 2 * first + 1;
+	static constexpr size_t third = 2 * second + 1;
+};
+
+// evaluate the kernel in precision L, and round the result when its error bound decides the rounding
+template<size_t nbits, size_t es, size_t L, typename Kernel>
+bool xf_evaluate_stage(const Kernel& kernel, posit<nbits, es>& p, bool boundary = false) {
+	int lost = 0;   // every stage starts with an empty error budget
+	xfloat<L> y = kernel.template evaluate<L>(lost);
+	return xf_round_verified(y, lost, p, boundary);
+}
+
+// Ziv's strategy: evaluate in increasing precisions until the rounding is decided,
+// the last stage resolves an undecided result as a tie on the rounding boundary
+template<size_t nbits, size_t es, typename Kernel>
+posit<nbits, es> xf_evaluate(const Kernel& kernel) {
+	posit<nbits, es> p;
+	if (xf_evaluate_stage<nbits, es, xf_precision<nbits>::first>(kernel, p)) return p;
+	if (xf_evaluate_stage<nbits, es, xf_precision<nbits>::second>(kernel, p)) return p;
+	xf_evaluate_stage<nbits, es, xf_precision<nbits>::third>(kernel, p, true);
+	return p;
+}
+
+template<size_t nbits, size_t es>
+struct xf_unary_kernel {
+	elementary_function f;
+	const posit<nbits, es>& x;
+	template<size_t L>
+	xfloat<L> evaluate(int& lost) const { return xf_elementary<nbits, es, L>(f, xfloat<L>(x), lost); }
+};
+
+template<size_t nbits, size_t es, typename Ty>
+struct xf_pow_kernel {
+	const posit<nbits, es>& x;
+	const Ty& y;
+	template<size_t L>
+	xfloat<L> evaluate(int& lost) const { return xf_pow<nbits, es, L>(xfloat<L>(x), xfloat<L>(y), lost); }
+};
+
+template<size_t nbits, size_t es>
+struct xf_atan2_kernel {
+	const posit<nbits, es>& y;
+	const posit<nbits, es>& x;
+	template<size_t L>
+	xfloat<L> evaluate(int& lost) const {
+		lost = XFLOAT_ATAN_LOST;
+		return xf_atan2(xfloat<L>(y), xfloat<L>(x));
+	}
+};
+
+// special cases of the elementary functions: returns true when the result is determined without evaluation
+template<size_t nbits, size_t es>
+bool elementary_special_case(elementary_function f, const posit<nbits, es>& x, posit<nbits, es>& r) {
+	using Posit = posit<nbits, es>;
+	// arguments beyond these scales saturate the exponential functions, or round tanh and expm1 to +-1
+	constexpr int saturation = xf_bit_length(maxpos_scale<nbits, es>()) + 1;
+	constexpr int unity = xf_bit_length(nbits + 2) + 1;
+	if (x.isnar()) {
+		r.setnar();
+		return true;
+	}
+	const Posit one(1), minus_one(-1);
+	bool zero = x.iszero();
+	bool negative = x.isneg();
+	int xscale = zero ? 0 : scale(x);
+	switch (f) {
+	case elementary_function::exp:
+	case elementary_function::exp2:
+	case elementary_function::exp10:
+		if (zero) { r = one; return true; }
+		if (xscale >= saturation) {
+			negative ? minpos(r) : maxpos(r);
+			return true;
+		}
+		return false;
+	case elementary_function::expm1:
+		if (zero) { r.setzero(); return true; }
+		if (!negative && xscale >= saturation) { maxpos(r); return true; }
+		if (negative && xscale >= unity) { r = minus_one; return true; }
+		return false;
+	case elementary_function::log:
+	case elementary_function::log2:
+	case elementary_function::log10:
+		if (zero || negative) { r.setnar(); return true; }
+		if (x == one) { r.setzero(); return true; }
+		return false;
+	case elementary_function::log1p:
+		if (zero) { r.setzero(); return true; }
+		if (x <= minus_one) { r.setnar(); return true; }
+		return false;
+	case elementary_function::sin:
+	case elementary_function::tan:
+	case elementary_function::atan:
+	case elementary_function::asinh:
+		if (zero) { r.setzero(); return true; }
+		return false;
+	case elementary_function::cos:
+	case elementary_function::sec:
+		if (zero) { r = one; return true; }
+		return false;
+	case elementary_function::cot:
+	case elementary_function::csc:
+		if (zero) { r.setnar(); return true; }
+		return false;
+	case elementary_function::asin:
+	case elementary_function::acos:
+		if (x > one || x < minus_one) { r.setnar(); return true; }
+		if (zero && f == elementary_function::asin) { r.setzero(); return true; }
+		return false;
+	case elementary_function::sinh:
+		if (zero) { r.setzero(); return true; }
+		if (xscale >= saturation) {
+			maxpos(r);
+			if (negative) r = -r;
+			return true;
+		}
+		return false;
+	case elementary_function::cosh:
+		if (zero) { r = one; return true; }
+		if (xscale >= saturation) { maxpos(r); return true; }
+		return false;
+	case elementary_function::tanh:
+		if (zero) { r.setzero(); return true; }
+		if (xscale >= unity) { r = negative ? minus_one : one; return true; }
+		return false;
+	case elementary_function::acosh:
+		if (x < one) { r.setnar(); return true; }
+		if (x == one) { r.setzero(); return true; }
+		return false;
+	case elementary_function::atanh:
+		if (x >= one || x <= minus_one) { r.setnar(); return true; }
+		if (zero) { r.setzero(); return true; }
+		return false;
+	}
+	return false;
+}
+
+// native evaluation of an elementary function
+template<size_t nbits, size_t es>
+posit<nbits, es> native_elementary(elementary_function f, const posit<nbits, es>& x) {
+	posit<nbits, es> r;
+	if (elementary_special_case(f, x, r)) return r;
+	return xf_evaluate<nbits, es>(xf_unary_kernel<nbits, es>{ f, x });
+}
+
+// lookup table of all the encodings of a small posit, generated with the native kernels upon first use
+template<size_t nbits, size_t es, elementary_function f>
+const std::vector< posit<nbits, es> >& elementary_lookup_table() {
+	static const std::vector< posit<nbits, es> > table = []() {
+		constexpr size_t NR_ENCODINGS = (size_t(1) << nbits);
+		std::vector< posit<nbits, es> > t(NR_ENCODINGS);
+		posit<nbits, es> x;
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+			x.set_raw_bits(i);
+			t[i] = native_elementary(f, x);
+		}
+		return t;
+	}();
+	return table;
+}
+
+// elementary function: table lookup for small posits, native evaluation otherwise
+// exp and log of posits up to POSIT_LOOKUP_UNARY_NBITS use the compile-time generated tables
+template<elementary_function f, size_t nbits, size_t es>
+inline posit<nbits, es> elementary(const posit<nbits, es>& x) {
+	if constexpr (f == elementary_function::exp && nbits <= POSIT_LOOKUP_UNARY_NBITS && lookup_in_double_range<nbits, es>()) {
+		posit<nbits, es> r;
+		return r.set_raw_bits(posit_unary_lookup<nbits, es, lookup_operator::exp>[size_t(x.encoding())]);
+	}
+	else if constexpr (f == elementary_function::log && nbits <= POSIT_LOOKUP_UNARY_NBITS && lookup_in_double_range<nbits, es>()) {
+		posit<nbits, es> r;
+		return r.set_raw_bits(posit_unary_lookup<nbits, es, lookup_operator::log>[size_t(x.encoding())]);
+	}
+	else if constexpr (nbits <= POSIT_ELEMENTARY_LOOKUP_NBITS) {
+		return elementary_lookup_table<nbits, es, f>()[size_t(x.encoding())];
+	}
+	else {
+		return native_elementary(f, x);
+	}
+}
+
+// exponents of pow that do not represent a real
+template<size_t nbits, size_t es>
+inline bool xf_isnar(const posit<nbits, es>& y) { return y.isnar(); }
+inline bool xf_isnar(double y) { return !std::isfinite(y); }
+inline bool xf_isnar(int) { return false; }
+
+// |x|^y with the sign and special case handling of pow
+template<size_t nbits, size_t es, typename Ty>
+posit<nbits, es> native_pow(const posit<nbits, es>& x, const Ty& y) {
+	constexpr size_t YL = xf_precision<nbits>::second;
+	posit<nbits, es> r;
+	xfloat<YL> yv(y);
+	// pow(x, 0) and pow(1, y) are 1 for any x and y, as in std::pow
+	if ((yv.iszero() && !xf_isnar(y)) || x == posit<nbits, es>(1)) {
+		r = 1;
+		return r;
+	}
+	if (x.isnar() || xf_isnar(y)) {
+		r.setnar();
+		return r;
+	}
+	if (x.iszero()) {
+		// 0^y = 0 for y > 0, and a pole for y < 0
+		if (yv.isneg()) r.setnar(); else r.setzero();
+		return r;
+	}
+	bool negate = false;
+	if (x.isneg()) {
+		xfloat<YL> fraction;
+		uint64_t n = xf_split_nearest(yv, fraction);
+		if (!fraction.iszero()) {
+			// the power of a negative base is only real for integer exponents
+			r.setnar();
+			return r;
+		}
+		negate = (n & 0x1);
+	}
+	r = xf_evaluate<nbits, es>(xf_pow_kernel<nbits, es, Ty>{ x, y });
+	return negate ? -r : r;
+}
+
+template<size_t nbits, size_t es>
+posit<nbits, es> native_atan2(const posit<nbits, es>& y, const posit<nbits, es>& x) {
+	posit<nbits, es> r;
+	if (y.isnar() || x.isnar()) {
+		r.setnar();
+		return r;
+	}
+	return xf_evaluate<nbits, es>(xf_atan2_kernel<nbits, es>{ y, x });
+}
+
+} // namespace internal
+
+}} // namespace sw::unum
@@ -4,12 +4,12 @@
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-
+#include "elementary_kernels.hpp"
 
 namespace sw {	namespace unum {
 
-// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// the hyperbolic functions are evaluated natively through expm1 and log1p, which avoid the cancellation
+// near zero; see elementary_kernels.hpp for the error bounds that decide the rounding
 
 // value representing an angle expressed in radians
 // One radian is equivalent to 180/PI degrees
@@ -17,37 +17,37 @@ namespace sw {	namespace unum {
 // hyperbolic sine of an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> sinh(posit<nbits,es> x) {
-	return posit<nbits,es>(std::sinh(double(x)));
+	return internal::elementary<internal::elementary_function::sinh>(x);
 }
 
 // hyperbolic cosine of an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> cosh(posit<nbits,es> x) {
-	return posit<nbits,es>(std::cosh(double(x)));
+	return internal::elementary<internal::elementary_function::cosh>(x);
 }
 
 // hyperbolic tangent of an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> tanh(posit<nbits,es> x) {
-	return posit<nbits,es>(std::tanh(double(x)));
+	return internal::elementary<internal::elementary_function::tanh>(x);
 }
 
-// hyperbolic cotangent of an angle of x radians
+// inverse hyperbolic tangent of x
 template<size_t nbits, size_t es>
 posit<nbits,es> atanh(posit<nbits,es> x) {
-	return posit<nbits,es>(std::atanh(double(x)));
+	return internal::elementary<internal::elementary_function::atanh>(x);
 }
 
-// hyperbolic cosecant of an angle of x radians
+// inverse hyperbolic cosine of x
 template<size_t nbits, size_t es>
 posit<nbits,es> acosh(posit<nbits,es> x) {
-	return posit<nbits,es>(std::acosh(double(x)));
+	return internal::elementary<internal::elementary_function::acosh>(x);
 }
 
-// hyperbolic secant of an angle of x radians
+// inverse hyperbolic sine of x
 template<size_t nbits, size_t es>
 posit<nbits,es> asinh(posit<nbits,es> x) {
-	return posit<nbits,es>(std::asinh(double(x)));
+	return internal::elementary<internal::elementary_function::asinh>(x);
 }
 
 
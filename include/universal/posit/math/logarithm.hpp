@@ -4,35 +4,35 @@
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-
+#include "elementary_kernels.hpp"
 
 namespace sw {	namespace unum {
 
-// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// the logarithm functions are evaluated natively: log2 of a power of 2 and log10 of a power of 10 are exact,
+// and the other results are rounded when the error bound of the kernel in elementary_kernels.hpp decides the rounding
 
 // Natural logarithm of x
 template<size_t nbits, size_t es>
 posit<nbits,es> log(posit<nbits,es> x) {
-	return posit<nbits,es>(std::log(double(x)));
+	return internal::elementary<internal::elementary_function::log>(x);
 }
 
 // Binary logarithm of x
 template<size_t nbits, size_t es>
 posit<nbits,es> log2(posit<nbits,es> x) {
-	return posit<nbits,es>(std::log2(double(x)));
+	return internal::elementary<internal::elementary_function::log2>(x);
 }
 
 // Decimal logarithm of x
 template<size_t nbits, size_t es>
 posit<nbits,es> log10(posit<nbits,es> x) {
-	return posit<nbits,es>(std::log10(double(x)));
+	return internal::elementary<internal::elementary_function::log10>(x);
 }
 		
 // Natural logarithm of 1+x
 template<size_t nbits, size_t es>
 posit<nbits,es> log1p(posit<nbits,es> x) {
-	return posit<nbits,es>(std::log1p(double(x)));
+	return internal::elementary<internal::elementary_function::log1p>(x);
 }
 
 }}  // namespace sw::unum
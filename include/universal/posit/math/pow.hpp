@@ -4,26 +4,26 @@
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-
+#include "elementary_kernels.hpp"
 
 namespace sw { namespace unum {
 
-// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// pow is evaluated natively as exp(y log|x|) in a working precision that grows until the error bound
+// decides the rounding; exact integer powers, and powers of 2 with an integer exponent, are rounded directly
 
 template<size_t nbits, size_t es>
 posit<nbits,es> pow(posit<nbits,es> x, posit<nbits, es> y) {
-	return posit<nbits,es>(std::pow(double(x), double(y)));
+	return internal::native_pow(x, y);
 }
 		
 template<size_t nbits, size_t es>
 posit<nbits,es> pow(posit<nbits,es> x, int y) {
-	return posit<nbits,es>(std::pow(double(x), double(y)));
+	return internal::native_pow(x, y);
 }
 		
 template<size_t nbits, size_t es>
 posit<nbits,es> pow(posit<nbits,es> x, double y) {
-	return posit<nbits,es>(std::pow(double(x), y));
+	return internal::native_pow(x, y);
 }
 
 // calculate an integer power function base^int
@@ -160,32 +160,35 @@ namespace sw { namespace unum {
 		return vsqrt;
 	}
 
-#if POSIT_NATIVE_SQRT
 	// sqrt for arbitrary posit
 	template<size_t nbits, size_t es>
 	inline posit<nbits, es> sqrt(const posit<nbits, es>& a) {
 		posit<nbits, es> p;
-		if (a.isneg() || a.isnar()) {
-			p.setnar();
+		if constexpr (nbits <= POSIT_LOOKUP_UNARY_NBITS) {
+			// small posits use the compile-time generated sqrt table
+			p.set_raw_bits(posit_unary_lookup<nbits, es, internal::lookup_operator::sqrt>[size_t(a.encoding())]);
 			return p;
 		}
+		else {
+#if POSIT_NATIVE_SQRT
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
 
-		// for small posits use a more precise posit to do the calculation while keeping the es config the same
-		constexpr size_t anbits = nbits > 33 ? nbits : 33;
-		constexpr size_t fbits = posit<anbits, es>::fbits;
-		value<fbits> v;
-		a.normalize_to(v);
-		value<fbits> vsqrt = fast_sqrt<anbits, es, fbits>(v);
-		convert(vsqrt, p);
-
-		return p;
-	}
+			// for small posits use a more precise posit to do the calculation while keeping the es config the same
+			constexpr size_t anbits = nbits > 33 ? nbits : 33;
+			constexpr size_t fbits = posit<anbits, es>::fbits;
+			value<fbits> v;
+			a.normalize_to(v);
+			value<fbits> vsqrt = fast_sqrt<anbits, es, fbits>(v);
+			convert(vsqrt, p);
 #else
-	template<size_t nbits, size_t es>
-	inline posit<nbits, es> sqrt(const posit<nbits, es>& a) {
-		return posit<nbits, es>(std::sqrt((double)a));
-	}
+			p = std::sqrt((double)a);
 #endif
+			return p;
+		}
+	}
 
 	// reciprocal sqrt
 	template<size_t nbits, size_t es>
@@ -197,86 +200,6 @@ namespace sw { namespace unum {
 	///////////////////////////////////////////////////////////////////
 	// specialized sqrt configurations
 
-
-	// fast sqrt for posit<2,0>
-	template<>
-	inline posit<3, 0> sqrt(const posit<3, 0>& a) {
-		posit<3, 0> p;
-		if (a.isneg() || a.isnar()) {
-			p.setnar();
-			return p;
-		}
-		unsigned root = posit_3_0_roots[a.encoding()];
-		p.set_raw_bits(root);
-		return p;
-	}
-
-	// fast sqrt for posit<3,1>
-	template<>
-	inline posit<3, 1> sqrt(const posit<3, 1>& a) {
-		posit<3, 1> p;
-		if (a.isneg() || a.isnar()) {
-			p.setnar();
-			return p;
-		}
-		unsigned root = posit_3_1_roots[a.encoding()];
-		p.set_raw_bits(root);
-		return p;
-	}
-
-	// fast sqrt for posit<4,0>
-	template<>
-	inline posit<4, 0> sqrt(const posit<4, 0>& a) {
-		posit<4, 0> p;
-		if (a.isneg() || a.isnar()) {
-			p.setnar();
-			return p;
-		}
-
-		unsigned root = posit_4_0_roots[a.encoding()];
-		p.set_raw_bits(root);
-		return p;
-	}
-
-	// fast sqrt for posit<5,0>
-	template<>
-	inline posit<5, 0> sqrt(const posit<5, 0>& a) {
-		posit<5, 0> p;
-		if (a.isneg() || a.isnar()) {
-			p.setnar();
-			return p;
-		}
-		unsigned root = posit_5_0_roots[a.encoding()];
-		p.set_raw_bits(root);
-		return p;
-	}
-
-	// fast sqrt for posit<8,0>
-	template<>
-	inline posit<8, 0> sqrt(const posit<8, 0>& a) {
-		posit<8, 0> p;
-		if (a.isneg() || a.isnar()) {
-			p.setnar();
-			return p;
-		}
-		unsigned root = posit_8_0_roots[a.encoding()];
-		p.set_raw_bits(root);
-		return p;
-	}
-
-	// fast sqrt for posit<8,1>
-	template<>
-	inline posit<8, 1> sqrt(const posit<8, 1>& a) {
-		posit<8, 1> p;
-		if (a.isneg() || a.isnar()) {
-			p.setnar();
-			return p;
-		}
-		unsigned root = posit_8_1_roots[a.encoding()];
-		p.set_raw_bits(root);
-		return p;
-	}
-
 	// seed sqrt approximation
 	const uint16_t approxRecipSqrt0[16] = {
 		0xb4c9, 0xffab, 0xaa7d, 0xf11c, 0xa1c5, 0xe4c7, 0x9a43, 0xda29,
@@ -482,8 +405,16 @@ namespace sw { namespace unum {
 	// fast sqrt for posit<64,3>
 	template<>
 	inline posit<64, 3> sqrt(const posit<64, 3>& a) {
-		throw "fast sqrt(posit<64,3>) not yet implemented";
-		return 0;
+		posit<64, 3> p;
+		if (a.isneg() || a.isnar()) {
+			p.setnar();
+			return p;
+		}
+		if (a.iszero()) {
+			p.setzero();
+			return p;
+		}
+		return p.set_raw_bits(internal::fast_posit64_sqrt(uint64_t(a.encoding())));
 	}
 
 #endif // POSIT_FAST_POSIT_64_3
@@ -493,8 +424,20 @@ namespace sw { namespace unum {
 	// fast sqrt for posit<128,4>
 	template<>
 	inline posit<128, 4> sqrt(const posit<128, 4>& a) {
-		throw "fast sqrt(posit<128,4>) not yet implemented";
-		return 0;
+		posit<128, 4> p;
+		if (a.isneg() || a.isnar()) {
+			p.setnar();
+			return p;
+		}
+		if (a.iszero()) {
+			p.setzero();
+			return p;
+		}
+		uint64_t bits[posit<128, 4>::nrLimbs], root[posit<128, 4>::nrLimbs];
+		for (size_t i = 0; i < posit<128, 4>::nrLimbs; ++i) bits[i] = a.word(i);
+		internal::fast_posit_limbs_sqrt<128, 4>(bits, root);
+		for (size_t i = 0; i < posit<128, 4>::nrLimbs; ++i) p.setword(i, root[i]);
+		return p;
 	}
 
 #endif // POSIT_FAST_POSIT_128_4
@@ -504,8 +447,20 @@ namespace sw { namespace unum {
 	// fast sqrt for posit<256,5>
 	template<>
 	inline posit<256, 5> sqrt(const posit<256, 5>& a) {
-		throw "fast sqrt(posit<256,5>) not yet implemented";
-		return 0;
+		posit<256, 5> p;
+		if (a.isneg() || a.isnar()) {
+			p.setnar();
+			return p;
+		}
+		if (a.iszero()) {
+			p.setzero();
+			return p;
+		}
+		uint64_t bits[posit<256, 5>::nrLimbs], root[posit<256, 5>::nrLimbs];
+		for (size_t i = 0; i < posit<256, 5>::nrLimbs; ++i) bits[i] = a.word(i);
+		internal::fast_posit_limbs_sqrt<256, 5>(bits, root);
+		for (size_t i = 0; i < posit<256, 5>::nrLimbs; ++i) p.setword(i, root[i]);
+		return p;
 	}
 
 #endif // POSIT_FAST_POSIT_256_5
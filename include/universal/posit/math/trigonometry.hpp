@@ -4,11 +4,13 @@
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include "elementary_kernels.hpp"
 
 namespace sw {	namespace unum {
 
-// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// the trigonometric functions are evaluated natively, and rounded when the error bound of the evaluation
+// decides the rounding; see elementary_kernels.hpp for the one case that is not verified.
+// Arguments are reduced modulo pi/2 with pi to the full dynamic range of the posit.
 
 // value representing an angle expressed in radians
 // One radian is equivalent to 180/PI degrees
@@ -16,65 +18,61 @@ namespace sw {	namespace unum {
 // sine of an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> sin(posit<nbits,es> x) {
-	//std::cerr << "sw::unum::sin(posit<" << nbits << "," << es << ")";
-	return posit<nbits,es>(std::sin(double(x)));
+	return internal::elementary<internal::elementary_function::sin>(x);
 }
 
 // cosine of an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> cos(posit<nbits,es> x) {
-	//std::cerr << "sw::unum::cos(posit<" << nbits << "," << es << ")";
-	return posit<nbits,es>(std::cos(double(x)));
+	return internal::elementary<internal::elementary_function::cos>(x);
 }
 
 // tangent of an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> tan(posit<nbits,es> x) {
-	//std::cerr << "sw::unum::tan(posit<" << nbits << "," << es << ")";
-	return posit<nbits,es>(std::tan(double(x)));
+	return internal::elementary<internal::elementary_function::tan>(x);
 }
 
-// cotangent of an angle of x radians
+// arc tangent of x
 template<size_t nbits, size_t es>
 posit<nbits,es> atan(posit<nbits,es> x) {
-	//std::cerr << "sw::unum::atan(posit<" << nbits << "," << es << ")";
-	return posit<nbits,es>(std::atan(double(x)));
+	return internal::elementary<internal::elementary_function::atan>(x);
 }
 		
 // Arc tangent with two parameters
 template<size_t nbits, size_t es>
 posit<nbits,es> atan2(posit<nbits,es> y, posit<nbits,es> x) {
-	return posit<nbits,es>(std::atan2(double(y),double(x)));
+	return internal::native_atan2(y, x);
 }
 
-// cosecant of an angle of x radians
+// arc cosine of x
 template<size_t nbits, size_t es>
 posit<nbits,es> acos(posit<nbits,es> x) {
-	return posit<nbits,es>(std::acos(double(x)));
+	return internal::elementary<internal::elementary_function::acos>(x);
 }
 
-// secant of an angle of x radians
+// arc sine of x
 template<size_t nbits, size_t es>
 posit<nbits,es> asin(posit<nbits,es> x) {
-	return posit<nbits,es>(std::asin(double(x)));
+	return internal::elementary<internal::elementary_function::asin>(x);
 }
 
 // cotangent an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> cot(posit<nbits,es> x) {
-	return posit<nbits,es>(std::tan(sw::unum::m_pi_2-double(x)));
+	return internal::elementary<internal::elementary_function::cot>(x);
 }
 
 // secant of an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> sec(posit<nbits,es> x) {
-	return posit<nbits,es>(1.0/std::cos(double(x)));
+	return internal::elementary<internal::elementary_function::sec>(x);
 }
 
 // cosecant of an angle of x radians
 template<size_t nbits, size_t es>
 posit<nbits,es> csc(posit<nbits,es> x) {
-	return posit<nbits,es>(1.0/std::sin(double(x)));
+	return internal::elementary<internal::elementary_function::csc>(x);
 }
 
 }}  // namespace sw::unum
@@ -71,6 +71,8 @@ typedef __128bitdd double_double;
 // #define POSIT_ENABLE_LITERALS 1
 // - define to non-zero if you want to throw exceptions on arithmetic errors
 // #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+// - define to non-zero if you want small posits to use table lookup arithmetic
+// #define POSIT_LOOKUP_ARITHMETIC 1
 
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 // Posits encode error conditions as NaR (Not a Real), propagating the error through arithmetic operations is preferred
@@ -86,6 +88,8 @@ typedef __128bitdd double_double;
 #include <universal/posit/exponent.hpp>
 #include <universal/posit/regime.hpp>
 #include <universal/posit/posit_functions.hpp>
+#include <universal/posit/posit_lookup.hpp>
+#include <universal/posit/posit_ieee_conversion.hpp>
 
 namespace sw {
 namespace unum {
@@ -728,6 +732,12 @@ public:
 			return *this;
 		}
 		if (rhs.iszero()) return *this;
+#if POSIT_LOOKUP_ARITHMETIC
+		if constexpr (nbits <= POSIT_LOOKUP_BINARY_NBITS) {
+			set_raw_bits(posit_binary_lookup<nbits, es, internal::lookup_operator::add>[(size_t(encoding()) << nbits) | size_t(rhs.encoding())]);
+			return *this;
+		}
+#endif
 
 		// arithmetic operation
 		value<abits + 1> sum;
@@ -770,6 +780,12 @@ public:
 			return *this;
 		}
 		if (rhs.iszero()) return *this;
+#if POSIT_LOOKUP_ARITHMETIC
+		if constexpr (nbits <= POSIT_LOOKUP_BINARY_NBITS) {
+			set_raw_bits(posit_binary_lookup<nbits, es, internal::lookup_operator::sub>[(size_t(encoding()) << nbits) | size_t(rhs.encoding())]);
+			return *this;
+		}
+#endif
 
 		// arithmetic operation
 		value<abits + 1> difference;
@@ -812,6 +828,12 @@ public:
 			setzero();
 			return *this;
 		}
+#if POSIT_LOOKUP_ARITHMETIC
+		if constexpr (nbits <= POSIT_LOOKUP_BINARY_NBITS) {
+			set_raw_bits(posit_binary_lookup<nbits, es, internal::lookup_operator::mul>[(size_t(encoding()) << nbits) | size_t(rhs.encoding())]);
+			return *this;
+		}
+#endif
 
 		// arithmetic operation
 		value<mbits> product;
@@ -865,6 +887,12 @@ public:
 		if (iszero() || isnar()) {
 			return *this;
 		}
+#endif
+#if POSIT_LOOKUP_ARITHMETIC
+		if constexpr (nbits <= POSIT_LOOKUP_BINARY_NBITS) {
+			set_raw_bits(posit_binary_lookup<nbits, es, internal::lookup_operator::div>[(size_t(encoding()) << nbits) | size_t(rhs.encoding())]);
+			return *this;
+		}
 #endif
 		value<divbits> ratio;
 		value<fbits> a, b;
@@ -915,6 +943,11 @@ public:
 			p.setnar();
 			return p;
 		}
+#if POSIT_LOOKUP_ARITHMETIC
+		if constexpr (nbits <= POSIT_LOOKUP_UNARY_NBITS) {
+			return p.set_raw_bits(posit_unary_lookup<nbits, es, internal::lookup_operator::reciprocal>[size_t(encoding())]);
+		}
+#endif
 		// compute the reciprocal
 		bool old_sign = _raw_bits[nbits-1];
 		bitblock<nbits> raw_bits;
@@ -1045,6 +1078,9 @@ public:
 	// Set the raw bits of the posit given an unsigned value starting from the lsb. Handy for enumerating a posit state space
 	constexpr posit<nbits,es>& set_raw_bits(uint64_t value) {
 		clear();
+#if BITBLOCK_WORD_ARRAY
+		_raw_bits.setword(0, value);  // setword nulls the bits beyond nbits
+#else
 		bitblock<nbits> raw_bits;
 		uint64_t mask = 1;
 		for ( size_t i = 0; i < nbits; i++ ) {
@@ -1052,6 +1088,7 @@ public:
 			mask <<= 1;
 		}
 		_raw_bits = raw_bits;
+#endif
 		return *this;
 	}
 
@@ -1160,9 +1197,11 @@ private:
 	unsigned long long to_ulong_long() const { return (unsigned long long)(to_long_double()); }
 #endif
 	float to_float() const {
+		if constexpr (internal::posit_ieee_direct<nbits, es>) return internal::posit_to_ieee<nbits, es, float>(encoding());
 		return (float)to_double();
 	}
 	double to_double() const {
+		if constexpr (internal::posit_ieee_direct<nbits, es>) return internal::posit_to_ieee<nbits, es, double>(encoding());
 		if (iszero())	return 0.0;
 		if (isnar())	return NAN;
 		bool		     	 _sign;
@@ -1192,6 +1231,10 @@ private:
 	}
 	template <typename T>
 	constexpr posit<nbits, es>& float_assign(const T& rhs) {
+		if constexpr (internal::posit_ieee_direct<nbits, es> && (std::is_same<T, float>::value || std::is_same<T, double>::value)) {
+			// round the IEEE-754 encoding directly into the posit encoding
+			return set_raw_bits(internal::ieee_to_posit<nbits, es>(rhs));
+		}
 		constexpr int dfbits = std::numeric_limits<T>::digits - 1;
 		value<dfbits> v(static_cast<T>(rhs));
 
@@ -0,0 +1,558 @@
+#pragma once
+// posit_batch.hpp: array-level arithmetic and conversion kernels for posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#if defined(LIB_USE_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace sw { namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// batch kernels
+///
+/// The batch kernels apply an operator element-wise to arrays of n posits.
+/// The generic versions are scalar loops over the posit operators.
+/// When the library is built with LIB_USE_AVX2 and the fast posit<16,1> or posit<32,2>
+/// specializations are enabled, eight lanes are processed at a time: the encodings are
+/// decoded in 32-bit lanes into floats (posit<16,1>) or doubles (posit<32,2>), which
+/// represent these posits exactly, the operator is evaluated together with an error-free
+/// transformation that yields the sign of the rounding residual, and the result is rounded
+/// back into the posit encoding using that residual to break ties.
+/// The results are identical to the scalar operators.
+/// Blocks that produce NaR are recomputed by the scalar operators, so that the
+/// POSIT_THROW_ARITHMETIC_EXCEPTION behavior is preserved.
+
+#if defined(LIB_USE_AVX2)
+namespace internal {
+
+// fields of eight posits, or of eight floating-point values to be rounded to posits, in 32-bit lanes
+struct avx2_fields {
+	__m256i sign;      // all ones for negative values
+	__m256i scale;     // k * 2^es + exponent
+	__m256i fraction;  // fraction bits without the hidden bit, left-aligned
+	__m256i sticky;    // nonzero when there are fraction bits beyond the 32 in fraction
+	__m256i zero;      // all ones for zero
+	__m256i nar;       // all ones for NaR, or non-finite values
+};
+
+// decode eight posit<nbits,es> encodings, held in the low bits of 32-bit lanes
+template<size_t nbits, size_t es>
+inline avx2_fields avx2_decode(__m256i raw) {
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one  = _mm256_set1_epi32(1);
+	avx2_fields f;
+	__m256i bits = _mm256_slli_epi32(raw, 32 - nbits);
+	f.zero   = _mm256_cmpeq_epi32(bits, zero);
+	f.nar    = _mm256_cmpeq_epi32(bits, _mm256_set1_epi32(INT32_MIN));
+	f.sign   = _mm256_srai_epi32(bits, 31);
+	f.sticky = zero;
+	__m256i x = _mm256_slli_epi32(_mm256_abs_epi32(bits), 1);   // left-align the bits following the sign bit
+	// the regime is a run of identical bits: invert a run of ones so that we can count leading zeros
+	__m256i ones = _mm256_srai_epi32(x, 31);
+	__m256i y = _mm256_xor_si256(x, ones);
+	// leading zero count from the exponent of the float conversion:
+	// clearing the bit below the leading one keeps the conversion from rounding up into the next binade
+	y = _mm256_andnot_si256(_mm256_srli_epi32(y, 1), y);
+	__m256i m = _mm256_sub_epi32(_mm256_set1_epi32(127 + 31), _mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(y)), 23));
+	// drop the regime run and its terminating bit
+	__m256i rem = _mm256_sllv_epi32(x, _mm256_add_epi32(m, one));
+	// k = m - 1 for a run of ones, and k = -m for a run of zeros
+	__m256i k = _mm256_blendv_epi8(_mm256_sub_epi32(zero, m), _mm256_sub_epi32(m, one), ones);
+	f.scale    = _mm256_slli_epi32(k, es);
+	f.fraction = rem;
+	if constexpr (es > 0) {
+		f.scale    = _mm256_add_epi32(f.scale, _mm256_srli_epi32(rem, 32 - es));
+		f.fraction = _mm256_slli_epi32(rem, es);
+	}
+	return f;
+}
+
+// round eight values to posit<nbits,es> encodings in the low bits of 32-bit lanes
+// the residual of the exact result with respect to the value is given by its sign and zero masks,
+// and breaks the ties of the round-to-nearest-even
+template<size_t nbits, size_t es>
+inline __m256i avx2_encode(const avx2_fields& f, __m256i rsign, __m256i rzero) {
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one  = _mm256_set1_epi32(1);
+	const __m256i all  = _mm256_set1_epi32(-1);
+	const __m256i maxbody = _mm256_set1_epi32(int32_t((uint32_t(1) << (nbits - 1)) - 1));
+
+	__m256i k      = _mm256_srai_epi32(f.scale, es);
+	__m256i kpos   = _mm256_cmpgt_epi32(k, all);
+	// left-aligned regime: k+1 ones followed by a zero, or -k zeros followed by a one
+	__m256i regime = _mm256_blendv_epi8(
+		_mm256_srlv_epi32(_mm256_set1_epi32(INT32_MIN), _mm256_sub_epi32(zero, k)),
+		_mm256_xor_si256(_mm256_srlv_epi32(all, _mm256_add_epi32(k, one)), all), kpos);
+	__m256i rlen   = _mm256_blendv_epi8(_mm256_sub_epi32(one, k), _mm256_add_epi32(k, _mm256_set1_epi32(2)), kpos);
+	// exponent and fraction bits follow the regime, bits that are shifted out contribute to the sticky bit
+	__m256i tail   = f.fraction;
+	__m256i sticky = f.sticky;
+	if constexpr (es > 0) {
+		sticky = _mm256_or_si256(sticky, _mm256_and_si256(tail, _mm256_set1_epi32((1 << es) - 1)));
+		tail   = _mm256_or_si256(_mm256_srli_epi32(tail, es), _mm256_slli_epi32(f.scale, 32 - es));
+	}
+	__m256i w      = _mm256_or_si256(regime, _mm256_srlv_epi32(tail, rlen));
+	sticky         = _mm256_or_si256(sticky, _mm256_sllv_epi32(tail, _mm256_sub_epi32(_mm256_set1_epi32(32), rlen)));
+
+	// round to nearest even on the bit string
+	__m256i body   = _mm256_srli_epi32(w, 33 - nbits);
+	__m256i guard  = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srli_epi32(w, 32 - nbits), one), one);
+	if constexpr (nbits < 32) sticky = _mm256_or_si256(sticky, _mm256_slli_epi32(w, nbits));
+	__m256i exact  = _mm256_cmpeq_epi32(sticky, zero);
+	__m256i odd    = _mm256_cmpeq_epi32(_mm256_and_si256(body, one), one);
+	// a nonzero residual that increases the magnitude resolves a tie upwards, one that decreases it resolves it downwards
+	__m256i rsame  = _mm256_cmpeq_epi32(rsign, f.sign);
+	__m256i tieup  = _mm256_or_si256(_mm256_andnot_si256(rzero, rsame), _mm256_and_si256(_mm256_or_si256(rzero, rsame), odd));
+	__m256i up     = _mm256_and_si256(guard, _mm256_or_si256(_mm256_xor_si256(exact, all), tieup));
+	// posits saturate at maxpos and minpos
+	up             = _mm256_andnot_si256(_mm256_cmpeq_epi32(body, maxbody), up);
+	__m256i bits   = _mm256_sub_epi32(body, up);
+	bits = _mm256_blendv_epi8(bits, one, _mm256_cmpeq_epi32(bits, zero));
+	bits = _mm256_blendv_epi8(bits, _mm256_sub_epi32(zero, bits), f.sign);
+	if constexpr (nbits < 32) bits = _mm256_and_si256(bits, _mm256_set1_epi32(int32_t((uint32_t(1) << nbits) - 1)));
+	// special cases
+	bits = _mm256_andnot_si256(f.zero, bits);
+	bits = _mm256_blendv_epi8(bits, _mm256_set1_epi32(int32_t(uint32_t(1) << (nbits - 1))), f.nar);
+	return bits;
+}
+
+// eight floats in a __m256
+// posits with a precision of at most 12 bits and a scale in [-126, 127] are exactly representable as floats
+template<size_t nbits, size_t es>
+inline __m256 avx2_posit_to_ps(__m256i raw) {
+	avx2_fields f = avx2_decode<nbits, es>(raw);
+	__m256i bits = _mm256_or_si256(_mm256_and_si256(f.sign, _mm256_set1_epi32(INT32_MIN)),
+		_mm256_or_si256(_mm256_slli_epi32(_mm256_add_epi32(f.scale, _mm256_set1_epi32(127)), 23), _mm256_srli_epi32(f.fraction, 9)));
+	bits = _mm256_andnot_si256(f.zero, bits);
+	bits = _mm256_blendv_epi8(bits, _mm256_set1_epi32(0x7FC00000), f.nar);
+	return _mm256_castsi256_ps(bits);
+}
+template<size_t nbits, size_t es>
+inline __m256i avx2_ps_to_posit(__m256 d, __m256 r) {
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i u = _mm256_castps_si256(d);
+	__m256i biased = _mm256_and_si256(_mm256_srli_epi32(u, 23), _mm256_set1_epi32(0xFF));
+	avx2_fields f;
+	f.sign     = _mm256_srai_epi32(u, 31);
+	f.scale    = _mm256_sub_epi32(biased, _mm256_set1_epi32(127));
+	f.fraction = _mm256_slli_epi32(u, 9);
+	f.sticky   = zero;
+	f.zero     = _mm256_cmpeq_epi32(_mm256_slli_epi32(u, 1), zero);
+	f.nar      = _mm256_cmpeq_epi32(biased, _mm256_set1_epi32(0xFF));
+	__m256i ur = _mm256_castps_si256(r);
+	return avx2_encode<nbits, es>(f, _mm256_srai_epi32(ur, 31), _mm256_cmpeq_epi32(_mm256_slli_epi32(ur, 1), zero));
+}
+
+// eight doubles in a pair of __m256d: lo holds the lanes 0, 1, 4, 5 and hi holds the lanes 2, 3, 6, 7
+struct avx2_pd2 {
+	__m256d lo, hi;
+};
+template<size_t nbits, size_t es>
+inline avx2_pd2 avx2_posit_to_pd2(__m256i raw) {
+	avx2_fields f = avx2_decode<nbits, es>(raw);
+	__m256i upper = _mm256_or_si256(_mm256_and_si256(f.sign, _mm256_set1_epi32(INT32_MIN)),
+		_mm256_or_si256(_mm256_slli_epi32(_mm256_add_epi32(f.scale, _mm256_set1_epi32(1023)), 20), _mm256_srli_epi32(f.fraction, 12)));
+	__m256i lower = _mm256_slli_epi32(f.fraction, 20);
+	upper = _mm256_andnot_si256(f.zero, upper);
+	upper = _mm256_blendv_epi8(upper, _mm256_set1_epi32(0x7FF80000), f.nar);
+	lower = _mm256_andnot_si256(_mm256_or_si256(f.zero, f.nar), lower);
+	avx2_pd2 v;
+	v.lo = _mm256_castsi256_pd(_mm256_unpacklo_epi32(lower, upper));
+	v.hi = _mm256_castsi256_pd(_mm256_unpackhi_epi32(lower, upper));
+	return v;
+}
+template<size_t nbits, size_t es>
+inline __m256i avx2_pd2_to_posit(const avx2_pd2& d, const avx2_pd2& r) {
+	const __m256i zero = _mm256_setzero_si256();
+	// gather the upper and lower 32-bit words of the doubles, in lane order
+	__m256i upper = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castpd_ps(d.lo), _mm256_castpd_ps(d.hi), _MM_SHUFFLE(3, 1, 3, 1)));
+	__m256i lower = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castpd_ps(d.lo), _mm256_castpd_ps(d.hi), _MM_SHUFFLE(2, 0, 2, 0)));
+	__m256i biased = _mm256_and_si256(_mm256_srli_epi32(upper, 20), _mm256_set1_epi32(0x7FF));
+	avx2_fields f;
+	f.sign     = _mm256_srai_epi32(upper, 31);
+	f.scale    = _mm256_sub_epi32(biased, _mm256_set1_epi32(1023));
+	f.fraction = _mm256_or_si256(_mm256_slli_epi32(upper, 12), _mm256_srli_epi32(lower, 20));
+	f.sticky   = _mm256_slli_epi32(lower, 12);
+	f.zero     = _mm256_cmpeq_epi32(_mm256_or_si256(_mm256_slli_epi32(upper, 1), lower), zero);
+	f.nar      = _mm256_cmpeq_epi32(biased, _mm256_set1_epi32(0x7FF));
+	__m256i rupper = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castpd_ps(r.lo), _mm256_castpd_ps(r.hi), _MM_SHUFFLE(3, 1, 3, 1)));
+	__m256i rlower = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castpd_ps(r.lo), _mm256_castpd_ps(r.hi), _MM_SHUFFLE(2, 0, 2, 0)));
+	return avx2_encode<nbits, es>(f, _mm256_srai_epi32(rupper, 31), _mm256_cmpeq_epi32(_mm256_or_si256(_mm256_slli_epi32(rupper, 1), rlower), zero));
+}
+// convert between the lane order of avx2_pd2 and eight consecutive doubles
+inline avx2_pd2 avx2_load_pd2(const double* v) {
+	__m256d first = _mm256_loadu_pd(v);
+	__m256d second = _mm256_loadu_pd(v + 4);
+	avx2_pd2 d;
+	d.lo = _mm256_permute2f128_pd(first, second, 0x20);
+	d.hi = _mm256_permute2f128_pd(first, second, 0x31);
+	return d;
+}
+inline void avx2_store_pd2(double* v, const avx2_pd2& d) {
+	_mm256_storeu_pd(v, _mm256_permute2f128_pd(d.lo, d.hi, 0x20));
+	_mm256_storeu_pd(v + 4, _mm256_permute2f128_pd(d.lo, d.hi, 0x31));
+}
+
+// floating-point primitives on float and double lanes
+inline __m256  avx2_add(__m256 a, __m256 b)   { return _mm256_add_ps(a, b); }
+inline __m256d avx2_add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+inline __m256  avx2_sub(__m256 a, __m256 b)   { return _mm256_sub_ps(a, b); }
+inline __m256d avx2_sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+inline __m256  avx2_mul(__m256 a, __m256 b)   { return _mm256_mul_ps(a, b); }
+inline __m256d avx2_mul(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+inline __m256  avx2_div(__m256 a, __m256 b)   { return _mm256_div_ps(a, b); }
+inline __m256d avx2_div(__m256d a, __m256d b) { return _mm256_div_pd(a, b); }
+inline __m256  avx2_negate(__m256 a)          { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+inline __m256d avx2_negate(__m256d a)         { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+inline __m256  avx2_copysign_of(__m256 a, __m256 b)   { return _mm256_xor_ps(a, _mm256_and_ps(b, _mm256_set1_ps(-0.0f))); }
+inline __m256d avx2_copysign_of(__m256d a, __m256d b) { return _mm256_xor_pd(a, _mm256_and_pd(b, _mm256_set1_pd(-0.0))); }
+inline __m256  avx2_splitter(__m256)   { return _mm256_set1_ps(4097.0f); }         // 2^12 + 1
+inline __m256d avx2_splitter(__m256d)  { return _mm256_set1_pd(134217729.0); }     // 2^27 + 1
+#if defined(__FMA__)
+inline __m256  avx2_fmsub(__m256 a, __m256 b, __m256 c)     { return _mm256_fmsub_ps(a, b, c); }
+inline __m256d avx2_fmsub(__m256d a, __m256d b, __m256d c)  { return _mm256_fmsub_pd(a, b, c); }
+inline __m256  avx2_fnmadd(__m256 a, __m256 b, __m256 c)    { return _mm256_fnmadd_ps(a, b, c); }
+inline __m256d avx2_fnmadd(__m256d a, __m256d b, __m256d c) { return _mm256_fnmadd_pd(a, b, c); }
+#endif
+
+// error-free transformations
+template<typename Real>
+inline void avx2_two_sum(Real a, Real b, Real& s, Real& r) {
+	s = avx2_add(a, b);
+	Real bb = avx2_sub(s, a);
+	r = avx2_add(avx2_sub(a, avx2_sub(s, bb)), avx2_sub(b, bb));
+}
+template<typename Real>
+inline void avx2_two_product(Real a, Real b, Real& p, Real& r) {
+	p = avx2_mul(a, b);
+#if defined(__FMA__)
+	r = avx2_fmsub(a, b, p);
+#else
+	// Dekker's product with Veltkamp splitting
+	Real ca = avx2_mul(avx2_splitter(a), a);
+	Real ahi = avx2_sub(ca, avx2_sub(ca, a));
+	Real alo = avx2_sub(a, ahi);
+	Real cb = avx2_mul(avx2_splitter(b), b);
+	Real bhi = avx2_sub(cb, avx2_sub(cb, b));
+	Real blo = avx2_sub(b, bhi);
+	r = avx2_add(avx2_add(avx2_add(avx2_sub(avx2_mul(ahi, bhi), p), avx2_mul(ahi, blo)), avx2_mul(alo, bhi)), avx2_mul(alo, blo));
+#endif
+}
+
+// lane operators: d is the rounded result, and r has the sign of the residual
+struct avx2_add_op {
+	template<typename Real> void operator()(Real a, Real b, Real& d, Real& r) const { avx2_two_sum(a, b, d, r); }
+};
+struct avx2_sub_op {
+	template<typename Real> void operator()(Real a, Real b, Real& d, Real& r) const { avx2_two_sum(a, avx2_negate(b), d, r); }
+};
+struct avx2_mul_op {
+	template<typename Real> void operator()(Real a, Real b, Real& d, Real& r) const { avx2_two_product(a, b, d, r); }
+};
+struct avx2_div_op {
+	template<typename Real> void operator()(Real a, Real b, Real& d, Real& r) const {
+		d = avx2_div(a, b);
+		// the remainder a - d * b is exact, and its sign relative to b is the sign of the residual of the quotient
+#if defined(__FMA__)
+		Real remainder = avx2_fnmadd(d, b, a);
+#else
+		Real p, pe;
+		avx2_two_product(d, b, p, pe);
+		Real remainder = avx2_sub(avx2_sub(a, p), pe);
+#endif
+		r = avx2_copysign_of(remainder, b);
+	}
+};
+struct avx2_fma_op {
+	template<typename Real> void operator()(Real a, Real b, Real c, Real& d, Real& r) const {
+		// a * b + c = ph + pl + c = d + r + te exactly
+		Real ph, pl, s, se, t, te;
+		avx2_two_product(a, b, ph, pl);
+		avx2_two_sum(ph, c, s, se);
+		avx2_two_sum(se, pl, t, te);
+		avx2_two_sum(s, t, d, r);
+		r = avx2_add(r, te);
+	}
+};
+
+// lane traits: only the fast specializations have the single word representation the SIMD kernels require
+template<size_t nbits, size_t es>
+struct avx2_batch {
+	static constexpr bool enabled = false;
+};
+
+#if POSIT_FAST_POSIT_16_1
+// posit<16,1> is evaluated in float lanes
+template<>
+struct avx2_batch<NBITS_IS_16, ES_IS_1> {
+	static constexpr bool enabled = true;
+	static_assert(sizeof(posit<NBITS_IS_16, ES_IS_1>) == sizeof(uint16_t), "fast posit<16,1> is expected to be a single 16-bit word");
+	static inline __m256i load(const posit<NBITS_IS_16, ES_IS_1>* p) {
+		return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+	}
+	static inline void store(posit<NBITS_IS_16, ES_IS_1>* p, __m256i bits) {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packus_epi32(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1)));
+	}
+	template<typename LaneOp>
+	static inline __m256i binary(LaneOp op, __m256i a, __m256i b) {
+		__m256 d, r;
+		op(avx2_posit_to_ps<NBITS_IS_16, ES_IS_1>(a), avx2_posit_to_ps<NBITS_IS_16, ES_IS_1>(b), d, r);
+		return avx2_ps_to_posit<NBITS_IS_16, ES_IS_1>(d, r);
+	}
+	template<typename LaneOp>
+	static inline __m256i ternary(LaneOp op, __m256i a, __m256i b, __m256i c) {
+		__m256 d, r;
+		op(avx2_posit_to_ps<NBITS_IS_16, ES_IS_1>(a), avx2_posit_to_ps<NBITS_IS_16, ES_IS_1>(b), avx2_posit_to_ps<NBITS_IS_16, ES_IS_1>(c), d, r);
+		return avx2_ps_to_posit<NBITS_IS_16, ES_IS_1>(d, r);
+	}
+	static inline void to_double(__m256i bits, double* v) {
+		__m256 f = avx2_posit_to_ps<NBITS_IS_16, ES_IS_1>(bits);
+		_mm256_storeu_pd(v, _mm256_cvtps_pd(_mm256_castps256_ps128(f)));
+		_mm256_storeu_pd(v + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(f, 1)));
+	}
+	static inline void to_float(__m256i bits, float* v) {
+		_mm256_storeu_ps(v, avx2_posit_to_ps<NBITS_IS_16, ES_IS_1>(bits));
+	}
+	// doubles are rounded directly: rounding through float first would round twice
+	static inline __m256i from_double(const double* v) {
+		avx2_pd2 zero = { _mm256_setzero_pd(), _mm256_setzero_pd() };
+		return avx2_pd2_to_posit<NBITS_IS_16, ES_IS_1>(avx2_load_pd2(v), zero);
+	}
+	static inline __m256i from_float(const float* v) {
+		return avx2_ps_to_posit<NBITS_IS_16, ES_IS_1>(_mm256_loadu_ps(v), _mm256_setzero_ps());
+	}
+};
+#endif
+
+#if POSIT_FAST_POSIT_32_2
+// posit<32,2> is evaluated in double lanes
+template<>
+struct avx2_batch<NBITS_IS_32, ES_IS_2> {
+	static constexpr bool enabled = true;
+	static_assert(sizeof(posit<NBITS_IS_32, ES_IS_2>) == sizeof(uint32_t), "fast posit<32,2> is expected to be a single 32-bit word");
+	static inline __m256i load(const posit<NBITS_IS_32, ES_IS_2>* p) {
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	}
+	static inline void store(posit<NBITS_IS_32, ES_IS_2>* p, __m256i bits) {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), bits);
+	}
+	template<typename LaneOp>
+	static inline __m256i binary(LaneOp op, __m256i a, __m256i b) {
+		avx2_pd2 va = avx2_posit_to_pd2<NBITS_IS_32, ES_IS_2>(a);
+		avx2_pd2 vb = avx2_posit_to_pd2<NBITS_IS_32, ES_IS_2>(b);
+		avx2_pd2 d, r;
+		op(va.lo, vb.lo, d.lo, r.lo);
+		op(va.hi, vb.hi, d.hi, r.hi);
+		return avx2_pd2_to_posit<NBITS_IS_32, ES_IS_2>(d, r);
+	}
+	template<typename LaneOp>
+	static inline __m256i ternary(LaneOp op, __m256i a, __m256i b, __m256i c) {
+		avx2_pd2 va = avx2_posit_to_pd2<NBITS_IS_32, ES_IS_2>(a);
+		avx2_pd2 vb = avx2_posit_to_pd2<NBITS_IS_32, ES_IS_2>(b);
+		avx2_pd2 vc = avx2_posit_to_pd2<NBITS_IS_32, ES_IS_2>(c);
+		avx2_pd2 d, r;
+		op(va.lo, vb.lo, vc.lo, d.lo, r.lo);
+		op(va.hi, vb.hi, vc.hi, d.hi, r.hi);
+		return avx2_pd2_to_posit<NBITS_IS_32, ES_IS_2>(d, r);
+	}
+	static inline void to_double(__m256i bits, double* v) {
+		avx2_store_pd2(v, avx2_posit_to_pd2<NBITS_IS_32, ES_IS_2>(bits));
+	}
+	static inline void to_float(__m256i bits, float* v) {
+		avx2_pd2 d = avx2_posit_to_pd2<NBITS_IS_32, ES_IS_2>(bits);
+		_mm_storeu_ps(v, _mm256_cvtpd_ps(_mm256_permute2f128_pd(d.lo, d.hi, 0x20)));
+		_mm_storeu_ps(v + 4, _mm256_cvtpd_ps(_mm256_permute2f128_pd(d.lo, d.hi, 0x31)));
+	}
+	static inline __m256i from_double(const double* v) {
+		avx2_pd2 zero = { _mm256_setzero_pd(), _mm256_setzero_pd() };
+		return avx2_pd2_to_posit<NBITS_IS_32, ES_IS_2>(avx2_load_pd2(v), zero);
+	}
+	static inline __m256i from_float(const float* v) {
+		__m256 f = _mm256_loadu_ps(v);
+		avx2_pd2 d, zero = { _mm256_setzero_pd(), _mm256_setzero_pd() };
+		__m256d first = _mm256_cvtps_pd(_mm256_castps256_ps128(f));
+		__m256d second = _mm256_cvtps_pd(_mm256_extractf128_ps(f, 1));
+		d.lo = _mm256_permute2f128_pd(first, second, 0x20);
+		d.hi = _mm256_permute2f128_pd(first, second, 0x31);
+		return avx2_pd2_to_posit<NBITS_IS_32, ES_IS_2>(d, zero);
+	}
+};
+#endif
+
+constexpr size_t AVX2_BATCH_LANES = 8;
+
+// c[i] = a[i] op b[i] for the largest multiple of eight elements, returns the number of elements processed
+template<size_t nbits, size_t es, typename LaneOp, typename ScalarOp>
+inline size_t avx2_binary_n(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n, LaneOp lane_op, ScalarOp scalar_op) {
+	using lanes = avx2_batch<nbits, es>;
+	const __m256i nar = _mm256_set1_epi32(int32_t(uint32_t(1) << (nbits - 1)));
+	size_t i = 0;
+	for (; i + AVX2_BATCH_LANES <= n; i += AVX2_BATCH_LANES) {
+		__m256i bits = lanes::binary(lane_op, lanes::load(a + i), lanes::load(b + i));
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(bits, nar))) {
+			for (size_t j = i; j < i + AVX2_BATCH_LANES; ++j) scalar_op(a[j], b[j], c[j]);
+		}
+		else {
+			lanes::store(c + i, bits);
+		}
+	}
+	return i;
+}
+
+// d[i] = a[i] * b[i] + c[i] with a single rounding
+template<size_t nbits, size_t es>
+inline size_t avx2_fma_n(const posit<nbits, es>* a, const posit<nbits, es>* b, const posit<nbits, es>* c, posit<nbits, es>* d, size_t n) {
+	using lanes = avx2_batch<nbits, es>;
+	const __m256i nar = _mm256_set1_epi32(int32_t(uint32_t(1) << (nbits - 1)));
+	size_t i = 0;
+	for (; i + AVX2_BATCH_LANES <= n; i += AVX2_BATCH_LANES) {
+		__m256i bits = lanes::ternary(avx2_fma_op(), lanes::load(a + i), lanes::load(b + i), lanes::load(c + i));
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(bits, nar))) {
+			for (size_t j = i; j < i + AVX2_BATCH_LANES; ++j) convert(fma(a[j], b[j], c[j]), d[j]);
+		}
+		else {
+			lanes::store(d + i, bits);
+		}
+	}
+	return i;
+}
+
+template<size_t nbits, size_t es>
+inline size_t avx2_to_double_n(const posit<nbits, es>* p, double* v, size_t n) {
+	size_t i = 0;
+	for (; i + AVX2_BATCH_LANES <= n; i += AVX2_BATCH_LANES) avx2_batch<nbits, es>::to_double(avx2_batch<nbits, es>::load(p + i), v + i);
+	return i;
+}
+template<size_t nbits, size_t es>
+inline size_t avx2_to_float_n(const posit<nbits, es>* p, float* v, size_t n) {
+	size_t i = 0;
+	for (; i + AVX2_BATCH_LANES <= n; i += AVX2_BATCH_LANES) avx2_batch<nbits, es>::to_float(avx2_batch<nbits, es>::load(p + i), v + i);
+	return i;
+}
+template<size_t nbits, size_t es>
+inline size_t avx2_from_double_n(const double* v, posit<nbits, es>* p, size_t n) {
+	size_t i = 0;
+	for (; i + AVX2_BATCH_LANES <= n; i += AVX2_BATCH_LANES) avx2_batch<nbits, es>::store(p + i, avx2_batch<nbits, es>::from_double(v + i));
+	return i;
+}
+template<size_t nbits, size_t es>
+inline size_t avx2_from_float_n(const float* v, posit<nbits, es>* p, size_t n) {
+	size_t i = 0;
+	for (; i + AVX2_BATCH_LANES <= n; i += AVX2_BATCH_LANES) avx2_batch<nbits, es>::store(p + i, avx2_batch<nbits, es>::from_float(v + i));
+	return i;
+}
+
+} // namespace internal
+#endif // LIB_USE_AVX2
+
+// c[i] = a[i] + b[i]
+template<size_t nbits, size_t es>
+void posit_add_n(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n) {
+	auto scalar_op = [](const posit<nbits, es>& lhs, const posit<nbits, es>& rhs, posit<nbits, es>& result) { result = lhs + rhs; };
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_binary_n(a, b, c, n, internal::avx2_add_op(), scalar_op);
+#endif
+	for (; i < n; ++i) scalar_op(a[i], b[i], c[i]);
+}
+
+// c[i] = a[i] - b[i]
+template<size_t nbits, size_t es>
+void posit_sub_n(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n) {
+	auto scalar_op = [](const posit<nbits, es>& lhs, const posit<nbits, es>& rhs, posit<nbits, es>& result) { result = lhs - rhs; };
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_binary_n(a, b, c, n, internal::avx2_sub_op(), scalar_op);
+#endif
+	for (; i < n; ++i) scalar_op(a[i], b[i], c[i]);
+}
+
+// c[i] = a[i] * b[i]
+template<size_t nbits, size_t es>
+void posit_mul_n(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n) {
+	auto scalar_op = [](const posit<nbits, es>& lhs, const posit<nbits, es>& rhs, posit<nbits, es>& result) { result = lhs * rhs; };
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_binary_n(a, b, c, n, internal::avx2_mul_op(), scalar_op);
+#endif
+	for (; i < n; ++i) scalar_op(a[i], b[i], c[i]);
+}
+
+// c[i] = a[i] / b[i]
+template<size_t nbits, size_t es>
+void posit_div_n(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n) {
+	auto scalar_op = [](const posit<nbits, es>& lhs, const posit<nbits, es>& rhs, posit<nbits, es>& result) { result = lhs / rhs; };
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_binary_n(a, b, c, n, internal::avx2_div_op(), scalar_op);
+#endif
+	for (; i < n; ++i) scalar_op(a[i], b[i], c[i]);
+}
+
+// d[i] = a[i] * b[i] + c[i] rounded once
+template<size_t nbits, size_t es>
+void posit_fma_n(const posit<nbits, es>* a, const posit<nbits, es>* b, const posit<nbits, es>* c, posit<nbits, es>* d, size_t n) {
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_fma_n(a, b, c, d, n);
+#endif
+	for (; i < n; ++i) convert(fma(a[i], b[i], c[i]), d[i]);
+}
+
+// v[i] = double(p[i])
+template<size_t nbits, size_t es>
+void posit_to_double_n(const posit<nbits, es>* p, double* v, size_t n) {
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_to_double_n(p, v, n);
+#endif
+	for (; i < n; ++i) v[i] = double(p[i]);
+}
+
+// v[i] = float(p[i])
+template<size_t nbits, size_t es>
+void posit_to_float_n(const posit<nbits, es>* p, float* v, size_t n) {
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_to_float_n(p, v, n);
+#endif
+	for (; i < n; ++i) v[i] = float(p[i]);
+}
+
+// p[i] = v[i]
+template<size_t nbits, size_t es>
+void posit_from_double_n(const double* v, posit<nbits, es>* p, size_t n) {
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_from_double_n(v, p, n);
+#endif
+	for (; i < n; ++i) p[i] = v[i];
+}
+
+// p[i] = v[i]
+template<size_t nbits, size_t es>
+void posit_from_float_n(const float* v, posit<nbits, es>* p, size_t n) {
+	size_t i = 0;
+#if defined(LIB_USE_AVX2)
+	if constexpr (internal::avx2_batch<nbits, es>::enabled) i = internal::avx2_from_float_n(v, p, n);
+#endif
+	for (; i < n; ++i) p[i] = v[i];
+}
+
+// bulk conversions between IEEE-754 arrays and posit arrays
+// posits of up to 64 bits convert on their encodings, see posit_ieee_conversion.hpp
+template<size_t nbits, size_t es>
+inline void convert_n(const double* v, posit<nbits, es>* p, size_t n) { posit_from_double_n(v, p, n); }
+template<size_t nbits, size_t es>
+inline void convert_n(const float* v, posit<nbits, es>* p, size_t n) { posit_from_float_n(v, p, n); }
+template<size_t nbits, size_t es>
+inline void convert_n(const posit<nbits, es>* p, double* v, size_t n) { posit_to_double_n(p, v, n); }
+template<size_t nbits, size_t es>
+inline void convert_n(const posit<nbits, es>* p, float* v, size_t n) { posit_to_float_n(p, v, n); }
+
+}} // namespace sw::unum
@@ -0,0 +1,295 @@
+#pragma once
+// posit_chars.hpp: allocation-free conversion of posits to and from character buffers
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <charconv>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <universal/posit/posit_fwd.hpp>
+#include <universal/bitblock/bitblock.hpp>
+
+namespace sw { namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// character conversions
+///
+/// to_chars and from_chars convert posits to and from character buffers with the
+/// semantics of std::to_chars and std::from_chars: no allocation, no locale, no
+/// leading whitespace, and the result reports the end of the conversion and an error code.
+/// Two text formats are supported:
+///   decimal: 1.5, -0.001953125, 3e+20, and nar for NaR
+///   hex:     the native posit format nbits.esxNN...NNp, for example 32.2x40000000p
+/// from_chars recognizes both formats. A hex encoding of a different size is aligned
+/// at its most significant bit, so 16.1x4000p parses as 1.0 into any posit<nbits, 1>.
+/// The decimal conversions go through the native floating-point type that represents the
+/// posit exactly, double or long double, and the shortest decimal form is produced, so
+/// formatting a posit and parsing it back yields the same posit whenever that type
+/// represents all its values. The hex format round trips all posits.
+/// to_chars_n and from_chars_n convert whole arrays.
+
+// text formats of a posit
+enum class posit_chars_format {
+	decimal,  // shortest decimal form that converts back to the same posit, nar for NaR
+	hex       // native posit format nbits.esxNN...NNp
+};
+
+// result of converting an array of posits to characters: count elements have been written
+struct to_chars_n_result {
+	char*     ptr;
+	std::errc ec;
+	size_t    count;
+};
+
+// result of converting characters to an array of posits: count elements have been assigned
+struct from_chars_n_result {
+	const char* ptr;
+	std::errc   ec;
+	size_t      count;
+};
+
+namespace internal {
+
+	// native floating-point type used for the decimal conversions of a posit<nbits, es>:
+	// double when it represents every posit value exactly, long double otherwise
+	template<size_t nbits, size_t es>
+	struct posit_decimal_type {
+		static constexpr size_t fbits = (es + 3 >= nbits ? 0 : nbits - 3 - es);
+		static constexpr size_t max_scale = (nbits < 2 ? 0 : (nbits - 2) << es);
+		using type = typename std::conditional<(fbits < size_t(std::numeric_limits<double>::digits) && max_scale < size_t(std::numeric_limits<double>::max_exponent)), double, long double>::type;
+	};
+
+	inline int hex_digit_value(char c) {
+		if (c >= '0' && c <= '9') return c - '0';
+		c = char(c | 0x20);
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		return -1;
+	}
+
+	inline bool is_posit_separator(char c) {
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v' || c == ',';
+	}
+
+	// case insensitive match of the NaR designation
+	inline bool match_nar(const char* first, const char* last) {
+		return last - first >= 3 && (first[0] | 0x20) == 'n' && (first[1] | 0x20) == 'a' && (first[2] | 0x20) == 'r';
+	}
+
+	// returns the position after the nbits.esx prefix of the hex format, or nullptr when the text is not in hex format
+	inline const char* scan_posit_hex_prefix(const char* first, const char* last, size_t& nbits_in) {
+		std::from_chars_result r = std::from_chars(first, last, nbits_in);
+		if (r.ec != std::errc() || r.ptr == last || *r.ptr != '.') return nullptr;
+		size_t es_in;
+		r = std::from_chars(r.ptr + 1, last, es_in);
+		if (r.ec != std::errc() || r.ptr == last || (*r.ptr != 'x' && *r.ptr != 'X')) return nullptr;
+		return r.ptr + 1;
+	}
+
+	// assign the encoding in the hex digits [first, last), a value of nbits_in bits, aligned at the most significant bit
+	template<size_t nbits, size_t es>
+	void assign_posit_hex_digits(const char* first, const char* last, size_t nbits_in, posit<nbits, es>& p) {
+		const size_t nrDigits = size_t(last - first);
+		if constexpr (nbits <= 64) {
+			if (nrDigits <= 16 && nbits_in <= 64) {
+				uint64_t raw = 0;
+				for (const char* c = first; c < last; ++c) raw = (raw << 4) | uint64_t(hex_digit_value(*c));
+				if (nbits_in > nbits) raw >>= (nbits_in - nbits);
+				else raw <<= (nbits - nbits_in);
+				if constexpr (nbits < 64) raw &= (uint64_t(1) << nbits) - 1;
+				p.set_raw_bits(raw);
+				return;
+			}
+		}
+		// general case: place bit i of the value at bit i + nbits - nbits_in of the encoding
+		bitblock<nbits> raw;
+		const long long offset = (long long)nbits - (long long)nbits_in;
+		for (size_t i = 0; i < nrDigits; ++i) {
+			const unsigned digit = unsigned(hex_digit_value(first[i]));
+			const long long lsb = (long long)(4 * (nrDigits - 1 - i)) + offset;
+			for (unsigned b = 0; b < 4; ++b) {
+				const long long pos = lsb + b;
+				if ((digit >> b) & 1u && pos >= 0 && pos < (long long)nbits) raw.set(size_t(pos));
+			}
+		}
+		if constexpr (nbits <= 64) {
+			p.set_raw_bits(raw.to_ullong());
+		}
+		else {
+			p.set(raw);
+		}
+	}
+
+	template<typename Real>
+	std::to_chars_result real_to_chars(char* first, char* last, Real v, int precision) {
+#if defined(__cpp_lib_to_chars)
+		return std::to_chars(first, last, v, std::chars_format::general, precision);
+#else
+		char buffer[128];
+		int length = std::snprintf(buffer, sizeof(buffer), "%.*Lg", precision, (long double)v);
+		if (length < 0 || size_t(length) >= sizeof(buffer) || length > last - first) return { last, std::errc::value_too_large };
+		for (int i = 0; i < length; ++i) first[i] = buffer[i];
+		return { first + length, std::errc() };
+#endif
+	}
+
+	template<typename Real>
+	std::to_chars_result real_to_chars(char* first, char* last, Real v) {
+#if defined(__cpp_lib_to_chars)
+		return std::to_chars(first, last, v);
+#else
+		return real_to_chars(first, last, v, std::numeric_limits<Real>::max_digits10);
+#endif
+	}
+
+	template<typename Real>
+	std::from_chars_result real_from_chars(const char* first, const char* last, Real& v) {
+#if defined(__cpp_lib_to_chars)
+		return std::from_chars(first, last, v);
+#else
+		// strtold needs a terminated string: copy the token into a local buffer
+		char buffer[128];
+		size_t length = 0;
+		while (first + length < last && length + 1 < sizeof(buffer) && !is_posit_separator(first[length])) {
+			buffer[length] = first[length];
+			++length;
+		}
+		buffer[length] = 0;
+		char* end;
+		errno = 0;
+		long double d = std::strtold(buffer, &end);
+		if (end == buffer) return { first, std::errc::invalid_argument };
+		if (errno == ERANGE) return { first + (end - buffer), std::errc::result_out_of_range };
+		v = Real(d);
+		return { first + (end - buffer), std::errc() };
+#endif
+	}
+
+} // namespace internal
+
+// write a posit to [first, last) in the requested format
+template<size_t nbits, size_t es>
+std::to_chars_result to_chars(char* first, char* last, const posit<nbits, es>& p, posit_chars_format format = posit_chars_format::decimal) {
+	if (format == posit_chars_format::hex) {
+		std::to_chars_result r = std::to_chars(first, last, nbits);
+		if (r.ec != std::errc() || r.ptr == last) return { last, std::errc::value_too_large };
+		*r.ptr++ = '.';
+		r = std::to_chars(r.ptr, last, es);
+		constexpr size_t nrDigits = (nbits + 3) / 4;
+		if (r.ec != std::errc() || size_t(last - r.ptr) < nrDigits + 2) return { last, std::errc::value_too_large };
+		char* digits = r.ptr;
+		*digits++ = 'x';
+		constexpr char hexChar[] = "0123456789abcdef";
+		if constexpr (nbits <= 64) {
+			uint64_t raw = uint64_t(p.encoding());
+			for (size_t i = 0; i < nrDigits; ++i) {
+				digits[nrDigits - 1 - i] = hexChar[raw & 0xF];
+				raw >>= 4;
+			}
+		}
+		else {
+			bitblock<nbits> raw = p.get();
+			for (size_t i = 0; i < nrDigits; ++i) {
+				unsigned nibble = 0;
+				for (unsigned b = 0; b < 4 && 4 * i + b < nbits; ++b) nibble |= unsigned(raw.test(4 * i + b)) << b;
+				digits[nrDigits - 1 - i] = hexChar[nibble];
+			}
+		}
+		digits[nrDigits] = 'p';
+		return { digits + nrDigits + 1, std::errc() };
+	}
+	if (p.isnar()) {
+		if (last - first < 3) return { last, std::errc::value_too_large };
+		first[0] = 'n'; first[1] = 'a'; first[2] = 'r';
+		return { first + 3, std::errc() };
+	}
+	using Real = typename internal::posit_decimal_type<nbits, es>::type;
+	return internal::real_to_chars(first, last, Real(p));
+}
+
+// write a posit to [first, last) as a decimal with precision significant digits, the text operator<< generates for that precision
+template<size_t nbits, size_t es>
+std::to_chars_result to_chars(char* first, char* last, const posit<nbits, es>& p, int precision) {
+	if (p.isnar()) {
+		if (last - first < 3) return { last, std::errc::value_too_large };
+		first[0] = 'n'; first[1] = 'a'; first[2] = 'r';
+		return { first + 3, std::errc() };
+	}
+	using Real = typename internal::posit_decimal_type<nbits, es>::type;
+	return internal::real_to_chars(first, last, Real(p), precision);
+}
+
+// read a posit in decimal or hex format from [first, last)
+// on error p is not modified: invalid_argument when there is no posit at first,
+// result_out_of_range when the decimal value is out of range of the native floating-point type
+template<size_t nbits, size_t es>
+std::from_chars_result from_chars(const char* first, const char* last, posit<nbits, es>& p) {
+	if (internal::match_nar(first, last)) {
+		p.setnar();
+		return { first + 3, std::errc() };
+	}
+	size_t nbits_in;
+	const char* digits = internal::scan_posit_hex_prefix(first, last, nbits_in);
+	if (digits != nullptr) {
+		const char* end = digits;
+		while (end < last && internal::hex_digit_value(*end) >= 0) ++end;
+		if (end == digits || nbits_in == 0) return { first, std::errc::invalid_argument };
+		internal::assign_posit_hex_digits(digits, end, nbits_in, p);
+		if (end < last && *end == 'p') ++end;
+		return { end, std::errc() };
+	}
+	// std::from_chars does not accept a plus sign
+	const char* number = first;
+	if (number < last && *number == '+') {
+		++number;
+		if (number == last || *number == '-' || *number == '+') return { first, std::errc::invalid_argument };
+	}
+	using Real = typename internal::posit_decimal_type<nbits, es>::type;
+	Real v;
+	std::from_chars_result r = internal::real_from_chars(number, last, v);
+	if (r.ec == std::errc::invalid_argument) return { first, r.ec };
+	if (r.ec == std::errc()) p = v;
+	return r;
+}
+
+// write n posits to [first, last), separated by separator
+// when the buffer is too small, the result holds value_too_large and points past the last complete element
+template<size_t nbits, size_t es>
+to_chars_n_result to_chars_n(char* first, char* last, const posit<nbits, es>* p, size_t n, char separator = ' ', posit_chars_format format = posit_chars_format::decimal) {
+	char* ptr = first;
+	for (size_t i = 0; i < n; ++i) {
+		char* element = ptr;
+		if (i > 0) {
+			if (element == last) return { ptr, std::errc::value_too_large, i };
+			*element++ = separator;
+		}
+		std::to_chars_result r = to_chars(element, last, p[i], format);
+		if (r.ec != std::errc()) return { ptr, r.ec, i };
+		ptr = r.ptr;
+	}
+	return { ptr, std::errc(), n };
+}
+
+// read up to n posits from [first, last), separated by whitespace or commas
+// the conversion ends without error at the end of the input; on a malformed element
+// the result holds the error and points at that element
+template<size_t nbits, size_t es>
+from_chars_n_result from_chars_n(const char* first, const char* last, posit<nbits, es>* p, size_t n) {
+	const char* ptr = first;
+	for (size_t i = 0; i < n; ++i) {
+		while (ptr < last && internal::is_posit_separator(*ptr)) ++ptr;
+		if (ptr == last) return { ptr, std::errc(), i };
+		std::from_chars_result r = from_chars(ptr, last, p[i]);
+		if (r.ec != std::errc()) return { ptr, r.ec, i };
+		ptr = r.ptr;
+	}
+	return { ptr, std::errc(), n };
+}
+
+}}  // namespace sw::unum
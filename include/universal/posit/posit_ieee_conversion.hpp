@@ -0,0 +1,190 @@
+#pragma once
+// posit_ieee_conversion.hpp: direct conversions between IEEE-754 float/double and posit encodings of up to 64 bits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <universal/native/limb_arithmetic.hpp>
+
+namespace sw { namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// IEEE-754 conversions
+///
+/// Posits of up to 64 bits convert to and from float and double on their encodings,
+/// with integer shifts instead of value<> and bitblock intermediates.
+/// A value is carried as a (sign, scale, significand) triple with the hidden bit of the
+/// significand at bit 63, and is rounded once: to nearest even on the posit bit string,
+/// without rounding to zero or NaR, or to nearest even in the IEEE-754 format.
+
+namespace internal {
+
+// posit configurations that use the direct conversions: the scales of the larger es do not fit an IEEE-754 double anyway
+template<size_t nbits, size_t es>
+constexpr bool posit_ieee_direct = (nbits <= 64) && (es <= 16);
+
+// the encoding parameters of float and double
+template<typename Real> struct ieee_encoding;
+template<>
+struct ieee_encoding<float> {
+	using bits_type = uint32_t;
+	static constexpr int fbits = 23;
+	static constexpr int bias = 127;
+};
+template<>
+struct ieee_encoding<double> {
+	using bits_type = uint64_t;
+	static constexpr int fbits = 52;
+	static constexpr int bias = 1023;
+};
+
+// round the value (-1)^sign * significand * 2^(scale - 63) to the nearest posit<nbits,es> encoding
+// sticky signals nonzero bits below the significand
+template<size_t nbits, size_t es>
+inline uint64_t posit_encode(bool sign, int scale, uint64_t significand, bool sticky) {
+	constexpr uint64_t mask = (nbits == 64) ? ~uint64_t(0) : ((uint64_t(1) << nbits) - 1);
+	constexpr int maxScale = int(nbits - 2) * (1 << es);
+	uint64_t bits;
+	if (scale >= maxScale) {          // maxpos
+		bits = (uint64_t(1) << (nbits - 1)) - 1;
+	}
+	else if (scale < -maxScale) {     // minpos
+		bits = 1;
+	}
+	else {
+		int k = (scale >= 0) ? (scale >> es) : -((-scale + (1 << es) - 1) >> es);
+		uint64_t e = uint64_t(scale - k * (1 << es));
+		uint64_t regime = (k >= 0) ? (((uint64_t(1) << (k + 1)) - 1) << 1) : uint64_t(1);
+		int len = (k >= 0) ? k + 2 : -k + 1;
+		int avail = int(nbits) - 1 - len;  // bits left for the exponent and fraction
+		uint64_t fraction = significand << 1;  // left aligned, without the hidden bit
+		bool guard;
+		if (avail >= int(es)) {
+			int fa = avail - int(es);      // fraction bits that fit
+			bits = (regime << avail) | (e << fa) | (fa > 0 ? (fraction >> (64 - fa)) : 0);
+			guard = ((fraction >> (63 - fa)) & 1) != 0;
+			sticky |= (fraction << (fa + 1)) != 0;
+		}
+		else {
+			int drop = int(es) - avail;    // exponent bits that do not fit
+			bits = (regime << avail) | (e >> drop);
+			guard = ((e >> (drop - 1)) & 1) != 0;
+			sticky |= (e & ((uint64_t(1) << (drop - 1)) - 1)) != 0 || fraction != 0;
+		}
+		if (guard && (sticky || (bits & 1))) ++bits;
+	}
+	return (sign ? (~bits + 1) : bits) & mask;
+}
+
+// decode a positive, nonzero posit<nbits,es> encoding into its scale and significand, with the hidden bit at bit 63
+template<size_t nbits, size_t es>
+inline void posit_decode(uint64_t bits, int& scale, uint64_t& significand) {
+	uint64_t x = bits << (65 - nbits);  // drop the sign bit: the regime starts at bit 63
+	int m, k;
+	if (x >> 63) {
+		m = limb_clz(~x);
+		k = m - 1;
+	}
+	else {
+		m = limb_clz(x);
+		k = -m;
+	}
+	// skip the regime run and its terminating bit, what remains are the exponent and fraction bits
+	uint64_t remaining = (m < 63) ? (x << (m + 1)) : 0;
+	if constexpr (es > 0) {
+		scale = k * (1 << es) + int(remaining >> (64 - es));
+		remaining <<= es;
+	}
+	else {
+		scale = k;
+	}
+	significand = 0x8000000000000000ull | (remaining >> 1);
+}
+
+// the posit<nbits,es> encoding nearest to the float or double v: NaN and infinities map to NaR
+template<size_t nbits, size_t es, typename Real>
+inline uint64_t ieee_to_posit(Real v) {
+	using ieee = ieee_encoding<Real>;
+	using bits_type = typename ieee::bits_type;
+	constexpr int width = int(sizeof(bits_type)) * 8;
+	constexpr uint64_t emask = (uint64_t(1) << (width - 1 - ieee::fbits)) - 1;
+	bits_type raw;
+	std::memcpy(&raw, &v, sizeof(raw));
+	bool sign = (raw >> (width - 1)) != 0;
+	int biased = int((uint64_t(raw) >> ieee::fbits) & emask);
+	uint64_t fraction = uint64_t(raw) & ((uint64_t(1) << ieee::fbits) - 1);
+	if (biased == int(emask)) return uint64_t(1) << (nbits - 1);  // NaR
+	int scale;
+	uint64_t significand;
+	if (biased == 0) {
+		if (fraction == 0) return 0;
+		// subnormal: normalize the fraction
+		int lz = limb_clz(fraction);
+		significand = fraction << lz;
+		scale = 64 - lz - ieee::bias - ieee::fbits;
+	}
+	else {
+		significand = 0x8000000000000000ull | (fraction << (63 - ieee::fbits));
+		scale = biased - ieee::bias;
+	}
+	return posit_encode<nbits, es>(sign, scale, significand, false);
+}
+
+// round the value (-1)^sign * significand * 2^(scale - 63) to the nearest float or double
+template<typename Real>
+inline Real ieee_compose(bool sign, int scale, uint64_t significand) {
+	using ieee = ieee_encoding<Real>;
+	using bits_type = typename ieee::bits_type;
+	constexpr int width = int(sizeof(bits_type)) * 8;
+	constexpr int emin = 1 - ieee::bias;
+	uint64_t bits;
+	if (scale > ieee::bias) {
+		bits = uint64_t((uint64_t(1) << (width - 1 - ieee::fbits)) - 1) << ieee::fbits;  // infinity
+	}
+	else {
+		// the lsb of the IEEE significand, further down for subnormals
+		int shift = 63 - ieee::fbits + ((scale < emin) ? emin - scale : 0);
+		uint64_t m;
+		if (shift > 64) {
+			m = 0;
+		}
+		else if (shift == 64) {
+			m = (significand << 1) != 0 ? 1 : 0;  // above half of the smallest subnormal, ties go to zero
+		}
+		else {
+			m = significand >> shift;
+			bool guard = ((significand >> (shift - 1)) & 1) != 0;
+			bool sticky = (significand << (65 - shift)) != 0;
+			if (guard && (sticky || (m & 1))) ++m;
+		}
+		// a carry out of the significand increments the exponent field, up to infinity
+		bits = (scale < emin) ? m : (uint64_t(scale - emin) << ieee::fbits) + m;
+	}
+	bits_type raw = bits_type(bits | (uint64_t(sign) << (width - 1)));
+	Real v;
+	std::memcpy(&v, &raw, sizeof(v));
+	return v;
+}
+
+// the float or double nearest to the posit<nbits,es> encoding
+template<size_t nbits, size_t es, typename Real>
+inline Real posit_to_ieee(uint64_t bits) {
+	constexpr uint64_t mask = (nbits == 64) ? ~uint64_t(0) : ((uint64_t(1) << nbits) - 1);
+	constexpr uint64_t nar = uint64_t(1) << (nbits - 1);
+	if (bits == 0) return Real(0);
+	if (bits == nar) return std::numeric_limits<Real>::quiet_NaN();
+	bool sign = (bits & nar) != 0;
+	if (sign) bits = (~bits + 1) & mask;
+	int scale;
+	uint64_t significand;
+	posit_decode<nbits, es>(bits, scale, significand);
+	return ieee_compose<Real>(sign, scale, significand);
+}
+
+} // namespace internal
+
+}} // namespace sw::unum
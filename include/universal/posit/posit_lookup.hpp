@@ -0,0 +1,344 @@
+#pragma once
+// posit_lookup.hpp: compile-time generated lookup tables for small posit configurations
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <array>
+#include <type_traits>
+#include <universal/posit/lookup_config.hpp>
+
+namespace sw { namespace unum {
+
+/// //////////////////////////////////////////////////////////////////
+/// lookup tables for small posits
+///
+/// The tables are indexed by the encodings of the operands, and are generated in
+/// constant expressions by a reference arithmetic that operates on the raw encodings.
+/// The reference arithmetic represents a posit value as a (sign, scale, significand) triple
+/// with the hidden bit of the significand at LOOKUP_HIDDEN_BIT, and rounds with the
+/// posit rounding rules: round to nearest even, no rounding to zero or NaR.
+/// Binary operator tables have 2^(2*nbits) entries and are indexed by (a << nbits) | b.
+///
+/// Tables are only generated for the configurations and operators that are used.
+
+namespace internal {
+
+constexpr int LOOKUP_HIDDEN_BIT = 30;
+
+// the storage type of a table entry
+template<size_t nbits>
+using lookup_storage_t = typename std::conditional<(nbits <= 8), uint8_t, uint16_t>::type;
+
+enum class lookup_operator { add, sub, mul, div, sqrt, reciprocal, exp, log };
+
+struct lookup_triple {
+	bool sign;
+	int scale;
+	uint64_t significand;
+};
+
+template<size_t nbits>
+constexpr uint64_t lookup_nar() { return uint64_t(1) << (nbits - 1); }
+
+template<size_t nbits>
+constexpr uint64_t lookup_one() { return uint64_t(1) << (nbits - 2); }
+
+constexpr int lookup_msb(uint64_t v) {
+	int msb = -1;
+	while (v) {
+		++msb;
+		v >>= 1;
+	}
+	return msb;
+}
+
+// decode a posit encoding that is neither zero nor NaR
+template<size_t nbits, size_t es>
+constexpr lookup_triple lookup_decode(uint64_t bits) {
+	constexpr uint64_t mask = (uint64_t(1) << nbits) - 1;
+	lookup_triple t{ false, 0, 0 };
+	t.sign = (bits >> (nbits - 1)) & 1;
+	if (t.sign) bits = (~bits + 1) & mask;
+	// regime: a run of identical bits terminated by the opposite bit or the end of the encoding
+	int pos = int(nbits) - 2;
+	bool r = (bits >> pos) & 1;
+	int run = 0;
+	while (pos >= 0 && bool((bits >> pos) & 1) == r) {
+		++run;
+		--pos;
+	}
+	int k = (r ? run - 1 : -run);
+	if (pos >= 0) --pos; // skip the terminating bit
+	// exponent: bits beyond the end of the encoding are 0
+	int e = 0;
+	for (size_t i = 0; i < es; ++i) {
+		e <<= 1;
+		if (pos >= 0) {
+			e |= int((bits >> pos) & 1);
+			--pos;
+		}
+	}
+	// fraction
+	int fbits = pos + 1;
+	uint64_t fraction = (fbits > 0 ? bits & ((uint64_t(1) << fbits) - 1) : 0);
+	t.scale = k * (1 << es) + e;
+	t.significand = (uint64_t(1) << LOOKUP_HIDDEN_BIT) | (fraction << (LOOKUP_HIDDEN_BIT - fbits));
+	return t;
+}
+
+// round the value significand * 2^lsb_scale, with sticky representing nonzero bits below the lsb, to a posit encoding
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_round(bool sign, int lsb_scale, uint64_t significand, bool sticky) {
+	static_assert(nbits <= 16, "lookup tables are limited to posits of up to 16 bits");
+	constexpr uint64_t mask = (uint64_t(1) << nbits) - 1;
+	constexpr int useed_scale = (1 << es);
+	constexpr int FBITS = 40; // fraction bits carried into the rounding
+	int msb = lookup_msb(significand);
+	int scale = lsb_scale + msb;
+	// normalize the fraction to FBITS bits below the hidden bit
+	uint64_t fraction = 0;
+	if (msb > FBITS) {
+		sticky = sticky || (significand & ((uint64_t(1) << (msb - FBITS)) - 1));
+		fraction = (significand >> (msb - FBITS));
+	}
+	else {
+		fraction = (significand << (FBITS - msb));
+	}
+	fraction &= (uint64_t(1) << FBITS) - 1;
+
+	int k = (scale >= 0 ? scale / useed_scale : -((-scale + useed_scale - 1) / useed_scale));
+	int e = scale - k * useed_scale;
+	uint64_t bits = 0;
+	if (k >= int(nbits) - 2) {
+		bits = (uint64_t(1) << (nbits - 1)) - 1;  // maxpos
+	}
+	else if (k < -(int(nbits) - 2)) {
+		bits = 1;                                 // minpos
+	}
+	else {
+		uint64_t regime = (k >= 0 ? ((uint64_t(1) << (k + 1)) - 1) << 1 : uint64_t(1));
+		int rbits = (k >= 0 ? k + 2 : -k + 1);
+		int rem = int(nbits) - 1 - rbits;         // bits left for exponent and fraction
+		constexpr int W = int(es) + FBITS;
+		uint64_t tail = (uint64_t(e) << FBITS) | fraction;
+		uint64_t top = tail >> (W - rem);
+		bool guard = (tail >> (W - rem - 1)) & 1;
+		bool rest = sticky || (tail & ((uint64_t(1) << (W - rem - 1)) - 1));
+		bits = (regime << rem) | top;
+		if (guard && (rest || (bits & 1))) ++bits;
+	}
+	return (sign ? (~bits + 1) & mask : bits);
+}
+
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_negate(uint64_t a) {
+	return (~a + 1) & ((uint64_t(1) << nbits) - 1);
+}
+
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_add(uint64_t a, uint64_t b) {
+	if (a == lookup_nar<nbits>() || b == lookup_nar<nbits>()) return lookup_nar<nbits>();
+	if (a == 0) return b;
+	if (b == 0) return a;
+	lookup_triple x = lookup_decode<nbits, es>(a);
+	lookup_triple y = lookup_decode<nbits, es>(b);
+	if (x.scale < y.scale || (x.scale == y.scale && x.significand < y.significand)) {
+		lookup_triple t = x; x = y; y = t;
+	}
+	// align the smaller operand, and jam the bits shifted out into its lsb
+	constexpr int ALIGN = 61 - LOOKUP_HIDDEN_BIT;
+	uint64_t mx = x.significand << ALIGN;
+	uint64_t my = y.significand << ALIGN;
+	int d = x.scale - y.scale;
+	if (d > 61) {
+		my = 1;
+	}
+	else if (d > 0) {
+		bool sticky = (my & ((uint64_t(1) << d) - 1)) != 0;
+		my >>= d;
+		if (sticky) my |= 1;
+	}
+	uint64_t sum = (x.sign == y.sign ? mx + my : mx - my);
+	if (sum == 0) return 0;
+	return lookup_round<nbits, es>(x.sign, x.scale - 61, sum, false);
+}
+
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_mul(uint64_t a, uint64_t b) {
+	if (a == lookup_nar<nbits>() || b == lookup_nar<nbits>()) return lookup_nar<nbits>();
+	if (a == 0 || b == 0) return 0;
+	lookup_triple x = lookup_decode<nbits, es>(a);
+	lookup_triple y = lookup_decode<nbits, es>(b);
+	return lookup_round<nbits, es>(x.sign != y.sign, x.scale + y.scale - 2 * LOOKUP_HIDDEN_BIT, x.significand * y.significand, false);
+}
+
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_div(uint64_t a, uint64_t b) {
+	if (a == lookup_nar<nbits>() || b == lookup_nar<nbits>() || b == 0) return lookup_nar<nbits>();
+	if (a == 0) return 0;
+	lookup_triple x = lookup_decode<nbits, es>(a);
+	lookup_triple y = lookup_decode<nbits, es>(b);
+	uint64_t n = x.significand << 32;
+	return lookup_round<nbits, es>(x.sign != y.sign, x.scale - y.scale - 32, n / y.significand, (n % y.significand) != 0);
+}
+
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_reciprocal(uint64_t a) {
+	return lookup_div<nbits, es>(lookup_one<nbits>(), a);
+}
+
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_sqrt(uint64_t a) {
+	if (a == lookup_nar<nbits>() || ((a >> (nbits - 1)) & 1)) return lookup_nar<nbits>();
+	if (a == 0) return 0;
+	lookup_triple x = lookup_decode<nbits, es>(a);
+	// x = significand * 2^(scale - LOOKUP_HIDDEN_BIT): shift the significand so the exponent becomes even
+	int shift = ((x.scale - LOOKUP_HIDDEN_BIT - 32) % 2 == 0 ? 32 : 31);
+	uint64_t m = x.significand << shift;
+	int exponent = x.scale - LOOKUP_HIDDEN_BIT - shift;
+	// bitwise integer square root
+	uint64_t root = 0, remainder = m;
+	uint64_t bit = uint64_t(1) << 62;
+	while (bit > m) bit >>= 2;
+	while (bit != 0) {
+		if (remainder >= root + bit) {
+			remainder -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return lookup_round<nbits, es>(false, exponent / 2, root, remainder != 0);
+}
+
+// value of a posit encoding as a double: exact for the posits that have tables
+template<size_t nbits, size_t es>
+constexpr double lookup_to_double(uint64_t a) {
+	lookup_triple x = lookup_decode<nbits, es>(a);
+	double v = double(x.significand);
+	int scale = x.scale - LOOKUP_HIDDEN_BIT;
+	for (; scale > 0; --scale) v *= 2.0;
+	for (; scale < 0; ++scale) v *= 0.5;
+	return (x.sign ? -v : v);
+}
+
+// round v * 2^k, where v approximates a transcendental value, to a posit encoding
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_from_double(double v, int k = 0) {
+	if (v == 0.0) return 0;
+	bool sign = (v < 0.0);
+	if (sign) v = -v;
+	int scale = 0;
+	while (v >= 2.0) { v *= 0.5; ++scale; }
+	while (v < 1.0) { v *= 2.0; --scale; }
+	for (int i = 0; i < 62; ++i) v *= 2.0;
+	// the value is not exact, so it carries a sticky bit
+	return lookup_round<nbits, es>(sign, scale + k - 62, uint64_t(v), true);
+}
+
+// exp and log tables need the dynamic range of the posit to be representable in double precision
+template<size_t nbits, size_t es>
+constexpr bool lookup_in_double_range() { return (int(nbits) - 2) * (1 << es) < 1000; }
+
+// ln(2) split in a part that is exact in 32 bits and a correction
+constexpr double LOOKUP_LN2_HI = 6.93147180369123816490e-01;
+constexpr double LOOKUP_LN2_LO = 1.90821492927058770002e-10;
+
+// exp and log are evaluated in double precision, which carries more than 40 bits beyond the fraction of the posits with tables
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_exp(uint64_t a) {
+	if (a == lookup_nar<nbits>()) return lookup_nar<nbits>();
+	if (a == 0) return lookup_one<nbits>();
+	constexpr int maxpos_scale = (int(nbits) - 2) * (1 << es);
+	double x = lookup_to_double<nbits, es>(a);
+	if (x > (maxpos_scale + 1) * LOOKUP_LN2_HI) return lookup_round<nbits, es>(false, maxpos_scale, 1, false);
+	if (x < -(maxpos_scale + 1) * LOOKUP_LN2_HI) return lookup_round<nbits, es>(false, -maxpos_scale, 1, false);
+	// x = k*ln2 + r, |r| <= ln2/2
+	double t = x / (LOOKUP_LN2_HI + LOOKUP_LN2_LO);
+	int k = int(t < 0 ? t - 0.5 : t + 0.5);
+	double r = (x - k * LOOKUP_LN2_HI) - k * LOOKUP_LN2_LO;
+	double sum = 1.0, term = 1.0;
+	for (int i = 1; i < 20; ++i) {
+		term *= r / i;
+		sum += term;
+	}
+	return lookup_from_double<nbits, es>(sum, k);
+}
+
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_log(uint64_t a) {
+	if (a == lookup_nar<nbits>() || a == 0 || ((a >> (nbits - 1)) & 1)) return lookup_nar<nbits>();
+	if (a == lookup_one<nbits>()) return 0;
+	// x = m * 2^s, m in [sqrt(2)/2, sqrt(2))
+	lookup_triple x = lookup_decode<nbits, es>(a);
+	double m = double(x.significand) / double(uint64_t(1) << LOOKUP_HIDDEN_BIT);
+	int s = x.scale;
+	if (m > 1.4142135623730950488) {
+		m *= 0.5;
+		++s;
+	}
+	// log(m) = 2 * atanh(z), z = (m - 1) / (m + 1), |z| < 0.172
+	double z = (m - 1.0) / (m + 1.0);
+	double z2 = z * z;
+	double sum = 0.0, power = z;
+	for (int i = 1; i < 40; i += 2) {
+		sum += power / i;
+		power *= z2;
+	}
+	return lookup_from_double<nbits, es>((s * LOOKUP_LN2_HI + 2.0 * sum) + s * LOOKUP_LN2_LO);
+}
+
+// the result of an operator on encodings: b is ignored by the unary operators
+template<size_t nbits, size_t es>
+constexpr uint64_t lookup_evaluate(lookup_operator op, uint64_t a, uint64_t b) {
+	switch (op) {
+	case lookup_operator::add:        return lookup_add<nbits, es>(a, b);
+	case lookup_operator::sub:        return lookup_add<nbits, es>(a, (b == lookup_nar<nbits>() ? b : lookup_negate<nbits, es>(b)));
+	case lookup_operator::mul:        return lookup_mul<nbits, es>(a, b);
+	case lookup_operator::div:        return lookup_div<nbits, es>(a, b);
+	case lookup_operator::sqrt:       return lookup_sqrt<nbits, es>(a);
+	case lookup_operator::reciprocal: return lookup_reciprocal<nbits, es>(a);
+	case lookup_operator::exp:        return lookup_exp<nbits, es>(a);
+	case lookup_operator::log:        return lookup_log<nbits, es>(a);
+	}
+	return lookup_nar<nbits>();
+}
+
+template<size_t nbits, size_t es, lookup_operator op>
+constexpr std::array<lookup_storage_t<nbits>, (size_t(1) << (2 * nbits))> generate_binary_lookup_table() {
+	static_assert(nbits <= POSIT_LOOKUP_BINARY_NBITS, "binary operator lookup tables are limited to posits of up to POSIT_LOOKUP_BINARY_NBITS bits");
+	std::array<lookup_storage_t<nbits>, (size_t(1) << (2 * nbits))> table{};
+	for (uint64_t a = 0; a < (uint64_t(1) << nbits); ++a) {
+		for (uint64_t b = 0; b < (uint64_t(1) << nbits); ++b) {
+			table[(a << nbits) | b] = lookup_storage_t<nbits>(lookup_evaluate<nbits, es>(op, a, b));
+		}
+	}
+	return table;
+}
+
+template<size_t nbits, size_t es, lookup_operator op>
+constexpr std::array<lookup_storage_t<nbits>, (size_t(1) << nbits)> generate_unary_lookup_table() {
+	static_assert(nbits <= POSIT_LOOKUP_UNARY_NBITS, "unary operator lookup tables are limited to posits of up to POSIT_LOOKUP_UNARY_NBITS bits");
+	static_assert((op != lookup_operator::exp && op != lookup_operator::log) || lookup_in_double_range<nbits, es>(), "exp and log lookup tables are limited to posits with a dynamic range that fits in double precision");
+	std::array<lookup_storage_t<nbits>, (size_t(1) << nbits)> table{};
+	for (uint64_t a = 0; a < (uint64_t(1) << nbits); ++a) {
+		table[a] = lookup_storage_t<nbits>(lookup_evaluate<nbits, es>(op, a, 0));
+	}
+	return table;
+}
+
+} // namespace internal
+
+// binary operator table of posit<nbits,es>: add, sub, mul, or div, indexed by (a.encoding() << nbits) | b.encoding()
+template<size_t nbits, size_t es, internal::lookup_operator op>
+inline constexpr auto posit_binary_lookup = internal::generate_binary_lookup_table<nbits, es, op>();
+
+// unary operator table of posit<nbits,es>: sqrt, reciprocal, exp, or log, indexed by a.encoding()
+template<size_t nbits, size_t es, internal::lookup_operator op>
+inline constexpr auto posit_unary_lookup = internal::generate_unary_lookup_table<nbits, es, op>();
+
+}} // namespace sw::unum
@@ -86,14 +86,22 @@ inline int min_scale() {
 	return -int(half_range); 
 }
 
-/* 
+/*
  quire: template class representing a quire associated with a posit configuration
- nbits and es are the same as the posit configuration, 
+ nbits and es are the same as the posit configuration,
  capacity indicates the power of 2 number of accumulations of maxpos^2 the quire can support
 
  All values in and out of the quire are normalized (sign, scale, fraction) triplets.
  Even though a quire is very strongly coupled to a posit configuration via the dynamic range
  a particular posit configuration exhibits, the class is designed to NOT depend on the posit<nbits,es> class definition.
+
+ The accumulator is stored as a little-endian array of 64-bit limbs. The segmented
+ (capacity, upper, lower) layout is a view over that storage:
+   bit [0, half_range)                                        lower accumulator
+   bit [half_range, half_range + upper_range)                 upper accumulator
+   bit [half_range + upper_range, qbits + 1)                  capacity segment
+ Incoming fractions are shifted into limb alignment and added with a word-level
+ add-with-carry that terminates as soon as the carry dies out.
  */
 template<size_t nbits, size_t es, size_t capacity = 30>
 class quire {
@@ -105,9 +113,14 @@ public:
 	// the upper is 1 bit bigger than the lower because maxpos^2 has that scale
 	static constexpr size_t upper_range = half_range + 1;     // size of the upper accumulator
 	static constexpr size_t qbits = range + capacity;		  // size of the quire minus the sign bit: we are managing the sign explicitly
-	
+	// limb storage of the segmented accumulator
+	static constexpr size_t accbits = half_range + upper_range + capacity;  // number of bits in the accumulator: qbits + 1
+	static constexpr size_t bitsInLimb = 64;
+	static constexpr size_t nrLimbs = (accbits + bitsInLimb - 1) / bitsInLimb;
+	static constexpr uint64_t MSL_MASK = (accbits % bitsInLimb) ? ((uint64_t(1) << (accbits % bitsInLimb)) - 1) : ~uint64_t(0);
+
 	// Constructors
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
+	quire() : _sign(false) { clear_limbs(); }
 
 	quire(int8_t initial_value)   { *this = initial_value; }
 	quire(int16_t initial_value)  { *this = initial_value; }
@@ -132,38 +145,14 @@ public:
 
 		int scale = rhs.scale();
 		// TODO: we are clamping the values of the RHS to be within the dynamic range of the posit
-		// TODO: however, on the upper side we also have the capacity bits, which gives us the opportunity 
+		// TODO: however, on the upper side we also have the capacity bits, which gives us the opportunity
 		// TODO: to accept larger scale values than the dynamic range of the posit.
 		// TODO: When you are assigning the sum of quires you could hit this condition.
 		if (scale >  int(half_range)) 	throw operand_too_large_for_quire{};
 		if (scale < -int(half_range)) 	throw operand_too_small_for_quire{};
 
-		int i, f; // running bit pointers, i for the quire, f for the incoming fraction
-		sw::unum::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = half_range + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = half_range - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
+		// the quire is zero, so assignment is an accumulation into an empty accumulator
+		add_value(rhs);
 		return *this;
 	}
 	quire& operator=(const posit<nbits, es>& rhs) {
@@ -186,26 +175,15 @@ public:
 		clear();
 		// transform to sign-magnitude
 		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
+		uint64_t magnitude;
 		magnitude = _sign ? -rhs : rhs;
-		unsigned msb = findMostSignificantBit(magnitude);
+		unsigned msb = findMostSignificantBit((unsigned long long)magnitude);
 		if (msb > half_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
 		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
+			// the integer bits start at the radix point
+			add_aligned(&magnitude, 1, int(radix_point));
 		}
 		return *this;
 	}
@@ -216,18 +194,9 @@ public:
 			throw operand_too_large_for_quire{};
 		}
 		else {
-			// copy the value into the quire
-			uint64_t mask = uint64_t(1);
-			for (unsigned i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (unsigned i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
+			// the integer bits start at the radix point
+			uint64_t magnitude = rhs;
+			add_aligned(&magnitude, 1, int(radix_point));
 		}
 		return *this;
 	}
@@ -249,7 +218,7 @@ public:
 
 	// All values in (and out) of the quire are normalized (sign, scale, fraction) triplets.
 
-	// Add a normalized value to the quire value. 
+	// Add a normalized value to the quire value.
 	template<size_t fbits>
 	quire& operator+=(const value<fbits>& rhs) {
 		if (rhs.iszero()) return *this;
@@ -260,6 +229,11 @@ public:
 		if (rhs.scale() < -int(half_range)) {
 			throw operand_too_small_for_quire{};
 		}
+		// transform the fraction into limbs once, and reuse the aligned limbs for compare and add/subtract
+		constexpr size_t nrFractionLimbs = (fbits + 1 + bitsInLimb - 1) / bitsInLimb;
+		uint64_t fraction[nrFractionLimbs];
+		fixed_point_limbs(rhs, fraction);
+		int lsb = int(radix_point) + rhs.scale() - int(fbits);
 		// sign/magnitude classification
 		// operation      add magnitudes           subtract magnitudes
 		//                                     a < b       a = b      a > b
@@ -268,25 +242,23 @@ public:
 		// (-a) + (+b)                       +(b - a)    +(a - b)   -(a - b)
 		// (-a) + (-b)      -(a + b)
 		if (_sign == rhs.sign()) {
-			add_value(rhs);
+			add_aligned(fraction, nrFractionLimbs, lsb);
 			// _sign stays the same, so nothing new to assign
 		}
 		else {
 			// subtract magnitudes
-			int cmp = CompareMagnitude(rhs);
+			int cmp = compare_aligned(fraction, nrFractionLimbs, lsb);
 			if (cmp < 0) {
-				// TODO: is there a way to NOT have to swap the whole quire?
-				value<qbits> subtractend = this->to_value();
-				*this = rhs;
-				subtract_value(subtractend);
+				// the magnitude of the rhs is bigger: compute rhs - quire in place
+				reverse_subtract_aligned(fraction, nrFractionLimbs, lsb);
 				_sign = rhs.sign();
 			}
 			else if (cmp > 0) {
-				subtract_value(rhs);
+				subtract_aligned(fraction, nrFractionLimbs, lsb);
 				// _sign stays the same
 			}
 			else {
-				subtract_value(rhs);
+				subtract_aligned(fraction, nrFractionLimbs, lsb);
 				_sign = false;
 			}
 		}
@@ -297,7 +269,7 @@ public:
 	quire& operator-=(const value<fbits>& rhs) {
 		return *this += -rhs;
 	}
-	
+
 	// add a posit directly (syntactic sugar)
 	quire& operator+=(const posit<nbits, es>& rhs) {
 		return operator+=(rhs.to_value());
@@ -307,20 +279,18 @@ public:
 		return operator-=(rhs.to_value());
 	}
 
-	// add two quires
+	// add two quires: the accumulators share the same alignment, so the sum is exact and never rounds
 	quire& operator+=(const quire& q) {
-		return operator+=(q.to_value());
+		return accumulate(q._limb, q._sign);
 	}
 	// subtract two quires
 	quire& operator-=(const quire& q) {
-		return operator-=(q.to_value());
+		return accumulate(q._limb, !q._sign);
 	}
-	
+
 	// bit addressing operator
 	bool operator[](int index) const {
-		if (index < int(radix_point)) return _lower[index];
-		if (index < int(radix_point) + int(upper_range)) return _upper[index - int(radix_point)];
-		if (index < int(radix_point) + int(upper_range) + int(capacity)) return _capacity[index - int(radix_point) - int(upper_range)];
+		if (index >= 0 && index < int(accbits)) return bit(size_t(index));
 		throw "index out of range";
 	}
 
@@ -330,9 +300,7 @@ public:
 	// reset the state of a quire to zero
 	void reset() {
 		_sign = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		clear_limbs();
 	}
 	// semantic sugar: clear the state of a quire to zero
 	void clear() { reset(); }
@@ -370,33 +338,18 @@ public:
 				if (msb_u != -1) return false; // fail, incorrect format
 				segment = 2;
 			}
-			else if (*it == '1') {
-				switch (segment) {
-				case 0:
-					_capacity.set(msb_c--);
-					break;
-				case 1:
-					_upper.set(msb_u--);
-					break;
-				case 2:
-					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.set(msb_l--);
-					break;
-				default:
-					return false; // fail, incorrect state
-				}
-			}
 			else {
+				bool b = (*it == '1');
 				switch (segment) {
 				case 0:
-					_capacity.reset(msb_c--);
+					set_bit(half_range + upper_range + size_t(msb_c--), b);
 					break;
 				case 1:
-					_upper.reset(msb_u--);
+					set_bit(half_range + size_t(msb_u--), b);
 					break;
 				case 2:
 					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.reset(msb_l--);
+					set_bit(size_t(msb_l--), b);
 					break;
 				default:
 					return false; // fail, incorrect state
@@ -407,21 +360,15 @@ public:
 	}
 
 // Selectors
-	
+
 	// Compare magnitudes between quire and value: returns -1 if q < v, 0 if q == v, and 1 if q > v
 	template<size_t fbits>
-	int CompareMagnitude(const value<fbits>& v) {
-		// inefficient as we are copying a whole quire just to reset the sign bit, but we are leveraging the comparison logic
-		quire<nbits, es, capacity> absq = abs(*this);
-		//value<qbits> absq = abs(*this);
-		value<fbits> absv = abs(v);
-		if (absq < absv) {
-			return -1;
-		}
-		else if (absq > absv) {
-			return 1;
-		}
-		return 0;
+	int CompareMagnitude(const value<fbits>& v) const {
+		if (v.iszero()) return iszero() ? 0 : 1;
+		constexpr size_t nrFractionLimbs = (fbits + 1 + bitsInLimb - 1) / bitsInLimb;
+		uint64_t fraction[nrFractionLimbs];
+		fixed_point_limbs(v, fraction);
+		return compare_aligned(fraction, nrFractionLimbs, int(radix_point) + v.scale() - int(fbits));
 	}
 	// query functions for quire attributes
 	inline int dynamic_range() const { return int(range); }
@@ -431,96 +378,225 @@ public:
 	inline size_t total_bits() const { return qbits + 1; }
 	inline bool isneg() const { return _sign; }
 	inline bool ispos() const { return _sign; }
-	inline bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
-	int scale() const {
-		int msb = int(capacity)-1; // indicative of no bits set
-		for (; msb >= 0; msb--) {
-			if (_capacity.test(msb)) break;
+	inline bool iszero() const {
+		for (size_t i = 0; i < nrLimbs; ++i) {
+			if (_limb[i]) return false;
 		}
-		if (msb >= 0) return msb + upper_range;
-		for (msb = int(upper_range) - 1; msb >= 0; msb--) {
-			if (_upper.test(msb)) break;
-		}
-		if (msb >= 0) return msb;
-		for (int i = int(half_range) - 1; i >= 0; i--, msb--) {
-			if (_lower.test(i)) break;
-		}
-		return msb;
+		return true;
+	}
+	int scale() const {
+		// no bits set returns -half_range - 1
+		return msb_position() - int(half_range);
 	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
 	inline bool sign() const { return _sign; }
 	inline float sign_value() const {	return (_sign ? -1.0 : 1.0); }
 	bitblock<qbits+1> get() const {
-		bitblock<qbits+1> q;
-		int msb = 0;
-		for (int i = 0; i < half_range; i++) {
-			q[msb] = _lower[i];
-			msb++;
-		}
-		for (int i = 0; i < upper_range; i++) {
-			q[msb] = _upper[i];
-			msb++;
-		}
-		for (int i = 0; i < capacity; i++) {
-			q[msb] = _capacity[i];
-			msb++;
-		}
-		return q;
+		return extract<qbits + 1>(0);
 	}
+	// segment views of the accumulator
+	bitblock<capacity>    capacity_segment() const { return extract<capacity>(int(half_range + upper_range)); }
+	bitblock<upper_range> upper_segment() const    { return extract<upper_range>(int(half_range)); }
+	bitblock<half_range>  lower_segment() const    { return extract<half_range>(0); }
+
 	value<qbits> to_value() const {
-		// find the MSB and build the fraction
-		bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _capacity[i];
-			}
+		int msb = msb_position();
+		if (msb < 0) return value<qbits>(_sign, 0, bitblock<qbits>(), true, false);
+		// the fraction consists of all the bits below the msb, left-aligned
+		bitblock<qbits> fraction = extract<qbits>(msb - int(qbits));
+		return value<qbits>(_sign, msb - int(half_range), fraction, false, false);
+	}
+	bool anyAfter(int index) const {
+		if (index < 0) return false;
+		if (index >= int(accbits)) index = int(accbits) - 1;
+		size_t limb = size_t(index) / bitsInLimb;
+		size_t shift = size_t(index) % bitsInLimb;
+		uint64_t mask = (shift == bitsInLimb - 1) ? ~uint64_t(0) : ((uint64_t(1) << (shift + 1)) - 1);
+		if (_limb[limb] & mask) return true;
+		for (size_t i = 0; i < limb; ++i) {
+			if (_limb[i]) return true;
 		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _upper[i];
-			}
+		return false;
+	}
+
+private:
+	bool				   _sign;
+	// segmented accumulator stored in limbs to enable word-level carry propagation
+	uint64_t               _limb[nrLimbs];
+
+	void clear_limbs() {
+		for (size_t i = 0; i < nrLimbs; ++i) _limb[i] = 0;
+	}
+	bool bit(size_t index) const {
+		return (_limb[index / bitsInLimb] >> (index % bitsInLimb)) & 0x1;
+	}
+	void set_bit(size_t index, bool v) {
+		uint64_t mask = uint64_t(1) << (index % bitsInLimb);
+		if (v) _limb[index / bitsInLimb] |= mask; else _limb[index / bitsInLimb] &= ~mask;
+	}
+	// position of the most significant bit set in the accumulator, -1 if the quire is zero
+	int msb_position() const {
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			if (_limb[i]) return i * int(bitsInLimb) + int(findMostSignificantBit((unsigned long long)_limb[i])) - 1;
+		}
+		return -1;
+	}
+	// return the 64 accumulator bits starting at bit position pos: bits outside of the accumulator read as 0
+	uint64_t fetch(int pos) const {
+		if (pos <= -int(bitsInLimb) || pos >= int(accbits)) return 0;
+		if (pos < 0) return _limb[0] << (-pos);
+		size_t limb = size_t(pos) / bitsInLimb;
+		size_t shift = size_t(pos) % bitsInLimb;
+		uint64_t word = _limb[limb] >> shift;
+		if (shift && limb + 1 < nrLimbs) word |= _limb[limb + 1] << (bitsInLimb - shift);
+		return word;
+	}
+	// extract sbits accumulator bits starting at bit position lsb into a bitblock
+	template<size_t sbits>
+	bitblock<sbits> extract(int lsb) const {
+		bitblock<sbits> segment;
+		if (sbits == 0) return segment;
+		constexpr size_t nrChunks = (sbits + bitsInLimb - 1) / bitsInLimb;
+		for (int c = int(nrChunks) - 1; c >= 0; --c) {
+			uint64_t word = fetch(lsb + c * int(bitsInLimb));
+			size_t chunkbits = sbits - size_t(c) * bitsInLimb;
+			if (chunkbits < bitsInLimb) word &= (uint64_t(1) << chunkbits) - 1;
+			segment <<= (bitsInLimb - 1);  // split the shift: shifting by the full width is not defined for narrow segments
+			segment <<= 1;
+			bitblock<sbits> chunk;
+			chunk = word;
+			segment |= chunk;
+		}
+		return segment;
+	}
+
+	// transform the fraction of a value, including the hidden bit, into little-endian limbs
+	template<size_t fbits>
+	static void fixed_point_limbs(const value<fbits>& v, uint64_t* limbs) {
+		constexpr size_t nrFractionLimbs = (fbits + 1 + bitsInLimb - 1) / bitsInLimb;
+		bitblock<fbits> fraction = v.fraction();
+		if (fbits < bitsInLimb) {
+			limbs[0] = fraction.to_ullong();
+		}
+		else {
+			bitblock<fbits> mask;
+			mask = ~0ull;
+			for (size_t i = 0; i < nrFractionLimbs; ++i) {
+				bitblock<fbits> limb(fraction);
+				limb &= mask;
+				limbs[i] = limb.to_ullong();
+				fraction >>= (bitsInLimb - 1);
+				fraction >>= 1;
+			}
+		}
+		limbs[fbits / bitsInLimb] |= uint64_t(1) << (fbits % bitsInLimb); // make hidden bit explicit
+	}
+	// return the limb of a fraction that aligns with quire limb i, when the fraction lsb sits at quire position lsb
+	static uint64_t aligned_limb(const uint64_t* fraction, size_t nrFractionLimbs, int lsb, size_t i) {
+		int src = int(i * bitsInLimb) - lsb;  // fraction bit that maps onto bit 0 of quire limb i
+		if (src <= -int(bitsInLimb)) return 0;
+		if (src < 0) return fraction[0] << (-src);
+		size_t limb = size_t(src) / bitsInLimb;
+		size_t shift = size_t(src) % bitsInLimb;
+		if (limb >= nrFractionLimbs) return 0;
+		uint64_t word = fraction[limb] >> shift;
+		if (shift && limb + 1 < nrFractionLimbs) word |= fraction[limb + 1] << (bitsInLimb - shift);
+		return word;
+	}
+	// range of quire limbs covered by a fraction of nrFractionLimbs with its lsb at quire position lsb
+	static void covered_limbs(size_t nrFractionLimbs, int lsb, size_t& first, size_t& last) {
+		int msb = lsb + int(nrFractionLimbs * bitsInLimb) - 1;
+		first = lsb > 0 ? size_t(lsb) / bitsInLimb : 0;
+		last = msb > 0 ? size_t(msb) / bitsInLimb : 0;
+		if (last >= nrLimbs) last = nrLimbs - 1;
+	}
+	// add an aligned fraction to the accumulator: bits below the quire lsb are truncated, carries out of the capacity segment are dropped
+	void add_aligned(const uint64_t* fraction, size_t nrFractionLimbs, int lsb) {
+		if (lsb + int(nrFractionLimbs * bitsInLimb) <= 0) return;
+		size_t first, last;
+		covered_limbs(nrFractionLimbs, lsb, first, last);
+		uint64_t carry = 0;
+		size_t i;
+		for (i = first; i <= last; ++i) {
+			uint64_t addend = aligned_limb(fraction, nrFractionLimbs, lsb, i);
+			uint64_t sum = _limb[i] + addend;
+			uint64_t c = (sum < addend);
+			sum += carry;
+			carry = c | (sum < carry);
+			_limb[i] = sum;
+		}
+		// propagate the carry until it dies out
+		for (; carry && i < nrLimbs; ++i) {
+			carry = (++_limb[i] == 0);
+		}
+		_limb[nrLimbs - 1] &= MSL_MASK;
+	}
+	// subtract an aligned fraction from the accumulator: the accumulator magnitude must be bigger or equal
+	void subtract_aligned(const uint64_t* fraction, size_t nrFractionLimbs, int lsb) {
+		if (lsb + int(nrFractionLimbs * bitsInLimb) <= 0) return;
+		size_t first, last;
+		covered_limbs(nrFractionLimbs, lsb, first, last);
+		uint64_t borrow = 0;
+		size_t i;
+		for (i = first; i <= last; ++i) {
+			uint64_t subtrahend = aligned_limb(fraction, nrFractionLimbs, lsb, i);
+			uint64_t diff = _limb[i] - subtrahend;
+			uint64_t b = (_limb[i] < subtrahend);
+			b |= (diff < borrow);
+			_limb[i] = diff - borrow;
+			borrow = b;
+		}
+		// propagate the borrow until it dies out
+		for (; borrow && i < nrLimbs; ++i) {
+			borrow = (_limb[i]-- == 0);
+		}
+		_limb[nrLimbs - 1] &= MSL_MASK;
+	}
+	// replace the accumulator with (aligned fraction - accumulator): the fraction magnitude must be bigger
+	void reverse_subtract_aligned(const uint64_t* fraction, size_t nrFractionLimbs, int lsb) {
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < nrLimbs; ++i) {
+			uint64_t minuend = aligned_limb(fraction, nrFractionLimbs, lsb, i);
+			uint64_t diff = minuend - _limb[i];
+			uint64_t b = (minuend < _limb[i]);
+			b |= (diff < borrow);
+			_limb[i] = diff - borrow;
+			borrow = b;
+		}
+		_limb[nrLimbs - 1] &= MSL_MASK;
+	}
+	// add a signed accumulator of another quire: its limbs are a fraction with the lsb at quire position 0
+	quire& accumulate(const uint64_t* limbs, bool sign) {
+		bool bZero = true;
+		for (size_t i = 0; i < nrLimbs; ++i) if (limbs[i]) { bZero = false; break; }
+		if (bZero) return *this;
+		if (_sign == sign) {
+			add_aligned(limbs, nrLimbs, 0);
 		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(i)) scale = qbit - int(half_range);
+		else {
+			int cmp = compare_aligned(limbs, nrLimbs, 0);
+			if (cmp < 0) {
+				reverse_subtract_aligned(limbs, nrLimbs, 0);
+				_sign = sign;
 			}
 			else {
-				fraction[fbit--] = _lower[i];
+				subtract_aligned(limbs, nrLimbs, 0);
+				if (cmp == 0) _sign = false;
 			}
 		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
-		}
-		return value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		return *this;
 	}
-	bool anyAfter(int index) const {
-		for (int i = index; i >= 0; i--) {
-			if (this->operator[](i)) return true;
+	// compare the magnitude of the accumulator to an aligned fraction: -1 if q < f, 0 if q == f, and 1 if q > f
+	int compare_aligned(const uint64_t* fraction, size_t nrFractionLimbs, int lsb) const {
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			uint64_t f = aligned_limb(fraction, nrFractionLimbs, lsb, size_t(i));
+			if (_limb[i] < f) return -1;
+			if (_limb[i] > f) return 1;
 		}
-		return false;
+		return 0;
 	}
 
-private:
-	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	bitblock<half_range>   _lower;
-	bitblock<upper_range>  _upper;
-	bitblock<capacity>     _capacity;
-
 	// add a value to the quire
 	template<size_t fbits>
 	void add_value(const value<fbits>& v) {
@@ -528,224 +604,19 @@ private:
 		// scale is the location of the msb in the fixed point representation
 		// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
 		// and scale = -1 is the first bit of the fraction
-		// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-		int lsb = v.scale() - static_cast<int>(fbits);
-		bool carry = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			int lsb = int(half_range) + v.scale() - int(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[size_t(i)];
-				bool _b = fraction[size_t(f)];
-				_lower[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// propagate any carries to the end of the lower accumulator
-			while (carry && i < int(half_range)) {
-				bool _a = _lower[size_t(i)];
-				_lower[size_t(i)] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			if (carry) {  // carry propagate to the _upper accumulator
-						  // need to increment the _upper
-				i = 0;
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[size_t(i)];
-					_upper[size_t(i)] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[size_t(i)];
-						_capacity[size_t(i)] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-				}
-			}
-		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[size_t(i)];
-				bool _b = fraction[size_t(f)];
-				_upper[size_t(i)] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[size_t(i)];
-				_upper[size_t(i)] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			if (carry) {
-				// next add the bits to the capacity segment
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[size_t(i)];
-					_capacity[size_t(i)] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-			}
-		}
-		else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[size_t(i)];
-				bool _b = fraction[size_t(f)];
-				_lower[size_t(i)] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[size_t(i)];
-				bool _b = fraction[size_t(f)];
-				_upper[size_t(i)] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// propagate any carries to the end of the upper accumulator
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[size_t(i)];
-				_upper[size_t(i)] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			// next add the bits to the capacity segment
-			if (carry) {
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[size_t(i)];
-					_capacity[size_t(i)] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-			}
-		}
+		constexpr size_t nrFractionLimbs = (fbits + 1 + bitsInLimb - 1) / bitsInLimb;
+		uint64_t fraction[nrFractionLimbs];
+		fixed_point_limbs(v, fraction);
+		add_aligned(fraction, nrFractionLimbs, int(radix_point) + v.scale() - int(fbits));
 	}
 	// subtract a value from the quire
 	template<size_t fbits>
 	void subtract_value(const value<fbits>& v) {
 		if (v.iszero()) return;
-		// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-		int lsb = v.scale() - static_cast<int>(fbits);
-		bool borrow = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			int lsb = int(half_range) + v.scale() - static_cast<int>(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[size_t(i)];
-				bool _b = fraction[size_t(f)];
-				_lower[size_t(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the lower accumulator
-			while (borrow && i < int(half_range)) {
-				bool _a = _lower[size_t(i)];
-				_lower[size_t(i)] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) { // borrow propagate to the _upper accumulator
-						  // need to decrement the _upper
-				i = 0;
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[size_t(i)];
-					_upper[size_t(i)] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[size_t(i)];
-						_capacity[size_t(i)] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-				}
-			}
-		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[size_t(i)];
-				bool _b = fraction[size_t(f)];
-				_upper[size_t(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[size_t(i)];
-				_upper[size_t(i)] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[size_t(i)];
-					_capacity[size_t(i)] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-			}
-		}
-		else {   // lsb < 0 && scale >= 0
-				 // part upper, and part lower accumulator
-				 // first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[size_t(i)];
-				bool _b = fraction[size_t(f)];
-				_lower[size_t(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[size_t(i)];
-				bool _b = fraction[size_t(f)];
-				_upper[size_t(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[size_t(i)];
-				_upper[size_t(i)] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[size_t(i)];
-					_capacity[size_t(i)] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-			}
-		}
+		constexpr size_t nrFractionLimbs = (fbits + 1 + bitsInLimb - 1) / bitsInLimb;
+		uint64_t fraction[nrFractionLimbs];
+		fixed_point_limbs(v, fraction);
+		subtract_aligned(fraction, nrFractionLimbs, int(radix_point) + v.scale() - int(fbits));
 	}
 
 	// template parameters need names different from class template parameters (for gcc and clang)
@@ -806,7 +677,7 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 ////////////////// QUIRE stream operators
 template<size_t nbits, size_t es, size_t capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nbits, es, capacity>& q) {
-	ostr << (q._sign ? "-:" : "+:") << q._capacity << "_" << q._upper << "." << q._lower;
+	ostr << (q._sign ? "-:" : "+:") << q.capacity_segment() << "_" << q.upper_segment() << "." << q.lower_segment();
 	return ostr;
 }
 
@@ -817,7 +688,13 @@ inline std::istream& operator>> (std::istream& istr, const quire<nbits, es, capa
 }
 
 template<size_t nbits, size_t es, size_t capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
+	if (lhs._sign != rhs._sign) return false;
+	for (size_t i = 0; i < quire<nbits, es, capacity>::nrLimbs; ++i) {
+		if (lhs._limb[i] != rhs._limb[i]) return false;
+	}
+	return true;
+}
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<size_t nbits, size_t es, size_t capacity>
@@ -827,14 +704,12 @@ inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits,
 		bSmaller = true;
 	}
 	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-			bSmaller = true;
+		// compare the accumulators limb by limb, starting at the capacity segment
+		for (int i = int(quire<nbits, es, capacity>::nrLimbs) - 1; i >= 0; --i) {
+			if (lhs._limb[i] != rhs._limb[i]) {
+				bSmaller = lhs._limb[i] < rhs._limb[i];
+				break;
+			}
 		}
 	}
 	return bSmaller;
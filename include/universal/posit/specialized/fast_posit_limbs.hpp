@@ -0,0 +1,291 @@
+#pragma once
+// fast_posit_limbs.hpp: multi-limb kernels for the fast specializations of posit<128,4> and posit<256,5>
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// DO NOT USE DIRECTLY!
+// this file is included by the fast specializations of the wide standard posits
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <universal/native/limb_arithmetic.hpp>
+
+namespace sw { namespace unum {
+
+namespace internal {
+
+// The wide posit kernels generalize the fast posit<64,3> kernels to encodings of nbits / 64 limbs,
+// least significant limb first. A positive encoding decodes into a scale and a significand of
+// nbits / 64 limbs with the hidden bit at the msb. Intermediate results carry enough guard bits
+// that a single rounding step in fast_posit_limbs_encode delivers the correctly rounded posit.
+
+// decode a positive, nonzero posit encoding into its scale and significand
+template<size_t nbits, size_t es>
+inline void fast_posit_limbs_decode(const uint64_t* bits, int& scale, uint64_t* significand) {
+	constexpr size_t N = nbits / 64;
+	uint64_t x[N];
+	limb_shift_left(x, bits, N, 1);   // drop the sign bit: the regime starts at the msb
+	size_t m;
+	int k;
+	if (x[N - 1] >> 63) {
+		uint64_t y[N];
+		for (size_t i = 0; i < N; ++i) y[i] = ~x[i];
+		m = limb_leading_zeros(y, N);
+		k = int(m) - 1;
+	}
+	else {
+		m = limb_leading_zeros(x, N);
+		k = -int(m);
+	}
+	// skip the regime run and its terminating bit, what remains are the exponent and fraction bits
+	limb_shift_left(x, x, N, m + 1);
+	scale = k * (1 << es) + int(x[N - 1] >> (64 - es));
+	limb_shift_left(significand, x, N, es);
+	limb_shift_right(significand, significand, N, 1);
+	significand[N - 1] |= 0x8000000000000000ull;
+}
+
+// round the value (-1)^sign * significand * 2^(scale - (nbits - 1)) to the nearest posit encoding
+// sticky signals nonzero bits below the significand
+template<size_t nbits, size_t es>
+inline void fast_posit_limbs_encode(bool sign, int scale, const uint64_t* significand, bool sticky, uint64_t* bits) {
+	constexpr size_t N = nbits / 64;
+	constexpr int maxscale = int(nbits - 2) * (1 << es);
+	if (scale >= maxscale) {           // maxpos
+		for (size_t i = 0; i < N; ++i) bits[i] = ~0ull;
+		bits[N - 1] = 0x7FFFFFFFFFFFFFFFull;
+	}
+	else if (scale < -maxscale) {      // minpos
+		for (size_t i = 0; i < N; ++i) bits[i] = 0;
+		bits[0] = 1;
+	}
+	else {
+		int k = (scale >= 0) ? (scale >> es) : -((-scale + (1 << es) - 1) >> es);
+		uint64_t e = uint64_t(scale - k * (1 << es));
+		// regime run and terminating bit, left aligned in a field of N + 1 limbs that starts after the sign bit
+		size_t len = size_t((k >= 0) ? k + 2 : -k + 1);
+		uint64_t field[N + 1] = { 0 };
+		if (k >= 0) {
+			for (size_t i = 0; i < size_t(k) + 1; ++i) field[N - i / 64] |= 0x8000000000000000ull >> (i % 64);
+		}
+		else {
+			field[N - (len - 1) / 64] |= 0x8000000000000000ull >> ((len - 1) % 64);
+		}
+		// exponent and fraction bits follow the regime
+		uint64_t tail[N + 1];
+		tail[0] = 0;
+		limb_shift_left(tail + 1, significand, N, 1);
+		limb_shift_right(tail, tail, N + 1, es);
+		tail[N] |= e << (64 - es);
+		sticky |= limb_shift_right(tail, tail, N + 1, len);
+		for (size_t i = 0; i <= N; ++i) field[i] |= tail[i];
+		// the top nbits - 1 bits are the posit, followed by the guard bit and the sticky bits
+		bool guard = (field[1] & 0x1) != 0;
+		sticky |= field[0] != 0;
+		limb_shift_right(field, field, N + 1, 65);
+		for (size_t i = 0; i < N; ++i) bits[i] = field[i];
+		if (guard && (sticky || (bits[0] & 0x1))) limb_add_carry(bits, N, 1);
+	}
+	if (sign) limb_negate(bits, bits, N);
+}
+
+// sum of two nonzero, non-NaR posit encodings
+template<size_t nbits, size_t es>
+inline void fast_posit_limbs_add(const uint64_t* lhs, const uint64_t* rhs, uint64_t* sum) {
+	constexpr size_t N = nbits / 64;
+	bool lsign = (lhs[N - 1] >> 63) != 0;
+	bool rsign = (rhs[N - 1] >> 63) != 0;
+	uint64_t la[N], ra[N];
+	if (lsign) limb_negate(la, lhs, N); else for (size_t i = 0; i < N; ++i) la[i] = lhs[i];
+	if (rsign) limb_negate(ra, rhs, N); else for (size_t i = 0; i < N; ++i) ra[i] = rhs[i];
+	const uint64_t* large = la;
+	const uint64_t* small = ra;
+	if (limb_compare(la, ra, N) < 0) {
+		std::swap(large, small);
+		std::swap(lsign, rsign);
+	}
+	int lscale, rscale;
+	uint64_t a[2 * N] = { 0 }, b[2 * N] = { 0 };
+	fast_posit_limbs_decode<nbits, es>(large, lscale, a + N);
+	fast_posit_limbs_decode<nbits, es>(small, rscale, b + N);
+
+	// hidden bit of the larger operand one below the msb, leaving room for the carry
+	limb_shift_right(a, a, 2 * N, 1);
+	limb_shift_right(b, b, 2 * N, 1);
+	int shift = lscale - rscale;
+	if (shift > 0) {
+		// jam the bits that are shifted out into the lsb
+		if (limb_shift_right(b, b, 2 * N, size_t(shift))) b[0] |= 1;
+	}
+	uint64_t s[2 * N];
+	if (lsign == rsign) {
+		limb_add(s, a, b, 2 * N);
+	}
+	else {
+		limb_sub(s, a, b, 2 * N);
+		if (limb_is_zero(s, 2 * N)) {
+			for (size_t i = 0; i < N; ++i) sum[i] = 0;
+			return;
+		}
+	}
+	// normalize the hidden bit to the msb
+	size_t lz = limb_leading_zeros(s, 2 * N);
+	limb_shift_left(s, s, 2 * N, lz);
+	fast_posit_limbs_encode<nbits, es>(lsign, lscale + 1 - int(lz), s + N, !limb_is_zero(s, N), sum);
+}
+
+// product of two nonzero, non-NaR posit encodings
+template<size_t nbits, size_t es>
+inline void fast_posit_limbs_mul(const uint64_t* lhs, const uint64_t* rhs, uint64_t* product) {
+	constexpr size_t N = nbits / 64;
+	bool sign = ((lhs[N - 1] ^ rhs[N - 1]) >> 63) != 0;
+	uint64_t la[N], ra[N], lsig[N], rsig[N];
+	if (lhs[N - 1] >> 63) limb_negate(la, lhs, N); else for (size_t i = 0; i < N; ++i) la[i] = lhs[i];
+	if (rhs[N - 1] >> 63) limb_negate(ra, rhs, N); else for (size_t i = 0; i < N; ++i) ra[i] = rhs[i];
+	int lscale, rscale;
+	fast_posit_limbs_decode<nbits, es>(la, lscale, lsig);
+	fast_posit_limbs_decode<nbits, es>(ra, rscale, rsig);
+	uint64_t p[2 * N];
+	limb_multiply(p, lsig, N, rsig, N);   // in [2^(2 nbits - 2), 2^(2 nbits))
+	int scale = lscale + rscale;
+	if (p[2 * N - 1] >> 63) ++scale; else limb_shift_left(p, p, 2 * N, 1);
+	fast_posit_limbs_encode<nbits, es>(sign, scale, p + N, !limb_is_zero(p, N), product);
+}
+
+// ratio of two nonzero, non-NaR posit encodings
+template<size_t nbits, size_t es>
+inline void fast_posit_limbs_div(const uint64_t* lhs, const uint64_t* rhs, uint64_t* ratio) {
+	constexpr size_t N = nbits / 64;
+	bool sign = ((lhs[N - 1] ^ rhs[N - 1]) >> 63) != 0;
+	uint64_t la[N], ra[N], lsig[N], rsig[N];
+	if (lhs[N - 1] >> 63) limb_negate(la, lhs, N); else for (size_t i = 0; i < N; ++i) la[i] = lhs[i];
+	if (rhs[N - 1] >> 63) limb_negate(ra, rhs, N); else for (size_t i = 0; i < N; ++i) ra[i] = rhs[i];
+	int lscale, rscale;
+	fast_posit_limbs_decode<nbits, es>(la, lscale, lsig);
+	fast_posit_limbs_decode<nbits, es>(ra, rscale, rsig);
+	// the long division works on 32-bit digits: (lsig << nbits) / rsig
+	uint32_t u[4 * N] = { 0 }, v[2 * N], qd[4 * N], rd[2 * N];
+	for (size_t i = 0; i < N; ++i) {
+		u[2 * N + 2 * i] = uint32_t(lsig[i]);
+		u[2 * N + 2 * i + 1] = uint32_t(lsig[i] >> 32);
+		v[2 * i] = uint32_t(rsig[i]);
+		v[2 * i + 1] = uint32_t(rsig[i] >> 32);
+	}
+	limb_divide(qd, rd, u, 4 * N, v, 2 * N);
+	uint64_t q[N + 1];   // in (2^(nbits - 1), 2^(nbits + 1))
+	for (size_t i = 0; i <= N; ++i) q[i] = uint64_t(qd[2 * i]) | (uint64_t(qd[2 * i + 1]) << 32);
+	bool sticky = false;
+	for (size_t i = 0; i < 2 * N; ++i) sticky |= (rd[i] != 0);
+	int scale = lscale - rscale;
+	if (q[N]) {
+		sticky |= (q[0] & 0x1) != 0;
+		limb_shift_right(q, q, N + 1, 1);
+	}
+	else {
+		--scale;
+	}
+	fast_posit_limbs_encode<nbits, es>(sign, scale, q, sticky, ratio);
+}
+
+// square root of a positive, nonzero posit encoding
+template<size_t nbits, size_t es>
+inline void fast_posit_limbs_sqrt(const uint64_t* bits, uint64_t* root) {
+	constexpr size_t N = nbits / 64;
+	int scale;
+	uint64_t x[2 * N] = { 0 };
+	fast_posit_limbs_decode<nbits, es>(bits, scale, x + N);
+	int odd = scale & 0x1;
+	if (!odd) limb_shift_right(x, x, 2 * N, 1);   // x in [2^(2 nbits - 2), 2^(2 nbits))
+
+	// the extended precision estimate of the top two limbs overestimates the integer square root,
+	// and the Newton iteration r = (r + x / r) / 2 then decreases monotonically onto it
+	uint64_t r[N + 1] = { 0 };
+	long double top = std::ldexp((long double)(x[2 * N - 1]), 64) + (long double)(x[2 * N - 2]);
+	long double estimate = std::sqrt(top) + 3.0l;
+	if (estimate >= 18446744073709551615.0l) {
+		for (size_t i = 0; i < N; ++i) r[i] = ~0ull;
+	}
+	else {
+		r[N - 1] = uint64_t(estimate);
+	}
+	uint32_t u[4 * N], v[2 * N], qd[4 * N], rd[2 * N];
+	for (size_t i = 0; i < 2 * N; ++i) {
+		u[2 * i] = uint32_t(x[i]);
+		u[2 * i + 1] = uint32_t(x[i] >> 32);
+	}
+	for (;;) {
+		for (size_t i = 0; i < N; ++i) {
+			v[2 * i] = uint32_t(r[i]);
+			v[2 * i + 1] = uint32_t(r[i] >> 32);
+		}
+		limb_divide(qd, rd, u, 4 * N, v, 2 * N);
+		uint64_t next[N + 1];
+		for (size_t i = 0; i <= N; ++i) next[i] = uint64_t(qd[2 * i]) | (uint64_t(qd[2 * i + 1]) << 32);
+		limb_add(next, next, r, N + 1);
+		limb_shift_right(next, next, N + 1, 1);
+		if (limb_compare(next, r, N + 1) >= 0) break;
+		for (size_t i = 0; i <= N; ++i) r[i] = next[i];
+	}
+	uint64_t square[2 * N];
+	limb_multiply(square, r, N, r, N);
+	bool sticky = limb_compare(square, x, 2 * N) != 0;
+	fast_posit_limbs_encode<nbits, es>(false, (scale - odd) / 2, r, sticky, root);
+}
+
+// round the significand to a native floating-point type with fewer than 64 significand bits
+template<size_t nbits, typename Real>
+inline Real fast_posit_limbs_to_native(bool sign, int scale, const uint64_t* significand) {
+	constexpr size_t N = nbits / 64;
+	static_assert(std::numeric_limits<Real>::digits < 63, "jamming the sticky bit requires two guard bits");
+	// the top limb with the lower limbs jammed into its lsb rounds correctly in the conversion to Real
+	uint64_t top = significand[N - 1];
+	if (!limb_is_zero(significand, N - 1)) top |= 1;
+	Real v = std::ldexp(Real(top), scale - 63);
+	return sign ? -v : v;
+}
+
+// round the significand to long double
+template<size_t nbits>
+inline long double fast_posit_limbs_to_long_double(bool sign, int scale, const uint64_t* significand) {
+	constexpr size_t N = nbits / 64;
+	if constexpr (std::numeric_limits<long double>::digits < 63) return fast_posit_limbs_to_native<nbits, long double>(sign, scale, significand);
+	// a 64-bit long double significand: round the top limb to nearest even
+	uint64_t top = significand[N - 1];
+	bool guard = (significand[N - 2] >> 63) != 0;
+	bool sticky = (significand[N - 2] << 1) != 0 || !limb_is_zero(significand, N - 2);
+	long double v;
+	if (guard && (sticky || (top & 0x1))) {
+		v = (top == ~0ull) ? std::ldexp(1.0l, scale + 1) : std::ldexp((long double)(top + 1), scale - 63);
+	}
+	else {
+		v = std::ldexp((long double)(top), scale - 63);
+	}
+	return sign ? -v : v;
+}
+
+// copy the limbs a[0..(size + 63) / 64) into a bitblock
+template<size_t size>
+inline void fast_posit_limbs_to_bitblock(const uint64_t* a, bitblock<size>& raw) {
+#if BITBLOCK_WORD_ARRAY
+	for (size_t i = 0; i < (size + 63) / 64; ++i) raw.setword(i, a[i]);
+#else
+	for (size_t i = 0; i < size; ++i) raw[i] = ((a[i / 64] >> (i % 64)) & 0x1) != 0;
+#endif
+}
+
+// copy a bitblock into the limbs a[0..(size + 63) / 64)
+template<size_t size>
+inline void fast_posit_limbs_from_bitblock(const bitblock<size>& raw, uint64_t* a) {
+#if BITBLOCK_WORD_ARRAY
+	for (size_t i = 0; i < (size + 63) / 64; ++i) a[i] = raw.word(i);
+#else
+	for (size_t i = 0; i < (size + 63) / 64; ++i) a[i] = 0;
+	for (size_t i = 0; i < size; ++i) if (raw[i]) a[i / 64] |= (1ull << (i % 64));
+#endif
+}
+
+} // namespace internal
+
+}} // namespace sw::unum
@@ -34,37 +34,15 @@ namespace sw { namespace unum {
 			0.0f, 1.0f, -INFINITY, -1.0f,
 		};
 
-		constexpr uint8_t posit_2_0_addition_lookup[16] = {
-			0,1,2,3,  // 0   + {0,1,NaR,-1}
-			1,1,2,0,  // 1   + {0,1,NaR,-1}
-			2,2,2,2,  // NaR + {0,1,NaR,-1}
-			3,0,2,3,  // -1  + {0,1,NaR,-1}
-		};
+		constexpr auto& posit_2_0_addition_lookup = posit_binary_lookup<2, 0, internal::lookup_operator::add>;
 
-		constexpr uint8_t posit_2_0_subtraction_lookup[16] = {
-			0,3,2,1,  // 0   - {0,1,NaR,-1}
-			1,0,2,1,  // 1   - {0,1,NaR,-1}
-			2,2,2,2,  // NaR - {0,1,NaR,-1}
-			3,3,2,0,  // -1  - {0,1,NaR,-1}
-		};
+		constexpr auto& posit_2_0_subtraction_lookup = posit_binary_lookup<2, 0, internal::lookup_operator::sub>;
 
-		constexpr uint8_t posit_2_0_multiplication_lookup[16] = {
-			0,0,2,0,  // 0   * {0,1,NaR,-1}
-			0,1,2,3,  // 1   * {0,1,NaR,-1}
-			2,2,2,2,  // NaR * {0,1,NaR,-1}
-			0,3,2,1,  // -1  * {0,1,NaR,-1}
-		};
+		constexpr auto& posit_2_0_multiplication_lookup = posit_binary_lookup<2, 0, internal::lookup_operator::mul>;
 
-		constexpr uint8_t posit_2_0_division_lookup[16] = {
-			2,0,2,0,  // 0   / {0,1,NaR,-1}
-			2,1,2,3,  // 1   / {0,1,NaR,-1}
-			2,2,2,2,  // NaR / {0,1,NaR,-1}
-			2,3,2,1,  // -1  / {0,1,NaR,-1}
-		};
+		constexpr auto& posit_2_0_division_lookup = posit_binary_lookup<2, 0, internal::lookup_operator::div>;
 
-		constexpr uint8_t posit_2_0_reciprocal_lookup[4] = {
-			2,1,2,3,
-		};
+		constexpr auto& posit_2_0_reciprocal_lookup = posit_unary_lookup<2, 0, internal::lookup_operator::reciprocal>;
 
 			template<>
 			class posit<NBITS_IS_2, ES_IS_0> {
@@ -36,50 +36,12 @@ namespace sw {	namespace unum {
 			0.0f, 0.5f, 1.0f, 2.0f, -INFINITY, -2.0f, -1.0f, -0.5f,
 		};
 
-		constexpr uint8_t posit_3_0_addition_lookup[64] = {
-			0,1,2,3,4,5,6,7,
-			1,2,2,3,4,6,7,0,
-			2,2,3,3,4,6,0,1,
-			3,3,3,3,4,0,2,2,
-			4,4,4,4,4,4,4,4,
-			5,6,6,0,4,5,5,5,
-			6,7,0,2,4,5,5,6,
-			7,0,1,2,4,5,6,6,
-		};
-		constexpr uint8_t posit_3_0_subtraction_lookup[64] = {
-			0,7,6,5,4,3,2,1,
-			1,0,7,6,4,3,2,2,
-			2,1,0,6,4,3,3,2,
-			3,2,2,0,4,3,3,3,
-			4,4,4,4,4,4,4,4,
-			5,5,5,5,4,0,6,6,
-			6,6,5,5,4,2,0,7,
-			7,6,6,5,4,2,1,0,
-		};
-		constexpr uint8_t posit_3_0_multiplication_lookup[64] = {
-			0,0,0,0,4,0,0,0,
-			0,1,1,2,4,6,7,7,
-			0,1,2,3,4,5,6,7,
-			0,2,3,3,4,5,5,6,
-			4,4,4,4,4,4,4,4,
-			0,6,5,5,4,3,3,2,
-			0,7,6,5,4,3,2,1,
-			0,7,7,6,4,2,1,1,
-		};
-		constexpr uint8_t posit_3_0_division_lookup[64] = {
-			4,0,0,0,4,0,0,0,
-			4,2,1,1,4,7,7,6,
-			4,3,2,1,4,7,6,5,
-			4,3,3,2,4,6,5,5,
-			4,4,4,4,4,4,4,4,
-			4,5,5,6,4,2,3,3,
-			4,5,6,7,4,1,2,3,
-			4,6,7,7,4,1,1,2,
-		};
+		constexpr auto& posit_3_0_addition_lookup = posit_binary_lookup<3, 0, internal::lookup_operator::add>;
+		constexpr auto& posit_3_0_subtraction_lookup = posit_binary_lookup<3, 0, internal::lookup_operator::sub>;
+		constexpr auto& posit_3_0_multiplication_lookup = posit_binary_lookup<3, 0, internal::lookup_operator::mul>;
+		constexpr auto& posit_3_0_division_lookup = posit_binary_lookup<3, 0, internal::lookup_operator::div>;
 
-		constexpr uint8_t posit_3_0_reciprocal_lookup[8] = {
-			4,3,2,1,4,7,6,5,  
-		};
+		constexpr auto& posit_3_0_reciprocal_lookup = posit_unary_lookup<3, 0, internal::lookup_operator::reciprocal>;
 
 		constexpr bool posit_3_0_less_than_lookup[64] = {
 			0,1,1,1,0,0,0,0,
@@ -23,42 +23,20 @@ namespace sw { namespace unum {
 	#warning("Fast specialization of posit<3,1>")
 #endif
 
-			constexpr uint8_t posit_3_1_addition_lookup[64] = {
-				0,1,0,3,1,1,0,3,2,0,2,3,3,3,3,3,
-				0,1,0,3,1,1,0,3,2,0,2,3,3,3,3,3,
-				0,1,0,3,1,1,0,3,2,0,2,3,3,3,3,3,
-				0,1,0,3,1,1,0,3,2,0,2,3,3,3,3,3,
-			};
+			constexpr auto& posit_3_1_addition_lookup = posit_binary_lookup<3, 1, internal::lookup_operator::add>;
 
-			constexpr uint8_t posit_3_1_subtraction_lookup[64] = {
-				0,2,1,3,1,0,1,3,2,2,0,3,3,3,3,3,
-				0,2,1,3,1,0,1,3,2,2,0,3,3,3,3,3,
-				0,2,1,3,1,0,1,3,2,2,0,3,3,3,3,3,
-				0,2,1,3,1,0,1,3,2,2,0,3,3,3,3,3,
-			};
+			constexpr auto& posit_3_1_subtraction_lookup = posit_binary_lookup<3, 1, internal::lookup_operator::sub>;
 
-			constexpr uint8_t posit_3_1_multiplication_lookup[64] = {
-				0,0,0,3,1,1,2,3,0,2,1,3,3,3,3,3,
-				0,0,0,3,1,1,2,3,0,2,1,3,3,3,3,3,
-				0,0,0,3,1,1,2,3,0,2,1,3,3,3,3,3,
-				0,0,0,3,1,1,2,3,0,2,1,3,3,3,3,3,
-			};
+			constexpr auto& posit_3_1_multiplication_lookup = posit_binary_lookup<3, 1, internal::lookup_operator::mul>;
 
-			constexpr uint8_t posit_3_1_division_lookup[64] = {
-				3,0,0,3,3,1,2,3,3,2,1,3,3,3,3,3,
-				3,0,0,3,3,1,2,3,3,2,1,3,3,3,3,3,
-				3,0,0,3,3,1,2,3,3,2,1,3,3,3,3,3,
-				3,0,0,3,3,1,2,3,3,2,1,3,3,3,3,3,
-			};
+			constexpr auto& posit_3_1_division_lookup = posit_binary_lookup<3, 1, internal::lookup_operator::div>;
 
-			constexpr uint8_t posit_3_1_reciprocal_lookup[8] = {
-				3,1,2,3,3,1,2,3,
-			};
+			constexpr auto& posit_3_1_reciprocal_lookup = posit_unary_lookup<3, 1, internal::lookup_operator::reciprocal>;
 
 			template<>
 			class posit<NBITS_IS_3, ES_IS_1> {
 			public:
-				static constexpr size_t nbits = NBITS_IS_2;
+				static constexpr size_t nbits = NBITS_IS_3;
 				static constexpr size_t es = ES_IS_1;
 				static constexpr size_t sbits = 1;
 				static constexpr size_t rbits = nbits - sbits;
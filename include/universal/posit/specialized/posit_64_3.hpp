@@ -13,6 +13,14 @@
 #define POSIT_FAST_POSIT_64_3 0
 #endif
 
+#if POSIT_FAST_POSIT_64_3
+#if !defined(__SIZEOF_INT128__)
+#error "fast posit<64,3> requires a compiler with a 128-bit unsigned integer type"
+#endif
+#include <cmath>
+#include <universal/native/limb_arithmetic.hpp>
+#endif
+
 namespace sw { namespace unum {
 
 	// set the fast specialization variable to indicate that we are running a special template specialization
@@ -23,6 +31,153 @@ namespace sw { namespace unum {
 	#warning("Fast specialization of posit<64,3>")
 #endif
 
+namespace internal {
+
+// The fast posit<64,3> kernels work on the magnitude of the encoding: sign, scale, and a 64-bit significand
+// with the hidden bit at bit 63. Intermediate results carry enough guard bits in 128-bit integers that
+// a single rounding step in fast_posit64_encode delivers the correctly rounded posit.
+
+// decode a positive, nonzero posit<64,3> encoding into its scale and significand
+inline void fast_posit64_decode(uint64_t bits, int& scale, uint64_t& significand) {
+	uint64_t x = bits << 1;   // drop the sign bit: the regime starts at bit 63
+	int m, k;
+	if (x & 0x8000000000000000ull) {
+		m = limb_clz(~x);
+		k = m - 1;
+	}
+	else {
+		m = limb_clz(x);
+		k = -m;
+	}
+	// skip the regime run and its terminating bit, what remains are the exponent and fraction bits
+	uint64_t remaining = (m < 63) ? (x << (m + 1)) : 0;
+	scale = k * 8 + int(remaining >> 61);
+	significand = 0x8000000000000000ull | ((remaining << 3) >> 1);
+}
+
+// round the value (-1)^sign * significand * 2^(scale - 63) to the nearest posit<64,3> encoding
+// sticky signals nonzero bits below the significand
+inline uint64_t fast_posit64_encode(bool sign, int scale, uint64_t significand, bool sticky) {
+	uint64_t bits;
+	if (scale >= 496) {           // maxpos
+		bits = 0x7FFFFFFFFFFFFFFFull;
+	}
+	else if (scale < -496) {      // minpos
+		bits = 0x1ull;
+	}
+	else {
+		int k = (scale >= 0) ? (scale >> 3) : -((-scale + 7) >> 3);
+		uint64_t e = uint64_t(scale - k * 8);
+		// regime run and terminating bit, left aligned in a 128-bit field that starts after the sign bit
+		int len = (k >= 0) ? k + 2 : -k + 1;
+		uint64_t regime = (k >= 0) ? (((1ull << (k + 1)) - 1) << 1) : 1ull;
+		uint128_t_ field = uint128_t_(regime) << (128 - len);
+		uint128_t_ tail = (uint128_t_(e) << 125) | (uint128_t_(significand & 0x7FFFFFFFFFFFFFFFull) << 62);
+		field |= tail >> len;
+		sticky |= (uint64_t(tail) << (64 - len)) != 0;
+		// the top 63 bits are the posit, followed by the guard bit and the sticky bits
+		bits = uint64_t(field >> 65);
+		bool guard = (uint64_t(field >> 64) & 0x1) != 0;
+		sticky |= uint64_t(field) != 0;
+		if (guard && (sticky || (bits & 0x1))) ++bits;
+	}
+	return sign ? (~bits + 1) : bits;
+}
+
+// sum of two nonzero, non-NaR posit<64,3> encodings
+inline uint64_t fast_posit64_add(uint64_t lhs, uint64_t rhs) {
+	bool lsign = (lhs >> 63) != 0;
+	bool rsign = (rhs >> 63) != 0;
+	uint64_t la = lsign ? (~lhs + 1) : lhs;
+	uint64_t ra = rsign ? (~rhs + 1) : rhs;
+	if (la < ra) {
+		std::swap(la, ra);
+		std::swap(lsign, rsign);
+	}
+	int lscale, rscale;
+	uint64_t lsig, rsig;
+	fast_posit64_decode(la, lscale, lsig);
+	fast_posit64_decode(ra, rscale, rsig);
+
+	// hidden bit of the larger operand at bit 126, leaving room for the carry
+	uint128_t_ a = uint128_t_(lsig) << 63;
+	uint128_t_ b = uint128_t_(rsig) << 63;
+	int shift = lscale - rscale;
+	if (shift > 0) {
+		// jam the bits that are shifted out into the lsb
+		bool lost = shift > 126 || (b << (128 - shift)) != 0;
+		b = (shift > 126) ? 0 : (b >> shift);
+		if (lost) b |= 1;
+	}
+	uint128_t_ s;
+	if (lsign == rsign) {
+		s = a + b;
+	}
+	else {
+		s = a - b;
+		if (s == 0) return 0;
+	}
+	// normalize the hidden bit to bit 127
+	uint64_t hi = uint64_t(s >> 64);
+	int lz = hi ? limb_clz(hi) : 64 + limb_clz(uint64_t(s));
+	s <<= lz;
+	return fast_posit64_encode(lsign, lscale + 1 - lz, uint64_t(s >> 64), uint64_t(s) != 0);
+}
+
+// product of two nonzero, non-NaR posit<64,3> encodings
+inline uint64_t fast_posit64_mul(uint64_t lhs, uint64_t rhs) {
+	bool sign = ((lhs ^ rhs) >> 63) != 0;
+	int lscale, rscale;
+	uint64_t lsig, rsig;
+	fast_posit64_decode((lhs >> 63) ? (~lhs + 1) : lhs, lscale, lsig);
+	fast_posit64_decode((rhs >> 63) ? (~rhs + 1) : rhs, rscale, rsig);
+	uint128_t_ p = uint128_t_(lsig) * rsig;   // in [2^126, 2^128)
+	int scale = lscale + rscale;
+	if (p >> 127) ++scale; else p <<= 1;
+	return fast_posit64_encode(sign, scale, uint64_t(p >> 64), uint64_t(p) != 0);
+}
+
+// ratio of two nonzero, non-NaR posit<64,3> encodings
+inline uint64_t fast_posit64_div(uint64_t lhs, uint64_t rhs) {
+	bool sign = ((lhs ^ rhs) >> 63) != 0;
+	int lscale, rscale;
+	uint64_t lsig, rsig;
+	fast_posit64_decode((lhs >> 63) ? (~lhs + 1) : lhs, lscale, lsig);
+	fast_posit64_decode((rhs >> 63) ? (~rhs + 1) : rhs, rscale, rsig);
+	uint128_t_ n = uint128_t_(lsig) << 64;
+	uint128_t_ q = n / rsig;   // in (2^63, 2^65)
+	bool sticky = (n - q * rsig) != 0;
+	int scale = lscale - rscale;
+	if (q >> 64) {
+		sticky |= (q & 0x1) != 0;
+		q >>= 1;
+	}
+	else {
+		--scale;
+	}
+	return fast_posit64_encode(sign, scale, uint64_t(q), sticky);
+}
+
+// square root of a positive, nonzero posit<64,3> encoding
+inline uint64_t fast_posit64_sqrt(uint64_t bits) {
+	int scale;
+	uint64_t sig;
+	fast_posit64_decode(bits, scale, sig);
+	int odd = scale & 0x1;
+	uint128_t_ x = uint128_t_(sig) << (63 + odd);   // in [2^126, 2^128)
+	// double precision estimate, one Newton step, and a final correction to the integer square root
+	double estimate = std::sqrt(double(x));
+	uint64_t r = (estimate >= 18446744073709551615.0) ? ~0ull : uint64_t(estimate);
+	uint128_t_ t = (uint128_t_(r) + x / r) >> 1;
+	r = (t >> 64) ? ~0ull : uint64_t(t);
+	while (uint128_t_(r) * r > x) --r;
+	while (r != ~0ull && uint128_t_(r + 1) * (r + 1) <= x) ++r;
+	bool sticky = uint128_t_(r) * r != x;
+	return fast_posit64_encode(false, (scale - odd) / 2, r, sticky);
+}
+
+} // namespace internal
+
 // fast specialized posit<64,3>
 template<>
 class posit<NBITS_IS_64, ES_IS_3> {
@@ -36,72 +191,41 @@ public:
 	static constexpr size_t fhbits = fbits + 1;
 	static constexpr uint64_t sign_mask = 0x8000000000000000ull;  // 0x8000'0000'0000'0000ull;
 
-	posit() { _bits = 0; }
+	constexpr posit() : _bits(0) {}
 	posit(const posit&) = default;
 	posit(posit&&) = default;
 	posit& operator=(const posit&) = default;
 	posit& operator=(posit&&) = default;
 
 	// initializers for native types
-	constexpr explicit posit(signed char initial_value)        { *this = initial_value; }
-	constexpr explicit posit(short initial_value)              { *this = initial_value; }
-	constexpr explicit posit(int initial_value)                { *this = initial_value; }
-	constexpr explicit posit(long initial_value)               { *this = initial_value; }
-	constexpr explicit posit(long long initial_value)          { *this = initial_value; }
-	constexpr explicit posit(char initial_value)               { *this = initial_value; }
-	constexpr explicit posit(unsigned short initial_value)     { *this = initial_value; }
-	constexpr explicit posit(unsigned int initial_value)       { *this = initial_value; }
-	constexpr explicit posit(unsigned long initial_value)      { *this = initial_value; }
-	constexpr explicit posit(unsigned long long initial_value) { *this = initial_value; }
-	constexpr explicit posit(float initial_value)              { *this = initial_value; }
-	constexpr explicit posit(double initial_value)             { *this = initial_value; }
-	constexpr          posit(long double initial_value)        { *this = initial_value; }
+	explicit posit(signed char initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(short initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(int initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(long initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(long long initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(char initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(unsigned short initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(unsigned int initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(unsigned long initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(unsigned long long initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(float initial_value) : _bits(0) { *this = initial_value; }
+	         posit(double initial_value) : _bits(0) { *this = initial_value; }
+	explicit posit(long double initial_value) : _bits(0) { *this = initial_value; }
 
 	// assignment operators for native types
-	posit& operator=(const signed char rhs)       { 
-		// special case for speed as this is a common initialization
-		if (rhs == 0) {
-			_bits = 0x00;
-			return *this;
-		}
-
-		bool sign = bool(rhs & 0x80);
-		int8_t v = sign ? -rhs : rhs; // project to positve side of the projective reals
-		uint8_t raw;
-		if (v > 48 || v == -128) { // +-maxpos, 0x80 is special in int8 arithmetic as it is its own negation
-			raw = 0x7F;
-		}
-		else {
-			uint8_t mask = 0x40;
-			int8_t k = 6;
-			uint8_t fraction_bits = v;
-			while (!(fraction_bits & mask)) {
-				k--;
-				fraction_bits <<= 1;
-			}
-			fraction_bits = (fraction_bits ^ mask);
-			raw = (0x7F ^ (0x3F >> k)) | (fraction_bits >> (k + 1));
-
-			mask = 0x1 << k; //bitNPlusOne
-			if (mask & fraction_bits) {
-				if (((mask - 1) & fraction_bits) | ((mask << 1) & fraction_bits)) raw++;
-			}
-		}
-		_bits = sign ? -raw : raw;
-		return *this;
-	}
-	posit& operator=(short rhs)             { return operator=((signed char)(rhs)); }
-	posit& operator=(int rhs)               { return operator=((signed char)(rhs)); }
-	posit& operator=(long rhs)              { return operator=((signed char)(rhs)); }
-	posit& operator=(long long rhs)         { return operator=((signed char)(rhs)); }
-	posit& operator=(char rhs)              { return operator=((signed char)(rhs)); }
-	posit& operator=(unsigned short rhs)    { return operator=((signed char)(rhs)); }
-	posit& operator=(unsigned int rhs)      { return operator=((signed char)(rhs)); }
-	posit& operator=(unsigned long rhs)     { return operator=((signed char)(rhs)); }
-	posit& operator=(unsigned long long rhs){ return operator=((signed char)(rhs)); }
-	posit& operator=(float rhs)             { return float_assign(rhs); }
-	posit& operator=(double rhs)            { return float_assign(rhs); }
-	posit& operator=(long double rhs)       { return float_assign(rhs); }
+	posit& operator=(signed char rhs)        { return integer_assign((long long)(rhs)); }
+	posit& operator=(short rhs)              { return integer_assign((long long)(rhs)); }
+	posit& operator=(int rhs)                { return integer_assign((long long)(rhs)); }
+	posit& operator=(long rhs)               { return integer_assign((long long)(rhs)); }
+	posit& operator=(long long rhs)          { return integer_assign(rhs); }
+	posit& operator=(char rhs)               { return integer_assign((long long)(rhs)); }
+	posit& operator=(unsigned short rhs)     { return unsigned_assign(false, (unsigned long long)(rhs)); }
+	posit& operator=(unsigned int rhs)       { return unsigned_assign(false, (unsigned long long)(rhs)); }
+	posit& operator=(unsigned long rhs)      { return unsigned_assign(false, (unsigned long long)(rhs)); }
+	posit& operator=(unsigned long long rhs) { return unsigned_assign(false, rhs); }
+	posit& operator=(float rhs)              { return float_assign((long double)rhs); }
+	posit& operator=(double rhs)             { return float_assign((long double)rhs); }
+	posit& operator=(long double rhs)        { return float_assign(rhs); }
 
 	explicit operator long double() const { return to_long_double(); }
 	explicit operator double() const { return to_double(); }
@@ -113,211 +237,112 @@ public:
 	explicit operator unsigned long() const { return to_long(); }
 	explicit operator unsigned int() const { return to_int(); }
 
-	posit& set(sw::unum::bitblock<NBITS_IS_64>& raw) {
-		_bits = uint8_t(raw.to_ulong());
+	posit& set(const sw::unum::bitblock<NBITS_IS_64>& raw) {
+		_bits = uint64_t(raw.to_ullong());
 		return *this;
 	}
-	posit& set_raw_bits(uint64_t value) {
-		_bits = uint8_t(value & 0xff);
+	constexpr posit& set_raw_bits(uint64_t value) {
+		_bits = value;
 		return *this;
 	}
 	posit operator-() const {
-		if (iszero()) {
-			return *this;
-		}
-		if (isnar()) {
-			return *this;
-		}
 		posit p;
 		return p.set_raw_bits((~_bits) + 1);
 	}
-	posit& operator+=(const posit& b) { // derived from SoftPosit
-		uint8_t lhs = _bits;
-		uint8_t rhs = b._bits;
-		// process special cases
-		if (isnar() || b.isnar()) {  // infinity
-			_bits = 0x80;
-			return *this;
+	// arithmetic assignment operators
+	posit& operator+=(const posit& b) {
+		// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+		if (isnar() || b.isnar()) {
+			throw operand_is_nar{};
 		}
-		if (iszero() || b.iszero()) { // zero
-			_bits = lhs | rhs;
+#else
+		if (isnar() || b.isnar()) {
+			setnar();
 			return *this;
 		}
-		bool sign = bool(_bits & 0x80);
-		if (sign) {
-			lhs = -lhs & 0xFF;
-			rhs = -rhs & 0xFF;
-		}
-		if (lhs < rhs) std::swap(lhs, rhs);
-			
-		// decode the regime of lhs
-		int8_t m = 0; // pattern length
-		uint8_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-		uint16_t frac16A = (0x80 | remaining) << 7;
-		int8_t shiftRight = m;
-		// adjust shift and extract fraction bits of rhs
-		extractAddand(rhs, shiftRight, remaining);
-		uint16_t frac16B = (0x80 | remaining) << 7;
-
-		// Work-around CLANG (LLVM) compiler when shifting right more than number of bits
-		(shiftRight>7) ? (frac16B = 0) : (frac16B >>= shiftRight); 
-
-		frac16A += frac16B;
-
-		bool rcarry = bool(0x8000 & frac16A); // is MSB set
-		if (rcarry) {
-			m++;
-			frac16A >>= 1;
-		}
-
-		_bits = round(m, frac16A);
-		if (sign) _bits = -_bits & 0xFF;
+#endif
+		if (b.iszero()) return *this;
+		if (iszero()) { _bits = b._bits; return *this; }
+		_bits = internal::fast_posit64_add(_bits, b._bits);
 		return *this;
 	}
-	posit& operator-=(const posit& b) {  // derived from SoftPosit
-		uint8_t lhs = _bits;
-		uint8_t rhs = b._bits;
-		// process special cases
+	posit& operator+=(double rhs) {
+		return *this += posit<nbits, es>(rhs);
+	}
+	posit& operator-=(const posit& b) {
+		// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (isnar() || b.isnar()) {
-			_bits = 0x80;
-			return *this;
-		}
-		if (iszero() || b.iszero()) {
-			_bits = lhs | rhs;
-			return *this;
+			throw operand_is_nar{};
 		}
-		// Both operands are actually the same sign if rhs inherits sign of sub: Make both positive
-		bool sign = bool(lhs & 0x80);
-		(sign) ? (lhs = (-lhs & 0xFF)) : (rhs = (-rhs & 0xFF));
-
-		if (lhs == rhs) {
-			_bits = 0x00;
-			return *this;
-		}
-		if (lhs < rhs) {
-			std::swap(lhs, rhs);
-			sign = !sign;
-		}
-
-		// decode the regime of lhs
-		int8_t m = 0; // pattern length
-		uint8_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-		uint16_t frac16A = (0x80 | remaining) << 7;
-		int8_t shiftRight = m;
-		// adjust shift and extract fraction bits of rhs
-		extractAddand(rhs, shiftRight, remaining);
-		uint16_t frac16B = (0x80 | remaining) << 7;
-
-		// do the subtraction of the fractions
-		if (shiftRight >= 14) {
-			_bits = lhs;
-			if (sign) _bits = -_bits & 0xFFFF;
+#else
+		if (isnar() || b.isnar()) {
+			setnar();
 			return *this;
 		}
-		else {
-			frac16B >>= shiftRight;
-		}
-		frac16A -= frac16B;
-
-		while ((frac16A >> 14) == 0) {
-			m--;
-			frac16A <<= 1;
-		}
-		bool ecarry = bool (0x4000 & frac16A);
-		if (!ecarry) {
-			m--;
-			frac16A <<= 1;
-		}
-
-		_bits = round(m, frac16A);
-		if (sign) _bits = -_bits & 0xFF;
+#endif
+		if (b.iszero()) return *this;
+		if (iszero()) { _bits = (~b._bits) + 1; return *this; }
+		_bits = internal::fast_posit64_add(_bits, (~b._bits) + 1);
 		return *this;
 	}
+	posit& operator-=(double rhs) {
+		return *this -= posit<nbits, es>(rhs);
+	}
 	posit& operator*=(const posit& b) {
-		uint8_t lhs = _bits;
-		uint8_t rhs = b._bits;
-		// process special cases
+		// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (isnar() || b.isnar()) {
-			_bits = 0x80;
-			return *this;
+			throw operand_is_nar{};
 		}
-		if (iszero() || b.iszero()) {
-			_bits = 0x00;
+#else
+		if (isnar() || b.isnar()) {
+			setnar();
 			return *this;
 		}
+#endif // POSIT_THROW_ARITHMETIC_EXCEPTION
 
-		// calculate the sign of the result
-		bool sign = bool(lhs & 0x80) ^ bool(rhs & 0x80);
-		lhs = lhs & 0x80 ? -lhs : lhs;
-		rhs = rhs & 0x80 ? -rhs : rhs;
-
-		// decode the regime of lhs
-		int8_t m = 0; // pattern length
-		uint8_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-		uint8_t lhs_fraction = (0x80 | remaining);
-		// adjust shift and extract fraction bits of rhs
-		extractMultiplicand(rhs, m, remaining);
-		uint8_t rhs_fraction = (0x80 | remaining);
-		uint16_t result_fraction = uint16_t(lhs_fraction) * uint16_t(rhs_fraction);
-
-		bool rcarry = bool(result_fraction & 0x8000);
-		if (rcarry) {
-			m++;
-			result_fraction >>= 1;
+		if (iszero() || b.iszero()) {
+			_bits = 0;
+			return *this;
 		}
-
-		// round
-		_bits = round(m, result_fraction);
-		if (sign) _bits = -_bits & 0xFF;
+		_bits = internal::fast_posit64_mul(_bits, b._bits);
 		return *this;
 	}
+	posit& operator*=(double rhs) {
+		return *this *= posit<nbits, es>(rhs);
+	}
 	posit& operator/=(const posit& b) {
-		uint8_t lhs = _bits;
-		uint8_t rhs = b._bits;
-		// process special cases
+		// since we are encoding error conditions as NaR (Not a Real), we need to process that condition first
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+		if (b.iszero()) {
+			throw divide_by_zero{};    // not throwing is a quiet signalling NaR
+		}
+		if (b.isnar()) {
+			throw divide_by_nar{};
+		}
+		if (isnar()) {
+			throw numerator_is_nar{};
+		}
+#else
 		if (isnar() || b.isnar() || b.iszero()) {
-			_bits = 0x80;
+			setnar();
 			return *this;
 		}
+#endif // POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (iszero()) {
-			_bits = 0x00;
+			setzero();
 			return *this;
 		}
-
-		// calculate the sign of the result
-		bool sign = bool(lhs & 0x80) ^ bool(rhs & 0x80);
-		lhs = (lhs & 0x80) ? -lhs : lhs;
-		rhs = (rhs & 0x80) ? -rhs : rhs;
-
-		// decode the regime of lhs
-		int8_t m = 0; // pattern length
-		uint8_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-		uint16_t lhs_fraction = (0x80 | remaining) << 7;
-		// adjust shift and extract fraction bits of rhs
-		extractDividand(rhs, m, remaining);
-		uint8_t rhs_fraction = (0x80 | remaining);
-		div_t result = div(lhs_fraction, uint16_t(rhs_fraction));
-		uint16_t result_fraction = result.quot;
-		uint16_t remainder = result.rem;
-
-		if (result_fraction != 0) {
-			bool rcarry = result_fraction >> 7; // this is the hidden bit (7th bit) , extreme right bit is bit 0
-			if (!rcarry) {
-				--m;
-				result_fraction <<= 1;
-			}
-		}
-
-		// round
-		_bits = adjustAndRound(m, result_fraction, remainder != 0);
-		if (sign) _bits = -_bits & 0xFF;
-
+		_bits = internal::fast_posit64_div(_bits, b._bits);
 		return *this;
 	}
+	posit& operator/=(double rhs) {
+		return *this /= posit<nbits, es>(rhs);
+	}
+
+	// prefix/postfix operators
 	posit& operator++() {
 		++_bits;
 		return *this;
@@ -337,270 +362,146 @@ public:
 		return tmp;
 	}
 	posit reciprocate() const {
-		posit p = 1.0 / *this;
+		posit p(1);
+		p /= *this;
 		return p;
 	}
-	// SELECTORS
-	inline bool isnar() const      { return (_bits == 0x80); }
-	inline bool iszero() const     { return (_bits == 0x00); }
-	inline bool isone() const      { return (_bits == 0x40); } // pattern 010000...
-	inline bool isminusone() const { return (_bits == 0xC0); } // pattern 110000...
-	inline bool isneg() const      { return (_bits & 0x80); }
-	inline bool ispos() const      { return !isneg(); }
-	inline bool ispowerof2() const { return !(_bits & 0x1); }
+	posit abs() const {
+		if (isneg()) {
+			return posit(-*this);
+		}
+		return *this;
+	}
 
-	inline int sign_value() const  { return (_bits & 0x8 ? -1 : 1); }
+	// MODIFIERS
+	inline constexpr void clear() { _bits = 0x0; }
+	inline constexpr void setzero() { clear(); }
+	inline constexpr void setnar() { _bits = sign_mask; }
 
-	bitblock<NBITS_IS_64> get() const { bitblock<NBITS_IS_64> bb; bb = int(_bits); return bb; }
+	// SELECTORS
+	inline constexpr bool isnar() const      { return (_bits == sign_mask); }
+	inline constexpr bool iszero() const     { return (_bits == 0x0); }
+	inline constexpr bool isone() const      { return (_bits == 0x4000000000000000ull); } // pattern 010000...
+	inline constexpr bool isminusone() const { return (_bits == 0xC000000000000000ull); } // pattern 110000...
+	inline constexpr bool isneg() const      { return (_bits & sign_mask); }
+	inline constexpr bool ispos() const      { return !isneg(); }
+	inline bool ispowerof2() const {
+		if (iszero() || isnar()) return false;
+		int scale;
+		uint64_t significand;
+		internal::fast_posit64_decode(isneg() ? (~_bits + 1) : _bits, scale, significand);
+		return significand == sign_mask;
+	}
+
+	inline int sign_value() const { return (_bits & sign_mask) ? -1 : 1; }
+
+	bitblock<NBITS_IS_64> get() const { bitblock<NBITS_IS_64> bb; bb = (unsigned long long)(_bits); return bb; }
 	unsigned long long encoding() const { return (unsigned long long)(_bits); }
-
-	inline void clear() { _bits = 0; }
-	inline void setzero() { clear(); }
-	inline void setnar() { _bits = 0x80; }
 	inline posit twosComplement() const {
-		posit<NBITS_IS_64, ES_IS_3> p;
-		int8_t v = -*(int8_t*)&_bits;
-		p.set_raw_bits(v);
-		return p;
+		posit p;
+		return p.set_raw_bits((~_bits) + 1);
+	}
+
+	value<fbits> to_value() const {
+		if (iszero() || isnar()) return value<fbits>(false, 0, bitblock<fbits>(), iszero(), isnar());
+		bool sign = isneg();
+		int scale;
+		uint64_t significand;
+		internal::fast_posit64_decode(sign ? (~_bits + 1) : _bits, scale, significand);
+		bitblock<fbits> fraction;
+		fraction = (unsigned long long)((significand << 1) >> (64 - fbits));
+		return value<fbits>(sign, scale, fraction, false, false);
 	}
+
 private:
-	uint8_t _bits;
+	uint64_t _bits;
 
 	// Conversion functions
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 	int         to_int() const {
 		if (iszero()) return 0;
 		if (isnar()) throw not_a_real{};
-		return int(to_float());
+		return int(to_double());
 	}
 	long        to_long() const {
 		if (iszero()) return 0;
 		if (isnar()) throw not_a_real{};
-		return long(to_double());
+		return long(to_long_double());
 	}
 	long long   to_long_long() const {
 		if (iszero()) return 0;
 		if (isnar()) throw not_a_real{};
-		return long(to_long_double());
+		return (long long)(to_long_double());
 	}
 #else
 	int         to_int() const {
 		if (iszero()) return 0;
 		if (isnar())  return int(INFINITY);
-		return int(to_float());
+		return int(to_double());
 	}
 	long        to_long() const {
 		if (iszero()) return 0;
 		if (isnar())  return long(INFINITY);
-		return long(to_double());
+		return long(to_long_double());
 	}
 	long long   to_long_long() const {
 		if (iszero()) return 0;
 		if (isnar())  return (long long)(INFINITY);
-		return long(to_long_double());
+		return (long long)(to_long_double());
 	}
 #endif
+	// the significand has at most 59 significant bits, so the conversion to long double is exact
+	// on platforms with an extended long double, and the narrowing to double and float rounds once
 	float       to_float() const {
-		return (float)to_double();
+		return float(to_long_double());
 	}
 	double      to_double() const {
-		if (iszero())	return 0.0;
-		if (isnar())	return NAN;
-		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		bitblock<nbits>		 _raw_bits;
-		_raw_bits.reset();
-		uint64_t mask = 1;
-		for (size_t i = 0; i < nbits; i++) {
-			_raw_bits.set(i, (_bits & mask));
-			mask <<= 1;
-		}
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-		double s = (_sign ? -1.0 : 1.0);
-		double r = _regime.value();
-		double e = _exponent.value();
-		double f = (1.0 + _fraction.value());
-		return s * r * e * f;
+		return double(to_long_double());
 	}
 	long double to_long_double() const {
 		if (iszero())  return 0.0;
 		if (isnar())   return NAN;
-		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		bitblock<nbits>		 _raw_bits;
-		_raw_bits.reset();
-		uint64_t mask = 1;
-		for (size_t i = 0; i < nbits; i++) {
-			_raw_bits.set(i, (_bits & mask));
-			mask <<= 1;
-		}
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-		long double s = (_sign ? -1.0 : 1.0);
-		long double r = _regime.value();
-		long double e = _exponent.value();
-		long double f = (1.0 + _fraction.value());
-		return s * r * e * f;
+		bool sign = isneg();
+		int scale;
+		uint64_t significand;
+		internal::fast_posit64_decode(sign ? (~_bits + 1) : _bits, scale, significand);
+		long double v = std::ldexp((long double)(significand), scale - 63);
+		return sign ? -v : v;
 	}
 
-	template <typename T>
-	posit& float_assign(const T& rhs) {
-		constexpr int dfbits = std::numeric_limits<T>::digits - 1;
-		value<dfbits> v((T)rhs);
-
+	// helper methods
+	posit& integer_assign(long long rhs) {
+		bool sign = rhs < 0;
+		return unsigned_assign(sign, sign ? (~(unsigned long long)(rhs) + 1) : (unsigned long long)(rhs));
+	}
+	posit& unsigned_assign(bool sign, unsigned long long v) {
+		// special case for speed as this is a common initialization
+		if (v == 0) {
+			_bits = 0x0;
+			return *this;
+		}
+		int lz = internal::limb_clz(v);
+		_bits = internal::fast_posit64_encode(sign, 63 - lz, uint64_t(v) << lz, false);
+		return *this;
+	}
+	posit& float_assign(long double rhs) {
 		// special case processing
-		if (v.iszero()) {
+		if (rhs == 0.0l) {
 			setzero();
 			return *this;
 		}
-		if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
+		if (std::isinf(rhs) || std::isnan(rhs)) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
 			setnar();
 			return *this;
 		}
-
-		bitblock<NBITS_IS_64> ptt;
-		convert_to_bb<NBITS_IS_64, ES_IS_3, dfbits>(v.sign(), v.scale(), v.fraction(), ptt); // TODO: needs to be faster
-		_bits = uint8_t(ptt.to_ulong());
+		bool sign = rhs < 0.0l;
+		int exponent;
+		long double m = std::ldexp(std::frexp(sign ? -rhs : rhs, &exponent), 64);   // in [2^63, 2^64)
+		uint64_t significand = uint64_t(m);
+		_bits = internal::fast_posit64_encode(sign, exponent - 1, significand, (m - (long double)(significand)) != 0.0l);
 		return *this;
 	}
 
-	// helper method
-	// decode_regime takes the raw bits of the posit, and returns the regime run-length, m, and the remaining fraction bits in remainder
-	inline void decode_regime(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-		remaining = (bits << 2) & 0xFF;
-		if (bits & 0x40) {  // positive regimes
-			while (remaining >> 7) {
-				++m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-		}
-		else {              // negative regimes
-			m = -1;
-			while (!(remaining >> 7)) {
-				--m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-			remaining &= 0x7F;
-		}
-	}
-	inline void extractAddand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-		remaining = (bits << 2) & 0xFF;
-		if (bits & 0x40) {  // positive regimes
-			while (remaining >> 7) {
-				--m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-		}
-		else {              // negative regimes
-			++m;
-			while (!(remaining >> 7)) {
-				++m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-			remaining &= 0x7F;
-		}
-	}
-	inline void extractMultiplicand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-		remaining = (bits << 2) & 0xFF;
-		if (bits & 0x40) {  // positive regimes
-			while (remaining >> 7) {
-				++m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-		}
-		else {              // negative regimes
-			--m;
-			while (!(remaining >> 7)) {
-				--m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-			remaining &= 0x7F;
-		}
-	}
-	inline void extractDividand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-		remaining = (bits << 2) & 0xFF;
-		if (bits & 0x40) {  // positive regimes
-			while (remaining >> 7) {
-				--m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-		}
-		else {              // negative regimes
-			++m;
-			while (!(remaining >> 7)) {
-				++m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-			remaining &= 0x7F;
-		}
-	}
-	inline uint8_t round(const int8_t m, uint16_t fraction) const {
-		uint8_t scale, regime, bits;
-		if (m < 0) {
-			scale = (-m & 0xFF);
-			regime = 0x40 >> scale;
-		}
-		else {
-			scale = m + 1;
-			regime = 0x7F - (0x7F >> scale);
-		}
-
-		if (scale > 6) {
-			bits = m<0 ? 0x1 : 0x7F;  // minpos and maxpos
-		}
-		else {
-			fraction = (fraction & 0x3FFF) >> scale;
-			uint8_t final_fbits = uint8_t(fraction >> 8);
-			bool bitNPlusOne = bool(0x80 & fraction);
-			bits = uint8_t(regime) + uint8_t(final_fbits);
-			// n+1 frac bit is 1. Need to check if another bit is 1 too if not round to even
-			if (bitNPlusOne) {
-				uint8_t moreBits = (0x7F & fraction) ? 0x01 : 0x00;
-				bits += (bits & 0x01) | moreBits;
-			}
-		}
-		return bits;
-	}
-	inline uint8_t adjustAndRound(const int8_t k, uint16_t fraction, bool nonZeroRemainder) const {
-		uint8_t scale, regime, bits;
-		if (k < 0) {
-			scale = (-k & 0xFF);
-			regime = 0x40 >> scale;
-		}
-		else {
-			scale = k + 1;
-			regime = 0x7F - (0x7F >> scale);
-		}
-
-		if (scale > 6) {
-			bits = k<0 ? 0x1 : 0x7F;  // minpos and maxpos
-		}
-		else {
-			//remove carry and rcarry bits and shift to correct position
-			fraction &= 0x7F;
-			uint8_t final_fbits = (uint_fast16_t)fraction >> (scale + 1);
-			bool bitNPlusOne = (0x1 & (fraction >> scale));
-			bits = uint8_t(regime) + uint8_t(final_fbits);
-#ifdef NOW
-			std::cout << std::hex;
-			std::cout << "fraction raw   = " << int(fraction) << std::endl;
-			std::cout << "fraction final = " << int(final_fbits) << std::endl;
-			std::cout << "posit bits     = " << int(bits) << std::endl;
-			std::cout << std::dec;
-#endif
-			if (bitNPlusOne) {
-				uint8_t moreBits = (((1 << scale) - 1) & fraction) ? 0x01 : 0x00;
-				if (nonZeroRemainder) moreBits = 0x01;
-				//std::cout << "bitsMore = " << (moreBits ? "true" : "false") << std::endl;
-				// n+1 frac bit is 1. Need to check if another bit is 1 too if not round to even
-				bits += (bits & 0x01) | moreBits;
-			}
-		}
-		return bits;
-	}
 	// I/O operators
 	friend std::ostream& operator<< (std::ostream& ostr, const posit<NBITS_IS_64, ES_IS_3>& p);
 	friend std::istream& operator>> (std::istream& istr, posit<NBITS_IS_64, ES_IS_3>& p);
@@ -634,7 +535,7 @@ inline std::ostream& operator<<(std::ostream& ostr, const posit<NBITS_IS_64, ES_
 	return ostr << ss.str();
 }
 
-// read an ASCII float or posit format: nbits.esxNN...NNp, for example: 32.2x80000000p
+// read an ASCII float or posit format: nbits.esxNN...NNp, for example: 64.3x8000000000000000p
 inline std::istream& operator>> (std::istream& istr, posit<NBITS_IS_64, ES_IS_3>& p) {
 	std::string txt;
 	istr >> txt;
@@ -645,12 +546,12 @@ inline std::istream& operator>> (std::istream& istr, posit<NBITS_IS_64, ES_IS_3>
 }
 
 // convert a posit value to a string using "nar" as designation of NaR
-std::string to_string(const posit<NBITS_IS_64, ES_IS_3>& p, std::streamsize precision) {
+inline std::string to_string(const posit<NBITS_IS_64, ES_IS_3>& p, std::streamsize precision) {
 	if (p.isnar()) {
 		return std::string("nar");
 	}
 	std::stringstream ss;
-	ss << std::setprecision(precision) << float(p);
+	ss << std::setprecision(precision) << (long double)(p);
 	return ss.str();
 }
 
@@ -674,28 +575,10 @@ inline bool operator>=(const posit<NBITS_IS_64, ES_IS_3>& lhs, const posit<NBITS
 	return !operator< (lhs, rhs);
 }
 
-inline posit<NBITS_IS_64, ES_IS_3> operator+(const posit<NBITS_IS_64, ES_IS_3>& lhs, const posit<NBITS_IS_64, ES_IS_3>& rhs) {
-	posit<NBITS_IS_64, ES_IS_3> result = lhs;
-	if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-		result += rhs;
-	} 
-	else {
-		result -= rhs;
-	}
-	return result;
-}
-inline posit<NBITS_IS_64, ES_IS_3> operator-(const posit<NBITS_IS_64, ES_IS_3>& lhs, const posit<NBITS_IS_64, ES_IS_3>& rhs) {
-	posit<NBITS_IS_64, ES_IS_3> result = lhs;
-	if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-		result -= rhs.twosComplement();
-	}
-	else {
-		result += rhs.twosComplement();
-	}
-	return result;
-
-}
-// binary operator*() is provided by generic class
+// binary operator+() is provided by generic function
+// binary operator-() is provided by generic function
+// binary operator*() is provided by generic function
+// binary operator/() is provided by generic function
 
 #if POSIT_ENABLE_LITERALS
 // posit - literal logic functions
@@ -98,32 +98,52 @@ public:
 		return negated.set_raw_bits(posit8_1_negate(b).v);
 	}
 	posit& operator+=(const posit& b) {
+#if POSIT_LOOKUP_ARITHMETIC
+		_bits = posit_binary_lookup<NBITS_IS_8, ES_IS_1, internal::lookup_operator::add>[(size_t(_bits) << 8) | b._bits];
+		return *this;
+#else
 		posit8_1_t lhs = { { _bits } };
 		posit8_1_t rhs = { { b._bits} };
 		posit8_1_t add = posit8_1_addp8(lhs, rhs);
 		_bits = add.v;
 		return *this;
+#endif
 	}
 	posit& operator-=(const posit& b) {
+#if POSIT_LOOKUP_ARITHMETIC
+		_bits = posit_binary_lookup<NBITS_IS_8, ES_IS_1, internal::lookup_operator::sub>[(size_t(_bits) << 8) | b._bits];
+		return *this;
+#else
 		posit8_1_t lhs = { { _bits } };
 		posit8_1_t rhs = { { b._bits } };
 		posit8_1_t sub = posit8_1_subp8(lhs, rhs);
 		_bits = sub.v;
 		return *this;
+#endif
 	}
 	posit& operator*=(const posit& b) {
+#if POSIT_LOOKUP_ARITHMETIC
+		_bits = posit_binary_lookup<NBITS_IS_8, ES_IS_1, internal::lookup_operator::mul>[(size_t(_bits) << 8) | b._bits];
+		return *this;
+#else
 		posit8_1_t lhs = { { _bits } };
 		posit8_1_t rhs = { { b._bits } };
 		posit8_1_t mul = posit8_1_mulp8(lhs, rhs);
 		_bits = mul.v;
 		return *this;
+#endif
 	}
 	posit& operator/=(const posit& b) {
+#if POSIT_LOOKUP_ARITHMETIC
+		_bits = posit_binary_lookup<NBITS_IS_8, ES_IS_1, internal::lookup_operator::div>[(size_t(_bits) << 8) | b._bits];
+		return *this;
+#else
 		posit8_1_t lhs = { { _bits } };
 		posit8_1_t rhs = { { b._bits } };
 		posit8_1_t div = posit8_1_divp8(lhs, rhs);
 		_bits = div.v;
 		return *this;
+#endif
 	}
 	posit& operator++() {
 		++_bits;
@@ -144,8 +164,13 @@ public:
 		return tmp;
 	}
 	posit reciprocate() const {
+#if POSIT_LOOKUP_ARITHMETIC
+		posit p;
+		return p.set_raw_bits(posit_unary_lookup<NBITS_IS_8, ES_IS_1, internal::lookup_operator::reciprocal>[_bits]);
+#else
 		posit p = 1.0 / *this;
 		return p;
+#endif
 	}
 	// SELECTORS
 	inline bool isnar() const      { return (_bits == 0x80); }
@@ -170,6 +195,22 @@ public:
 		p.set_raw_bits(v);
 		return p;
 	}
+
+	value<fbits> to_value() const {
+		bool		     	 _sign;
+		regime<nbits, es>    _regime;
+		exponent<nbits, es>  _exponent;
+		fraction<fbits>      _fraction;
+		bitblock<nbits>		 _raw_bits;
+		_raw_bits.reset();
+		uint64_t mask = 1;
+		for (size_t i = 0; i < nbits; i++) {
+			_raw_bits.set(i, (_bits & mask));
+			mask <<= 1;
+		}
+		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
+		return value<fbits>(_sign, _regime.scale() + _exponent.scale(), _fraction.get(), iszero(), isnar());
+	}
 private:
 	uint8_t _bits;
 
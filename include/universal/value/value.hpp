@@ -374,26 +374,24 @@ public:
 			number[0] = true;
 			return number;
 		}
+		// Copy fraction bits into certain part
+		if (shift >= 0) {
+			copy_into<fbits, Size>(_fraction, size_t(shift), number);
+		}
+		else {
+			copy_into<fbits, Size>(_fraction, 0, number);
+			number >>= size_t(-shift);
+			// Set uncertainty bit
+			number[0] = anyAfter(_fraction, std::min(int(fbits) - 1, -shift));
+		}
 		number[size_t(hpos)] = true;                   // hidden bit now safely set
-
-											   // Copy fraction bits into certain part
-		for (int npos = hpos - 1, fpos = int(fbits) - 1; npos > 0 && fpos >= 0; --npos, --fpos)
-			number[size_t(npos)] = _fraction[size_t(fpos)];
-
-		// Set uncertainty bit
-		bool uncertainty = false;
-		for (int fpos = std::min(int(fbits) - 1, -shift); fpos >= 0 && !uncertainty; --fpos)
-			uncertainty |= _fraction[size_t(fpos)];
-		number[0] = uncertainty;
 		return number;
 	}
 	// get a fixed point number by making the hidden bit explicit: useful for multiply units
 	bitblock<fhbits> get_fixed_point() const {
 		bitblock<fbits + 1> fixed_point_number;
+		copy_into<fbits, fbits + 1>(_fraction, 0, fixed_point_number);
 		fixed_point_number.set(fbits, true); // make hidden bit explicit
-		for (size_t i = 0; i < fbits; i++) {
-			fixed_point_number[i] = _fraction[i];
-		}
 		return fixed_point_number;
 	}
 	// get the fraction value including the implicit hidden bit (this is at an exponent level 1 smaller)
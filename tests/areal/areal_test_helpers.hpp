@@ -4,6 +4,7 @@
 // Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
 #include <vector>
 #include <iostream>
 #include <typeinfo>
@@ -1049,6 +1050,203 @@ namespace sw { namespace unum {
 		}
 
 
+		//////////////////////////////////// UBIT-AWARE VERIFICATION ////////////////////////
+
+		// the bounds of an areal as values of a wider native type: an exact value is the closed interval [v, v],
+		// an uncertain value the open interval between its exact value and the next exact value away from zero
+		template<typename Areal, typename Real>
+		void ArealBounds(const Areal& a, Real& lo, Real& hi) {
+			Areal exact(a), next(a);
+			exact.setubit(false);
+			lo = hi = Real(exact.to_long_double());
+			if (!a.ubit()) return;
+			if (a.sign()) { --next; --next; } else { ++next; ++next; }
+			(a.sign() ? lo : hi) = Real(next.to_long_double());
+		}
+
+		// the areal that holds the value x, or the values just above x (side > 0) or just below x (side < 0)
+		template<typename Areal, typename Real>
+		Areal ArealLocate(Real x, int side) {
+			Areal c(x);
+			if (c.isexact() && side > 0) ++c;
+			if (c.isexact() && side < 0) --c;
+			return c;
+		}
+
+		template<typename Real>
+		Real ArealOperation(int opcode, Real a, Real b) {
+			switch (opcode) {
+			default:
+			case OPCODE_ADD: return a + b;
+			case OPCODE_SUB: return a - b;
+			case OPCODE_MUL: return a * b;
+			case OPCODE_DIV: return a / b;
+			}
+		}
+
+		// the reference result of an areal operation, computed on the bounds of the operands in a wider native type
+		// in which they, and their sums and products, are exact. Exact operands yield the exact result, truncated by
+		// the conversion. Otherwise the result is the areal that encloses the interval between the smallest and the
+		// largest result on the bounds, or NaN when no single areal encloses it.
+		template<typename Areal, typename Real>
+		Areal ArealReference(int opcode, const Areal& a, const Areal& b) {
+			Areal nan;
+			nan.setnan();
+			if (a.isnan() || b.isnan()) return nan;
+			Real alo, ahi, blo, bhi;
+			ArealBounds(a, alo, ahi);
+			ArealBounds(b, blo, bhi);
+			bool open = a.ubit() || b.ubit();
+			// an exact zero or infinity that absorbs the other operand yields the same result for all the values
+			// of the other operand: evaluate it on a value inside the interval
+			bool ainf = a.isinf(), binf = b.isinf(), azero = a.iszero() && !a.ubit(), bzero = b.iszero() && !b.ubit();
+			bool absorbs = ainf || binf;
+			if (opcode == OPCODE_MUL) absorbs = absorbs || azero || bzero;
+			if (opcode == OPCODE_DIV) absorbs = absorbs || azero || bzero;
+			if (!open || absorbs) {
+				auto inside = [](Real lo, Real hi) { return std::isinf(lo) ? 2 * hi : (std::isinf(hi) ? 2 * lo : (lo + hi) / 2); };
+				return Areal(ArealOperation(opcode, a.ubit() ? inside(alo, ahi) : alo, b.ubit() ? inside(blo, bhi) : blo));
+			}
+			// the results on the bounds that are defined: 0 * inf, 0 / 0, and inf / inf only occur on open bounds
+			// that other combinations of bounds dominate
+			Real lo = std::numeric_limits<Real>::infinity(), hi = -lo;
+			for (Real x : { alo, ahi }) {
+				for (Real y : { blo, bhi }) {
+					Real r = ArealOperation(opcode, x, y);
+					if (std::isnan(r)) continue;
+					if (r < lo) lo = r;
+					if (r > hi) hi = r;
+				}
+			}
+			Areal l = ArealLocate<Areal>(lo, 1), h = ArealLocate<Areal>(hi, -1);
+			return (l == h) ? l : nan;
+		}
+
+		template<typename Areal>
+		Areal ArealExecute(int opcode, const Areal& a, const Areal& b) {
+			switch (opcode) {
+			default:
+			case OPCODE_ADD: return a + b;
+			case OPCODE_SUB: return a - b;
+			case OPCODE_MUL: return a * b;
+			case OPCODE_DIV: return a / b;
+			}
+		}
+
+		// identical encodings, or both NaN
+		template<typename Areal>
+		bool ArealIdentical(const Areal& a, const Areal& b) {
+			return (a.isnan() && b.isnan()) || a.get() == b.get();
+		}
+
+		// enumerate all operand pairs of a small areal configuration, including the uncertain and special encodings
+		template<size_t nbits, size_t es, typename Real = double>
+		int ValidateUbitArithmetic(const std::string& tag, bool bReportIndividualTestCases, int opcode) {
+			using Areal = areal<nbits, es>;
+			const size_t NR_VALUES = (size_t(1) << nbits);
+			int nrOfFailedTests = 0;
+			Areal a, b;
+			for (size_t i = 0; i < NR_VALUES; ++i) {
+				a.set_raw_bits(i);
+				for (size_t j = 0; j < NR_VALUES; ++j) {
+					b.set_raw_bits(j);
+					Areal result = ArealExecute(opcode, a, b);
+					Areal reference = ArealReference<Areal, Real>(opcode, a, b);
+					if (!ArealIdentical(result, reference)) {
+						++nrOfFailedTests;
+						if (bReportIndividualTestCases) std::cerr << tag << " FAIL " << a.get() << ' ' << b.get() << " yielded " << result.get() << " reference " << reference.get() << std::endl;
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// random operands with exponents near the bias, so that the reference results are exact in the native type
+		template<size_t nbits, size_t es, typename Real = double>
+		int ValidateUbitArithmeticThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, int opcode, size_t nrRandoms, int exponentRange) {
+			using Areal = areal<nbits, es>;
+			constexpr size_t fbits = Areal::fbits;
+			std::mt19937_64 eng(0x5eed);
+			std::uniform_int_distribution<uint64_t> fraction(0, (uint64_t(1) << fbits) - 1);
+			std::uniform_int_distribution<int> exponent(Areal::bias - exponentRange, Areal::bias + exponentRange);
+			std::uniform_int_distribution<int> coin(0, 1);
+			auto random_areal = [&]() {
+				Areal v;
+				uint64_t raw = (uint64_t(coin(eng)) << (nbits - 1)) | (uint64_t(exponent(eng)) << (fbits + 1)) | (fraction(eng) << 1) | uint64_t(coin(eng));
+				v.set_raw_bits(raw);
+				return v;
+			};
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < nrRandoms; ++i) {
+				Areal a = random_areal(), b = random_areal();
+				Areal result = ArealExecute(opcode, a, b);
+				Areal reference = ArealReference<Areal, Real>(opcode, a, b);
+				if (!ArealIdentical(result, reference)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cerr << tag << " FAIL " << a.get() << ' ' << b.get() << " yielded " << result.get() << " reference " << reference.get() << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// exact values convert exactly, values between two exact values convert to the interval between them
+		template<size_t nbits, size_t es>
+		int ValidateUbitConversion(const std::string& tag, bool bReportIndividualTestCases) {
+			using Areal = areal<nbits, es>;
+			const size_t NR_VALUES = (size_t(1) << nbits);
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < NR_VALUES; i += 2) {
+				Areal exact, interval, next;
+				exact.set_raw_bits(i);
+				if (exact.isinf() || exact.isnan()) continue;
+				interval.set_raw_bits(i + 1);
+				next.set_raw_bits(i + 2);
+				long double v = exact.to_long_double();
+				if (!ArealIdentical(Areal(v), exact)) ++nrOfFailedTests;
+				long double u = next.isinf() ? 2 * v : (v + next.to_long_double()) / 2;
+				if (!ArealIdentical(Areal(u), interval)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cerr << tag << " FAIL " << u << " converted to " << Areal(u).get() << " instead of " << interval.get() << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// uncertain operands are intervals: the result encloses all the results on their values, overflow lands
+		// in (maxpos, inf), and underflow in (0, minpos)
+		template<size_t nbits, size_t es>
+		int VerifyUbitPropagation() {
+			using Areal = areal<nbits, es>;
+			int nrOfFailedTests = 0;
+			Areal third = Areal(1) / Areal(3);
+			if (!third.ubit() || (Areal(0.75) + Areal(0.25)).ubit()) ++nrOfFailedTests;
+			// 3 * (1/3) holds 1, which is exact: no single areal encloses it
+			if (!(third * Areal(3)).isnan()) ++nrOfFailedTests;
+			// 2 - (0.5, 0.5 + ulp) is (1.5 - ulp, 1.5), inside the interval below 1.5 of twice the width
+			Areal half(0.5), below(1.5);
+			half.setubit();
+			--below;
+			if ((Areal(2) - half).get() != below.get() || !(Areal(1) - half).isnan()) ++nrOfFailedTests;
+			// (1, 1 + ulp) + 0.5 is the interval above 1.5, and (1, 1 + ulp) + (0.25, 0.25 + ulp/4) holds 1.25 + ulp
+			Areal one(1), quarter(0.25), above(1.5);
+			one.setubit();
+			quarter.setubit();
+			++above;
+			if ((one + Areal(0.5)).get() != above.get() || !(one + quarter).isnan()) ++nrOfFailedTests;
+			// (0, minpos) is not zero: it absorbs only a product that stays below minpos
+			Areal tiny = std::numeric_limits<Areal>::denorm_min(), small;
+			small.setubit();
+			if ((small * Areal(0.5)).get() != small.get() || !(small * Areal(4)).isnan() || (small / Areal(2)).get() != small.get()) ++nrOfFailedTests;
+			if (!(small * Areal(0)).iszero() || (small * Areal(0)).ubit() || !(small / small).isnan()) ++nrOfFailedTests;
+			Areal big = std::numeric_limits<Areal>::max();
+			Areal above_maxpos(big);
+			++above_maxpos;
+			if ((Areal(1) / small).get() != above_maxpos.get()) ++nrOfFailedTests;
+			if ((big + big).get() != above_maxpos.get() || (big * big).isinf() || (above_maxpos * Areal(2)).get() != above_maxpos.get()) ++nrOfFailedTests;
+			if (!(tiny * tiny).iszero() || !(tiny * tiny).ubit()) ++nrOfFailedTests;
+			return nrOfFailedTests;
+		}
+
 } // namespace unum
 } // namespace sw
 
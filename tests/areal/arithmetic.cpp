@@ -0,0 +1,57 @@
+// arithmetic.cpp: functional tests for the arithmetic of arbitrary reals and the propagation of the ubit
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/areal/areal.hpp>
+#include <universal/areal/numeric_limits.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "areal_test_helpers.hpp"
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+	bool bReportIndividualTestCases = false;
+	constexpr size_t RND_TEST_CASES = 100000;
+
+	cout << "Arbitrary real arithmetic validation: native integer arithmetic" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitConversion<8, 2>("areal<8,2>", bReportIndividualTestCases), "areal<8,2>", "conversion    ");
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitConversion<10, 4>("areal<10,4>", bReportIndividualTestCases), "areal<10,4>", "conversion    ");
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitConversion<16, 5>("areal<16,5>", bReportIndividualTestCases), "areal<16,5>", "conversion    ");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmetic<8, 2>("areal<8,2>", bReportIndividualTestCases, OPCODE_ADD), "areal<8,2>", "addition      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmetic<8, 2>("areal<8,2>", bReportIndividualTestCases, OPCODE_SUB), "areal<8,2>", "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmetic<8, 2>("areal<8,2>", bReportIndividualTestCases, OPCODE_MUL), "areal<8,2>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmetic<8, 2>("areal<8,2>", bReportIndividualTestCases, OPCODE_DIV), "areal<8,2>", "division      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmetic<8, 4>("areal<8,4>", bReportIndividualTestCases, OPCODE_ADD), "areal<8,4>", "addition      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmetic<8, 4>("areal<8,4>", bReportIndividualTestCases, OPCODE_MUL), "areal<8,4>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmetic<8, 4>("areal<8,4>", bReportIndividualTestCases, OPCODE_DIV), "areal<8,4>", "division      ");
+
+	for (int opcode : { OPCODE_ADD, OPCODE_SUB, OPCODE_MUL, OPCODE_DIV }) {
+		nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmeticThroughRandoms<16, 5>("areal<16,5>", bReportIndividualTestCases, opcode, RND_TEST_CASES, 15), "areal<16,5>", "random op " + to_string(opcode) + "   ");
+		nrOfFailedTestCases += ReportTestResult(ValidateUbitArithmeticThroughRandoms<32, 8>("areal<32,8>", bReportIndividualTestCases, opcode, RND_TEST_CASES, 12), "areal<32,8>", "random op " + to_string(opcode) + "   ");
+	}
+
+	nrOfFailedTestCases += ReportTestResult(VerifyUbitPropagation<16, 5>(), "areal<16,5>", "ubit          ");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
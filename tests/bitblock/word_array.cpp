@@ -0,0 +1,212 @@
+// word_array.cpp :  test suite for the word-array bitblock across 64-bit word boundaries
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#define BITBLOCK_WORD_ARRAY 1
+#define BITBLOCK_THROW_ARITHMETIC_EXCEPTION 1
+#undef BITBLOCK_ROUND_TIES_AWAY_FROM_ZERO
+#undef BITBLOCK_ROUND_TIES_TO_ZERO
+#include "universal/bitblock/bitblock.hpp"
+#include <random>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw { namespace unum {
+
+// random bitblock with a random number of significant bits
+template<size_t nbits>
+bitblock<nbits> RandomBitblock(std::mt19937_64& eng) {
+	bitblock<nbits> a;
+	for (size_t i = 0; i < nbits; ++i) a[i] = (eng() & 1) != 0;
+	a >>= size_t(eng() % nbits);
+	return a;
+}
+
+// bit-serial reference: sum of a and b in nbits + 1 bits
+template<size_t nbits>
+bitblock<nbits + 1> ReferenceAdd(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+	bitblock<nbits + 1> sum;
+	bool carry = false;
+	for (size_t i = 0; i < nbits; ++i) {
+		sum[i] = a[i] ^ b[i] ^ carry;
+		carry = (a[i] & b[i]) | (carry & (a[i] ^ b[i]));
+	}
+	sum[nbits] = carry;
+	return sum;
+}
+
+// bit-serial reference: product of a and b in 2 * nbits bits
+template<size_t nbits>
+bitblock<2 * nbits> ReferenceMul(const bitblock<nbits>& a, const bitblock<nbits>& b) {
+	bitblock<2 * nbits> product;
+	for (size_t i = 0; i < nbits; ++i) {
+		if (!a[i]) continue;
+		bool carry = false;
+		for (size_t j = 0; j < 2 * nbits - i; ++j) {
+			bool bj = (j < nbits ? b[j] : false);
+			bool pj = product[i + j];
+			product[i + j] = pj ^ bj ^ carry;
+			carry = (pj & bj) | (carry & (pj ^ bj));
+		}
+	}
+	return product;
+}
+
+template<size_t nbits>
+int VerifyShifts(std::mt19937_64& eng, bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	for (int t = 0; t < 100; ++t) {
+		bitblock<nbits> a = RandomBitblock<nbits>(eng);
+		size_t shift = size_t(eng() % (nbits + 2));
+		bitblock<nbits> l(a), r(a), lref, rref;
+		l <<= shift;
+		r >>= shift;
+		for (size_t i = 0; i < nbits; ++i) {
+			lref[i] = (i >= shift ? a[i - shift] : false);
+			rref[i] = (i + shift < nbits ? a[i + shift] : false);
+		}
+		if (l != lref || r != rref) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " shift " << shift << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+template<size_t nbits>
+int VerifyAddSubtract(std::mt19937_64& eng, bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	for (int t = 0; t < 100; ++t) {
+		bitblock<nbits> a = RandomBitblock<nbits>(eng), b = RandomBitblock<nbits>(eng);
+		if (t & 1) { a.set(); b.set(); b >>= size_t(eng() % nbits); } // force carries across all the words
+		bitblock<nbits + 1> sum, ref = ReferenceAdd(a, b);
+		bitblock<nbits + 2> dif;
+		add_unsigned(a, b, sum);
+		// subtracting b from the sum reproduces a
+		bitblock<nbits + 1> bb;
+		copy_into<nbits, nbits + 1>(b, 0, bb);
+		subtract_unsigned(sum, bb, dif);
+		bitblock<nbits + 1> aa;
+		copy_into<nbits, nbits + 1>(a, 0, aa);
+		bitblock<nbits + 1> diflow;
+		for (size_t i = 0; i < nbits + 1; ++i) diflow[i] = dif[i];
+		if (sum != ref || diflow != aa) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " + " << b << " = " << sum << " ref " << ref << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+template<size_t nbits>
+int VerifyMultiplyDivide(std::mt19937_64& eng, bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	for (int t = 0; t < 50; ++t) {
+		bitblock<nbits> a = RandomBitblock<nbits>(eng), b = RandomBitblock<nbits>(eng);
+		if (b.none()) b.set(0);
+		bitblock<2 * nbits> product, ref = ReferenceMul(a, b);
+		multiply_unsigned(a, b, product);
+		// (a * b) / b == a
+		bitblock<2 * nbits> wideb;
+		copy_into<nbits, 2 * nbits>(b, 0, wideb);
+		bitblock<4 * nbits> quotient, ref_quotient;
+		integer_divide_unsigned(product, wideb, quotient);
+		copy_into<nbits, 4 * nbits>(a, 0, ref_quotient);
+		if (product != ref || quotient != ref_quotient) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " * " << b << " = " << product << " ref " << ref << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+template<size_t nbits>
+int VerifyMostSignificantBit(std::mt19937_64& eng, bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	for (int t = 0; t < 100; ++t) {
+		bitblock<nbits> a = RandomBitblock<nbits>(eng);
+		int ref = -1;
+		for (int i = int(nbits) - 1; i >= 0; --i) if (a[size_t(i)]) { ref = i; break; }
+		int lsb = int(eng() % nbits);
+		bool sticky = false;
+		for (int i = lsb; i >= 0; --i) sticky |= a[size_t(i)];
+		if (findMostSignificantBit(a) != ref || anyAfter(a, lsb) != sticky) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: msb of " << a << " = " << findMostSignificantBit(a) << " ref " << ref << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+template<size_t nbits>
+int VerifyWordArray(const std::string& tag, std::mt19937_64& eng, bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportTestResult(VerifyShifts<nbits>(eng, bReportIndividualTestCases), tag, "shift");
+	nrOfFailedTestCases += ReportTestResult(VerifyAddSubtract<nbits>(eng, bReportIndividualTestCases), tag, "add/subtract");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplyDivide<nbits>(eng, bReportIndividualTestCases), tag, "multiply/divide");
+	nrOfFailedTestCases += ReportTestResult(VerifyMostSignificantBit<nbits>(eng, bReportIndividualTestCases), tag, "msb/sticky");
+	return nrOfFailedTestCases;
+}
+
+}} // namespace sw::unum
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::mt19937_64 eng(0x5eed);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += VerifyWordArray<65>("bitblock< 65>", eng, true);
+
+#else
+
+	cout << "Word-array bitblock across word boundaries" << endl;
+
+	nrOfFailedTestCases += VerifyWordArray<  7>("bitblock<  7>", eng, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyWordArray< 63>("bitblock< 63>", eng, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyWordArray< 64>("bitblock< 64>", eng, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyWordArray< 65>("bitblock< 65>", eng, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyWordArray<127>("bitblock<127>", eng, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyWordArray<128>("bitblock<128>", eng, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyWordArray<200>("bitblock<200>", eng, bReportIndividualTestCases);
+
+	// fraction division of a posit<64,3> value
+	{
+		bitblock<61> a, b;
+		a.set(); b.set(); b.reset(3);
+		bitblock<3 * 61> q;
+		divide_with_fraction(a, b, q);
+		// a / b is slightly larger than 1: the hidden bit lands at result_size - operand_size
+		nrOfFailedTestCases += ReportTestResult((findMostSignificantBit(q) == int(3 * 61 - 61) ? 0 : 1), "bitblock<61>", "divide_with_fraction");
+	}
+
+#if STRESS_TESTING
+
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
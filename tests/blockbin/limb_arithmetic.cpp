@@ -0,0 +1,264 @@
+// limb_arithmetic.cpp: functional tests for the multi-precision multiply and divide kernels of blockbinary
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/native/limb_arithmetic.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw { namespace unum {
+
+// operand patterns that stress the carry and borrow chains of the kernels
+enum class LimbPattern { Random, AllOnes, Sparse, TopHeavy };
+
+// n random words of type Word that follow the pattern
+template<typename Word>
+std::vector<Word> RandomWords(std::mt19937_64& eng, size_t n, LimbPattern pattern) {
+	std::vector<Word> a(n);
+	for (size_t i = 0; i < n; ++i) {
+		switch (pattern) {
+		case LimbPattern::Random:
+			a[i] = Word(eng());
+			break;
+		case LimbPattern::AllOnes:
+			a[i] = Word(~Word(0));
+			break;
+		case LimbPattern::Sparse:
+			a[i] = (eng() % 4 == 0) ? Word(eng()) : Word(0);
+			break;
+		case LimbPattern::TopHeavy:
+			a[i] = (eng() % 2 == 0) ? Word(~Word(0)) : Word(eng());
+			break;
+		}
+	}
+	return a;
+}
+
+constexpr LimbPattern limbPatterns[] = { LimbPattern::Random, LimbPattern::AllOnes, LimbPattern::Sparse, LimbPattern::TopHeavy };
+
+// bit-serial long division reference: q[0..m) = u[0..m) / v[0..n), r[0..n) = u[0..m) % v[0..n)
+void ReferenceDivide(uint32_t* q, uint32_t* r, const uint32_t* u, size_t m, const uint32_t* v, size_t n) {
+	std::vector<uint32_t> rem(n + 1, 0);
+	for (size_t i = 0; i < m; ++i) q[i] = 0;
+	for (size_t bit = 32 * m; bit-- > 0; ) {
+		// rem = (rem << 1) | u[bit]
+		uint32_t carry = (u[bit / 32] >> (bit % 32)) & 1u;
+		for (size_t i = 0; i <= n; ++i) {
+			uint32_t msb = rem[i] >> 31;
+			rem[i] = (rem[i] << 1) | carry;
+			carry = msb;
+		}
+		// rem >= v ?
+		bool greaterOrEqual = (rem[n] != 0);
+		if (!greaterOrEqual) {
+			greaterOrEqual = true;
+			for (size_t i = n; i-- > 0; ) {
+				if (rem[i] != v[i]) { greaterOrEqual = (rem[i] > v[i]); break; }
+			}
+		}
+		if (greaterOrEqual) {
+			uint64_t borrow = 0;
+			for (size_t i = 0; i <= n; ++i) {
+				uint64_t d = uint64_t(rem[i]) - (i < n ? v[i] : 0u) - borrow;
+				rem[i] = uint32_t(d);
+				borrow = (d >> 63);
+			}
+			q[bit / 32] |= (1u << (bit % 32));
+		}
+	}
+	for (size_t i = 0; i < n; ++i) r[i] = rem[i];
+}
+
+// Karatsuba multiplication of n limb operands against the schoolbook product
+int VerifyKaratsubaMultiply(std::mt19937_64& eng, size_t n, bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	for (LimbPattern pa : limbPatterns) {
+		for (LimbPattern pb : limbPatterns) {
+			std::vector<uint64_t> a = RandomWords<uint64_t>(eng, n, pa);
+			std::vector<uint64_t> b = RandomWords<uint64_t>(eng, n, pb);
+			std::vector<uint64_t> karatsuba(2 * n), product(2 * n), reference(2 * n);
+			internal::limb_mul_karatsuba(karatsuba.data(), a.data(), b.data(), n);
+			internal::limb_multiply(product.data(), a.data(), n, b.data(), n);
+			internal::limb_mul_schoolbook(reference.data(), a.data(), n, b.data(), n);
+			if (karatsuba != reference || product != reference) {
+				++nrOfFailedTestCases;
+				if (bReportIndividualTestCases) std::cout << "FAIL: Karatsuba multiply of " << n << " limbs, patterns " << int(pa) << " and " << int(pb) << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// truncated multiplication of n limb operands against the lower n limbs of the schoolbook product
+int VerifyTruncatedMultiply(std::mt19937_64& eng, size_t n, bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	for (LimbPattern pa : limbPatterns) {
+		for (LimbPattern pb : limbPatterns) {
+			std::vector<uint64_t> a = RandomWords<uint64_t>(eng, n, pa);
+			std::vector<uint64_t> b = RandomWords<uint64_t>(eng, n, pb);
+			std::vector<uint64_t> truncated(n), lowSchoolbook(n), reference(2 * n);
+			internal::limb_multiply_low(truncated.data(), a.data(), b.data(), n);
+			internal::limb_mul_low_schoolbook(lowSchoolbook.data(), a.data(), b.data(), n);
+			internal::limb_mul_schoolbook(reference.data(), a.data(), n, b.data(), n);
+			reference.resize(n);
+			if (truncated != reference || lowSchoolbook != reference) {
+				++nrOfFailedTestCases;
+				if (bReportIndividualTestCases) std::cout << "FAIL: truncated multiply of " << n << " limbs, patterns " << int(pa) << " and " << int(pb) << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// Knuth D division of one pair of operands against the long division reference
+int VerifyDivision(const std::vector<uint32_t>& u, const std::vector<uint32_t>& v, bool bReportIndividualTestCases) {
+	size_t m = u.size(), n = v.size();
+	std::vector<uint32_t> q(m), r(n), qref(m), rref(n);
+	internal::limb_divide(q.data(), r.data(), u.data(), m, v.data(), n);
+	ReferenceDivide(qref.data(), rref.data(), u.data(), m, v.data(), n);
+	if (q != qref || r != rref) {
+		if (bReportIndividualTestCases) {
+			std::cout << "FAIL: Knuth D division of " << m << " by " << n << " digits:" << std::hex;
+			for (size_t i = m; i-- > 0; ) std::cout << ' ' << std::setw(8) << std::setfill('0') << u[i];
+			std::cout << " /";
+			for (size_t i = n; i-- > 0; ) std::cout << ' ' << std::setw(8) << std::setfill('0') << v[i];
+			std::cout << std::dec << std::setfill(' ') << std::endl;
+		}
+		return 1;
+	}
+	return 0;
+}
+
+// Knuth D division of m digit dividends by n digit divisors
+int VerifyKnuthDivision(std::mt19937_64& eng, size_t m, size_t n, bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	for (LimbPattern pu : limbPatterns) {
+		for (LimbPattern pv : limbPatterns) {
+			std::vector<uint32_t> u = RandomWords<uint32_t>(eng, m, pu);
+			std::vector<uint32_t> v = RandomWords<uint32_t>(eng, n, pv);
+			if (internal::limb_significant(v.data(), n) == 0) v[0] = 1;
+			// vary the normalization shift of the most significant divisor digit from 0 to 31
+			v[n - 1] = (v[n - 1] >> (eng() % 32)) | 1u;
+			nrOfFailedTestCases += VerifyDivision(u, v, bReportIndividualTestCases);
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// divisor normalization and quotient digit correction cases of Knuth D, least significant digit first
+int VerifyDivisionEdgeCases(bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	// the quotient digit estimate is too large and the remainder needs to be added back
+	nrOfFailedTestCases += VerifyDivision({ 3, 0, 0x80000000 }, { 1, 0, 0x20000000 }, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyDivision({ 3, 0, 0x00008000 }, { 1, 0, 0x00002000 }, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyDivision({ 0, 0, 0x80000000, 0x7fffffff }, { 1, 0, 0x80000000 }, bReportIndividualTestCases);
+	// the multiply-subtract quantity does not fit a signed digit
+	nrOfFailedTestCases += VerifyDivision({ 0, 0, 0x00008000, 0x00007fff }, { 1, 0, 0x00008000 }, bReportIndividualTestCases);
+	// the estimate is decremented before the multiply-subtract, and still needs an add back
+	nrOfFailedTestCases += VerifyDivision({ 0, 0x0000fffe, 0, 0x00008000 }, { 0x0000ffff, 0, 0x00008000 }, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyDivision({ 0, 0xfffffffe, 0, 0x80000000 }, { 0xffffffff, 0, 0x80000000 }, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyDivision({ 0, 0xfffffffe, 0, 0x80000000 }, { 0x0000ffff, 0, 0x80000000 }, bReportIndividualTestCases);
+	// the top digits of the running remainder and the divisor are equal: the first estimate is b or larger
+	nrOfFailedTestCases += VerifyDivision({ 0, 0x80000000, 0x80000000 }, { 1, 0x80000000 }, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyDivision({ 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }, bReportIndividualTestCases);
+	// normalization shifts of 0 and 31
+	nrOfFailedTestCases += VerifyDivision({ 0x12345678, 0x9abcdef0, 0xfedcba98, 0x76543210 }, { 0x0f0f0f0f, 0x80000000 }, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyDivision({ 0x12345678, 0x9abcdef0, 0xfedcba98, 0x76543210 }, { 0x0f0f0f0f, 0x00000001 }, bReportIndividualTestCases);
+	// single digit divisors, with the divisor padded by leading zero digits
+	nrOfFailedTestCases += VerifyDivision({ 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0, 0 }, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyDivision({ 0xffffffff, 0xffffffff, 0xffffffff }, { 1, 0 }, bReportIndividualTestCases);
+	// dividends smaller than the divisor, and equal to the divisor
+	nrOfFailedTestCases += VerifyDivision({ 0xffffffff, 0x7fffffff, 0 }, { 0, 0x80000000, 0 }, bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyDivision({ 0x89abcdef, 0x01234567 }, { 0x89abcdef, 0x01234567 }, bReportIndividualTestCases);
+
+	// division by zero is reported
+	std::vector<uint32_t> u = { 1, 2, 3 }, v = { 0, 0 }, q(3), r(2);
+	if (internal::limb_divide(q.data(), r.data(), u.data(), u.size(), v.data(), v.size())) {
+		++nrOfFailedTestCases;
+		if (bReportIndividualTestCases) std::cout << "FAIL: division by zero is not reported" << std::endl;
+	}
+	return nrOfFailedTestCases;
+}
+
+}} // namespace sw::unum
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::mt19937_64 eng(0x5eed);
+
+	// the schoolbook/Karatsuba crossover, and the crossover of the truncated multiply
+	constexpr size_t T = LIMB_KARATSUBA_THRESHOLD;
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyKaratsubaMultiply(eng, T + 1, true), "limbs", "Karatsuba multiply");
+	nrOfFailedTestCases += ReportTestResult(VerifyTruncatedMultiply(eng, 2 * T + 1, true), "limbs", "truncated multiply");
+	nrOfFailedTestCases += ReportTestResult(VerifyDivisionEdgeCases(true), "digits", "Knuth D edge cases");
+
+#else
+
+	cout << "Multi-precision kernel validation" << endl;
+
+	int nrOfFailedKaratsuba = 0;
+	for (size_t n = 1; n <= 3 * T + 2; ++n) nrOfFailedKaratsuba += VerifyKaratsubaMultiply(eng, n, bReportIndividualTestCases);
+	for (size_t n : { 4 * T - 1, 4 * T, 4 * T + 1, 5 * T + 3 }) nrOfFailedKaratsuba += VerifyKaratsubaMultiply(eng, n, bReportIndividualTestCases);
+	nrOfFailedTestCases += ReportTestResult(nrOfFailedKaratsuba, "limbs", "Karatsuba multiply");
+
+	int nrOfFailedTruncated = 0;
+	for (size_t n = 1; n <= 2 * T + 2; ++n) nrOfFailedTruncated += VerifyTruncatedMultiply(eng, n, bReportIndividualTestCases);
+	for (size_t n : { 3 * T - 1, 3 * T, 4 * T - 1, 4 * T, 4 * T + 1, 5 * T + 3 }) nrOfFailedTruncated += VerifyTruncatedMultiply(eng, n, bReportIndividualTestCases);
+	nrOfFailedTestCases += ReportTestResult(nrOfFailedTruncated, "limbs", "truncated multiply");
+
+	int nrOfFailedDivisions = 0;
+	for (size_t m = 1; m <= 12; ++m) {
+		for (size_t n = 1; n <= m + 1; ++n) nrOfFailedDivisions += VerifyKnuthDivision(eng, m, n, bReportIndividualTestCases);
+	}
+	for (size_t n : { 1, 2, 3, 31, 32, 33 }) nrOfFailedDivisions += VerifyKnuthDivision(eng, 64, n, bReportIndividualTestCases);
+	nrOfFailedTestCases += ReportTestResult(nrOfFailedDivisions, "digits", "Knuth D division");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDivisionEdgeCases(bReportIndividualTestCases), "digits", "Knuth D edge cases");
+
+#if STRESS_TESTING
+
+	int nrOfFailedStress = 0;
+	for (size_t n = 3 * T + 3; n <= 16 * T; ++n) nrOfFailedStress += VerifyKaratsubaMultiply(eng, n, bReportIndividualTestCases);
+	for (size_t n = 2 * T + 3; n <= 16 * T; ++n) nrOfFailedStress += VerifyTruncatedMultiply(eng, n, bReportIndividualTestCases);
+	for (size_t m = 13; m <= 64; ++m) {
+		for (size_t n = 1; n <= m + 1; ++n) nrOfFailedStress += VerifyKnuthDivision(eng, m, n, bReportIndividualTestCases);
+	}
+	nrOfFailedTestCases += ReportTestResult(nrOfFailedStress, "limbs", "stress");
+
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
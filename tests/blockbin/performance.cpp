@@ -278,6 +278,70 @@ void TestBlockPerformanceOnMul() {
 
 }
 
+// fill all the blocks of a blockbinary with a nonrepeating bit pattern
+template<size_t nbits, typename bt>
+void FullWidthOperand(sw::unum::blockbinary<nbits, bt>& a, uint64_t seed) {
+	for (size_t i = 0; i < sw::unum::blockbinary<nbits, bt>::nrBlocks; ++i) {
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		a.setblock(i, bt(seed >> 32));
+	}
+}
+
+// workload for multiplication of operands that use all the blocks
+template<size_t nbits, typename bt>
+void FullWidthMultiplicationWorkload(uint64_t NR_OPS) {
+	sw::unum::blockbinary<nbits, bt> a, b, c;
+	FullWidthOperand(a, 0x5eed);
+	FullWidthOperand(b, 0xbeef);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		c = a * b;
+		a.setblock(0, c.block(0));
+	}
+	if (c.iszero()) std::cout << "full width product is zero\n";
+}
+
+// workload for division of a full width dividend by a half width divisor
+template<size_t nbits, typename bt>
+void FullWidthDivisionWorkload(uint64_t NR_OPS) {
+	sw::unum::blockbinary<nbits, bt> a, b, c;
+	FullWidthOperand(a, 0x5eed);
+	FullWidthOperand(b, 0xbeef);
+	b >>= int(nbits / 2);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		c = a / b;
+		a.setblock(0, c.block(0));
+	}
+	if (c.iszero()) std::cout << "full width quotient is zero\n";
+}
+
+// multiply and divide of full width operands: the limb kernels switch to Karatsuba above LIMB_KARATSUBA_THRESHOLD limbs
+void TestBlockPerformanceOnFullWidthMulDiv() {
+	using namespace std;
+	cout << endl << "full width multiply and divide performance, Karatsuba threshold " << LIMB_KARATSUBA_THRESHOLD << " limbs" << endl;
+
+	size_t NR_OPS = 100000;
+	PerformanceRunner("blockbinary<256,uint8>    mul   ", FullWidthMultiplicationWorkload<256, uint8_t>, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint16>   mul   ", FullWidthMultiplicationWorkload<256, uint16_t>, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint32>   mul   ", FullWidthMultiplicationWorkload<256, uint32_t>, NR_OPS);
+	PerformanceRunner("blockbinary<1024,uint8>   mul   ", FullWidthMultiplicationWorkload<1024, uint8_t>, NR_OPS / 4);
+	PerformanceRunner("blockbinary<1024,uint16>  mul   ", FullWidthMultiplicationWorkload<1024, uint16_t>, NR_OPS / 4);
+	PerformanceRunner("blockbinary<1024,uint32>  mul   ", FullWidthMultiplicationWorkload<1024, uint32_t>, NR_OPS / 4);
+	PerformanceRunner("blockbinary<4096,uint8>   mul   ", FullWidthMultiplicationWorkload<4096, uint8_t>, NR_OPS / 32);
+	PerformanceRunner("blockbinary<4096,uint16>  mul   ", FullWidthMultiplicationWorkload<4096, uint16_t>, NR_OPS / 32);
+	PerformanceRunner("blockbinary<4096,uint32>  mul   ", FullWidthMultiplicationWorkload<4096, uint32_t>, NR_OPS / 32);
+	PerformanceRunner("blockbinary<16384,uint32> mul   ", FullWidthMultiplicationWorkload<16384, uint32_t>, NR_OPS / 256);
+
+	PerformanceRunner("blockbinary<256,uint8>    div   ", FullWidthDivisionWorkload<256, uint8_t>, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint16>   div   ", FullWidthDivisionWorkload<256, uint16_t>, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint32>   div   ", FullWidthDivisionWorkload<256, uint32_t>, NR_OPS);
+	PerformanceRunner("blockbinary<1024,uint8>   div   ", FullWidthDivisionWorkload<1024, uint8_t>, NR_OPS / 4);
+	PerformanceRunner("blockbinary<1024,uint16>  div   ", FullWidthDivisionWorkload<1024, uint16_t>, NR_OPS / 4);
+	PerformanceRunner("blockbinary<1024,uint32>  div   ", FullWidthDivisionWorkload<1024, uint32_t>, NR_OPS / 4);
+	PerformanceRunner("blockbinary<4096,uint8>   div   ", FullWidthDivisionWorkload<4096, uint8_t>, NR_OPS / 32);
+	PerformanceRunner("blockbinary<4096,uint16>  div   ", FullWidthDivisionWorkload<4096, uint16_t>, NR_OPS / 32);
+	PerformanceRunner("blockbinary<4096,uint32>  div   ", FullWidthDivisionWorkload<4096, uint32_t>, NR_OPS / 32);
+}
+
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
@@ -311,6 +375,7 @@ try {
 	TestBlockPerformanceOnMul();
 	TestBlockPerformanceOnDiv();
 	TestBlockPerformanceOnRem();
+	TestBlockPerformanceOnFullWidthMulDiv();
 
 #if STRESS_TESTING
 
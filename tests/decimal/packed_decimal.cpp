@@ -0,0 +1,163 @@
+//  packed_decimal.cpp : test suite for abitrary precision decimal integers with multi-digit limbs
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <random>
+#include <string>
+// configure the decimal integer arithmetic class
+#define DECIMAL_THROW_ARITHMETIC_EXCEPTION 1
+#include <universal/decimal/decimal>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// exhaustive arithmetic on [-ub, ub] against native long arithmetic
+template<typename Limb>
+int VerifyNativeArithmetic(long ub, bool bReportIndividualTestCases) {
+	using Decimal = sw::unum::packed_decimal<Limb>;
+	int nrOfFailedTests = 0;
+	for (long i = -ub; i <= ub; ++i) {
+		Decimal a = i;
+		for (long j = -ub; j <= ub; ++j) {
+			Decimal b = j;
+			bool fail = (a + b) != i + j || (a - b) != i - j || (a * b) != i * j || (a < b) != (i < j) || (a == b) != (i == j);
+			if (j != 0) fail = fail || (a / b) != i / j || (a % b) != i % j;
+			if (fail) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " and " << b << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// a random decimal string of up to nrDigits digits, without leading zeros
+std::string RandomDigits(std::mt19937_64& eng, size_t nrDigits) {
+	size_t n = 1 + eng() % nrDigits;
+	std::string digits = (eng() & 1) ? "-" : "";
+	digits.push_back(char('1' + eng() % 9));
+	for (size_t i = 1; i < n; ++i) digits.push_back(char('0' + eng() % 10));
+	return digits;
+}
+
+// products against the digit per byte decimal, and the division identity a = q * b + r with |r| < |b|
+template<typename Limb>
+int VerifyRandomArithmetic(size_t nrDigits, int nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	using Decimal = packed_decimal<Limb>;
+	std::mt19937_64 eng(nrDigits);
+	int nrOfFailedTests = 0;
+	for (int t = 0; t < nrOfRandoms; ++t) {
+		decimal da, db;
+		da.parse(RandomDigits(eng, nrDigits));
+		db.parse(RandomDigits(eng, nrDigits));
+		Decimal a(da), b(db);
+		bool fail = to_string(a) != to_string(da) || decimal(a) != da;
+		fail = fail || decimal(a * b) != da * db || decimal(a + b) != da + db || decimal(a - b) != da - db;
+		if (!b.iszero()) {
+			Decimal q = a / b, r = a % b;
+			Decimal absr = r.isneg() ? -r : r, absb = b.isneg() ? -b : b;
+			fail = fail || q * b + r != a || absr >= absb || (!r.iszero() && r.sign() != a.sign());
+		}
+		if (fail) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " and " << b << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Karatsuba products and long divisions of operands of many limbs
+template<typename Limb>
+int VerifyLongOperands(size_t nrDigits, int nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	using Decimal = packed_decimal<Limb>;
+	std::mt19937_64 eng(nrDigits);
+	int nrOfFailedTests = 0;
+	for (int t = 0; t < nrOfRandoms; ++t) {
+		Decimal a(RandomDigits(eng, nrDigits)), b(RandomDigits(eng, nrDigits)), c(RandomDigits(eng, nrDigits / 3));
+		if (b.iszero() || c.iszero()) continue;
+		Decimal p = a * b;
+		// (a + c) * b == a * b + c * b, with the mixed lengths in the chunked product
+		bool fail = (a + c) * b != p + c * b || p / b != a || !(p % b).iszero();
+		Decimal q = (p + c) / b, r = (p + c) % b;
+		fail = fail || q * b + r != p + c;
+		if (fail) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " and " << b << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main()
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+#if MANUAL_TESTING
+
+	packed_decimal<uint32_t> a("123456789012345678901234567890"), b("-987654321");
+	cout << a << " * " << b << " = " << a * b << endl;
+	cout << a << " / " << b << " = " << a / b << endl;
+	cout << a << " % " << b << " = " << a % b << endl;
+
+#else
+
+	cout << "packed decimal arithmetic validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<uint32_t>(100, bReportIndividualTestCases), "packed_decimal<uint32_t>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<uint64_t>(100, bReportIndividualTestCases), "packed_decimal<uint64_t>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomArithmetic<uint32_t>(60, 1000, bReportIndividualTestCases), "packed_decimal<uint32_t>", "random arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomArithmetic<uint64_t>(60, 1000, bReportIndividualTestCases), "packed_decimal<uint64_t>", "random arithmetic");
+	// Karatsuba above DECIMAL_KARATSUBA_THRESHOLD limbs
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomArithmetic<uint32_t>(1000, 20, bReportIndividualTestCases), "packed_decimal<uint32_t>", "long arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyLongOperands<uint32_t>(3000, 20, bReportIndividualTestCases), "packed_decimal<uint32_t>", "long operands");
+	nrOfFailedTestCases += ReportTestResult(VerifyLongOperands<uint64_t>(3000, 20, bReportIndividualTestCases), "packed_decimal<uint64_t>", "long operands");
+
+	// boundary values, increments across limbs, and the interoperation with native types
+	{
+		int nrOfFailures = 0;
+		packed_decimal<uint32_t> a(numeric_limits<long long>::min()), b;
+		if (static_cast<long long>(a) != numeric_limits<long long>::min() || to_string(a) != "-9223372036854775808") ++nrOfFailures;
+		b.parse("999999999999999999");
+		if (to_string(++b) != "1000000000000000000" || to_string(--b) != "999999999999999999") ++nrOfFailures;
+		b = -1;
+		if (!(++b).iszero() || b.isneg() || (--b) != -1) ++nrOfFailures;
+		if (b.parse("12a") || b.parse("") || !b.parse(" +007 ") || b != 7 || to_string(-b) != "-7") ++nrOfFailures;
+		try {
+			b = a / packed_decimal<uint32_t>(0);
+			++nrOfFailures;
+		}
+		catch (const decimal_integer_divide_by_zero&) {}
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "packed_decimal<uint32_t>", "boundary values");
+	}
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyLongOperands<uint32_t>(100000, 5, bReportIndividualTestCases), "packed_decimal<uint32_t>", "long operands");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
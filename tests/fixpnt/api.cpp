@@ -190,13 +190,37 @@ try {
 	////////////////////////////////////////////////////////////////////////////////////
 	// parsing of text input
 	{
-		/* TODO: implement parse
+		int start = nrOfFailedTestCases;
 		constexpr size_t nbits = 128;
 		constexpr size_t rbits = 64;
-		fixpnt<nbits, rbits, Modulo, uint32_t> a, b, c, d;
+		fixpnt<nbits, rbits, Modulo, uint32_t> a, b, c;
 		a.assign("123456789.987654321");
 		parse("123456789.987654321", b);
-		*/
+		if (a != b) ++nrOfFailedTestCases;
+		// the decimal string is exact, and parses back to the same value
+		std::string str = convert_to_decimal_string(a);
+		if (str.substr(0, 30) != "123456789.98765432100000000002") ++nrOfFailedTestCases;
+		parse(str, c);
+		if (c != a) ++nrOfFailedTestCases;
+		parse("-" + str, c);
+		if (c != -a) ++nrOfFailedTestCases;
+		// the fraction rounds to nearest, ties to even
+		fixpnt<8, 4> d;
+		parse("0.03125", d);
+		if (d != 0) ++nrOfFailedTestCases;
+		parse("0.09375", d);
+		if (d != fixpnt<8, 4>(0.125)) ++nrOfFailedTestCases;
+		parse("0.0312500001", d);
+		if (d != fixpnt<8, 4>(0.0625)) ++nrOfFailedTestCases;
+		// the integer part saturates with saturating arithmetic
+		fixpnt<8, 4, Saturating> e, saturated;
+		parse("100", e);
+		if (e != maxpos(saturated)) ++nrOfFailedTestCases;
+		parse("-8.01", e);
+		if (e != maxneg(saturated)) ++nrOfFailedTestCases;
+		if (nrOfFailedTestCases - start > 0) {
+			cout << "FAIL : parse\n";
+		}
 	}
 
 	///////////////////////////////////////////////////////////////////////////////////
@@ -175,6 +175,8 @@ try {
 	using namespace std;
 	using namespace sw::unum;
 
+	if (!ParseVerificationArguments(argc, argv)) return EXIT_FAILURE;
+
 	bool bReportIndividualTestCases = true;
 	int nrOfFailedTestCases = 0;
 
@@ -228,6 +228,8 @@ try {
 	using namespace std;
 	using namespace sw::unum;
 
+	if (!ParseVerificationArguments(argc, argv)) return EXIT_FAILURE;
+
 	int nrOfFailedTestCases = 0;
 
 	std::string tag = "modular division: ";
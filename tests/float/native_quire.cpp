@@ -0,0 +1,171 @@
+//  native_quire.cpp : test suite for the limb-based Kulisch accumulator of IEEE float and double
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include "universal/float/native_quire.hpp"
+
+template<typename Real>
+bool identical(Real a, Real b) {
+	return (std::isnan(a) && std::isnan(b)) || (a == b && std::signbit(a) == std::signbit(b));
+}
+
+// special values follow IEEE-754 addition and multiplication
+template<typename Real>
+int VerifySpecialValues(const std::string& tag) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	const Real inf = std::numeric_limits<Real>::infinity(), nan = std::numeric_limits<Real>::quiet_NaN();
+	native_quire<Real> q;
+	if (!q.iszero() || !identical(q.to_native(), Real(0))) ++nrOfFailedTests;
+	q += Real(1);
+	q += inf;
+	if (!identical(q.to_native(), inf)) ++nrOfFailedTests;
+	q -= inf;
+	if (!std::isnan(q.to_native())) ++nrOfFailedTests;
+	q.reset();
+	q += quire_mul(-inf, Real(2));
+	if (!identical(q.to_native(), -inf)) ++nrOfFailedTests;
+	q.reset();
+	q += quire_mul(inf, Real(0));
+	if (!std::isnan(q.to_native())) ++nrOfFailedTests;
+	q.reset();
+	q += nan;
+	if (!std::isnan(q.to_native())) ++nrOfFailedTests;
+	// overflow of the rounded sum
+	q.reset();
+	q += std::numeric_limits<Real>::max();
+	q += std::numeric_limits<Real>::max();
+	if (!identical(q.to_native(), inf)) ++nrOfFailedTests;
+	q -= quire_mul(std::numeric_limits<Real>::max(), Real(4));
+	if (!identical(q.to_native(), -inf)) ++nrOfFailedTests;
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+// rounding to nearest, ties to even, for normal and subnormal results
+template<typename Real>
+int VerifyRounding(const std::string& tag) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	const int digits = std::numeric_limits<Real>::digits;
+	const Real ulp = std::ldexp(Real(1), 1 - digits);  // ulp of 1
+	const Real tiny = std::numeric_limits<Real>::denorm_min();
+
+	native_quire<Real> q;
+	// 1 + ulp/2 is a tie that rounds to even 1, 1 + 3ulp/2 rounds to 1 + 2ulp
+	q = native_quire<Real>(Real(1));
+	q += ulp / 2;
+	if (!identical(q.to_native(), Real(1))) ++nrOfFailedTests;
+	q += ulp;
+	if (!identical(q.to_native(), Real(1) + 2 * ulp)) ++nrOfFailedTests;
+	// a tiny excess above the tie rounds up
+	q = native_quire<Real>(Real(1));
+	q += ulp / 2;
+	q += quire_mul(tiny, tiny);
+	if (!identical(q.to_native(), Real(1) + ulp)) ++nrOfFailedTests;
+	// and a tiny deficit below the tie rounds down
+	q = native_quire<Real>(Real(1));
+	q += ulp / 2;
+	q -= quire_mul(tiny, tiny);
+	if (!identical(q.to_native(), Real(1))) ++nrOfFailedTests;
+
+	// products of subnormals: tiny*tiny is far below the smallest subnormal
+	q.reset();
+	q += quire_mul(tiny, tiny);
+	if (!identical(q.to_native(), Real(0))) ++nrOfFailedTests;
+	q.reset();
+	q -= quire_mul(tiny, tiny);
+	if (!identical(q.to_native(), -Real(0))) ++nrOfFailedTests;
+	// half the smallest subnormal is a tie to even zero, three halves round to two
+	q.reset();
+	q += quire_mul(tiny, Real(0.5));
+	if (!identical(q.to_native(), Real(0))) ++nrOfFailedTests;
+	q += quire_mul(tiny, Real(1));
+	if (!identical(q.to_native(), 2 * tiny)) ++nrOfFailedTests;
+	// subnormal sums are exact
+	q.reset();
+	q += std::numeric_limits<Real>::min();
+	q -= tiny;
+	if (!identical(q.to_native(), std::numeric_limits<Real>::min() - tiny)) ++nrOfFailedTests;
+
+	// the products of random values are exact: compare to the product rounded once
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<Real> dist(-1, 1);
+	for (int i = 0; i < 10000; ++i) {
+		Real a = dist(eng), b = dist(eng);
+		q.reset();
+		q += quire_mul(a, b);
+		if (!identical(q.to_native(), a * b)) { ++nrOfFailedTests; break; }
+	}
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+// merging accumulators is exact
+template<typename Real>
+int VerifyMerge(const std::string& tag) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<Real> mantissa(-1, 1);
+	std::uniform_int_distribution<int> scale(std::numeric_limits<Real>::min_exponent / 2, std::numeric_limits<Real>::max_exponent / 2);
+	native_quire<Real> all, part[3];
+	for (int i = 0; i < 30000; ++i) {
+		Real a = std::ldexp(mantissa(eng), scale(eng)), b = std::ldexp(mantissa(eng), scale(eng));
+		all += quire_mul(a, b);
+		part[i % 3] += quire_mul(a, b);
+	}
+	native_quire<Real> merged;
+	merged += part[2];
+	merged += part[0];
+	merged += part[1];
+	if (!identical(merged.to_native(), all.to_native())) ++nrOfFailedTests;
+	// the exact sum of the terms and their negations is zero
+	native_quire<Real> q = all;
+	std::mt19937_64 replay(0x5eed);
+	for (int i = 0; i < 30000; ++i) {
+		Real a = std::ldexp(mantissa(replay), scale(replay)), b = std::ldexp(mantissa(replay), scale(replay));
+		q -= quire_mul(a, b);
+	}
+	if (!q.iszero()) ++nrOfFailedTests;
+
+	std::cout << tag << (nrOfFailedTests ? " FAIL" : " PASS") << std::endl;
+	return nrOfFailedTests;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "native IEEE quire verification" << endl;
+
+	nrOfFailedTestCases += VerifySpecialValues<float>("special values float  ");
+	nrOfFailedTestCases += VerifySpecialValues<double>("special values double ");
+	nrOfFailedTestCases += VerifyRounding<float>("rounding float        ");
+	nrOfFailedTestCases += VerifyRounding<double>("rounding double       ");
+	nrOfFailedTestCases += VerifyMerge<float>("merge float           ");
+	nrOfFailedTestCases += VerifyMerge<double>("merge double          ");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
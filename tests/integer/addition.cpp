@@ -59,11 +59,13 @@ std::string convert_to_string(const std::vector<char>& v) {
 	return ss.str();
 }
 
-int main()
+int main(int argc, char** argv)
 try {
 	using namespace std;
 	using namespace sw::unum;
 
+	if (!ParseVerificationArguments(argc, argv)) return EXIT_FAILURE;
+
 	std::string tag = "Integer Arithmetic tests failed";
 
 #if MANUAL_TESTING
@@ -0,0 +1,124 @@
+// decimal_conversion.cpp: tests of the conversions between integers and decimal strings
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal number project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <random>
+#include <string>
+#include <universal/integer/integer>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// the reference: the decimal string by doubling and adding a digit per byte decimal
+template<size_t nbits, typename BlockType>
+std::string ReferenceDecimalString(const sw::unum::integer<nbits, BlockType>& value) {
+	sw::unum::integer<nbits, BlockType> magnitude = value.sign() ? twos_complement(value) : value;
+	sw::unum::impl::decimal partial, multiplier;
+	partial.push_back(0); partial.sign = false;
+	multiplier.push_back(1); multiplier.sign = false;
+	for (unsigned i = 0; i < nbits; ++i) {
+		if (magnitude.at(i)) sw::unum::impl::add(partial, multiplier);
+		sw::unum::impl::add(multiplier, multiplier);
+	}
+	std::string str = value.sign() ? "-" : "";
+	for (auto rit = partial.rbegin(); rit != partial.rend(); ++rit) str.push_back(char('0' + *rit));
+	return str;
+}
+
+// decimal strings against the reference, and the round trip through parse, of random integers of random length
+template<size_t nbits, typename BlockType>
+int VerifyDecimalConversion(int nrOfRandoms, bool bReportIndividualTestCases) {
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	std::mt19937_64 eng(nbits);
+	int nrOfFailedTestCases = 0;
+	for (int t = 0; t < nrOfRandoms; ++t) {
+		Integer a(0), b;
+		unsigned bits = unsigned(eng() % nbits) + 1;
+		for (unsigned i = 0; i < bits; ++i) a.set(i, eng() & 1);
+		if (t == 0) a.setzero();
+		if (t == 1) { a.setzero(); a.set(nbits - 1, true); }  // maxneg
+		std::string str = convert_to_decimal_string(a);
+		parse(str, b);
+		if (str != ReferenceDecimalString(a) || b != a) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << str << " != " << ReferenceDecimalString(a) << " or parsed as " << b << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main()
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+#if MANUAL_TESTING
+
+	integer<256, uint32_t> a;
+	parse("-123456789012345678901234567890123456789012345678901234567890", a);
+	char buffer[max_decimal_chars<256, uint32_t>()];
+	char* end = to_decimal_chars(buffer, buffer + sizeof(buffer), a);
+	cout << string(buffer, end) << endl;
+	cout << ReferenceDecimalString(a) << endl;
+
+#else // MANUAL_TESTING
+
+	cout << "Decimal conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimalConversion<8, uint8_t>(256, bReportIndividualTestCases), "integer<8>", "decimal conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimalConversion<64, uint8_t>(1000, bReportIndividualTestCases), "integer<64>", "decimal conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimalConversion<100, uint16_t>(500, bReportIndividualTestCases), "integer<100>", "decimal conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimalConversion<256, uint32_t>(500, bReportIndividualTestCases), "integer<256>", "decimal conversion");
+	// the divide-and-conquer conversions above LIMB_RADIX_DC_THRESHOLD limbs
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimalConversion<2048, uint32_t>(50, bReportIndividualTestCases), "integer<2048>", "decimal conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimalConversion<4096, uint32_t>(20, bReportIndividualTestCases), "integer<4096>", "decimal conversion");
+
+	// buffers that are too small, signs, and decimal strings that wrap modulo 2^nbits
+	{
+		int nrOfFailures = 0;
+		integer<64, uint32_t> a(-1234567890123456789ll), b;
+		char buffer[max_decimal_chars<64, uint32_t>()];
+		if (to_decimal_chars(buffer, buffer + 19, a) != nullptr) ++nrOfFailures;
+		char* end = to_decimal_chars(buffer, buffer + 20, a);
+		if (end == nullptr || string(buffer, end) != "-1234567890123456789") ++nrOfFailures;
+		const char* txt = "+42 apples";
+		if (from_decimal_chars(txt, txt + 10, b) != txt + 3 || b != 42) ++nrOfFailures;
+		if (from_decimal_chars(txt + 4, txt + 10, b) != txt + 4) ++nrOfFailures;
+		parse("+-123", b);
+		if (b != -123) ++nrOfFailures;
+		parse("18446744073709551617", b);  // 2^64 + 1
+		if (b != 1) ++nrOfFailures;
+		integer<128, uint32_t> c;
+		parse(string(400, '9'), c);  // 10^400 - 1 is -1 modulo 2^128
+		if (c != -1) ++nrOfFailures;
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "integer<64>", "decimal buffers and wrapping");
+	}
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimalConversion<16384, uint32_t>(10, bReportIndividualTestCases), "integer<16384>", "decimal conversion");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (std::runtime_error& err) {
+	std::cerr << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
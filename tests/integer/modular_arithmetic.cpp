@@ -0,0 +1,128 @@
+// modular_arithmetic.cpp: tests of the Montgomery and Barrett modular arithmetic on arbitrary precision integers
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal number project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <random>
+#include <vector>
+#include <universal/integer/integer>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// a random nonnegative integer of a number of bits
+template<size_t nbits, typename BlockType>
+sw::unum::integer<nbits, BlockType> RandomInteger(std::mt19937_64& eng, unsigned bits) {
+	sw::unum::integer<nbits, BlockType> a(0);
+	for (unsigned i = 0; i < bits; ++i) a.set(i, eng() & 1);
+	return a;
+}
+
+// (a * b) mod m with a double width product and a remainder
+template<size_t nbits, typename BlockType>
+sw::unum::integer<nbits, BlockType> ReferenceMulmod(const sw::unum::integer<nbits, BlockType>& a, const sw::unum::integer<nbits, BlockType>& b, const sw::unum::integer<nbits, BlockType>& m) {
+	using Wide = sw::unum::integer<2 * nbits, BlockType>;
+	sw::unum::integer<nbits, BlockType> r;
+	r.bitcopy((Wide(a) * Wide(b)) % Wide(m));
+	return r;
+}
+
+// mulmod, powmod, the batch powmod, and invmod against square and multiply with the reference products,
+// for odd moduli, which take the Montgomery path, and even moduli, which take the Barrett path
+template<size_t nbits, typename BlockType>
+int VerifyModularArithmetic(unsigned bits, bool bReportIndividualTestCases) {
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	std::mt19937_64 eng(bits);
+	int nrOfFailedTestCases = 0;
+	for (int t = 0; t < 100; ++t) {
+		Integer m = RandomInteger<nbits, BlockType>(eng, bits);
+		m.set(0, (t & 1) == 0);
+		m.set(bits - 1, true);
+		sw::unum::modular_context<Integer> ctx(m);
+		Integer a = RandomInteger<nbits, BlockType>(eng, bits) % m, b = RandomInteger<nbits, BlockType>(eng, bits) % m;
+		Integer e = RandomInteger<nbits, BlockType>(eng, nbits < 81 ? nbits / 2 : 80);
+		Integer product = ctx.mulmod(a, b);
+		Integer power(1);
+		for (int i = findMsb(e); i >= 0; --i) {
+			power = ReferenceMulmod(power, power, m);
+			if (e.at(unsigned(i))) power = ReferenceMulmod(power, a, m);
+		}
+		std::vector<Integer> bases = { a, b, a + 1, b + 2, Integer(2) }, exponents = { e, e + 1, Integer(0), Integer(65537), e * e }, results;
+		ctx.powmod(bases, exponents, results);
+		int batchFailures = 0;
+		for (size_t i = 0; i < bases.size(); ++i) if (results[i] != ctx.powmod(bases[i], exponents[i])) ++batchFailures;
+		Integer inverse = ctx.invmod(a);
+		bool bInverse = sw::unum::gcd(a, m).isone() ? (ctx.mulmod(inverse, a) == 1) : inverse.iszero();
+		if (product != ReferenceMulmod(a, b, m) || ctx.powmod(a, e) != power || batchFailures || !bInverse) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: modulus " << m << " a " << a << " b " << b << " exponent " << e << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main()
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+#if MANUAL_TESTING
+
+	using Integer = integer<128, uint32_t>;
+	Integer m = 1000000007, a = 123456789, b = 987654321;
+	modular_context<Integer> ctx(m);
+	cout << a << " * " << b << " mod " << m << " = " << ctx.mulmod(a, b) << endl;
+	cout << a << " ^ " << b << " mod " << m << " = " << ctx.powmod(a, b) << endl;
+	cout << a << " ^ -1 mod " << m << " = " << ctx.invmod(a) << endl;
+
+#else // MANUAL_TESTING
+
+	cout << "Modular arithmetic validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<64, uint8_t>(40, bReportIndividualTestCases), "integer<64>", "modular arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<128, uint32_t>(127, bReportIndividualTestCases), "integer<128>", "modular arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<256, uint32_t>(200, bReportIndividualTestCases), "integer<256>", "modular arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<512, uint32_t>(511, bReportIndividualTestCases), "integer<512>", "modular arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<1024, uint32_t>(1000, bReportIndividualTestCases), "integer<1024>", "modular arithmetic");
+
+	// the convenience functions, and the degenerate modulus 1
+	{
+		using Integer = integer<128, uint32_t>;
+		Integer m(1000000007);
+		int nrOfFailures = 0;
+		if (powmod(Integer(2), m - 1, m) != 1) ++nrOfFailures;  // Fermat's little theorem
+		if (mulmod(invmod(Integer(3), m), Integer(3), m) != 1) ++nrOfFailures;
+		if (powmod(Integer(3), Integer(-1), m) != invmod(Integer(3), m)) ++nrOfFailures;
+		if (mulmod(Integer(-5), Integer(7), m) != m - 35) ++nrOfFailures;
+		if (!powmod(Integer(12345), Integer(678), Integer(1)).iszero()) ++nrOfFailures;
+		if (!invmod(Integer(6), Integer(9)).iszero()) ++nrOfFailures;
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "integer<128>", "mulmod/powmod/invmod");
+	}
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<2048, uint32_t>(2047, bReportIndividualTestCases), "integer<2048>", "modular arithmetic");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (std::runtime_error& err) {
+	std::cerr << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
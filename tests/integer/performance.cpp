@@ -6,10 +6,13 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <random>
+#include <vector>
 // configure the integer arithmetic class
 #define INTEGER_THROW_ARITHMETIC_EXCEPTION 0
 #include <universal/integer/integer.hpp>
 #include <universal/integer/numeric_limits.hpp>
+#include <universal/integer/modular_arithmetic.hpp>
 // is representable
 #include <universal/functions/isrepresentable.hpp>
 // test helpers, such as, ReportTestResults
@@ -132,6 +135,186 @@ void TestArithmeticOperatorPerformance() {
 	PerformanceRunner("integer<1024> multiplication", MultiplicationWorkload< sw::unum::integer<1024> >, NR_OPS / 32);
 }
 
+// an odd modulus of nbits - 1 bits and two residues below it
+template<size_t nbits>
+void ModularOperands(sw::unum::integer<nbits, uint32_t>& m, sw::unum::integer<nbits, uint32_t>& a, sw::unum::integer<nbits, uint32_t>& b) {
+	std::mt19937_64 eng(nbits);
+	m = a = b = 0;
+	for (unsigned i = 0; i < nbits - 1; ++i) {
+		m.set(i, eng() & 1);
+		a.set(i, eng() & 1);
+		b.set(i, eng() & 1);
+	}
+	m.set(0, true);
+	m.set(nbits - 2, true);
+	a = a % m;
+	b = b % m;
+}
+
+// the reference: a double width product and a remainder
+template<size_t nbits>
+void NaiveModularMultiplicationWorkload(uint64_t NR_OPS) {
+	using Wide = sw::unum::integer<2 * nbits, uint32_t>;
+	sw::unum::integer<nbits, uint32_t> m, a, b;
+	ModularOperands(m, a, b);
+	Wide M(m);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		a.bitcopy((Wide(a) * Wide(b)) % M);
+	}
+}
+
+template<size_t nbits>
+void ModularMultiplicationWorkload(uint64_t NR_OPS) {
+	sw::unum::integer<nbits, uint32_t> m, a, b;
+	ModularOperands(m, a, b);
+	sw::unum::modular_context< sw::unum::integer<nbits, uint32_t> > ctx(m);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		a = ctx.mulmod(a, b);
+	}
+}
+
+// products of residues in Montgomery representation, which skip the conversions of mulmod
+template<size_t nbits>
+void MontgomeryMultiplicationWorkload(uint64_t NR_OPS) {
+	sw::unum::integer<nbits, uint32_t> m, a, b;
+	ModularOperands(m, a, b);
+	sw::unum::modular_context< sw::unum::integer<nbits, uint32_t> > ctx(m);
+	auto x = ctx.to_residue(a), y = ctx.to_residue(b);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		x = ctx.mul(x, y);
+	}
+	a = ctx.to_integer(x);
+}
+
+// the reference: square and multiply with double width products and remainders, of an nbits - 1 bit exponent
+template<size_t nbits>
+void NaiveModularExponentiationWorkload(uint64_t NR_OPS) {
+	using Wide = sw::unum::integer<2 * nbits, uint32_t>;
+	sw::unum::integer<nbits, uint32_t> m, a, e, r;
+	ModularOperands(m, a, e);
+	Wide M(m);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		r = 1;
+		for (int bit = findMsb(e); bit >= 0; --bit) {
+			r.bitcopy((Wide(r) * Wide(r)) % M);
+			if (e.at(unsigned(bit))) r.bitcopy((Wide(r) * Wide(a)) % M);
+		}
+		a = r;
+	}
+}
+
+template<size_t nbits>
+void ModularExponentiationWorkload(uint64_t NR_OPS) {
+	sw::unum::integer<nbits, uint32_t> m, a, e;
+	ModularOperands(m, a, e);
+	sw::unum::modular_context< sw::unum::integer<nbits, uint32_t> > ctx(m);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		a = ctx.powmod(a, e);
+	}
+}
+
+// NR_OPS independent exponentiations, interleaved by the batch mode
+template<size_t nbits>
+void BatchModularExponentiationWorkload(uint64_t NR_OPS) {
+	sw::unum::integer<nbits, uint32_t> m, a, e;
+	ModularOperands(m, a, e);
+	sw::unum::modular_context< sw::unum::integer<nbits, uint32_t> > ctx(m);
+	std::vector< sw::unum::integer<nbits, uint32_t> > bases(NR_OPS), results;
+	for (uint64_t i = 0; i < NR_OPS; ++i) bases[i] = a + sw::unum::integer<nbits, uint32_t>((long long)i);
+	ctx.powmod(bases, e, results);
+}
+
+void TestModularArithmeticPerformance() {
+	using namespace std;
+	cout << endl << "Modular arithmetic performance" << endl;
+
+	uint64_t NR_OPS = 1024 * 8;
+	PerformanceRunner("integer<512>  (a*b)%m       ", NaiveModularMultiplicationWorkload<512>, NR_OPS);
+	PerformanceRunner("integer<512>  mulmod        ", ModularMultiplicationWorkload<512>, NR_OPS * 4);
+	PerformanceRunner("integer<512>  montgomery mul", MontgomeryMultiplicationWorkload<512>, NR_OPS * 16);
+	PerformanceRunner("integer<1024> (a*b)%m       ", NaiveModularMultiplicationWorkload<1024>, NR_OPS / 2);
+	PerformanceRunner("integer<1024> mulmod        ", ModularMultiplicationWorkload<1024>, NR_OPS * 2);
+	PerformanceRunner("integer<1024> montgomery mul", MontgomeryMultiplicationWorkload<1024>, NR_OPS * 8);
+	PerformanceRunner("integer<2048> (a*b)%m       ", NaiveModularMultiplicationWorkload<2048>, NR_OPS / 4);
+	PerformanceRunner("integer<2048> mulmod        ", ModularMultiplicationWorkload<2048>, NR_OPS);
+	PerformanceRunner("integer<2048> montgomery mul", MontgomeryMultiplicationWorkload<2048>, NR_OPS * 2);
+
+	NR_OPS = 16;
+	PerformanceRunner("integer<512>  naive powmod  ", NaiveModularExponentiationWorkload<512>, NR_OPS);
+	PerformanceRunner("integer<512>  powmod        ", ModularExponentiationWorkload<512>, NR_OPS * 16);
+	PerformanceRunner("integer<512>  batch powmod  ", BatchModularExponentiationWorkload<512>, NR_OPS * 16);
+	PerformanceRunner("integer<1024> naive powmod  ", NaiveModularExponentiationWorkload<1024>, NR_OPS / 4);
+	PerformanceRunner("integer<1024> powmod        ", ModularExponentiationWorkload<1024>, NR_OPS * 4);
+	PerformanceRunner("integer<1024> batch powmod  ", BatchModularExponentiationWorkload<1024>, NR_OPS * 4);
+	PerformanceRunner("integer<2048> powmod        ", ModularExponentiationWorkload<2048>, NR_OPS);
+	PerformanceRunner("integer<2048> batch powmod  ", BatchModularExponentiationWorkload<2048>, NR_OPS);
+}
+
+// the reference: the decimal string by doubling and adding a digit per byte decimal
+template<size_t nbits>
+std::string ReferenceDecimalString(const sw::unum::integer<nbits, uint32_t>& value) {
+	sw::unum::impl::decimal partial, multiplier;
+	partial.push_back(0); partial.sign = false;
+	multiplier.push_back(1); multiplier.sign = false;
+	for (unsigned i = 0; i < nbits; ++i) {
+		if (value.at(i)) sw::unum::impl::add(partial, multiplier);
+		sw::unum::impl::add(multiplier, multiplier);
+	}
+	std::string str;
+	for (auto rit = partial.rbegin(); rit != partial.rend(); ++rit) str.push_back(char('0' + *rit));
+	return str;
+}
+
+// a positive integer of nbits - 1 random bits
+template<size_t nbits>
+sw::unum::integer<nbits, uint32_t> DecimalOperand() {
+	std::mt19937_64 eng(nbits);
+	sw::unum::integer<nbits, uint32_t> a(0);
+	for (unsigned i = 0; i < nbits - 1; ++i) a.set(i, eng() & 1);
+	return a;
+}
+
+template<size_t nbits>
+void NaiveDecimalStringWorkload(uint64_t NR_OPS) {
+	sw::unum::integer<nbits, uint32_t> a = DecimalOperand<nbits>();
+	size_t length = 0;
+	for (uint64_t i = 0; i < NR_OPS; ++i) length += ReferenceDecimalString(a).size();
+	if (length == 0) std::cout << "unexpected empty string" << std::endl;
+}
+
+template<size_t nbits>
+void DecimalCharsWorkload(uint64_t NR_OPS) {
+	sw::unum::integer<nbits, uint32_t> a = DecimalOperand<nbits>();
+	char buffer[sw::unum::max_decimal_chars<nbits>()];
+	size_t length = 0;
+	for (uint64_t i = 0; i < NR_OPS; ++i) length += size_t(sw::unum::to_decimal_chars(buffer, buffer + sizeof(buffer), a) - buffer);
+	if (length == 0) std::cout << "unexpected empty string" << std::endl;
+}
+
+template<size_t nbits>
+void ParseDecimalCharsWorkload(uint64_t NR_OPS) {
+	sw::unum::integer<nbits, uint32_t> a = DecimalOperand<nbits>(), b;
+	char buffer[sw::unum::max_decimal_chars<nbits>()];
+	char* end = sw::unum::to_decimal_chars(buffer, buffer + sizeof(buffer), a);
+	for (uint64_t i = 0; i < NR_OPS; ++i) sw::unum::from_decimal_chars(buffer, end, b);
+	if (a != b) std::cout << "decimal round trip failed" << std::endl;
+}
+
+void TestDecimalConversionPerformance() {
+	using namespace std;
+	cout << endl << "Decimal conversion performance" << endl;
+
+	uint64_t NR_OPS = 1024 * 64;
+	PerformanceRunner("integer<256>  naive string  ", NaiveDecimalStringWorkload<256>, NR_OPS / 64);
+	PerformanceRunner("integer<256>  to chars      ", DecimalCharsWorkload<256>, NR_OPS * 4);
+	PerformanceRunner("integer<256>  from chars    ", ParseDecimalCharsWorkload<256>, NR_OPS * 4);
+	PerformanceRunner("integer<1024> naive string  ", NaiveDecimalStringWorkload<1024>, NR_OPS / 512);
+	PerformanceRunner("integer<1024> to chars      ", DecimalCharsWorkload<1024>, NR_OPS);
+	PerformanceRunner("integer<1024> from chars    ", ParseDecimalCharsWorkload<1024>, NR_OPS);
+	PerformanceRunner("integer<8192> to chars      ", DecimalCharsWorkload<8192>, NR_OPS / 32);
+	PerformanceRunner("integer<8192> from chars    ", ParseDecimalCharsWorkload<8192>, NR_OPS / 32);
+}
+
 // conditional compilation
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
@@ -147,6 +330,8 @@ try {
 
 	TestShiftOperatorPerformance();
 	TestArithmeticOperatorPerformance();
+	TestModularArithmeticPerformance();
+	TestDecimalConversionPerformance();
 
 	cout << "done" << endl;
 
@@ -158,6 +343,8 @@ try {
 	   
 	TestShiftOperatorPerformance();
 	TestArithmeticOperatorPerformance();
+	TestModularArithmeticPerformance();
+	TestDecimalConversionPerformance();
 
 #if STRESS_TESTING
 
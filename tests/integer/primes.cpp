@@ -9,9 +9,112 @@
 #include <universal/integer/integer>
 #include <universal/integer/math_functions.hpp>
 #include <universal/integer/primes.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// the number of primes below the powers of 10
+int VerifySieveCounts(bool bReportIndividualTestCases) {
+	const uint64_t pi[] = { 0, 4, 25, 168, 1229, 9592, 78498, 664579 };
+	int nrOfFailedTestCases = 0;
+	uint64_t limit = 1;
+	for (int k = 1; k < 8; ++k) {
+		limit *= 10;
+		uint64_t count = sw::unum::countPrimes(0, limit);
+		uint64_t parallel = sw::unum::countPrimes(0, limit, 4);
+		if (count != pi[k] || parallel != pi[k]) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: pi(" << limit << ") = " << count << " with 4 threads " << parallel << " reference " << pi[k] << std::endl;
+		}
+	}
+	// a window that starts beyond the sieving primes, and its concatenation from threads
+	std::vector<uint64_t> window = sw::unum::segmentedSieve(1000000000, 1000100000);
+	std::vector<uint64_t> parallel = sw::unum::segmentedSieve(1000000000, 1000100000, 3);
+	if (window != parallel || window.size() != 4832 || window.front() != 1000000007) {
+		++nrOfFailedTestCases;
+		if (bReportIndividualTestCases) std::cout << "FAIL: " << window.size() << " primes in [10^9, 10^9 + 10^5)" << std::endl;
+	}
+	return nrOfFailedTestCases;
+}
+
+// the primality tests agree with the sieve on all numbers below a limit
+template<size_t nbits, typename BlockType>
+int VerifyPrimalityAgainstSieve(uint64_t limit, bool bReportIndividualTestCases) {
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	std::vector<bool> prime(limit, false);
+	for (uint64_t p : sw::unum::segmentedSieve(0, limit)) prime[p] = true;
+	int nrOfFailedTestCases = 0;
+	for (uint64_t i = 0; i < limit; ++i) {
+		Integer a((unsigned long long)i);
+		if (isPrime(a) != prime[i] || isPrimeBPSW(a) != prime[i]) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << (prime[i] ? " is prime" : " is composite") << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// 2^p - 1
+template<size_t nbits, typename BlockType>
+sw::unum::integer<nbits, BlockType> Mersenne(int p) {
+	sw::unum::integer<nbits, BlockType> m(1);
+	for (int i = 0; i < p; ++i) m *= 2;
+	return m - 1;
+}
+
+// strong pseudoprimes, Carmichael numbers, Mersenne numbers, and the first prime beyond 2^100
+template<size_t nbits, typename BlockType>
+int VerifyKnownPrimes(bool bReportIndividualTestCases) {
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	int nrOfFailedTestCases = 0;
+	auto check = [&](const Integer& a, bool expected) {
+		if (isPrime(a) != expected || isPrimeBPSW(a) != expected) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << (expected ? " is prime" : " is composite") << std::endl;
+		}
+	};
+	// strong pseudoprimes to base 2, and 3825123056546413051 to all the prime bases up to 23
+	for (long long spsp : { 2047ll, 561ll, 3215031751ll, 3825123056546413051ll }) {
+		Integer a(spsp);
+		check(a, false);
+		if (!millerRabin(a, Integer(2)) && spsp != 561) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " is a strong pseudoprime to base 2" << std::endl;
+		}
+	}
+	for (int p : { 31, 61, 89, 107, 127 }) check(Mersenne<nbits, BlockType>(p), true);
+	for (int p : { 67, 101, 103, 109 }) check(Mersenne<nbits, BlockType>(p), false);
+	// the primes of the form 2^100 + k, k < 300
+	Integer base = Mersenne<nbits, BlockType>(100) + 1;
+	for (int k = 0; k < 300; ++k) check(base + k, k == 277);
+	return nrOfFailedTestCases;
+}
+
+// the factorization multiplies back to the magnitude of the number, and its factors are increasing primes
+template<size_t nbits, typename BlockType>
+int VerifyFactorization(const sw::unum::integer<nbits, BlockType>& a, bool bReportIndividualTestCases) {
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	sw::unum::primefactors<nbits, BlockType> factors;
+	primeFactorization(a, factors);
+	Integer product(1), previous(1);
+	bool bFactorsArePrime = true;
+	for (auto& f : factors) {
+		product *= ipow(f.first, f.second);
+		bFactorsArePrime = bFactorsArePrime && isPrime(f.first) && previous < f.first;
+		previous = f.first;
+	}
+	if (product != (a.sign() ? -a : a) || !bFactorsArePrime) {
+		if (bReportIndividualTestCases) {
+			std::cout << "FAIL: " << a << " =";
+			for (auto& f : factors) std::cout << ' ' << f.first << '^' << f.second;
+			std::cout << std::endl;
+		}
+		return 1;
+	}
+	return 0;
+}
 
 // conditional compilation
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
 int main() 
@@ -88,13 +191,42 @@ try {
 
 #else // MANUAL_TESTING
 
-	// GCD of three numbers is
-	// gcd(a, b, c) == gcd(a, gcd(b, c)) == gcd(gcd(a, b), c) == gcd(b, gcd(a, c))
-
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "Prime number sieves, tests, and factorization" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifySieveCounts(bReportIndividualTestCases), "segmented sieve", "prime counts");
+	nrOfFailedTestCases += ReportTestResult(VerifyPrimalityAgainstSieve<64, uint8_t>(100000, bReportIndividualTestCases), "integer<64>", "isPrime");
+	nrOfFailedTestCases += ReportTestResult(VerifyPrimalityAgainstSieve<128, uint32_t>(20000, bReportIndividualTestCases), "integer<128>", "isPrime");
+	nrOfFailedTestCases += ReportTestResult(VerifyKnownPrimes<256, uint32_t>(bReportIndividualTestCases), "integer<256>", "isPrime");
+
+	{
+		using Integer = integer<256, uint32_t>;
+		int nrOfFailedFactorizations = 0;
+		// small prime powers, a Mersenne number, and products of large primes
+		Integer a = ipow(Integer(2), Integer(5)) * ipow(Integer(3), Integer(4)) * ipow(Integer(5), Integer(3)) * ipow(Integer(7), Integer(2)) * Integer(1009) * Integer(1009);
+		nrOfFailedFactorizations += VerifyFactorization(a, bReportIndividualTestCases);
+		nrOfFailedFactorizations += VerifyFactorization(a + 1, bReportIndividualTestCases);
+		nrOfFailedFactorizations += VerifyFactorization(Mersenne<256, uint32_t>(67), bReportIndividualTestCases);
+		nrOfFailedFactorizations += VerifyFactorization(Integer(1000003ll) * Integer(1000003ll) * Integer(1000000007ll), bReportIndividualTestCases);
+		nrOfFailedFactorizations += VerifyFactorization(Integer(1000000000039ll) * Integer(1000000000061ll) * Integer(-1000000000063ll), bReportIndividualTestCases);
+		for (long long i = 1; i < 200; ++i) nrOfFailedFactorizations += VerifyFactorization(Integer(i * 1000000007ll + 1), bReportIndividualTestCases);
+		nrOfFailedTestCases += ReportTestResult(nrOfFailedFactorizations, "integer<256>", "primeFactorization");
+
+		// a semiprime of two 13-digit primes
+		Integer p(1000000000039ll), q(7000000000009ll);
+		Integer factor = quadraticSieve(p * q);
+		nrOfFailedTestCases += ReportTestResult((factor == p || factor == q) ? 0 : 1, "integer<256>", "quadraticSieve");
+		factor = pollardRhoBrent(Integer(1000003ll) * Integer(999983ll));
+		nrOfFailedTestCases += ReportTestResult((factor == 1000003 || factor == 999983) ? 0 : 1, "integer<256>", "pollardRhoBrent");
+	}
 
 #if STRESS_TESTING
-
+	nrOfFailedTestCases += ReportTestResult(VerifyPrimalityAgainstSieve<1024, uint32_t>(100000, bReportIndividualTestCases), "integer<1024>", "isPrime");
 #endif // STRESS_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 #endif // MANUAL_TESTING
 
 
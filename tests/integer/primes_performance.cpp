@@ -0,0 +1,134 @@
+//  primes_performance.cpp : performance of the prime sieves, primality tests, and factorization algorithms
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <universal/integer/integer>
+
+// the trial division primality test and factorization that the sieves and probabilistic tests replace
+namespace reference {
+
+template<size_t nbits, typename BlockType>
+bool isPrime(const sw::unum::integer<nbits, BlockType>& a) {
+	if (a.iszero() || a == 1) return false;
+	for (sw::unum::integer<nbits, BlockType> i = 2; i < a / 2; ++i) if ((a % i) == 0) return false;
+	return true;
+}
+
+template<size_t nbits, typename BlockType>
+void primeFactorization(const sw::unum::integer<nbits, BlockType>& a, sw::unum::primefactors<nbits, BlockType>& factors) {
+	using Integer = sw::unum::integer<nbits, BlockType>;
+	Integer i(a);
+	Integer factor = 2;
+	Integer power = 0;
+	while (i.iseven()) { ++power; i >>= 1; }
+	if (power > 0) factors.push_back(std::pair<Integer, Integer>(factor, power));
+	for (factor = 3; factor <= sqrt(i); factor += 2) {
+		if (reference::isPrime(factor)) {
+			power = 0;
+			while ((i % factor) == 0) { ++power; i /= factor; }
+			if (power > 0) factors.push_back(std::pair<Integer, Integer>(factor, power));
+		}
+	}
+	if (i > 2) factors.push_back(std::pair<Integer, Integer>(i, 1));
+}
+
+} // namespace reference
+
+// seconds that a function takes
+template<typename Function>
+double Elapsed(Function f) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	f();
+	steady_clock::time_point end = steady_clock::now();
+	return duration_cast< duration<double> >(end - begin).count();
+}
+
+void ReportRate(const std::string& tag, uint64_t nrOfPrimes, double elapsed) {
+	std::cout << std::setw(40) << std::left << tag << std::right << std::setw(10) << nrOfPrimes << " primes in "
+		<< std::setw(10) << std::setprecision(4) << elapsed << " sec -> " << std::setw(12) << std::setprecision(4) << double(nrOfPrimes) / elapsed << " primes/sec" << std::endl;
+}
+
+// primes per second of trial division and of the segmented sieve
+void SievePerformance() {
+	using namespace sw::unum;
+	std::cout << "\nprime generation" << std::endl;
+	uint64_t count = 0;
+	constexpr uint64_t trialLimit = 20000;
+	double elapsed = Elapsed([&]() {
+		for (uint64_t i = 0; i < trialLimit; ++i) if (reference::isPrime(integer<64>((unsigned long long)i))) ++count;
+	});
+	ReportRate("trial division    [0, 2*10^4)", count, elapsed);
+	elapsed = Elapsed([&]() {
+		count = 0;
+		for (uint64_t i = 0; i < 1000000; ++i) if (isPrime(integer<64>((unsigned long long)i))) ++count;
+	});
+	ReportRate("Miller-Rabin      [0, 10^6)", count, elapsed);
+	elapsed = Elapsed([&]() { count = countPrimes(0, 100000000); });
+	ReportRate("segmented sieve   [0, 10^8)", count, elapsed);
+	unsigned nrThreads = std::max(1u, std::thread::hardware_concurrency());
+	elapsed = Elapsed([&]() { count = countPrimes(0, 100000000, nrThreads); });
+	ReportRate(std::string("segmented sieve   [0, 10^8) ") + std::to_string(nrThreads) + " threads", count, elapsed);
+	elapsed = Elapsed([&]() { count = countPrimes(1000000000000ull, 1000100000000ull, nrThreads); });
+	ReportRate(std::string("segmented sieve   [10^12, +10^8) ") + std::to_string(nrThreads) + " threads", count, elapsed);
+}
+
+template<size_t nbits, typename BlockType, typename Factorization>
+void ReportFactorization(const std::string& tag, const sw::unum::integer<nbits, BlockType>& a, Factorization factorize) {
+	sw::unum::primefactors<nbits, BlockType> factors;
+	double elapsed = Elapsed([&]() { factorize(a, factors); });
+	std::cout << std::setw(24) << std::left << tag << std::right << std::setw(12) << std::setprecision(4) << elapsed << " sec  " << a << " =";
+	for (auto& f : factors) std::cout << ' ' << f.first << '^' << f.second;
+	std::cout << std::endl;
+}
+
+// the time to factor products of primes of increasing size
+void FactorizationPerformance() {
+	using namespace sw::unum;
+	using Integer = integer<256, uint32_t>;
+	std::cout << "\nfactorization" << std::endl;
+	auto trial = [](const Integer& a, primefactors<256, uint32_t>& f) { reference::primeFactorization(a, f); };
+	auto current = [](const Integer& a, primefactors<256, uint32_t>& f) { primeFactorization(a, f); };
+	for (long long p : { 1009ll, 4999ll }) {
+		Integer a = Integer(p) * Integer(p + 4);
+		ReportFactorization("trial division", a, trial);
+		ReportFactorization("rho and sieve", a, current);
+	}
+	ReportFactorization("rho and sieve", Integer(1000003ll) * Integer(1000000007ll) * Integer(1000000000039ll), current);
+	Integer fermat(1);
+	for (int i = 0; i < 64; ++i) fermat *= 2;
+	ReportFactorization("rho and sieve", fermat + 1, current);  // the sixth Fermat number
+	// a semiprime that takes Pollard's rho 10^9 steps, and the quadratic sieve a second
+	Integer p(1000000000000000003ll), q(3000000000000000037ll);
+	double elapsed = Elapsed([&]() { p = quadraticSieve(p * q); });
+	std::cout << std::setw(24) << std::left << "quadratic sieve" << std::right << std::setw(12) << std::setprecision(4) << elapsed << " sec  " << Integer(1000000000000000003ll) * q << " = " << p << " * " << Integer(1000000000000000003ll) * q / p << std::endl;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	cout << "prime sieve, primality test, and factorization performance" << endl;
+	SievePerformance();
+	FactorizationPerformance();
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
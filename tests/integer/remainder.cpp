@@ -40,11 +40,13 @@ void ExamplePattern() {
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
-int main()
+int main(int argc, char** argv)
 try {
 	using namespace std;
 	using namespace sw::unum;
 
+	if (!ParseVerificationArguments(argc, argv)) return EXIT_FAILURE;
+
 	std::string tag = "Integer Arithmetic tests failed";
 
 #if MANUAL_TESTING
@@ -32,11 +32,13 @@ void GenerateSubTest(const Scalar& x, const Scalar& y, Scalar& z) {
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
-int main()
+int main(int argc, char** argv)
 try {
 	using namespace std;
 	using namespace sw::unum;
 
+	if (!ParseVerificationArguments(argc, argv)) return EXIT_FAILURE;
+
 	std::string tag = "integer subtraction";
 
 #if MANUAL_TESTING
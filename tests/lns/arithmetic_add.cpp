@@ -8,6 +8,7 @@
 #include <universal/lns/lns.hpp>
 // test helpers, such as, ReportTestResults
 #include "../utils/test_helpers.hpp"
+#include <random>
 
 // generate specific test case that you can trace with the trace conditions in areal.hpp
 // for most bugs they are traceable with _trace_conversion and _trace_add
@@ -27,14 +28,68 @@ void GenerateTestCase(Ty a, Ty b) {
 	std::cout << std::setprecision(5);
 }
 
-template<size_t nbits> 
+// a faithful result is the correctly rounded reference or its neighbor
+template<size_t nbits, typename bt>
+bool Faithful(const sw::unum::lns<nbits, bt>& result, const sw::unum::lns<nbits, bt>& reference) {
+	if (result == reference) return true;
+	if (result.isnan() || reference.isnan()) return false;
+	sw::unum::lns<nbits, bt> next(reference), previous(reference);
+	++next;
+	--previous;
+	return result == next || result == previous;
+}
+
+// the sum of every pair of encodings is a faithful rounding of the sum of their values:
+// the logarithm of the result is within one ulp of the correctly rounded logarithm
+template<size_t nbits>
 int ValidateAddition(const std::string& tag, bool bReportIndividualTestCases) {
+	using Lns = sw::unum::lns<nbits>;
+	constexpr size_t NR_ENCODINGS = (size_t(1) << nbits);
 	int nrOfFailedTestCases = 0;
+	Lns a, b, result, reference;
+	for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+		a.set_raw_bits(i);
+		for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+			b.set_raw_bits(j);
+			result = a + b;
+			if (a.isnan() || b.isnan()) {
+				if (!result.isnan()) ++nrOfFailedTestCases;
+				continue;
+			}
+			reference = a.to_long_double() + b.to_long_double();
+			if (!Faithful(result, reference)) {
+				++nrOfFailedTestCases;
+				if (bReportIndividualTestCases) std::cout << tag << a << " + " << b << " = " << result << " reference " << reference << std::endl;
+			}
+			// subtraction is the addition of the negation
+			if (a - b != a + (-b)) ++nrOfFailedTestCases;
+		}
+	}
+	return nrOfFailedTestCases;
+}
 
+// random operands of a wide configuration
+template<size_t nbits>
+int ValidateRandomAddition(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using Lns = sw::unum::lns<nbits>;
+	int nrOfFailedTestCases = 0;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+	std::uniform_int_distribution<int> scale(-20, 20);
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		Lns a(std::ldexp(mantissa(eng), scale(eng))), b(std::ldexp(mantissa(eng), scale(eng)));
+		// near cancellation exercises the singularity of the difference function
+		if (i & 1) b = -a * Lns(1.0 + std::ldexp(mantissa(eng), -scale(eng) / 2 - 10));
+		Lns result = a + b, reference(a.to_long_double() + b.to_long_double());
+		if (!Faithful(result, reference)) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << tag << a << " + " << b << " = " << result << " reference " << reference << std::endl;
+		}
+	}
 	return nrOfFailedTestCases;
 }
 
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
 int main(int argc, char** argv)
@@ -61,8 +116,14 @@ try {
 	std::string tag = "Addition failed: ";
 
 	nrOfFailedTestCases += ReportTestResult(ValidateAddition<8>(tag, bReportIndividualTestCases), "lns<8>", "addition");
+	nrOfFailedTestCases += ReportTestResult(ValidateAddition<10>(tag, bReportIndividualTestCases), "lns<10>", "addition");
+	nrOfFailedTestCases += ReportTestResult(ValidateRandomAddition<16>(tag, bReportIndividualTestCases, 100000), "lns<16>", "addition");
+	nrOfFailedTestCases += ReportTestResult(ValidateRandomAddition<32>(tag, bReportIndividualTestCases, 100000), "lns<32>", "addition");
+	// beyond LNS_GAUSSIAN_LOG_TABLE_RBITS the Gaussian logarithms are evaluated by the standard library
+	nrOfFailedTestCases += ReportTestResult(ValidateRandomAddition<40>(tag, bReportIndividualTestCases, 10000), "lns<40>", "addition");
 
 #if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateAddition<12>(tag, bReportIndividualTestCases), "lns<12>", "addition");
 
 #endif  // STRESS_TESTING
 
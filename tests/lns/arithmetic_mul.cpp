@@ -19,7 +19,7 @@ void GenerateTestCase(Ty a, Ty b) {
 	pb = b;
 	ref = a * b;
 	pref = ref;
-	psum = pa + pb;
+	psum = pa * pb;
 	std::cout << std::setprecision(nbits - 2);
 	std::cout << std::setw(nbits) << a << " * " << std::setw(nbits) << b << " = " << std::setw(nbits) << ref << std::endl;
 	std::cout << pa.get() << " * " << pb.get() << " = " << psum.get() << " (reference: " << pref.get() << ")   " ;
@@ -27,14 +27,40 @@ void GenerateTestCase(Ty a, Ty b) {
 	std::cout << std::setprecision(5);
 }
 
-template<size_t nbits> 
+// the product and quotient of every pair of encodings is exact, up to saturation at minpos and maxpos
+template<size_t nbits>
 int ValidateMultiplication(const std::string& tag, bool bReportIndividualTestCases) {
+	using Lns = sw::unum::lns<nbits>;
+	constexpr size_t NR_ENCODINGS = (size_t(1) << nbits);
 	int nrOfFailedTestCases = 0;
-
+	Lns a, b, result, reference;
+	for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+		a.set_raw_bits(i);
+		for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+			b.set_raw_bits(j);
+			result = a * b;
+			if (a.isnan() || b.isnan()) {
+				if (!result.isnan()) ++nrOfFailedTestCases;
+				continue;
+			}
+			reference = a.to_long_double() * b.to_long_double();
+			if (result != reference) {
+				++nrOfFailedTestCases;
+				if (bReportIndividualTestCases) std::cout << tag << a << " * " << b << " = " << result << " reference " << reference << std::endl;
+			}
+			if (b.iszero()) continue;
+			result = a / b;
+			reference = a.to_long_double() / b.to_long_double();
+			if (result != reference) {
+				++nrOfFailedTestCases;
+				if (bReportIndividualTestCases) std::cout << tag << a << " / " << b << " = " << result << " reference " << reference << std::endl;
+			}
+		}
+	}
 	return nrOfFailedTestCases;
 }
 
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
 int main(int argc, char** argv)
@@ -68,9 +94,11 @@ try {
 	bool bReportIndividualTestCases = false;
 	std::string tag = "multiplication failed: ";
 
-	nrOfFailedTestCases += ReportTestResult(ValidateMultiplication<8>(tag, bReportIndividualTestCases), "lns<8>", "addition");
+	nrOfFailedTestCases += ReportTestResult(ValidateMultiplication<8>(tag, bReportIndividualTestCases), "lns<8>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateMultiplication<10>(tag, bReportIndividualTestCases), "lns<10>", "multiplication");
 
 #if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateMultiplication<12>(tag, bReportIndividualTestCases), "lns<12>", "multiplication");
 
 #endif  // STRESS_TESTING
 
@@ -0,0 +1,83 @@
+// performance.cpp: throughput of logarithmic number system arithmetic
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the lns template environment
+// first: disable lns arithmetic exceptions
+#define LNS_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/lns/lns>
+#include <chrono>
+#include <random>
+#include <vector>
+
+constexpr size_t NR_LNS_TEST_CASES = 1000000;
+// the workloads store their results and sink one of them so that the compiler can't elide the arithmetic
+volatile double lns_performance_sink = 0;
+
+// operations per second of op(a[i], b[i]) over a set of random operands
+template<typename Scalar, typename Operator>
+double MeasureThroughput(const std::vector<Scalar>& a, const std::vector<Scalar>& b, Operator op) {
+	using namespace std::chrono;
+	std::vector<Scalar> c(a.size());
+	steady_clock::time_point begin = steady_clock::now();
+	for (size_t i = 0; i < a.size(); ++i) {
+		c[i] = op(a[i], b[i]);
+	}
+	steady_clock::time_point end = steady_clock::now();
+	lns_performance_sink = double(c[a.size() / 2]);
+	double elapsed = duration_cast<duration<double>>(end - begin).count();
+	return double(a.size()) / elapsed;
+}
+
+template<typename Scalar>
+void ReportPerformance(const std::string& tag) {
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+	std::uniform_int_distribution<int> scale(-6, 6);
+	std::vector<Scalar> a(NR_LNS_TEST_CASES), b(NR_LNS_TEST_CASES);
+	for (auto& e : a) e = Scalar(std::ldexp(mantissa(eng), scale(eng)));
+	for (auto& e : b) e = Scalar(std::ldexp(mantissa(eng), scale(eng)));
+
+	double add = MeasureThroughput(a, b, [](const Scalar& x, const Scalar& y) { return x + y; });
+	double sub = MeasureThroughput(a, b, [](const Scalar& x, const Scalar& y) { return x - y; });
+	double mul = MeasureThroughput(a, b, [](const Scalar& x, const Scalar& y) { return x * y; });
+	double div = MeasureThroughput(a, b, [](const Scalar& x, const Scalar& y) { return x / y; });
+	std::cout << std::setw(20) << std::left << tag << std::right << std::fixed << std::setprecision(1)
+		<< " add " << std::setw(8) << add / 1.0e6 << " MOPS"
+		<< "   sub " << std::setw(8) << sub / 1.0e6 << " MOPS"
+		<< "   mul " << std::setw(8) << mul / 1.0e6 << " MOPS"
+		<< "   div " << std::setw(8) << div / 1.0e6 << " MOPS" << std::endl;
+	std::cout << std::defaultfloat;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	cout << "LNS arithmetic performance" << endl;
+
+	ReportPerformance< lns<8> >("lns<8>");
+	ReportPerformance< lns<16> >("lns<16>");
+	ReportPerformance< lns<32> >("lns<32>");
+	ReportPerformance< lns<32, uint32_t> >("lns<32,uint32_t>");
+	// beyond LNS_GAUSSIAN_LOG_TABLE_RBITS addition evaluates the Gaussian logarithms with the standard library
+	ReportPerformance< lns<40> >("lns<40> libm");
+	ReportPerformance< float >("float");
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
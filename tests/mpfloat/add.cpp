@@ -13,16 +13,20 @@
 #include <universal/mpfloat/mpfloat.hpp>
 // test helpers, such as, ReportTestResults
 #include "../utils/test_helpers.hpp"
-//#include "mpfloat_test_helpers.hpp"
+#include "mpfloat_test_helpers.hpp"
 
 // generate specific test case that you can trace with the trace conditions in mpreal.hpp
 // for most bugs they are traceable with _trace_conversion and _trace_add
 template<typename Ty>
 void GenerateTestCase(Ty a, Ty b) {
+	constexpr size_t precision = std::numeric_limits<Ty>::digits;
 	Ty ref;
 	sw::unum::mpfloat mpa, mpb, mpref, mpsum;
+	// native values are assigned at the default precision
 	mpa = a;
+	mpa.setprecision(precision);
 	mpb = b;
+	mpb.setprecision(precision);
 	ref = a + b;
 	mpref = ref;
 	mpsum = mpa + mpb;
@@ -34,41 +38,48 @@ void GenerateTestCase(Ty a, Ty b) {
 	std::cout << std::setprecision(5);
 }
 
-// progressions
-void Progressions(uint32_t digit) {
-	using namespace std;
-	using BlockType = uint32_t;
-	sw::unum::mpfloat mpa;
-	vector<BlockType> coef;
-
-	constexpr size_t digitsInWord = 9;
-	coef.clear();
-	coef.push_back(digit);
-	for (size_t i = 0; i < digitsInWord; ++i) {
-		mpa.test(false, -1, coef);
-		cout << "(+, exp = -1, coef = " << coef[0] << ") = " << mpa << endl;
-		coef[0] *= 10;
-		coef[0] += digit;
-	}
-	coef.clear();
-	coef.push_back(digit);
-	for (size_t i = 0; i < digitsInWord; ++i) {
-		mpa.test(false, 0, coef);
-		cout << "(+, exp = 0, coef = " << coef[0] << ") = " << mpa << endl;
-		coef[0] *= 10;
-		coef[0] += digit;
-	}
-	coef.clear();
-	coef.push_back(digit);
-	for (size_t i = 0; i < digitsInWord; ++i) {
-		mpa.test(false, 1, coef);
-		cout << "(+, exp = 1, coef = " << coef[0] << ") = " << mpa << endl;
-		coef[0] *= 10;
-		coef[0] += digit;
+// the sum at a precision is the exact sum, computed at a precision that holds it, rounded once
+int ValidateExactlyRoundedAddition(const std::string& tag, size_t precision, size_t nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTestCases = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		mpfloat a = RandomMpfloat(eng, precision), b = RandomMpfloat(eng, precision);
+		// nearby magnitudes exercise the cancellation of leading bits
+		if (i % 4 == 0) b = -(a + ldexp(b, -int64_t(precision) / 2));
+		mpfloat exact(a);
+		exact.setprecision(2 * precision + 256);
+		exact += b;
+		mpfloat sum = a + b, diff = a - b;
+		if (sum != exact.setprecision(precision) || diff != a + (-b)) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << tag << a << " + " << b << " = " << sum << " reference " << exact << std::endl;
+		}
 	}
+	return nrOfFailedTestCases;
 }
 
-#define MANUAL_TESTING 1
+// IEEE-754 special values and signed zeros
+int ValidateSpecialCases(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	int nrOfFailedTestCases = 0;
+	mpfloat inf(INFINITY), ninf(-INFINITY), zero(0.0), nzero(-0.0), one(1ll);
+	nrOfFailedTestCases += ReportCheck(tag, "inf + inf", (inf + inf).isinf() && (inf + inf).ispos());
+	nrOfFailedTestCases += ReportCheck(tag, "inf - inf", (inf - inf).isnan());
+	nrOfFailedTestCases += ReportCheck(tag, "-inf + 1", (ninf + one).isinf() && (ninf + one).isneg());
+	nrOfFailedTestCases += ReportCheck(tag, "-0 + -0", (nzero + nzero).iszero() && (nzero + nzero).sign());
+	nrOfFailedTestCases += ReportCheck(tag, "-0 + 0", (nzero + zero).iszero() && !(nzero + zero).sign());
+	nrOfFailedTestCases += ReportCheck(tag, "1 - 1", (one - one).iszero() && !(one - one).sign());
+	nrOfFailedTestCases += ReportCheck(tag, "nan + 1", (mpfloat(NAN) + one).isnan());
+	// a tie rounds to even: 1 + 2^-p is halfway between 1 and its successor at precision p
+	mpfloat tie = ldexp(mpfloat(1ll, 200), -200);
+	nrOfFailedTestCases += ReportCheck(tag, "1 + 2^-200", mpfloat(1ll, 200) + tie == 1);
+	nrOfFailedTestCases += ReportCheck(tag, "1 + 3*2^-200", mpfloat(1ll, 200) + tie * mpfloat(3ll, 200) == mpfloat(1ll, 200) + ldexp(tie, 2));
+	if (bReportIndividualTestCases && nrOfFailedTestCases) std::cout << tag << "special cases failed" << std::endl;
+	return nrOfFailedTestCases;
+}
+
+#define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
 int main(int argc, char** argv)
@@ -81,50 +92,31 @@ try {
 	std::string tag = "multi-precision float addition failed: ";
 
 #if MANUAL_TESTING
-//	bool bReportIndividualTestCases = false;
-
 	// generate individual testcases to hand trace/debug
 	GenerateTestCase(INFINITY, INFINITY);
-
-	mpfloat mpa;
-	mpa = 0;
-	cout << mpa << endl;
-
-	vector<uint32_t> coef;
-
-	Progressions(1);
-	Progressions(9);
-
-	coef.clear();
-	coef.push_back(0);
-	mpa.test(false, 0, coef);
-	for (int i = 0; i < 13; ++i) {
-		coef[0] += 1;
-		mpa.test(false, 0, coef);
-		cout << "(+, exp = 0, coef = " << coef[0] << ") = " << mpa << endl;
-	}
-	coef[0] = 999999999;
-	mpa.test(false, 0, coef);
-	cout << "(+, exp = 0, coef = " << coef[0] << ") = " << mpa << endl;
-	coef.push_back(0);
-	for (int i = 0; i < 13; ++i) {
-		coef[0] = 0;
-		coef[1] += 1;
-		mpa.test(false, 0, coef);
-		cout << "(+, exp = 0, coef = " << coef[0] << ", " << coef[1] << ") = " << mpa << endl;
-		coef[0] = 999999999;
-		mpa.test(false, 0, coef);
-		cout << "(+, exp = 0, coef = " << coef[0] << ", " << coef[1] << ") = " << mpa << endl;
-
-	}
+	GenerateTestCase(1.0f, std::ldexp(1.0f, -24));
+	GenerateTestCase(0.1, 0.2);
 
 #else
+	bool bReportIndividualTestCases = false;
 
 	cout << "multi-precision float addition validation" << endl;
 
+	nrOfFailedTestCases += ValidateSpecialCases(tag, bReportIndividualTestCases);
 
-#if STRESS_TESTING
+	auto add = [](const auto& a, const auto& b) { return a + b; };
+	auto sub = [](const auto& a, const auto& b) { return a - b; };
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<float>(tag, "+", add, add, 10000, bReportIndividualTestCases), "mpfloat precision 24", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<double>(tag, "+", add, add, 10000, bReportIndividualTestCases), "mpfloat precision 53", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<double>(tag, "-", sub, sub, 10000, bReportIndividualTestCases), "mpfloat precision 53", "subtraction");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<long double>(tag, "+", add, add, 10000, bReportIndividualTestCases), "mpfloat precision 64", "addition");
 
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedAddition(tag, 100, 1000, bReportIndividualTestCases), "mpfloat precision 100", "addition");
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedAddition(tag, 256, 1000, bReportIndividualTestCases), "mpfloat precision 256", "addition");
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedAddition(tag, 1000, 100, bReportIndividualTestCases), "mpfloat precision 1000", "addition");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedAddition(tag, 4096, 1000, bReportIndividualTestCases), "mpfloat precision 4096", "addition");
 #endif  // STRESS_TESTING
 
 #endif  // MANUAL_TESTING
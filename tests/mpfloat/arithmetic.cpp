@@ -0,0 +1,214 @@
+// arithmetic.cpp: functional tests for multiplication, division, square root, and conversion of multi-precision linear floating point
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <limits>
+
+// the posit conversions need the posit definitions
+#include <universal/posit/posit>
+#include <universal/mpfloat/mpfloat.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "mpfloat_test_helpers.hpp"
+
+// the product at a precision is the exact product, computed at a precision that holds it, rounded once
+int ValidateExactlyRoundedMultiplication(const std::string& tag, size_t precision, size_t nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTestCases = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		mpfloat a = RandomMpfloat(eng, precision), b = RandomMpfloat(eng, precision);
+		mpfloat exact(a);
+		exact.setprecision(2 * precision);
+		exact *= b;
+		mpfloat product = a * b;
+		if (product != exact.setprecision(precision)) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << tag << a << " * " << b << " = " << product << " reference " << exact << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// q = a / b is correctly rounded when the exact residual |a - q*b| is at most |b| * ulp(q) / 2
+int ValidateExactlyRoundedDivision(const std::string& tag, size_t precision, size_t nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTestCases = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		mpfloat a = RandomMpfloat(eng, precision), b = RandomMpfloat(eng, precision);
+		mpfloat q = a / b;
+		mpfloat residual(q);
+		residual.setprecision(4 * precision);
+		residual = residual * b - a;
+		mpfloat bound = ldexp(abs(b), q.scale() - int64_t(precision));
+		if (abs(residual) > bound || q.precision() != precision) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << tag << a << " / " << b << " = " << q << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// s = sqrt(a) is correctly rounded when (s - ulp(s)/2)^2 < a < (s + ulp(s)/2)^2, as a square root is never a tie
+int ValidateExactlyRoundedSqrt(const std::string& tag, size_t precision, size_t nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTestCases = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		mpfloat a = abs(RandomMpfloat(eng, precision));
+		mpfloat s = sqrt(a);
+		mpfloat lower(s), upper(s);
+		lower.setprecision(precision + 2);
+		upper.setprecision(precision + 2);
+		mpfloat halfulp = ldexp(mpfloat(1ll, precision + 2), s.scale() - int64_t(precision));
+		lower -= halfulp;
+		upper += halfulp;
+		lower.setprecision(4 * precision);
+		upper.setprecision(4 * precision);
+		if (!(lower * lower < a && a < upper * upper)) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << tag << "sqrt(" << a << ") = " << s << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// posits round trip through mpfloat, and doubles converted through mpfloat round like the posit conversion of the double
+template<size_t nbits, size_t es>
+int ValidatePositConversion(const std::string& tag, size_t nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTestCases = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		double d = RandomNative<double>(eng, 32);
+		posit<nbits, es> p(d), roundtrip, rounded;
+		mpfloat mp(p);
+		convert(mp, roundtrip);
+		convert(mpfloat(d), rounded);
+		if (roundtrip != p || rounded != p) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << tag << d << " : " << p << " " << roundtrip << " " << rounded << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// values round trip through mpfloat
+int ValidateValueConversion(const std::string& tag, size_t nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTestCases = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		double d = RandomNative<double>(eng);
+		value<52> v(d);
+		mpfloat mp(v);
+		value<52> roundtrip = mp.to_value<52>();
+		value<23> rounded = mp.to_value<23>();
+		if (roundtrip != v || double(mp) != d || rounded.to_float() != float(d)) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << tag << d << " : " << v << " " << roundtrip << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// decimal strings with enough digits round trip at a precision
+int ValidateDecimalConversion(const std::string& tag, size_t precision, size_t nrOfRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTestCases = 0;
+	size_t nrDigits = size_t(std::ceil(double(precision) * 0.30102999566398)) + 1;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		mpfloat a = RandomMpfloat(eng, precision, 400);
+		std::string s = a.str(nrDigits);
+		mpfloat b(s, precision);
+		if (a != b) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << tag << s << " : " << b.str(nrDigits) << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "multi-precision float arithmetic failed: ";
+
+#if MANUAL_TESTING
+	mpfloat two(2ll, 1000);
+	cout << "sqrt(2) = " << sqrt(two).str(300) << endl;
+	cout << "1/3     = " << (mpfloat(1ll, 1000) / mpfloat(3ll, 1000)).str(300) << endl;
+
+#else
+	bool bReportIndividualTestCases = false;
+
+	cout << "multi-precision float arithmetic validation" << endl;
+
+	auto mul = [](const auto& a, const auto& b) { return a * b; };
+	auto div = [](const auto& a, const auto& b) { return a / b; };
+	auto mproot = [](const mpfloat& a, const mpfloat&) { return sqrt(abs(a)); };
+	auto root = [](const auto& a, const auto&) { return std::sqrt(std::abs(a)); };
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<float>(tag, "*", mul, mul, 10000, bReportIndividualTestCases), "mpfloat precision 24", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<double>(tag, "*", mul, mul, 10000, bReportIndividualTestCases), "mpfloat precision 53", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<long double>(tag, "*", mul, mul, 10000, bReportIndividualTestCases), "mpfloat precision 64", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<float>(tag, "/", div, div, 10000, bReportIndividualTestCases), "mpfloat precision 24", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<double>(tag, "/", div, div, 10000, bReportIndividualTestCases), "mpfloat precision 53", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<long double>(tag, "/", div, div, 10000, bReportIndividualTestCases), "mpfloat precision 64", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<double>(tag, "sqrt", mproot, root, 10000, bReportIndividualTestCases), "mpfloat precision 53", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeReference<long double>(tag, "sqrt", mproot, root, 10000, bReportIndividualTestCases), "mpfloat precision 64", "sqrt");
+
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedMultiplication(tag, 256, 1000, bReportIndividualTestCases), "mpfloat precision 256", "multiplication");
+	// 40 limbs take the Karatsuba kernel
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedMultiplication(tag, 2560, 50, bReportIndividualTestCases), "mpfloat precision 2560", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedDivision(tag, 256, 1000, bReportIndividualTestCases), "mpfloat precision 256", "division");
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedDivision(tag, 1000, 50, bReportIndividualTestCases), "mpfloat precision 1000", "division");
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedSqrt(tag, 256, 500, bReportIndividualTestCases), "mpfloat precision 256", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedSqrt(tag, 1000, 20, bReportIndividualTestCases), "mpfloat precision 1000", "sqrt");
+
+	nrOfFailedTestCases += ReportTestResult(ValidatePositConversion<32, 2>(tag, 1000, bReportIndividualTestCases), "posit<32,2>", "conversion");
+	nrOfFailedTestCases += ReportTestResult(ValidatePositConversion<64, 3>(tag, 1000, bReportIndividualTestCases), "posit<64,3>", "conversion");
+	nrOfFailedTestCases += ReportTestResult(ValidateValueConversion(tag, 1000, bReportIndividualTestCases), "value<52>", "conversion");
+	nrOfFailedTestCases += ReportTestResult(ValidateDecimalConversion(tag, 256, 200, bReportIndividualTestCases), "mpfloat precision 256", "decimal");
+
+	// the reference values of the trigonometry applications
+	mpfloat pi("3.14159265358979323846264338327950288419716939937510582097494459230781640628620899862803482534211706798214808651328230664709384460955058223172535940812848111745028410270193852110555964462294895493038196", 600);
+	mpfloat root2 = sqrt(mpfloat(2ll, 600));
+	nrOfFailedTestCases += ReportCheck(tag, "pi 150 digits", pi.str(150) == mpfloat(pi.str(150), 600).str(150));
+	nrOfFailedTestCases += ReportCheck(tag, "sqrt(2)^2", abs(root2 * root2 - 2) <= ldexp(mpfloat(1ll, 600), -598));
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedMultiplication(tag, 8192, 100, bReportIndividualTestCases), "mpfloat precision 8192", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedDivision(tag, 4096, 100, bReportIndividualTestCases), "mpfloat precision 4096", "division");
+	nrOfFailedTestCases += ReportTestResult(ValidateExactlyRoundedSqrt(tag, 4096, 100, bReportIndividualTestCases), "mpfloat precision 4096", "sqrt");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
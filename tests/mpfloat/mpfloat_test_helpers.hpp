@@ -0,0 +1,61 @@
+#pragma once
+//  mpfloat_test_helpers.hpp : multi-precision floating-point verification functions
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <limits>
+#include <string>
+
+namespace sw { namespace unum {
+
+// a random mpfloat with every one of its precision bits random, a random sign, and a scale in [-scale, scale]
+inline mpfloat RandomMpfloat(std::mt19937_64& eng, size_t precision, int scale = 64) {
+	std::uniform_int_distribution<int> exponent(-scale, scale);
+	mpfloat r(0ll, precision + 64);
+	for (size_t i = 0; i < precision; i += 64) {
+		r = ldexp(r, 64) + mpfloat((unsigned long long)eng());
+	}
+	r = ldexp(r, exponent(eng) - int64_t(r.scale()));
+	if (eng() & 1) r = -r;
+	return r.setprecision(precision);
+}
+
+// the operands of the arithmetic tests at a precision
+template<typename Real>
+Real RandomNative(std::mt19937_64& eng, int scale = 64) {
+	std::uniform_real_distribution<Real> mantissa(Real(-1), Real(1));
+	std::uniform_int_distribution<int> exponent(-scale, scale);
+	return std::ldexp(mantissa(eng), exponent(eng));
+}
+
+// the precision of a native type is its number of digits, and its arithmetic is correctly rounded:
+// op on mpfloats of that precision must reproduce op on the native operands
+template<typename Real, typename MpfloatOp, typename NativeOp>
+int VerifyNativeReference(const std::string& tag, const std::string& op, MpfloatOp mpop, NativeOp nativeop, size_t nrOfRandoms, bool bReportIndividualTestCases) {
+	constexpr size_t precision = std::numeric_limits<Real>::digits;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTestCases = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		// operands of moderate scale keep the native results out of the subnormal range, where they round twice
+		Real a = RandomNative<Real>(eng, 16), b = RandomNative<Real>(eng, 16);
+		mpfloat ma(a), mb(b);
+		ma.setprecision(precision);
+		mb.setprecision(precision);
+		Real reference = nativeop(a, b);
+		mpfloat result = mpop(ma, mb);
+		if (Real(result) != reference || result.precision() != precision) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) {
+				std::cout << tag << std::setprecision(std::numeric_limits<Real>::max_digits10) << a << ' ' << op << ' ' << b
+					<< " = " << Real(result) << " reference " << reference << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+} } // namespace sw::unum
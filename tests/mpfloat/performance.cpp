@@ -0,0 +1,98 @@
+// performance.cpp: throughput of multi-precision linear floating point arithmetic compared to a wide posit
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <chrono>
+#include <random>
+#include <vector>
+// the posit<256,5> oracle that mpfloat replaces
+#include <universal/posit/posit>
+#include <universal/mpfloat/mpfloat.hpp>
+
+constexpr size_t NR_MPFLOAT_TEST_CASES = 10000;
+// the workloads store their results and sink one of them so that the compiler can't elide the arithmetic
+volatile double mpfloat_performance_sink = 0;
+
+// operations per second of op(a[i], b[i]) over a set of random operands
+template<typename Scalar, typename Operator>
+double MeasureThroughput(const std::vector<Scalar>& a, const std::vector<Scalar>& b, Operator op) {
+	using namespace std::chrono;
+	std::vector<Scalar> c(a.size());
+	steady_clock::time_point begin = steady_clock::now();
+	for (size_t i = 0; i < a.size(); ++i) {
+		c[i] = op(a[i], b[i]);
+	}
+	steady_clock::time_point end = steady_clock::now();
+	mpfloat_performance_sink = double(c[a.size() / 2]);
+	double elapsed = duration_cast<duration<double>>(end - begin).count();
+	return double(a.size()) / elapsed;
+}
+
+template<typename Scalar>
+void ReportPerformance(const std::string& tag, const std::vector<Scalar>& a, const std::vector<Scalar>& b) {
+	using std::sqrt;
+	using sw::unum::sqrt;
+	double add = MeasureThroughput(a, b, [](const Scalar& x, const Scalar& y) { return x + y; });
+	double mul = MeasureThroughput(a, b, [](const Scalar& x, const Scalar& y) { return x * y; });
+	double div = MeasureThroughput(a, b, [](const Scalar& x, const Scalar& y) { return x / y; });
+	double root = MeasureThroughput(a, b, [](const Scalar& x, const Scalar&) { return sqrt(abs(x)); });
+	std::cout << std::setw(20) << std::left << tag << std::right << std::fixed << std::setprecision(1)
+		<< " add " << std::setw(8) << add / 1.0e3 << " KOPS"
+		<< "   mul " << std::setw(8) << mul / 1.0e3 << " KOPS"
+		<< "   div " << std::setw(8) << div / 1.0e3 << " KOPS"
+		<< "   sqrt " << std::setw(8) << root / 1.0e3 << " KOPS" << std::endl;
+	std::cout << std::defaultfloat;
+}
+
+// random operands at a precision: every bit of the significand is random
+void ReportMpfloatPerformance(size_t precision, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_int_distribution<int> scale(-6, 6);
+	std::vector<mpfloat> a(nrOfRandoms), b(nrOfRandoms);
+	for (auto* v : { &a, &b }) {
+		for (auto& e : *v) {
+			e = mpfloat(0ll, precision);
+			for (size_t i = 0; i < precision; i += 64) e = ldexp(e, 64) + mpfloat((unsigned long long)eng());
+			e = ldexp(e, scale(eng) - e.scale()).setprecision(precision);
+		}
+	}
+	ReportPerformance(std::string("mpfloat ") + std::to_string(precision), a, b);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	cout << "multi-precision float arithmetic performance" << endl;
+
+	// the oracle: posit<256,5> has about 245 fraction bits near 1
+	{
+		std::mt19937_64 eng(0x5eed);
+		std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+		std::uniform_int_distribution<int> scale(-6, 6);
+		std::vector< posit<256, 5> > a(NR_MPFLOAT_TEST_CASES / 10), b(NR_MPFLOAT_TEST_CASES / 10);
+		for (auto& e : a) e = std::ldexp(mantissa(eng), scale(eng));
+		for (auto& e : b) e = std::ldexp(mantissa(eng), scale(eng));
+		ReportPerformance(std::string("posit<256,5>"), a, b);
+	}
+	ReportMpfloatPerformance(256, NR_MPFLOAT_TEST_CASES);
+	ReportMpfloatPerformance(1024, NR_MPFLOAT_TEST_CASES);
+	ReportMpfloatPerformance(4096, NR_MPFLOAT_TEST_CASES / 10);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
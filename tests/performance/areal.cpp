@@ -0,0 +1,44 @@
+// areal.cpp: performance characterization of standard areal configurations
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the areal template environment
+// first: enable the native integer arithmetic of configurations up to 32 bits
+#define AREAL_FAST_SPECIALIZATION 1
+// second: disable areal arithmetic exceptions
+#define AREAL_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/areal/areal>
+#include "areal_performance.hpp"
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	ArealOperatorPerformance perfReport;
+	GenerateArealPerformanceReport<8, 2>(perfReport);
+	ReportArealPerformance(cout, "areal<8,2>", perfReport);
+	GenerateArealPerformanceReport<16, 5>(perfReport);
+	ReportArealPerformance(cout, "areal<16,5>", perfReport);
+	GenerateArealPerformanceReport<32, 8>(perfReport);
+	ReportArealPerformance(cout, "areal<32,8>", perfReport);
+	// wider configurations compute with blockbinary significands
+	GenerateArealPerformanceReport<40, 8>(perfReport);
+	ReportArealPerformance(cout, "areal<40,8> blockbinary reference", perfReport);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,156 @@
+#pragma once
+//  areal_performance.hpp : functions to aid in measuring arithmetic performance of areal types.
+// Needs to be included after areal type is declared.
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <chrono>
+
+namespace sw {
+namespace unum {
+
+	// standardized structure to hold performance measurement results of an areal configuration
+	struct ArealOperatorPerformance {
+		ArealOperatorPerformance() : intconvert(0), ieeeconvert(0), prefix(0), postfix(0), neg(0), add(0), sub(0), mul(0), div(0) {}
+		float intconvert;
+		float ieeeconvert;
+		float prefix;
+		float postfix;
+		float neg;
+		float add;
+		float sub;
+		float mul;
+		float div;
+	};
+
+	static constexpr int NR_AREAL_TEST_CASES = 100000;
+	// the workloads fold their results into this sink so that the compiler can't elide the arithmetic
+	inline volatile unsigned long long areal_performance_sink = 0;
+	template<size_t nbits, size_t es>
+	inline unsigned long long areal_sink_bits(const areal<nbits, es>& a) {
+		return a.get().block(0);
+	}
+
+	inline std::string areal_to_scientific(double value) {
+		const char* scales[] = { "", "K", "M", "G", "T" };
+		double lower_bound = 1.0;
+		int integer_value = 0;
+		int scale = 0;
+		for (int i = 0; i < 5; ++i) {
+			if (value > lower_bound && value < 1000 * lower_bound) {
+				integer_value = int(value / lower_bound);
+				scale = i;
+				break;
+			}
+			lower_bound *= 1000;
+		}
+		std::stringstream ss;
+		ss << std::setw(3) << std::right << integer_value << ' ' << scales[scale];
+		return ss.str();
+	}
+
+	inline void ReportArealPerformance(std::ostream& ostr, const std::string& header, const ArealOperatorPerformance& perf) {
+		ostr << "Performance Report: " << header << '\n'
+			<< "Conversion int  : " << areal_to_scientific(perf.intconvert) << "OPS\n"
+			<< "Conversion ieee : " << areal_to_scientific(perf.ieeeconvert) << "OPS\n"
+			<< "Prefix          : " << areal_to_scientific(perf.prefix) << "OPS\n"
+			<< "Postfix         : " << areal_to_scientific(perf.postfix) << "OPS\n"
+			<< "Negation        : " << areal_to_scientific(perf.neg) << "OPS\n"
+			<< "Addition        : " << areal_to_scientific(perf.add) << "OPS\n"
+			<< "Subtraction     : " << areal_to_scientific(perf.sub) << "OPS\n"
+			<< "Multiplication  : " << areal_to_scientific(perf.mul) << "OPS\n"
+			<< "Division        : " << areal_to_scientific(perf.div) << "OPS\n"
+			<< std::endl;
+	}
+
+	// operations per second of a workload of NR_AREAL_TEST_CASES operations
+	template<typename Workload>
+	float MeasureArealThroughput(Workload workload) {
+		using namespace std::chrono;
+		steady_clock::time_point begin = steady_clock::now();
+		unsigned long long checksum = workload();
+		steady_clock::time_point end = steady_clock::now();
+		areal_performance_sink = checksum;
+		double elapsed = duration_cast<duration<double>>(end - begin).count();
+		return float(NR_AREAL_TEST_CASES / elapsed);
+	}
+
+	// the binary operators combine 1.0 with every encoding, including the uncertain and special encodings
+	template<size_t nbits, size_t es, typename Operator>
+	float MeasureArealBinaryOperator(Operator op) {
+		return MeasureArealThroughput([op]() {
+			constexpr unsigned long long mask = (nbits < 64 ? (1ull << nbits) - 1 : ~0ull);
+			areal<nbits, es> a(1), b, c;
+			unsigned long long checksum = 0;
+			for (int i = 0; i < NR_AREAL_TEST_CASES; ++i) {
+				b.set_raw_bits((unsigned long long)(i) & mask);
+				c = op(a, b);
+				checksum ^= areal_sink_bits(c);
+			}
+			return checksum;
+		});
+	}
+
+	template<size_t nbits, size_t es>
+	void GenerateArealPerformanceReport(ArealOperatorPerformance& report) {
+		using Areal = areal<nbits, es>;
+		report.intconvert = MeasureArealThroughput([]() {
+			Areal a;
+			unsigned long long checksum = 0;
+			for (int i = -(NR_AREAL_TEST_CASES >> 1); i < (NR_AREAL_TEST_CASES >> 1); ++i) {
+				a = i;
+				checksum ^= areal_sink_bits(a);
+			}
+			return checksum;
+		});
+		report.ieeeconvert = MeasureArealThroughput([]() {
+			Areal a;
+			unsigned long long checksum = 0;
+			double v = 1.0;
+			for (int i = 0; i < NR_AREAL_TEST_CASES; ++i) {
+				a = v;
+				v += 0.0625;
+				checksum ^= areal_sink_bits(a);
+			}
+			return checksum;
+		});
+		report.prefix = MeasureArealThroughput([]() {
+			Areal a(0);
+			unsigned long long checksum = 0;
+			for (int i = 0; i < NR_AREAL_TEST_CASES; ++i) {
+				++a;
+				checksum ^= areal_sink_bits(a);
+			}
+			return checksum;
+		});
+		report.postfix = MeasureArealThroughput([]() {
+			Areal a(0);
+			unsigned long long checksum = 0;
+			for (int i = 0; i < NR_AREAL_TEST_CASES; ++i) {
+				a++;
+				checksum ^= areal_sink_bits(a);
+			}
+			return checksum;
+		});
+		report.neg = MeasureArealThroughput([]() {
+			Areal a(1);
+			unsigned long long checksum = 0;
+			for (int i = 0; i < NR_AREAL_TEST_CASES; ++i) {
+				a = -a;
+				checksum ^= areal_sink_bits(a);
+			}
+			return checksum;
+		});
+		report.add = MeasureArealBinaryOperator<nbits, es>([](const Areal& a, const Areal& b) { return a + b; });
+		report.sub = MeasureArealBinaryOperator<nbits, es>([](const Areal& a, const Areal& b) { return a - b; });
+		report.mul = MeasureArealBinaryOperator<nbits, es>([](const Areal& a, const Areal& b) { return a * b; });
+		report.div = MeasureArealBinaryOperator<nbits, es>([](const Areal& a, const Areal& b) { return a / b; });
+	}
+
+} // namespace unum
+} // namespace sw
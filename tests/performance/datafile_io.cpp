@@ -0,0 +1,132 @@
+// datafile_io.cpp: performance characterization of loading posit datasets from text and from binary data files
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<16,1> and posit<32,2>
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/serialization/datafile.hpp>
+#include <universal/blas/serialization/mapped_dataset.hpp>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include "../utils/test_helpers.hpp"
+#include "../utils/performance_runner.hpp"
+
+constexpr size_t DATASET_SIZE = 4 * 1024 * 1024;
+
+// the dataset in memory, and its text and binary file
+template<size_t nbits, size_t es>
+struct Dataset {
+	sw::unum::blas::vector< sw::unum::posit<nbits, es> > v, w;
+	std::string text;
+	std::string filename;
+	volatile uint64_t checksum;
+};
+
+template<size_t nbits, size_t es>
+Dataset<nbits, es>& Data() {
+	static Dataset<nbits, es> dataset;
+	return dataset;
+}
+
+template<size_t nbits, size_t es>
+void GenerateDataset() {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> dist(-1024.0, 1024.0);
+	Dataset<nbits, es>& d = Data<nbits, es>();
+	d.v.resize(DATASET_SIZE);
+	for (auto& e : d.v) e = dist(eng);
+	std::vector<posit<nbits, es>> buffer(d.v.begin(), d.v.end());
+	d.text.resize(DATASET_SIZE * 32);
+	char* first = &d.text[0];
+	to_chars_n_result r = to_chars_n(first, first + d.text.size(), buffer.data(), buffer.size(), '\n');
+	d.text.resize(size_t(r.ptr - first));
+	d.filename = "datafile_io_" + std::to_string(nbits) + "_" + std::to_string(es) + ".dat";
+	std::ofstream file(d.filename, std::ios::binary);
+	blas::write_binary(file, d.v);
+}
+
+// parse the text form of the dataset
+template<size_t nbits, size_t es>
+void TextLoadWorkload(uint64_t NR_ELEMENTS) {
+	Dataset<nbits, es>& d = Data<nbits, es>();
+	std::vector< sw::unum::posit<nbits, es> > w(NR_ELEMENTS);
+	sw::unum::from_chars_n(d.text.data(), d.text.data() + d.text.size(), w.data(), w.size());
+	d.checksum = w[NR_ELEMENTS / 2].encoding();
+}
+// read the data file through a stream
+template<size_t nbits, size_t es>
+void StreamLoadWorkload(uint64_t) {
+	Dataset<nbits, es>& d = Data<nbits, es>();
+	std::ifstream file(d.filename, std::ios::binary);
+	sw::unum::blas::read_binary(file, d.w);
+	d.checksum = d.w[d.w.size() / 2].encoding();
+}
+// map the data file and decode or view the elements
+template<size_t nbits, size_t es>
+void MappedLoadWorkload(uint64_t) {
+	Dataset<nbits, es>& d = Data<nbits, es>();
+	sw::unum::blas::mapped_dataset< sw::unum::posit<nbits, es> > dataset(d.filename);
+	uint64_t checksum = 0;
+	if (dataset.zero_copy()) {
+		for (const auto& e : dataset.as_vector()) checksum += e.encoding();
+	}
+	else {
+		for (size_t i = 0; i < dataset.size(); ++i) checksum += dataset[i].encoding();
+	}
+	d.checksum = checksum;
+}
+
+template<size_t nbits, size_t es>
+void TestLoadPerformance(const std::string& tag) {
+	using namespace std;
+	GenerateDataset<nbits, es>();
+	Dataset<nbits, es>& d = Data<nbits, es>();
+	cout << endl << tag << " text " << d.text.size() << " bytes, binary " << DATASET_SIZE * nbits / 8 << " bytes of payload" << endl;
+
+	PerformanceRunner(tag + " text   from_chars_n  ", TextLoadWorkload<nbits, es>, DATASET_SIZE);
+	PerformanceRunner(tag + " binary read_binary   ", StreamLoadWorkload<nbits, es>, DATASET_SIZE);
+	PerformanceRunner(tag + " binary mapped_dataset", MappedLoadWorkload<nbits, es>, DATASET_SIZE);
+	std::remove(d.filename.c_str());
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "dataset load performance: elements per second" << endl;
+
+	TestLoadPerformance<10, 1>("posit<10,1>");
+	TestLoadPerformance<16, 1>("posit<16,1>");
+	TestLoadPerformance<32, 2>("posit<32,2>");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,128 @@
+// packed_blas.cpp: performance characterization of bit-packed vectors of odd-width posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<16,1>
+#define POSIT_FAST_POSIT_16_1 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/packed.hpp>
+#include <random>
+#include "../utils/test_helpers.hpp"
+#include "../utils/performance_runner.hpp"
+
+constexpr size_t VECTOR_SIZE = 1024 * 1024;
+
+// the operands, unpacked and packed
+template<size_t nbits, size_t es>
+struct Operands {
+	sw::unum::blas::vector< sw::unum::posit<nbits, es> > x, y;
+	sw::unum::blas::packed_vector< sw::unum::posit<nbits, es> > px, py;
+	std::vector< sw::unum::posit<nbits, es> > buffer;
+	volatile uint64_t checksum;
+};
+
+template<size_t nbits, size_t es>
+Operands<nbits, es>& Data() {
+	static Operands<nbits, es> operands;
+	return operands;
+}
+
+// copy the elements out of the unpacked vector, the reference for unpack
+template<size_t nbits, size_t es>
+void CopyWorkload(uint64_t NR_ELEMENTS) {
+	Operands<nbits, es>& d = Data<nbits, es>();
+	for (size_t i = 0; i < NR_ELEMENTS; ++i) d.buffer[i] = d.x[i];
+	d.checksum = d.buffer[NR_ELEMENTS / 2].encoding();
+}
+template<size_t nbits, size_t es>
+void UnpackWorkload(uint64_t NR_ELEMENTS) {
+	Operands<nbits, es>& d = Data<nbits, es>();
+	d.px.unpack(0, NR_ELEMENTS, d.buffer.data());
+	d.checksum = d.buffer[NR_ELEMENTS / 2].encoding();
+}
+template<size_t nbits, size_t es>
+void DotWorkload(uint64_t) {
+	Operands<nbits, es>& d = Data<nbits, es>();
+	d.checksum = sw::unum::blas::dot(d.x, d.y).encoding();
+}
+template<size_t nbits, size_t es>
+void PackedDotWorkload(uint64_t) {
+	Operands<nbits, es>& d = Data<nbits, es>();
+	d.checksum = sw::unum::blas::dot(d.px, d.py).encoding();
+}
+template<size_t nbits, size_t es>
+void AxpyWorkload(uint64_t NR_ELEMENTS) {
+	Operands<nbits, es>& d = Data<nbits, es>();
+	sw::unum::blas::axpy(NR_ELEMENTS, sw::unum::posit<nbits, es>(0.25), d.x, 1, d.y, 1);
+	d.checksum = d.y[NR_ELEMENTS / 2].encoding();
+}
+template<size_t nbits, size_t es>
+void PackedAxpyWorkload(uint64_t NR_ELEMENTS) {
+	Operands<nbits, es>& d = Data<nbits, es>();
+	sw::unum::blas::axpy(NR_ELEMENTS, sw::unum::posit<nbits, es>(0.25), d.px, 1, d.py, 1);
+	d.checksum = d.py.get(NR_ELEMENTS / 2).encoding();
+}
+
+template<size_t nbits, size_t es>
+void TestPackedPerformance(const std::string& tag) {
+	using namespace std;
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	Operands<nbits, es>& d = Data<nbits, es>();
+	d.x.resize(VECTOR_SIZE);
+	d.y.resize(VECTOR_SIZE);
+	for (auto& e : d.x) e = dist(eng);
+	for (auto& e : d.y) e = dist(eng);
+	d.px = blas::packed_vector< posit<nbits, es> >(d.x);
+	d.py = blas::packed_vector< posit<nbits, es> >(d.y);
+	d.buffer.resize(VECTOR_SIZE);
+
+	cout << endl << tag << " storage: vector " << VECTOR_SIZE * sizeof(posit<nbits, es>) << " bytes, packed_vector " << d.px.bytes() << " bytes" << endl;
+	PerformanceRunner(tag + " vector        copy  ", CopyWorkload<nbits, es>, VECTOR_SIZE);
+	PerformanceRunner(tag + " packed_vector unpack", UnpackWorkload<nbits, es>, VECTOR_SIZE);
+	PerformanceRunner(tag + " vector        dot   ", DotWorkload<nbits, es>, VECTOR_SIZE);
+	PerformanceRunner(tag + " packed_vector dot   ", PackedDotWorkload<nbits, es>, VECTOR_SIZE);
+	PerformanceRunner(tag + " vector        axpy  ", AxpyWorkload<nbits, es>, VECTOR_SIZE);
+	PerformanceRunner(tag + " packed_vector axpy  ", PackedAxpyWorkload<nbits, es>, VECTOR_SIZE);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "bit-packed vector performance: elements per second" << endl;
+
+	TestPackedPerformance<10, 1>("posit<10,1>");
+	TestPackedPerformance<12, 1>("posit<12,1>");
+	TestPackedPerformance<14, 1>("posit<14,1>");
+	TestPackedPerformance<16, 1>("posit<16,1>");
+	TestPackedPerformance<48, 2>("posit<48,2>");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,154 @@
+// posit_batch.cpp: performance characterization of the array-level kernels versus the scalar posit operators
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<16,1> and posit<32,2>
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <vector>
+#include "../utils/test_helpers.hpp"
+#include "../utils/performance_runner.hpp"
+#include "posit_performance.hpp"
+
+constexpr size_t BATCH_SIZE = 1024;
+
+// scalar workloads
+template<size_t nbits, size_t es>
+void ScalarAddWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		for (size_t i = 0; i < BATCH_SIZE; ++i) o.r[i] = o.a[i] + o.b[i];
+	}
+}
+template<size_t nbits, size_t es>
+void ScalarMulWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		for (size_t i = 0; i < BATCH_SIZE; ++i) o.r[i] = o.a[i] * o.b[i];
+	}
+}
+template<size_t nbits, size_t es>
+void ScalarDivWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		for (size_t i = 0; i < BATCH_SIZE; ++i) o.r[i] = o.a[i] / o.b[i];
+	}
+}
+template<size_t nbits, size_t es>
+void ScalarFmaWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		for (size_t i = 0; i < BATCH_SIZE; ++i) convert(sw::unum::fma(o.a[i], o.b[i], o.c[i]), o.r[i]);
+	}
+}
+template<size_t nbits, size_t es>
+void ScalarToDoubleWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		for (size_t i = 0; i < BATCH_SIZE; ++i) o.v[i] = double(o.a[i]);
+	}
+}
+template<size_t nbits, size_t es>
+void ScalarFromDoubleWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		for (size_t i = 0; i < BATCH_SIZE; ++i) o.r[i] = o.v[i];
+	}
+}
+
+// batch workloads
+template<size_t nbits, size_t es>
+void BatchAddWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::posit_add_n(o.a.data(), o.b.data(), o.r.data(), BATCH_SIZE);
+}
+template<size_t nbits, size_t es>
+void BatchMulWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::posit_mul_n(o.a.data(), o.b.data(), o.r.data(), BATCH_SIZE);
+}
+template<size_t nbits, size_t es>
+void BatchDivWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::posit_div_n(o.a.data(), o.b.data(), o.r.data(), BATCH_SIZE);
+}
+template<size_t nbits, size_t es>
+void BatchFmaWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::posit_fma_n(o.a.data(), o.b.data(), o.c.data(), o.r.data(), BATCH_SIZE);
+}
+template<size_t nbits, size_t es>
+void BatchToDoubleWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::posit_to_double_n(o.a.data(), o.v.data(), BATCH_SIZE);
+}
+template<size_t nbits, size_t es>
+void BatchFromDoubleWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::posit_from_double_n(o.v.data(), o.r.data(), BATCH_SIZE);
+}
+
+// test performance of the batch kernels against the scalar operators
+template<size_t nbits, size_t es>
+void TestBatchPerformance(const std::string& tag) {
+	using namespace std;
+	cout << endl << tag << " scalar operators versus batch kernels" << endl;
+
+	uint64_t NR_OPS = 1024 * 1024;
+	sw::unum::GenerateOperands<nbits, es>(BATCH_SIZE, -1024.0, 1024.0);
+
+	PerformanceRunner(tag + " add         scalar ", ScalarAddWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " add         batch  ", BatchAddWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " mul         scalar ", ScalarMulWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " mul         batch  ", BatchMulWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " div         scalar ", ScalarDivWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " div         batch  ", BatchDivWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " fma         scalar ", ScalarFmaWorkload<nbits, es>, NR_OPS / 16);
+	PerformanceRunner(tag + " fma         batch  ", BatchFmaWorkload<nbits, es>, NR_OPS / 16);
+	PerformanceRunner(tag + " to_double   scalar ", ScalarToDoubleWorkload<nbits, es>, NR_OPS / 4);
+	PerformanceRunner(tag + " to_double   batch  ", BatchToDoubleWorkload<nbits, es>, NR_OPS / 4);
+	PerformanceRunner(tag + " from_double scalar ", ScalarFromDoubleWorkload<nbits, es>, NR_OPS / 4);
+	PerformanceRunner(tag + " from_double batch  ", BatchFromDoubleWorkload<nbits, es>, NR_OPS / 4);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "batch kernel performance";
+#if defined(LIB_USE_AVX2)
+	cout << tag << ": AVX2 lanes" << endl;
+#else
+	cout << tag << ": scalar fallback, configure with USE_AVX2 to enable the SIMD lanes" << endl;
+#endif
+
+	TestBatchPerformance<16, 1>("posit<16,1>");
+	TestBatchPerformance<32, 2>("posit<32,2>");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
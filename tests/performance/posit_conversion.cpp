@@ -0,0 +1,127 @@
+// posit_conversion.cpp: conversion throughput between double arrays and posit arrays
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: the generic posit, without the fast specializations
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <random>
+#include <vector>
+#include "../utils/test_helpers.hpp"
+#include "../utils/performance_runner.hpp"
+
+constexpr size_t CONVERSION_SIZE = 1024;
+
+// the arrays of the workloads
+template<size_t nbits, size_t es>
+struct ConversionOperands {
+	std::vector< sw::unum::posit<nbits, es> > p;
+	std::vector<double> v, w;
+};
+
+template<size_t nbits, size_t es>
+ConversionOperands<nbits, es>& Arrays() {
+	static ConversionOperands<nbits, es> arrays;
+	return arrays;
+}
+
+// doubles with random significands over a range of scales
+template<size_t nbits, size_t es>
+void GenerateArrays() {
+	std::mt19937_64 eng(0x5eed);
+	std::uniform_real_distribution<double> significand(-2.0, 2.0);
+	std::uniform_int_distribution<int> scale(-64, 64);
+	ConversionOperands<nbits, es>& arrays = Arrays<nbits, es>();
+	arrays.p.resize(CONVERSION_SIZE);
+	arrays.v.resize(CONVERSION_SIZE);
+	arrays.w.resize(CONVERSION_SIZE);
+	for (size_t i = 0; i < CONVERSION_SIZE; ++i) {
+		arrays.v[i] = std::ldexp(significand(eng), scale(eng));
+		arrays.p[i] = arrays.v[i];
+	}
+}
+
+// the conversion through a value<52> intermediate and the bitblock assembly of the posit fields
+template<size_t nbits, size_t es>
+void ValueFromDoubleWorkload(uint64_t NR_OPS) {
+	ConversionOperands<nbits, es>& a = Arrays<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += CONVERSION_SIZE) {
+		for (size_t i = 0; i < CONVERSION_SIZE; ++i) convert(sw::unum::value<52>(a.v[i]), a.p[i]);
+	}
+}
+// the conversion on the encodings
+template<size_t nbits, size_t es>
+void DirectFromDoubleWorkload(uint64_t NR_OPS) {
+	ConversionOperands<nbits, es>& a = Arrays<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += CONVERSION_SIZE) {
+		for (size_t i = 0; i < CONVERSION_SIZE; ++i) a.p[i] = a.v[i];
+	}
+}
+template<size_t nbits, size_t es>
+void BulkFromDoubleWorkload(uint64_t NR_OPS) {
+	ConversionOperands<nbits, es>& a = Arrays<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += CONVERSION_SIZE) sw::unum::convert_n(a.v.data(), a.p.data(), CONVERSION_SIZE);
+}
+// the posit to double conversion through the value<> of the decoded posit
+template<size_t nbits, size_t es>
+void ValueToDoubleWorkload(uint64_t NR_OPS) {
+	ConversionOperands<nbits, es>& a = Arrays<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += CONVERSION_SIZE) {
+		for (size_t i = 0; i < CONVERSION_SIZE; ++i) a.w[i] = a.p[i].to_value().to_double();
+	}
+}
+template<size_t nbits, size_t es>
+void BulkToDoubleWorkload(uint64_t NR_OPS) {
+	ConversionOperands<nbits, es>& a = Arrays<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += CONVERSION_SIZE) sw::unum::convert_n(a.p.data(), a.w.data(), CONVERSION_SIZE);
+}
+
+// conversion throughput of the value<> intermediates versus the direct conversions
+template<size_t nbits, size_t es>
+void TestConversionPerformance(const std::string& tag) {
+	using namespace std;
+	cout << endl << tag << " conversion throughput" << endl;
+
+	uint64_t NR_OPS = 1024 * 256;
+	GenerateArrays<nbits, es>();
+
+	PerformanceRunner(tag + " from double value<> ", ValueFromDoubleWorkload<nbits, es>, NR_OPS / 16);
+	PerformanceRunner(tag + " from double direct  ", DirectFromDoubleWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " from double convert_n", BulkFromDoubleWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " to double   value<> ", ValueToDoubleWorkload<nbits, es>, NR_OPS / 16);
+	PerformanceRunner(tag + " to double   convert_n", BulkToDoubleWorkload<nbits, es>, NR_OPS);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "conversion performance";
+	cout << tag << ": IEEE-754 double to and from generic posits" << endl;
+
+	TestConversionPerformance<16, 1>("posit<16,1>");
+	TestConversionPerformance<32, 2>("posit<32,2>");
+	TestConversionPerformance<48, 2>("posit<48,2>");
+	TestConversionPerformance<64, 3>("posit<64,3>");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
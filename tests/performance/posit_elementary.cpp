@@ -0,0 +1,118 @@
+// posit_elementary.cpp: performance characterization of the natively evaluated posit elementary functions
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<16,1> and posit<32,2>
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <vector>
+#include "../utils/test_helpers.hpp"
+#include "../utils/performance_runner.hpp"
+#include "posit_performance.hpp"
+
+constexpr size_t NR_OPERANDS = 1024;
+
+template<size_t nbits, size_t es>
+void ExpWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; ++n) o.r[n % NR_OPERANDS] = sw::unum::exp(o.b[n % NR_OPERANDS]);
+}
+template<size_t nbits, size_t es>
+void LogWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; ++n) o.r[n % NR_OPERANDS] = sw::unum::log(o.a[n % NR_OPERANDS]);
+}
+template<size_t nbits, size_t es>
+void SinWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; ++n) o.r[n % NR_OPERANDS] = sw::unum::sin(o.a[n % NR_OPERANDS]);
+}
+template<size_t nbits, size_t es>
+void AtanWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; ++n) o.r[n % NR_OPERANDS] = sw::unum::atan(o.a[n % NR_OPERANDS]);
+}
+template<size_t nbits, size_t es>
+void TanhWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; ++n) o.r[n % NR_OPERANDS] = sw::unum::tanh(o.b[n % NR_OPERANDS]);
+}
+template<size_t nbits, size_t es>
+void PowWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; ++n) o.r[n % NR_OPERANDS] = sw::unum::pow(o.a[n % NR_OPERANDS], o.b[n % NR_OPERANDS]);
+}
+
+// the double precision round trip that the elementary functions used to be: not correctly rounded
+template<size_t nbits, size_t es>
+void ExpViaDoubleWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; ++n) o.r[n % NR_OPERANDS] = std::exp(double(o.b[n % NR_OPERANDS]));
+}
+template<size_t nbits, size_t es>
+void SinViaDoubleWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; ++n) o.r[n % NR_OPERANDS] = std::sin(double(o.a[n % NR_OPERANDS]));
+}
+
+// measure the throughput of the elementary functions of a posit configuration
+template<size_t nbits, size_t es>
+void TestElementaryPerformance(const std::string& tag, uint64_t NR_OPS) {
+	using namespace std;
+	cout << endl << tag << " elementary functions" << endl;
+
+	// operands in (0, 16], the domain of all the functions that are measured, and exponents in (0, 4]
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::GenerateOperands<nbits, es>(NR_OPERANDS, 1.0 / 1024.0, 16.0);
+	for (size_t i = 0; i < NR_OPERANDS; ++i) o.b[i] /= 4.0;
+
+	PerformanceRunner(tag + " exp              ", ExpWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " exp   via double ", ExpViaDoubleWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " log              ", LogWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " sin              ", SinWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " sin   via double ", SinViaDoubleWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " atan             ", AtanWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " tanh             ", TanhWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " pow              ", PowWorkload<nbits, es>, NR_OPS / 2);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "elementary function performance";
+	cout << tag << ": posits up to " << POSIT_ELEMENTARY_LOOKUP_NBITS << " bits use lookup tables" << endl;
+
+	TestElementaryPerformance<8, 0>("posit<8,0>    ", 1024 * 1024);
+	TestElementaryPerformance<16, 1>("posit<16,1>   ", 64 * 1024);
+	TestElementaryPerformance<32, 2>("posit<32,2>   ", 64 * 1024);
+	TestElementaryPerformance<64, 3>("posit<64,3>   ", 16 * 1024);
+	TestElementaryPerformance<128, 4>("posit<128,4>  ", 4 * 1024);
+	TestElementaryPerformance<256, 5>("posit<256,5>  ", 1024);
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -52,6 +52,13 @@ namespace unum {
 		return ss.str();
 	}
 	static constexpr int NR_TEST_CASES = 100000;
+	// the workloads fold their results into this sink so that the compiler can't elide the arithmetic
+	inline volatile unsigned long long performance_sink = 0;
+	// the bits of a result that are folded into the sink: the encoding of posits up to 64 bits, the lsb of wider posits
+	template<size_t nbits, size_t es>
+	inline unsigned long long sink_bits(const posit<nbits, es>& p) {
+		if constexpr (nbits <= 64) return p.encoding(); else return p.get().test(0) ? 1ull : 0ull;
+	}
 	static constexpr unsigned FLOAT_TABLE_WIDTH = 15;
 
 	template<size_t nbits, size_t es>
@@ -75,11 +82,14 @@ namespace unum {
 	int MeasureIntegerConversionPerformance(int &positives, int &negatives) {
 		posit<nbits, es> p(0);
 
+		unsigned long long checksum = 0;
 		positives = 0, negatives = 0;
 		for (int i = -(NR_TEST_CASES >> 1); i < (NR_TEST_CASES >> 1); ++i) {
 			p = i;
 			p >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(p);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -89,11 +99,14 @@ namespace unum {
 	int MeasureIeeeConversionPerformance(int &positives, int &negatives) {
 		posit<nbits, es> p(0);
 
+		unsigned long long checksum = 0;
 		positives = 0, negatives = 0;
 		for (int i = 1; i < NR_TEST_CASES; i++) {
 			p = 1.0;
 			p >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(p);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -103,11 +116,14 @@ namespace unum {
 	int MeasurePostfixPerformance(int &positives, int &negatives)	{
 		posit<nbits, es> p(0);
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 1; i < NR_TEST_CASES; i++) {
 			p++;
 			p >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(p);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -117,11 +133,14 @@ namespace unum {
 	int MeasurePrefixPerformance(int &positives, int &negatives) {
 		posit<nbits, es> p(0);
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 1; i < NR_TEST_CASES; i++) {
 			++p;
 			p >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(p);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -131,6 +150,7 @@ namespace unum {
 	int MeasureNegationPerformance(int &positives, int &negatives) {
 		posit<nbits, es> pa(0);
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 1; i < NR_TEST_CASES; i++) {
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
@@ -150,7 +170,9 @@ namespace unum {
 			pa = -pa;
 #endif
 			pa >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(pa);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -159,6 +181,7 @@ namespace unum {
 	int MeasureSqrtPerformance(int &positives, int &negatives) {		
 		posit<nbits, es> pa, psqrt;
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 0; i < NR_TEST_CASES; i++) {
 			pa.set_raw_bits(i);
@@ -180,7 +203,9 @@ namespace unum {
 #endif
 
 			psqrt >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(psqrt);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -189,6 +214,7 @@ namespace unum {
 	int MeasureAdditionPerformance(int &positives, int &negatives) {
 		posit<nbits, es> pa(1), pb, psum;
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 0; i < NR_TEST_CASES; i++) {
 			pb.set_raw_bits(i);
@@ -209,7 +235,9 @@ namespace unum {
 			psum = pa + pb;
 #endif
 			psum >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(psum);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -218,6 +246,7 @@ namespace unum {
 	int MeasureSubtractionPerformance(int &positives, int &negatives) {
 		posit<nbits, es> pa(1), pb, pdif;
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 0; i < NR_TEST_CASES; i++) {
 			pb.set_raw_bits(i);
@@ -238,7 +267,9 @@ namespace unum {
 			pdif = pa - pb;
 #endif
 			pdif >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(pdif);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -247,6 +278,7 @@ namespace unum {
 	int MeasureMultiplicationPerformance(int &positives, int &negatives) {
 		posit<nbits, es> pa(1), pb, pmul;
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 0; i < NR_TEST_CASES; i++) {
 			pb.set_raw_bits(i);
@@ -268,7 +300,9 @@ namespace unum {
 #endif
 
 			pmul >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(pmul);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -277,11 +311,14 @@ namespace unum {
 	int MeasureReciprocationPerformance(int &positives, int &negatives) {
 		posit<nbits, es> pa(0); ++pa; // minpos
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 0; i < NR_TEST_CASES; i++) {
 			pa = pa.reciprocate();
 			pa >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(pa);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -290,6 +327,7 @@ namespace unum {
 	int MeasureDivisionPerformance(int &positives, int &negatives) {
 		posit<nbits, es> pa(1), pb, pdiv;
 
+		unsigned long long checksum = 0;
 		positives = 0; negatives = 0;
 		for (int i = 0; i < NR_TEST_CASES; i++) {
 			pb.set_raw_bits(i);
@@ -328,7 +366,9 @@ namespace unum {
 			pdiv = pa / pb;
 #endif
 			pdiv >= 0 ? positives++ : negatives++;
+			checksum ^= sink_bits(pdiv);
 		}
+		performance_sink = checksum;
 		return positives + negatives;
 	}
 
@@ -519,6 +559,42 @@ namespace unum {
 		report.div = float((positives + negatives) / elapsed);
 	}
 
+	// the operand arrays of the array-level workloads of a posit configuration:
+	// a, b, and c hold random posits, r receives the results, and v holds random doubles
+	template<size_t nbits, size_t es>
+	struct PositOperands {
+		std::vector< posit<nbits, es> > a, b, c, r;
+		std::vector<double> v;
+	};
+
+	// the operand arrays of a posit configuration, shared by all the workloads of that configuration
+	template<size_t nbits, size_t es>
+	PositOperands<nbits, es>& Operands() {
+		static PositOperands<nbits, es> operands;
+		return operands;
+	}
+
+	// fill the operand arrays of a posit configuration with n random values in [lo, hi)
+	// the generator is seeded with a constant so that every run measures the same operands
+	template<size_t nbits, size_t es>
+	PositOperands<nbits, es>& GenerateOperands(size_t n, double lo, double hi) {
+		std::mt19937_64 eng(0x5eed);
+		std::uniform_real_distribution<double> dist(lo, hi);
+		PositOperands<nbits, es>& operands = Operands<nbits, es>();
+		operands.a.resize(n);
+		operands.b.resize(n);
+		operands.c.resize(n);
+		operands.r.resize(n);
+		operands.v.resize(n);
+		for (size_t i = 0; i < n; ++i) {
+			operands.a[i] = dist(eng);
+			operands.b[i] = dist(eng);
+			operands.c[i] = dist(eng);
+			operands.v[i] = dist(eng);
+		}
+		return operands;
+	}
+
 } // namespace unum
 } // namespace sw
 
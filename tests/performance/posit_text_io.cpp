@@ -0,0 +1,166 @@
+// posit_text_io.cpp: performance characterization of the character conversions versus the stream operators
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<16,1> and posit<32,2>
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <sstream>
+#include <vector>
+#include "../utils/test_helpers.hpp"
+#include "../utils/performance_runner.hpp"
+#include "posit_performance.hpp"
+
+constexpr size_t BATCH_SIZE = 1024;
+
+// the text of the operands: the decimal and hex text of a, one posit per line, and a buffer to format into
+template<size_t nbits, size_t es>
+struct TextBuffers {
+	std::vector<char> buffer;
+	std::string decimal, hex;
+};
+
+template<size_t nbits, size_t es>
+TextBuffers<nbits, es>& Text() {
+	static TextBuffers<nbits, es> text;
+	return text;
+}
+
+// generate random operands in the range [-1024, 1024] and their text
+template<size_t nbits, size_t es>
+void GenerateText() {
+	using namespace sw::unum;
+	PositOperands<nbits, es>& operands = GenerateOperands<nbits, es>(BATCH_SIZE, -1024.0, 1024.0);
+	TextBuffers<nbits, es>& text = Text<nbits, es>();
+	text.buffer.resize(BATCH_SIZE * 48);
+	char* first = text.buffer.data();
+	char* last = first + text.buffer.size();
+	text.decimal.assign(first, to_chars_n(first, last, operands.a.data(), BATCH_SIZE, '\n').ptr);
+	text.hex.assign(first, to_chars_n(first, last, operands.a.data(), BATCH_SIZE, '\n', posit_chars_format::hex).ptr);
+}
+
+// stream operator workloads
+template<size_t nbits, size_t es>
+void StreamWriteDecimalWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		std::stringstream ss;
+		ss << std::setprecision(17);
+		for (size_t i = 0; i < BATCH_SIZE; ++i) ss << o.a[i] << '\n';
+	}
+}
+template<size_t nbits, size_t es>
+void StreamWriteHexWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		std::stringstream ss;
+		for (size_t i = 0; i < BATCH_SIZE; ++i) ss << sw::unum::hex_format(o.a[i]) << '\n';
+	}
+}
+template<size_t nbits, size_t es>
+void StreamReadDecimalWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	TextBuffers<nbits, es>& t = Text<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		std::stringstream ss(t.decimal);
+		for (size_t i = 0; i < BATCH_SIZE; ++i) ss >> o.b[i];
+	}
+}
+template<size_t nbits, size_t es>
+void StreamReadHexWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	TextBuffers<nbits, es>& t = Text<nbits, es>();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) {
+		std::stringstream ss(t.hex);
+		for (size_t i = 0; i < BATCH_SIZE; ++i) ss >> o.b[i];
+	}
+}
+
+// character conversion workloads
+template<size_t nbits, size_t es>
+void CharsWriteDecimalWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	TextBuffers<nbits, es>& t = Text<nbits, es>();
+	char* first = t.buffer.data();
+	char* last = first + t.buffer.size();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::to_chars_n(first, last, o.a.data(), BATCH_SIZE, '\n');
+}
+template<size_t nbits, size_t es>
+void CharsWriteHexWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	TextBuffers<nbits, es>& t = Text<nbits, es>();
+	char* first = t.buffer.data();
+	char* last = first + t.buffer.size();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::to_chars_n(first, last, o.a.data(), BATCH_SIZE, '\n', sw::unum::posit_chars_format::hex);
+}
+template<size_t nbits, size_t es>
+void CharsReadDecimalWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	TextBuffers<nbits, es>& t = Text<nbits, es>();
+	const char* first = t.decimal.data();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::from_chars_n(first, first + t.decimal.size(), o.b.data(), BATCH_SIZE);
+}
+template<size_t nbits, size_t es>
+void CharsReadHexWorkload(uint64_t NR_OPS) {
+	sw::unum::PositOperands<nbits, es>& o = sw::unum::Operands<nbits, es>();
+	TextBuffers<nbits, es>& t = Text<nbits, es>();
+	const char* first = t.hex.data();
+	for (uint64_t n = 0; n < NR_OPS; n += BATCH_SIZE) sw::unum::from_chars_n(first, first + t.hex.size(), o.b.data(), BATCH_SIZE);
+}
+
+// test performance of the character conversions against the stream operators
+template<size_t nbits, size_t es>
+void TestTextPerformance(const std::string& tag) {
+	using namespace std;
+	cout << endl << tag << " stream operators versus character conversions" << endl;
+
+	uint64_t NR_OPS = 256 * 1024;
+	GenerateText<nbits, es>();
+
+	PerformanceRunner(tag + " write decimal stream ", StreamWriteDecimalWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " write decimal chars  ", CharsWriteDecimalWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " write hex     stream ", StreamWriteHexWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " write hex     chars  ", CharsWriteHexWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " read  decimal stream ", StreamReadDecimalWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " read  decimal chars  ", CharsReadDecimalWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " read  hex     stream ", StreamReadHexWorkload<nbits, es>, NR_OPS);
+	PerformanceRunner(tag + " read  hex     chars  ", CharsReadHexWorkload<nbits, es>, NR_OPS);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	cout << "posit text conversion performance" << endl;
+
+	TestTextPerformance<16, 1>("posit<16,1>");
+	TestTextPerformance<32, 2>("posit<32,2>");
+	TestTextPerformance<64, 3>("posit<64,3>");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
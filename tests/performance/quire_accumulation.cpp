@@ -0,0 +1,112 @@
+// quire_accumulation.cpp: performance characterization of quire accumulation for the standard posit configurations
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include "../utils/test_helpers.hpp"
+#include "../utils/performance_runner.hpp"
+#include "posit_performance.hpp"
+
+constexpr size_t NR_OPERANDS = 1024;
+
+// the set of unrounded products that are accumulated by the workloads
+template<size_t nbits, size_t es>
+std::vector< sw::unum::value<2 * (nbits - 2 - es)> >& Products() {
+	static std::vector< sw::unum::value<2 * (nbits - 2 - es)> > products;
+	return products;
+}
+
+// generate random operands in the range [-1, 1] so that the accumulation exercises carry and borrow propagation
+template<size_t nbits, size_t es>
+void GenerateProducts() {
+	sw::unum::PositOperands<nbits, es>& operands = sw::unum::GenerateOperands<nbits, es>(NR_OPERANDS, -1.0, 1.0);
+	std::vector< sw::unum::value<2 * (nbits - 2 - es)> >& products = Products<nbits, es>();
+	products.resize(NR_OPERANDS);
+	for (size_t i = 0; i < NR_OPERANDS; ++i) {
+		products[i] = sw::unum::quire_mul(operands.a[i], operands.b[i]);
+	}
+}
+
+// workload for accumulating unrounded products into a quire
+template<size_t nbits, size_t es>
+void QuireAccumulationWorkload(uint64_t NR_OPS) {
+	const std::vector< sw::unum::value<2 * (nbits - 2 - es)> >& products = Products<nbits, es>();
+	sw::unum::quire<nbits, es> q;
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		q += products[i % NR_OPERANDS];
+	}
+	if (q.iszero()) std::cout << "quire accumulation yielded zero\n";
+}
+
+// workload for the fused multiply-accumulate q += quire_mul(a, b)
+template<size_t nbits, size_t es>
+void QuireFusedMultiplyAccumulateWorkload(uint64_t NR_OPS) {
+	const sw::unum::PositOperands<nbits, es>& operands = sw::unum::Operands<nbits, es>();
+	sw::unum::quire<nbits, es> q;
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		size_t index = i % NR_OPERANDS;
+		q += sw::unum::quire_mul(operands.a[index], operands.b[index]);
+	}
+	if (q.iszero()) std::cout << "quire fused multiply-accumulate yielded zero\n";
+}
+
+// test performance of quire accumulation
+void TestQuireAccumulationPerformance() {
+	using namespace std;
+	cout << endl << "Quire accumulation performance" << endl;
+
+	uint64_t NR_OPS = 1000000;
+
+	GenerateProducts<16, 1>();
+	GenerateProducts<32, 2>();
+	GenerateProducts<64, 3>();
+
+	PerformanceRunner("quire<16,1>   accumulation       ", QuireAccumulationWorkload<16, 1>, NR_OPS);
+	PerformanceRunner("quire<32,2>   accumulation       ", QuireAccumulationWorkload<32, 2>, NR_OPS);
+	PerformanceRunner("quire<64,3>   accumulation       ", QuireAccumulationWorkload<64, 3>, NR_OPS);
+
+	PerformanceRunner("quire<16,1>   fused mul-acc      ", QuireFusedMultiplyAccumulateWorkload<16, 1>, NR_OPS / 4);
+	PerformanceRunner("quire<32,2>   fused mul-acc      ", QuireFusedMultiplyAccumulateWorkload<32, 2>, NR_OPS / 4);
+	PerformanceRunner("quire<64,3>   fused mul-acc      ", QuireFusedMultiplyAccumulateWorkload<64, 3>, NR_OPS / 8);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "quire accumulation performance";
+
+	cout << tag << endl;
+
+	TestQuireAccumulationPerformance();
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
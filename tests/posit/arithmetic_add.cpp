@@ -53,6 +53,8 @@ try {
 	using namespace std;
 	using namespace sw::unum;
 
+	if (!ParseVerificationArguments(argc, argv)) return EXIT_FAILURE;
+
 	bool bReportIndividualTestCases = false;
 	int nrOfFailedTestCases = 0;
 
@@ -53,6 +53,7 @@ try {
 	using namespace std;
 	using namespace sw::unum;
 
+	if (!ParseVerificationArguments(argc, argv)) return EXIT_FAILURE;
 
 	std::string tag = "Conversion test";
 
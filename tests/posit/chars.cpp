@@ -0,0 +1,255 @@
+// chars.cpp: functional tests of the allocation-free character conversions of posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// enable the fast posit<16,1> and posit<32,2> to cover the specialized encodings
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+#include <universal/posit/posit>
+#include <random>
+#include <sstream>
+#include <vector>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// round trip a posit through its text form and compare the text to the stream operators
+template<size_t nbits, size_t es>
+int VerifyRoundTrip(const sw::unum::posit<nbits, es>& p, const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	char buffer[256];
+	posit<nbits, es> q;
+
+	// hex: identical to hex_format, and exact for all posits
+	std::to_chars_result w = to_chars(buffer, buffer + sizeof(buffer), p, posit_chars_format::hex);
+	std::string hex(buffer, w.ptr);
+	std::from_chars_result r = from_chars(buffer, w.ptr, q);
+	if (w.ec != std::errc() || hex != hex_format(p) || r.ec != std::errc() || r.ptr != w.ptr || q != p) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " FAIL hex     " << hex << " vs " << hex_format(p) << " parsed " << hex_format(q) << std::endl;
+	}
+
+	// shortest decimal: exact when the native floating-point type represents the posit
+	w = to_chars(buffer, buffer + sizeof(buffer), p);
+	r = from_chars(buffer, w.ptr, q);
+	if (w.ec != std::errc() || r.ec != std::errc() || r.ptr != w.ptr || q != p) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " FAIL decimal " << std::string(buffer, w.ptr) << " vs " << hex_format(p) << " parsed " << hex_format(q) << std::endl;
+	}
+
+	// fixed precision: the text of operator<<
+	w = to_chars(buffer, buffer + sizeof(buffer), p, 6);
+	std::stringstream ss;
+	ss << p;
+	if (w.ec != std::errc() || std::string(buffer, w.ptr) != ss.str()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " FAIL stream  " << std::string(buffer, w.ptr) << " vs " << ss.str() << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyExhaustiveRoundTrip(const std::string& tag, bool bReportIndividualTestCases) {
+	constexpr size_t NR_POSITS = (size_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	sw::unum::posit<nbits, es> p;
+	for (size_t i = 0; i < NR_POSITS; ++i) {
+		p.set_raw_bits(i);
+		nrOfFailedTests += VerifyRoundTrip(p, tag, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyRandomRoundTrip(const std::string& tag, size_t nrRandoms, bool bReportIndividualTestCases) {
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTests = 0;
+	sw::unum::posit<nbits, es> p;
+	for (size_t i = 0; i < nrRandoms; ++i) {
+		p.set_raw_bits(eng());
+		nrOfFailedTests += VerifyRoundTrip(p, tag, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+// posits wider than 64 bits only round trip through the hex format
+template<size_t nbits, size_t es>
+int VerifyWideHexRoundTrip(const std::string& tag, size_t nrRandoms, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTests = 0;
+	char buffer[256];
+	posit<nbits, es> p, q;
+	for (size_t i = 0; i < nrRandoms; ++i) {
+		bitblock<nbits> raw;
+		for (size_t b = 0; b < nbits; ++b) raw[b] = bool(eng() & 1);
+		p.set(raw);
+		std::to_chars_result w = to_chars(buffer, buffer + sizeof(buffer), p, posit_chars_format::hex);
+		std::from_chars_result r = from_chars(buffer, w.ptr, q);
+		if (w.ec != std::errc() || std::string(buffer, w.ptr) != hex_format(p) || r.ec != std::errc() || q != p) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL hex " << std::string(buffer, w.ptr) << " vs " << hex_format(p) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// parse special forms and malformed text
+int VerifyParsing(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	struct testcase { const char* txt; std::errc ec; size_t consumed; double value; };
+	const testcase cases[] = {
+		{ "1.5",            std::errc(), 3, 1.5 },
+		{ "+1.5",           std::errc(), 4, 1.5 },
+		{ "-0.25e2",        std::errc(), 7, -25.0 },
+		{ "32.2x40000000p", std::errc(), 14, 1.0 },
+		{ "32.2X40000000",  std::errc(), 13, 1.0 },
+		{ "16.1x4000p",     std::errc(), 10, 1.0 },   // aligned at the most significant bit
+		{ "64.3x4000000000000000p", std::errc(), 22, 1.0 },
+		{ "32.2xc0000000p", std::errc(), 14, -1.0 },
+		{ "1.5 2.5",        std::errc(), 3, 1.5 },
+		{ "32.2xp",         std::errc::invalid_argument, 0, 0.0 },
+		{ "abc",            std::errc::invalid_argument, 0, 0.0 },
+		{ "+-1",            std::errc::invalid_argument, 0, 0.0 },
+		{ "",               std::errc::invalid_argument, 0, 0.0 },
+	};
+	for (const testcase& c : cases) {
+		posit<32, 2> p(0);
+		const char* last = c.txt + std::char_traits<char>::length(c.txt);
+		std::from_chars_result r = from_chars(c.txt, last, p);
+		bool pass = r.ec == c.ec && size_t(r.ptr - c.txt) == c.consumed && (r.ec != std::errc() || double(p) == c.value);
+		if (!pass) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL parse -" << c.txt << "- consumed " << (r.ptr - c.txt) << " value " << p << std::endl;
+		}
+	}
+	const char* nar = "NaR";
+	posit<32, 2> p(0);
+	std::from_chars_result r = from_chars(nar, nar + 3, p);
+	if (r.ec != std::errc() || !p.isnar()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " FAIL parse -NaR-" << std::endl;
+	}
+	// parse() skips leading whitespace and rejects text that remains after the posit
+	struct parsecase { const char* txt; bool success; double value; };
+	const parsecase parsecases[] = {
+		{ "1.5",              true,  1.5 },
+		{ "  \t1.5",          true,  1.5 },
+		{ " 32.2x40000000p",  true,  1.0 },
+		{ "NaR",              true,  0.0 },
+		{ "1.5 2.5",          false, 0.0 },
+		{ "1.5abc",           false, 0.0 },
+		{ "32.2x40000000pp",  false, 0.0 },
+		{ "1.5 ",             false, 0.0 },
+		{ "   ",              false, 0.0 },
+		{ "",                 false, 0.0 },
+	};
+	for (const parsecase& c : parsecases) {
+		posit<32, 2> q(0.125);
+		bool success = parse(c.txt, q);
+		bool pass = (success == c.success) && (success ? (q.isnar() || double(q) == c.value) : double(q) == 0.125);
+		if (!pass) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL parse() -" << c.txt << "- " << (success ? "accepted" : "rejected") << " value " << q << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// format and parse arrays
+template<size_t nbits, size_t es>
+int VerifyBulkConversion(const std::string& tag, sw::unum::posit_chars_format format, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	constexpr size_t N = 1000;
+	std::mt19937_64 eng(0x5eed);
+	std::vector< posit<nbits, es> > a(N), b(N);
+	for (auto& p : a) p.set_raw_bits(eng());
+	std::vector<char> buffer(N * 48);
+	int nrOfFailedTests = 0;
+
+	to_chars_n_result w = to_chars_n(buffer.data(), buffer.data() + buffer.size(), a.data(), N, '\n', format);
+	from_chars_n_result r = from_chars_n(buffer.data(), w.ptr, b.data(), N);
+	if (w.ec != std::errc() || w.count != N || r.ec != std::errc() || r.count != N || r.ptr != w.ptr || a != b) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " FAIL bulk round trip: formatted " << w.count << " parsed " << r.count << std::endl;
+	}
+
+	// a buffer that is too small ends at the last complete element
+	w = to_chars_n(buffer.data(), buffer.data() + 100, a.data(), N, ',', format);
+	r = from_chars_n(buffer.data(), w.ptr, b.data(), N);
+	if (w.ec != std::errc::value_too_large || w.count == 0 || w.count >= N || r.ec != std::errc() || r.count != w.count) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " FAIL bulk partial: formatted " << w.count << " parsed " << r.count << std::endl;
+	}
+
+	// a malformed element stops the conversion
+	const char* txt = "1.0 2.0 three 4.0";
+	r = from_chars_n(txt, txt + std::char_traits<char>::length(txt), b.data(), N);
+	if (r.ec != std::errc::invalid_argument || r.count != 2 || r.ptr != txt + 8) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << tag << " FAIL bulk malformed: parsed " << r.count << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "character conversion failed: ";
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip<8, 0>(tag, true), "posit<8,0>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyParsing(tag, true), "posit<32,2>", "parsing");
+
+#else
+
+	cout << "Posit character conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip<8, 0>(tag, bReportIndividualTestCases), "posit<8,0>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip<8, 2>(tag, bReportIndividualTestCases), "posit<8,2>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip<10, 1>(tag, bReportIndividualTestCases), "posit<10,1>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomRoundTrip<32, 2>(tag, 10000, bReportIndividualTestCases), "posit<32,2>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomRoundTrip<48, 2>(tag, 1000, bReportIndividualTestCases), "posit<48,2>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomRoundTrip<64, 3>(tag, 1000, bReportIndividualTestCases), "posit<64,3>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideHexRoundTrip<80, 2>(tag, 1000, bReportIndividualTestCases), "posit<80,2>", "hex round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyParsing(tag, bReportIndividualTestCases), "posit<32,2>", "parsing");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkConversion<16, 1>(tag, posit_chars_format::decimal, bReportIndividualTestCases), "posit<16,1>", "bulk decimal");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkConversion<32, 2>(tag, posit_chars_format::hex, bReportIndividualTestCases), "posit<32,2>", "bulk hex");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomRoundTrip<32, 2>(tag, 10000000, bReportIndividualTestCases), "posit<32,2>", "round trip");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
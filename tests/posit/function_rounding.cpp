@@ -0,0 +1,136 @@
+// function_rounding.cpp: correct rounding tests of the elementary functions of large posit configurations
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/posit_manipulators.hpp"
+#include "universal/posit/math/exponent.hpp"
+#include "universal/posit/math/logarithm.hpp"
+#include "universal/posit/math/trigonometry.hpp"
+#include "universal/posit/math/hyperbolic.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_math_helpers.hpp"
+
+// the elementary functions as posit and long double callables
+#define ELEMENTARY_FUNCTION(fn) \
+	[](const sw::unum::posit<nbits, es>& x) { return sw::unum::fn(x); }, \
+	[](long double x) { return std::fn(x); }
+
+// correct rounding against the long double math library: posit configurations with up to 64 fraction bits
+template<size_t nbits, size_t es>
+int ValidateAgainstLongDouble(const std::string& tag, bool bReportIndividualTestCases, unsigned nrRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("exp",   ELEMENTARY_FUNCTION(exp),   bReportIndividualTestCases, nrRandoms), tag, "exp");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("exp2",  ELEMENTARY_FUNCTION(exp2),  bReportIndividualTestCases, nrRandoms), tag, "exp2");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("expm1", ELEMENTARY_FUNCTION(expm1), bReportIndividualTestCases, nrRandoms), tag, "expm1");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("log",   ELEMENTARY_FUNCTION(log),   bReportIndividualTestCases, nrRandoms), tag, "log");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("log2",  ELEMENTARY_FUNCTION(log2),  bReportIndividualTestCases, nrRandoms), tag, "log2");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("log10", ELEMENTARY_FUNCTION(log10), bReportIndividualTestCases, nrRandoms), tag, "log10");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("log1p", ELEMENTARY_FUNCTION(log1p), bReportIndividualTestCases, nrRandoms), tag, "log1p");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("sin",   ELEMENTARY_FUNCTION(sin),   bReportIndividualTestCases, nrRandoms), tag, "sin");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("cos",   ELEMENTARY_FUNCTION(cos),   bReportIndividualTestCases, nrRandoms), tag, "cos");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("tan",   ELEMENTARY_FUNCTION(tan),   bReportIndividualTestCases, nrRandoms), tag, "tan");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("atan",  ELEMENTARY_FUNCTION(atan),  bReportIndividualTestCases, nrRandoms), tag, "atan");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("asin",  ELEMENTARY_FUNCTION(asin),  bReportIndividualTestCases, nrRandoms), tag, "asin");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("acos",  ELEMENTARY_FUNCTION(acos),  bReportIndividualTestCases, nrRandoms), tag, "acos");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("sinh",  ELEMENTARY_FUNCTION(sinh),  bReportIndividualTestCases, nrRandoms), tag, "sinh");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("cosh",  ELEMENTARY_FUNCTION(cosh),  bReportIndividualTestCases, nrRandoms), tag, "cosh");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("tanh",  ELEMENTARY_FUNCTION(tanh),  bReportIndividualTestCases, nrRandoms), tag, "tanh");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("asinh", ELEMENTARY_FUNCTION(asinh), bReportIndividualTestCases, nrRandoms), tag, "asinh");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("acosh", ELEMENTARY_FUNCTION(acosh), bReportIndividualTestCases, nrRandoms), tag, "acosh");
+	nrOfFailedTestCases += ReportTestResult(ValidateCorrectRounding<nbits, es>("atanh", ELEMENTARY_FUNCTION(atanh), bReportIndividualTestCases, nrRandoms), tag, "atanh");
+	return nrOfFailedTestCases;
+}
+
+// the posit callable of an elementary function
+#define POSIT_FUNCTION(fn) \
+	internal::elementary_function::fn, [](const sw::unum::posit<nbits, es>& x) { return sw::unum::fn(x); }
+
+// correct rounding against an evaluation at a higher working precision: posit configurations beyond long double
+template<size_t nbits, size_t es>
+int ValidateAgainstWorkingPrecision(const std::string& tag, bool bReportIndividualTestCases, unsigned nrRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("exp",   POSIT_FUNCTION(exp),   bReportIndividualTestCases, nrRandoms), tag, "exp");
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("log",   POSIT_FUNCTION(log),   bReportIndividualTestCases, nrRandoms), tag, "log");
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("log10", POSIT_FUNCTION(log10), bReportIndividualTestCases, nrRandoms), tag, "log10");
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("sin",   POSIT_FUNCTION(sin),   bReportIndividualTestCases, nrRandoms), tag, "sin");
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("cos",   POSIT_FUNCTION(cos),   bReportIndividualTestCases, nrRandoms), tag, "cos");
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("tan",   POSIT_FUNCTION(tan),   bReportIndividualTestCases, nrRandoms), tag, "tan");
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("atan",  POSIT_FUNCTION(atan),  bReportIndividualTestCases, nrRandoms), tag, "atan");
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("tanh",  POSIT_FUNCTION(tanh),  bReportIndividualTestCases, nrRandoms), tag, "tanh");
+	nrOfFailedTestCases += ReportTestResult(ValidateWorkingPrecision<nbits, es>("asinh", POSIT_FUNCTION(asinh), bReportIndividualTestCases, nrRandoms), tag, "asinh");
+	return nrOfFailedTestCases;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = true;
+	int nrOfFailedTestCases = 0;
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ValidateAgainstLongDouble<32, 2>("posit<32,2>", bReportIndividualTestCases, 100);
+	nrOfFailedTestCases += ValidateAgainstWorkingPrecision<128, 4>("posit<128,4>", bReportIndividualTestCases, 10);
+
+#else
+
+	cout << "Posit elementary function correct rounding validation" << endl;
+
+	nrOfFailedTestCases += ValidateAgainstLongDouble<16, 1>("posit<16,1>", bReportIndividualTestCases, 1000);
+	nrOfFailedTestCases += ValidateAgainstLongDouble<32, 2>("posit<32,2>", bReportIndividualTestCases, 1000);
+	nrOfFailedTestCases += ValidateAgainstLongDouble<64, 3>("posit<64,3>", bReportIndividualTestCases, 1000);
+
+	nrOfFailedTestCases += ValidateAgainstWorkingPrecision<128, 4>("posit<128,4>", bReportIndividualTestCases, 100);
+	nrOfFailedTestCases += ValidateAgainstWorkingPrecision<256, 5>("posit<256,5>", bReportIndividualTestCases, 25);
+
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundingBoundary<32, 2>(bReportIndividualTestCases), "posit<32,2>", "rounding boundary");
+	nrOfFailedTestCases += ReportTestResult(ValidateRoundingBoundary<128, 4>(bReportIndividualTestCases), "posit<128,4>", "rounding boundary");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ValidateAgainstLongDouble<32, 2>("posit<32,2>", bReportIndividualTestCases, 100000);
+	nrOfFailedTestCases += ValidateAgainstLongDouble<64, 3>("posit<64,3>", bReportIndividualTestCases, 100000);
+
+	nrOfFailedTestCases += ValidateAgainstWorkingPrecision<128, 4>("posit<128,4>", bReportIndividualTestCases, 10000);
+	nrOfFailedTestCases += ValidateAgainstWorkingPrecision<256, 5>("posit<256,5>", bReportIndividualTestCases, 1000);
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,170 @@
+// ieee_conversion.cpp: tests of the direct conversions between IEEE-754 float/double and posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// the reference conversion through the value<> intermediate
+template<size_t nbits, size_t es, typename Real>
+sw::unum::posit<nbits, es> ReferenceConversion(Real v) {
+	constexpr int dfbits = std::numeric_limits<Real>::digits - 1;
+	sw::unum::value<dfbits> vv(v);
+	sw::unum::posit<nbits, es> p;
+	if (vv.iszero()) p.setzero(); else if (vv.isinf() || vv.isnan()) p.setnar(); else convert(vv, p);
+	return p;
+}
+
+// random bit patterns, and values around the dynamic range of the posit, against the reference conversion
+template<size_t nbits, size_t es, typename Real>
+int VerifyIeeeToPosit(int nrOfRandoms, bool bReportIndividualTestCases) {
+	using Bits = typename std::conditional<sizeof(Real) == 4, uint32_t, uint64_t>::type;
+	std::mt19937_64 eng(nbits * 64 + es);
+	int nrOfFailedTestCases = 0;
+	for (int i = 0; i < nrOfRandoms; ++i) {
+		Real v;
+		if (i & 1) {
+			Bits raw = Bits(eng());
+			std::memcpy(&v, &raw, sizeof(v));
+		}
+		else {
+			int scale = int(eng() % ((nbits + 2) << (es + 1))) - int((nbits + 2) << es);
+			v = Real(std::ldexp(double(eng() >> 11), scale - 52)) * ((eng() & 1) ? Real(-1) : Real(1));
+		}
+		sw::unum::posit<nbits, es> p(v), ref = ReferenceConversion<nbits, es>(v);
+		if (p != ref) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << v << " -> " << p.get() << " instead of " << ref.get() << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// every encoding of a posit with at most 53 bits of precision round trips through double,
+// and converts to float as the double rounded once
+template<size_t nbits, size_t es>
+int VerifyExhaustiveRoundTrip(bool bReportIndividualTestCases) {
+	int nrOfFailedTestCases = 0;
+	sw::unum::posit<nbits, es> p, q;
+	for (uint64_t i = 0; i < (uint64_t(1) << nbits); ++i) {
+		p.set_raw_bits(i);
+		double d = double(p);
+		q = d;
+		bool fail = p.isnar() ? !std::isnan(d) || !q.isnar() : q != p;
+		float f = float(p);
+		fail = fail || (!p.isnar() && f != float(d));
+		if (fail) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << p.get() << " -> " << d << " -> " << q.get() << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// posits with more precision than a double round to the nearest double: the long double reference is exact for 64-bit significands
+template<size_t nbits, size_t es>
+int VerifyPositToDouble(int nrOfRandoms, bool bReportIndividualTestCases) {
+	std::mt19937_64 eng(nbits * 64 + es);
+	int nrOfFailedTestCases = 0;
+	sw::unum::posit<nbits, es> p;
+	for (int i = 0; i < nrOfRandoms; ++i) {
+		p.set_raw_bits(eng());
+		if (p.isnar()) continue;
+		double d = double(p), ref = double((long double)(p));
+		if (d != ref) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << p.get() << " -> " << d << " instead of " << ref << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main()
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+#if MANUAL_TESTING
+
+	posit<48, 2> p(1.0 / 3.0);
+	cout << p.get() << " " << setprecision(17) << double(p) << endl;
+	cout << ReferenceConversion<48, 2>(1.0 / 3.0).get() << endl;
+
+#else // MANUAL_TESTING
+
+	cout << "IEEE-754 to posit conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit< 8, 0, double>(10000, bReportIndividualTestCases), "posit<8,0>", "double conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit<10, 3, float>(10000, bReportIndividualTestCases), "posit<10,3>", "float conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit<16, 1, float>(10000, bReportIndividualTestCases), "posit<16,1>", "float conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit<24, 2, double>(10000, bReportIndividualTestCases), "posit<24,2>", "double conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit<32, 2, double>(10000, bReportIndividualTestCases), "posit<32,2>", "double conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit<48, 2, double>(10000, bReportIndividualTestCases), "posit<48,2>", "double conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit<64, 3, double>(10000, bReportIndividualTestCases), "posit<64,3>", "double conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit<64, 0, float>(10000, bReportIndividualTestCases), "posit<64,0>", "float conversion");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip< 8, 0>(bReportIndividualTestCases), "posit<8,0>", "double round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip<10, 2>(bReportIndividualTestCases), "posit<10,2>", "double round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip<16, 1>(bReportIndividualTestCases), "posit<16,1>", "double round trip");
+
+	if (std::numeric_limits<long double>::digits >= 64) {
+		nrOfFailedTestCases += ReportTestResult(VerifyPositToDouble<64, 3>(10000, bReportIndividualTestCases), "posit<64,3>", "rounding to double");
+		nrOfFailedTestCases += ReportTestResult(VerifyPositToDouble<60, 1>(10000, bReportIndividualTestCases), "posit<60,1>", "rounding to double");
+	}
+
+	// special values, and the bulk conversions
+	{
+		int nrOfFailures = 0;
+		posit<48, 2> p;
+		p = std::numeric_limits<double>::quiet_NaN();
+		if (!p.isnar()) ++nrOfFailures;
+		p = -std::numeric_limits<double>::infinity();
+		if (!p.isnar()) ++nrOfFailures;
+		p = -0.0;
+		if (!p.iszero()) ++nrOfFailures;
+		p = std::numeric_limits<double>::denorm_min();
+		if (p != std::numeric_limits< posit<48, 2> >::min()) ++nrOfFailures;
+		p = -std::numeric_limits<double>::max();
+		if (p != -std::numeric_limits< posit<48, 2> >::max()) ++nrOfFailures;
+		vector<double> v = { 1.0, -0.375, 1.0e-9, 3.0e12, 0.0 }, w(v.size());
+		vector< posit<48, 2> > pv(v.size());
+		convert_n(v.data(), pv.data(), v.size());
+		convert_n(pv.data(), w.data(), w.size());
+		for (size_t i = 0; i < v.size(); ++i) if (pv[i] != posit<48, 2>(v[i]) || w[i] != double(pv[i])) ++nrOfFailures;
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "posit<48,2>", "special values");
+	}
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveRoundTrip<24, 2>(bReportIndividualTestCases), "posit<24,2>", "double round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeToPosit<64, 3, double>(10000000, bReportIndividualTestCases), "posit<64,3>", "double conversion");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,181 @@
+// lookup_tables.cpp: exhaustive validation of the compile-time generated posit lookup tables
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/posit_manipulators.hpp"
+#include "universal/posit/math/sqrt.hpp"
+#include "universal/posit/math/exponent.hpp"
+#include "universal/posit/math/logarithm.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+// the reference posit arithmetic of a binary lookup operator
+template<size_t nbits, size_t es>
+sw::unum::posit<nbits, es> ReferenceBinary(sw::unum::internal::lookup_operator op, const sw::unum::posit<nbits, es>& a, const sw::unum::posit<nbits, es>& b) {
+	using namespace sw::unum;
+	switch (op) {
+	case internal::lookup_operator::add: return a + b;
+	case internal::lookup_operator::sub: return a - b;
+	case internal::lookup_operator::mul: return a * b;
+	case internal::lookup_operator::div: return a / b;
+	default: break;
+	}
+	posit<nbits, es> nar;
+	nar.setnar();
+	return nar;
+}
+
+// the reference of a unary lookup operator: double precision for sqrt and reciprocal, the native kernels for exp and log
+template<size_t nbits, size_t es>
+sw::unum::posit<nbits, es> ReferenceUnary(sw::unum::internal::lookup_operator op, const sw::unum::posit<nbits, es>& a) {
+	using namespace sw::unum;
+	posit<nbits, es> r;
+	if (a.isnar()) {
+		r.setnar();
+		return r;
+	}
+	switch (op) {
+	case internal::lookup_operator::sqrt:
+		if (a.isneg()) r.setnar(); else r = std::sqrt(double(a));
+		break;
+	case internal::lookup_operator::reciprocal:
+		if (a.iszero()) r.setnar(); else r = 1.0 / double(a);
+		break;
+	case internal::lookup_operator::exp:
+		r = internal::native_elementary(internal::elementary_function::exp, a);
+		break;
+	case internal::lookup_operator::log:
+		r = internal::native_elementary(internal::elementary_function::log, a);
+		break;
+	default:
+		r.setnar();
+		break;
+	}
+	return r;
+}
+
+template<size_t nbits, size_t es, sw::unum::internal::lookup_operator op>
+int VerifyBinaryLookup(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	constexpr size_t NR_POSITS = (size_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	posit<nbits, es> a, b, result, ref;
+	for (size_t i = 0; i < NR_POSITS; ++i) {
+		a.set_raw_bits(i);
+		for (size_t j = 0; j < NR_POSITS; ++j) {
+			b.set_raw_bits(j);
+			result.set_raw_bits(posit_binary_lookup<nbits, es, op>[(i << nbits) | j]);
+			ref = ReferenceBinary(op, a, b);
+			if (result != ref) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << tag << " FAIL " << a.get() << " " << b.get() << " table " << result.get() << " reference " << ref.get() << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es, sw::unum::internal::lookup_operator op>
+int VerifyUnaryLookup(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	constexpr size_t NR_POSITS = (size_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	posit<nbits, es> a, result, ref;
+	for (size_t i = 0; i < NR_POSITS; ++i) {
+		a.set_raw_bits(i);
+		result.set_raw_bits(posit_unary_lookup<nbits, es, op>[i]);
+		ref = ReferenceUnary(op, a);
+		if (result != ref) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL " << a.get() << " table " << result.get() << " reference " << ref.get() << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyBinaryLookupTables(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum::internal;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryLookup<nbits, es, lookup_operator::add>(tag, bReportIndividualTestCases), tag, "add table ");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryLookup<nbits, es, lookup_operator::sub>(tag, bReportIndividualTestCases), tag, "sub table ");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryLookup<nbits, es, lookup_operator::mul>(tag, bReportIndividualTestCases), tag, "mul table ");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryLookup<nbits, es, lookup_operator::div>(tag, bReportIndividualTestCases), tag, "div table ");
+	return nrOfFailedTestCases;
+}
+
+template<size_t nbits, size_t es>
+int VerifyUnaryLookupTables(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum::internal;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportTestResult(VerifyUnaryLookup<nbits, es, lookup_operator::sqrt>(tag, bReportIndividualTestCases), tag, "sqrt table");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnaryLookup<nbits, es, lookup_operator::reciprocal>(tag, bReportIndividualTestCases), tag, "rcp table ");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnaryLookup<nbits, es, lookup_operator::exp>(tag, bReportIndividualTestCases), tag, "exp table ");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnaryLookup<nbits, es, lookup_operator::log>(tag, bReportIndividualTestCases), tag, "log table ");
+	return nrOfFailedTestCases;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += VerifyBinaryLookupTables<5, 1>(" posit<5,1> ", true);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<5, 1>(" posit<5,1> ", true);
+
+#else
+
+	cout << "Posit lookup table validation" << endl;
+
+	nrOfFailedTestCases += VerifyBinaryLookupTables<2, 0>(" posit<2,0> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyBinaryLookupTables<3, 0>(" posit<3,0> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyBinaryLookupTables<3, 1>(" posit<3,1> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyBinaryLookupTables<4, 0>(" posit<4,0> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyBinaryLookupTables<5, 1>(" posit<5,1> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyBinaryLookupTables<6, 3>(" posit<6,3> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyBinaryLookupTables<8, 0>(" posit<8,0> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyBinaryLookupTables<8, 1>(" posit<8,1> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyBinaryLookupTables<8, 2>(" posit<8,2> ", bReportIndividualTestCases);
+
+	nrOfFailedTestCases += VerifyUnaryLookupTables<3, 1>(" posit<3,1> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<5, 2>(" posit<5,2> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<8, 0>(" posit<8,0> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<8, 1>(" posit<8,1> ", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<10, 1>(" posit<10,1>", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<12, 2>(" posit<12,2>", bReportIndividualTestCases);
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += VerifyUnaryLookupTables<12, 0>(" posit<12,0>", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<12, 1>(" posit<12,1>", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<12, 3>(" posit<12,3>", bReportIndividualTestCases);
+	nrOfFailedTestCases += VerifyUnaryLookupTables<12, 4>(" posit<12,4>", bReportIndividualTestCases);
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,230 @@
+// batch_kernels.cpp: functionality tests for the array-level posit kernels of the fast posit<16,1> and posit<32,2>
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<16,1> and posit<32,2>
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions so that NaR propagates through the batches
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <random>
+#include <vector>
+// test helpers, such as, ReportTestResults
+#include "../../utils/test_helpers.hpp"
+
+// generate operands with random encodings, seeded with the special encodings
+template<size_t nbits, size_t es>
+std::vector< sw::unum::posit<nbits, es> > GenerateBatchOperands(size_t n, uint64_t seed) {
+	std::mt19937_64 eng(seed);
+	std::vector< sw::unum::posit<nbits, es> > v(n);
+	for (size_t i = 0; i < n; ++i) v[i].set_raw_bits(eng());
+	const uint64_t special[] = { 0, 1, (1ull << (nbits - 1)) - 1, (1ull << (nbits - 2)), (1ull << (nbits - 1)), (1ull << (nbits - 1)) + 1, (1ull << nbits) - 1, 3ull << (nbits - 2) };
+	for (size_t i = 0; i < sizeof(special) / sizeof(special[0]) && i < n; ++i) v[(i * 37 + seed) % n].set_raw_bits(special[i]);
+	return v;
+}
+
+// generate posit<32,2> operands in [1,2) whose 56-bit significand product rounds to a tie in double precision:
+// only the sign of the residual of the product can resolve the rounding of these cases
+void GenerateTieProducts(std::vector< sw::unum::posit<32, 2> >& a, std::vector< sw::unum::posit<32, 2> >& b) {
+	std::mt19937_64 eng(0x713);
+	size_t i = 0;
+	while (i < a.size()) {
+		uint64_t A = (eng() & 0x7FFFFFFull) | 0x8000001ull;   // odd 28-bit significand
+		uint64_t inverse = A;
+		for (int k = 0; k < 5; ++k) inverse *= 2 - A * inverse;   // inverse of A modulo 2^64
+		// the low 28 bits of the product are 0x8000001 (above the tie) or 0x7FFFFFF (below the tie)
+		uint64_t pattern = (i & 1) ? 0x7FFFFFFull : 0x8000001ull;
+		uint64_t B = (pattern * inverse) & 0xFFFFFFFull;
+		if (B < 0x8000000ull || A * B < (1ull << 55)) continue;
+		a[i] = std::ldexp(double(A), -27) * ((i & 2) ? -1.0 : 1.0);
+		b[i] = std::ldexp(double(B), -27);
+		++i;
+	}
+}
+
+// compare a batch of results against the scalar operators
+template<size_t nbits, size_t es>
+int CompareBatch(const std::string& tag, const std::string& op, const std::vector< sw::unum::posit<nbits, es> >& batch, const std::vector< sw::unum::posit<nbits, es> >& scalar, bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < batch.size(); ++i) {
+		if (batch[i] != scalar[i]) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " " << op << " FAIL element " << i << ": " << sw::unum::hex_format(batch[i]) << " != " << sw::unum::hex_format(scalar[i]) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyBatchArithmetic(const std::string& tag, const std::vector< sw::unum::posit<nbits, es> >& a, const std::vector< sw::unum::posit<nbits, es> >& b, const std::vector< sw::unum::posit<nbits, es> >& c, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	using Posit = posit<nbits, es>;
+	size_t n = a.size();
+	std::vector<Posit> batch(n), scalar(n);
+	int nrOfFailedTests = 0;
+
+	posit_add_n(a.data(), b.data(), batch.data(), n);
+	for (size_t i = 0; i < n; ++i) scalar[i] = a[i] + b[i];
+	nrOfFailedTests += CompareBatch(tag, "add", batch, scalar, bReportIndividualTestCases);
+
+	posit_sub_n(a.data(), b.data(), batch.data(), n);
+	for (size_t i = 0; i < n; ++i) scalar[i] = a[i] - b[i];
+	nrOfFailedTests += CompareBatch(tag, "sub", batch, scalar, bReportIndividualTestCases);
+
+	posit_mul_n(a.data(), b.data(), batch.data(), n);
+	for (size_t i = 0; i < n; ++i) scalar[i] = a[i] * b[i];
+	nrOfFailedTests += CompareBatch(tag, "mul", batch, scalar, bReportIndividualTestCases);
+
+	posit_div_n(a.data(), b.data(), batch.data(), n);
+	for (size_t i = 0; i < n; ++i) scalar[i] = a[i] / b[i];
+	nrOfFailedTests += CompareBatch(tag, "div", batch, scalar, bReportIndividualTestCases);
+
+	posit_fma_n(a.data(), b.data(), c.data(), batch.data(), n);
+	for (size_t i = 0; i < n; ++i) convert(fma(a[i], b[i], c[i]), scalar[i]);
+	nrOfFailedTests += CompareBatch(tag, "fma", batch, scalar, bReportIndividualTestCases);
+
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyBatchConversion(const std::string& tag, const std::vector< sw::unum::posit<nbits, es> >& p, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	using Posit = posit<nbits, es>;
+	size_t n = p.size();
+	int nrOfFailedTests = 0;
+
+	std::vector<double> d(n);
+	std::vector<float> f(n);
+	posit_to_double_n(p.data(), d.data(), n);
+	posit_to_float_n(p.data(), f.data(), n);
+	for (size_t i = 0; i < n; ++i) {
+		double dref = double(p[i]);
+		float fref = float(p[i]);
+		bool fail = p[i].isnar() ? !(std::isnan(d[i]) && std::isnan(f[i])) : (d[i] != dref || f[i] != fref);
+		if (fail) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " to_double/to_float FAIL " << hex_format(p[i]) << " : " << d[i] << " " << f[i] << std::endl;
+		}
+	}
+
+	// round trip, and the midpoints between neighbors to exercise the tie breaking of the rounding
+	std::vector<double> v(2 * n);
+	std::mt19937_64 eng(n);
+	for (size_t i = 0; i < n; ++i) {
+		v[2 * i] = d[i];
+		Posit next(p[i]);
+		++next;
+		v[2 * i + 1] = (p[i].isnar() || next.isnar()) ? d[i] * 1.5 : 0.5 * (d[i] + double(next));
+	}
+	std::vector<Posit> batch(2 * n), scalar(2 * n);
+	posit_from_double_n(v.data(), batch.data(), 2 * n);
+	for (size_t i = 0; i < 2 * n; ++i) scalar[i] = v[i];
+	nrOfFailedTests += CompareBatch(tag, "from_double", batch, scalar, bReportIndividualTestCases);
+
+	std::vector<float> vf(2 * n);
+	for (size_t i = 0; i < 2 * n; ++i) vf[i] = float(v[i]);
+	posit_from_float_n(vf.data(), batch.data(), 2 * n);
+	for (size_t i = 0; i < 2 * n; ++i) scalar[i] = vf[i];
+	nrOfFailedTests += CompareBatch(tag, "from_float", batch, scalar, bReportIndividualTestCases);
+
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+	bool bReportIndividualTestCases = false;
+
+#if defined(LIB_USE_AVX2)
+	cout << "Batch kernel tests: AVX2 lanes" << endl;
+#else
+	cout << "Batch kernel tests: scalar fallback" << endl;
+#endif
+
+#if MANUAL_TESTING
+	using Posit = posit<32, 2>;
+	std::vector<Posit> a(4), b(4), c(4);
+	a[0].set_raw_bits(0x40000000); b[0].set_raw_bits(0x40000001);
+	posit_add_n(a.data(), b.data(), c.data(), 4);
+	cout << hex_format(a[0]) << " + " << hex_format(b[0]) << " = " << hex_format(c[0]) << " reference " << hex_format(a[0] + b[0]) << endl;
+#else
+
+	{
+		// posit<16,1>: every encoding against randomized operands
+		constexpr size_t nbits = 16;
+		constexpr size_t es = 1;
+		std::string tag = " posit<16,1>";
+		std::vector< posit<nbits, es> > all(size_t(1) << nbits);
+		for (size_t i = 0; i < all.size(); ++i) all[i].set_raw_bits(i);
+		nrOfFailedTestCases += ReportTestResult(VerifyBatchConversion<nbits, es>(tag, all, bReportIndividualTestCases), tag, "conversion      (batch)   ");
+		int nrOfFailedArithmetic = 0;
+		for (uint64_t seed = 1; seed <= 8; ++seed) {
+			nrOfFailedArithmetic += VerifyBatchArithmetic<nbits, es>(tag, all, GenerateBatchOperands<nbits, es>(all.size(), seed), GenerateBatchOperands<nbits, es>(all.size(), seed + 100), bReportIndividualTestCases);
+		}
+		nrOfFailedTestCases += ReportTestResult(nrOfFailedArithmetic, tag, "arithmetic      (batch)   ");
+	}
+
+	{
+		// posit<32,2>: randomized operands
+		constexpr size_t nbits = 32;
+		constexpr size_t es = 2;
+		constexpr size_t RND_TEST_CASES = 500000;
+		std::string tag = " posit<32,2>";
+		std::vector< posit<nbits, es> > a = GenerateBatchOperands<nbits, es>(RND_TEST_CASES, 1);
+		std::vector< posit<nbits, es> > b = GenerateBatchOperands<nbits, es>(RND_TEST_CASES, 2);
+		std::vector< posit<nbits, es> > c = GenerateBatchOperands<nbits, es>(RND_TEST_CASES, 3);
+		nrOfFailedTestCases += ReportTestResult(VerifyBatchConversion<nbits, es>(tag, a, bReportIndividualTestCases), tag, "conversion      (batch)   ");
+		nrOfFailedTestCases += ReportTestResult(VerifyBatchArithmetic<nbits, es>(tag, a, b, c, bReportIndividualTestCases), tag, "arithmetic      (batch)   ");
+		// operands of similar magnitude exercise cancellation and the tie breaking of the rounding
+		for (size_t i = 0; i < RND_TEST_CASES; ++i) {
+			b[i].set_raw_bits(a[i].encoding() + (i & 0x7));
+			c[i] = -(a[i] * b[i]);
+		}
+		nrOfFailedTestCases += ReportTestResult(VerifyBatchArithmetic<nbits, es>(tag, a, b, c, bReportIndividualTestCases), tag, "cancellation    (batch)   ");
+		// products that round to a tie in double precision
+		GenerateTieProducts(a, b);
+		for (size_t i = 0; i < RND_TEST_CASES; ++i) c[i] = 0;
+		nrOfFailedTestCases += ReportTestResult(VerifyBatchArithmetic<nbits, es>(tag, a, b, c, bReportIndividualTestCases), tag, "rounding ties   (batch)   ");
+	}
+
+#if STRESS_TESTING
+
+#endif // STRESS_TESTING
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -33,3 +33,233 @@
 #endif
 #endif
 
+
+#include <random>
+#include <algorithm>
+
+/*
+The double-based randoms can't represent the operands of the wide posits exactly, so the fast
+specializations of posit<64,3>, posit<128,4>, and posit<256,5> are validated against the generic value<>
+arithmetic pipeline, which decodes through bitblocks. The helpers below are templated on the posit
+configuration, and expect <universal/posit/posit> and the test helpers to be included first.
+*/
+
+namespace sw { namespace unum {
+
+// uses the generic decoder to produce the triple (sign, scale, fraction) of a posit
+template<size_t nbits, size_t es>
+value<nbits - 3 - es> GenericDecode(const posit<nbits, es>& p) {
+	constexpr size_t fbits = nbits - 3 - es;
+	bool s;
+	regime<nbits, es> r;
+	exponent<nbits, es> e;
+	fraction<fbits> f;
+	decode(p.get(), s, r, e, f);
+	return value<fbits>(s, r.scale() + e.scale(), f.get(), p.iszero(), p.isnar());
+}
+
+// the result of the generic posit arithmetic pipeline for operands that are neither zero nor NaR
+template<size_t nbits, size_t es>
+posit<nbits, es> GenericReference(int opcode, const posit<nbits, es>& a, const posit<nbits, es>& b) {
+	constexpr size_t fbits = nbits - 3 - es;
+	constexpr size_t fhbits = fbits + 1;
+	constexpr size_t abits = fhbits + 3;
+	constexpr size_t mbits = 2 * fhbits;
+	constexpr size_t divbits = 3 * fhbits + 4;
+	value<fbits> va = GenericDecode(a), vb = GenericDecode(b);
+	posit<nbits, es> c;
+	switch (opcode) {
+	case OPCODE_ADD:
+	case OPCODE_SUB:
+	{
+		value<abits + 1> sum;
+		if (opcode == OPCODE_ADD) module_add<fbits, abits>(va, vb, sum); else module_subtract<fbits, abits>(va, vb, sum);
+		if (sum.iszero()) c.setzero(); else convert(sum, c);
+		break;
+	}
+	case OPCODE_MUL:
+	{
+		value<mbits> product;
+		module_multiply(va, vb, product);
+		convert(product, c);
+		break;
+	}
+	case OPCODE_DIV:
+	{
+		value<divbits> ratio;
+		module_divide(va, vb, ratio);
+		convert<nbits, es, divbits>(ratio, c);
+		break;
+	}
+	default:
+		break;
+	}
+	return c;
+}
+
+// random operands: uniform encodings, which are dominated by short regimes and full fractions,
+// and encodings next to maxpos and minpos
+template<size_t nbits, size_t es>
+posit<nbits, es> RandomPosit(std::mt19937_64& eng) {
+	constexpr size_t N = nbits / 64;
+	posit<nbits, es> p;
+	if constexpr (N == 1) p.set_raw_bits(eng()); else for (size_t i = 0; i < N; ++i) p.setword(i, eng());
+	switch (eng() % 8) {
+	case 0:
+		if constexpr (N == 1) p.set_raw_bits(0x7FFFFFFFFFFFFFFFull);
+		else {
+			for (size_t i = 0; i < N; ++i) p.setword(i, ~0ull);
+			p.setword(N - 1, 0x7FFFFFFFFFFFFFFFull);
+		}
+		for (uint64_t k = eng() % 1024; k > 0; --k) --p;   // next to maxpos
+		break;
+	case 1:
+		p.set_raw_bits(1 + (eng() % 1024));            // next to minpos
+		break;
+	default:
+		break;
+	}
+	if (eng() & 1) p = -p;
+	if (p.iszero() || p.isnar()) p = 1;
+	return p;
+}
+
+// the fast arithmetic operators compared to the generic pipeline
+template<size_t nbits, size_t es>
+int VerifyAgainstGeneric(const std::string& tag, bool bReportIndividualTestCases, int opcode, size_t nrOfRandoms) {
+	std::mt19937_64 eng(opcode + 1);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		posit<nbits, es> a = RandomPosit<nbits, es>(eng), b = RandomPosit<nbits, es>(eng), c, ref;
+		if (i % 16 == 0) {
+			// catastrophic cancellation: operands a few ulps apart
+			b = -a;
+			for (uint64_t k = eng() % 64; k > 0; --k) ++b;
+			if (b.iszero() || b.isnar()) b = a;
+		}
+		switch (opcode) {
+		case OPCODE_ADD: c = a + b; break;
+		case OPCODE_SUB: c = a - b; break;
+		case OPCODE_MUL: c = a * b; break;
+		case OPCODE_DIV: c = a / b; break;
+		default: break;
+		}
+		ref = GenericReference(opcode, a, b);
+		if (c != ref) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL: " << hex_format(a) << " op " << hex_format(b) << " = " << hex_format(c) << " reference " << hex_format(ref) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// scale and significand of a positive posit from the generic decoder: p = significand * 2^(scale - (nbits - 1)),
+// with the significand in nbits / 64 limbs, least significant limb first
+template<size_t nbits, size_t es>
+void GenericScaleAndSignificand(const posit<nbits, es>& p, int& scale, uint64_t* significand) {
+	constexpr size_t fbits = nbits - 3 - es;
+	constexpr size_t shift = nbits - 1 - fbits;
+	value<fbits> v = GenericDecode(p);
+	scale = v.scale();
+	for (size_t i = 0; i < nbits / 64; ++i) significand[i] = 0;
+	for (size_t i = 0; i < fbits; ++i) {
+		if (v.fraction()[i]) significand[(i + shift) / 64] |= uint64_t(1) << ((i + shift) % 64);
+	}
+	significand[nbits / 64 - 1] |= 0x8000000000000000ull;
+}
+
+// compare a with the square of the midpoint of the positive posits lo and hi: returns -1, 0, or 1
+template<size_t nbits, size_t es>
+int CompareWithSquaredMidpoint(const posit<nbits, es>& a, const posit<nbits, es>& lo, const posit<nbits, es>& hi) {
+	constexpr size_t N = nbits / 64;
+	constexpr size_t W = 2 * N + 4;
+	constexpr int F = int(nbits) - 1;
+	int sa, sl, sh;
+	uint64_t ma[W] = { 0 }, ml[W] = { 0 }, mh[W] = { 0 }, twice_mid[W], square[2 * W], lhs[2 * W] = { 0 }, rhs[2 * W] = { 0 };
+	GenericScaleAndSignificand(a, sa, ma);
+	GenericScaleAndSignificand(lo, sl, ml);
+	GenericScaleAndSignificand(hi, sh, mh);
+	// 2 * midpoint = twice_mid * 2^(s0 - F)
+	int s0 = std::min(sl, sh);
+	internal::limb_shift_left(ml, ml, W, size_t(sl - s0));
+	internal::limb_shift_left(mh, mh, W, size_t(sh - s0));
+	internal::limb_add(twice_mid, ml, mh, W);
+	// a = ma * 2^(sa - F), midpoint^2 = twice_mid^2 * 2^(2 * (s0 - F - 1))
+	internal::limb_multiply(square, twice_mid, W, twice_mid, W);
+	int d = (sa - F) - 2 * (s0 - F - 1);
+	for (size_t i = 0; i < W; ++i) lhs[i] = ma[i];
+	if (d >= 0) {
+		internal::limb_shift_left(lhs, lhs, 2 * W, size_t(d));
+		for (size_t i = 0; i < 2 * W; ++i) rhs[i] = square[i];
+	}
+	else {
+		internal::limb_shift_left(rhs, square, 2 * W, size_t(-d));
+	}
+	return internal::limb_compare(lhs, rhs, 2 * W);
+}
+
+// sqrt is correctly rounded when its argument lies between the squares of the midpoints to the neighbors of the result
+template<size_t nbits, size_t es>
+int VerifySqrt(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	std::mt19937_64 eng(0x5eed);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		posit<nbits, es> a = RandomPosit<nbits, es>(eng).abs();
+		posit<nbits, es> r = sqrt(a), lo(r), hi(r);
+		--lo; ++hi;
+		if (CompareWithSquaredMidpoint(a, lo, r) <= 0 || CompareWithSquaredMidpoint(a, r, hi) >= 0) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL: sqrt(" << hex_format(a) << ") = " << hex_format(r) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// conversions from native floating point and integers compared to the generic value<> conversion
+template<size_t nbits, size_t es>
+int VerifyNativeConversion(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	std::mt19937_64 eng(0xC0DE);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		int64_t integer = int64_t(eng()) >> (eng() % 64);
+		double d = std::ldexp(double(int64_t(eng())), int(eng() % 1200) - 600);
+		long double ld = std::ldexp((long double)(int64_t(eng())), int(eng() % 1200) - 600);
+		posit<nbits, es> pi(integer), pd(d), pld(ld), ri, rd, rld;
+		convert(value<63>((long long)integer), ri);
+		convert(value<std::numeric_limits<double>::digits - 1>(d), rd);
+		convert(value<std::numeric_limits<long double>::digits - 1>(ld), rld);
+		bool roundtrip;
+		if constexpr (nbits > 64) {
+			// the native values are exact posits
+			roundtrip = (double)(pd) == d && (long double)(pld) == ld && (long long)(pi) == integer;
+		}
+		else {
+			// posit to long double is exact
+			roundtrip = pld.iszero() || (long double)(pld) == GenericDecode(pld).to_long_double();
+		}
+		if (pi != ri || pd != rd || pld != rld || !roundtrip) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL: " << integer << " " << hex_format(pi) << " " << hex_format(ri) << " : " << d << " " << hex_format(pd) << " " << hex_format(rd) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the quire multiplier on the fast decoder compared to the generic quire multiplier
+template<size_t nbits, size_t es>
+int VerifyQuireMultiplier(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	std::mt19937_64 eng(0xF00D);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		posit<nbits, es> a = RandomPosit<nbits, es>(eng), b = RandomPosit<nbits, es>(eng);
+		auto fast = quire_mul(a, b);
+		auto ref = quire_mul<nbits, es>(a, b);
+		if (fast.sign() != ref.sign() || fast.scale() != ref.scale() || fast.fraction() != ref.fraction()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL: " << hex_format(a) << " * " << hex_format(b) << " = " << components(fast) << " reference " << components(ref) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+}} // namespace sw::unum
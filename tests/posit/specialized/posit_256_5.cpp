@@ -7,29 +7,32 @@
 // Configure the posit template environment
 // first: enable fast specialized posit<256,5>
 //#define POSIT_FAST_SPECIALIZATION   // turns on all fast specializations
-#define POSIT_FAST_POSIT_256_5 0
+#define POSIT_FAST_POSIT_256_5 1
 // second: enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 0
 #include <universal/posit/posit>
 // test helpers, such as, ReportTestResults
 #include "../../utils/test_helpers.hpp"
 #include "../../utils/posit_test_randoms.hpp"
+// the generic pipeline references of the wide posits
+#include "common.hpp"
 
 /*
 Standard posits with nbits = 256 have 5 exponent bits.
 */
 
-#define STRESS_TESTING 1
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
 
 int main(int argc, char** argv)
 try {
 	using namespace std;
 	using namespace sw::unum;
 
-	const size_t RND_TEST_CASES = 10000;
+	constexpr size_t RND_TEST_CASES = 2000;
 
-	const size_t nbits = 256;
-	const size_t es = 5;
+	constexpr size_t nbits = 256;
+	constexpr size_t es = 5;
 
 	int nrOfFailedTestCases = 0;
 	bool bReportIndividualTestCases = false;
@@ -44,22 +47,47 @@ try {
 	posit<nbits, es> p;
 	cout << dynamic_range(p) << endl << endl;
 
-	// TODO: as we don't have a reference floating point implementation to validate
-	// the arithmetic operations we are going to ignore the failures
+#if MANUAL_TESTING
+
+#else
+
+	// special cases
+	cout << "Special case tests " << endl;
+	string test = "Initialize to zero: ";
+	p = 0;
+	nrOfFailedTestCases += ReportCheck(tag, test, p.iszero());
+	test = "Initialize to NAN";
+	p = NAN;
+	nrOfFailedTestCases += ReportCheck(tag, test, p.isnar());
+	test = "Initialize to INFINITY";
+	p = INFINITY;
+	nrOfFailedTestCases += ReportCheck(tag, test, p.isnar());
+
+	// conversion tests
+	cout << "Assignment/conversion tests " << endl;
+	nrOfFailedTestCases += ReportTestResult( ValidateIntegerConversion<nbits, es>(tag, bReportIndividualTestCases), tag, "sint32 assign   (native)  ");
+
+	// validation against the generic posit arithmetic
+	cout << "Arithmetic tests against the generic posit<256,5> pipeline " << RND_TEST_CASES << " randoms each" << endl;
+	nrOfFailedTestCases += ReportTestResult( VerifyAgainstGeneric<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, RND_TEST_CASES), tag, "addition        (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyAgainstGeneric<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES), tag, "subtraction     (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyAgainstGeneric<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication  (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyAgainstGeneric<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division        (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyNativeConversion<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "conversion      (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyQuireMultiplier<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "quire_mul       (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifySqrt<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "sqrt            (exact)   ");
+
 #if STRESS_TESTING
-	cout << "Arithmetic tests " << RND_TEST_CASES << " randoms each" << endl;
-	cout << "Without an arithmetic reference, test failures can be ignored" << endl;
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, RND_TEST_CASES), tag, "addition      ");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES), tag, "subtraction   ");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division      ");
-#endif
-	nrOfFailedTestCases = 0;
+
+#endif // STRESS_TESTING
+
+#endif // !MANUAL_TESTING
+
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 catch (char const* msg) {
 	std::cerr << msg << std::endl;
-	return EXIT_SUCCESS; //as we manually throwing the not supported yet it should not fall through the cracks     EXIT_FAILURE;
+	return EXIT_FAILURE;
 }
 catch (const posit_arithmetic_exception& err) {
 	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
@@ -6,18 +6,20 @@
 
 // Configure the posit template environment
 // first: enable fast specialized posit<64,3>
-#define POSIT_FAST_POSIT_64_3 0  // TODO: fast posit<64,3> not implemented yet
+#define POSIT_FAST_POSIT_64_3 1
 // second: enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/posit/posit>
 // test helpers, such as, ReportTestResults
 #include "../../utils/test_helpers.hpp"
 #include "../../utils/posit_test_randoms.hpp"
+// the generic pipeline references of the wide posits
+#include "common.hpp"
 
 // Standard posit with nbits = 64 have es = 3 exponent bits.
 
 #define MANUAL_TESTING 0
-#define STRESS_TESTING 1
+#define STRESS_TESTING 0
 
 int main(int argc, char** argv)
 try {
@@ -110,15 +112,25 @@ try {
 	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_POW, RND_TEST_CASES),   tag, "pow                       ");
 
 
+	// as we don't have a reference floating point implementation to validate
+	// the arithmetic operations through doubles we are going to ignore those failures
+	nrOfFailedTestCases = 0;
+
+	// validation against the generic posit arithmetic
+	cout << "Arithmetic tests against the generic posit<64,3> pipeline " << RND_TEST_CASES << " randoms each" << endl;
+	nrOfFailedTestCases += ReportTestResult( VerifyAgainstGeneric<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, RND_TEST_CASES), tag, "addition        (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyAgainstGeneric<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES), tag, "subtraction     (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyAgainstGeneric<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication  (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyAgainstGeneric<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division        (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifyNativeConversion<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "conversion      (generic) ");
+	nrOfFailedTestCases += ReportTestResult( VerifySqrt<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "sqrt            (exact)   ");
+
 #if STRESS_TESTING
 
 #endif // STRESS_TESTING
 
 #endif // !MANUAL_TESTING
 
-	// TODO: as we don't have a reference floating point implementation to validate
-	// the arithmetic operations we are going to ignore the failures
-	nrOfFailedTestCases = 0;
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 catch (char const* msg) {
@@ -0,0 +1,93 @@
+// posit_8_lookup.cpp: Functionality tests for the table lookup arithmetic of posit<8,0> and posit<8,1>
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the table lookup arithmetic of the fast specialized posit<8,0> and the standard posit<8,1>
+#define POSIT_FAST_POSIT_8_0 1
+#define POSIT_LOOKUP_ARITHMETIC 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../../utils/test_helpers.hpp"
+
+/*
+The lookup arithmetic replaces the arithmetic operators of small posits with loads from the
+compile-time generated operator tables. The tables themselves are validated against the
+generic posit arithmetic in tests/posit/lookup_tables.cpp: here we validate the operators, exhaustively,
+against the reference arithmetic the tables are generated with.
+*/
+
+template<size_t nbits, size_t es>
+int VerifyLookupOperators(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	using namespace sw::unum::internal;
+	constexpr size_t NR_POSITS = (size_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	posit<nbits, es> a, b, c;
+	for (size_t i = 0; i < NR_POSITS; ++i) {
+		a.set_raw_bits(i);
+		for (size_t j = 0; j < NR_POSITS; ++j) {
+			b.set_raw_bits(j);
+			c = a + b;
+			if (c.encoding() != lookup_evaluate<nbits, es>(lookup_operator::add, i, j)) ++nrOfFailedTests;
+			c = a - b;
+			if (c.encoding() != lookup_evaluate<nbits, es>(lookup_operator::sub, i, j)) ++nrOfFailedTests;
+			c = a * b;
+			if (c.encoding() != lookup_evaluate<nbits, es>(lookup_operator::mul, i, j)) ++nrOfFailedTests;
+			c = a / b;
+			if (c.encoding() != lookup_evaluate<nbits, es>(lookup_operator::div, i, j)) ++nrOfFailedTests;
+		}
+		c = a.reciprocate();
+		if (c.encoding() != lookup_evaluate<nbits, es>(lookup_operator::reciprocal, i, 0)) ++nrOfFailedTests;
+		if (bReportIndividualTestCases && nrOfFailedTests) {
+			std::cout << tag << " FAIL operand " << a.get() << std::endl;
+			bReportIndividualTestCases = false;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+	bool bReportIndividualTestCases = true;
+
+	cout << "Table lookup arithmetic posit<8,0> and posit<8,1> tests" << endl;
+
+	// 8-bit posits can be done exhaustively
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupOperators<8, 0>(" posit<8,0>", bReportIndividualTestCases), " posit<8,0>", "+ - * / rcp (lookup)");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupOperators<8, 1>(" posit<8,1>", bReportIndividualTestCases), " posit<8,1>", "+ - * / rcp (lookup)");
+
+	// a few spot values of the posit<8,1> encodings
+	posit<8, 1> a, b;
+	a.set_raw_bits(0x01);  // minpos = 2^-12
+	b.set_raw_bits(0x02);  // 2^-10
+	if ((a + b).encoding() != 0x02) ++nrOfFailedTestCases;
+	a = 1; b = 2;
+	if (double(a + b) != 3.0) ++nrOfFailedTestCases;
+	if (double(a / b) != 0.5) ++nrOfFailedTestCases;
+	posit<8, 0> c(1), d(2);
+	if (double(c - d) != -1.0) ++nrOfFailedTestCases;
+	if (double(c / d) != 0.5) ++nrOfFailedTestCases;
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
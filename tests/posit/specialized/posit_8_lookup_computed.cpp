@@ -0,0 +1,176 @@
+// posit_8_lookup_computed.cpp: exhaustive comparison of the table lookup and the computed arithmetic of posit<8,0> and posit<8,1>
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the table lookup arithmetic of the fast specialized posit<8,0> and the standard posit<8,1>
+#define POSIT_FAST_POSIT_8_0 1
+#define POSIT_LOOKUP_ARITHMETIC 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../../utils/test_helpers.hpp"
+
+/*
+With POSIT_LOOKUP_ARITHMETIC set, the operators of posit<8,0> and posit<8,1> are table loads.
+The computed paths they replace are still reachable in this build:
+ - the fast posit<8,0> computes with the posit8_t kernels of posit_8_0.h
+ - the standard posit<8,1> computes by normalizing the operands into value<> triples,
+   and rounding the result of the module_add/subtract/multiply/divide functions
+This test compares the two, exhaustively, for all 256 x 256 operand pairs.
+*/
+
+namespace sw { namespace unum {
+
+enum class ComputedOperator { add, sub, mul, div };
+
+// the computed arithmetic of the fast posit<8,0>
+posit<8, 0> ComputedArithmetic(ComputedOperator op, const posit<8, 0>& a, const posit<8, 0>& b) {
+	posit8_t lhs = { { uint8_t(a.encoding()) } };
+	posit8_t rhs = { { uint8_t(b.encoding()) } };
+	posit8_t result;
+	switch (op) {
+	case ComputedOperator::add: result = posit8_addp8(lhs, rhs); break;
+	case ComputedOperator::sub: result = posit8_subp8(lhs, rhs); break;
+	case ComputedOperator::mul: result = posit8_mulp8(lhs, rhs); break;
+	case ComputedOperator::div: result = posit8_divp8(lhs, rhs); break;
+	}
+	posit<8, 0> c;
+	c.set_raw_bits(result.v);
+	return c;
+}
+
+// the computed arithmetic of the standard posit: the special cases and the value<> pipeline of the posit operators
+template<size_t nbits, size_t es>
+posit<nbits, es> ComputedArithmetic(ComputedOperator op, const posit<nbits, es>& a, const posit<nbits, es>& b) {
+	using Posit = posit<nbits, es>;
+	constexpr size_t fbits = Posit::fbits;
+	constexpr size_t abits = Posit::abits;
+	Posit c;
+	if (a.isnar() || b.isnar() || (op == ComputedOperator::div && b.iszero())) { c.setnar(); return c; }
+	switch (op) {
+	case ComputedOperator::add:
+		if (a.iszero()) return b;
+		if (b.iszero()) return a;
+		break;
+	case ComputedOperator::sub:
+		if (a.iszero()) return -b;
+		if (b.iszero()) return a;
+		break;
+	case ComputedOperator::mul:
+		if (a.iszero() || b.iszero()) { c.setzero(); return c; }
+		break;
+	case ComputedOperator::div:
+		if (a.iszero()) return a;
+		break;
+	}
+	value<fbits> va, vb;
+	a.normalize(va);
+	b.normalize(vb);
+	switch (op) {
+	case ComputedOperator::add:
+	{
+		value<abits + 1> sum;
+		module_add<fbits, abits>(va, vb, sum);
+		if (sum.iszero()) { c.setzero(); return c; }
+		if (sum.isinf()) { c.setnar(); return c; }
+		return convert(sum, c);
+	}
+	case ComputedOperator::sub:
+	{
+		value<abits + 1> difference;
+		module_subtract<fbits, abits>(va, vb, difference);
+		if (difference.iszero()) { c.setzero(); return c; }
+		if (difference.isinf()) { c.setnar(); return c; }
+		return convert(difference, c);
+	}
+	case ComputedOperator::mul:
+	{
+		value<Posit::mbits> product;
+		module_multiply(va, vb, product);
+		if (product.iszero()) { c.setzero(); return c; }
+		if (product.isinf()) { c.setnar(); return c; }
+		return convert(product, c);
+	}
+	case ComputedOperator::div:
+	{
+		value<Posit::divbits> ratio;
+		module_divide(va, vb, ratio);
+		if (ratio.iszero()) { c.setzero(); return c; }
+		if (ratio.isinf()) { c.setnar(); return c; }
+		return convert<nbits, es, Posit::divbits>(ratio, c);
+	}
+	}
+	return c;
+}
+
+// compare the lookup operators against the computed arithmetic for all operand pairs
+template<size_t nbits, size_t es>
+int VerifyLookupAgainstComputed(const std::string& tag, bool bReportIndividualTestCases) {
+	constexpr size_t NR_POSITS = (size_t(1) << nbits);
+	constexpr ComputedOperator operators[] = { ComputedOperator::add, ComputedOperator::sub, ComputedOperator::mul, ComputedOperator::div };
+	constexpr char symbols[] = { '+', '-', '*', '/' };
+	int nrOfFailedTests = 0;
+	posit<nbits, es> a, b, one(1), lookup, computed;
+	for (size_t i = 0; i < NR_POSITS; ++i) {
+		a.set_raw_bits(i);
+		for (size_t j = 0; j < NR_POSITS; ++j) {
+			b.set_raw_bits(j);
+			for (size_t k = 0; k < 4; ++k) {
+				switch (operators[k]) {
+				case ComputedOperator::add: lookup = a + b; break;
+				case ComputedOperator::sub: lookup = a - b; break;
+				case ComputedOperator::mul: lookup = a * b; break;
+				case ComputedOperator::div: lookup = a / b; break;
+				}
+				computed = ComputedArithmetic(operators[k], a, b);
+				if (lookup != computed) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cout << tag << " FAIL " << a.get() << ' ' << symbols[k] << ' ' << b.get() << " lookup " << lookup.get() << " computed " << computed.get() << std::endl;
+				}
+			}
+		}
+		// the reciprocal is the computed division of one by the operand
+		lookup = a.reciprocate();
+		computed = ComputedArithmetic(ComputedOperator::div, one, a);
+		if (lookup != computed) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL 1 / " << a.get() << " lookup " << lookup.get() << " computed " << computed.get() << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+}} // namespace sw::unum
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	int nrOfFailedTestCases = 0;
+	bool bReportIndividualTestCases = false;
+
+	cout << "Table lookup against computed arithmetic posit<8,0> and posit<8,1> tests" << endl;
+
+	// 8-bit posits can be done exhaustively
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupAgainstComputed<8, 0>(" posit<8,0>", bReportIndividualTestCases), " posit<8,0>", "+ - * / rcp (lookup vs computed)");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupAgainstComputed<8, 1>(" posit<8,1>", bReportIndividualTestCases), " posit<8,1>", "+ - * / rcp (lookup vs computed)");
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -5,6 +5,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <typeinfo>
 #include <random>
@@ -17,15 +18,16 @@
 #include "universal/fixpnt/fixpnt_functions.hpp"
 // test helpers, such as, ReportTestResults
 #include "test_helpers.hpp"
+#include "verification_engine.hpp"
 
 namespace sw { namespace unum {
 
 #define FIXPNT_TABLE_WIDTH 20
 
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
-void ReportConversionError(const std::string& test_case, const std::string& op, double input, double reference, const fixpnt<nbits, rbits, arithmetic, BlockType>& result) {
-	auto old_precision = std::cerr.precision();
-	std::cerr << test_case
+void ReportConversionError(std::ostream& ostr, const std::string& test_case, const std::string& op, double input, double reference, const fixpnt<nbits, rbits, arithmetic, BlockType>& result) {
+	auto old_precision = ostr.precision();
+	ostr << test_case
 		<< " " << op << " "
 		<< std::setw(FIXPNT_TABLE_WIDTH) << input
 		<< " did not convert to "
@@ -36,6 +38,11 @@ void ReportConversionError(const std::string& test_case, const std::string& op,
 		<< std::endl;
 }
 
+template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
+void ReportConversionError(const std::string& test_case, const std::string& op, double input, double reference, const fixpnt<nbits, rbits, arithmetic, BlockType>& result) {
+	ReportConversionError(std::cerr, test_case, op, input, reference, result);
+}
+
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
 void ReportConversionSuccess(const std::string& test_case, const std::string& op, double input, double reference, const fixpnt<nbits, rbits, arithmetic, BlockType>& result) {
 	std::cerr << test_case
@@ -49,9 +56,9 @@ void ReportConversionSuccess(const std::string& test_case, const std::string& op
 }
 
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
-void ReportBinaryArithmeticError(const std::string& test_case, const std::string& op, const fixpnt<nbits, rbits, arithmetic, BlockType>& lhs, const fixpnt<nbits, rbits, arithmetic, BlockType>& rhs, const fixpnt<nbits, rbits, arithmetic, BlockType>& ref, const fixpnt<nbits, rbits, arithmetic, BlockType>& result) {
-	auto old_precision = std::cerr.precision();
-	std::cerr << test_case << " "
+void ReportBinaryArithmeticError(std::ostream& ostr, const std::string& test_case, const std::string& op, const fixpnt<nbits, rbits, arithmetic, BlockType>& lhs, const fixpnt<nbits, rbits, arithmetic, BlockType>& rhs, const fixpnt<nbits, rbits, arithmetic, BlockType>& ref, const fixpnt<nbits, rbits, arithmetic, BlockType>& result) {
+	auto old_precision = ostr.precision();
+	ostr << test_case << " "
 		<< std::setprecision(20)
 		<< std::setw(FIXPNT_TABLE_WIDTH) << lhs
 		<< " " << op << " "
@@ -64,6 +71,11 @@ void ReportBinaryArithmeticError(const std::string& test_case, const std::string
 		<< std::endl;
 }
 
+template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
+void ReportBinaryArithmeticError(const std::string& test_case, const std::string& op, const fixpnt<nbits, rbits, arithmetic, BlockType>& lhs, const fixpnt<nbits, rbits, arithmetic, BlockType>& rhs, const fixpnt<nbits, rbits, arithmetic, BlockType>& ref, const fixpnt<nbits, rbits, arithmetic, BlockType>& result) {
+	ReportBinaryArithmeticError(std::cerr, test_case, op, lhs, rhs, ref, result);
+}
+
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
 void ReportBinaryArithmeticError(const std::string& test_case, const std::string& op, 
 	const std::complex<fixpnt<nbits, rbits, arithmetic, BlockType>>& lhs, 
@@ -102,8 +114,8 @@ void ReportBinaryArithmeticSuccess(const std::string& test_case, const std::stri
 }
 
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType, typename Ty>
-void ReportAssignmentError(const std::string& test_case, const std::string& op, const fixpnt<nbits, rbits, arithmetic, BlockType>& ref, const fixpnt <nbits, rbits, arithmetic, BlockType>& result, const Ty& value) {
-	std::cerr << test_case
+void ReportAssignmentError(std::ostream& ostr, const std::string& test_case, const std::string& op, const fixpnt<nbits, rbits, arithmetic, BlockType>& ref, const fixpnt <nbits, rbits, arithmetic, BlockType>& result, const Ty& value) {
+	ostr << test_case
 		<< " " << op << " "
 		<< std::setw(FIXPNT_TABLE_WIDTH) << value
 		<< " != "
@@ -112,6 +124,11 @@ void ReportAssignmentError(const std::string& test_case, const std::string& op,
 		<< " " << to_binary(result) << " vs " << to_binary(ref) << std::endl;
 }
 
+template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType, typename Ty>
+void ReportAssignmentError(const std::string& test_case, const std::string& op, const fixpnt<nbits, rbits, arithmetic, BlockType>& ref, const fixpnt <nbits, rbits, arithmetic, BlockType>& result, const Ty& value) {
+	ReportAssignmentError(std::cerr, test_case, op, ref, result, value);
+}
+
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType, typename Ty>
 void ReportAssignmentSuccess(const std::string& test_case, const std::string& op, const fixpnt<nbits, rbits, arithmetic, BlockType>& ref, const fixpnt <nbits, rbits, arithmetic, BlockType>& result, const Ty& value) {
 	std::cerr << test_case
@@ -126,12 +143,12 @@ void ReportAssignmentSuccess(const std::string& test_case, const std::string& op
 /////////////////////////////// VERIFICATION TEST SUITES ////////////////////////////////
 
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
-int Compare(double input, const fixpnt<nbits, rbits, arithmetic, BlockType>& presult, double reference, bool bReportIndividualTestCases) {
+int Compare(std::ostream& ostr, double input, const fixpnt<nbits, rbits, arithmetic, BlockType>& presult, double reference, bool bReportIndividualTestCases) {
 	int fail = 0;
 	double result = double(presult);
 	if (std::fabs(result - reference) > 0.000000001) {
 		fail++;
-		if (bReportIndividualTestCases)	ReportConversionError("FAIL", "=", input, reference, presult);
+		if (bReportIndividualTestCases)	ReportConversionError(ostr, "FAIL", "=", input, reference, presult);
 	}
 	else {
 		// if (bReportIndividualTestCases) ReportConversionSuccess("PASS", "=", input, reference, presult);
@@ -139,6 +156,14 @@ int Compare(double input, const fixpnt<nbits, rbits, arithmetic, BlockType>& pre
 	return fail;
 }
 
+template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
+int Compare(double input, const fixpnt<nbits, rbits, arithmetic, BlockType>& presult, double reference, bool bReportIndividualTestCases) {
+	return Compare(std::cerr, input, presult, reference, bReportIndividualTestCases);
+}
+
+// the conversion suites verify their test cases in rows of FIXPNT_CONVERSION_CASES_PER_ROW consecutive encodings
+constexpr size_t FIXPNT_CONVERSION_CASES_PER_ROW = 256;
+
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType, typename Ty>
 int ValidateAssignment(bool bReportIndividualTestCases) {
 	const size_t NR_NUMBERS = (size_t(1) << nbits);
@@ -146,21 +171,27 @@ int ValidateAssignment(bool bReportIndividualTestCases) {
 
 	// use only valid fixed-point values
 	// fixpnt_raw -> to value in Ty -> assign to fixpnt -> compare fixpnts
-	fixpnt<nbits, rbits, arithmetic, BlockType> p, assigned;
-	for (size_t i = 0; i < NR_NUMBERS; i++) {
-		p.set_raw_bits(i); 
-		//std::cout << to_binary(p) << std::endl;
-		Ty value = (Ty)(p);
-		assigned = value;
-		//std::cout << p << " " << value << " " << assigned << std::endl;
-		if (p != assigned) {
-			nrOfFailedTestCases++;
-			if (bReportIndividualTestCases) ReportAssignmentError("FAIL", "=", p, assigned, value);
-		}
-		else {
-			//if (bReportIndividualTestCases) ReportAssignmentSuccess("PASS", "=", p, assigned, value);
+	const size_t nrRows = (NR_NUMBERS + FIXPNT_CONVERSION_CASES_PER_ROW - 1) / FIXPNT_CONVERSION_CASES_PER_ROW;
+	nrOfFailedTestCases += VerifyRows(nrRows, [&](size_t row, std::ostream& report) {
+		int nrOfFailedTests = 0;
+		fixpnt<nbits, rbits, arithmetic, BlockType> p, assigned;
+		const size_t last = std::min(NR_NUMBERS, (row + 1) * FIXPNT_CONVERSION_CASES_PER_ROW);
+		for (size_t i = row * FIXPNT_CONVERSION_CASES_PER_ROW; i < last; i++) {
+			p.set_raw_bits(i);
+			//std::cout << to_binary(p) << std::endl;
+			Ty value = (Ty)(p);
+			assigned = value;
+			//std::cout << p << " " << value << " " << assigned << std::endl;
+			if (p != assigned) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) ReportAssignmentError(report, "FAIL", "=", p, assigned, value);
+			}
+			else {
+				//if (bReportIndividualTestCases) ReportAssignmentSuccess("PASS", "=", p, assigned, value);
+			}
 		}
-	}
+		return nrOfFailedTests;
+	});
 	return nrOfFailedTestCases;
 }
 
@@ -179,144 +210,147 @@ int ValidateConversion(const std::string& tag, bool bReportIndividualTestCases)
 	// to test the rounding logic of the conversion.
 	constexpr size_t NR_TEST_CASES = (size_t(1) << (nbits + 1));
 	constexpr size_t HALF = (size_t(1) << nbits);
-	fixpnt<nbits + 1, rbits + 1, arithmetic, BlockType> pref, pprev, pnext;
-
 	const unsigned max = nbits > 20 ? 20 : nbits + 1;
 	size_t max_tests = (size_t(1) << max);
 	if (max_tests < NR_TEST_CASES) {
 		std::cout << "ValidateConversion<" << nbits << "," << rbits << ">: NR_TEST_CASES = " << NR_TEST_CASES << " clipped by " << max_tests << std::endl;
 	}
 
-	// execute the test
-	int nrOfFailedTests = 0;
 	fixpnt<nbits + 1, rbits + 1, arithmetic, BlockType> fpminpos;
 	double dminpos = double(minpos(fpminpos));
 	fixpnt<nbits, rbits, arithmetic, BlockType> fpmaxneg;
 	double dmaxneg = double(maxneg(fpmaxneg));
 
-	double eps;
-	double da, input;
-	fixpnt<nbits, rbits, arithmetic, BlockType> nut; // NUT: number under test
-	for (size_t i = 0; i < NR_TEST_CASES && i < max_tests; ++i) {
-		pref.set_raw_bits(i);
-		da = double(pref);
-		if (i == 0) {
-			eps = dminpos / 2.0;
-		}
-		else {
-			eps = da > 0 ? da * 1.0e-6 : da * -1.0e-6;
-		}
-		if (i % 2) {
-			if (i == 1) {
-				// special case of a tie that needs to round to even -> 0
-				input = da;
-				nut = input;
-				nrOfFailedTests += Compare(input, nut, 0.0, bReportIndividualTestCases);
-
-				// this rounds up
-				input = da + eps;
-				nut = input;
-				pnext.set_raw_bits(i + 1);
-				nrOfFailedTests += Compare(input, nut, (double)pnext, bReportIndividualTestCases);
-
-			}
-			else if (i == HALF - 1) {
-				// special case of projecting to maxpos
-				input = da - eps;
-				nut = input;
-				pprev.set_raw_bits(HALF - 2);
-				nrOfFailedTests += Compare(input, nut, (double)pprev, bReportIndividualTestCases);
-			}
-			else if (i == HALF + 1) {
-				// special case of projecting to maxneg
-				input = da - eps;
-				nut = input;
-				nrOfFailedTests += Compare(input, nut, dmaxneg, bReportIndividualTestCases);
-			}
-			else if (i == NR_TEST_CASES - 1) {
-				// special case of projecting to minneg
-				input = da - eps;
-				nut = input;
-				pprev.set_raw_bits(i - 1);
-				nrOfFailedTests += Compare(input, nut, (double)pprev, bReportIndividualTestCases);
-				// but the +delta goes to 0
-				input = da + eps;
-				nut = input;
-//				nrOfFailedTests += Compare(input, nut, (double)pprev, bReportIndividualTestCases);
-				nrOfFailedTests += Compare(input, nut, 0.0, bReportIndividualTestCases);
+	// execute the test: the rows are blocks of consecutive reference encodings
+	const size_t nrCases = std::min(NR_TEST_CASES, max_tests);
+	const size_t nrRows = (nrCases + FIXPNT_CONVERSION_CASES_PER_ROW - 1) / FIXPNT_CONVERSION_CASES_PER_ROW;
+	return VerifyRows(nrRows, [&](size_t row, std::ostream& report) {
+		int nrOfFailedTests = 0;
+		fixpnt<nbits + 1, rbits + 1, arithmetic, BlockType> pref, pprev, pnext;
+		double eps;
+		double da, input;
+		fixpnt<nbits, rbits, arithmetic, BlockType> nut; // NUT: number under test
+		const size_t last = std::min(nrCases, (row + 1) * FIXPNT_CONVERSION_CASES_PER_ROW);
+		for (size_t i = row * FIXPNT_CONVERSION_CASES_PER_ROW; i < last; ++i) {
+			pref.set_raw_bits(i);
+			da = double(pref);
+			if (i == 0) {
+				eps = dminpos / 2.0;
 			}
 			else {
-				// for odd values, we are between fixed point values, so we create the round-up and round-down cases
-				// round-down
-				input = da - eps;
-				nut = input;
-				pprev.set_raw_bits(i - 1);
-				nrOfFailedTests += Compare(input, nut, (double)pprev, bReportIndividualTestCases);
-				// round-up
-				input = da + eps;
-				nut = input;
-				pnext.set_raw_bits(i + 1);
-				nrOfFailedTests += Compare(input, nut, (double)pnext, bReportIndividualTestCases);
+				eps = da > 0 ? da * 1.0e-6 : da * -1.0e-6;
 			}
-		}
-		else {
-			// for the even values, we generate the round-to-actual cases
-			if (i == 0) {
-				// pref = 0
-				// 0                 -> value = 0
-				// half of pnext     -> value = 0
-				// special case of assigning to 0
-				input = da;
-				nut = input;
-				nrOfFailedTests += Compare(input, nut, da, bReportIndividualTestCases);
-
-				input = da + eps;
-				nut = input;
-				nrOfFailedTests += Compare(input, nut, da, bReportIndividualTestCases);
-			}
-			else if (i == NR_TEST_CASES - 2) {
-				// special case of projecting to minneg
-				input = da - eps;
-				nut = input;
-				pprev.set_raw_bits(NR_TEST_CASES - 2);
-				nrOfFailedTests += Compare(input, nut, (double)pprev, bReportIndividualTestCases);
+			if (i % 2) {
+				if (i == 1) {
+					// special case of a tie that needs to round to even -> 0
+					input = da;
+					nut = input;
+					nrOfFailedTests += Compare(report, input, nut, 0.0, bReportIndividualTestCases);
+
+					// this rounds up
+					input = da + eps;
+					nut = input;
+					pnext.set_raw_bits(i + 1);
+					nrOfFailedTests += Compare(report, input, nut, (double)pnext, bReportIndividualTestCases);
+
+				}
+				else if (i == HALF - 1) {
+					// special case of projecting to maxpos
+					input = da - eps;
+					nut = input;
+					pprev.set_raw_bits(HALF - 2);
+					nrOfFailedTests += Compare(report, input, nut, (double)pprev, bReportIndividualTestCases);
+				}
+				else if (i == HALF + 1) {
+					// special case of projecting to maxneg
+					input = da - eps;
+					nut = input;
+					nrOfFailedTests += Compare(report, input, nut, dmaxneg, bReportIndividualTestCases);
+				}
+				else if (i == NR_TEST_CASES - 1) {
+					// special case of projecting to minneg
+					input = da - eps;
+					nut = input;
+					pprev.set_raw_bits(i - 1);
+					nrOfFailedTests += Compare(report, input, nut, (double)pprev, bReportIndividualTestCases);
+					// but the +delta goes to 0
+					input = da + eps;
+					nut = input;
+	//				nrOfFailedTests += Compare(report, input, nut, (double)pprev, bReportIndividualTestCases);
+					nrOfFailedTests += Compare(report, input, nut, 0.0, bReportIndividualTestCases);
+				}
+				else {
+					// for odd values, we are between fixed point values, so we create the round-up and round-down cases
+					// round-down
+					input = da - eps;
+					nut = input;
+					pprev.set_raw_bits(i - 1);
+					nrOfFailedTests += Compare(report, input, nut, (double)pprev, bReportIndividualTestCases);
+					// round-up
+					input = da + eps;
+					nut = input;
+					pnext.set_raw_bits(i + 1);
+					nrOfFailedTests += Compare(report, input, nut, (double)pnext, bReportIndividualTestCases);
+				}
 			}
 			else {
-				// for even values, we are on actual fixed point values, so we create the round-up and round-down cases
-				// round-up
-				input = da - eps;
-				nut = input;
-				nrOfFailedTests += Compare(input, nut, da, bReportIndividualTestCases);
-				// round-down
-				input = da + eps;
-				nut = input;
-				nrOfFailedTests += Compare(input, nut, da, bReportIndividualTestCases);
+				// for the even values, we generate the round-to-actual cases
+				if (i == 0) {
+					// pref = 0
+					// 0                 -> value = 0
+					// half of pnext     -> value = 0
+					// special case of assigning to 0
+					input = da;
+					nut = input;
+					nrOfFailedTests += Compare(report, input, nut, da, bReportIndividualTestCases);
+
+					input = da + eps;
+					nut = input;
+					nrOfFailedTests += Compare(report, input, nut, da, bReportIndividualTestCases);
+				}
+				else if (i == NR_TEST_CASES - 2) {
+					// special case of projecting to minneg
+					input = da - eps;
+					nut = input;
+					pprev.set_raw_bits(NR_TEST_CASES - 2);
+					nrOfFailedTests += Compare(report, input, nut, (double)pprev, bReportIndividualTestCases);
+				}
+				else {
+					// for even values, we are on actual fixed point values, so we create the round-up and round-down cases
+					// round-up
+					input = da - eps;
+					nut = input;
+					nrOfFailedTests += Compare(report, input, nut, da, bReportIndividualTestCases);
+					// round-down
+					input = da + eps;
+					nut = input;
+					nrOfFailedTests += Compare(report, input, nut, da, bReportIndividualTestCases);
+				}
 			}
 		}
-	}
-	return nrOfFailedTests;
+		return nrOfFailedTests;
+	});
 }
 
 // enumerate all addition cases for an fixpnt<nbits,rbits> configuration
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
 int VerifyAddition(const std::string& tag, bool bReportIndividualTestCases) {
 	constexpr size_t NR_VALUES = (size_t(1) << nbits);
-	int nrOfFailedTests = 0;
-	fixpnt<nbits, rbits, arithmetic, BlockType> a, b, result, cref;
-	double ref;
 
 	// set the saturation clamps
 	fixpnt<nbits, rbits, arithmetic, BlockType> fpmaxpos{ 0 }, fpmaxneg{ 0 };
 	maxpos<nbits, rbits, arithmetic, BlockType>(fpmaxpos);
 	maxneg<nbits, rbits, arithmetic, BlockType>(fpmaxneg);
 
-	double da, db;
-	for (size_t i = 0; i < NR_VALUES; i++) {
+	return VerifyRows(NR_VALUES, [&](size_t i, std::ostream& report) {
+		int nrOfFailedTests = 0;
+		fixpnt<nbits, rbits, arithmetic, BlockType> a, b, result, cref;
+		double ref;
 		a.set_raw_bits(i);
-		da = double(a);
+		double da = double(a);
 		for (size_t j = 0; j < NR_VALUES; j++) {
 			b.set_raw_bits(j);
-			db = double(b);
+			double db = double(b);
 			ref = da + db;
 #if FIXPNT_THROW_ARITHMETIC_EXCEPTION
 			// catching overflow
@@ -339,39 +373,36 @@ int VerifyAddition(const std::string& tag, bool bReportIndividualTestCases) {
 			cref = ref;
 			if (result != cref) {
 				nrOfFailedTests++;
-				if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "+", a, b, cref, result);
+				if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "+", a, b, cref, result);
 			}
 			else {
 				//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "+", a, b, cref, result);
 			}
-			if (nrOfFailedTests > 100) return nrOfFailedTests;
+			if (nrOfFailedTests > 100) break;
 		}
-		if (i % 1024 == 0) std::cout << '.';
-	}
-	std::cout << std::endl;
-	return nrOfFailedTests;
+		return nrOfFailedTests;
+	}, std::cerr, 100);
 }
 
 // enumerate all subtraction cases for an fixpnt<nbits,rbits> configuration
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
 int VerifySubtraction(const std::string& tag, bool bReportIndividualTestCases) {
 	constexpr size_t NR_VALUES = (size_t(1) << nbits);
-	int nrOfFailedTests = 0;
-	fixpnt<nbits, rbits, arithmetic, BlockType> a, b, result, cref;
-	double ref;
 
 	// set the saturation clamps
 	fixpnt<nbits, rbits, arithmetic, BlockType> fpmaxpos, fpmaxneg;
 	maxpos<nbits, rbits, arithmetic, BlockType>(fpmaxpos);
 	maxneg<nbits, rbits, arithmetic, BlockType>(fpmaxneg);
 
-	double da, db;
-	for (size_t i = 0; i < NR_VALUES; i++) {
+	return VerifyRows(NR_VALUES, [&](size_t i, std::ostream& report) {
+		int nrOfFailedTests = 0;
+		fixpnt<nbits, rbits, arithmetic, BlockType> a, b, result, cref;
+		double ref;
 		a.set_raw_bits(i);
-		da = double(a);
+		double da = double(a);
 		for (size_t j = 0; j < NR_VALUES; j++) {
 			b.set_raw_bits(j);
-			db = double(b);
+			double db = double(b);
 			ref = da - db;
 #if FIXPNT_THROW_ARITHMETIC_EXCEPTION
 			// catching overflow
@@ -394,39 +425,36 @@ int VerifySubtraction(const std::string& tag, bool bReportIndividualTestCases) {
 			cref = ref;
 			if (result != cref) {
 				nrOfFailedTests++;
-				if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "-", a, b, cref, result);
+				if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "-", a, b, cref, result);
 			}
 			else {
 				// if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "-", a, b, cref, result);
 			}
-			if (nrOfFailedTests > 100) return nrOfFailedTests;
+			if (nrOfFailedTests > 100) break;
 		}
-		if (i % 1024 == 0) std::cout << '.';
-	}
-	std::cout << std::endl;
-	return nrOfFailedTests;
+		return nrOfFailedTests;
+	}, std::cerr, 100);
 }
 
 // enumerate all multiplication cases for an fixpnt<nbits,rbits> configuration
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
 int VerifyMultiplication(const std::string& tag, bool bReportIndividualTestCases) {
 	constexpr size_t NR_VALUES = (size_t(1) << nbits);
-	int nrOfFailedTests = 0;
-	fixpnt<nbits, rbits, arithmetic, BlockType> a, b, result, cref;
-	double ref;
 
 	// set the saturation clamps
 	fixpnt<nbits, rbits, arithmetic, BlockType> fpmaxpos, fpmaxneg;
 	maxpos<nbits, rbits, arithmetic, BlockType>(fpmaxpos);
 	maxneg<nbits, rbits, arithmetic, BlockType>(fpmaxneg);
 
-	double da, db;
-	for (size_t i = 0; i < NR_VALUES; i++) {
+	return VerifyRows(NR_VALUES, [&](size_t i, std::ostream& report) {
+		int nrOfFailedTests = 0;
+		fixpnt<nbits, rbits, arithmetic, BlockType> a, b, result, cref;
+		double ref;
 		a.set_raw_bits(i);
-		da = double(a);
+		double da = double(a);
 		for (size_t j = 0; j < NR_VALUES; j++) {
 			b.set_raw_bits(j);
-			db = double(b);
+			double db = double(b);
 			ref = da * db;
 #if FIXPNT_THROW_ARITHMETIC_EXCEPTION
 			// catching overflow
@@ -449,39 +477,36 @@ int VerifyMultiplication(const std::string& tag, bool bReportIndividualTestCases
 			cref = ref;
 			if (result != cref) {
 				nrOfFailedTests++;
-				if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "*", a, b, cref, result);
+				if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "*", a, b, cref, result);
 			}
 			else {
 				// if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "*", a, b, cref, result);
 			}
-			if (nrOfFailedTests > 24) return nrOfFailedTests;
+			if (nrOfFailedTests > 24) break;
 		}
-		if (i % 1024 == 0) std::cout << '.';
-	}
-	std::cout << std::endl;
-	return nrOfFailedTests;
+		return nrOfFailedTests;
+	}, std::cerr, 24);
 }
 
 // enumerate all division cases for an fixpnt<nbits,rbits> configuration
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
 int VerifyDivision(const std::string& tag, bool bReportIndividualTestCases) {
 	constexpr size_t NR_VALUES = (size_t(1) << nbits);
-	int nrOfFailedTests = 0;
-	fixpnt<nbits, rbits, arithmetic, BlockType> a, b, result, cref;
-	double ref;
 
 	// set the saturation clamps
 	fixpnt<nbits, rbits, arithmetic, BlockType> fpmaxpos, fpmaxneg;
 	maxpos<nbits, rbits, arithmetic, BlockType>(fpmaxpos);
 	maxneg<nbits, rbits, arithmetic, BlockType>(fpmaxneg);
 
-	double da, db;
-	for (size_t i = 0; i < NR_VALUES; i++) {
+	return VerifyRows(NR_VALUES, [&](size_t i, std::ostream& report) {
+		int nrOfFailedTests = 0;
+		fixpnt<nbits, rbits, arithmetic, BlockType> a, b, result, cref;
+		double ref;
 		a.set_raw_bits(i);
-		da = double(a);
+		double da = double(a);
 		for (size_t j = 0; j < NR_VALUES; j++) {
 			b.set_raw_bits(j);
-			db = double(b);
+			double db = double(b);
 			if (j != 0) {
 				ref = da / db;
 			}
@@ -508,17 +533,15 @@ int VerifyDivision(const std::string& tag, bool bReportIndividualTestCases) {
 			cref = ref;
 			if (result != cref) {
 				nrOfFailedTests++;
-				if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "/", a, b, cref, result);
+				if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "/", a, b, cref, result);
 			}
 			else {
 				// if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "/", a, b, cref, result);
 			}
-			if (nrOfFailedTests > 24) return nrOfFailedTests;
+			if (nrOfFailedTests > 24) break;
 		}
-		if (i % 1024 == 0) std::cout << '.';
-	}
-	std::cout << std::endl;
-	return nrOfFailedTests;
+		return nrOfFailedTests;
+	}, std::cerr, 24);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <iostream>
 #include <string>
+#include "verification_engine.hpp"
 
 // the integer number class will be configured outside of this helper
 //
@@ -19,9 +20,9 @@ namespace unum {
 
 #define INTEGER_TABLE_WIDTH 20
 	template<size_t nbits, typename BlockType>
-	void ReportBinaryArithmeticError(const std::string& test_case, const std::string& op, const integer<nbits, BlockType>& lhs, const integer<nbits, BlockType>& rhs, const integer<nbits, BlockType>& pref, const integer<nbits, BlockType>& presult) {
-		auto old_precision = std::cerr.precision(); 
-		std::cerr << test_case << " "
+	void ReportBinaryArithmeticError(std::ostream& ostr, const std::string& test_case, const std::string& op, const integer<nbits, BlockType>& lhs, const integer<nbits, BlockType>& rhs, const integer<nbits, BlockType>& pref, const integer<nbits, BlockType>& presult) {
+		auto old_precision = ostr.precision(); 
+		ostr << test_case << " "
 			<< std::setprecision(20)
 			<< std::setw(INTEGER_TABLE_WIDTH) << lhs
 			<< " " << op << " "
@@ -35,9 +36,14 @@ namespace unum {
 	}
 
 	template<size_t nbits, typename BlockType>
-	void ReportBinaryArithmeticSuccess(const std::string& test_case, const std::string& op, const integer<nbits, BlockType>& lhs, const integer<nbits, BlockType>& rhs, const integer<nbits, BlockType>& pref, const integer<nbits, BlockType>& presult) {
-		auto old_precision = std::cerr.precision();
-		std::cerr << test_case << " "
+	void ReportBinaryArithmeticError(const std::string& test_case, const std::string& op, const integer<nbits, BlockType>& lhs, const integer<nbits, BlockType>& rhs, const integer<nbits, BlockType>& pref, const integer<nbits, BlockType>& presult) {
+		ReportBinaryArithmeticError(std::cerr, test_case, op, lhs, rhs, pref, presult);
+	}
+
+	template<size_t nbits, typename BlockType>
+	void ReportBinaryArithmeticSuccess(std::ostream& ostr, const std::string& test_case, const std::string& op, const integer<nbits, BlockType>& lhs, const integer<nbits, BlockType>& rhs, const integer<nbits, BlockType>& pref, const integer<nbits, BlockType>& presult) {
+		auto old_precision = ostr.precision();
+		ostr << test_case << " "
 			<< std::setprecision(20)
 			<< std::setw(INTEGER_TABLE_WIDTH) << lhs
 			<< " " << op << " "
@@ -50,6 +56,11 @@ namespace unum {
 			<< std::endl;
 	}
 
+	template<size_t nbits, typename BlockType>
+	void ReportBinaryArithmeticSuccess(const std::string& test_case, const std::string& op, const integer<nbits, BlockType>& lhs, const integer<nbits, BlockType>& rhs, const integer<nbits, BlockType>& pref, const integer<nbits, BlockType>& presult) {
+		ReportBinaryArithmeticSuccess(std::cerr, test_case, op, lhs, rhs, pref, presult);
+	}
+
 	template<size_t nbits, typename BlockType>
 	void ReportUnaryArithmeticError(const std::string& test_case, const std::string& op, const integer<nbits, BlockType>& argument, const integer<nbits, BlockType>& ref, const integer<nbits, BlockType>& result) {
 		auto old_precision = std::cerr.precision();
@@ -71,16 +82,14 @@ namespace unum {
 		constexpr size_t nbits = 16;
 
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		short i64a, i64b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i64a = short(ia);
+			short i64a = short(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i64b = short(ib);
+				short i64b = short(ib);
 				iref = i64a + i64b;
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
@@ -101,17 +110,14 @@ namespace unum {
 #endif
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "+", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "+", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "+", ia, ib, iref, iresult);
 				}
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 	// enumerate all subtraction cases for an integer<16> configuration compared against native short
 	template<typename BlockType>
@@ -119,16 +125,14 @@ namespace unum {
 		constexpr size_t nbits = 16;
 
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		short i16a, i16b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i16a = short(ia);
+			short i16a = short(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i16b = short(ib);
+				short i16b = short(ib);
 				iref = i16a - i16b;
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
@@ -149,17 +153,14 @@ namespace unum {
 #endif
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "-", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "-", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "-", ia, ib, iref, iresult);
 				}
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 	// enumerate all multiplication cases for an integer<16> configuration compared against native short
 	template<typename BlockType>
@@ -167,16 +168,14 @@ namespace unum {
 		constexpr size_t nbits = 16;
 
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		short i16a, i16b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i16a = short(ia);
+			short i16a = short(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i16b = short(ib);
+				short i16b = short(ib);
 				iref = i16a * i16b;
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
@@ -197,17 +196,14 @@ namespace unum {
 #endif
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "*", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "*", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "*", ia, ib, iref, iresult);
 				}
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 	// enumerate all division cases for an integer<16> configuration compared against native short
 	template<typename BlockType>
@@ -215,16 +211,14 @@ namespace unum {
 		constexpr size_t nbits = 16;
 
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		short i16a, i16b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i16a = short(ia);
+			short i16a = short(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i16b = short(ib);
+				short i16b = short(ib);
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				if (j == 0) {
 					try {
@@ -251,24 +245,25 @@ namespace unum {
 						nrOfFailedTests++;
 					}
 				}
+				else {
+					iresult = ia / ib;
+				}
 #else
 				if (j == 0) continue;
+				iref = i16a / i16b;
 				iresult = ia / ib;
 #endif
 
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "/", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "/", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "/", ia, ib, iref, iresult);
 				}
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 	// enumerate all remainder cases for an integer<16> configuration compared against native short
 	template<typename BlockType = uint8_t>
@@ -276,22 +271,20 @@ namespace unum {
 		constexpr size_t nbits = 16;
 
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		short i16a, i16b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i16a = short(ia);
+			short i16a = short(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i16b = short(ib);
+				short i16b = short(ib);
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
 					iresult = ia % ib;
 				}
 				catch (...) {
-					if (iref > max_int<nbits, BlockType>() || iref < min_int<nbits, BlockType>()) {
+					if (j == 0) {
 						// correctly caught the exception
 						continue;
 					}
@@ -300,38 +293,34 @@ namespace unum {
 					}
 				}
 #else
+				if (j == 0) continue;
 				iresult = ia % ib;
 #endif
 				iref = i16a % i16b;
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "%", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "%", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "%", ia, ib, iref, iresult);
 				}
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// enumerate all addition cases for an integer<nbits, BlockType> configuration
 	template<size_t nbits, typename BlockType>
 	int VerifyAddition(const std::string& tag, bool bReportIndividualTestCases) {
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		int64_t i64a, i64b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i64a = int64_t(ia);
+			int64_t i64a = int64_t(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i64b = int64_t(ib);
+				int64_t i64b = int64_t(ib);
 				iref = i64a + i64b;
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
@@ -352,32 +341,28 @@ namespace unum {
 #endif
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "+", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "+", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "+", ia, ib, iref, iresult);
 				}
-				if (nrOfFailedTests > 100) return nrOfFailedTests;
+				if (nrOfFailedTests > 100) break;
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		}, std::cerr, 100);
 	}
 	// enumerate all subtraction cases for an integer<nbits, BlockType> configuration
 	template<size_t nbits, typename BlockType>
 	int VerifySubtraction(const std::string& tag, bool bReportIndividualTestCases) {
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		int64_t i64a, i64b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i64a = int64_t(ia);
+			int64_t i64a = int64_t(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i64b = int64_t(ib);
+				int64_t i64b = int64_t(ib);
 				iref = i64a - i64b;
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
@@ -398,33 +383,29 @@ namespace unum {
 #endif
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "-", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "-", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "-", ia, ib, iref, iresult);
 				}
-				if (nrOfFailedTests > 100) return nrOfFailedTests;
+				if (nrOfFailedTests > 100) break;
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		}, std::cerr, 100);
 	}
 
 	// enumerate all multiplication cases for an integer<nbits, BlockType> configuration
 	template<size_t nbits, typename BlockType>
 	int VerifyMultiplication(const std::string& tag, bool bReportIndividualTestCases) {
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		int64_t i64a, i64b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i64a = int64_t(ia);
+			int64_t i64a = int64_t(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i64b = int64_t(ib);
+				int64_t i64b = int64_t(ib);
 				iref = i64a * i64b;
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
@@ -445,33 +426,29 @@ namespace unum {
 #endif
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "*", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "*", ia, ib, iref, iresult);
 				}
 				else {
-					if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "*", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess(report, "PASS", "*", ia, ib, iref, iresult);
 				}
-				if (nrOfFailedTests > 100) return nrOfFailedTests;
+				if (nrOfFailedTests > 100) break;
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		}, std::cerr, 100);
 	}
 
 	// enumerate all division cases for an integer<nbits, BlockType> configuration
 	template<size_t nbits, typename BlockType>
 	int VerifyDivision(const std::string& tag, bool bReportIndividualTestCases) {
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		int64_t i64a, i64b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i64a = int64_t(ia);
+			int64_t i64a = int64_t(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i64b = int64_t(ib);
+				int64_t i64b = int64_t(ib);
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
 					iresult = ia / ib;
@@ -482,16 +459,16 @@ namespace unum {
 						continue;
 					}
 					else {
-						std::cerr << "unexpected : " << e.what() << std::endl;
+						report << "unexpected : " << e.what() << std::endl;
 						nrOfFailedTests++;
 					}
 				}
 				catch (const integer_overflow& e) {
-					std::cerr << e.what() << std::endl;
+					report << e.what() << std::endl;
 					// TODO: how do you validate the overflow?
 				}
 				catch (...) {
-					std::cerr << "unexpected exception" << std::endl;
+					report << "unexpected exception" << std::endl;
 					nrOfFailedTests++;
 				}
 #else
@@ -505,33 +482,29 @@ namespace unum {
 				}
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "/", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "/", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "/", ia, ib, iref, iresult);
 				}
-				if (nrOfFailedTests > 100) return nrOfFailedTests;
+				if (nrOfFailedTests > 100) break;
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		}, std::cerr, 100);
 	}
 
 	// enumerate all remainder cases for an integer<nbits, BlockType> configuration
 	template<size_t nbits, typename BlockType>
 	int VerifyRemainder(const std::string& tag, bool bReportIndividualTestCases) {
 		constexpr size_t NR_INTEGERS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		integer<nbits, BlockType> ia, ib, iresult, iref;
-
-		int64_t i64a, i64b;
-		for (size_t i = 0; i < NR_INTEGERS; i++) {
+		return VerifyRows(NR_INTEGERS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			integer<nbits, BlockType> ia, ib, iresult, iref;
 			ia.set_raw_bits(i);
-			i64a = int64_t(ia);
+			int64_t i64a = int64_t(ia);
 			for (size_t j = 0; j < NR_INTEGERS; j++) {
 				ib.set_raw_bits(j);
-				i64b = int64_t(ib);
+				int64_t i64b = int64_t(ib);
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 				try {
 					iresult = ia % ib;
@@ -552,17 +525,15 @@ namespace unum {
 				iref = i64a % i64b;
 				if (iresult != iref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "%", ia, ib, iref, iresult);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "%", ia, ib, iref, iresult);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "%", ia, ib, iref, iresult);
 				}
-				if (nrOfFailedTests > 100) return nrOfFailedTests;
+				if (nrOfFailedTests > 100) break;
 			}
-			if (i % 1024 == 0) std::cout << '.';
-		}
-		std::cout << std::endl;
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		}, std::cerr, 100);
 	}
 
 } // namespace unum
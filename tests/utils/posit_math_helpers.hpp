@@ -10,6 +10,8 @@
 #include <typeinfo>
 #include <random>
 #include <limits>
+#include <cmath>
+#include <cfenv>
 
 // mathematical function definitions and implementations
 #include "universal/posit/math_functions.hpp"
@@ -22,6 +24,44 @@ namespace sw {
 
 //		static constexpr unsigned FLOAT_TABLE_WIDTH = 15;
 
+		// Generate the correctly rounded posit reference of a function value.
+		// The reference is evaluated in long double, and the floating-point status flags separate
+		// a pole, which maps to NaR, from an overflow or underflow of the long double result,
+		// which posit arithmetic saturates to maxpos or minpos.
+		// Returns false when the long double reference is too close to a rounding boundary
+		// of the posit to decide which way the correctly rounded result goes.
+		template<size_t nbits, size_t es, typename Reference>
+		bool CorrectlyRoundedReference(Reference reference, posit<nbits, es>& pref, unsigned ulps = 8) {
+			std::feclearexcept(FE_ALL_EXCEPT);
+			long double v = reference();
+			if (std::isnan(v) || std::fetestexcept(FE_DIVBYZERO)) {
+				pref.setnar();
+				return true;
+			}
+			if (v == 0.0l && !std::fetestexcept(FE_UNDERFLOW)) {
+				pref.setzero();
+				return true;
+			}
+			// values outside of the dynamic range saturate: the conversions of the fast specializations
+			// may go through a narrower floating-point type, so do not leave the projection to them
+			posit<nbits, es> pmaxpos, pminpos;
+			maxpos(pmaxpos);
+			minpos(pminpos);
+			if (std::fabs(v) >= static_cast<long double>(pmaxpos)) {
+				pref = (v < 0 ? -pmaxpos : pmaxpos);
+				return true;
+			}
+			if (std::fabs(v) <= static_cast<long double>(pminpos)) {
+				pref = (std::signbit(v) ? -pminpos : pminpos);
+				return true;
+			}
+			// the long double math library is faithful to a few ulps
+			long double eps = ulps * std::numeric_limits<long double>::epsilon();
+			pref = v;
+			posit<nbits, es> lo(v - v * eps), hi(v + v * eps);
+			return lo == hi;
+		}
+
 		template<size_t nbits, size_t es>
 		void ReportTwoInputFunctionError(const std::string& test_case, const std::string& op, const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
 			std::cerr << test_case << " " << op << "("
@@ -85,13 +125,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, plog, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				plog = sw::unum::log(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::log(da);
+				if (!CorrectlyRoundedReference([&] { return std::log(static_cast<long double>(pa)); }, pref)) continue;
 				if (plog != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "log", pa, pref, plog);
@@ -110,13 +148,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, plog2, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				plog2 = sw::unum::log2(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::log2(da);
+				if (!CorrectlyRoundedReference([&] { return std::log2(static_cast<long double>(pa)); }, pref)) continue;
 				if (plog2 != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "log2", pa, pref, plog2);
@@ -136,13 +172,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, plog10, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				plog10 = sw::unum::log10(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::log10(da);
+				if (!CorrectlyRoundedReference([&] { return std::log10(static_cast<long double>(pa)); }, pref)) continue;
 				if (plog10 != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "log10", pa, pref, plog10);
@@ -162,18 +196,14 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, pexp, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				pexp = sw::unum::exp(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::exp(da);
+				if (!CorrectlyRoundedReference([&] { return std::exp(static_cast<long double>(pa)); }, pref)) continue;
 				if (pexp != pref) {
-					if (std::exp(da) != 0.0) { // exclude special posit rounding rule that projects to minpos
-						nrOfFailedTests++;
-						if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "exp", pa, pref, pexp);	
-					}
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "exp", pa, pref, pexp);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportOneInputFunctionSuccess("PASS", "exp", pa, pref, pexp);
@@ -189,18 +219,14 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, pexp2, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				pexp2 = sw::unum::exp2(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::exp2(da);
+				if (!CorrectlyRoundedReference([&] { return std::exp2(static_cast<long double>(pa)); }, pref)) continue;
 				if (pexp2 != pref) {
-					if (std::exp(da) != 0.0) { // exclude special posit rounding rule that projects to minpos
-						nrOfFailedTests++;
-						if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "exp2", pa, pref, pexp2);
-					}
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "exp2", pa, pref, pexp2);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportOneInputFunctionSuccess("PASS", "exp2", pa, pref, pexp2);
@@ -217,13 +243,10 @@ namespace sw {
 			posit<nbits, es> pa, pb, ppow, pref;
 
 			uint32_t testNr = 0;
-			double da, db;
 			for (int i = 0; i < NR_POSITS; i++) {
 				pa.set_raw_bits(i);
-				da = double(pa);
 				for (int j = 0; j < NR_POSITS; j++) {
 					pb.set_raw_bits(j);
-					db = double(pb);
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 					try {
 						ppow = pow(pa, pb);
@@ -239,8 +262,7 @@ namespace sw {
 #else
 					ppow = pow(pa, pb);
 #endif
-					pref = std::pow(da, db);
-					if (ppow != pref) {
+					if (CorrectlyRoundedReference([&] { return std::pow(static_cast<long double>(pa), static_cast<long double>(pb)); }, pref) && ppow != pref) {
 						nrOfFailedTests++;
 						if (bReportIndividualTestCases)	ReportTwoInputFunctionError("FAIL", "pow", pa, pb, pref, ppow);
 					}
@@ -265,13 +287,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, psin, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				psin = sw::unum::sin(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::sin(da);
+				if (!CorrectlyRoundedReference([&] { return std::sin(static_cast<long double>(pa)); }, pref)) continue;
 				if (psin != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "sin", pa, pref, psin);
@@ -290,13 +310,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, pcos, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				pcos = sw::unum::cos(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::cos(da);
+				if (!CorrectlyRoundedReference([&] { return std::cos(static_cast<long double>(pa)); }, pref)) continue;
 				if (pcos != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "cos", pa, pref, pcos);
@@ -315,13 +333,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, ptan, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				ptan = sw::unum::tan(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::tan(da);
+				if (!CorrectlyRoundedReference([&] { return std::tan(static_cast<long double>(pa)); }, pref)) continue;
 				if (ptan != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "tan", pa, pref, ptan);
@@ -340,13 +356,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, patan, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				patan = sw::unum::atan(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::atan(da);
+				if (!CorrectlyRoundedReference([&] { return std::atan(static_cast<long double>(pa)); }, pref)) continue;
 				if (patan != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "atan", pa, pref, patan);
@@ -365,13 +379,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, pasin, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				pasin = sw::unum::asin(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::asin(da);
+				if (!CorrectlyRoundedReference([&] { return std::asin(static_cast<long double>(pa)); }, pref)) continue;
 				if (pasin != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "asin", pa, pref, pasin);
@@ -390,13 +402,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, pacos, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				pacos = sw::unum::acos(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::acos(da);
+				if (!CorrectlyRoundedReference([&] { return std::acos(static_cast<long double>(pa)); }, pref)) continue;
 				if (pacos != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "acos", pa, pref, pacos);
@@ -415,13 +425,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, psinh, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				psinh = sw::unum::sinh(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::sinh(da);
+				if (!CorrectlyRoundedReference([&] { return std::sinh(static_cast<long double>(pa)); }, pref)) continue;
 				if (psinh != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "sinh", pa, pref, psinh);
@@ -440,13 +448,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, pcosh, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				pcosh = sw::unum::cosh(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::cosh(da);
+				if (!CorrectlyRoundedReference([&] { return std::cosh(static_cast<long double>(pa)); }, pref)) continue;
 				if (pcosh != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "cosh", pa, pref, pcosh);
@@ -465,13 +471,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, ptanh, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				ptanh = sw::unum::tanh(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::tanh(da);
+				if (!CorrectlyRoundedReference([&] { return std::tanh(static_cast<long double>(pa)); }, pref)) continue;
 				if (ptanh != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "tanh", pa, pref, ptanh);
@@ -490,13 +494,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, patanh, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				patanh = sw::unum::atanh(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::atanh(da);
+				if (!CorrectlyRoundedReference([&] { return std::atanh(static_cast<long double>(pa)); }, pref)) continue;
 				if (patanh != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "atanh", pa, pref, patanh);
@@ -515,13 +517,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, pasinh, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				pasinh = sw::unum::asinh(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::asinh(da);
+				if (!CorrectlyRoundedReference([&] { return std::asinh(static_cast<long double>(pa)); }, pref)) continue;
 				if (pasinh != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "asinh", pa, pref, pasinh);
@@ -540,13 +540,11 @@ namespace sw {
 			int nrOfFailedTests = 0;
 			posit<nbits, es> pa, pacosh, pref;
 
-			double da;
 			for (int i = 1; i < NR_TEST_CASES; i++) {
 				pa.set_raw_bits(i);
 				pacosh = sw::unum::acosh(pa);
 				// generate reference
-				da = double(pa);
-				pref = std::acosh(da);
+				if (!CorrectlyRoundedReference([&] { return std::acosh(static_cast<long double>(pa)); }, pref)) continue;
 				if (pacosh != pref) {
 					nrOfFailedTests++;
 					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", "acosh", pa, pref, pacosh);
@@ -558,6 +556,96 @@ namespace sw {
 			return nrOfFailedTests;
 		}
 
+		//////////////////////////////////// RANDOMIZED TEST SUITE FOR ELEMENTARY FUNCTIONS ////////////////////////
+
+		// generate a random posit encoding, which samples the full dynamic range of the configuration
+		template<size_t nbits, size_t es>
+		posit<nbits, es> RandomEncoding(std::mt19937_64& eng) {
+			bitblock<nbits> raw;
+			uint64_t bits = 0;
+			for (size_t i = 0; i < nbits; ++i) {
+				if (i % 64 == 0) bits = eng();
+				raw[i] = (bits & 1);
+				bits >>= 1;
+			}
+			posit<nbits, es> p;
+			p.set(raw);
+			return p;
+		}
+
+		// randomized test of the correct rounding of a function for posit configurations that are too large to enumerate
+		// function is the posit implementation, and reference the long double math library function.
+		// posits with more than 64 fraction bits are beyond the precision of the long double reference: use ValidateWorkingPrecision
+		template<size_t nbits, size_t es, typename Function, typename Reference>
+		int ValidateCorrectRounding(const std::string& op, Function function, Reference reference, bool bReportIndividualTestCases, unsigned nrRandoms = 10000, unsigned ulps = 4) {
+			std::mt19937_64 eng(nbits * 1000 + es);
+			int nrOfFailedTests = 0;
+			posit<nbits, es> pa, presult, pref;
+			for (unsigned n = 0; n < nrRandoms; ++n) {
+				pa = RandomEncoding<nbits, es>(eng);
+				presult = function(pa);
+				if (!CorrectlyRoundedReference([&] { return reference(static_cast<long double>(pa)); }, pref, ulps)) continue;
+				if (presult != pref) {
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", op, pa, pref, presult);
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// randomized test of an elementary function against an evaluation of the native kernels at a higher working precision:
+		// a correctly rounded result does not depend on the precision in which it is computed
+		template<size_t nbits, size_t es, typename Function>
+		int ValidateWorkingPrecision(const std::string& op, internal::elementary_function f, Function function, bool bReportIndividualTestCases, unsigned nrRandoms = 1000) {
+			constexpr size_t L = internal::xf_precision<nbits>::second + 2;
+			std::mt19937_64 eng(nbits * 1000 + es);
+			int nrOfFailedTests = 0;
+			posit<nbits, es> pa, presult, pref;
+			for (unsigned n = 0; n < nrRandoms; ++n) {
+				pa = RandomEncoding<nbits, es>(eng);
+				presult = function(pa);
+				if (!internal::elementary_special_case(f, pa, pref)) {
+					int lost = 0;
+					internal::xfloat<L> y = internal::xf_elementary<nbits, es, L>(f, internal::xfloat<L>(pa), lost);
+					if (!internal::xf_round_verified(y, lost, pref)) continue;
+				}
+				if (presult != pref) {
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases)	ReportOneInputFunctionError("FAIL", op, pa, pref, presult);
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// the last evaluation stage resolves an error interval that contains a rounding boundary as a tie:
+		// the midpoint of two neighbouring posits, with an error bound that spans the boundary, rounds to the even encoding
+		template<size_t nbits, size_t es>
+		int ValidateRoundingBoundary(bool bReportIndividualTestCases, unsigned nrRandoms = 1000) {
+			constexpr size_t L = internal::xf_precision<nbits>::third;
+			using X = internal::xfloat<L>;
+			// an error bound of 2^-(nbits + 2) relative to the midpoint
+			constexpr int lost = X::mbits - internal::XFLOAT_GUARD_BITS - int(nbits) - 2;
+			std::mt19937_64 eng(nbits * 1000 + es);
+			int nrOfFailedTests = 0;
+			posit<nbits, es> pa, pb, presult, pref;
+			for (unsigned n = 0; n < nrRandoms; ++n) {
+				// a scale near 1, where neighbouring posits differ in their fraction bits
+				pa = RandomEncoding<nbits, es>(eng);
+				if (pa.iszero() || pa.isnar() || scale(pa) < -8 || scale(pa) > 8) continue;
+				pb = pa;
+				++pb;
+				X midpoint = internal::xf_ldexp(X(pa) + X(pb), -1);
+				pref = pa.get()[0] ? pb : pa;
+				bool fail = internal::xf_round_verified(midpoint, lost, presult);
+				fail = fail || !internal::xf_round_verified(midpoint, lost, presult, true) || presult != pref;
+				if (fail) {
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases) std::cout << "FAIL: midpoint of " << pa << " and " << pb << " rounds to " << presult << " instead of " << pref << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
 		//////////////////////////////////// RANDOMIZED TEST SUITE FOR BINARY OPERATORS ////////////////////////
 
 
@@ -6,10 +6,12 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <typeinfo>
 #include <random>
 #include <limits>
+#include "verification_engine.hpp"
 
 namespace sw {
 namespace unum {
@@ -17,7 +19,7 @@ namespace unum {
 	static constexpr unsigned FLOAT_TABLE_WIDTH = 15;
 
 	template<size_t nbits, size_t es>
-	void ReportConversionError(const std::string& test_case, const std::string& op, double input, double reference, const posit<nbits, es>& presult) {
+	void ReportConversionError(std::ostream& ostr, const std::string& test_case, const std::string& op, double input, double reference, const posit<nbits, es>& presult) {
 		constexpr size_t fbits = nbits - 3 - es;
 
 		bool		     	 _sign;
@@ -27,7 +29,7 @@ namespace unum {
 		decode(presult.get(), _sign, _regime, _exponent, _fraction);
 		int                  _scale = _regime.scale() + _exponent.scale();
 
-		std::cerr << test_case
+		ostr << test_case
 			<< " " << op << " "
 			<< std::setw(FLOAT_TABLE_WIDTH) << input
 			<< " did not convert to "
@@ -39,10 +41,10 @@ namespace unum {
 	}
 
 	template<>
-	void ReportConversionError<2,0>(const std::string& test_case, const std::string& op, double input, double reference, const posit<2, 0>& presult) {
+	void ReportConversionError<2,0>(std::ostream& ostr, const std::string& test_case, const std::string& op, double input, double reference, const posit<2, 0>& presult) {
 		constexpr size_t nbits = 2;
 		//constexpr size_t es = 0;
-		std::cerr << test_case
+		ostr << test_case
 			<< " " << op << " "
 			<< std::setw(FLOAT_TABLE_WIDTH) << input
 			<< " did not convert to "
@@ -54,10 +56,10 @@ namespace unum {
 
 	}
 	template<>
-	void ReportConversionError<3, 1>(const std::string& test_case, const std::string& op, double input, double reference, const posit<3, 1>& presult) {
+	void ReportConversionError<3, 1>(std::ostream& ostr, const std::string& test_case, const std::string& op, double input, double reference, const posit<3, 1>& presult) {
 		constexpr size_t nbits = 3;
 		//constexpr size_t es = 1; 
-		std::cerr << test_case
+		ostr << test_case
 			<< " " << op << " "
 			<< std::setw(FLOAT_TABLE_WIDTH) << input
 			<< " did not convert to "
@@ -69,6 +71,11 @@ namespace unum {
 
 	}
 
+	template<size_t nbits, size_t es>
+	void ReportConversionError(const std::string& test_case, const std::string& op, double input, double reference, const posit<nbits, es>& presult) {
+		ReportConversionError(std::cerr, test_case, op, input, reference, presult);
+	}
+
 	template<size_t nbits, size_t es>
 	void ReportConversionSuccess(const std::string& test_case, const std::string& op, double input, double reference, const posit<nbits, es>& presult) {
 		static_assert(nbits > 1, "component_to_string requires nbits >= 2");
@@ -108,8 +115,8 @@ namespace unum {
 	}
 
 	template<size_t nbits, size_t es>
-	void ReportUnaryArithmeticError(const std::string& test_case, const std::string& op, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
-		std::cerr << test_case
+	void ReportUnaryArithmeticError(std::ostream& ostr, const std::string& test_case, const std::string& op, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
+		ostr << test_case
 			<< " " << op << " "
 			<< std::setw(FLOAT_TABLE_WIDTH) << rhs
 			<< " != "
@@ -119,8 +126,13 @@ namespace unum {
 	}
 
 	template<size_t nbits, size_t es>
-	void ReportUnaryArithmeticSuccess(const std::string& test_case, const std::string& op, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
-		std::cerr << test_case
+	void ReportUnaryArithmeticError(const std::string& test_case, const std::string& op, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
+		ReportUnaryArithmeticError(std::cerr, test_case, op, rhs, pref, presult);
+	}
+
+	template<size_t nbits, size_t es>
+	void ReportUnaryArithmeticSuccess(std::ostream& ostr, const std::string& test_case, const std::string& op, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
+		ostr << test_case
 			<< " " << op << " "
 			<< std::setw(FLOAT_TABLE_WIDTH) << rhs
 			<< " == "
@@ -130,8 +142,13 @@ namespace unum {
 	}
 
 	template<size_t nbits, size_t es>
-	void ReportBinaryArithmeticError(const std::string& test_case, const std::string& op, const posit<nbits, es>& lhs, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
-		std::cerr << test_case << " " 
+	void ReportUnaryArithmeticSuccess(const std::string& test_case, const std::string& op, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
+		ReportUnaryArithmeticSuccess(std::cerr, test_case, op, rhs, pref, presult);
+	}
+
+	template<size_t nbits, size_t es>
+	void ReportBinaryArithmeticError(std::ostream& ostr, const std::string& test_case, const std::string& op, const posit<nbits, es>& lhs, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
+		ostr << test_case << " " 
 			<< std::setprecision(20)
 			<< std::setw(FLOAT_TABLE_WIDTH) << lhs
 			<< " " << op << " "
@@ -144,6 +161,11 @@ namespace unum {
 			<< std::endl;
 	}
 
+	template<size_t nbits, size_t es>
+	void ReportBinaryArithmeticError(const std::string& test_case, const std::string& op, const posit<nbits, es>& lhs, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
+		ReportBinaryArithmeticError(std::cerr, test_case, op, lhs, rhs, pref, presult);
+	}
+
 	template<size_t nbits, size_t es>
 	void ReportBinaryArithmeticErrorInBinary(const std::string& test_case, const std::string& op, const posit<nbits, es>& lhs, const posit<nbits, es>& rhs, const posit<nbits, es>& pref, const posit<nbits, es>& presult) {
 		std::cerr << test_case << " "
@@ -191,12 +213,12 @@ namespace unum {
 	/////////////////////////////// VERIFICATION TEST SUITES ////////////////////////////////
 
 	template<size_t nbits, size_t es>
-	int Compare(double input, const posit<nbits, es>& presult, double reference, bool bReportIndividualTestCases) {
+	int Compare(std::ostream& ostr, double input, const posit<nbits, es>& presult, double reference, bool bReportIndividualTestCases) {
 		int fail = 0;
 		double result = double(presult);
 		if (std::fabs(result - reference) > 0.000000001) {
 			fail++;
-			if (bReportIndividualTestCases)	ReportConversionError("FAIL", "=", input, reference, presult);
+			if (bReportIndividualTestCases)	ReportConversionError(ostr, "FAIL", "=", input, reference, presult);
 		}
 		else {
 			// if (bReportIndividualTestCases) ReportConversionSuccess("PASS", "=", input, reference, presult);
@@ -204,6 +226,26 @@ namespace unum {
 		return fail;
 	}
 
+	template<size_t nbits, size_t es>
+	int Compare(double input, const posit<nbits, es>& presult, double reference, bool bReportIndividualTestCases) {
+		return Compare(std::cerr, input, presult, reference, bReportIndividualTestCases);
+	}
+
+	// the conversion suites verify their test cases in rows of CONVERSION_CASES_PER_ROW consecutive cases
+	constexpr size_t CONVERSION_CASES_PER_ROW = 256;
+
+	// the posits that start the rows of an enumeration that steps from first with ++ (or -- when descending)
+	template<size_t nbits, size_t es>
+	std::vector< posit<nbits, es> > ConversionRowStarts(const posit<nbits, es>& first, size_t nrCases, bool descending = false) {
+		std::vector< posit<nbits, es> > starts((nrCases + CONVERSION_CASES_PER_ROW - 1) / CONVERSION_CASES_PER_ROW);
+		posit<nbits, es> p(first);
+		for (size_t i = 0; i < nrCases; ++i) {
+			if (i % CONVERSION_CASES_PER_ROW == 0) starts[i / CONVERSION_CASES_PER_ROW] = p;
+			if (descending) --p; else ++p;
+		}
+		return starts;
+	}
+
 	// logic operator consistency check
 	template<size_t nbits, size_t es>
 	void testLogicOperators(const sw::unum::posit<nbits, es>& a, const sw::unum::posit<nbits, es>& b) {
@@ -233,100 +275,104 @@ namespace unum {
 			std::cout << "ValidateConversion<" << nbits << "," << es << ">: NR_TEST_CASES = " << NR_TEST_CASES << " constrained due to nbits > 20" << std::endl;
 		}
 
-		// execute the test
-		int nrOfFailedTests = 0;
-		for (size_t i = 0; i < NR_TEST_CASES; i++) {
-			posit<nbits + 1, es> pref, pprev, pnext;
-
-			pref.set_raw_bits(i);
-			double da = double(pref);
-			double eps = (i == 0) ? minpos_value<nbits + 1, es>() / 2.0 : (da > 0 ? da * 1.0e-6 : da * -1.0e-6);
-			double input;
-			posit<nbits, es> pa;
-			if (i % 2) {
-				if (i == 1) {
-					// special case of projecting to +minpos
-					// even the -delta goes to +minpos
-					input = da - eps;
-					pa = input;
-					pnext.set_raw_bits(i + 1);
-					nrOfFailedTests += Compare(input, pa, (double)pnext, bReportIndividualTestCases);
-					input = da + eps;
-					pa = input;
-					nrOfFailedTests += Compare(input, pa, (double)pnext, bReportIndividualTestCases);
-				}
-				else if (i == HALF - 1) {
-					// special case of projecting to +maxpos
-					input = da - eps;
-					pa = input;
-					pprev.set_raw_bits(HALF - 2);
-					nrOfFailedTests += Compare(input, pa, (double)pprev, bReportIndividualTestCases);
-				}
-				else if (i == HALF + 1) {
-					// special case of projecting to -maxpos
-					input = da - eps;
-					pa = input;
-					pprev.set_raw_bits(HALF + 2);
-					nrOfFailedTests += Compare(input, pa, (double)pprev, bReportIndividualTestCases);
-				}
-				else if (i == NR_TEST_CASES - 1) {
-					// special case of projecting to -minpos
-					// even the +delta goes to -minpos
-					input = da - eps;
-					pa = input;
-					pprev.set_raw_bits(i - 1);
-					nrOfFailedTests += Compare(input, pa, (double)pprev, bReportIndividualTestCases);
-					input = da + eps;
-					pa = input;
-					nrOfFailedTests += Compare(input, pa, (double)pprev, bReportIndividualTestCases);
-				}
-				else {
-					// for odd values, we are between posit values, so we create the round-up and round-down cases
-					// round-down
-					input = da - eps;
-					pa = input;
-					pprev.set_raw_bits(i - 1);
-					nrOfFailedTests += Compare(input, pa, (double)pprev, bReportIndividualTestCases);
-					// round-up
-					input = da + eps;
-					pa = input;
-					pnext.set_raw_bits(i + 1);
-					nrOfFailedTests += Compare(input, pa, (double)pnext, bReportIndividualTestCases);
-				}
-			}
-			else {
-				// for the even values, we generate the round-to-actual cases
-				if (i == 0) {
-					// special case of assigning to 0
-					input = 0.0;
-					pa = input;
-					nrOfFailedTests += Compare(input, pa, da, bReportIndividualTestCases);
-					// special case of projecting to +minpos
-					input = da + eps;
-					pa = input;
-					pnext.set_raw_bits(i + 2);
-					nrOfFailedTests += Compare(input, pa, (double)pnext, bReportIndividualTestCases);
-				}
-				else if (i == NR_TEST_CASES - 2) {
-					// special case of projecting to -minpos
-					input = da - eps;
-					pa = input;
-					pprev.set_raw_bits(NR_TEST_CASES - 2);
-					nrOfFailedTests += Compare(input, pa, (double)pprev, bReportIndividualTestCases);
+		// execute the test: the rows are blocks of consecutive reference encodings
+		const size_t nrRows = (NR_TEST_CASES + CONVERSION_CASES_PER_ROW - 1) / CONVERSION_CASES_PER_ROW;
+		return VerifyRows(nrRows, [&](size_t row, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			const size_t last = std::min(NR_TEST_CASES, (row + 1) * CONVERSION_CASES_PER_ROW);
+			for (size_t i = row * CONVERSION_CASES_PER_ROW; i < last; i++) {
+				posit<nbits + 1, es> pref, pprev, pnext;
+
+				pref.set_raw_bits(i);
+				double da = double(pref);
+				double eps = (i == 0) ? minpos_value<nbits + 1, es>() / 2.0 : (da > 0 ? da * 1.0e-6 : da * -1.0e-6);
+				double input;
+				posit<nbits, es> pa;
+				if (i % 2) {
+					if (i == 1) {
+						// special case of projecting to +minpos
+						// even the -delta goes to +minpos
+						input = da - eps;
+						pa = input;
+						pnext.set_raw_bits(i + 1);
+						nrOfFailedTests += Compare(report, input, pa, (double)pnext, bReportIndividualTestCases);
+						input = da + eps;
+						pa = input;
+						nrOfFailedTests += Compare(report, input, pa, (double)pnext, bReportIndividualTestCases);
+					}
+					else if (i == HALF - 1) {
+						// special case of projecting to +maxpos
+						input = da - eps;
+						pa = input;
+						pprev.set_raw_bits(HALF - 2);
+						nrOfFailedTests += Compare(report, input, pa, (double)pprev, bReportIndividualTestCases);
+					}
+					else if (i == HALF + 1) {
+						// special case of projecting to -maxpos
+						input = da - eps;
+						pa = input;
+						pprev.set_raw_bits(HALF + 2);
+						nrOfFailedTests += Compare(report, input, pa, (double)pprev, bReportIndividualTestCases);
+					}
+					else if (i == NR_TEST_CASES - 1) {
+						// special case of projecting to -minpos
+						// even the +delta goes to -minpos
+						input = da - eps;
+						pa = input;
+						pprev.set_raw_bits(i - 1);
+						nrOfFailedTests += Compare(report, input, pa, (double)pprev, bReportIndividualTestCases);
+						input = da + eps;
+						pa = input;
+						nrOfFailedTests += Compare(report, input, pa, (double)pprev, bReportIndividualTestCases);
+					}
+					else {
+						// for odd values, we are between posit values, so we create the round-up and round-down cases
+						// round-down
+						input = da - eps;
+						pa = input;
+						pprev.set_raw_bits(i - 1);
+						nrOfFailedTests += Compare(report, input, pa, (double)pprev, bReportIndividualTestCases);
+						// round-up
+						input = da + eps;
+						pa = input;
+						pnext.set_raw_bits(i + 1);
+						nrOfFailedTests += Compare(report, input, pa, (double)pnext, bReportIndividualTestCases);
+					}
 				}
 				else {
-					// round-up
-					input = da - eps;
-					pa = input;
-					nrOfFailedTests += Compare(input, pa, da, bReportIndividualTestCases);
-					// round-down
-					input = da + eps;
-					pa = input;
-					nrOfFailedTests += Compare(input, pa, da, bReportIndividualTestCases);
+					// for the even values, we generate the round-to-actual cases
+					if (i == 0) {
+						// special case of assigning to 0
+						input = 0.0;
+						pa = input;
+						nrOfFailedTests += Compare(report, input, pa, da, bReportIndividualTestCases);
+						// special case of projecting to +minpos
+						input = da + eps;
+						pa = input;
+						pnext.set_raw_bits(i + 2);
+						nrOfFailedTests += Compare(report, input, pa, (double)pnext, bReportIndividualTestCases);
+					}
+					else if (i == NR_TEST_CASES - 2) {
+						// special case of projecting to -minpos
+						input = da - eps;
+						pa = input;
+						pprev.set_raw_bits(NR_TEST_CASES - 2);
+						nrOfFailedTests += Compare(report, input, pa, (double)pprev, bReportIndividualTestCases);
+					}
+					else {
+						// round-up
+						input = da - eps;
+						pa = input;
+						nrOfFailedTests += Compare(report, input, pa, da, bReportIndividualTestCases);
+						// round-down
+						input = da + eps;
+						pa = input;
+						nrOfFailedTests += Compare(report, input, pa, da, bReportIndividualTestCases);
+					}
 				}
 			}
-		}
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 	template<>
 	int ValidateConversion<NBITS_IS_2, ES_IS_0>(const std::string& tag, bool bReportIndividualTestCases) {
@@ -366,21 +412,28 @@ namespace unum {
 			std::cout << tag << " FAIL long(" << ref << ") != long(" << presult << ") : reference = -2147483648" << std::endl;
 			nrOfFailedTestCases++;
 		}
-		posit<nbits, es> p(1);
-		for (size_t i = 0; i < NR_TEST_CASES; ++i) {
-			if (!p.isnar()) {
-				long ref = (long)p; // obtain the integer cast of this posit
-				presult = ref;		// assign this integer to a posit				
-				if (ref != presult) { // compare the integer cast to the reference posit
-					if (bReportIndividualTestCases) std::cout << tag << " FAIL long(" << p << ") != long(" << presult << ") : reference = " << ref << std::endl;
-					nrOfFailedTestCases++;
-				}
-				else {
-					//if (bReportIndividualTestCases) std::cout << tag << " PASS " << p << " casts to " << presult << " : reference = " << ref << std::endl;
+		// the rows are blocks of consecutive encodings, starting at 1
+		std::vector< posit<nbits, es> > starts = ConversionRowStarts(posit<nbits, es>(1), NR_TEST_CASES);
+		nrOfFailedTestCases += VerifyRows(starts.size(), [&](size_t row, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			posit<nbits, es> p(starts[row]), presult;
+			const size_t last = std::min(NR_TEST_CASES, (row + 1) * CONVERSION_CASES_PER_ROW);
+			for (size_t i = row * CONVERSION_CASES_PER_ROW; i < last; ++i) {
+				if (!p.isnar()) {
+					long ref = (long)p; // obtain the integer cast of this posit
+					presult = ref;		// assign this integer to a posit
+					if (ref != presult) { // compare the integer cast to the reference posit
+						if (bReportIndividualTestCases) report << tag << " FAIL long(" << p << ") != long(" << presult << ") : reference = " << ref << std::endl;
+						nrOfFailedTests++;
+					}
+					else {
+						//if (bReportIndividualTestCases) report << tag << " PASS " << p << " casts to " << presult << " : reference = " << ref << std::endl;
+					}
 				}
+				++p;
 			}
-			++p;
-		}
+			return nrOfFailedTests;
+		}, std::cout);
 		return nrOfFailedTestCases;
 	}
 /*
@@ -436,24 +489,12 @@ namespace unum {
 		size_t NR_TEST_CASES = (size_t(1) << (max - 1)) + 1;
 		int nrOfFailedTestCases = 0;
 
-		posit<nbits, es> p, presult;
-
-		if (nbits > 24) {
+		posit<nbits, es> p;
+		bool descending = nbits > 24;
+		if (descending) {
 			// cycle from largest value down to 0 via positive regime
 			constexpr unsigned long upper_bound = 0xFFFFFFFF;
 			p = upper_bound;
-			for (unsigned long i = upper_bound; i > upper_bound - (unsigned long)(NR_TEST_CASES); --i) {
-				unsigned long ref = (unsigned long)p;   // obtain the integer cast of this posit
-				presult = ref;		  // assign this integer to a reference posit
-				if (presult != ref) { // compare the integer cast to the reference posit
-					if (bReportIndividualTestCases) std::cout << tag << " FAIL uint32(" << p << ") != uint32(" << presult << ") : reference = " << ref << std::endl;
-					nrOfFailedTestCases++;
-				}
-				else {
-					//if (bReportIndividualTestCases) std::cout << tag << " PASS " << p << " == " << presult << " : reference = " << ref << std::endl;
-				}
-				--p;
-			}
 		}
 		else {
 			p = 1;
@@ -461,21 +502,30 @@ namespace unum {
 				if (bReportIndividualTestCases) std::cout << tag << " FAIL " << p << " != " << 1 << std::endl;
 				nrOfFailedTestCases++;
 			}
-			for (size_t i = 0; i < NR_TEST_CASES; ++i) {
+		}
+
+		// the rows are blocks of consecutive encodings
+		std::vector< posit<nbits, es> > starts = ConversionRowStarts(p, NR_TEST_CASES, descending);
+		nrOfFailedTestCases += VerifyRows(starts.size(), [&](size_t row, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			posit<nbits, es> p(starts[row]), presult;
+			const size_t last = std::min(NR_TEST_CASES, (row + 1) * CONVERSION_CASES_PER_ROW);
+			for (size_t i = row * CONVERSION_CASES_PER_ROW; i < last; ++i) {
 				if (!p.isnar()) {
 					unsigned long ref = (unsigned long)p;   // obtain the integer cast of this posit
 					presult = ref;		  // assign this integer to a reference posit
 					if (presult != ref) { // compare the integer cast to the reference posit
-						if (bReportIndividualTestCases) std::cout << tag << " FAIL uint32(" << p << ") != uint32(" << presult << ") : reference = " << ref << std::endl;
-						nrOfFailedTestCases++;
+						if (bReportIndividualTestCases) report << tag << " FAIL uint32(" << p << ") != uint32(" << presult << ") : reference = " << ref << std::endl;
+						nrOfFailedTests++;
 					}
 					else {
-						//if (bReportIndividualTestCases) std::cout << tag << " PASS " << p << " == " << presult << " : reference = " << ref << std::endl;
+						//if (bReportIndividualTestCases) report << tag << " PASS " << p << " == " << presult << " : reference = " << ref << std::endl;
 					}
 				}
-				++p;
+				if (descending) --p; else ++p;
 			}
-		}
+			return nrOfFailedTests;
+		}, std::cout);
 		return nrOfFailedTestCases;
 	}
 
@@ -645,16 +695,14 @@ namespace unum {
 	template<size_t nbits, size_t es>
 	int ValidateAddition(const std::string& tag, bool bReportIndividualTestCases) {
 		const size_t NR_POSITS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		posit<nbits, es> pa, pb, psum, pref;
-
-		double da, db;
-		for (size_t i = 0; i < NR_POSITS; i++) {
+		return VerifyRows(NR_POSITS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
+			posit<nbits, es> pa, pb, psum, pref;
 			pa.set_raw_bits(i);
-			da = double(pa);
+			double da = double(pa);
 			for (size_t j = 0; j < NR_POSITS; j++) {
 				pb.set_raw_bits(j);
-				db = double(pb);
+				double db = double(pb);
 				pref = da + db;
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 				try {
@@ -675,23 +723,22 @@ namespace unum {
 #endif
 				if (psum != pref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "+", pa, pb, pref, psum);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "+", pa, pb, pref, psum);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "+", pa, pb, pref, psum);
 				}
 			}
-		}
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// enumerate all addition cases for a posit configuration
 	template<size_t nbits, size_t es>
 	int ValidateInPlaceAddition(const std::string& tag, bool bReportIndividualTestCases) {
 		const size_t NR_POSITS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		for (size_t i = 0; i < NR_POSITS; i++) {
+		return VerifyRows(NR_POSITS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
 			posit<nbits, es> pa;
 			pa.set_raw_bits(i);
 			double da = double(pa);
@@ -721,23 +768,22 @@ namespace unum {
 #endif
 				if (psum != pref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "+=", pa, pb, pref, psum);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "+=", pa, pb, pref, psum);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "+=", pa, pb, pref, psum);
 				}
 			}
-		}
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// enumerate all subtraction cases for a posit configuration: is within 10sec till about nbits = 14
 	template<size_t nbits, size_t es>
 	int ValidateSubtraction(const std::string& tag, bool bReportIndividualTestCases) {
 		const size_t NR_POSITS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		for (size_t i = 0; i < NR_POSITS; i++) {
+		return VerifyRows(NR_POSITS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
 			posit<nbits, es> pa;
 			pa.set_raw_bits(i);
 			double da = double(pa);
@@ -765,23 +811,22 @@ namespace unum {
 #endif
 				if (pdif != pref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "-", pa, pb, pref, pdif);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "-", pa, pb, pref, pdif);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "-", pa, pb, pref, pdif);
 				}
 			}
-		}
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// enumerate all subtraction cases for a posit configuration: is within 10sec till about nbits = 14
 	template<size_t nbits, size_t es>
 	int ValidateInPlaceSubtraction(const std::string& tag, bool bReportIndividualTestCases) {
 		const size_t NR_POSITS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		for (size_t i = 0; i < NR_POSITS; i++) {
+		return VerifyRows(NR_POSITS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
 			posit<nbits, es> pa;
 			pa.set_raw_bits(i);
 			double da = double(pa);
@@ -810,23 +855,22 @@ namespace unum {
 #endif
 				if (pdif != pref) {
 					nrOfFailedTests++;
-					if (bReportIndividualTestCases)	ReportBinaryArithmeticError("FAIL", "-=", pa, pb, pref, pdif);
+					if (bReportIndividualTestCases)	ReportBinaryArithmeticError(report, "FAIL", "-=", pa, pb, pref, pdif);
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "-=", pa, pb, pref, pdif);
 				}
 			}
-		}
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// enumerate all multiplication cases for a posit configuration: is within 10sec till about nbits = 14
 	template<size_t nbits, size_t es>
 	int ValidateMultiplication(const std::string& tag, bool bReportIndividualTestCases) {
-		int nrOfFailedTests = 0;
 		const size_t NR_POSITS = (size_t(1) << nbits);
-		for (size_t i = 0; i < NR_POSITS; i++) {
+		return VerifyRows(NR_POSITS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
 			posit<nbits, es> pa;
 			pa.set_raw_bits(i);
 			double da = double(pa);
@@ -852,23 +896,23 @@ namespace unum {
 				pmul = pa * pb;
 #endif
 				if (pmul != pref) {
-					if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "*", pa, pb, pref, pmul);
+					if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "*", pa, pb, pref, pmul);
 					nrOfFailedTests++;
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "*", pa, pb, pref, pmul);
 				}
 			}
-		}
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// enumerate all multiplication cases for a posit configuration: is within 10sec till about nbits = 14
 	template<size_t nbits, size_t es>
 	int ValidateInPlaceMultiplication(const std::string& tag, bool bReportIndividualTestCases) {
-		int nrOfFailedTests = 0;
 		const size_t NR_POSITS = (size_t(1) << nbits);
-		for (size_t i = 0; i < NR_POSITS; i++) {
+		return VerifyRows(NR_POSITS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
 			posit<nbits, es> pa;
 			pa.set_raw_bits(i);
 			double da = double(pa);
@@ -896,15 +940,15 @@ namespace unum {
 				pmul *= pb;
 #endif
 				if (pmul != pref) {
-					if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "*=", pa, pb, pref, pmul);
+					if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "*=", pa, pb, pref, pmul);
 					nrOfFailedTests++;
 				}
 				else {
 					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", "*=", pa, pb, pref, pmul);
 				}
 			}
-		}
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// enerate all reciprocation cases for a posit configuration: executes within 10 sec till about nbits = 14
@@ -941,8 +985,8 @@ namespace unum {
 	template<size_t nbits, size_t es>
 	int ValidateDivision(const std::string& tag, bool bReportIndividualTestCases) {
 		constexpr size_t NR_POSITS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		for (size_t i = 0; i < NR_POSITS; i++) {
+		return VerifyRows(NR_POSITS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
 			posit<nbits, es> pa;
 			pa.set_raw_bits(i);
 			double da = double(pa);
@@ -967,7 +1011,7 @@ namespace unum {
 						//pdiv.setnar();
 					}
 					else {
-						if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "/", pa, pb, pref, pdiv);
+						if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "/", pa, pb, pref, pdiv);
 						throw; // rethrow
 					}
 				}
@@ -978,7 +1022,7 @@ namespace unum {
 						//pdiv = 0.0f;
 					}
 					else {
-						if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "/", pa, pb, pref, pdiv);
+						if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "/", pa, pb, pref, pdiv);
 						throw; // rethrow
 					}
 				}
@@ -989,7 +1033,7 @@ namespace unum {
 						//pdiv.setnar();
 					}
 					else {
-						if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "/", pa, pb, pref, pdiv);
+						if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "/", pa, pb, pref, pdiv);
 						throw; // rethrow
 					}
 				}
@@ -998,7 +1042,7 @@ namespace unum {
 #endif
 				// check against the IEEE reference
 				if (pdiv != pref) {
-					if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "/", pa, pb, pref, pdiv);
+					if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "/", pa, pb, pref, pdiv);
 					nrOfFailedTests++;
 				}
 				else {
@@ -1006,16 +1050,16 @@ namespace unum {
 				}
 
 			}
-		}
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// enumerate all division cases for a posit configuration: is within 10sec till about nbits = 14
 	template<size_t nbits, size_t es>
 	int ValidateInPlaceDivision(const std::string& tag, bool bReportIndividualTestCases) {
 		constexpr size_t NR_POSITS = (size_t(1) << nbits);
-		int nrOfFailedTests = 0;
-		for (size_t i = 0; i < NR_POSITS; i++) {
+		return VerifyRows(NR_POSITS, [&](size_t i, std::ostream& report) {
+			int nrOfFailedTests = 0;
 			posit<nbits, es> pa;
 			pa.set_raw_bits(i);
 			double da = double(pa);
@@ -1041,7 +1085,7 @@ namespace unum {
 						//pdiv.setnar();
 					}
 					else {
-						if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "/", pa, pb, pref, pdiv);
+						if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "/", pa, pb, pref, pdiv);
 						throw err; // rethrow
 					}
 				}
@@ -1052,7 +1096,7 @@ namespace unum {
 						//pdiv = 0.0f;
 					}
 					else {
-						if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "/", pa, pb, pref, pdiv);
+						if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "/", pa, pb, pref, pdiv);
 						throw; // rethrow
 					}
 				}
@@ -1063,7 +1107,7 @@ namespace unum {
 						//pdiv.setnar();
 					}
 					else {
-						if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "/=", pa, pb, pref, pdiv);
+						if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "/=", pa, pb, pref, pdiv);
 						throw; // rethrow
 					}
 				}
@@ -1073,7 +1117,7 @@ namespace unum {
 #endif
 				// check against the IEEE reference
 				if (pdiv != pref) {
-					if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", "/=", pa, pb, pref, pdiv);
+					if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", "/=", pa, pb, pref, pdiv);
 					nrOfFailedTests++;
 				}
 				else {
@@ -1081,8 +1125,8 @@ namespace unum {
 				}
 
 			}
-		}
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// Posit equal diverges from IEEE float in dealing with INFINITY/NAN
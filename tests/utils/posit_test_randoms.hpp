@@ -10,6 +10,7 @@
 #include <typeinfo>
 #include <random>
 #include <limits>
+#include <algorithm>
 
 // include the base test helpers
 #include "posit_test_helpers.hpp"
@@ -58,6 +59,9 @@ namespace sw { namespace unum {
 	const int OPCODE_POW   = 50;
 	const int OPCODE_RAN   = 60;
 
+	// number of randoms drawn by a single task of the verification engine
+	constexpr size_t RANDOMS_PER_BLOCK = 64;
+
 	// Execute a binary operator
 	template<size_t nbits, size_t es>
 	void executeBinary(int opcode, double da, double db, const posit<nbits, es>& pa, const posit<nbits, es>& pb, posit<nbits, es>& preference, posit<nbits, es>& presult) {
@@ -114,8 +118,9 @@ namespace sw { namespace unum {
 	// Execute a unary operator
 	template<size_t nbits, size_t es>
 	void executeUnary(int opcode, double da, const posit<nbits, es>& pa, posit<nbits, es>& preference, posit<nbits, es>& presult) {
-		posit<nbits, es> pminpos;
+		posit<nbits, es> pminpos, pmaxpos;
 		double dminpos = double(minpos<nbits, es>(pminpos));
+		double dmaxpos = double(maxpos<nbits, es>(pmaxpos));
 		double reference = 0.0;
 		switch (opcode) {
 		case OPCODE_SQRT:
@@ -126,11 +131,13 @@ namespace sw { namespace unum {
 			presult = sw::unum::exp(pa);
 			reference = std::exp(da);
 			if (0.0 == reference) reference = dminpos;
+			if (std::isinf(reference)) reference = std::copysign(dmaxpos, reference);
 			break;
 		case OPCODE_EXP2:
 			presult = sw::unum::exp2(pa);
 			reference = std::exp2(da);
 			if (0.0 == reference) reference = dminpos;
+			if (std::isinf(reference)) reference = std::copysign(dmaxpos, reference);
 			break;
 		case OPCODE_LOG:
 			presult = sw::unum::log(pa);
@@ -171,10 +178,12 @@ namespace sw { namespace unum {
 		case OPCODE_SINH:
 			presult = sw::unum::sinh(pa);
 			reference = std::sinh(da);
+			if (std::isinf(reference)) reference = std::copysign(dmaxpos, reference);
 			break;
 		case OPCODE_COSH:
 			presult = sw::unum::cosh(pa);
 			reference = std::cosh(da);
+			if (std::isinf(reference)) reference = std::copysign(dmaxpos, reference);
 			break;
 		case OPCODE_TANH:
 			presult = sw::unum::tanh(pa);
@@ -239,48 +248,55 @@ namespace sw { namespace unum {
 			std::cerr << "Unsupported unary operator, test cancelled\n";
 			return 1;
 		}
-		// generate the full state space set of valid posit values
-		std::random_device rd;     // get a random seed from the OS entropy device, or whatever
-		std::mt19937_64 eng(rd()); // use the 64-bit Mersenne Twister 19937 generator and seed it with entropy.
-		// define the distribution, by default it goes from 0 to MAX(unsigned long long)
-		std::uniform_int_distribution<unsigned long long> distr;
-		int nrOfFailedTests = 0;
-		for (unsigned i = 1; i < nrOfRandoms; i++) {
-			posit<nbits, es> pa, pb, presult, preference;
-			pa.set_raw_bits(distr(eng));
-			pb.set_raw_bits(distr(eng));
-			double da = double(pa);
-			double db = double(pb);
-			// in case you have numeric_limits<long double>::digits trouble... this will show that
-			//std::cout << "sizeof da: " << sizeof(da) << " bits in significant " << (std::numeric_limits<long double>::digits - 1) << " value da " << da << " at index " << ia << " pa " << pa << std::endl;
-			//std::cout << "sizeof db: " << sizeof(db) << " bits in significant " << (std::numeric_limits<long double>::digits - 1) << " value db " << db << " at index " << ia << " pa " << pb << std::endl;
+		// the randoms are drawn in blocks, each block from its own generator seeded with the run seed
+		// and the block index, so that a run can be reproduced with --seed and sharded like the exhaustive suites
+		const uint64_t seed = VerificationSeed();
+		const size_t nrOfBlocks = (nrOfRandoms > 1 ? (size_t(nrOfRandoms) - 1 + RANDOMS_PER_BLOCK - 1) / RANDOMS_PER_BLOCK : 0);
+		return VerifyRows(nrOfBlocks, [&](size_t block, std::ostream& report) {
+			std::seed_seq sequence{ uint32_t(seed), uint32_t(seed >> 32), uint32_t(block) };
+			std::mt19937_64 eng(sequence);
+			// define the distribution, by default it goes from 0 to MAX(unsigned long long)
+			std::uniform_int_distribution<unsigned long long> distr;
+			int nrOfFailedTests = 0;
+			const size_t first = 1 + block * RANDOMS_PER_BLOCK;
+			const size_t last = std::min(first + RANDOMS_PER_BLOCK, size_t(nrOfRandoms));
+			for (size_t i = first; i < last; i++) {
+				posit<nbits, es> pa, pb, presult, preference;
+				pa.set_raw_bits(distr(eng));
+				pb.set_raw_bits(distr(eng));
+				double da = double(pa);
+				double db = double(pb);
+				// in case you have numeric_limits<long double>::digits trouble... this will show that
+				//std::cout << "sizeof da: " << sizeof(da) << " bits in significant " << (std::numeric_limits<long double>::digits - 1) << " value da " << da << " at index " << ia << " pa " << pa << std::endl;
+				//std::cout << "sizeof db: " << sizeof(db) << " bits in significant " << (std::numeric_limits<long double>::digits - 1) << " value db " << db << " at index " << ia << " pa " << pb << std::endl;
 
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
-			try {
-				executeBinary(opcode, da, db, pa, pb, preference, presult);
-			}
-			catch (const posit_arithmetic_exception& err) {
-				if (pa.isnar() || pb.isnar() || ((opcode == OPCODE_DIV || opcode == OPCODE_IPD) && pb.iszero())) {
-					if (bReportIndividualTestCases) std::cerr << "Correctly caught arithmetic exception: " << err.what() << std::endl;
+				try {
+					executeBinary(opcode, da, db, pa, pb, preference, presult);
 				}
-				else {
-					throw; // rethrow
+				catch (const posit_arithmetic_exception& err) {
+					if (pa.isnar() || pb.isnar() || ((opcode == OPCODE_DIV || opcode == OPCODE_IPD) && pb.iszero())) {
+						if (bReportIndividualTestCases) report << "Correctly caught arithmetic exception: " << err.what() << std::endl;
+					}
+					else {
+						throw; // rethrow
+					}
 				}
-			}
 #else
-			executeBinary(opcode, da, db, pa, pb, preference, presult);
+				executeBinary(opcode, da, db, pa, pb, preference, presult);
 #endif
 
-			presult = preference;
-			if (presult != preference) {
-				nrOfFailedTests++;
-				if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", operation_string, pa, pb, preference, presult);
-			}
-			else {
-				//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", operation_string, pa, pb, preference, presult);
+				presult = preference;
+				if (presult != preference) {
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases) ReportBinaryArithmeticError(report, "FAIL", operation_string, pa, pb, preference, presult);
+				}
+				else {
+					//if (bReportIndividualTestCases) ReportBinaryArithmeticSuccess("PASS", operation_string, pa, pb, preference, presult);
+				}
 			}
-		}
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	// generate a random set of operands to test the binary operators for a posit configuration
@@ -343,56 +359,61 @@ namespace sw { namespace unum {
 		case OPCODE_ATANH:
 			break;
 		}
-		// generate the full state space set of valid posit values
-		std::random_device rd;     // get a random seed from the OS entropy device, or whatever
-		std::mt19937_64 eng(rd()); // use the 64-bit Mersenne Twister 19937 generator and seed it with entropy.
-		// define the distribution, by default it goes from 0 to MAX(unsigned long long)
-		std::uniform_int_distribution<unsigned long long> distr;
-		int nrOfFailedTests = 0;
-		for (unsigned i = 1; i < nrOfRandoms; i++) {
-			posit<nbits, es> pa, presult, preference;
-			pa.set_raw_bits(distr(eng));
-			if (sqrtOperator && pa < 0) pa = -pa;
-			double da = double(pa);
-			// in case you have numeric_limits<long double>::digits trouble... this will show that
-			//std::cout << "sizeof da: " << sizeof(da) << " bits in significant " << (std::numeric_limits<long double>::digits - 1) << " value da " << da << " at index " << ia << " pa " << pa << std::endl;
+		// the randoms are drawn in blocks, each block from its own generator seeded with the run seed and the block index
+		const uint64_t seed = VerificationSeed();
+		const size_t nrOfBlocks = (nrOfRandoms > 1 ? (size_t(nrOfRandoms) - 1 + RANDOMS_PER_BLOCK - 1) / RANDOMS_PER_BLOCK : 0);
+		return VerifyRows(nrOfBlocks, [&](size_t block, std::ostream& report) {
+			std::seed_seq sequence{ uint32_t(seed), uint32_t(seed >> 32), uint32_t(block) };
+			std::mt19937_64 eng(sequence);
+			// define the distribution, by default it goes from 0 to MAX(unsigned long long)
+			std::uniform_int_distribution<unsigned long long> distr;
+			int nrOfFailedTests = 0;
+			const size_t first = 1 + block * RANDOMS_PER_BLOCK;
+			const size_t last = std::min(first + RANDOMS_PER_BLOCK, size_t(nrOfRandoms));
+			for (size_t i = first; i < last; i++) {
+				posit<nbits, es> pa, presult, preference;
+				pa.set_raw_bits(distr(eng));
+				if (sqrtOperator && pa < 0) pa = -pa;
+				double da = double(pa);
+				// in case you have numeric_limits<long double>::digits trouble... this will show that
+				//std::cout << "sizeof da: " << sizeof(da) << " bits in significant " << (std::numeric_limits<long double>::digits - 1) << " value da " << da << " at index " << ia << " pa " << pa << std::endl;
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
-			try {
-				executeUnary(opcode, da, pa, preference, presult);
-			}
-			catch (const posit_arithmetic_exception& err) {
-				if (pa.isnar()) {
-					if (bReportIndividualTestCases) std::cerr << "Correctly caught arithmetic exception: " << err.what() << std::endl;
+				try {
+					executeUnary(opcode, da, pa, preference, presult);
 				}
-				else {
-					throw;  // rethrow
+				catch (const posit_arithmetic_exception& err) {
+					if (pa.isnar()) {
+						if (bReportIndividualTestCases) report << "Correctly caught arithmetic exception: " << err.what() << std::endl;
+					}
+					else {
+						throw;  // rethrow
+					}
 				}
-			}
 #else
-			executeUnary(opcode, da, pa, preference, presult);
+				executeUnary(opcode, da, pa, preference, presult);
 #endif
-			if (presult != preference) {
-				nrOfFailedTests++;
-				if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", operation_string, pa, preference, presult);
-			}
-			else {
-				if (bReportIndividualTestCases) ReportUnaryArithmeticSuccess("PASS", operation_string, pa, preference, presult);
+				if (presult != preference) {
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases) ReportUnaryArithmeticError(report, "FAIL", operation_string, pa, preference, presult);
+				}
+				else {
+					if (bReportIndividualTestCases) ReportUnaryArithmeticSuccess(report, "PASS", operation_string, pa, preference, presult);
+				}
 			}
-		}
-
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 	template<size_t nbits, size_t es>
-	int Compare(long double input, const posit<nbits, es>& presult, const posit<nbits, es>& ptarget, const posit<nbits+1,es>& pref, bool bReportIndividualTestCases) {
+	int Compare(std::ostream& ostr, long double input, const posit<nbits, es>& presult, const posit<nbits, es>& ptarget, const posit<nbits+1,es>& pref, bool bReportIndividualTestCases) {
 		int fail = 0;
 		if (presult != ptarget) {
 			fail++;
 			if (bReportIndividualTestCases) {
-				ReportConversionError("FAIL", "=", input, (long double)(ptarget), presult);
-				std::cout << "reference   : " << pref.get() << std::endl;
-				std::cout << "target bits : " << ptarget.get() << std::endl;
-				std::cout << "actual bits : " << presult.get() << std::endl;
+				ReportConversionError(ostr, "FAIL", "=", input, (long double)(ptarget), presult);
+				ostr << "reference   : " << pref.get() << std::endl;
+				ostr << "target bits : " << ptarget.get() << std::endl;
+				ostr << "actual bits : " << presult.get() << std::endl;
 			}
 		}
 		else {
@@ -401,6 +422,11 @@ namespace sw { namespace unum {
 		return fail;
 	}
 
+	template<size_t nbits, size_t es>
+	int Compare(long double input, const posit<nbits, es>& presult, const posit<nbits, es>& ptarget, const posit<nbits+1,es>& pref, bool bReportIndividualTestCases) {
+		return Compare(std::cerr, input, presult, ptarget, pref, bReportIndividualTestCases);
+	}
+
 
 	// generate a random set of conversion cases
 	template<size_t nbits, size_t es>
@@ -410,75 +436,79 @@ namespace sw { namespace unum {
 		// These larger posits will be at the mid-point between the smaller posit sample values
 		// and we'll enumerate the exact value, and a perturbation smaller and a perturbation larger
 		// to test the rounding logic of the conversion.
-		posit<nbits + 1, es> pref, pprev, pnext;
 
-		// setup the random number generator
-		std::random_device rd;     //Get a random seed from the OS entropy device, or whatever
-		std::mt19937_64 eng(rd()); //Use the 64-bit Mersenne Twister 19937 generator and seed it with entropy.
-									//Define the distribution, by default it goes from 0 to MAX(unsigned long long)
-		std::uniform_int_distribution<unsigned long long> distr;
+		// the randoms are drawn in blocks, each block from its own generator seeded with the run seed and the block index
+		const uint64_t seed = VerificationSeed();
+		const size_t nrOfBlocks = (size_t(nrOfRandoms) + RANDOMS_PER_BLOCK - 1) / RANDOMS_PER_BLOCK;
+		return VerifyRows(nrOfBlocks, [&](size_t block, std::ostream& report) {
+			std::seed_seq sequence{ uint32_t(seed), uint32_t(seed >> 32), uint32_t(block) };
+			std::mt19937_64 eng(sequence);
+			// define the distribution, by default it goes from 0 to MAX(unsigned long long)
+			std::uniform_int_distribution<unsigned long long> distr;
+			int nrOfFailedTests = 0;
+			posit<nbits + 1, es> pref, pprev, pnext;
+			const size_t first = block * RANDOMS_PER_BLOCK;
+			const size_t last = std::min(first + RANDOMS_PER_BLOCK, size_t(nrOfRandoms));
+			for (size_t i = first; i < last; ++i) {
+				posit<nbits, es> presult, ptarget;
+				// generate random value
+				unsigned long long value = distr(eng);
+				pref.set_raw_bits(value);   // assign to a posit<nbits+1,es> to generate the reference we know how to perturb
+				long double da = (long double)(pref);
 
-		// execute the test
-		int nrOfFailedTests = 0;
-		for (uint32_t i = 0; i < nrOfRandoms; ++i) {
-			posit<nbits, es> presult, ptarget;
-			// generate random value
-			unsigned long long value = distr(eng);
-			pref.set_raw_bits(value);   // assign to a posit<nbits+1,es> to generate the reference we know how to perturb
-			long double da = (long double)(pref);
-
-			//std::cout << std::hex << "0x" << value << std::endl;
-			//std::cout << std::dec << da << std::endl;
+				//std::cout << std::hex << "0x" << value << std::endl;
+				//std::cout << std::dec << da << std::endl;
 /*
-			long double eps;
-			if (value == 0) {
-				eps = minpos / 2.0;
-			}
-			else {
-				eps = da > 0 ? da * 1.0e-6 : da * -1.0e-6;
-			}
-			*/
+				long double eps;
+				if (value == 0) {
+					eps = minpos / 2.0;
+				}
+				else {
+					eps = da > 0 ? da * 1.0e-6 : da * -1.0e-6;
+				}
+				*/
 
-			pprev = pnext = pref;
-			--pprev;
-			++pnext;
-			bitblock<nbits> raw_target;
-			long double input;
-			if (value % 2) {
-				// for odd values, we are between posit values, so we create the round-up and round-down cases
+				pprev = pnext = pref;
+				--pprev;
+				++pnext;
+				bitblock<nbits> raw_target;
+				long double input;
+				if (value % 2) {
+					// for odd values, we are between posit values, so we create the round-up and round-down cases
 
-				// round-down case
-				input = (long double)(pprev);
-				presult = input;
-				truncate(pprev.get(), raw_target);
-				ptarget.set(raw_target);
-				nrOfFailedTests += Compare(input, presult, ptarget, pref, bReportIndividualTestCases);
-				// round-up
-				input = (long double)(pnext);
-				presult = input;
-				truncate(pnext.get(), raw_target);
-				ptarget.set(raw_target);
-				nrOfFailedTests += Compare(input, presult, ptarget, pref, bReportIndividualTestCases);
-			}
-			else {
-				// for even values, we are on a posit value, so we create the round-up and round-down cases
-				// by perturbing negative for rounding up, and perturbing positive for rounding down
-				// The problem you will run into for large posits is that you need 128-bit floats to be
-				// able to make the perturbation small enough not to end up on a completely different posit.
+					// round-down case
+					input = (long double)(pprev);
+					presult = input;
+					truncate(pprev.get(), raw_target);
+					ptarget.set(raw_target);
+					nrOfFailedTests += Compare(report, input, presult, ptarget, pref, bReportIndividualTestCases);
+					// round-up
+					input = (long double)(pnext);
+					presult = input;
+					truncate(pnext.get(), raw_target);
+					ptarget.set(raw_target);
+					nrOfFailedTests += Compare(report, input, presult, ptarget, pref, bReportIndividualTestCases);
+				}
+				else {
+					// for even values, we are on a posit value, so we create the round-up and round-down cases
+					// by perturbing negative for rounding up, and perturbing positive for rounding down
+					// The problem you will run into for large posits is that you need 128-bit floats to be
+					// able to make the perturbation small enough not to end up on a completely different posit.
 
-				// round-up
-				input = (long double)(pprev);
-				presult = input;
-				ptarget = (long double)(pref);
-				//nrOfFailedTests += Compare(input, presult, ptarget, pref, bReportIndividualTestCases);
-				// round-down
-				input = (long double)(pnext);
-				presult = input;
-				ptarget = (long double)(pref);
-				nrOfFailedTests += Compare(input, presult, ptarget, pref, bReportIndividualTestCases);
+					// round-up
+					input = (long double)(pprev);
+					presult = input;
+					ptarget = (long double)(pref);
+					//nrOfFailedTests += Compare(report, input, presult, ptarget, pref, bReportIndividualTestCases);
+					// round-down
+					input = (long double)(pnext);
+					presult = input;
+					ptarget = (long double)(pref);
+					nrOfFailedTests += Compare(report, input, presult, ptarget, pref, bReportIndividualTestCases);
+				}
 			}
-		}
-		return nrOfFailedTests;
+			return nrOfFailedTests;
+		});
 	}
 
 }} // namespace sw::unum
\ No newline at end of file
@@ -0,0 +1,218 @@
+#pragma once
+//  verification_engine.hpp : parallel, shardable enumeration engine for the arithmetic verification suites
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sw { namespace unum {
+
+// The exhaustive verification suites enumerate the operand space as rows: row i holds all the
+// test cases that have the i-th encoding as left-hand operand. The engine distributes the rows
+// across a pool of worker threads and emits the failure reports in row order, so the output of
+// a run does not depend on the number of threads.
+//
+// A run can be restricted to a shard of the rows, selected with --shard i/N on the command line
+// of a test driver that calls ParseVerificationArguments, or with the environment variable
+// UNIVERSAL_VERIFICATION_SHARD=i/N. Shard i holds the rows r with r % N == i, so a long exhaustive
+// run can be split across processes or machines, and an interrupted run can be resumed by only
+// running the shards that did not complete.
+struct verification_config {
+	unsigned threads;   // number of worker threads, 0 selects std::thread::hardware_concurrency()
+	size_t   shard;     // shard of the rows to verify
+	size_t   nrShards;  // number of shards the rows are partitioned into
+	uint64_t seed;      // seed of the randomized suites, 0 selects a seed from std::random_device
+};
+
+namespace internal {
+
+	// parse a decimal number that must span the whole string
+	inline bool parse_verification_number(const std::string& str, uint64_t& number) {
+		if (str.empty() || str.size() > 19) return false;
+		number = 0;
+		for (char c : str) {
+			if (c < '0' || c > '9') return false;
+			number = 10 * number + uint64_t(c - '0');
+		}
+		return true;
+	}
+
+	// parse a shard specification of the form i/N with i < N
+	inline bool parse_verification_shard(const std::string& spec, size_t& shard, size_t& nrShards) {
+		size_t slash = spec.find('/');
+		if (slash == std::string::npos) return false;
+		uint64_t i, n;
+		if (!parse_verification_number(spec.substr(0, slash), i)) return false;
+		if (!parse_verification_number(spec.substr(slash + 1), n)) return false;
+		if (n == 0 || i >= n) return false;
+		shard = size_t(i);
+		nrShards = size_t(n);
+		return true;
+	}
+
+	inline verification_config default_verification_config() {
+		verification_config config{ 0, 0, 1, 0 };
+#ifdef POSIT_VERBOSE_OUTPUT
+		// arithmetic tracing writes to std::cout from inside the operators
+		config.threads = 1;
+#endif
+		const char* env = std::getenv("UNIVERSAL_VERIFICATION_SHARD");
+		if (env != nullptr && !parse_verification_shard(env, config.shard, config.nrShards)) {
+			std::cerr << "ignoring malformed UNIVERSAL_VERIFICATION_SHARD=" << env << ", expected i/N\n";
+		}
+		env = std::getenv("UNIVERSAL_VERIFICATION_THREADS");
+		uint64_t number;
+		if (env != nullptr) {
+			if (parse_verification_number(env, number)) config.threads = unsigned(number);
+			else std::cerr << "ignoring malformed UNIVERSAL_VERIFICATION_THREADS=" << env << '\n';
+		}
+		env = std::getenv("UNIVERSAL_VERIFICATION_SEED");
+		if (env != nullptr) {
+			if (parse_verification_number(env, number)) config.seed = number;
+			else std::cerr << "ignoring malformed UNIVERSAL_VERIFICATION_SEED=" << env << '\n';
+		}
+		return config;
+	}
+
+} // namespace internal
+
+// the active configuration of the verification engine
+inline verification_config& VerificationConfiguration() {
+	static verification_config config = internal::default_verification_config();
+	return config;
+}
+
+// process the engine arguments --shard i/N, --threads T, and --seed S of a test driver
+// returns false when an argument is malformed; other arguments are left to the driver
+inline bool ParseVerificationArguments(int argc, char** argv) {
+	verification_config& config = VerificationConfiguration();
+	for (int i = 1; i < argc; ++i) {
+		std::string arg(argv[i]);
+		std::string option, parameter;
+		size_t eq = arg.find('=');
+		if (eq != std::string::npos) {
+			option = arg.substr(0, eq);
+			parameter = arg.substr(eq + 1);
+		}
+		else {
+			option = arg;
+			if (i + 1 < argc && (option == "--shard" || option == "--threads" || option == "--seed")) parameter = argv[++i];
+		}
+		uint64_t number;
+		if (option == "--shard") {
+			if (!internal::parse_verification_shard(parameter, config.shard, config.nrShards)) {
+				std::cerr << "malformed shard specification '" << parameter << "', expected --shard i/N with i < N\n";
+				return false;
+			}
+		}
+		else if (option == "--threads") {
+			if (!internal::parse_verification_number(parameter, number)) {
+				std::cerr << "malformed thread count '" << parameter << "'\n";
+				return false;
+			}
+			config.threads = unsigned(number);
+		}
+		else if (option == "--seed") {
+			if (!internal::parse_verification_number(parameter, number)) {
+				std::cerr << "malformed seed '" << parameter << "'\n";
+				return false;
+			}
+			config.seed = number;
+		}
+	}
+	if (config.nrShards > 1) {
+		std::cout << "verifying shard " << config.shard << '/' << config.nrShards << " of the operand space\n";
+	}
+	return true;
+}
+
+// seed of a randomized verification run: the configured seed, or a fresh one from the OS entropy device
+inline uint64_t VerificationSeed() {
+	uint64_t seed = VerificationConfiguration().seed;
+	if (seed == 0) {
+		std::random_device rd;
+		seed = (uint64_t(rd()) << 32) | uint64_t(rd());
+	}
+	return seed;
+}
+
+// Enumerate the rows [0, nrRows) that belong to the active shard.
+// verify(row, report) verifies a single row, writes the reports of its failing test cases to report,
+// and returns the number of failures in the row. After all workers complete, the reports are
+// written to ostr in row order. An exception that escapes verify is rethrown after the reports
+// of the preceding rows have been written. The enumeration ends with the row at which the
+// accumulated failure count exceeds maxFailures, identical to a sequential enumeration:
+// workers stop claiming rows once the limit is reached, and the rows claimed before that
+// always form a prefix that contains the row that crossed it.
+template<typename RowVerifier>
+int VerifyRows(size_t nrRows, RowVerifier&& verify, std::ostream& ostr = std::cerr, int maxFailures = std::numeric_limits<int>::max()) {
+	const verification_config& config = VerificationConfiguration();
+	const size_t shard = config.shard;
+	const size_t stride = config.nrShards;
+	const size_t nrShardRows = (nrRows > shard ? (nrRows - shard + stride - 1) / stride : 0);
+
+	struct row_result {
+		int failures = 0;
+		std::string report;
+		std::exception_ptr error;
+	};
+	std::vector<row_result> results(nrShardRows);
+	std::atomic<size_t> nextRow{ 0 };
+	std::atomic<long long> totalFailures{ 0 };
+	std::atomic<bool> stop{ false };
+
+	auto worker = [&]() {
+		while (!stop.load(std::memory_order_relaxed)) {
+			size_t k = nextRow.fetch_add(1);
+			if (k >= nrShardRows) break;
+			row_result& result = results[k];
+			std::ostringstream report;
+			try {
+				result.failures = verify(shard + k * stride, static_cast<std::ostream&>(report));
+			}
+			catch (...) {
+				result.error = std::current_exception();
+				stop = true;
+			}
+			result.report = report.str();
+			if (totalFailures.fetch_add(result.failures) + result.failures > maxFailures) stop = true;
+		}
+	};
+
+	size_t nrThreads = config.threads;
+	if (nrThreads == 0) nrThreads = std::thread::hardware_concurrency();
+	if (nrThreads > nrShardRows) nrThreads = nrShardRows;
+	if (nrThreads <= 1) {
+		worker();
+	}
+	else {
+		std::vector<std::thread> pool;
+		pool.reserve(nrThreads - 1);
+		for (size_t t = 1; t < nrThreads; ++t) pool.emplace_back(worker);
+		worker();
+		for (auto& thread : pool) thread.join();
+	}
+
+	// aggregate in row order
+	int nrOfFailedTests = 0;
+	for (row_result& result : results) {
+		ostr << result.report;
+		if (result.error) std::rethrow_exception(result.error);
+		nrOfFailedTests += result.failures;
+		if (nrOfFailedTests > maxFailures) break;
+	}
+	return nrOfFailedTests;
+}
+
+}} // namespace sw::unum